@@ -128,7 +128,7 @@ auto equilibrate(Vec& n, Vec& y)
 //               
 //        Vec dydn = lu.solve(-F);
         
-        Vec dydn = solve(J, -F);
+        Vec dydn = solve(J, (-F).eval());
 
         const auto dy = dydn.head(E);
         const auto dn = dydn.tail(N);
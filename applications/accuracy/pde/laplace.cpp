@@ -8,9 +8,12 @@
 // Configure the posit library with arithmetic exceptions
 // enable posit arithmetic exceptions
 #define POSIT_THROW_ARITHMETIC_EXCEPTION 1
+#define POSIT_FAST_POSIT_16_1 1
+#define POSIT_FAST_POSIT_32_2 1
 #include <universal/number/posit/posit.hpp>
 #include <universal/blas/blas.hpp>
 #include <universal/blas/generators.hpp>
+#include <universal/blas/solvers/sor.hpp>
 
 /*
 
@@ -88,6 +91,35 @@ As I said, I had hoped to try this approach with Type I unums
 but ran out of time. My manuscript was six months late as it was!
 */
 
+// Laplace's equation on the interior points of an N x N grid of the unit square: f = 1 on the left half
+// of the bottom border, f = -1 on the right half of the top border, and f = 0 elsewhere on the border.
+// The boundary values move to the right-hand side of the 5-point difference equations.
+template<typename Scalar>
+sw::universal::blas::vector<Scalar> LaplaceBoundary(size_t N) {
+	sw::universal::blas::vector<Scalar> b(N * N, Scalar(0));
+	for (size_t j = 0; j < N; ++j) {
+		if (2 * j < N) b[j] += Scalar(1);                         // bottom row of interior points
+		if (2 * j >= N) b[(N - 1) * N + j] += Scalar(-1);         // top row of interior points
+	}
+	return b;
+}
+
+// solve with red-black SOR at the optimal relaxation factor, and report against the double precision solution
+template<typename Scalar>
+void SolveLaplace(size_t N, const sw::universal::blas::vector<double>& reference) {
+	using namespace sw::universal;
+	using namespace sw::universal::blas;
+	stencil<Scalar> A = laplace_stencil<Scalar>(N, N);
+	vector<Scalar> b = LaplaceBoundary<Scalar>(N), x(N * N, Scalar(0));
+	double w = 2.0 / (1.0 + std::sin(pi / double(N + 1)));
+	// the updates stagnate at the rounding noise of the sweeps: stop at a tolerance the precision can attain
+	double tolerance = std::max(1.0e-6, 16.0 * double(std::numeric_limits<Scalar>::epsilon()));
+	size_t itr = sor<Scalar, 10000>(A, b, x, Scalar(w), Scalar(tolerance));
+	double error{ 0 };
+	for (size_t i = 0; i < N * N; ++i) error = std::max(error, std::abs(double(x[i]) - reference[i]));
+	std::cout << std::setw(20) << type_tag(Scalar()) << " iterations " << std::setw(6) << itr << "  max difference to double " << error << '\n';
+}
+
 int main(int argc, char** argv)
 try {
 	using namespace sw::universal;
@@ -108,6 +140,17 @@ try {
 	laplace2D(A, 5, 5);
 	std::cout << A << std::endl;
 
+	// the matrix-free stencil of the same operator scales to grids that a dense matrix can't hold
+	for (size_t N : { 8, 32, 128 }) {
+		stencil<double> S = laplace_stencil<double>(N, N);
+		vector<double> b = LaplaceBoundary<double>(N), reference(N * N, 0.0);
+		sor<double, 100000>(S, b, reference, 2.0 / (1.0 + std::sin(pi / double(N + 1))), 1.0e-14);
+		std::cout << "Laplace's equation on a " << N << 'x' << N << " grid\n";
+		SolveLaplace< posit<16, 1> >(N, reference);
+		SolveLaplace< posit<32, 2> >(N, reference);
+		SolveLaplace< float >(N, reference);
+	}
+
 	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
 }
 catch (char const* msg) {
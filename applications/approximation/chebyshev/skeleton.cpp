@@ -25,7 +25,7 @@ try {
 	constexpr int N = 12;
 	auto k = arange<Scalar>(0, N);
 	std::cout << "k       = " << k << '\n';
-	auto cosines = -cos(k * PI / N);
+	auto cosines = -cos((k * PI / N).eval());
 	std::cout << "cosines = " << cosines << '\n';
 
 	return EXIT_SUCCESS;
@@ -53,7 +53,7 @@ void SinFunctionFit() {
 		y_pred = av + bx + cxx + dxxx;
 
 		// compute and print loss function
-		Scalar loss = (blas::square(y_pred - y)).sum();
+		Scalar loss = (blas::square((y_pred - y).eval())).sum();
 		if (r % 100 == 99) {
 			std::cout << "[ " << std::setw(4) << r << "] : " << loss << '\n';
 		}
@@ -9,6 +9,17 @@
 #include <universal/number/cfloat/cfloat.hpp>
 #include <universal/number/lns/lns.hpp>
 #include <universal/dnn/dnn.hpp>
+#include <random>
+
+// generate a batch of synthetic 32x32 gray-scale images
+template<typename Scalar>
+sw::universal::dnn::tensor<Scalar> GenerateImages(unsigned N, unsigned seed) {
+	sw::universal::dnn::tensor<Scalar> images(N, 1, 32, 32);
+	std::mt19937 generator(seed);
+	std::uniform_real_distribution<double> distribution(0.0, 1.0);
+	for (size_t i = 0; i < images.size(); ++i) images[i] = Scalar(distribution(generator));
+	return images;
+}
 
 int main()
 try {
@@ -18,21 +29,59 @@ try {
 	constexpr bool hasSupernormals = true;
 	constexpr bool isSaturating = false;
 	using WeightType = cfloat<8, 2, std::uint8_t, hasSubnormals, hasSupernormals, isSaturating>;
-	using ActivationType = lns<5, 2, std::uint8_t>;
+	using ActivationType = lns<8, 3, std::uint8_t>;
+	using AccumulationType = float;
 	dnn::dnn<float> dnn("LeNet-5", 0.1f);
 
-	unsigned N(1), C(3), H(224), W(224);
-	auto convLayer1 = dnn::CreateConvolutionLayer<WeightType, ActivationType>(N, C, H, W, dnn::Activation::Tanh);
+	// LeNet-5: 1x32x32 -> conv 6@5x5 -> avgpool 2x2 -> conv 16@5x5 -> avgpool 2x2 -> fc 120 -> fc 84 -> fc 10
+	auto convLayer1 = dnn::CreateConvolutionLayer<WeightType, ActivationType, AccumulationType>(1, 6, 5, 5, 1, 0, dnn::Activation::Tanh);
+	auto poolLayer1 = dnn::CreatePoolingLayer<ActivationType>(dnn::LayerOperation::AvgPooling, 2, 2);
+	auto convLayer2 = dnn::CreateConvolutionLayer<WeightType, ActivationType, AccumulationType>(6, 16, 5, 5, 1, 0, dnn::Activation::Tanh);
+	auto poolLayer2 = dnn::CreatePoolingLayer<ActivationType>(dnn::LayerOperation::AvgPooling, 2, 2);
+	auto fcLayer1 = dnn::CreateFullyConnectedLayer<WeightType, ActivationType, AccumulationType>(400, 120, dnn::Activation::Tanh);
+	auto fcLayer2 = dnn::CreateFullyConnectedLayer<WeightType, ActivationType, AccumulationType>(120, 84, dnn::Activation::Tanh);
+	auto fcLayer3 = dnn::CreateFullyConnectedLayer<WeightType, ActivationType, AccumulationType>(84, 10, dnn::Activation::Identity);
+	convLayer1.initialize(1);
+	convLayer2.initialize(2);
+	fcLayer1.initialize(3);
+	fcLayer2.initialize(4);
+	fcLayer3.initialize(5);
 	std::cout << convLayer1 << '\n';
+	std::cout << poolLayer1 << '\n';
+	std::cout << convLayer2 << '\n';
+	std::cout << poolLayer2 << '\n';
+	std::cout << fcLayer1 << '\n';
+	std::cout << fcLayer2 << '\n';
+	std::cout << fcLayer3 << '\n';
 	dnn.addLayer(convLayer1);
-
-	auto fcLayer = dnn::CreateFullyConnectedLayer<WeightType, ActivationType>(10ul, dnn::Activation::ReLU);
-	std::cout << fcLayer << '\n';
-	dnn.addLayer(fcLayer);
+	dnn.addLayer(poolLayer1);
+	dnn.addLayer(convLayer2);
+	dnn.addLayer(poolLayer2);
+	dnn.addLayer(fcLayer1);
+	dnn.addLayer(fcLayer2);
+	dnn.addLayer(fcLayer3);
 
 	std::cout << dnn << '\n';
 
-	return EXIT_SUCCESS;
+	constexpr unsigned N = 8;
+	auto images = GenerateImages<ActivationType>(N, 42);
+	auto logits = dnn.infer(images);
+	std::cout << "input  : " << images << '\n';
+	std::cout << "output : " << logits << '\n';
+
+	// inference is partitioned across the batch, so the result must not depend on the number of threads
+	auto reference = dnn.infer(images, 1);
+	int nrOfFailedTestCases = 0;
+	for (unsigned n = 0; n < N; ++n) {
+		unsigned argmax = 0;
+		for (unsigned c = 0; c < logits.channels(); ++c) {
+			if (logits(n, c, 0, 0) != reference(n, c, 0, 0)) ++nrOfFailedTestCases;
+			if (logits(n, c, 0, 0) > logits(n, argmax, 0, 0)) argmax = c;
+		}
+		std::cout << "image " << n << " : class " << argmax << " : logit " << logits(n, argmax, 0, 0) << '\n';
+	}
+
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
 }
 catch (char const* msg) {
 	std::cerr << "Caught ad-hoc exception: " << msg << std::endl;
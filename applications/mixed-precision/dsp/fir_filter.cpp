@@ -8,6 +8,7 @@
 // enable posit arithmetic exceptions
 #define POSIT_THROW_ARITHMETIC_EXCEPTION 1
 #include <universal/number/posit/posit.hpp>
+#include <universal/dsp/fft.hpp>
 
 /*
 
@@ -31,6 +32,26 @@ log_e(10)		M_LN10		2.30258509299404568402
 
 constexpr double pi = 3.14159265358979323846;  // best practice for C++
 
+// direct-form FIR filter y[n] = sum_k taps[k] x[n - k] from a zero initial state
+template<typename Real>
+std::vector<Real> DirectFIR(const std::vector<Real>& taps, const std::vector<Real>& x) {
+	std::vector<Real> y(x.size());
+	for (size_t n = 0; n < x.size(); ++n) {
+		Real sum(0);
+		for (size_t k = 0; k < taps.size() && k <= n; ++k) sum += taps[k] * x[n - k];
+		y[n] = sum;
+	}
+	return y;
+}
+
+// largest absolute difference between y and the double precision reference
+template<typename Real>
+double MaxError(const std::vector<Real>& y, const std::vector<double>& reference) {
+	double error{ 0 };
+	for (size_t i = 0; i < y.size(); ++i) error = std::max(error, std::abs(double(y[i]) - reference[i]));
+	return error;
+}
+
 int main()
 try {
 	using namespace sw::universal;
@@ -56,6 +77,26 @@ try {
 	}
 	std::cout << "Value is " << fir << '\n';
 
+	// filter a two-tone signal with a moving average low-pass filter: the direct form costs
+	// taps multiply-adds per sample, the overlap-add FFT filter two transforms per block of samples
+	using Real = posit<nbits, es>;
+	const size_t nrSamples = 1024;
+	const size_t nrTaps = vecSize;
+	std::vector<Real> taps(nrTaps, Real(1.0 / double(nrTaps))), signal(nrSamples);
+	std::vector<double> dtaps(nrTaps), dsignal(nrSamples);
+	for (size_t i = 0; i < nrSamples; ++i) {
+		signal[i] = 0.5 * std::sin(2.0 * pi * double(i) / 256.0) + 0.25 * std::sin(2.0 * pi * double(i) / 8.0);
+		dsignal[i] = double(signal[i]);
+	}
+	for (size_t k = 0; k < nrTaps; ++k) dtaps[k] = double(taps[k]);
+	std::vector<double> reference = DirectFIR(dtaps, dsignal);
+	std::vector<Real> direct = DirectFIR(taps, signal);
+	dsp::fft_fir_filter<Real> fftFilter(taps);
+	std::vector<Real> filtered = fftFilter.filter(signal);
+	std::cout << "FIR filter with " << nrTaps << " taps over " << nrSamples << " samples in " << type_tag(Real()) << '\n';
+	std::cout << "direct form      max error : " << MaxError(direct, reference) << '\n';
+	std::cout << "FFT overlap-add  max error : " << MaxError(filtered, reference) << " with blocks of " << fftFilter.block_size() << " samples\n";
+
 	return EXIT_SUCCESS;
 }
 catch (char const* msg) {
@@ -5,7 +5,13 @@
 //
 // This file is part of the universal numbers project, which is released under an MIT Open Source license.
 #include <iostream>
+#include <iomanip>
+// configure posit environment
+#define POSIT_FAST_POSIT_32_2 1
 #include <universal/number/posit/posit.hpp>
+#include <universal/number/cfloat/cfloat.hpp>
+#include <universal/number/dd/dd.hpp>
+#include <universal/ode/runge_kutta.hpp>
 
 /*
 On the relation between reliable computation time, float-point precision and the
@@ -30,12 +36,99 @@ agreement with numerical experimental results, especially the scale factors.
 Keywords: reliable computation time, Lyapunov exponent, float precision
  */
 
+// Lorenz system evaluated on a block of ensemble members
+struct Lorenz {
+	template<typename Scalar>
+	void operator()(const Scalar&, sw::universal::ode::soa_block<const Scalar> y, sw::universal::ode::soa_block<Scalar> dydt) const {
+		const Scalar sigma(10), rho(28), beta = Scalar(8) / Scalar(3);
+		for (size_t j = 0; j < y.size(); ++j) {
+			dydt[0][j] = sigma * (y[1][j] - y[0][j]);
+			dydt[1][j] = y[0][j] * (rho - y[2][j]) - y[1][j];
+			dydt[2][j] = y[0][j] * y[1][j] - beta * y[2][j];
+		}
+	}
+};
+
+// integrate the ensemble in Scalar over the segments of the reference solution, and return the mean time
+// at which the members deviate more than the threshold from the reference: the reliable computation time
+template<typename Scalar>
+double ReliableComputationTime(const sw::universal::ode::ensemble<double>& y0, const std::vector<sw::universal::ode::ensemble<double>>& reference,
+		double h, size_t stepsPerSegment, double threshold) {
+	using namespace sw::universal::ode;
+	explicit_runge_kutta<Scalar> rk(classic_rk4());
+	ensemble<Scalar> y(y0.dimension(), y0.members());
+	for (size_t c = 0; c < y0.dimension(); ++c) {
+		for (size_t m = 0; m < y0.members(); ++m) y(m, c) = Scalar(y0(m, c));
+	}
+	std::vector<double> tc(y0.members(), 0.0);
+	Scalar t(0);
+	for (size_t s = 0; s < reference.size(); ++s) {
+		t = rk.integrate(Lorenz{}, t, y, Scalar(h), stepsPerSegment);
+		double segmentEnd = double(s + 1) * double(stepsPerSegment) * h;
+		for (size_t m = 0; m < y0.members(); ++m) {
+			if (tc[m] > 0.0) continue;
+			if (std::abs(double(y(m, 0)) - reference[s](m, 0)) > threshold) tc[m] = segmentEnd;
+		}
+	}
+	double sum{ 0 };
+	for (size_t m = 0; m < y0.members(); ++m) sum += (tc[m] > 0.0 ? tc[m] : double(reference.size() * stepsPerSegment) * h);
+	return sum / double(y0.members());
+}
+
 int main()
 try {
+	using namespace sw::universal;
+	using namespace sw::universal::ode;
 
 	std::cout << "Time-Precision Trade-off for Lyaponov exponent\n";
 
-    
+	// ensemble of trajectories of the Lorenz system from nearby initial conditions, integrated with
+	// the classic Runge-Kutta method in each number system, and in double-double as the reference
+	const size_t members = 64;
+	const double h = 0.01;
+	const size_t stepsPerSegment = 50;
+	const size_t nrSegments = 120;
+	const double threshold = 1.0;
+	ensemble<double> y0(3, members);
+	for (size_t m = 0; m < members; ++m) {
+		y0(m, 0) = 1.0 + 1.0e-3 * double(m);
+		y0(m, 1) = 1.0;
+		y0(m, 2) = 20.0;
+	}
+
+	std::vector<ensemble<double>> reference;
+	{
+		explicit_runge_kutta<dd> rk(classic_rk4());
+		ensemble<dd> y(3, members);
+		for (size_t c = 0; c < 3; ++c) {
+			for (size_t m = 0; m < members; ++m) y(m, c) = dd(y0(m, c));
+		}
+		dd t(0);
+		for (size_t s = 0; s < nrSegments; ++s) {
+			t = rk.integrate(Lorenz{}, t, y, dd(h), stepsPerSegment);
+			ensemble<double> state(3, members);
+			for (size_t c = 0; c < 3; ++c) {
+				for (size_t m = 0; m < members; ++m) state(m, c) = double(y(m, c));
+			}
+			reference.push_back(state);
+		}
+	}
+
+	// the reliable computation time Tc = (ln B / lambda) K + C grows linearly with the number of significant digits K
+	std::cout << "reliable computation time of " << members << " trajectories with deviation threshold " << threshold << '\n';
+	std::cout << std::setw(40) << std::left << type_tag(float()) << ReliableComputationTime<float>(y0, reference, h, stepsPerSegment, threshold) << '\n';
+	std::cout << std::setw(40) << type_tag(posit<32, 2>()) << ReliableComputationTime<posit<32, 2>>(y0, reference, h, stepsPerSegment, threshold) << '\n';
+	std::cout << std::setw(40) << type_tag(double()) << ReliableComputationTime<double>(y0, reference, h, stepsPerSegment, threshold) << '\n';
+
+	// throughput of the ensemble integration in each number system
+	auto lorenz = [](const auto& t, auto y, auto dydt) { Lorenz{}(t, y, dydt); };
+	std::vector<ensemble_run> runs = ensemble_study<float, posit<32, 2>, cfloat<32, 8, uint32_t, true, false, false>, double, dd>(classic_rk4(), lorenz, y0, 0.0, h, 200);
+	std::cout << "throughput of the ensemble integration\n";
+	for (const ensemble_run& run : runs) {
+		std::cout << std::setw(40) << std::left << run.type << std::right << std::scientific << std::setprecision(3)
+			<< run.steps_per_second << " steps/sec\n" << std::defaultfloat;
+	}
+
 	return EXIT_SUCCESS;
 }
 catch (char const* msg) {
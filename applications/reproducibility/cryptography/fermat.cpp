@@ -16,8 +16,32 @@
 #include <universal/number/integer/integer.hpp>
 #include <universal/number/integer/primes.hpp>
 
-template<size_t nbits, typename BlockType>
+// Miller-Rabin test to the first reps prime bases, with the modular exponentiations in Montgomery form
+template<unsigned nbits, typename BlockType>
 bool miller_rabin(const sw::universal::integer<nbits, BlockType>& a, int reps) {
+	using Integer = sw::universal::integer<nbits, BlockType>;
+	static const int bases[] = { 2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37, 41, 43, 47, 53, 59, 61, 67, 71, 73, 79, 83, 89, 97 };
+	if (a < 2) return false;
+	for (int p : bases) {
+		if (a == p) return true;
+		if (a % p == 0) return false;
+	}
+	// a - 1 = d * 2^s with d odd
+	Integer d = a - 1;
+	int s = 0;
+	while (d.iseven()) { d >>= 1; ++s; }
+	sw::universal::montgomery<nbits, BlockType> modulus(a);
+	Integer aMinusOne = a - 1;
+	for (int i = 0; i < reps && i < static_cast<int>(sizeof(bases) / sizeof(bases[0])); ++i) {
+		Integer x = modulus.pow(Integer(bases[i]), d);
+		if (x == 1 || x == aMinusOne) continue;
+		bool witness = true;
+		for (int r = 1; r < s && witness; ++r) {
+			x = modulus.mul(x, x);
+			if (x == aMinusOne) witness = false;
+		}
+		if (witness) return false;
+	}
 	return true;
 }
 
@@ -90,13 +114,10 @@ try {
 			while (!factors.empty()) {
 				Integer factor = factors.top();
 				factors.pop();
-				/*
 				if (miller_rabin(factor, 25)) {
-					// factor is prime
-					cout << factor << endl;
+					std::cout << "factor " << factor << " is prime\n";
 					continue;
 				}
-				*/
 				Integer result = fermatFactorization(factor);
 				if (result == 1) {
 					std::cout << "factor " << factor << " exponent " << result << '\n';
@@ -14,10 +14,41 @@
 #define INTEGER_THROW_ARITHMETIC_EXCEPTION 1
 #include <universal/number/integer/integer.hpp>
 
+// factor a number and report the prime factors and the time it took
+template<typename Integer>
+void Factor(const std::string& tag, const Integer& n) {
+	using namespace sw::universal;
+	using namespace std::chrono;
+	primefactors<Integer> factors;
+	steady_clock::time_point begin = steady_clock::now();
+	primeFactorization(n, factors);
+	steady_clock::time_point end = steady_clock::now();
+	std::cout << std::setw(10) << tag << " = " << n << " = ";
+	for (size_t i = 0; i < factors.size(); ++i) {
+		std::cout << (i > 0 ? " * " : "") << factors[i].first;
+		if (factors[i].second > 1) std::cout << '^' << factors[i].second;
+	}
+	std::cout << "  in " << duration_cast<duration<double>>(end - begin).count() << " sec\n";
+}
+
 int main(int argc, char** argv)
 try {
 	using namespace sw::universal;
+	using Integer = integer<256, uint32_t>;
 
+	// primeFactorization removes small factors by trial division, splits the composite cofactors with
+	// Brent's variant of Pollard's rho method, which finds a factor p in about sqrt(p) steps, and
+	// hands factors that are too large for rho to the elliptic curve method
+	std::cout << "Pollard-Brent rho and elliptic curve factorization of integer<256>\n";
+	Integer one(1), n;
+	n = (one << 64) + 1;
+	Factor("2^64 + 1", n);
+	n = (one << 67) - 1;
+	Factor("2^67 - 1", n);
+	n = (one << 101) - 1;
+	Factor("2^101 - 1", n);
+	n.assign("1000000016000000063");  // 1000000007 * 1000000009
+	Factor("twin", n);
 
 	return EXIT_SUCCESS;
 }
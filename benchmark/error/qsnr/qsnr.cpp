@@ -40,6 +40,11 @@ try {
 	using namespace sw::universal;
 
 	constexpr int nrExperiments = 10;
+	using formats = format_list<
+		fixpnt<8, 2>, fixpnt<8, 3>, fixpnt<8, 4>, fixpnt<8, 5>,
+		fp8e2m5, fp8e3m4, fp8e4m3, fp8e5m2,
+		posit<8, 0>, posit<8, 1>, posit<8, 2>, posit<8, 3>,
+		lns<8, 2>, lns<8, 3>, lns<8, 4>, lns<8, 5>>;
 	std::map<std::string, blas::vector<double>> table;
 	std::vector<std::string> arithmeticTypename = {
 		"fixpnt<8,2>",
@@ -65,22 +70,9 @@ try {
 		constexpr double mean = 0.0;
 		constexpr double stddev = 1.0;
 		auto data = sw::universal::blas::gaussian_random_vector<double>(N, mean, stddev);
-		table["fixpnt<8,2>"].push_back(qsnr<fixpnt<8, 2>>(data));
-		table["fixpnt<8,3>"].push_back(qsnr<fixpnt<8, 3>>(data));
-		table["fixpnt<8,4>"].push_back(qsnr<fixpnt<8, 4>>(data));
-		table["fixpnt<8,5>"].push_back(qsnr<fixpnt<8, 5>>(data));
-		table["fp8e2m5"].push_back(qsnr<fp8e2m5>(data));
-		table["fp8e3m4"].push_back(qsnr<fp8e3m4>(data));
-		table["fp8e4m3"].push_back(qsnr<fp8e4m3>(data));
-		table["fp8e5m2"].push_back(qsnr<fp8e5m2>(data));
-		table["posit<8,0>"].push_back(qsnr<posit<8, 0>>(data));
-		table["posit<8,1>"].push_back(qsnr<posit<8, 1>>(data));
-		table["posit<8,2>"].push_back(qsnr<posit<8, 2>>(data));
-		table["posit<8,3>"].push_back(qsnr<posit<8, 3>>(data));
-		table["lns<8,2>"].push_back(qsnr<lns<8, 2>>(data));
-		table["lns<8,3>"].push_back(qsnr<lns<8, 3>>(data));
-		table["lns<8,4>"].push_back(qsnr<lns<8, 4>>(data));
-		table["lns<8,5>"].push_back(qsnr<lns<8, 5>>(data));
+		// quantize the sample to all formats in a single pass
+		auto reports = qsnr_sweep(formats{}, data);
+		for (size_t k = 0; k < reports.size(); ++k) table[arithmeticTypename[k]].push_back(reports[k].qsnr);
 	}
 
 	for (auto tag : arithmeticTypename) {
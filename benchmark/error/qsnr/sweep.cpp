@@ -0,0 +1,204 @@
+// sweep.cpp: quantization error sweeps over a list of target formats
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <random>
+#include <universal/number/fixpnt/fixpnt.hpp>
+#include <universal/number/cfloat/cfloat.hpp>
+#include <universal/number/posit/posit.hpp>
+#include <universal/number/lns/lns.hpp>
+#include <universal/number/takum/takum.hpp>
+#include <universal/blas/blas.hpp>
+#include <universal/quantization/qsnr.hpp>
+#include <universal/verification/test_suite.hpp>
+
+// Regression testing guards: typically set by the cmake configuration, but MANUAL_TESTING is an override
+#define MANUAL_TESTING 0
+// REGRESSION_LEVEL_OVERRIDE is set by the cmake file to drive a specific regression intensity
+// It is the responsibility of the regression test to organize the tests in a quartile progression.
+//#undef REGRESSION_LEVEL_OVERRIDE
+#ifndef REGRESSION_LEVEL_OVERRIDE
+#undef REGRESSION_LEVEL_1
+#undef REGRESSION_LEVEL_2
+#undef REGRESSION_LEVEL_3
+#undef REGRESSION_LEVEL_4
+#define REGRESSION_LEVEL_1 1
+#define REGRESSION_LEVEL_2 1
+#define REGRESSION_LEVEL_3 1
+#define REGRESSION_LEVEL_4 1
+#endif
+
+namespace sw { namespace universal {
+	using fp6e3m2 = cfloat<6, 3, std::uint8_t, true, true, false>;
+	using fp6e2m3 = cfloat<6, 2, std::uint8_t, true, true, false>;
+	using fp4e2m1 = cfloat<4, 2, std::uint8_t, true, true, false>;
+
+	using fp8_formats = format_list<fp8e4m3, fp8e5m2, fp6e3m2, fp6e2m3, fp4e2m1, posit<8, 0>, posit<8, 2>, lns<8, 3>, fixpnt<8, 4>, takum<8>>;
+}}
+
+// the tabulated quantizer rounds as the arithmetic conversion of the target: on values of all scales, on the
+// rounding boundaries and their neighbors, and on the special values
+template<typename Target>
+int VerifyQuantizer(bool reportTestCases) {
+	using namespace sw::universal;
+	int nrOfFailedTestCases = 0;
+	const quantizer<Target>& q = quantizer<Target>::instance();
+	if (reportTestCases && !q.tabulated()) std::cerr << type_tag(Target()) << " does not convert monotonically and quantizes through its conversion\n";
+	auto check = [&](double x) {
+		double expected = double(Target(x));
+		double quantized = q(x);
+		bool pass = (std::isnan(expected) ? std::isnan(quantized) : quantized == expected);
+		if (!pass) {
+			++nrOfFailedTestCases;
+			if (reportTestCases && nrOfFailedTestCases < 10) std::cerr << "FAIL: " << type_tag(Target()) << " quantizes " << std::setprecision(17) << x << " to " << quantized << " instead of " << expected << '\n';
+		}
+	};
+	constexpr double inf = std::numeric_limits<double>::infinity();
+	std::mt19937_64 generator(0x5eed);
+	std::normal_distribution<double> gaussian(0.0, 1.0);
+	std::uniform_int_distribution<int> scale(-40, 40);
+	for (int i = 0; i < 100000; ++i) check(std::ldexp(gaussian(generator), scale(generator)));
+	for (uint64_t raw = 0; raw < (uint64_t(1) << Target::nbits); ++raw) {
+		Target t;
+		t.setbits(raw);
+		double v = double(t);
+		if (!std::isfinite(v)) continue;
+		check(v);
+		check(std::nextafter(v, inf));
+		check(std::nextafter(v, -inf));
+		// the midpoints to the neighbors, where the rounding boundaries of linear formats are
+		Target up(t), down(t);
+		++up;
+		--down;
+		if (std::isfinite(double(up))) {
+			double mid = std::midpoint(v, double(up));
+			check(mid);
+			check(std::nextafter(mid, inf));
+			check(std::nextafter(mid, -inf));
+		}
+		if (std::isfinite(double(down))) check(std::midpoint(v, double(down)));
+	}
+	for (double x : { 0.0, -0.0, inf, -inf, std::numeric_limits<double>::quiet_NaN(), 1.0e300, -1.0e300, 1.0e-300, -1.0e-300 }) check(x);
+	return nrOfFailedTestCases;
+}
+
+// the sweep of a format list reports the QSNR of each format quantized on its own, for any number of threads
+template<typename... Targets>
+int VerifySweep(sw::universal::format_list<Targets...> formats, bool reportTestCases) {
+	using namespace sw::universal;
+	int nrOfFailedTestCases = 0;
+	blas::vector<double> data(100000);
+	blas::gaussian_random(data, 0.0, 1.0);
+	// clip the data to the range of the narrowest format, fp4e2m1 with maxpos 3, so that no format overflows
+	for (auto& x : data) x = std::max(-3.0, std::min(3.0, x));
+
+	std::vector<double> expected = { qsnr<Targets>(data)... };
+	for (unsigned threads : { 1u, 2u, 3u }) {
+		auto reports = qsnr_sweep(formats, data, threads, 4096);
+		for (size_t k = 0; k < reports.size(); ++k) {
+			bool pass = std::abs(reports[k].qsnr - expected[k]) < 1.0e-9 * std::abs(expected[k]) && reports[k].count == size(data)
+				&& reports[k].overflows == 0 && reports[k].error_histogram.total() == size(data);
+			if (!pass) {
+				++nrOfFailedTestCases;
+				if (reportTestCases) std::cerr << "FAIL: " << threads << " threads: " << reports[k] << " expected QSNR " << expected[k] << '\n';
+			}
+		}
+	}
+	return nrOfFailedTestCases;
+}
+
+// values beyond the range of a format without saturation are counted as overflows, and values below its
+// smallest value as zeros
+int VerifyRangeCounters(bool reportTestCases) {
+	using namespace sw::universal;
+	int nrOfFailedTestCases = 0;
+	std::vector<double> data = { 1.0, 2.0, 100.0, -100.0, 1.0e-10, 0.0, 0.5 };
+	auto reports = qsnr_sweep<fp4e2m1, posit<8, 2>>(data, 1);
+	// fp4e2m1 does not saturate: the conversion of 100 is infinite, and 1e-10 rounds to zero
+	// posit<8,2> saturates to maxpos 2^24 and does not round to zero
+	bool pass = reports[0].overflows == 2 && reports[0].zeros == 1 && reports[0].max_error == 1.0e-10 && reports[0].count == 5
+		&& reports[1].overflows == 0 && reports[1].zeros == 0 && reports[1].count == 7;
+	if (!pass) {
+		++nrOfFailedTestCases;
+		if (reportTestCases) std::cerr << "FAIL: range counters\n" << reports[0] << '\n' << reports[1] << '\n';
+	}
+	return nrOfFailedTestCases;
+}
+
+int main()
+try {
+	using namespace sw::universal;
+
+	std::string test_suite  = "quantization sweep";
+	std::string test_tag    = "qsnr_sweep";
+	bool reportTestCases    = true;
+	int nrOfFailedTestCases = 0;
+
+	ReportTestSuiteHeader(test_suite, reportTestCases);
+
+#if MANUAL_TESTING
+
+	blas::vector<double> data(1024 * 1024);
+	blas::gaussian_random(data, 0.0, 1.0);
+	for (const auto& report : qsnr_sweep(fp8_formats{}, data)) std::cout << report << '\n';
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return EXIT_SUCCESS;
+#else
+
+#if REGRESSION_LEVEL_1
+	nrOfFailedTestCases += ReportTestResult(VerifyQuantizer<fp8e4m3>(reportTestCases), type_tag(fp8e4m3()), "quantizer");
+	nrOfFailedTestCases += ReportTestResult(VerifyQuantizer<fp8e5m2>(reportTestCases), type_tag(fp8e5m2()), "quantizer");
+	nrOfFailedTestCases += ReportTestResult(VerifyQuantizer<fp6e3m2>(reportTestCases), type_tag(fp6e3m2()), "quantizer");
+	nrOfFailedTestCases += ReportTestResult(VerifyQuantizer<fp6e2m3>(reportTestCases), type_tag(fp6e2m3()), "quantizer");
+	nrOfFailedTestCases += ReportTestResult(VerifyQuantizer<fp4e2m1>(reportTestCases), type_tag(fp4e2m1()), "quantizer");
+	nrOfFailedTestCases += ReportTestResult(VerifyQuantizer<posit<8, 0>>(reportTestCases), type_tag(posit<8, 0>()), "quantizer");
+	nrOfFailedTestCases += ReportTestResult(VerifyQuantizer<posit<8, 2>>(reportTestCases), type_tag(posit<8, 2>()), "quantizer");
+	nrOfFailedTestCases += ReportTestResult(VerifyQuantizer<lns<8, 3>>(reportTestCases), type_tag(lns<8, 3>()), "quantizer");
+	nrOfFailedTestCases += ReportTestResult(VerifyQuantizer<fixpnt<8, 4>>(reportTestCases), type_tag(fixpnt<8, 4>()), "quantizer");
+	nrOfFailedTestCases += ReportTestResult(VerifyQuantizer<takum<8>>(reportTestCases), type_tag(takum<8>()), "quantizer");
+
+	nrOfFailedTestCases += ReportTestResult(VerifySweep(fp8_formats{}, reportTestCases), "8-bit formats", "sweep");
+	nrOfFailedTestCases += ReportTestResult(VerifyRangeCounters(reportTestCases), "fp4e2m1, posit<8,2>", "range counters");
+#endif
+
+#if REGRESSION_LEVEL_2
+	nrOfFailedTestCases += ReportTestResult(VerifyQuantizer<posit<12, 1>>(reportTestCases), type_tag(posit<12, 1>()), "quantizer");
+	nrOfFailedTestCases += ReportTestResult(VerifyQuantizer<half>(reportTestCases), type_tag(half()), "quantizer");
+#endif
+
+#if REGRESSION_LEVEL_3
+
+#endif
+
+#if REGRESSION_LEVEL_4
+
+#endif
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+#endif
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_arithmetic_exception& err) {
+	std::cerr << "Uncaught universal arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_internal_exception& err) {
+	std::cerr << "Uncaught universal internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
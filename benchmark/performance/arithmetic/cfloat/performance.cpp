@@ -336,6 +336,17 @@ void TestConversionPerformance() {
 //	uint64_t NR_OPS = 1000000;
 }
 
+/*
+10/19/2026
+cfloat division, bit-serial significant division versus limb-by-limb division (Knuth algorithm D)
+bit-serial
+cfloat<32,8,uint32_t>    division             32768 per        0.115471sec -> 283 Kops/sec
+cfloat<64,11,uint64_t>   division             32768 per       0.0396414sec -> 826 Kops/sec
+limb-by-limb
+cfloat<32,8,uint32_t>    division             32768 per      0.00880692sec ->   3 Mops/sec
+cfloat<64,11,uint64_t>   division             32768 per       0.0154517sec ->   2 Mops/sec
+*/
+
 // measure performance of arithmetic operators
 void TestArithmeticOperatorPerformance() {
 	using namespace sw::universal;
@@ -377,6 +388,115 @@ void TestArithmeticOperatorPerformance() {
 
 }
 
+// the arithmetic path that cfloats of 16 bits or less used before they received native integer arithmetic
+template<typename Scalar>
+Scalar BlockTripleAdd(const Scalar& lhs, const Scalar& rhs) {
+	using namespace sw::universal;
+	blocktriple<Scalar::fbits, BlockTripleOperator::ADD, typename Scalar::BlockType> a, b, sum;
+	lhs.normalizeAddition(a);
+	rhs.normalizeAddition(b);
+	sum.add(a, b);
+	Scalar c;
+	convert(sum, c);
+	return c;
+}
+template<typename Scalar>
+Scalar BlockTripleMul(const Scalar& lhs, const Scalar& rhs) {
+	using namespace sw::universal;
+	blocktriple<Scalar::fbits, BlockTripleOperator::MUL, typename Scalar::BlockType> a, b, product;
+	lhs.normalizeMultiplication(a);
+	rhs.normalizeMultiplication(b);
+	product.mul(a, b);
+	Scalar c;
+	convert(product, c);
+	return c;
+}
+template<typename Scalar>
+Scalar BlockTripleDiv(const Scalar& lhs, const Scalar& rhs) {
+	using namespace sw::universal;
+	using BlockTriple = blocktriple<Scalar::fbits, BlockTripleOperator::DIV, typename Scalar::BlockType>;
+	BlockTriple a, b, quotient;
+	lhs.normalizeDivision(a);
+	rhs.normalizeDivision(b);
+	quotient.div(a, b);
+	quotient.setradix(BlockTriple::radix);
+	Scalar c;
+	convert(quotient, c);
+	return c;
+}
+
+// run the arithmetic operator, or its blocktriple equivalent, across all finite encodings
+template<typename Scalar, bool native>
+void ArithmeticPathWorkload(size_t NR_OPS) {
+	constexpr size_t NR_ENCODINGS = (1ull << Scalar::nbits);
+	std::vector<Scalar> data;
+	for (size_t i = 0; i < NR_ENCODINGS; ++i) {
+		Scalar v;
+		v.setbits(i);
+		if (!v.isnan() && !v.isinf() && !v.iszero()) data.push_back(v);
+	}
+	size_t N = data.size();
+	Scalar s{ 0 }, p{ 0 }, q{ 0 };
+	uint64_t checksum{ 0 };  // consume the results so that the optimizer can't remove the loop
+	size_t ia{ 0 }, ib{ N / 3 };
+	for (size_t i = 0; i < NR_OPS; ++i) {
+		const Scalar& a = data[ia];
+		const Scalar& b = data[ib];
+		if (++ia == N) ia = 0;
+		ib += 7; if (ib >= N) ib -= N;
+		if constexpr (native) {
+			s = a + b;
+			p = a * b;
+			q = a / b;
+		}
+		else {
+			s = BlockTripleAdd(a, b);
+			p = BlockTripleMul(a, b);
+			q = BlockTripleDiv(a, b);
+		}
+		checksum += uint64_t(s.block(0)) + uint64_t(p.block(0)) + uint64_t(q.block(0));
+	}
+	if (checksum == 0) std::cout << "dummy case to fool the optimizer\n";
+}
+
+/*
+10/19/2026
+cfloat native integer arithmetic versus the blocktriple path: one op is an add, a multiply, and a divide
+cfloat<8,2,uint8_t,t,t,f>  blocktriple    1000000 per        0.339076sec ->   2 Mops/sec
+cfloat<8,2,uint8_t,t,t,f>  native         1000000 per       0.0533176sec ->  18 Mops/sec
+cfloat<8,4,uint8_t,t,f,f>  blocktriple    1000000 per        0.133033sec ->   7 Mops/sec
+cfloat<8,4,uint8_t,t,f,f>  native         1000000 per        0.045639sec ->  21 Mops/sec
+cfloat<8,5,uint8_t,t,f,f>  blocktriple    1000000 per        0.148051sec ->   6 Mops/sec
+cfloat<8,5,uint8_t,t,f,f>  native         1000000 per       0.0468356sec ->  21 Mops/sec
+cfloat<16,5,uint16_t>      blocktriple    1000000 per        0.712487sec ->   1 Mops/sec
+cfloat<16,5,uint16_t>      native         1000000 per       0.0681007sec ->  14 Mops/sec
+cfloat<16,8,uint16_t>      blocktriple    1000000 per        0.187423sec ->   5 Mops/sec
+cfloat<16,8,uint16_t>      native         1000000 per        0.061196sec ->  16 Mops/sec
+*/
+
+// measure the native integer arithmetic of small cfloats against the blocktriple path it bypasses
+void TestNativeArithmeticPerformance() {
+	using namespace sw::universal;
+	std::cout << "classic floating-point cfloat native integer arithmetic versus blocktriple arithmetic\n";
+
+	uint64_t NR_OPS = 1000000;
+	using fp8e2m5   = cfloat<8, 2, uint8_t, true, true, false>;
+	using fp8e4m3   = cfloat<8, 4, uint8_t, true, false, false>;
+	using fp8e5m2   = cfloat<8, 5, uint8_t, true, false, false>;
+	using fp16      = cfloat<16, 5, uint16_t, true, false, false>;
+	using bfloat_t  = cfloat<16, 8, uint16_t, true, false, false>;
+	PerformanceRunner("cfloat<8,2,uint8_t,t,t,f>  blocktriple", ArithmeticPathWorkload< fp8e2m5, false >, NR_OPS);
+	PerformanceRunner("cfloat<8,2,uint8_t,t,t,f>  native     ", ArithmeticPathWorkload< fp8e2m5, true >, NR_OPS);
+	PerformanceRunner("cfloat<8,4,uint8_t,t,f,f>  blocktriple", ArithmeticPathWorkload< fp8e4m3, false >, NR_OPS);
+	PerformanceRunner("cfloat<8,4,uint8_t,t,f,f>  native     ", ArithmeticPathWorkload< fp8e4m3, true >, NR_OPS);
+	PerformanceRunner("cfloat<8,5,uint8_t,t,f,f>  blocktriple", ArithmeticPathWorkload< fp8e5m2, false >, NR_OPS);
+	PerformanceRunner("cfloat<8,5,uint8_t,t,f,f>  native     ", ArithmeticPathWorkload< fp8e5m2, true >, NR_OPS);
+	PerformanceRunner("cfloat<16,5,uint16_t>      blocktriple", ArithmeticPathWorkload< fp16, false >, NR_OPS);
+	PerformanceRunner("cfloat<16,5,uint16_t>      native     ", ArithmeticPathWorkload< fp16, true >, NR_OPS);
+	PerformanceRunner("cfloat<16,8,uint16_t>      blocktriple", ArithmeticPathWorkload< bfloat_t, false >, NR_OPS);
+	PerformanceRunner("cfloat<16,8,uint16_t>      native     ", ArithmeticPathWorkload< bfloat_t, true >, NR_OPS);
+}
+
 // conditional compilation
 #define MANUAL_TESTING 0
 #define STRESS_TESTING 0
@@ -413,6 +533,7 @@ try {
 	TestNormalizePerformance();
 #endif
 	TestArithmeticOperatorPerformance();
+	TestNativeArithmeticPerformance();
 
 #if STRESS_TESTING
 
@@ -0,0 +1,157 @@
+// conversion.cpp: performance of the table and arithmetic conversions of small formats to and from double
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <chrono>
+#include <vector>
+#include <universal/number/cfloat/cfloat.hpp>
+#include <universal/number/posit/posit.hpp>
+#include <universal/number/lns/lns.hpp>
+#include <universal/number/fixpnt/fixpnt.hpp>
+
+// access to the arithmetic conversions, which are protected in lns and fixpnt
+template<typename Number>
+struct ArithmeticConversion : public Number {
+	double decode() const {
+		if constexpr (requires { this->template arithmetic_to_native<double>(); }) return this->template arithmetic_to_native<double>();
+		else if constexpr (requires { this->template arithmetic_to_ieee754<double>(); }) return this->template arithmetic_to_ieee754<double>();
+		else return this->arithmetic_to_double();
+	}
+	void encode(double v) {
+		if constexpr (requires { this->arithmetic_convert_ieee754(v); }) this->arithmetic_convert_ieee754(v);
+		else static_cast<Number&>(*this) = v;
+	}
+};
+
+// the checksums of the workloads are stored so that the conversions are not optimized away
+volatile double checksum{ 0 };
+
+// run a workload and report its rate in conversions per second
+template<typename Workload>
+void MeasureConversion(const std::string& tag, const std::string& kernel, double conversions, Workload&& work) {
+	using namespace std::chrono;
+	steady_clock::time_point begin = steady_clock::now();
+	checksum = work();
+	steady_clock::time_point end = steady_clock::now();
+	double elapsed_time = duration_cast<duration<double>>(end - begin).count();
+	std::cout << std::setw(15) << std::left << tag << std::setw(18) << kernel
+		<< " time " << std::setw(12) << std::right << std::scientific << std::setprecision(3) << elapsed_time << " sec"
+		<< "  rate " << std::setw(12) << conversions / elapsed_time << " conversions/sec\n";
+	std::cout << std::defaultfloat;
+}
+
+template<typename Number>
+void ConversionWorkload(const std::string& tag, size_t N) {
+	constexpr size_t NR_ENCODINGS = size_t(1) << Number::nbits;
+	std::vector<ArithmeticConversion<Number>> encodings(NR_ENCODINGS);
+	for (size_t i = 0; i < NR_ENCODINGS; ++i) encodings[i].setbits(i);
+	std::vector<double> values(N);
+	for (size_t i = 0; i < N; ++i) values[i] = std::sin(double(i)) * double(Number(sw::universal::SpecificValue::maxpos)) * 0.9;
+
+	// generate the tables before measuring
+	double first = double(Number(1.0));
+	MeasureConversion(tag, "decode default", double(N), [&]() {
+		double sum = first;
+		for (size_t i = 0; i < N; ++i) sum += double(static_cast<const Number&>(encodings[i % NR_ENCODINGS]));
+		return sum;
+	});
+	MeasureConversion(tag, "decode arithmetic", double(N), [&]() {
+		double sum = first;
+		for (size_t i = 0; i < N; ++i) sum += encodings[i % NR_ENCODINGS].decode();
+		return sum;
+	});
+	MeasureConversion(tag, "encode default", double(N), [&]() {
+		Number a;
+		double sum{ 0 };
+		for (size_t i = 0; i < N; ++i) {
+			a = values[i];
+			sum += a.sign();
+		}
+		return sum;
+	});
+	MeasureConversion(tag, "encode arithmetic", double(N), [&]() {
+		ArithmeticConversion<Number> a;
+		double sum{ 0 };
+		for (size_t i = 0; i < N; ++i) {
+			a.encode(values[i]);
+			sum += a.sign();
+		}
+		return sum;
+	});
+}
+
+/*
+10/19/2026: single core, 1M conversions of the encodings and of doubles spread over the range
+The default conversion to double is the encoding table for every format. The default conversion from
+double is the table search for posits only, as the search loses to the cfloat, lns, and fixpnt conversions.
+Caching the saturation thresholds of lns made its conversion from double 6x faster. Formats of 16 bits
+tabulate only on request, as their tables take tens of milliseconds to generate, and convert arithmetically.
+
+cfloat<8,4>    decode default     time    3.743e-03 sec  rate    2.672e+08 conversions/sec
+cfloat<8,4>    decode arithmetic  time    1.513e-02 sec  rate    6.611e+07 conversions/sec
+cfloat<8,4>    encode default     time    8.099e-03 sec  rate    1.235e+08 conversions/sec
+cfloat<8,4>    encode arithmetic  time    8.577e-03 sec  rate    1.166e+08 conversions/sec
+cfloat<12,5>   decode default     time    3.863e-03 sec  rate    2.588e+08 conversions/sec
+cfloat<12,5>   decode arithmetic  time    3.782e-02 sec  rate    2.644e+07 conversions/sec
+cfloat<12,5>   encode default     time    7.660e-03 sec  rate    1.305e+08 conversions/sec
+cfloat<12,5>   encode arithmetic  time    8.216e-03 sec  rate    1.217e+08 conversions/sec
+cfloat<12,8>   decode default     time    3.575e-03 sec  rate    2.797e+08 conversions/sec
+cfloat<12,8>   decode arithmetic  time    4.587e-02 sec  rate    2.180e+07 conversions/sec
+cfloat<12,8>   encode default     time    8.122e-03 sec  rate    1.231e+08 conversions/sec
+cfloat<12,8>   encode arithmetic  time    8.248e-03 sec  rate    1.212e+08 conversions/sec
+posit<8,2>     decode default     time    3.671e-03 sec  rate    2.724e+08 conversions/sec
+posit<8,2>     decode arithmetic  time    5.125e-02 sec  rate    1.951e+07 conversions/sec
+posit<8,2>     encode default     time    4.305e-02 sec  rate    2.323e+07 conversions/sec
+posit<8,2>     encode arithmetic  time    2.129e-01 sec  rate    4.698e+06 conversions/sec
+posit<12,2>    decode default     time    3.364e-03 sec  rate    2.973e+08 conversions/sec
+posit<12,2>    decode arithmetic  time    6.677e-02 sec  rate    1.498e+07 conversions/sec
+posit<12,2>    encode default     time    5.921e-02 sec  rate    1.689e+07 conversions/sec
+posit<12,2>    encode arithmetic  time    2.655e-01 sec  rate    3.766e+06 conversions/sec
+lns<12,6>      decode default     time    3.927e-03 sec  rate    2.547e+08 conversions/sec
+lns<12,6>      decode arithmetic  time    9.587e-01 sec  rate    1.043e+06 conversions/sec
+lns<12,6>      encode default     time    3.045e-02 sec  rate    3.284e+07 conversions/sec
+lns<12,6>      encode arithmetic  time    3.043e-02 sec  rate    3.287e+07 conversions/sec
+fixpnt<12,6>   decode default     time    3.801e-03 sec  rate    2.631e+08 conversions/sec
+fixpnt<12,6>   decode arithmetic  time    9.081e-01 sec  rate    1.101e+06 conversions/sec
+fixpnt<12,6>   encode default     time    1.395e-02 sec  rate    7.168e+07 conversions/sec
+fixpnt<12,6>   encode arithmetic  time    1.355e-02 sec  rate    7.381e+07 conversions/sec
+ */
+
+int main()
+try {
+	using namespace sw::universal;
+	std::cout << "conversions/sec of small formats to and from double\n";
+	size_t N = 1000000;
+	ConversionWorkload< cfloat<8, 4, uint8_t, true, false, false> >("cfloat<8,4>", N);
+	ConversionWorkload< cfloat<12, 5, uint16_t, true, false, false> >("cfloat<12,5>", N);
+	ConversionWorkload< cfloat<12, 8, uint16_t, true, false, false> >("cfloat<12,8>", N);
+	ConversionWorkload< posit<8, 2> >("posit<8,2>", N);
+	ConversionWorkload< posit<12, 2> >("posit<12,2>", N);
+	ConversionWorkload< lns<12, 6, uint16_t> >("lns<12,6>", N);
+	ConversionWorkload< fixpnt<12, 6, Modulo, uint16_t> >("fixpnt<12,6>", N);
+
+	return EXIT_SUCCESS;
+}
+catch (char const* msg) {
+	std::cerr << "Caught exception: " << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_arithmetic_exception& err) {
+	std::cerr << "Uncaught universal arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_internal_exception& err) {
+	std::cerr << "Uncaught universal internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
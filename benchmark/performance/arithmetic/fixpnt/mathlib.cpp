@@ -0,0 +1,151 @@
+// mathlib.cpp: performance of the CORDIC math functions of fixpnt against their double shims
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <chrono>
+#include <random>
+#include <vector>
+#include <universal/number/fixpnt/fixpnt.hpp>
+
+// apply a function to every element and report its rate in function evaluations per second
+template<typename Scalar, typename Function>
+double MeasureFunction(const std::vector<Scalar>& x, std::vector<Scalar>& y, Function&& function) {
+	using namespace std::chrono;
+	steady_clock::time_point begin = steady_clock::now();
+	for (size_t i = 0; i < x.size(); ++i) y[i] = function(x[i]);
+	steady_clock::time_point end = steady_clock::now();
+	return double(x.size()) / duration_cast<duration<double>>(end - begin).count();
+}
+
+template<typename Scalar, typename Native, typename Shim>
+void CompareFunction(const std::string& tag, const std::string& op, const std::vector<Scalar>& x, Native&& native, Shim&& shim) {
+	std::vector<Scalar> yn(x.size()), ys(x.size());
+	double nativeRate = MeasureFunction(x, yn, native);
+	double shimRate = MeasureFunction(x, ys, shim);
+	size_t differences = 0;
+	for (size_t i = 0; i < x.size(); ++i) if (!(yn[i] == ys[i])) ++differences;
+	std::cout << std::setw(16) << std::left << tag << std::setw(8) << op << std::right << std::scientific << std::setprecision(3)
+		<< " native " << std::setw(10) << nativeRate << " /sec  double shim " << std::setw(10) << shimRate << " /sec  speedup "
+		<< std::fixed << std::setprecision(1) << std::setw(5) << nativeRate / shimRate << "x  differences " << differences << '\n' << std::defaultfloat;
+}
+
+// the batch sine and cosine against the scalar functions
+template<typename Scalar>
+void CompareBatch(const std::string& tag, const std::vector<Scalar>& x) {
+	using namespace std::chrono;
+	using namespace sw::universal;
+	size_t N = x.size();
+	std::vector<Scalar> s(N), c(N), ss(N), cs(N);
+	steady_clock::time_point begin = steady_clock::now();
+	sincos(x.data(), s.data(), c.data(), N);
+	steady_clock::time_point end = steady_clock::now();
+	double batchRate = double(N) / duration_cast<duration<double>>(end - begin).count();
+	begin = steady_clock::now();
+	for (size_t i = 0; i < N; ++i) {
+		ss[i] = sin(x[i]);
+		cs[i] = cos(x[i]);
+	}
+	end = steady_clock::now();
+	double scalarRate = double(N) / duration_cast<duration<double>>(end - begin).count();
+	size_t differences = 0;
+	for (size_t i = 0; i < N; ++i) if (!(s[i] == ss[i]) || !(c[i] == cs[i])) ++differences;
+	std::cout << std::setw(16) << std::left << tag << std::setw(8) << "sincos" << std::right << std::scientific << std::setprecision(3)
+		<< " batch  " << std::setw(10) << batchRate << " /sec  scalar      " << std::setw(10) << scalarRate << " /sec  speedup "
+		<< std::fixed << std::setprecision(1) << std::setw(5) << batchRate / scalarRate << "x  differences " << differences << '\n' << std::defaultfloat;
+}
+
+template<typename Scalar>
+void CompareMathlib(const std::string& tag, size_t N) {
+	using namespace sw::universal;
+	std::vector<Scalar> x(N), p(N);
+	std::mt19937_64 generator(42);
+	std::uniform_real_distribution<double> distribution(-4.0, 4.0);
+	for (size_t i = 0; i < N; ++i) {
+		x[i] = Scalar(distribution(generator));
+		p[i] = Scalar(std::exp2(distribution(generator)));
+	}
+
+	CompareFunction(tag, "sin", x, [](const Scalar& a) { return sin(a); }, [](const Scalar& a) { return Scalar(std::sin(double(a))); });
+	CompareFunction(tag, "cos", x, [](const Scalar& a) { return cos(a); }, [](const Scalar& a) { return Scalar(std::cos(double(a))); });
+	CompareFunction(tag, "tan", x, [](const Scalar& a) { return tan(a); }, [](const Scalar& a) { return Scalar(std::tan(double(a))); });
+	CompareFunction(tag, "atan", x, [](const Scalar& a) { return atan(a); }, [](const Scalar& a) { return Scalar(std::atan(double(a))); });
+	CompareFunction(tag, "hypot", x, [](const Scalar& a) { return hypot(a, a); }, [](const Scalar& a) { return Scalar(std::hypot(double(a), double(a))); });
+	CompareFunction(tag, "exp", x, [](const Scalar& a) { return exp(a); }, [](const Scalar& a) { return Scalar(std::exp(double(a))); });
+	CompareFunction(tag, "tanh", x, [](const Scalar& a) { return tanh(a); }, [](const Scalar& a) { return Scalar(std::tanh(double(a))); });
+	CompareFunction(tag, "log", p, [](const Scalar& a) { return log(a); }, [](const Scalar& a) { return Scalar(std::log(double(a))); });
+	CompareFunction(tag, "log2", p, [](const Scalar& a) { return log2(a); }, [](const Scalar& a) { return Scalar(std::log2(double(a))); });
+	CompareBatch(tag, x);
+}
+
+/*
+10/19/2026: single core, 256K arguments in [-4, 4], and in [2^-4, 2^4] for the logarithms
+The CORDIC functions are 60 shift-and-add steps in 64-bit integers, while the shims of the wider
+configurations are dominated by the conversions to and from double. The batch sine and cosine run the
+steps over blocks of 64 independent elements, twice the rate of a scalar sin and cos. The differences of
+fixpnt<64,32> are tan near its poles and exp of large arguments, where the double shim loses precision.
+
+fixpnt<16,8>    sin      native  4.143e+06 /sec  double shim  1.232e+06 /sec  speedup   3.4x  differences 0
+fixpnt<16,8>    cos      native  3.969e+06 /sec  double shim  2.424e+06 /sec  speedup   1.6x  differences 0
+fixpnt<16,8>    tan      native  3.743e+06 /sec  double shim  2.679e+06 /sec  speedup   1.4x  differences 0
+fixpnt<16,8>    atan     native  4.612e+06 /sec  double shim  2.797e+06 /sec  speedup   1.6x  differences 0
+fixpnt<16,8>    hypot    native  3.615e+06 /sec  double shim  2.613e+06 /sec  speedup   1.4x  differences 0
+fixpnt<16,8>    exp      native  3.707e+06 /sec  double shim  2.942e+06 /sec  speedup   1.3x  differences 0
+fixpnt<16,8>    tanh     native  3.316e+06 /sec  double shim  2.284e+06 /sec  speedup   1.5x  differences 0
+fixpnt<16,8>    log      native  5.001e+06 /sec  double shim  2.940e+06 /sec  speedup   1.7x  differences 0
+fixpnt<16,8>    log2     native  5.250e+06 /sec  double shim  2.718e+06 /sec  speedup   1.9x  differences 0
+fixpnt<16,8>    sincos   batch   4.055e+06 /sec  scalar       2.173e+06 /sec  speedup   1.9x  differences 0
+fixpnt<32,16>   sin      native  2.760e+06 /sec  double shim  4.616e+05 /sec  speedup   6.0x  differences 0
+fixpnt<32,16>   cos      native  2.527e+06 /sec  double shim  4.378e+05 /sec  speedup   5.8x  differences 0
+fixpnt<32,16>   tan      native  2.744e+06 /sec  double shim  4.449e+05 /sec  speedup   6.2x  differences 0
+fixpnt<32,16>   atan     native  2.875e+06 /sec  double shim  4.338e+05 /sec  speedup   6.6x  differences 0
+fixpnt<32,16>   hypot    native  2.682e+06 /sec  double shim  4.674e+05 /sec  speedup   5.7x  differences 0
+fixpnt<32,16>   exp      native  2.598e+06 /sec  double shim  4.267e+05 /sec  speedup   6.1x  differences 0
+fixpnt<32,16>   tanh     native  2.399e+06 /sec  double shim  4.815e+05 /sec  speedup   5.0x  differences 0
+fixpnt<32,16>   log      native  3.317e+06 /sec  double shim  4.557e+05 /sec  speedup   7.3x  differences 0
+fixpnt<32,16>   log2     native  3.316e+06 /sec  double shim  4.688e+05 /sec  speedup   7.1x  differences 0
+fixpnt<32,16>   sincos   batch   2.343e+06 /sec  scalar       1.174e+06 /sec  speedup   2.0x  differences 0
+fixpnt<64,32>   sin      native  2.367e+06 /sec  double shim  3.673e+05 /sec  speedup   6.4x  differences 0
+fixpnt<64,32>   cos      native  2.384e+06 /sec  double shim  3.687e+05 /sec  speedup   6.5x  differences 0
+fixpnt<64,32>   tan      native  2.482e+06 /sec  double shim  3.830e+05 /sec  speedup   6.5x  differences 22
+fixpnt<64,32>   atan     native  2.854e+06 /sec  double shim  3.671e+05 /sec  speedup   7.8x  differences 0
+fixpnt<64,32>   hypot    native  2.253e+06 /sec  double shim  3.517e+05 /sec  speedup   6.4x  differences 0
+fixpnt<64,32>   exp      native  2.336e+06 /sec  double shim  4.127e+05 /sec  speedup   5.7x  differences 1
+fixpnt<64,32>   tanh     native  2.474e+06 /sec  double shim  4.072e+05 /sec  speedup   6.1x  differences 0
+fixpnt<64,32>   log      native  3.283e+06 /sec  double shim  3.978e+05 /sec  speedup   8.3x  differences 0
+fixpnt<64,32>   log2     native  3.382e+06 /sec  double shim  3.766e+05 /sec  speedup   9.0x  differences 0
+fixpnt<64,32>   sincos   batch   2.559e+06 /sec  scalar       1.242e+06 /sec  speedup   2.1x  differences 0
+ */
+
+int main()
+try {
+	using namespace sw::universal;
+	std::cout << "CORDIC math functions against double shims\n";
+	CompareMathlib< fixpnt<16, 8, Saturate, uint16_t> >("fixpnt<16,8>", 256 * 1024);
+	CompareMathlib< fixpnt<32, 16, Saturate, uint32_t> >("fixpnt<32,16>", 256 * 1024);
+	CompareMathlib< fixpnt<64, 32, Saturate, uint64_t> >("fixpnt<64,32>", 256 * 1024);
+
+	return EXIT_SUCCESS;
+}
+catch (char const* msg) {
+	std::cerr << "Caught exception: " << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_arithmetic_exception& err) {
+	std::cerr << "Uncaught universal arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_internal_exception& err) {
+	std::cerr << "Uncaught universal internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
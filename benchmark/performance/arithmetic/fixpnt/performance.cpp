@@ -76,6 +76,33 @@ void TestArithmeticOperatorPerformance() {
 	PerformanceRunner("fixpnt<128, 32, Saturate, uint32_t>  multiplication ", MultiplicationWorkload< sw::universal::fixpnt<128, 32, Saturate, uint32_t> >, NR_OPS / 2);
 }
 
+/*
+10/19/2026
+fixpnt division, bit-serial restoring division versus limb-by-limb division (Knuth algorithm D)
+bit-serial
+fixpnt< 32, 16, Modulo, uint32_t>  division                32768 per       0.0925693sec -> 353 Kops/sec
+fixpnt< 64, 32, Modulo, uint32_t>  division                32768 per        0.323634sec -> 101 Kops/sec
+fixpnt<128, 32, Modulo, uint32_t>  division                16384 per        0.430237sec ->  38 Kops/sec
+limb-by-limb
+fixpnt< 32, 16, Modulo, uint32_t>  division                32768 per      0.00676185sec ->   4 Mops/sec
+fixpnt< 64, 32, Modulo, uint32_t>  division                32768 per       0.0130403sec ->   2 Mops/sec
+fixpnt<128, 32, Modulo, uint32_t>  division                16384 per       0.0104652sec ->   1 Mops/sec
+*/
+
+// measure performance of the division operator: Saturate division is not implemented yet, so measure Modulo
+void TestDivisionOperatorPerformance() {
+	using namespace sw::universal;
+	std::cout << "\nFIXPNT Fixed-Point Modulo division performance\n";
+
+	uint64_t NR_OPS = 1024 * 32;
+	PerformanceRunner("fixpnt<  8,  4, Modulo, uint8_t >  division          ", DivisionWorkload< sw::universal::fixpnt<  8,  4, Modulo, uint8_t> >, NR_OPS);
+	PerformanceRunner("fixpnt< 16,  8, Modulo, uint16_t>  division          ", DivisionWorkload< sw::universal::fixpnt< 16,  8, Modulo, uint16_t> >, NR_OPS);
+	PerformanceRunner("fixpnt< 32, 16, Modulo, uint32_t>  division          ", DivisionWorkload< sw::universal::fixpnt< 32, 16, Modulo, uint32_t> >, NR_OPS);
+	PerformanceRunner("fixpnt< 64, 32, Modulo, uint32_t>  division          ", DivisionWorkload< sw::universal::fixpnt< 64, 32, Modulo, uint32_t> >, NR_OPS);
+	PerformanceRunner("fixpnt<128, 32, Modulo, uint32_t>  division          ", DivisionWorkload< sw::universal::fixpnt<128, 32, Modulo, uint32_t> >, NR_OPS / 2);
+	PerformanceRunner("fixpnt<256, 64, Modulo, uint32_t>  division          ", DivisionWorkload< sw::universal::fixpnt<256, 64, Modulo, uint32_t> >, NR_OPS / 4);
+}
+
 // conditional compilation
 #define MANUAL_TESTING 0
 #define STRESS_TESTING 0
@@ -90,6 +117,7 @@ try {
 
 	TestShiftOperatorPerformance();
 	TestArithmeticOperatorPerformance();
+	TestDivisionOperatorPerformance();
 
 	std::cout << "done" << std::endl;
 
@@ -101,6 +129,7 @@ try {
 	   
 	TestShiftOperatorPerformance();
 	TestArithmeticOperatorPerformance();
+	TestDivisionOperatorPerformance();
 
 #if STRESS_TESTING
 
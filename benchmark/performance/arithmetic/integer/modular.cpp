@@ -0,0 +1,101 @@
+// modular.cpp: performance of RSA-style modular exponentiation of fixed-size integers
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <chrono>
+#include <random>
+#include <vector>
+#include <universal/number/integer/integer.hpp>
+
+// square and multiply with a reduction by operator% of the double-width product, as the reference
+template<unsigned nbits>
+sw::universal::integer<nbits, uint32_t> remainderPowMod(const sw::universal::integer<nbits, uint32_t>& base, const sw::universal::integer<nbits, uint32_t>& exponent, const sw::universal::integer<nbits, uint32_t>& modulus) {
+	using Wide = sw::universal::integer<2 * nbits, uint32_t>;
+	Wide m(modulus), x(base), r(1);
+	for (int i = static_cast<int>(nbits) - 1; i >= 0; --i) {
+		r = (r * r) % m;
+		if (exponent.at(static_cast<unsigned>(i))) r = (r * x) % m;
+	}
+	return sw::universal::integer<nbits, uint32_t>(r);
+}
+
+// random odd integers of nbits - 1 bits, which are positive in the signed integer<nbits>
+template<unsigned nbits>
+sw::universal::integer<nbits, uint32_t> RandomOddInteger(std::mt19937_64& generator) {
+	sw::universal::integer<nbits, uint32_t> a(0);
+	for (unsigned i = 0; i < nbits - 1; ++i) a.setbit(i, (generator() & 1) != 0);
+	a.setbit(nbits - 2);
+	a.setbit(0);
+	return a;
+}
+
+template<typename Function>
+double Seconds(Function&& function) {
+	using namespace std::chrono;
+	steady_clock::time_point begin = steady_clock::now();
+	function();
+	steady_clock::time_point end = steady_clock::now();
+	return duration_cast<duration<double>>(end - begin).count();
+}
+
+// throughput of full-width exponentiations modulo an (nbits - 1)-bit odd modulus, the private key operation
+// of RSA without the Chinese remainder theorem
+template<unsigned nbits>
+void MeasureModularExponentiation(size_t N, size_t nrReference, std::mt19937_64& generator) {
+	using namespace sw::universal;
+	using Integer = integer<nbits, uint32_t>;
+	Integer m = RandomOddInteger<nbits>(generator);
+	std::vector<Integer> bases(N), exponents(N), results(N);
+	for (size_t i = 0; i < N; ++i) {
+		bases[i] = RandomOddInteger<nbits>(generator) % m;
+		exponents[i] = RandomOddInteger<nbits>(generator);
+	}
+	montgomery<nbits, uint32_t> mg(m);
+	barrett<nbits, uint32_t> br(m);
+	bool agree = true;
+	double referenceTime = Seconds([&]() { for (size_t i = 0; i < nrReference; ++i) results[i] = remainderPowMod(bases[i], exponents[i], m); });
+	double montgomeryTime = Seconds([&]() { for (size_t i = 0; i < N; ++i) agree &= (mg.pow(bases[i], exponents[i]) == results[i] || i >= nrReference); });
+	double constantTime = Seconds([&]() { for (size_t i = 0; i < N; ++i) agree &= (mg.pow_ct(bases[i], exponents[i]) == results[i] || i >= nrReference); });
+	double barrettTime = Seconds([&]() { for (size_t i = 0; i < N; ++i) agree &= (br.pow(bases[i], exponents[i]) == results[i] || i >= nrReference); });
+	std::cout << "integer<" << std::setw(4) << nbits << ">  modexp/sec  operator% " << std::scientific << std::setprecision(3) << std::setw(10) << nrReference / referenceTime
+		<< "  montgomery " << std::setw(10) << N / montgomeryTime << "  constant-time " << std::setw(10) << N / constantTime
+		<< "  barrett " << std::setw(10) << N / barrettTime << "  speedup " << std::fixed << std::setprecision(1)
+		<< (referenceTime / nrReference) / (montgomeryTime / N) << "x  agree " << (agree ? "yes" : "no") << '\n' << std::defaultfloat;
+}
+
+/*
+10/19/2026: single core of a virtualized x86-64 host, g++ -O2
+
+RSA-style modular exponentiation performance
+integer< 512>  modexp/sec  operator%  4.717e+02  montgomery  4.499e+03  constant-time  3.312e+03  barrett  2.672e+03  speedup 9.5x  agree yes
+integer<1024>  modexp/sec  operator%  7.560e+01  montgomery  6.175e+02  constant-time  5.473e+02  barrett  4.686e+02  speedup 8.2x  agree yes
+integer<2048>  modexp/sec  operator%  9.338e+00  montgomery  8.879e+01  constant-time  7.652e+01  barrett  6.455e+01  speedup 9.5x  agree yes
+ */
+
+int main()
+try {
+	using namespace sw::universal;
+	std::mt19937_64 generator(42);
+
+	std::cout << "RSA-style modular exponentiation performance\n";
+	MeasureModularExponentiation< 512>(256, 16, generator);
+	MeasureModularExponentiation<1024>(64, 8, generator);
+	MeasureModularExponentiation<2048>(16, 2, generator);
+
+	return EXIT_SUCCESS;
+}
+catch (char const* msg) {
+	std::cerr << "Caught exception: " << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
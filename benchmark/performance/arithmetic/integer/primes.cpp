@@ -0,0 +1,169 @@
+// primes.cpp: performance of primality testing, prime sieving, and factorization of arbitrary precision integers
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <chrono>
+#include <random>
+#include <vector>
+#include <universal/number/integer/integer.hpp>
+
+// the trial division by 6k +- 1 that isPrime used to run, as the reference
+template<typename IntegerType>
+bool trialDivisionIsPrime(const IntegerType& a) {
+	if (a <= 1) return false;
+	if (a <= 3) return true;
+	if (a % 2 == 0 || a % 3 == 0) return false;
+	for (IntegerType i = 5; i * i <= a; i += 6) if ((a % i) == 0 || a % (i + 2) == 0) return false;
+	return true;
+}
+
+// uniformly distributed odd integers of exactly the given number of bits
+template<typename Integer>
+std::vector<Integer> RandomOddIntegers(unsigned bits, size_t N, std::mt19937_64& generator) {
+	std::vector<Integer> v(N);
+	for (auto& a : v) {
+		a = 0;
+		for (unsigned i = 0; i < bits; i += 32) {
+			a <<= 32;
+			a += Integer(generator() & 0xFFFF'FFFFull);
+		}
+		for (unsigned i = bits; i < Integer::nbits; ++i) a.setbit(i, false);
+		a.setbit(bits - 1);
+		a.setbit(0);
+	}
+	return v;
+}
+
+template<typename Function>
+double Seconds(Function&& function) {
+	using namespace std::chrono;
+	steady_clock::time_point begin = steady_clock::now();
+	function();
+	steady_clock::time_point end = steady_clock::now();
+	return duration_cast<duration<double>>(end - begin).count();
+}
+
+// rate of isPrime on random odd candidates, which trial division mostly rejects, and on primes, which run the full
+// Baillie-PSW test: the values have nbits - 1 bits to stay positive in the signed integer<nbits>
+template<unsigned nbits>
+void MeasurePrimality(size_t N, std::mt19937_64& generator) {
+	using namespace sw::universal;
+	using Integer = integer<nbits, uint32_t>;
+	std::vector<Integer> candidates = RandomOddIntegers<Integer>(nbits - 1, N, generator);
+	std::vector<Integer> primes;
+	for (auto a : candidates) {
+		while (!isPrime(a)) a += 2;
+		primes.push_back(a);
+	}
+	size_t count = 0;
+	double candidateTime = Seconds([&]() { for (const auto& a : candidates) count += isPrime(a); });
+	double primeTime = Seconds([&]() { for (const auto& a : primes) count += isPrime(a); });
+	std::cout << "integer<" << std::setw(4) << nbits << ">  isPrime  candidates " << std::scientific << std::setprecision(3) << std::setw(10) << N / candidateTime
+		<< " /sec  primes " << std::setw(10) << N / primeTime << " /sec  (" << count - N << " primes among " << N << " candidates)\n" << std::defaultfloat;
+}
+
+// the Baillie-PSW test against trial division on primes, where trial division has to run to sqrt(a)
+void CompareTrialDivision(unsigned bits, size_t N, std::mt19937_64& generator) {
+	using namespace sw::universal;
+	using Integer = integer<64, uint32_t>;
+	std::vector<Integer> primes = RandomOddIntegers<Integer>(bits, N, generator);
+	for (auto& a : primes) while (!isPrime(a)) a += 2;
+	size_t bpsw = 0, trial = 0;
+	double bpswTime = Seconds([&]() { for (const auto& a : primes) bpsw += isPrime(a); });
+	double trialTime = Seconds([&]() { for (const auto& a : primes) trial += trialDivisionIsPrime(a); });
+	std::cout << std::setw(5) << bits << "-bit  primes   Baillie-PSW " << std::scientific << std::setprecision(3) << std::setw(10) << N / bpswTime
+		<< " /sec  trial division " << std::setw(10) << N / trialTime << " /sec  speedup " << std::fixed << std::setprecision(1)
+		<< trialTime / bpswTime << "x  agree " << (bpsw == trial ? "yes" : "no") << '\n' << std::defaultfloat;
+}
+
+void MeasureSieve(std::uint64_t low, std::uint64_t high) {
+	using namespace sw::universal;
+	size_t count1 = 0, countN = 0;
+	double t1 = Seconds([&]() { count1 = segmentedSieve(low, high, 1).size(); });
+	double tN = Seconds([&]() { countN = segmentedSieve(low, high).size(); });
+	std::cout << "segmented sieve of [" << low << ", " << high << ")  " << count1 << " primes  1 thread " << std::fixed << std::setprecision(3)
+		<< t1 << " sec  " << hardware_threads() << " threads " << tN << " sec  " << (count1 == countN ? "" : "MISMATCH") << '\n' << std::defaultfloat;
+}
+
+// time to factor the product of two random primes of the given number of bits
+void MeasureFactorization(unsigned bits, size_t N, std::mt19937_64& generator) {
+	using namespace sw::universal;
+	using Integer = integer<256, uint32_t>;
+	std::vector<Integer> p = RandomOddIntegers<Integer>(bits, N, generator), q = RandomOddIntegers<Integer>(bits, N, generator);
+	std::vector<Integer> semiprimes;
+	for (size_t i = 0; i < N; ++i) {
+		while (!isPrime(p[i])) p[i] += 2;
+		while (!isPrime(q[i])) q[i] += 2;
+		semiprimes.push_back(p[i] * q[i]);
+	}
+	size_t nrFactored = 0;
+	double t = Seconds([&]() {
+		for (const auto& n : semiprimes) {
+			primefactors<Integer> factors;
+			primeFactorization(n, factors);
+			if (factors.size() == 2 || (factors.size() == 1 && factors[0].second == 2)) ++nrFactored;
+		}
+	});
+	std::cout << std::setw(5) << 2 * bits << "-bit  semiprimes of " << bits << "-bit factors  " << std::fixed << std::setprecision(4)
+		<< t / N << " sec per factorization  (" << nrFactored << '/' << N << " factored)\n" << std::defaultfloat;
+}
+
+/*
+10/19/2026: single core of a virtualized x86-64 host, g++ -O2
+
+Primality testing, prime sieving, and factorization performance
+integer<  64>  isPrime  candidates  6.232e+05 /sec  primes  6.123e+04 /sec  (44 primes among 1024 candidates)
+integer< 128>  isPrime  candidates  2.880e+05 /sec  primes  2.088e+04 /sec  (21 primes among 1024 candidates)
+integer< 256>  isPrime  candidates  8.556e+04 /sec  primes  4.923e+03 /sec  (2 primes among 256 candidates)
+integer< 512>  isPrime  candidates  1.565e+04 /sec  primes  9.065e+02 /sec  (0 primes among 64 candidates)
+integer<1024>  isPrime  candidates  1.334e+03 /sec  primes  1.431e+02 /sec  (0 primes among 16 candidates)
+   32-bit  primes   Baillie-PSW  9.771e+04 /sec  trial division  1.045e+03 /sec  speedup 93.5x  agree yes
+   40-bit  primes   Baillie-PSW  1.248e+05 /sec  trial division  7.201e+01 /sec  speedup 1733.5x  agree yes
+segmented sieve of [0, 100000000)  5761455 primes  1 thread 0.293 sec  1 threads 0.288 sec
+segmented sieve of [1000000000000, 1000100000000)  3618282 primes  1 thread 0.478 sec  1 threads 0.507 sec
+   48-bit  semiprimes of 24-bit factors  0.0002 sec per factorization  (16/16 factored)
+   64-bit  semiprimes of 32-bit factors  0.0042 sec per factorization  (16/16 factored)
+   80-bit  semiprimes of 40-bit factors  0.1125 sec per factorization  (16/16 factored)
+   96-bit  semiprimes of 48-bit factors  0.7732 sec per factorization  (16/16 factored)
+ */
+
+int main()
+try {
+	using namespace sw::universal;
+	std::mt19937_64 generator(42);
+
+	std::cout << "Primality testing, prime sieving, and factorization performance\n";
+	MeasurePrimality<  64>(1024, generator);
+	MeasurePrimality< 128>(1024, generator);
+	MeasurePrimality< 256>(256, generator);
+	MeasurePrimality< 512>(64, generator);
+	MeasurePrimality<1024>(16, generator);
+
+	CompareTrialDivision(32, 256, generator);
+	CompareTrialDivision(40, 16, generator);
+
+	MeasureSieve(0, 100'000'000);
+	MeasureSieve(1'000'000'000'000ull, 1'000'100'000'000ull);
+
+	MeasureFactorization(24, 16, generator);
+	MeasureFactorization(32, 16, generator);
+	MeasureFactorization(40, 16, generator);
+	MeasureFactorization(48, 16, generator);
+
+	return EXIT_SUCCESS;
+}
+catch (char const* msg) {
+	std::cerr << "Caught exception: " << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
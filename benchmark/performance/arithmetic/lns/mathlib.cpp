@@ -0,0 +1,126 @@
+// mathlib.cpp: performance of the exponent arithmetic math functions of lns and dbns against their double shims
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <chrono>
+#include <random>
+#include <vector>
+#include <universal/number/lns/lns.hpp>
+#include <universal/number/dbns/dbns.hpp>
+
+// apply a function to every element and report its rate in function evaluations per second
+template<typename Scalar, typename Function>
+double MeasureFunction(const std::vector<Scalar>& x, std::vector<Scalar>& y, Function&& function) {
+	using namespace std::chrono;
+	steady_clock::time_point begin = steady_clock::now();
+	for (size_t i = 0; i < x.size(); ++i) y[i] = function(x[i]);
+	steady_clock::time_point end = steady_clock::now();
+	return double(x.size()) / duration_cast<duration<double>>(end - begin).count();
+}
+
+template<typename Scalar, typename Native, typename Shim>
+void CompareFunction(const std::string& tag, const std::string& op, const std::vector<Scalar>& x, Native&& native, Shim&& shim) {
+	std::vector<Scalar> yn(x.size()), ys(x.size());
+	double nativeRate = MeasureFunction(x, yn, native);
+	double shimRate = MeasureFunction(x, ys, shim);
+	size_t differences = 0;
+	for (size_t i = 0; i < x.size(); ++i) if (!(yn[i] == ys[i]) && !(yn[i].isnan() && ys[i].isnan())) ++differences;
+	std::cout << std::setw(12) << std::left << tag << std::setw(8) << op << std::right << std::scientific << std::setprecision(3)
+		<< " native " << std::setw(10) << nativeRate << " /sec  double shim " << std::setw(10) << shimRate << " /sec  speedup "
+		<< std::fixed << std::setprecision(1) << std::setw(5) << nativeRate / shimRate << "x  differences " << differences << '\n' << std::defaultfloat;
+}
+
+template<typename Scalar>
+void CompareMathlib(const std::string& tag, size_t N) {
+	using namespace sw::universal;
+	std::vector<Scalar> x(N);
+	std::mt19937_64 generator(42);
+	std::uniform_real_distribution<double> distribution(-8.0, 8.0);
+	for (size_t i = 0; i < N; ++i) x[i] = Scalar(std::exp2(distribution(generator)));
+
+	CompareFunction(tag, "sqrt", x, [](const Scalar& a) { return sqrt(a); }, [](const Scalar& a) { return Scalar(std::sqrt(double(a))); });
+	CompareFunction(tag, "cbrt", x, [](const Scalar& a) { return cbrt(a); }, [](const Scalar& a) { return Scalar(std::cbrt(double(a))); });
+	CompareFunction(tag, "rsqrt", x, [](const Scalar& a) { return rsqrt(a); }, [](const Scalar& a) { return Scalar(1.0 / std::sqrt(double(a))); });
+	CompareFunction(tag, "pow", x, [](const Scalar& a) { return pow(a, 3); }, [](const Scalar& a) { return Scalar(std::pow(double(a), 3.0)); });
+	CompareFunction(tag, "hypot", x, [](const Scalar& a) { return hypot(a, a); }, [](const Scalar& a) { return Scalar(std::hypot(double(a), double(a))); });
+	CompareFunction(tag, "exp2", x, [](const Scalar& a) { return exp2(a); }, [](const Scalar& a) { return Scalar(std::exp2(double(a))); });
+	CompareFunction(tag, "log", x, [](const Scalar& a) { return log(a); }, [](const Scalar& a) { return Scalar(std::log(double(a))); });
+	CompareFunction(tag, "log2", x, [](const Scalar& a) { return log2(a); }, [](const Scalar& a) { return Scalar(std::log2(double(a))); });
+}
+
+/*
+10/19/2026: single core, 1M lns and 64K dbns arguments in [2^-8, 2^8]
+The lns roots, powers, and reciprocals are integer arithmetic on the exponent field, and the logarithms
+read the field directly: both avoid the conversion to and from double, which dominates the shims of
+lns<32,16>. The differences of sqrt and rsqrt are the ties of odd exponent fields, which the native
+functions round to even. The dbns functions still search the exponent pair of the result, which costs
+as much as the conversion of the shim, so there is little to gain.
+
+lns<16,8>   sqrt     native  2.897e+07 /sec  double shim  2.581e+06 /sec  speedup  11.2x  differences 50401
+lns<16,8>   cbrt     native  3.203e+07 /sec  double shim  3.931e+06 /sec  speedup   8.1x  differences 0
+lns<16,8>   rsqrt    native  2.967e+07 /sec  double shim  5.153e+06 /sec  speedup   5.8x  differences 69519
+lns<16,8>   pow      native  1.034e+08 /sec  double shim  4.481e+06 /sec  speedup  23.1x  differences 0
+lns<16,8>   hypot    native  1.305e+07 /sec  double shim  5.069e+06 /sec  speedup   2.6x  differences 0
+lns<16,8>   exp2     native  1.769e+07 /sec  double shim  5.593e+06 /sec  speedup   3.2x  differences 0
+lns<16,8>   log      native  6.294e+06 /sec  double shim  4.884e+06 /sec  speedup   1.3x  differences 0
+lns<16,8>   log2     native  5.856e+06 /sec  double shim  4.217e+06 /sec  speedup   1.4x  differences 0
+lns<32,16>  sqrt     native  2.181e+07 /sec  double shim  2.736e+05 /sec  speedup  79.7x  differences 53691
+lns<32,16>  cbrt     native  2.215e+07 /sec  double shim  2.697e+05 /sec  speedup  82.1x  differences 0
+lns<32,16>  rsqrt    native  2.382e+07 /sec  double shim  2.818e+05 /sec  speedup  84.5x  differences 71134
+lns<32,16>  pow      native  8.222e+07 /sec  double shim  2.822e+05 /sec  speedup 291.4x  differences 0
+lns<32,16>  hypot    native  1.089e+07 /sec  double shim  1.567e+05 /sec  speedup  69.5x  differences 0
+lns<32,16>  exp2     native  2.227e+07 /sec  double shim  3.096e+05 /sec  speedup  71.9x  differences 0
+lns<32,16>  log      native  5.768e+06 /sec  double shim  3.020e+05 /sec  speedup  19.1x  differences 0
+lns<32,16>  log2     native  5.750e+06 /sec  double shim  3.039e+05 /sec  speedup  18.9x  differences 0
+dbns<8,3>   sqrt     native  4.695e+06 /sec  double shim  2.839e+06 /sec  speedup   1.7x  differences 0
+dbns<8,3>   cbrt     native  2.703e+06 /sec  double shim  1.983e+06 /sec  speedup   1.4x  differences 0
+dbns<8,3>   rsqrt    native  2.856e+06 /sec  double shim  4.241e+06 /sec  speedup   0.7x  differences 0
+dbns<8,3>   pow      native  4.744e+06 /sec  double shim  2.494e+06 /sec  speedup   1.9x  differences 0
+dbns<8,3>   hypot    native  2.680e+06 /sec  double shim  2.567e+06 /sec  speedup   1.0x  differences 0
+dbns<8,3>   exp2     native  1.682e+06 /sec  double shim  1.819e+06 /sec  speedup   0.9x  differences 0
+dbns<8,3>   log      native  2.755e+06 /sec  double shim  2.744e+06 /sec  speedup   1.0x  differences 0
+dbns<8,3>   log2     native  2.848e+06 /sec  double shim  2.798e+06 /sec  speedup   1.0x  differences 0
+dbns<12,5>  sqrt     native  1.404e+06 /sec  double shim  1.395e+06 /sec  speedup   1.0x  differences 0
+dbns<12,5>  cbrt     native  1.329e+06 /sec  double shim  1.109e+06 /sec  speedup   1.2x  differences 0
+dbns<12,5>  rsqrt    native  1.451e+06 /sec  double shim  1.728e+06 /sec  speedup   0.8x  differences 0
+dbns<12,5>  pow      native  1.153e+06 /sec  double shim  1.077e+06 /sec  speedup   1.1x  differences 0
+dbns<12,5>  hypot    native  9.140e+05 /sec  double shim  1.022e+06 /sec  speedup   0.9x  differences 1602
+dbns<12,5>  exp2     native  6.689e+05 /sec  double shim  7.565e+05 /sec  speedup   0.9x  differences 0
+dbns<12,5>  log      native  1.602e+06 /sec  double shim  1.300e+06 /sec  speedup   1.2x  differences 0
+dbns<12,5>  log2     native  1.379e+06 /sec  double shim  1.388e+06 /sec  speedup   1.0x  differences 0
+ */
+
+int main()
+try {
+	using namespace sw::universal;
+	std::cout << "exponent arithmetic math functions against double shims\n";
+	CompareMathlib< lns<16, 8> >("lns<16,8>", 1024 * 1024);
+	CompareMathlib< lns<32, 16> >("lns<32,16>", 1024 * 1024);
+	CompareMathlib< dbns<8, 3> >("dbns<8,3>", 64 * 1024);
+	CompareMathlib< dbns<12, 5> >("dbns<12,5>", 64 * 1024);
+
+	return EXIT_SUCCESS;
+}
+catch (char const* msg) {
+	std::cerr << "Caught exception: " << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_arithmetic_exception& err) {
+	std::cerr << "Uncaught universal arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_internal_exception& err) {
+	std::cerr << "Uncaught universal internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
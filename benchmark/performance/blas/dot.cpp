@@ -4,6 +4,8 @@
 //
 // This file is part of the universal numbers project, which is released under an MIT Open Source license.
 #include <universal/utility/directives.hpp>
+#include <chrono>
+#include <random>
 
 // enable the following define to show the intermediate steps in the fused-dot product
 // #define ALGORITHM_VERBOSE_OUTPUT
@@ -18,7 +20,50 @@
 #define POSIT_THROW_ARITHMETIC_EXCEPTION 1
 #include <universal/number/posit/posit.hpp>
 #include <universal/number/edecimal/edecimal.hpp>
+#include <universal/number/cfloat/cfloat.hpp>
 #include <universal/blas/blas.hpp>
+#include <universal/benchmark/performance_runner.hpp>
+
+// dot product throughput of the execution policies from 1 to all hardware threads
+// The ParallelDeterministic policy must produce the same bits for every thread count.
+template<typename Scalar>
+void DotScaling(const std::string& tag, size_t N) {
+	using namespace sw::universal;
+	using namespace sw::universal::blas;
+	using namespace std::chrono;
+	using Vector = sw::universal::blas::vector<Scalar>;
+
+	Vector x(N), y(N);
+	std::mt19937_64 generator(42);
+	std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+	for (size_t i = 0; i < N; ++i) {
+		x[i] = Scalar(distribution(generator));
+		y[i] = Scalar(distribution(generator));
+	}
+
+	std::vector<unsigned> threadCounts;
+	for (unsigned nrThreads = 1; nrThreads < hardware_threads(); nrThreads *= 2) threadCounts.push_back(nrThreads);
+	threadCounts.push_back(hardware_threads());
+
+	auto measure = [&](ExecutionPolicy policy, const std::string& label, unsigned nrThreads) {
+		steady_clock::time_point begin = steady_clock::now();
+		Scalar result = dot(policy, x, y, nrThreads);
+		steady_clock::time_point end = steady_clock::now();
+		double elapsed_time = duration_cast<duration<double>>(end - begin).count();
+		std::cout << std::setw(20) << std::left << tag << std::setw(24) << label << " threads " << std::setw(3) << nrThreads
+			<< std::setw(15) << std::right << elapsed_time << "sec -> " << toPowerOfTen(double(N) / elapsed_time) << "FMAs/sec\n";
+		return result;
+	};
+	measure(ExecutionPolicy::Serial, "serial", 1);
+	for (auto nrThreads : threadCounts) measure(ExecutionPolicy::Parallel, "parallel", nrThreads);
+	Scalar reference = measure(ExecutionPolicy::ParallelDeterministic, "parallel deterministic", 1);
+	bool reproducible = true;
+	for (auto nrThreads : threadCounts) {
+		if (nrThreads == 1) continue;
+		if (measure(ExecutionPolicy::ParallelDeterministic, "parallel deterministic", nrThreads) != reference) reproducible = false;
+	}
+	std::cout << tag << " parallel deterministic results are " << (reproducible ? "reproducible" : "NOT reproducible") << " across thread counts\n";
+}
 
 int main()
 try {
@@ -47,6 +92,12 @@ try {
 
 	std::cout << std::setprecision(prec);
 
+	std::cout << "\ndot product scaling\n";
+	DotScaling<float>("float", 4 * SIZE_1M);
+	DotScaling<double>("double", 4 * SIZE_1M);
+	DotScaling< cfloat<16, 5, uint16_t, true, false, false> >("cfloat<16,5>", SIZE_1M);
+	DotScaling< posit<32, 2> >("posit<32,2>", SIZE_1M);
+
 	return EXIT_SUCCESS;
 }
 catch (char const* msg) {
@@ -0,0 +1,142 @@
+// einsum.cpp: performance of tensor contractions lowered to the tiled matrix product, and of fused elementwise operators
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <chrono>
+#include <random>
+#include <universal/number/cfloat/cfloat.hpp>
+#include <universal/number/posit/posit.hpp>
+#include <universal/blas/blas.hpp>
+
+template<typename Function>
+double Seconds(Function&& function) {
+	using namespace std::chrono;
+	steady_clock::time_point begin = steady_clock::now();
+	function();
+	steady_clock::time_point end = steady_clock::now();
+	return duration_cast<duration<double>>(end - begin).count();
+}
+
+template<typename Scalar>
+void RandomFill(sw::universal::blas::tensor<Scalar>& T, std::mt19937_64& generator) {
+	std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+	for (auto& e : T) e = Scalar(distribution(generator));
+}
+
+// the N x N matrix product as einsum on tensors against the triple loop of blas::matrix, and einsum on a transposed view
+template<typename Scalar>
+void MeasureMatmul(const std::string& tag, size_t N, std::mt19937_64& generator) {
+	using namespace sw::universal::blas;
+	tensor<Scalar> A({ N, N }), B({ N, N });
+	RandomFill(A, generator);
+	RandomFill(B, generator);
+	matrix<Scalar> MA(N, N), MB(N, N);
+	for (size_t i = 0; i < N; ++i) for (size_t j = 0; j < N; ++j) { MA(i, j) = A(i, j); MB(i, j) = B(i, j); }
+	tensor<Scalar> C;
+	matrix<Scalar> MC;
+	double loopTime = Seconds([&]() { MC = MA * MB; });
+	double einsumTime = Seconds([&]() { C = einsum("ij,jk->ik", A, B); });
+	double transposedTime = Seconds([&]() { C = einsum("ji,jk->ik", A.transpose(), B); });
+	double flops = 2.0 * double(N) * double(N) * double(N);
+	std::cout << std::setw(14) << std::left << tag << std::right << " N = " << std::setw(4) << N << "  triple loop " << std::scientific << std::setprecision(3)
+		<< flops / loopTime << " flops/sec  einsum " << flops / einsumTime << " flops/sec  transposed view " << flops / transposedTime
+		<< " flops/sec  speedup " << std::fixed << std::setprecision(1) << loopTime / einsumTime << "x\n" << std::defaultfloat;
+}
+
+// a batch of small matrix products and a double contraction, against einsum's direct loop nest on the same operands
+template<typename Scalar>
+void MeasureContractions(const std::string& tag, std::mt19937_64& generator) {
+	using namespace sw::universal::blas;
+	tensor<Scalar> X({ 32, 64, 64 }), Y({ 32, 64, 64 }), Z({ 64, 16, 64 });
+	RandomFill(X, generator);
+	RandomFill(Y, generator);
+	RandomFill(Z, generator);
+	tensor<Scalar> C;
+	auto direct = [](const std::string& spec, const tensor<Scalar>& a, const tensor<Scalar>& b) {
+		// a repeated dummy letter of extent 1 forces the direct loop nest
+		tensor_view<const Scalar> va = a.view().reshape({ a.extent(0), a.extent(1), a.extent(2), 1, 1 }), vb = b.view();
+		size_t comma = spec.find(',');
+		return einsum(spec.substr(0, comma) + "zz" + spec.substr(comma), va, vb);
+	};
+	double batchedTime = Seconds([&]() { C = einsum("bij,bjk->bik", X, Y); });
+	double batchedDirect = Seconds([&]() { C = direct("bij,bjk->bik", X, Y); });
+	double doubleTime = Seconds([&]() { C = einsum("ijk,jlk->il", X, Z); });
+	double doubleDirect = Seconds([&]() { C = direct("ijk,jlk->il", X, Z); });
+	std::cout << std::setw(14) << std::left << tag << std::right << " bij,bjk->bik  lowered " << std::fixed << std::setprecision(4) << batchedTime << " sec  direct "
+		<< batchedDirect << " sec    ijk,jlk->il  lowered " << doubleTime << " sec  direct " << doubleDirect << " sec\n" << std::defaultfloat;
+}
+
+// relu(x * s + b) fused in one pass against the same expression with tensor temporaries
+template<typename Scalar>
+void MeasureFusion(const std::string& tag, std::mt19937_64& generator) {
+	using namespace sw::universal::blas;
+	tensor<Scalar> X({ 256, 1024 }), S({ 256, 1024 }), b({ 256, 1024 });
+	RandomFill(X, generator);
+	RandomFill(S, generator);
+	RandomFill(b, generator);
+	tensor<Scalar> Y;
+	double unfusedTime = Seconds([&]() {
+		tensor<Scalar> T = (X % S) + b;
+		Y = elementwise([](Scalar t) { return (t > Scalar(0) ? t : Scalar(0)); }, T);
+	});
+	double fusedTime = Seconds([&]() {
+		Y = elementwise([](Scalar x, Scalar s, Scalar c) { Scalar t = x * s + c; return (t > Scalar(0) ? t : Scalar(0)); }, X, S, b);
+	});
+	std::cout << std::setw(14) << std::left << tag << std::right << " relu(x * s + b)  temporaries " << std::fixed << std::setprecision(4) << unfusedTime
+		<< " sec  fused " << fusedTime << " sec  speedup " << std::setprecision(1) << unfusedTime / fusedTime << "x\n" << std::defaultfloat;
+}
+
+/*
+10/19/2026: single core of a virtualized x86-64 host, g++ -O2
+The packed and tiled product runs 2 to 7x faster than the triple loop for native floats, whose cost is in
+the memory accesses; for emulated types, whose cost is in the arithmetic, it runs at the rate of the loop.
+
+Tensor contraction and fusion performance
+float          N =  256  triple loop 1.691e+09 flops/sec  einsum 5.128e+09 flops/sec  transposed view 5.049e+09 flops/sec  speedup 3.0x
+float          N =  512  triple loop 1.381e+09 flops/sec  einsum 4.811e+09 flops/sec  transposed view 4.509e+09 flops/sec  speedup 3.5x
+double         N =  256  triple loop 1.759e+09 flops/sec  einsum 3.738e+09 flops/sec  transposed view 3.831e+09 flops/sec  speedup 2.1x
+double         N =  512  triple loop 5.263e+08 flops/sec  einsum 3.950e+09 flops/sec  transposed view 4.112e+09 flops/sec  speedup 7.5x
+cfloat<32,8>   N =  128  triple loop 6.135e+06 flops/sec  einsum 6.389e+06 flops/sec  transposed view 7.306e+06 flops/sec  speedup 1.0x
+posit<32,2>    N =  128  triple loop 2.542e+05 flops/sec  einsum 2.638e+05 flops/sec  transposed view 2.029e+05 flops/sec  speedup 1.0x
+float          bij,bjk->bik  lowered 0.0054 sec  direct 0.1727 sec    ijk,jlk->il  lowered 0.0022 sec  direct 0.0440 sec
+double         bij,bjk->bik  lowered 0.0071 sec  direct 0.1826 sec    ijk,jlk->il  lowered 0.0023 sec  direct 0.0431 sec
+float          relu(x * s + b)  temporaries 0.0068 sec  fused 0.0045 sec  speedup 1.5x
+double         relu(x * s + b)  temporaries 0.0104 sec  fused 0.0058 sec  speedup 1.8x
+ */
+
+int main()
+try {
+	using namespace sw::universal;
+	std::mt19937_64 generator(42);
+
+	std::cout << "Tensor contraction and fusion performance\n";
+	MeasureMatmul<float>("float", 256, generator);
+	MeasureMatmul<float>("float", 512, generator);
+	MeasureMatmul<double>("double", 256, generator);
+	MeasureMatmul<double>("double", 512, generator);
+	MeasureMatmul<cfloat<32, 8, uint32_t, true, false, false>>("cfloat<32,8>", 128, generator);
+	MeasureMatmul<posit<32, 2>>("posit<32,2>", 128, generator);
+
+	MeasureContractions<float>("float", generator);
+	MeasureContractions<double>("double", generator);
+
+	MeasureFusion<float>("float", generator);
+	MeasureFusion<double>("double", generator);
+
+	return EXIT_SUCCESS;
+}
+catch (char const* msg) {
+	std::cerr << "Caught exception: " << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
@@ -0,0 +1,95 @@
+// fdp.cpp: performance of the exact fused dot product of floats and doubles against the rounded dot product
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <universal/number/float/kulisch.hpp>
+
+// run a workload and report its rate in products per second
+template<typename Workload>
+void MeasureDot(const std::string& tag, const std::string& kernel, double products, Workload&& work) {
+	using namespace std::chrono;
+	steady_clock::time_point begin = steady_clock::now();
+	auto result = work();
+	steady_clock::time_point end = steady_clock::now();
+	double elapsed_time = duration_cast<duration<double>>(end - begin).count();
+	std::cout << std::setw(8) << std::left << tag << std::setw(16) << kernel
+		<< " time " << std::setw(12) << std::right << std::scientific << std::setprecision(3) << elapsed_time << " sec"
+		<< "  rate " << std::setw(12) << products / elapsed_time << " products/sec"
+		<< "  result " << std::setprecision(17) << double(result) << '\n';
+	std::cout << std::defaultfloat;
+}
+
+template<typename Real>
+void DotWorkload(const std::string& tag, size_t N, unsigned repetitions) {
+	using namespace sw::universal;
+	std::mt19937_64 rng(42);
+	std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+	std::vector<Real> x(N), y(N);
+	for (size_t i = 0; i < N; ++i) {
+		x[i] = Real(std::ldexp(distribution(rng), int(i % 41) - 20));
+		y[i] = Real(distribution(rng));
+	}
+	double products = double(N) * double(repetitions);
+
+	MeasureDot(tag, "rounded dot", products, [&]() {
+		Real sum(0);
+		for (unsigned r = 0; r < repetitions; ++r) {
+			Real s(0);
+			for (size_t i = 0; i < N; ++i) s += x[i] * y[i];
+			sum += s;
+		}
+		return sum;
+	});
+	MeasureDot(tag, "fdp", products, [&]() {
+		Real sum(0);
+		for (unsigned r = 0; r < repetitions; ++r) sum += fdp(x.data(), y.data(), N);
+		return sum;
+	});
+	MeasureDot(tag, "fdp parallel", products, [&]() {
+		Real sum(0);
+		for (unsigned r = 0; r < repetitions; ++r) sum += fdp_parallel(x.data(), y.data(), N);
+		return sum;
+	});
+}
+
+/*
+10/19/2026: single core, 4M element dot products, 5 repetitions
+The fused dot product costs 7 to 9 rounded dot products: a product is decoded, multiplied as integers, and
+added to four or six limbs of the accumulator without resolving carries. The rounded float dot product has
+lost 12 of its 24 bits of precision to the rounding of the running sum.
+
+float   rounded dot      time    7.180e-02 sec  rate    2.921e+08 products/sec  result -1.41179340000000000e+07
+float   fdp              time    6.398e-01 sec  rate    3.278e+07 products/sec  result -1.41210180000000000e+07
+float   fdp parallel     time    6.035e-01 sec  rate    3.475e+07 products/sec  result -1.41210180000000000e+07
+double  rounded dot      time    1.147e-01 sec  rate    1.829e+08 products/sec  result -1.41210370065762848e+07
+double  fdp              time    7.772e-01 sec  rate    2.698e+07 products/sec  result -1.41210370065780561e+07
+double  fdp parallel     time    7.722e-01 sec  rate    2.716e+07 products/sec  result -1.41210370065780561e+07
+ */
+
+int main()
+try {
+	std::cout << "products/sec of the exact fused dot product\n";
+	DotWorkload<float>("float", 4 * 1024 * 1024, 5);
+	DotWorkload<double>("double", 4 * 1024 * 1024, 5);
+
+	return EXIT_SUCCESS;
+}
+catch (char const* msg) {
+	std::cerr << "Caught exception: " << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
@@ -4,6 +4,8 @@
 //
 // This file is part of the universal numbers project, which is released under an MIT Open Source license.
 #include <universal/utility/directives.hpp>
+#include <chrono>
+#include <random>
 
 // enable the following define to show the intermediate steps in the fused-dot product
 // #define ALGORITHM_VERBOSE_OUTPUT
@@ -12,8 +14,10 @@
 // enable posit arithmetic exceptions
 #define POSIT_THROW_ARITHMETIC_EXCEPTION 1
 #include <universal/number/posit/posit.hpp>
+#include <universal/number/cfloat/cfloat.hpp>
 #define BLAS_TRACE_ROUNDING_EVENTS 1
 #include <universal/blas/blas.hpp>
+#include <universal/benchmark/performance_runner.hpp>
 
 template<typename Scalar>
 void catastrophicCancellationTest() {
@@ -44,12 +48,53 @@ void catastrophicCancellationTest() {
 	}
 }
 
+// row-blocked matrix-vector product throughput from 1 to all hardware threads
+template<typename Scalar>
+void MatvecScaling(const std::string& tag, size_t N) {
+	using namespace sw::universal;
+	using namespace sw::universal::blas;
+	using namespace std::chrono;
+	using Matrix = sw::universal::blas::matrix<Scalar>;
+	using Vector = sw::universal::blas::vector<Scalar>;
+
+	Matrix A(N, N);
+	Vector x(N), b(N), reference(N);
+	std::mt19937_64 generator(42);
+	std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+	for (size_t i = 0; i < N; ++i) {
+		x[i] = Scalar(distribution(generator));
+		for (size_t j = 0; j < N; ++j) A(i, j) = Scalar(distribution(generator));
+	}
+	matvec(reference, A, x);  // row-by-row reference
+
+	std::vector<unsigned> threadCounts;
+	for (unsigned nrThreads = 1; nrThreads < hardware_threads(); nrThreads *= 2) threadCounts.push_back(nrThreads);
+	threadCounts.push_back(hardware_threads());
+	bool identical = true;
+	for (auto nrThreads : threadCounts) {
+		steady_clock::time_point begin = steady_clock::now();
+		matvec(ExecutionPolicy::Parallel, b, A, x, nrThreads);
+		steady_clock::time_point end = steady_clock::now();
+		double elapsed_time = duration_cast<duration<double>>(end - begin).count();
+		std::cout << std::setw(20) << std::left << tag << " matvec " << N << 'x' << N << " threads " << std::setw(3) << nrThreads
+			<< std::setw(15) << std::right << elapsed_time << "sec -> " << toPowerOfTen(double(N) * double(N) / elapsed_time) << "FMAs/sec\n";
+		for (size_t i = 0; i < N; ++i) if (b[i] != reference[i]) identical = false;
+	}
+	std::cout << tag << " row-blocked matvec is " << (identical ? "identical" : "NOT identical") << " to the row-by-row product\n";
+}
+
 int main()
 try {
 	catastrophicCancellationTest<float>();
 	catastrophicCancellationTest<double>();
 	catastrophicCancellationTest< sw::universal::posit<32,2> >();
 
+	std::cout << "\nmatrix-vector product scaling\n";
+	MatvecScaling<float>("float", 2048);
+	MatvecScaling<double>("double", 2048);
+	MatvecScaling< sw::universal::cfloat<16, 5, uint16_t, true, false, false> >("cfloat<16,5>", 1024);
+	MatvecScaling< sw::universal::posit<32, 2> >("posit<32,2>", 128);
+
 	return EXIT_SUCCESS;
 }
 catch (char const* msg) {
@@ -0,0 +1,113 @@
+// packed_vector.cpp: performance of the dot product and axpy of packed vectors of narrow formats
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <chrono>
+#include <random>
+#include <universal/number/cfloat/cfloat.hpp>
+#include <universal/number/posit/posit.hpp>
+#include <universal/blas/blas.hpp>
+
+template<typename Function>
+double Seconds(Function&& function) {
+	using namespace std::chrono;
+	steady_clock::time_point begin = steady_clock::now();
+	function();
+	steady_clock::time_point end = steady_clock::now();
+	return duration_cast<duration<double>>(end - begin).count();
+}
+
+// the dot product and axpy of a blas::vector, one Scalar per element, against the packed vector of the same values
+template<typename Scalar>
+void MeasurePacked(size_t N) {
+	using namespace sw::universal;
+	using namespace sw::universal::blas;
+	std::mt19937_64 generator(42);
+	std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+	blas::vector<Scalar> x(N), y(N);
+	for (size_t i = 0; i < N; ++i) {
+		x[i] = Scalar(distribution(generator));
+		y[i] = Scalar(distribution(generator));
+	}
+	packed_vector<Scalar> px(x), py(y);
+	double mvalues = double(N) / 1.0e6;
+
+	Scalar d{ 0 }, pd{ 0 };
+	double t = Seconds([&]() { d = blas::dot(x, y); });
+	// the same values, decoded one element at a time and accumulated in double as the packed kernel does
+	double s{ 0 };
+	double u = Seconds([&]() { for (size_t i = 0; i < N; ++i) s += double(x[i]) * double(y[i]); });
+	double p = Seconds([&]() { pd = blas::dot(px, py); });
+	std::cout << std::setw(20) << type_tag(Scalar()) << " : " << std::setw(5) << sizeof(Scalar) << " bytes/element, packed "
+		<< std::setw(5) << std::setprecision(3) << double(px.bytes()) / double(N) << " bytes/element\n";
+	std::cout << std::setprecision(4)
+		<< "    dot  vector " << std::setw(8) << mvalues / t << " Mvalues/sec  vector in double " << std::setw(8) << mvalues / u
+		<< " Mvalues/sec  packed " << std::setw(8) << mvalues / p << " Mvalues/sec  (" << d << ", " << Scalar(s) << ", " << pd << ")\n";
+
+	Scalar a(0.5);
+	t = Seconds([&]() { blas::axpy(N, a, x, 1, y, 1); });
+	p = Seconds([&]() { blas::axpy(N, a, px, 1, py, 1); });
+	std::cout << "    axpy vector " << std::setw(8) << mvalues / t << " Mvalues/sec" << std::setw(46) << "packed "
+		<< std::setw(8) << mvalues / p << " Mvalues/sec  (" << y[N / 2] << ", " << py[N / 2] << ")\n";
+}
+
+/*
+10/19/2026: single core of a virtualized x86-64 host, g++ -O2
+The packed dot product decodes a tile of each operand through the value table of the format and sums the
+products in double: it runs as fast as, and for the byte-aligned formats twice as fast as, decoding a vector of
+Scalars element by element in double, at half to an eighth of the memory, and one to two orders of magnitude
+faster than the dot product in the arithmetic of the format. The packed axpy is bound by the rounding of each
+result back to the format, not by the memory traffic, and still runs up to ten times faster than axpy in the
+arithmetic of the format. The sums of 4M random elements overflow the narrow formats; the checksums show that the
+packed kernels round the same double sum as the element by element reference.
+
+packed vector performance: 4194304 elements
+cfloat<  4,   2, uint8_t, hasSubnormals, hasSupernormals, notSaturating> :     1 bytes/element, packed   0.5 bytes/element
+    dot  vector    35.52 Mvalues/sec  vector in double    259.8 Mvalues/sec  packed    450.5 Mvalues/sec  (-inf, inf, inf)
+    axpy vector    32.67 Mvalues/sec                                       packed    39.24 Mvalues/sec  (1, 1)
+cfloat<  6,   3, uint8_t, hasSubnormals, hasSupernormals, notSaturating> :     1 bytes/element, packed  0.75 bytes/element
+    dot  vector     15.1 Mvalues/sec  vector in double    248.2 Mvalues/sec  packed    283.9 Mvalues/sec  (1, -inf, -inf)
+    axpy vector    15.22 Mvalues/sec                                       packed    31.33 Mvalues/sec  (0.875, 0.875)
+cfloat<  8,   4, uint8_t, hasSubnormals, hasSupernormals, notSaturating> :     1 bytes/element, packed     1 bytes/element
+    dot  vector    15.36 Mvalues/sec  vector in double    249.9 Mvalues/sec  packed    437.6 Mvalues/sec  (0.6875, -416, -416)
+    axpy vector    18.32 Mvalues/sec                                       packed    40.47 Mvalues/sec  (0.875, 0.875)
+       posit<  6, 1> :     8 bytes/element, packed  0.75 bytes/element
+    dot  vector    1.967 Mvalues/sec  vector in double    194.6 Mvalues/sec  packed    270.3 Mvalues/sec  (2.5, -256, -256)
+    axpy vector    2.365 Mvalues/sec                                       packed    21.82 Mvalues/sec  (0.875, 0.875)
+       posit<  8, 2> :     8 bytes/element, packed     1 bytes/element
+    dot  vector    2.109 Mvalues/sec  vector in double    264.3 Mvalues/sec  packed    713.8 Mvalues/sec  (0.9375, -384, -384)
+    axpy vector    2.393 Mvalues/sec                                       packed     28.5 Mvalues/sec  (0.875, 0.875)
+ */
+
+int main()
+try {
+	using namespace sw::universal;
+
+	using fp4e2m1 = cfloat<4, 2, std::uint8_t, true, true, false>;
+	using fp6e3m2 = cfloat<6, 3, std::uint8_t, true, true, false>;
+
+	constexpr size_t N = 4 * 1024 * 1024;
+	std::cout << "packed vector performance: " << N << " elements\n";
+	MeasurePacked<fp4e2m1>(N);
+	MeasurePacked<fp6e3m2>(N);
+	MeasurePacked<fp8e4m3>(N);
+	MeasurePacked<posit<6, 1>>(N);
+	MeasurePacked<posit<8, 2>>(N);
+
+	return EXIT_SUCCESS;
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
@@ -0,0 +1,154 @@
+// reproducible.cpp: performance of the binned reproducible dot product against the parallel rounded dot product
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <chrono>
+#include <random>
+#include <universal/number/cfloat/cfloat.hpp>
+#include <universal/number/dd/dd.hpp>
+#include <universal/blas/blas.hpp>
+
+// run a dot product and report its rate in products per second
+template<typename Scalar, typename Kernel>
+Scalar MeasureDot(const std::string& tag, const std::string& kernel, unsigned nrThreads, size_t N, Kernel&& kernel_fn, double& elapsed_time) {
+	using namespace std::chrono;
+	steady_clock::time_point begin = steady_clock::now();
+	Scalar result = kernel_fn(nrThreads);
+	steady_clock::time_point end = steady_clock::now();
+	elapsed_time = duration_cast<duration<double>>(end - begin).count();
+	std::cout << std::setw(14) << std::left << tag << std::setw(14) << kernel << " threads " << std::setw(3) << nrThreads
+		<< " time " << std::setw(12) << std::right << std::scientific << std::setprecision(3) << elapsed_time << " sec"
+		<< "  rate " << std::setw(12) << double(N) / elapsed_time << " products/sec";
+	std::cout << std::defaultfloat;
+	return result;
+}
+
+// the overhead of the reproducible dot product over the Parallel policy from 1 to 64 threads
+template<typename Scalar>
+void DotOverhead(const std::string& tag, size_t N) {
+	using namespace sw::universal;
+	using namespace sw::universal::blas;
+	vector<Scalar> x(N), y(N);
+	std::mt19937_64 generator(42);
+	std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+	for (size_t i = 0; i < N; ++i) {
+		x[i] = Scalar(distribution(generator));
+		y[i] = Scalar(distribution(generator));
+	}
+
+	Scalar reference = reproducible_dot(x, y, 1);
+	bool reproducible = true;
+	for (unsigned nrThreads = 1; nrThreads <= 64; nrThreads *= 2) {
+		double parallelTime, binnedTime;
+		MeasureDot<Scalar>(tag, "parallel", nrThreads, N, [&](unsigned t) { return dot(ExecutionPolicy::Parallel, x, y, t); }, parallelTime);
+		std::cout << '\n';
+		Scalar result = MeasureDot<Scalar>(tag, "reproducible", nrThreads, N, [&](unsigned t) { return reproducible_dot(x, y, t); }, binnedTime);
+		std::cout << "  overhead " << std::fixed << std::setprecision(1) << binnedTime / parallelTime << "x\n" << std::defaultfloat;
+		if (!(result == reference)) reproducible = false;
+	}
+	std::cout << tag << " reproducible results are " << (reproducible ? "identical" : "NOT identical") << " across thread counts\n";
+}
+
+/*
+10/19/2026: single core, 4M element dot products (1M for cfloat and dd), threads beyond 1 time share the core
+The binned dot product deposits every product in three bins with four additions each, which costs 3 to 8
+parallel rounded dot products for float and double. The cfloat and dd dot products are faster binned: the
+products and the sums are native double arithmetic instead of emulated arithmetic. The results are
+identical from 1 to 64 threads.
+
+float         parallel       threads 1   time    1.243e-02 sec  rate    3.374e+08 products/sec
+float         reproducible   threads 1   time    9.483e-02 sec  rate    4.423e+07 products/sec  overhead 7.6x
+float         parallel       threads 2   time    1.585e-02 sec  rate    2.647e+08 products/sec
+float         reproducible   threads 2   time    9.980e-02 sec  rate    4.203e+07 products/sec  overhead 6.3x
+float         parallel       threads 4   time    1.341e-02 sec  rate    3.128e+08 products/sec
+float         reproducible   threads 4   time    9.605e-02 sec  rate    4.367e+07 products/sec  overhead 7.2x
+float         parallel       threads 8   time    1.378e-02 sec  rate    3.044e+08 products/sec
+float         reproducible   threads 8   time    9.733e-02 sec  rate    4.309e+07 products/sec  overhead 7.1x
+float         parallel       threads 16  time    2.004e-02 sec  rate    2.093e+08 products/sec
+float         reproducible   threads 16  time    6.735e-02 sec  rate    6.228e+07 products/sec  overhead 3.4x
+float         parallel       threads 32  time    1.424e-02 sec  rate    2.944e+08 products/sec
+float         reproducible   threads 32  time    6.647e-02 sec  rate    6.310e+07 products/sec  overhead 4.7x
+float         parallel       threads 64  time    2.770e-02 sec  rate    1.514e+08 products/sec
+float         reproducible   threads 64  time    9.666e-02 sec  rate    4.339e+07 products/sec  overhead 3.5x
+float reproducible results are identical across thread counts
+double        parallel       threads 1   time    2.453e-02 sec  rate    1.710e+08 products/sec
+double        reproducible   threads 1   time    8.951e-02 sec  rate    4.686e+07 products/sec  overhead 3.6x
+double        parallel       threads 2   time    3.288e-02 sec  rate    1.276e+08 products/sec
+double        reproducible   threads 2   time    1.080e-01 sec  rate    3.884e+07 products/sec  overhead 3.3x
+double        parallel       threads 4   time    2.773e-02 sec  rate    1.512e+08 products/sec
+double        reproducible   threads 4   time    1.120e-01 sec  rate    3.744e+07 products/sec  overhead 4.0x
+double        parallel       threads 8   time    2.454e-02 sec  rate    1.709e+08 products/sec
+double        reproducible   threads 8   time    1.155e-01 sec  rate    3.633e+07 products/sec  overhead 4.7x
+double        parallel       threads 16  time    2.464e-02 sec  rate    1.702e+08 products/sec
+double        reproducible   threads 16  time    1.174e-01 sec  rate    3.573e+07 products/sec  overhead 4.8x
+double        parallel       threads 32  time    3.825e-02 sec  rate    1.097e+08 products/sec
+double        reproducible   threads 32  time    1.278e-01 sec  rate    3.283e+07 products/sec  overhead 3.3x
+double        parallel       threads 64  time    3.505e-02 sec  rate    1.197e+08 products/sec
+double        reproducible   threads 64  time    1.295e-01 sec  rate    3.239e+07 products/sec  overhead 3.7x
+double reproducible results are identical across thread counts
+cfloat<16,5>  parallel       threads 1   time    2.514e-01 sec  rate    4.170e+06 products/sec
+cfloat<16,5>  reproducible   threads 1   time    3.679e-02 sec  rate    2.850e+07 products/sec  overhead 0.1x
+cfloat<16,5>  parallel       threads 2   time    2.473e-01 sec  rate    4.241e+06 products/sec
+cfloat<16,5>  reproducible   threads 2   time    3.759e-02 sec  rate    2.789e+07 products/sec  overhead 0.2x
+cfloat<16,5>  parallel       threads 4   time    2.657e-01 sec  rate    3.946e+06 products/sec
+cfloat<16,5>  reproducible   threads 4   time    3.997e-02 sec  rate    2.624e+07 products/sec  overhead 0.2x
+cfloat<16,5>  parallel       threads 8   time    2.448e-01 sec  rate    4.283e+06 products/sec
+cfloat<16,5>  reproducible   threads 8   time    3.898e-02 sec  rate    2.690e+07 products/sec  overhead 0.2x
+cfloat<16,5>  parallel       threads 16  time    2.602e-01 sec  rate    4.030e+06 products/sec
+cfloat<16,5>  reproducible   threads 16  time    4.796e-02 sec  rate    2.186e+07 products/sec  overhead 0.2x
+cfloat<16,5>  parallel       threads 32  time    2.654e-01 sec  rate    3.951e+06 products/sec
+cfloat<16,5>  reproducible   threads 32  time    5.513e-02 sec  rate    1.902e+07 products/sec  overhead 0.2x
+cfloat<16,5>  parallel       threads 64  time    2.836e-01 sec  rate    3.697e+06 products/sec
+cfloat<16,5>  reproducible   threads 64  time    5.100e-02 sec  rate    2.056e+07 products/sec  overhead 0.2x
+cfloat<16,5> reproducible results are identical across thread counts
+dd            parallel       threads 1   time    4.081e-01 sec  rate    2.569e+06 products/sec
+dd            reproducible   threads 1   time    2.559e-01 sec  rate    4.097e+06 products/sec  overhead 0.6x
+dd            parallel       threads 2   time    4.056e-01 sec  rate    2.585e+06 products/sec
+dd            reproducible   threads 2   time    2.588e-01 sec  rate    4.052e+06 products/sec  overhead 0.6x
+dd            parallel       threads 4   time    4.053e-01 sec  rate    2.587e+06 products/sec
+dd            reproducible   threads 4   time    2.508e-01 sec  rate    4.180e+06 products/sec  overhead 0.6x
+dd            parallel       threads 8   time    3.870e-01 sec  rate    2.709e+06 products/sec
+dd            reproducible   threads 8   time    2.802e-01 sec  rate    3.742e+06 products/sec  overhead 0.7x
+dd            parallel       threads 16  time    4.197e-01 sec  rate    2.498e+06 products/sec
+dd            reproducible   threads 16  time    2.801e-01 sec  rate    3.744e+06 products/sec  overhead 0.7x
+dd            parallel       threads 32  time    4.124e-01 sec  rate    2.543e+06 products/sec
+dd            reproducible   threads 32  time    2.735e-01 sec  rate    3.834e+06 products/sec  overhead 0.7x
+dd            parallel       threads 64  time    4.408e-01 sec  rate    2.379e+06 products/sec
+dd            reproducible   threads 64  time    2.852e-01 sec  rate    3.677e+06 products/sec  overhead 0.6x
+dd reproducible results are identical across thread counts
+ */
+
+int main()
+try {
+	using namespace sw::universal;
+	std::cout << "overhead of the reproducible dot product\n";
+	DotOverhead<float>("float", 4 * SIZE_1M);
+	DotOverhead<double>("double", 4 * SIZE_1M);
+	DotOverhead< cfloat<16, 5, uint16_t, true, false, false> >("cfloat<16,5>", SIZE_1M);
+	DotOverhead<dd>("dd", SIZE_1M);
+
+	return EXIT_SUCCESS;
+}
+catch (char const* msg) {
+	std::cerr << "Caught exception: " << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_arithmetic_exception& err) {
+	std::cerr << "Uncaught universal arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_internal_exception& err) {
+	std::cerr << "Uncaught universal internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
@@ -0,0 +1,190 @@
+// solvers.cpp: allocation and time per iteration of the iterative solvers with lazy and eager vector arithmetic
+//
+// Copyright (C) 2017-2023 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <new>
+#include <sstream>
+#include <universal/number/posit/posit.hpp>
+#include <universal/number/cfloat/cfloat.hpp>
+#include <universal/blas/blas.hpp>
+#include <universal/blas/solvers/cg.hpp>
+#include <universal/blas/solvers/jacobi.hpp>
+
+// count the heap allocations of the solvers
+static std::atomic<size_t> nrAllocations{ 0 };
+
+void* operator new(std::size_t size) {
+	++nrAllocations;
+	if (void* p = std::malloc(size == 0 ? 1 : size)) return p;
+	throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+namespace sw { namespace universal { namespace blas {
+
+// the conjugate gradient iteration of cg.hpp with every intermediate materialized,
+// which is how the vector arithmetic operators evaluated before the expression templates
+template<typename Matrix, typename Vector, size_t MAX_ITERATIONS = 100>
+size_t cg_eager(const Matrix& M, const Matrix& A, const Vector& b, Vector& x, Vector& residuals, typename Matrix::value_type tolerance) {
+	using Scalar = typename Matrix::value_type;
+	Scalar residual = Scalar(std::numeric_limits<Scalar>::max());
+	Vector rho(size(b)), zeta(size(b)), p(size(b)), q(size(b));
+	Scalar sigma_1{ 0 }, sigma_2{ 0 }, alpha{ 0 }, beta{ 0 };
+	rho = b;
+	size_t itr = 0;
+	bool firstIteration = true;
+	while (residual > tolerance && itr < MAX_ITERATIONS) {
+		zeta = M * rho;
+		sigma_2 = sigma_1;
+		sigma_1 = zeta * rho;
+		if (firstIteration) {
+			firstIteration = false;
+			p = zeta;
+		}
+		else {
+			beta = sigma_1 / sigma_2;
+			p = (zeta + (beta * p).eval()).eval();
+		}
+		q = A * p;
+		alpha = sigma_1 / (p * q);
+		Vector x_1(x);
+		x = (x + (alpha * p).eval()).eval();
+		rho = (rho - (alpha * q).eval()).eval();
+		residual = norm((x_1 - x).eval(), 1);
+		residuals.push_back(residual);
+		++itr;
+	}
+	return itr;
+}
+
+// the Jacobi iteration of jacobi.hpp with every intermediate materialized
+template<typename Matrix, typename Vector, size_t MAX_ITERATIONS = 100>
+size_t Jacobi_eager(const Matrix& A, const Vector& b, Vector& x, typename Matrix::value_type tolerance) {
+	using Scalar = typename Matrix::value_type;
+	Scalar residual = Scalar(std::numeric_limits<Scalar>::max());
+	size_t m = num_rows(A);
+	size_t n = num_cols(A);
+	size_t itr = 0;
+	while (residual > tolerance && itr < MAX_ITERATIONS) {
+		Vector x_old = x;
+		for (size_t i = 0; i < m; ++i) {
+			Scalar sigma = 0;
+			for (size_t j = 0; j < n; ++j) {
+				if (i != j) sigma += A(i, j) * x(j);
+			}
+			x(i) = (b(i) - sigma) / A(i, i);
+		}
+		residual = normL1((x_old - x).eval());
+		++itr;
+	}
+	return itr;
+}
+
+}}} // namespace sw::universal::blas
+
+// report allocations and time per iteration of a solver run
+template<typename Solver>
+void MeasureSolver(const std::string& tag, const std::string& solver, Solver&& solve) {
+	using namespace std::chrono;
+	std::stringstream solverOutput;  // the library solvers report their convergence on std::cout
+	std::streambuf* coutBuffer = std::cout.rdbuf(solverOutput.rdbuf());
+	size_t allocationsBefore = nrAllocations;
+	steady_clock::time_point begin = steady_clock::now();
+	size_t iterations = solve();
+	steady_clock::time_point end = steady_clock::now();
+	std::cout.rdbuf(coutBuffer);
+	size_t allocations = nrAllocations - allocationsBefore;
+	double elapsed_time = duration_cast<duration<double>>(end - begin).count();
+	if (iterations == 0) iterations = 1;
+	std::cout << std::setw(15) << std::left << tag << std::setw(15) << solver << " iterations " << std::setw(4) << std::right << iterations
+		<< "  allocations/iteration " << std::setw(8) << std::fixed << std::setprecision(2) << double(allocations) / double(iterations)
+		<< "  time/iteration " << std::setw(12) << std::scientific << std::setprecision(3) << elapsed_time / double(iterations) << " sec\n";
+	std::cout << std::defaultfloat;
+}
+
+// diagonally dominant, symmetric positive definite tridiagonal system of order N
+template<typename Scalar>
+void SolverWorkload(const std::string& tag, size_t N) {
+	using namespace sw::universal::blas;
+	using Matrix = matrix<Scalar>;
+	using Vector = vector<Scalar>;
+
+	Matrix A(N, N), M(N, N);
+	A = Scalar(0);
+	M = Scalar(0);
+	for (size_t i = 0; i < N; ++i) {
+		A(i, i) = Scalar(4);
+		if (i > 0) A(i, i - 1) = Scalar(-1);
+		if (i + 1 < N) A(i, i + 1) = Scalar(-1);
+		M(i, i) = Scalar(0.25);  // Jacobi preconditioner
+	}
+	Vector ones(N, Scalar(1));
+	Vector b = A * ones;
+	Scalar tolerance(1.0e-6);
+
+	Vector xLazy(N), xEager(N), residualsLazy, residualsEager;
+	size_t lazyIterations{ 0 }, eagerIterations{ 0 };
+	MeasureSolver(tag, "cg eager", [&]() { return eagerIterations = cg_eager<Matrix, Vector, 100>(M, A, b, xEager, residualsEager, tolerance); });
+	MeasureSolver(tag, "cg lazy", [&]() { return lazyIterations = cg<Matrix, Vector, 100>(M, A, b, xLazy, residualsLazy, tolerance); });
+	std::cout << tag << " cg solutions are " << (xLazy == xEager && lazyIterations == eagerIterations ? "identical" : "DIFFERENT") << '\n';
+	xLazy = Scalar(0);
+	xEager = Scalar(0);
+	MeasureSolver(tag, "Jacobi eager", [&]() { return Jacobi_eager<Matrix, Vector, 100>(A, b, xEager, tolerance); });
+	MeasureSolver(tag, "Jacobi lazy", [&]() { return Jacobi<Matrix, Vector, 100, false>(A, b, xLazy, tolerance); });
+	std::cout << tag << " Jacobi solutions are " << (xLazy == xEager ? "identical" : "DIFFERENT") << '\n';
+}
+
+/*
+10/19/2026: allocations per iteration, eager evaluation versus expression templates
+   cg     : 10.5 -> 2.8, what remains are the two matrix-vector products and the growth of the residual history
+   Jacobi :  2.0 -> 0.1, what remains is the growth of std::cout's buffer
+The dense O(N^2) matrix-vector products dominate the time per iteration of these small systems:
+the O(N) vector updates are within the noise of the single core measurement.
+
+double         cg eager        iterations   14  allocations/iteration    10.50  time/iteration    5.140e-05 sec
+double         cg lazy         iterations   14  allocations/iteration     2.79  time/iteration    4.954e-05 sec
+double         Jacobi eager    iterations   19  allocations/iteration     2.00  time/iteration    7.226e-05 sec
+double         Jacobi lazy     iterations   19  allocations/iteration     0.11  time/iteration    4.702e-05 sec
+cfloat<32,8>   cg eager        iterations   13  allocations/iteration    10.54  time/iteration    3.340e-04 sec
+cfloat<32,8>   cg lazy         iterations   13  allocations/iteration     2.85  time/iteration    3.311e-04 sec
+posit<32,2>    cg eager        iterations   14  allocations/iteration    10.50  time/iteration    1.585e-03 sec
+posit<32,2>    cg lazy         iterations   14  allocations/iteration     2.79  time/iteration    1.582e-03 sec
+posit<32,2>    Jacobi eager    iterations   17  allocations/iteration     2.00  time/iteration    9.086e-04 sec
+posit<32,2>    Jacobi lazy     iterations   17  allocations/iteration     0.12  time/iteration    8.982e-04 sec
+ */
+
+int main()
+try {
+	std::cout << "allocations and time per iteration of the iterative solvers\n";
+	SolverWorkload<double>("double", 256);
+	SolverWorkload< sw::universal::cfloat<32, 8, uint32_t, true, false, false> >("cfloat<32,8>", 64);
+	SolverWorkload< sw::universal::posit<32, 2> >("posit<32,2>", 64);
+
+	return EXIT_SUCCESS;
+}
+catch (char const* msg) {
+	std::cerr << "Caught exception: " << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_arithmetic_exception& err) {
+	std::cerr << "Uncaught universal arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_internal_exception& err) {
+	std::cerr << "Uncaught universal internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
@@ -0,0 +1,109 @@
+// statistics.cpp: performance of single-pass streaming statistics against the two-pass, copy-and-sort summary
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <universal/number/cfloat/cfloat.hpp>
+#include <universal/number/posit/posit.hpp>
+#include <universal/blas/blas.hpp>
+#include <universal/blas/statistics.hpp>
+
+template<typename Function>
+double Seconds(Function&& function) {
+	using namespace std::chrono;
+	steady_clock::time_point begin = steady_clock::now();
+	function();
+	steady_clock::time_point end = steady_clock::now();
+	return duration_cast<duration<double>>(end - begin).count();
+}
+
+// the summary the library computed before the streaming accumulators: a pass for the mean, a pass for the
+// variance, and a sorted copy for the quartiles
+template<typename Vector>
+sw::universal::blas::SummaryStats<typename Vector::value_type> TwoPassSummary(const Vector& data) {
+	using Scalar = typename Vector::value_type;
+	using std::sqrt;
+	size_t N = size(data);
+	sw::universal::blas::SummaryStats<Scalar> stats;
+	Scalar sum{ 0 };
+	for (auto e : data) sum += e;
+	stats.mean = sum / Scalar(double(N));
+	sum = 0;
+	for (auto e : data) {
+		Scalar s = (e - stats.mean);
+		sum += s * s;
+	}
+	stats.stddev = sqrt(sum / Scalar(double(N - 1)));
+	Vector v(data);
+	std::sort(v.begin(), v.end());
+	stats.quantiles.set(v[0], v[N / 4], v[N / 2], v[(3 * N) / 4], v[N - 1]);
+	return stats;
+}
+
+template<typename Scalar>
+void MeasureSummary(const std::string& tag, size_t N) {
+	using namespace sw::universal::blas;
+	std::mt19937_64 generator(0x5eed);
+	std::normal_distribution<double> distribution(0.0, 1.0);
+	std::vector<Scalar> data(N);
+	for (auto& e : data) e = Scalar(distribution(generator));
+
+	SummaryStats<Scalar> reference, serial, parallel;
+	double referenceTime = Seconds([&]() { reference = TwoPassSummary(data); });
+	double serialTime = Seconds([&]() { serial = summaryStatistics(data, 1); });
+	double parallelTime = Seconds([&]() { parallel = summaryStatistics(data); });
+	moments<Scalar> moment;
+	double momentTime = Seconds([&]() { moment.push(data.begin(), data.end()); });
+	std::cout << std::setw(14) << std::left << tag << std::right << " N = " << std::setw(8) << N
+		<< "  two-pass + sort " << std::setw(8) << std::setprecision(4) << referenceTime << " sec"
+		<< "  streaming " << std::setw(8) << serialTime << " sec"
+		<< "  parallel " << std::setw(8) << parallelTime << " sec"
+		<< "  moments only " << std::setw(8) << momentTime << " sec (mean " << double(moment.mean()) << ")"
+		<< "  median " << double(reference.quantiles.q[2]) << " vs " << double(serial.quantiles.q[2]) << '\n';
+}
+
+/*
+10/19/2026: single core of a virtualized x86-64 host, g++ -O2
+The streaming summary replaces the sort of a copy of the data with a t-digest of a few hundred centroids, and
+runs twice as fast for native types; the moments alone take a few percent of the time. For posits, whose
+cost is in the arithmetic, the compensated sum adds three additions per value, and the single pass runs at
+about the rate of the two passes and the sort.
+
+Streaming statistics performance
+float          N =  1048576  two-pass + sort   0.1263 sec  streaming  0.07095 sec  parallel  0.06668 sec  moments only 0.003854 sec (mean 0.001082)  median 0.001466 vs 0.001093
+double         N =  1048576  two-pass + sort   0.1411 sec  streaming  0.09404 sec  parallel  0.08329 sec  moments only 0.004243 sec (mean 0.001083)  median 0.001466 vs 0.001093
+double         N =  8388608  two-pass + sort    1.186 sec  streaming   0.6161 sec  parallel   0.6156 sec  moments only  0.03489 sec (mean 0.0001506)  median 0.0001971 vs -1.563e-05
+cfloat<32,8>   N =   262144  two-pass + sort   0.6261 sec  streaming   0.4688 sec  parallel   0.4737 sec  moments only   0.3498 sec (mean -0.001308)  median 0.000924 vs 0.0008631
+posit<32,2>    N =   262144  two-pass + sort    2.939 sec  streaming    3.909 sec  parallel    4.799 sec  moments only    5.108 sec (mean -0.001307)  median 0.000924 vs 0.0008631
+ */
+
+int main()
+try {
+	using namespace sw::universal;
+
+	std::cout << "Streaming statistics performance\n";
+	MeasureSummary<float>("float", 1024 * 1024);
+	MeasureSummary<double>("double", 1024 * 1024);
+	MeasureSummary<double>("double", 8 * 1024 * 1024);
+	MeasureSummary< cfloat<32, 8, uint32_t, true, false, false> >("cfloat<32,8>", 256 * 1024);
+	MeasureSummary< posit<32, 2> >("posit<32,2>", 256 * 1024);
+
+	return EXIT_SUCCESS;
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
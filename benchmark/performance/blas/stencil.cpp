@@ -0,0 +1,96 @@
+// stencil.cpp: performance of the matrix-free stencil products and relaxation sweeps
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <chrono>
+// configure posit environment
+#define POSIT_FAST_POSIT_32_2 1
+#include <universal/number/posit/posit.hpp>
+#include <universal/blas/blas.hpp>
+
+// run a workload and report its rate in grid points per second
+template<typename Workload>
+void MeasureSweep(const std::string& tag, const std::string& kernel, double points, Workload&& work) {
+	using namespace std::chrono;
+	steady_clock::time_point begin = steady_clock::now();
+	work();
+	steady_clock::time_point end = steady_clock::now();
+	double elapsed_time = duration_cast<duration<double>>(end - begin).count();
+	std::cout << std::setw(15) << std::left << tag << std::setw(20) << kernel
+		<< " time " << std::setw(12) << std::right << std::scientific << std::setprecision(3) << elapsed_time << " sec"
+		<< "  rate " << std::setw(12) << points / elapsed_time << " points/sec\n";
+	std::cout << std::defaultfloat;
+}
+
+// N x N Laplace stencil: a dense matrix of this operator would hold N^4 elements
+template<typename Scalar>
+void StencilWorkload(const std::string& tag, size_t N, size_t sweeps) {
+	using namespace sw::universal::blas;
+	stencil<Scalar> A = laplace_stencil<Scalar>(N, N);
+	vector<Scalar> b(N * N), x(N * N, Scalar(0)), y(N * N);
+	for (size_t i = 0; i < N * N; ++i) b[i] = Scalar(std::sin(0.001 * double(i)));
+	double points = double(N) * double(N) * double(sweeps);
+
+	MeasureSweep(tag, "matvec", points, [&]() {
+		for (size_t s = 0; s < sweeps; ++s) A.matvec(b, y);
+	});
+	MeasureSweep(tag, "jacobi sweep", points, [&]() {
+		for (size_t s = 0; s < sweeps; ++s) {
+			A.jacobi_sweep(b, x, y);
+			std::swap(x, y);
+		}
+	});
+	MeasureSweep(tag, "red-black sor sweep", points, [&]() {
+		for (size_t s = 0; s < sweeps; ++s) A.red_black_sweep(b, x, Scalar(1.5));
+	});
+}
+
+/*
+10/19/2026: single core, 4096 x 4096 grids for the native types and 1024 x 1024 for posit<32,2>
+A 4096 x 4096 grid has 16.8M unknowns, and its dense matrix would need 2.3 PB in double: the stencil
+needs the 134 MB of each vector. The red-black sweep visits every other point of a line per color,
+and is 1.3 to 1.6 times slower per point than the Jacobi sweep that streams the lines.
+
+float          matvec               time    3.576e-01 sec  rate    2.346e+08 points/sec
+float          jacobi sweep         time    5.420e-01 sec  rate    1.548e+08 points/sec
+float          red-black sor sweep  time    6.404e-01 sec  rate    1.310e+08 points/sec
+double         matvec               time    3.012e-01 sec  rate    2.785e+08 points/sec
+double         jacobi sweep         time    4.457e-01 sec  rate    1.882e+08 points/sec
+double         red-black sor sweep  time    7.008e-01 sec  rate    1.197e+08 points/sec
+posit<32,2>    matvec               time    8.477e-01 sec  rate    6.185e+06 points/sec
+posit<32,2>    jacobi sweep         time    8.548e-01 sec  rate    6.134e+06 points/sec
+posit<32,2>    red-black sor sweep  time    1.352e+00 sec  rate    3.879e+06 points/sec
+ */
+
+int main()
+try {
+	std::cout << "points/sec of the matrix-free stencil kernels\n";
+	StencilWorkload<float>("float", 4096, 5);
+	StencilWorkload<double>("double", 4096, 5);
+	StencilWorkload< sw::universal::posit<32, 2> >("posit<32,2>", 1024, 5);
+
+	return EXIT_SUCCESS;
+}
+catch (char const* msg) {
+	std::cerr << "Caught exception: " << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_arithmetic_exception& err) {
+	std::cerr << "Uncaught universal arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_internal_exception& err) {
+	std::cerr << "Uncaught universal internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
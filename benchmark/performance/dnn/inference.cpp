@@ -0,0 +1,102 @@
+// inference.cpp: images/sec performance measurement of mixed-precision DNN inference
+//
+// Copyright (C) 2017-2023 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <chrono>
+#include <random>
+#include <universal/number/cfloat/cfloat.hpp>
+#include <universal/number/lns/lns.hpp>
+#include <universal/number/posit/posit.hpp>
+#include <universal/dnn/dnn.hpp>
+#include <universal/benchmark/performance_runner.hpp>
+
+/*
+   LeNet-5 forward inference throughput as a function of the weight number system,
+   the accumulation number system, and the number of threads the batch is partitioned across.
+ */
+
+template<typename WeightType, typename ActivationType, typename AccumulationType>
+void LeNet5InferenceBenchmark(const std::string& tag, unsigned batchSize) {
+	using namespace sw::universal;
+	using namespace std::chrono;
+
+	dnn::dnn<float> network("LeNet-5", 0.1f);
+	auto convLayer1 = dnn::CreateConvolutionLayer<WeightType, ActivationType, AccumulationType>(1, 6, 5, 5, 1, 0, dnn::Activation::Tanh);
+	auto poolLayer1 = dnn::CreatePoolingLayer<ActivationType>(dnn::LayerOperation::AvgPooling, 2, 2);
+	auto convLayer2 = dnn::CreateConvolutionLayer<WeightType, ActivationType, AccumulationType>(6, 16, 5, 5, 1, 0, dnn::Activation::Tanh);
+	auto poolLayer2 = dnn::CreatePoolingLayer<ActivationType>(dnn::LayerOperation::AvgPooling, 2, 2);
+	auto fcLayer1 = dnn::CreateFullyConnectedLayer<WeightType, ActivationType, AccumulationType>(400, 120, dnn::Activation::Tanh);
+	auto fcLayer2 = dnn::CreateFullyConnectedLayer<WeightType, ActivationType, AccumulationType>(120, 84, dnn::Activation::Tanh);
+	auto fcLayer3 = dnn::CreateFullyConnectedLayer<WeightType, ActivationType, AccumulationType>(84, 10, dnn::Activation::Identity);
+	convLayer1.initialize(1);
+	convLayer2.initialize(2);
+	fcLayer1.initialize(3);
+	fcLayer2.initialize(4);
+	fcLayer3.initialize(5);
+	network.addLayer(convLayer1);
+	network.addLayer(poolLayer1);
+	network.addLayer(convLayer2);
+	network.addLayer(poolLayer2);
+	network.addLayer(fcLayer1);
+	network.addLayer(fcLayer2);
+	network.addLayer(fcLayer3);
+
+	dnn::tensor<ActivationType> images(batchSize, 1, 32, 32);
+	std::mt19937 generator(42);
+	std::uniform_real_distribution<double> distribution(0.0, 1.0);
+	for (size_t i = 0; i < images.size(); ++i) images[i] = ActivationType(distribution(generator));
+
+	std::vector<unsigned> threadCounts;
+	for (unsigned nrThreads = 1; nrThreads < hardware_threads(); nrThreads *= 2) threadCounts.push_back(nrThreads);
+	threadCounts.push_back(hardware_threads());
+	for (auto nrThreads : threadCounts) {
+		steady_clock::time_point begin = steady_clock::now();
+		auto logits = network.infer(images, nrThreads);
+		steady_clock::time_point end = steady_clock::now();
+		double elapsed_time = duration_cast<duration<double>>(end - begin).count();
+		std::cout << std::setw(50) << std::left << tag << " threads " << std::setw(3) << nrThreads
+			<< " batch " << std::setw(4) << batchSize
+			<< std::setw(15) << std::right << elapsed_time << "sec -> " << toPowerOfTen(double(batchSize) / elapsed_time) << "images/sec\n";
+	}
+}
+
+int main()
+try {
+	using namespace sw::universal;
+
+	std::cout << "LeNet-5 inference performance\n";
+
+	using fp8    = cfloat<8, 2, std::uint8_t, true, true, false>;
+	using lns8   = lns<8, 3, std::uint8_t>;
+	using posit8 = posit<8, 0>;
+
+	LeNet5InferenceBenchmark<float, float, float>              ("weights float     activations float   acc float", 16);
+	LeNet5InferenceBenchmark<fp8, float, float>                ("weights cfloat<8> activations float   acc float", 16);
+	LeNet5InferenceBenchmark<lns8, float, float>               ("weights lns<8>    activations float   acc float", 16);
+	LeNet5InferenceBenchmark<posit8, float, float>             ("weights posit<8>  activations float   acc float", 16);
+	LeNet5InferenceBenchmark<posit8, posit8, quire<8, 0, 30>>  ("weights posit<8>  activations posit<8> acc quire", 2);
+
+	return EXIT_SUCCESS;
+}
+catch (char const* msg) {
+	std::cerr << "Caught ad-hoc exception: " << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_arithmetic_exception& err) {
+	std::cerr << "Caught unexpected universal arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_internal_exception& err) {
+	std::cerr << "Caught unexpected universal internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (std::runtime_error& err) {
+	std::cerr << "Caught unexpected runtime error: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
@@ -0,0 +1,120 @@
+// mx.cpp: performance of the quantization and the block-scaled GEMM of the microscaling (MX) formats
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <chrono>
+#include <universal/blas/blas.hpp>
+#include <universal/quantization/mx.hpp>
+
+template<typename Function>
+double Seconds(Function&& function) {
+	using namespace std::chrono;
+	steady_clock::time_point begin = steady_clock::now();
+	function();
+	steady_clock::time_point end = steady_clock::now();
+	return duration_cast<duration<double>>(end - begin).count();
+}
+
+template<typename Format>
+void MeasureQuantization(const sw::universal::blas::vector<float>& data) {
+	using namespace sw::universal;
+	mx_vector<Format> v(data.size());
+	double quantize = Seconds([&]() { v.quantize(data, 1); });
+	blas::vector<float> values(data.size());
+	double dequantize = Seconds([&]() { v.dequantize(values); });
+	double mvalues = double(data.size()) / 1.0e6;
+	std::cout << std::setw(12) << type_tag(Format()) << " : quantize " << std::setw(8) << std::setprecision(4) << mvalues / quantize << " Mvalues/sec"
+		<< "  dequantize " << std::setw(8) << mvalues / dequantize << " Mvalues/sec  "
+		<< std::setw(6) << std::setprecision(3) << 8.0 * double(v.bytes()) / double(data.size()) << " bits/value  (checksum " << values[data.size() / 2] << ")\n";
+}
+
+template<typename FA, typename FB>
+void MeasureGemm(const sw::universal::blas::matrix<float>& A, const sw::universal::blas::matrix<float>& B) {
+	using namespace sw::universal;
+	mx_matrix<FA> a(A, mx_axis::rows);
+	mx_matrix<FB> b(B, mx_axis::columns);
+	double gflop = 2.0 * double(A.rows()) * double(A.cols()) * double(B.cols()) / 1.0e9;
+	blas::matrix<float> C;
+	double t = Seconds([&]() { C = gemm(a, b, 1); });
+	std::cout << std::setw(12) << type_tag(FA()) << " x " << std::setw(12) << type_tag(FB()) << " : block-scaled gemm " << std::setw(8) << std::setprecision(4) << t << " sec "
+		<< std::setw(8) << gflop / t << " GFLOPS";
+	// reference: dequantize to float and multiply the float matrices
+	blas::matrix<float> Af, Bf, Cf;
+	double r = Seconds([&]() {
+		a.dequantize(Af);
+		b.dequantize(Bf);
+		Cf = Af * Bf;
+	});
+	double maxdiff{ 0 };
+	for (size_t i = 0; i < C.rows(); ++i) for (size_t j = 0; j < C.cols(); ++j) maxdiff = std::max(maxdiff, double(std::abs(C(i, j) - Cf(i, j))));
+	std::cout << "  dequantize + float gemm " << std::setw(8) << r << " sec " << std::setw(8) << gflop / r << " GFLOPS  max difference " << maxdiff << '\n';
+}
+
+/*
+10/19/2026: single core of a virtualized x86-64 host, g++ -O2
+The block-scaled GEMM multiplies the element integers of a block in an integer accumulator and scales the
+block product once, and runs twice as fast as dequantizing to float and multiplying floats, at a quarter to a
+half of the storage of float. The block products are exact, so for the formats whose blocks sum exactly in
+float the two products agree to the last bit; the differences of the FP8 formats are the rounding of the float
+reference, which accumulates the products of a row in float. The mixed FP8 x FP4 product widens the FP4
+elements to the 32-bit integers of FP8 and is the slowest.
+
+MX block-scaled format performance
+  mxfp8_e4m3 : quantize    129.2 Mvalues/sec  dequantize    457.7 Mvalues/sec    8.25 bits/value  (checksum 1.62)
+  mxfp8_e5m2 : quantize    114.2 Mvalues/sec  dequantize    374.4 Mvalues/sec    8.25 bits/value  (checksum 1.75)
+  mxfp6_e3m2 : quantize    99.18 Mvalues/sec  dequantize    436.9 Mvalues/sec    6.25 bits/value  (checksum 1.75)
+  mxfp6_e2m3 : quantize    88.81 Mvalues/sec  dequantize    354.9 Mvalues/sec    6.25 bits/value  (checksum 1.62)
+  mxfp4_e2m1 : quantize    87.41 Mvalues/sec  dequantize    320.7 Mvalues/sec    4.25 bits/value  (checksum 1.5)
+      mxint8 : quantize    146.7 Mvalues/sec  dequantize    409.7 Mvalues/sec    8.25 bits/value  (checksum 1.67)
+gemm 256x1024 * 1024x256
+  mxfp8_e4m3 x   mxfp8_e4m3 : block-scaled gemm   0.0377 sec    3.561 GFLOPS  dequantize + float gemm  0.07493 sec    1.791 GFLOPS  max difference 1.526e-05
+  mxfp8_e5m2 x   mxfp8_e5m2 : block-scaled gemm   0.0422 sec    3.181 GFLOPS  dequantize + float gemm  0.08083 sec    1.661 GFLOPS  max difference 1.144e-05
+  mxfp6_e2m3 x   mxfp6_e2m3 : block-scaled gemm  0.03331 sec    4.029 GFLOPS  dequantize + float gemm  0.08318 sec    1.613 GFLOPS  max difference 0
+  mxfp4_e2m1 x   mxfp4_e2m1 : block-scaled gemm  0.03942 sec    3.404 GFLOPS  dequantize + float gemm   0.1116 sec    1.202 GFLOPS  max difference 0
+  mxfp8_e4m3 x   mxfp4_e2m1 : block-scaled gemm  0.06294 sec    2.132 GFLOPS  dequantize + float gemm   0.1101 sec    1.219 GFLOPS  max difference 7.629e-06
+      mxint8 x       mxint8 : block-scaled gemm  0.03489 sec    3.847 GFLOPS  dequantize + float gemm  0.07759 sec     1.73 GFLOPS  max difference 0
+ */
+
+int main()
+try {
+	using namespace sw::universal;
+
+	std::cout << "MX block-scaled format performance\n";
+	blas::vector<float> data(16 * 1024 * 1024);
+	blas::gaussian_random(data, 0.0, 1.0);
+	MeasureQuantization<mxfp8_e4m3>(data);
+	MeasureQuantization<mxfp8_e5m2>(data);
+	MeasureQuantization<mxfp6_e3m2>(data);
+	MeasureQuantization<mxfp6_e2m3>(data);
+	MeasureQuantization<mxfp4>(data);
+	MeasureQuantization<mxint8>(data);
+
+	constexpr size_t M = 256, K = 1024, N = 256;
+	blas::matrix<float> A(M, K), B(K, N);
+	blas::gaussian_random(A, 0.0, 1.0);
+	blas::gaussian_random(B, 0.0, 1.0);
+	std::cout << "gemm " << M << 'x' << K << " * " << K << 'x' << N << '\n';
+	MeasureGemm<mxfp8_e4m3, mxfp8_e4m3>(A, B);
+	MeasureGemm<mxfp8_e5m2, mxfp8_e5m2>(A, B);
+	MeasureGemm<mxfp6_e2m3, mxfp6_e2m3>(A, B);
+	MeasureGemm<mxfp4, mxfp4>(A, B);
+	MeasureGemm<mxfp8_e4m3, mxfp4>(A, B);
+	MeasureGemm<mxint8, mxint8>(A, B);
+
+	return EXIT_SUCCESS;
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
@@ -0,0 +1,123 @@
+// qsnr_sweep.cpp: performance of a quantization error sweep over a list of formats against a pass per format
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <chrono>
+#include <universal/number/fixpnt/fixpnt.hpp>
+#include <universal/number/cfloat/cfloat.hpp>
+#include <universal/number/posit/posit.hpp>
+#include <universal/number/lns/lns.hpp>
+#include <universal/number/takum/takum.hpp>
+#include <universal/blas/blas.hpp>
+#include <universal/quantization/qsnr.hpp>
+
+template<typename Function>
+double Seconds(Function&& function) {
+	using namespace std::chrono;
+	steady_clock::time_point begin = steady_clock::now();
+	function();
+	steady_clock::time_point end = steady_clock::now();
+	return duration_cast<duration<double>>(end - begin).count();
+}
+
+namespace sw { namespace universal {
+	using fp6e3m2 = cfloat<6, 3, std::uint8_t, true, true, false>;
+	using fp4e2m1 = cfloat<4, 2, std::uint8_t, true, true, false>;
+
+	using dl_formats = format_list<fp8e4m3, fp8e5m2, fp6e3m2, fp4e2m1, posit<8, 0>, posit<8, 2>, lns<8, 3>, fixpnt<8, 4>>;
+}}
+
+// the QSNR of each format with a pass over the data per format
+template<typename... Targets>
+double PassPerFormat(sw::universal::format_list<Targets...>, const sw::universal::blas::vector<double>& data) {
+	double checksum{ 0 };
+	((checksum += sw::universal::qsnr<Targets>(data)), ...);
+	return checksum;
+}
+
+void MeasureSweep(size_t N, bool measurePassPerFormat) {
+	using namespace sw::universal;
+	blas::vector<double> data(N);
+	blas::gaussian_random(data, 0.0, 1.0);
+	double megabytes = double(N * sizeof(double)) / (1024.0 * 1024.0);
+	std::cout << "data set of " << megabytes << " MB, " << dl_formats::size << " formats\n";
+
+	if (measurePassPerFormat) {
+		double checksum{ 0 };
+		double t = Seconds([&]() { checksum = PassPerFormat(dl_formats{}, data); });
+		std::cout << "pass per format   : " << std::setw(8) << std::setprecision(4) << t << " sec  " << std::setw(8) << megabytes / t << " MB/sec  (checksum " << checksum << ")\n";
+	}
+	std::vector<quantization_report> reports;
+	double serial = Seconds([&]() { reports = qsnr_sweep(dl_formats{}, data, 1); });
+	std::cout << "sweep, 1 thread   : " << std::setw(8) << std::setprecision(4) << serial << " sec  " << std::setw(8) << megabytes / serial << " MB/sec\n";
+	double parallel = Seconds([&]() { reports = qsnr_sweep(dl_formats{}, data); });
+	std::cout << "sweep, " << hardware_threads() << " threads  : " << std::setw(8) << std::setprecision(4) << parallel << " sec  " << std::setw(8) << megabytes / parallel << " MB/sec\n";
+	for (const auto& report : reports) std::cout << report << '\n';
+	// a format whose conversion is not tabulated
+	double untabulated = Seconds([&]() { reports = qsnr_sweep<takum<8>>(data); });
+	std::cout << "takum<8>, untabulated : " << std::setw(8) << std::setprecision(4) << untabulated << " sec\n" << reports[0] << '\n';
+}
+
+/*
+10/19/2026: single core of a virtualized x86-64 host, g++ -O2
+The sweep reads the data once and rounds through the quantizer tables, and runs three times faster than a
+pass per format through the arithmetic conversions: 1GB in 16 seconds on one core, which the tiles divide
+over the cores of a larger host. The pass per format reports an infinite noise for fp4e2m1, which does not
+saturate; the sweep counts those values as overflows. takum<8> does not convert monotonically and is not
+tabulated: a sweep of it alone costs as much as the eight tabulated formats.
+
+Quantization sweep performance
+data set of 128 MB, 8 formats
+pass per format   :    6.157 sec     20.79 MB/sec  (checksum -inf)
+sweep, 1 thread   :     2.34 sec      54.7 MB/sec
+sweep, 1 threads  :    2.068 sec     61.89 MB/sec
+cfloat<  8,   4, uint8_t, hasSubnormals, hasSupernormals, notSaturating> QSNR   31.519 dB  max error   2.4982e-01  zeros    12986  overflows        0
+cfloat<  8,   5, uint8_t, hasSubnormals, hasSupernormals, notSaturating> QSNR   25.541 dB  max error   4.9983e-01  zeros      101  overflows        0
+cfloat<  6,   3, uint8_t, hasSubnormals, hasSupernormals, notSaturating> QSNR   25.456 dB  max error   4.9983e-01  zeros   418444  overflows        0
+cfloat<  4,   2, uint8_t, hasSubnormals, hasSupernormals, notSaturating> QSNR   16.353 dB  max error   5.0000e-01  zeros  3309984  overflows     7806
+posit<  8, 0>                                                QSNR   40.130 dB  max error   2.4982e-01  zeros        0  overflows        0
+posit<  8, 2>                                                QSNR   31.519 dB  max error   2.4982e-01  zeros        0  overflows        0
+lns<  8,   3, uint8_t, Saturating>                           QSNR   32.031 dB  max error   2.1580e-01  zeros    54781  overflows        0
+fixpnt<  8,   4,     Modulo, h>                              QSNR   34.876 dB  max error   3.1250e-02  zeros   418444  overflows        0
+takum<8>, untabulated :    2.277 sec
+takum<  8, uint8_t>                                          QSNR   21.015 dB  max error   1.2308e+00  zeros        0  overflows        0
+data set of 1024 MB, 8 formats
+sweep, 1 thread   :    16.34 sec     62.69 MB/sec
+sweep, 1 threads  :    15.49 sec     66.11 MB/sec
+cfloat<  8,   4, uint8_t, hasSubnormals, hasSupernormals, notSaturating> QSNR   31.520 dB  max error   2.4999e-01  zeros   104482  overflows        0
+cfloat<  8,   5, uint8_t, hasSubnormals, hasSupernormals, notSaturating> QSNR   25.543 dB  max error   5.0000e-01  zeros      836  overflows        0
+cfloat<  6,   3, uint8_t, hasSubnormals, hasSupernormals, notSaturating> QSNR   25.458 dB  max error   5.0000e-01  zeros  3347210  overflows        0
+cfloat<  4,   2, uint8_t, hasSubnormals, hasSupernormals, notSaturating> QSNR   16.353 dB  max error   5.0000e-01  zeros 26493736  overflows    62537
+posit<  8, 0>                                                QSNR   40.131 dB  max error   2.4999e-01  zeros        0  overflows        0
+posit<  8, 2>                                                QSNR   31.519 dB  max error   2.4999e-01  zeros        0  overflows        0
+lns<  8,   3, uint8_t, Saturating>                           QSNR   32.035 dB  max error   2.2567e-01  zeros   436809  overflows        0
+fixpnt<  8,   4,     Modulo, h>                              QSNR   34.874 dB  max error   3.1250e-02  zeros  3347210  overflows        0
+takum<8>, untabulated :    17.88 sec
+takum<  8, uint8_t>                                          QSNR   21.013 dB  max error   1.2430e+00  zeros        0  overflows        0
+ */
+
+int main()
+try {
+	using namespace sw::universal;
+
+	std::cout << "Quantization sweep performance\n";
+	MeasureSweep(16 * 1024 * 1024, true);      // 128MB
+	MeasureSweep(128 * 1024 * 1024, false);    // 1GB
+
+	return EXIT_SUCCESS;
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
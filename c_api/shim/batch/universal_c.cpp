@@ -0,0 +1,297 @@
+// universal_c.cpp: implementation of the vectorized C API for posits and cfloats
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+#include <vector>
+#define UNIVERSAL_C_BUILDING
+#include <universal/number/posit/posit_c_batch.h>
+#include <universal/number/cfloat/cfloat_c_batch.h>
+
+// configure the C++ library
+// Disable exceptions: NaR and NaN propagate through the batch kernels
+#define POSIT_THROW_ARITHMETIC_EXCEPTION 0
+#define CFLOAT_THROW_ARITHMETIC_EXCEPTION 0
+// Unlike the scalar shim, the batch API uses the fast specializations of the standard posits
+#define POSIT_FAST_POSIT_8_0   1
+#define POSIT_FAST_POSIT_16_1  1
+#define POSIT_FAST_POSIT_32_2  1
+// Now include the C++ library
+#include <universal/number/posit/posit.hpp>
+#include <universal/number/cfloat/cfloat.hpp>
+#include <universal/number/float/kulisch.hpp>
+
+namespace {
+
+using namespace sw::universal;
+
+// decode a standard posit of at most 64 bits to double: the regime, exponent, and fraction are read with
+// word operations and the significand of posit<64,3> is rounded once by the integer to double conversion
+template<unsigned nbits, unsigned es>
+double posit_to_double(uint64_t bits) noexcept {
+	constexpr uint64_t mask = (nbits == 64 ? ~uint64_t(0) : (uint64_t(1) << nbits) - 1);
+	constexpr uint64_t nar = uint64_t(1) << (nbits - 1);
+	bits &= mask;
+	if (bits == 0) return 0.0;
+	if (bits == nar) return std::numeric_limits<double>::quiet_NaN();
+	bool negative = (bits & nar) != 0;
+	if (negative) bits = (0 - bits) & mask;
+	uint64_t x = bits << (65 - nbits);               // the bits after the sign, left aligned
+	int m = (x >> 63) ? std::countl_one(x) : std::countl_zero(x);
+	int k = (x >> 63) ? m - 1 : -m;
+	x = (m + 1 < 64 ? x << (m + 1) : 0);             // drop the regime and its terminating bit
+	int e = 0;
+	if constexpr (es > 0) {
+		e = int(x >> (64 - es));
+		x <<= es;
+	}
+	uint64_t significand = (uint64_t(1) << 63) | (x >> 1);
+	double v = std::ldexp(double(significand), k * (1 << es) + e - 63);
+	return (negative ? -v : v);
+}
+
+// encode a double as a standard posit of at most 64 bits, rounding the encoding to nearest, ties to even:
+// values beyond maxpos and below minpos saturate, infinities and NaN are NaR
+template<unsigned nbits, unsigned es>
+uint64_t posit_from_double(double v) noexcept {
+	constexpr uint64_t mask = (nbits == 64 ? ~uint64_t(0) : (uint64_t(1) << nbits) - 1);
+	constexpr uint64_t nar = uint64_t(1) << (nbits - 1);
+	constexpr int maxScale = int(nbits - 2) << es;
+	if (v == 0.0) return 0;
+	if (!std::isfinite(v)) return nar;
+	bool negative = std::signbit(v);
+	int exponent;
+	double f = std::frexp(std::fabs(v), &exponent);   // f in [0.5, 1)
+	int scale = exponent - 1;
+	uint64_t body;
+	if (scale >= maxScale) {
+		body = nar - 1;                                // maxpos
+	}
+	else if (scale < -maxScale) {
+		body = 1;                                      // minpos
+	}
+	else {
+		int k = (scale >= 0 ? scale >> es : -((-scale + (1 << es) - 1) >> es));
+		uint64_t e = uint64_t(scale - k * (1 << es));
+		uint64_t fraction = uint64_t(std::ldexp(f, 53)) << 11;   // left aligned, hidden bit in bit 63
+		fraction <<= 1;                                          // drop the hidden bit
+		// assemble regime, exponent, and fraction left aligned in a word, with the bits beyond it in sticky
+		uint64_t word;
+		int used;
+		if (k >= 0) { word = ~uint64_t(0) << (63 - k); used = k + 2; }
+		else        { word = uint64_t(1) << (63 + k);  used = 1 - k; }
+		bool sticky = false;
+		if constexpr (es > 0) {
+			if (used + int(es) <= 64) word |= e << (64 - used - int(es));
+			else {
+				int spill = used + int(es) - 64;
+				word |= e >> spill;
+				sticky = (e & ((uint64_t(1) << spill) - 1)) != 0;
+			}
+		}
+		used += int(es);
+		if (used < 64) {
+			word |= fraction >> used;
+			if (used > 0) sticky = sticky || (fraction << (64 - used)) != 0;
+		}
+		else {
+			sticky = sticky || fraction != 0;
+		}
+		// round the nbits - 1 bits after the sign
+		body = word >> (65 - nbits);
+		bool guard = (word >> (64 - nbits)) & 1;
+		if constexpr (nbits < 64) sticky = sticky || (word & ((uint64_t(1) << (64 - nbits)) - 1)) != 0;
+		if (guard && (sticky || (body & 1))) ++body;
+	}
+	return (negative ? (0 - body) & mask : body);
+}
+
+// decode and encode the C types without marshalling: the union member v holds the encoding
+template<typename Number, typename Encoding>
+struct codec {
+	static Number decode(Encoding e) noexcept {
+		Number v;
+		v.setbits(uint64_t(e.v));
+		return v;
+	}
+	static Encoding encode(const Number& v) noexcept {
+		Encoding e;
+		e.v = static_cast<decltype(e.v)>(v.block(0));
+		return e;
+	}
+	static Encoding from_double(double v) noexcept { return encode(Number(v)); }
+	static double to_double(Encoding e) noexcept { return double(decode(e)); }
+};
+
+template<unsigned nbits, unsigned es, typename Encoding>
+struct codec<posit<nbits, es>, Encoding> {
+	static posit<nbits, es> decode(Encoding e) noexcept {
+		posit<nbits, es> v;
+		v.setbits(uint64_t(e.v));
+		return v;
+	}
+	static Encoding encode(const posit<nbits, es>& v) noexcept {
+		Encoding e;
+		e.v = static_cast<decltype(e.v)>(v.bits());
+		return e;
+	}
+	static Encoding from_double(double v) noexcept {
+		Encoding e;
+		e.v = static_cast<decltype(e.v)>(posit_from_double<nbits, es>(v));
+		return e;
+	}
+	static double to_double(Encoding e) noexcept { return posit_to_double<nbits, es>(uint64_t(e.v)); }
+};
+
+// the encoding of fp32 is IEEE-754 binary32: its native specialization is the hardware float
+template<>
+struct codec<float, fp32_t> {
+	static float decode(fp32_t e) noexcept {
+		float v;
+		std::memcpy(&v, &e.v, sizeof(float));
+		return v;
+	}
+	static fp32_t encode(float v) noexcept {
+		fp32_t e;
+		std::memcpy(&e.v, &v, sizeof(float));
+		return e;
+	}
+	static fp32_t from_double(double v) noexcept { return encode(float(v)); }
+	static double to_double(fp32_t e) noexcept { return double(decode(e)); }
+};
+
+template<typename Number, typename Encoding>
+struct batch {
+	using Codec = codec<Number, Encoding>;
+
+	static void from_doubles(const double* in, Encoding* out, size_t n) noexcept {
+		for (size_t i = 0; i < n; ++i) out[i] = Codec::from_double(in[i]);
+	}
+	static void to_doubles(const Encoding* in, double* out, size_t n) noexcept {
+		for (size_t i = 0; i < n; ++i) out[i] = Codec::to_double(in[i]);
+	}
+	static Number dot(const Encoding* x, const Encoding* y, size_t n) noexcept {
+		Number sum(0);
+		for (size_t i = 0; i < n; ++i) sum += Codec::decode(x[i]) * Codec::decode(y[i]);
+		return sum;
+	}
+	static void axpy(Encoding a, const Encoding* x, Encoding* y, size_t n) noexcept {
+		Number alpha = Codec::decode(a);
+		for (size_t i = 0; i < n; ++i) y[i] = Codec::encode(alpha * Codec::decode(x[i]) + Codec::decode(y[i]));
+	}
+	static void gemm(size_t m, size_t n, size_t k, Encoding alpha, const Encoding* A, const Encoding* B, Encoding beta, Encoding* C) noexcept {
+		Number a = Codec::decode(alpha), b = Codec::decode(beta);
+		bool scaleC = !(b == Number(0));
+		std::vector<Number> row(n);
+		for (size_t i = 0; i < m; ++i) {
+			// accumulate row i of A * B in the order of the dot product, a row of B at a time
+			for (size_t j = 0; j < n; ++j) row[j] = Number(0);
+			for (size_t p = 0; p < k; ++p) {
+				Number aip = Codec::decode(A[i * k + p]);
+				const Encoding* Bp = B + p * n;
+				for (size_t j = 0; j < n; ++j) row[j] += aip * Codec::decode(Bp[j]);
+			}
+			Encoding* Ci = C + i * n;
+			for (size_t j = 0; j < n; ++j) {
+				Number cij = a * row[j];
+				if (scaleC) cij += b * Codec::decode(Ci[j]);
+				Ci[j] = Codec::encode(cij);
+			}
+		}
+	}
+};
+
+// the exact sum in a Kulisch accumulator, rounded to odd in Real: the sum S is rounded to hi, and when the
+// remainder S - hi is not zero, the result is whichever of hi and the Real next to it toward S has an odd
+// significand. The result is never a value of a format with at least two fewer significand bits than Real,
+// nor a midpoint between two of its values, so that format rounds the result as it would round S.
+template<typename Real>
+Real round_to_odd(kulisch_accumulator<Real>& q) noexcept {
+	using Bits = std::conditional_t<sizeof(Real) == sizeof(uint64_t), uint64_t, uint32_t>;
+	Real hi = q.value();
+	if (!std::isfinite(hi)) return hi;
+	q -= hi;
+	Real lo = q.value();
+	if (lo == Real(0) || (std::bit_cast<Bits>(hi) & 1u)) return hi;
+	return std::nextafter(hi, (lo > Real(0) ? std::numeric_limits<Real>::infinity() : -std::numeric_limits<Real>::infinity()));
+}
+
+// fused dot product of posits: the posits of up to 32 bits are doubles and their products are exact in the
+// double Kulisch accumulator. posit<64,3> accumulates in the quire, with a capacity of 2^30 products.
+template<unsigned nbits, unsigned es, typename Encoding>
+posit<nbits, es> fdot(const Encoding* x, const Encoding* y, size_t n, const posit<nbits, es>*) {
+	using Codec = codec<posit<nbits, es>, Encoding>;
+	posit<nbits, es> sum;
+	if constexpr (nbits <= 32) {
+		kulisch_accumulator<double> q;
+		for (size_t i = 0; i < n; ++i) q.add_product(Codec::to_double(x[i]), Codec::to_double(y[i]));
+		sum.setbits(posit_from_double<nbits, es>(round_to_odd(q)));
+	}
+	else {
+		quire<nbits, es, 30> q(0);
+		for (size_t i = 0; i < n; ++i) q += quire_mul(Codec::decode(x[i]), Codec::decode(y[i]));
+		convert(q.to_value(), sum);
+	}
+	return sum;
+}
+
+// fused dot product of the 16-bit cfloats: their products are exact in the float Kulisch accumulator
+template<unsigned nbits, unsigned es, typename bt, bool sub, bool sup, bool sat, typename Encoding>
+cfloat<nbits, es, bt, sub, sup, sat> fdot(const Encoding* x, const Encoding* y, size_t n, const cfloat<nbits, es, bt, sub, sup, sat>*) {
+	using Number = cfloat<nbits, es, bt, sub, sup, sat>;
+	using Codec = codec<Number, Encoding>;
+	kulisch_accumulator<float> q;
+	for (size_t i = 0; i < n; ++i) q.add_product(float(Codec::decode(x[i])), float(Codec::decode(y[i])));
+	return Number(round_to_odd(q));
+}
+
+template<typename Encoding>
+float fdot(const Encoding* x, const Encoding* y, size_t n, const float*) {
+	static_assert(sizeof(Encoding) == sizeof(float), "fdot: float requires a 32-bit encoding");
+	kulisch_accumulator<float> q;
+	q.add_products(reinterpret_cast<const float*>(x), reinterpret_cast<const float*>(y), n);
+	return q.value();
+}
+
+using posit8  = posit<8, 0>;
+using posit16 = posit<16, 1>;
+using posit32 = posit<32, 2>;
+using posit64 = posit<64, 3>;
+using bfloat16 = cfloat<16, 8, uint16_t, true, false, false>;
+
+} // namespace
+
+// prevent any symbol mangling
+extern "C" {
+
+#define UNIVERSAL_C_BATCH_IMPL(T, Number) \
+	void T##_from_doubles(const double* in, T##_t* out, size_t n) { batch<Number, T##_t>::from_doubles(in, out, n); } \
+	void T##_to_doubles(const T##_t* in, double* out, size_t n) { batch<Number, T##_t>::to_doubles(in, out, n); } \
+	T##_t T##_dot(const T##_t* x, const T##_t* y, size_t n) { \
+		return codec<Number, T##_t>::encode(batch<Number, T##_t>::dot(x, y, n)); \
+	} \
+	T##_t T##_fdot(const T##_t* x, const T##_t* y, size_t n) { \
+		return codec<Number, T##_t>::encode(fdot(x, y, n, static_cast<const Number*>(nullptr))); \
+	} \
+	void T##_axpy(T##_t a, const T##_t* x, T##_t* y, size_t n) { batch<Number, T##_t>::axpy(a, x, y, n); } \
+	void T##_gemm(size_t m, size_t n, size_t k, T##_t alpha, const T##_t* A, const T##_t* B, T##_t beta, T##_t* C) { \
+		batch<Number, T##_t>::gemm(m, n, k, alpha, A, B, beta, C); \
+	}
+
+UNIVERSAL_C_BATCH_IMPL(posit8,   posit8)
+UNIVERSAL_C_BATCH_IMPL(posit16,  posit16)
+UNIVERSAL_C_BATCH_IMPL(posit32,  posit32)
+UNIVERSAL_C_BATCH_IMPL(posit64,  posit64)
+UNIVERSAL_C_BATCH_IMPL(fp16,     half)
+UNIVERSAL_C_BATCH_IMPL(bfloat16, bfloat16)
+UNIVERSAL_C_BATCH_IMPL(fp32,     float)
+
+#undef UNIVERSAL_C_BATCH_IMPL
+
+}
@@ -0,0 +1,101 @@
+// cfloat_batch.c: test of the vectorized cfloat API for C programs
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <universal/number/cfloat/cfloat_c_batch.h>
+
+// generate a test of the batch entry points of a cfloat type
+// big is a power of two for which big + 1 rounds to big, so that only the fused dot product recovers the 1
+#define VERIFY_BATCH(T, big) \
+static int verify_##T(void) { \
+	int fails = 0; \
+	double in[6] = { 0.5, 1.0, 1.5, -2.0, 3.0, 0.25 }; \
+	double out[6]; \
+	T##_t x[6], y[6], a, r; \
+	/* bulk conversion of values that are exact in all formats */ \
+	T##_from_doubles(in, x, 6); \
+	T##_to_doubles(x, out, 6); \
+	for (int i = 0; i < 6; ++i) if (out[i] != in[i]) { printf("FAIL: %s conversion of %g produced %g\n", #T, in[i], out[i]); ++fails; } \
+	/* rounded and fused dot products */ \
+	double ones[3] = { 1.0, 1.0, 1.0 }; \
+	double cancel[3] = { big, 1.0, -(big) }; \
+	T##_from_doubles(in, x, 3); \
+	T##_from_doubles(ones, y, 3); \
+	r = T##_dot(x, y, 3); \
+	T##_to_doubles(&r, out, 1); \
+	if (out[0] != 3.0) { printf("FAIL: %s dot produced %g instead of 3\n", #T, out[0]); ++fails; } \
+	T##_from_doubles(cancel, x, 3); \
+	r = T##_dot(x, y, 3); \
+	T##_to_doubles(&r, out, 1); \
+	if (out[0] != 0.0) { printf("FAIL: %s dot produced %g instead of 0\n", #T, out[0]); ++fails; } \
+	r = T##_fdot(x, y, 3); \
+	T##_to_doubles(&r, out, 1); \
+	if (out[0] != 1.0) { printf("FAIL: %s fdot produced %g instead of 1\n", #T, out[0]); ++fails; } \
+	/* y = 2 * x + y */ \
+	double two = 2.0, zero = 0.0; \
+	T##_from_doubles(&two, &a, 1); \
+	T##_from_doubles(in, x, 3); \
+	T##_axpy(a, x, y, 3); \
+	T##_to_doubles(y, out, 3); \
+	for (int i = 0; i < 3; ++i) if (out[i] != 2.0 * in[i] + 1.0) { printf("FAIL: %s axpy produced %g instead of %g\n", #T, out[i], 2.0 * in[i] + 1.0); ++fails; } \
+	/* C = A * B with a C that must not be read, then C = 2 * A * B + C */ \
+	double dA[6] = { 1.0, 2.0, 0.0, -1.0, 0.5, 1.0 }; \
+	double dB[6] = { 1.0, 0.0, 0.5, 1.0, 2.0, -1.0 }; \
+	double dC[4] = { 2.0, 2.0, 1.25, -0.5 };   /* A * B */ \
+	double nan[4] = { NAN, NAN, NAN, NAN }; \
+	T##_t A[6], B[6], C[4], alpha, beta; \
+	T##_from_doubles(dA, A, 6); \
+	T##_from_doubles(dB, B, 6); \
+	T##_from_doubles(nan, C, 4); \
+	T##_from_doubles(&ones[0], &alpha, 1); \
+	T##_from_doubles(&zero, &beta, 1); \
+	T##_gemm(2, 2, 3, alpha, A, B, beta, C); \
+	T##_to_doubles(C, out, 4); \
+	for (int i = 0; i < 4; ++i) if (out[i] != dC[i]) { printf("FAIL: %s gemm produced %g instead of %g\n", #T, out[i], dC[i]); ++fails; } \
+	T##_gemm(2, 2, 3, a, A, B, alpha, C); \
+	T##_to_doubles(C, out, 4); \
+	for (int i = 0; i < 4; ++i) if (out[i] != 3.0 * dC[i]) { printf("FAIL: %s gemm produced %g instead of %g\n", #T, out[i], 3.0 * dC[i]); ++fails; } \
+	printf("%-9s batch  %s\n", #T, (fails ? "FAIL" : "PASS")); \
+	return fails; \
+}
+
+// the exact sum 1 + 3 * 2^-(fbits + 1) - 2^-23 + 2^-48 lies just below the midpoint between 1 + 2^-fbits and
+// 1 + 2^-(fbits - 1), and one ulp of float from it: the fused dot product must round it down to 1 + 2^-fbits
+#define VERIFY_FDOT_ROUNDING(T, fbits) \
+static int verify_fdot_rounding_##T(void) { \
+	int fails = 0; \
+	double dx[4] = { 1.0, ldexp(3.0, -(fbits + 1)), -ldexp(1.0, -23), ldexp(1.0, -24) }; \
+	double dy[4] = { 1.0, 1.0, 1.0, ldexp(1.0, -24) }; \
+	double out; \
+	T##_t x[4], y[4], r; \
+	T##_from_doubles(dx, x, 4); \
+	T##_from_doubles(dy, y, 4); \
+	r = T##_fdot(x, y, 4); \
+	T##_to_doubles(&r, &out, 1); \
+	if (out != 1.0 + ldexp(1.0, -fbits)) { printf("FAIL: %s fdot produced %a instead of %a\n", #T, out, 1.0 + ldexp(1.0, -fbits)); ++fails; } \
+	printf("%-9s fdot rounding %s\n", #T, (fails ? "FAIL" : "PASS")); \
+	return fails; \
+}
+
+VERIFY_BATCH(fp16, 4096.0)
+VERIFY_BATCH(bfloat16, 1024.0)
+VERIFY_BATCH(fp32, 1073741824.0)
+
+VERIFY_FDOT_ROUNDING(fp16, 10)
+VERIFY_FDOT_ROUNDING(bfloat16, 7)
+
+int main(int argc, char* argv[])
+{
+	int fails = 0;
+	fails += verify_fp16();
+	fails += verify_bfloat16();
+	fails += verify_fp32();
+	fails += verify_fdot_rounding_fp16();
+	fails += verify_fdot_rounding_bfloat16();
+	return fails > 0 ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,121 @@
+// posit_batch.c: test of the vectorized posit API for C programs
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <math.h>
+#include <universal/number/posit/posit_c_batch.h>
+
+// generate a test of the batch entry points of a posit type
+// big is a power of two for which big + 1 rounds to big, so that only the fused dot product recovers the 1
+#define VERIFY_BATCH(nbits, big) \
+static int verify_posit##nbits(void) { \
+	int fails = 0; \
+	double in[6] = { 0.5, 1.0, 1.5, -2.0, 3.0, 0.25 }; \
+	double out[6]; \
+	posit##nbits##_t x[6], y[6], a, r; \
+	/* bulk conversion of values that are exact in all standard posits */ \
+	posit##nbits##_from_doubles(in, x, 6); \
+	posit##nbits##_to_doubles(x, out, 6); \
+	for (int i = 0; i < 6; ++i) if (out[i] != in[i]) { printf("FAIL: posit%d conversion of %g produced %g\n", nbits, in[i], out[i]); ++fails; } \
+	/* rounded and fused dot products */ \
+	double ones[3] = { 1.0, 1.0, 1.0 }; \
+	double cancel[3] = { big, 1.0, -(big) }; \
+	posit##nbits##_from_doubles(in, x, 3); \
+	posit##nbits##_from_doubles(ones, y, 3); \
+	r = posit##nbits##_dot(x, y, 3); \
+	posit##nbits##_to_doubles(&r, out, 1); \
+	if (out[0] != 3.0) { printf("FAIL: posit%d dot produced %g instead of 3\n", nbits, out[0]); ++fails; } \
+	posit##nbits##_from_doubles(cancel, x, 3); \
+	r = posit##nbits##_dot(x, y, 3); \
+	posit##nbits##_to_doubles(&r, out, 1); \
+	if (out[0] != 0.0) { printf("FAIL: posit%d dot produced %g instead of 0\n", nbits, out[0]); ++fails; } \
+	r = posit##nbits##_fdot(x, y, 3); \
+	posit##nbits##_to_doubles(&r, out, 1); \
+	if (out[0] != 1.0) { printf("FAIL: posit%d fdot produced %g instead of 1\n", nbits, out[0]); ++fails; } \
+	/* y = 2 * x + y */ \
+	double two = 2.0, zero = 0.0; \
+	posit##nbits##_from_doubles(&two, &a, 1); \
+	posit##nbits##_from_doubles(in, x, 3); \
+	posit##nbits##_axpy(a, x, y, 3); \
+	posit##nbits##_to_doubles(y, out, 3); \
+	for (int i = 0; i < 3; ++i) if (out[i] != 2.0 * in[i] + 1.0) { printf("FAIL: posit%d axpy produced %g instead of %g\n", nbits, out[i], 2.0 * in[i] + 1.0); ++fails; } \
+	/* C = A * B with a C that must not be read, then C = 2 * A * B + C */ \
+	double dA[6] = { 1.0, 2.0, 0.0, -1.0, 0.5, 1.0 }; \
+	double dB[6] = { 1.0, 0.0, 0.5, 1.0, 2.0, -1.0 }; \
+	double dC[4] = { 2.0, 2.0, 1.25, -0.5 };   /* A * B */ \
+	double nan[4] = { NAN, NAN, NAN, NAN }; \
+	posit##nbits##_t A[6], B[6], C[4], alpha, beta; \
+	posit##nbits##_from_doubles(dA, A, 6); \
+	posit##nbits##_from_doubles(dB, B, 6); \
+	posit##nbits##_from_doubles(nan, C, 4); \
+	posit##nbits##_from_doubles(&ones[0], &alpha, 1); \
+	posit##nbits##_from_doubles(&zero, &beta, 1); \
+	posit##nbits##_gemm(2, 2, 3, alpha, A, B, beta, C); \
+	posit##nbits##_to_doubles(C, out, 4); \
+	for (int i = 0; i < 4; ++i) if (out[i] != dC[i]) { printf("FAIL: posit%d gemm produced %g instead of %g\n", nbits, out[i], dC[i]); ++fails; } \
+	posit##nbits##_gemm(2, 2, 3, a, A, B, alpha, C); \
+	posit##nbits##_to_doubles(C, out, 4); \
+	for (int i = 0; i < 4; ++i) if (out[i] != 3.0 * dC[i]) { printf("FAIL: posit%d gemm produced %g instead of %g\n", nbits, out[i], 3.0 * dC[i]); ++fails; } \
+	printf("posit%-3d batch  %s\n", nbits, (fails ? "FAIL" : "PASS")); \
+	return fails; \
+}
+
+// every encoding survives the bulk conversion to double and back
+#define VERIFY_ROUNDTRIP(nbits) \
+static int verify_roundtrip##nbits(void) { \
+	enum { N = 1 << nbits }; \
+	static posit##nbits##_t p[N], q[N]; \
+	static double d[N]; \
+	int fails = 0; \
+	for (int i = 0; i < N; ++i) p[i].v = i; \
+	posit##nbits##_to_doubles(p, d, N); \
+	posit##nbits##_from_doubles(d, q, N); \
+	for (int i = 0; i < N; ++i) if (q[i].v != p[i].v) { if (fails++ < 10) printf("FAIL: posit%d encoding 0x%x converted to %g and back to 0x%x\n", nbits, i, d[i], q[i].v); } \
+	printf("posit%-3d round trip %s\n", nbits, (fails ? "FAIL" : "PASS")); \
+	return fails; \
+}
+
+// the exact sum 1 + 3 * 2^-(fbits + 1) - 2^-52 + tiny^2 lies just below the midpoint between 1 + 2^-fbits and
+// 1 + 2^-(fbits - 1), and one ulp of double from it: the fused dot product must round it down to 1 + 2^-fbits
+#define VERIFY_FDOT_ROUNDING(nbits, fbits, tiny) \
+static int verify_fdot_rounding##nbits(void) { \
+	int fails = 0; \
+	double dx[4] = { 1.0, ldexp(3.0, -(fbits + 1)), -ldexp(1.0, -26), tiny }; \
+	double dy[4] = { 1.0, 1.0, ldexp(1.0, -26), tiny }; \
+	double out; \
+	posit##nbits##_t x[4], y[4], r; \
+	posit##nbits##_from_doubles(dx, x, 4); \
+	posit##nbits##_from_doubles(dy, y, 4); \
+	r = posit##nbits##_fdot(x, y, 4); \
+	posit##nbits##_to_doubles(&r, &out, 1); \
+	if (out != 1.0 + ldexp(1.0, -fbits)) { printf("FAIL: posit%d fdot produced %a instead of %a\n", nbits, out, 1.0 + ldexp(1.0, -fbits)); ++fails; } \
+	printf("posit%-3d fdot rounding %s\n", nbits, (fails ? "FAIL" : "PASS")); \
+	return fails; \
+}
+
+VERIFY_ROUNDTRIP(8)
+VERIFY_ROUNDTRIP(16)
+
+VERIFY_BATCH(8, 64.0)
+VERIFY_BATCH(16, 1048576.0)
+VERIFY_BATCH(32, 1099511627776.0)
+VERIFY_BATCH(64, 1208925819614629174706176.0)
+
+VERIFY_FDOT_ROUNDING(16, 12, ldexp(1.0, -28))
+VERIFY_FDOT_ROUNDING(32, 27, ldexp(1.0, -50))
+
+int main(int argc, char* argv[])
+{
+	int fails = 0;
+	fails += verify_roundtrip8();
+	fails += verify_roundtrip16();
+	fails += verify_posit8();
+	fails += verify_posit16();
+	fails += verify_posit32();
+	fails += verify_posit64();
+	fails += verify_fdot_rounding16();
+	fails += verify_fdot_rounding32();
+	return fails > 0 ? EXIT_FAILURE : EXIT_SUCCESS;
+}
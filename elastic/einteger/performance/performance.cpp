@@ -9,10 +9,38 @@
 #include <string>
 #include <cmath>
 #include <limits>
+#include <chrono>
+#include <vector>
 
 // minimum set of include files to reflect source code dependencies
 #include <universal/number/einteger/einteger.hpp>
 #include <universal/verification/test_suite.hpp>
+#include <universal/benchmark/performance_runner.hpp>
+
+// construct, copy, and add a working set of einteger values of a given size:
+// values that fit in the inline limbs of the einteger do not touch the heap
+template<typename BlockType>
+void CopyAndAddWorkload(size_t NR_OPS, unsigned bits) {
+	using namespace sw::universal;
+	using Integer = einteger<BlockType>;
+	constexpr size_t N = 1024;
+	std::vector<Integer> a(N), b(N);
+	Integer one(1);
+	for (size_t i = 0; i < N; ++i) {
+		a[i] = one;
+		a[i] <<= static_cast<int>(bits - 2);
+		a[i] += Integer(static_cast<long long>(i));
+	}
+	Integer checksum(0);
+	for (size_t rep = 0; rep < NR_OPS / N; ++rep) {
+		b = a;                               // copies
+		for (size_t i = 0; i < N; ++i) {
+			Integer sum = b[i] + a[N - 1 - i];  // temporaries
+			checksum = sum;
+		}
+	}
+	if (checksum.iszero()) std::cout << "checksum is zero\n";
+}
 
 // Regression testing guards: typically set by the cmake configuration, but MANUAL_TESTING is an override
 #define MANUAL_TESTING 1
@@ -43,6 +71,18 @@ try {
 
 #if MANUAL_TESTING
 
+	/*
+	10/19/2026: copy and add of einteger<uint32_t>, before and after the inline limb storage of EINTEGER_INLINE_BITS = 128
+	                  heap limbs         inline limbs
+	  64-bit values  :  30 Mops/sec          56 Mops/sec
+	 128-bit values  :  30 Mops/sec          50 Mops/sec
+	 512-bit values  :  24 Mops/sec          23 Mops/sec    (do not fit inline)
+	 */
+	std::cout << "einteger copy and add throughput\n";
+	PerformanceRunner("einteger<uint32_t>  64-bit copy+add ", [](size_t NR_OPS) { CopyAndAddWorkload<std::uint32_t>(NR_OPS, 64); }, 1024 * 1024);
+	PerformanceRunner("einteger<uint32_t> 128-bit copy+add ", [](size_t NR_OPS) { CopyAndAddWorkload<std::uint32_t>(NR_OPS, 128); }, 1024 * 1024);
+	PerformanceRunner("einteger<uint32_t> 512-bit copy+add ", [](size_t NR_OPS) { CopyAndAddWorkload<std::uint32_t>(NR_OPS, 512); }, 1024 * 1024);
+
 	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
 	return EXIT_SUCCESS; // ignore failures
 #else
@@ -20,6 +20,7 @@ constexpr uint32_t UNIVERSAL_AGGREGATE_TENSOR = 0x8008;
 #include <universal/blas/vector.hpp>
 #include <universal/blas/matrix.hpp>
 #include <universal/blas/tensor.hpp>
+#include <universal/blas/stencil.hpp>
 
 constexpr uint64_t SIZE_1K   = 1024;
 constexpr uint64_t SIZE_2K   = 2 * SIZE_1K;
@@ -54,12 +55,17 @@ constexpr uint64_t SIZE_512G = 512 * SIZE_1G;
 
 // L1 operators
 #include <universal/blas/blas_l1.hpp>
+#include <universal/blas/packed_vector.hpp>
 
 // L2
 #include <universal/blas/blas_l2.hpp>
 
+// reproducible reductions
+#include <universal/blas/reproducible.hpp>
+
 // L3
 #include <universal/blas/blas_l3.hpp>
+#include <universal/blas/einsum.hpp>
 #include <universal/blas/inverse.hpp>
 
 // Matrix operators
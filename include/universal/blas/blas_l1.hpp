@@ -6,11 +6,17 @@
 //
 // This file is part of the universal numbers project, which is released under an MIT Open Source license.
 #include <cmath>
+#include <algorithm>
+#include <utility>
 #include <universal/math/math>  // injection of native IEEE-754 math library functions into sw::universal namespace
 #include <universal/blas/vector.hpp>
+#include <universal/blas/execution.hpp>
 
 namespace sw { namespace universal { namespace blas { 
 
+// number of elements visited by a stride of inc through a container of the given size
+inline size_t strided_count(size_t size, size_t inc) { return (size + inc - 1) / inc; }
+
 // 1-norm of a vector: sum of magnitudes of the vector elements, default increment stride is 1
 template<typename Vector>
 typename Vector::value_type asum(size_t n, const Vector& x, size_t incx = 1) {
@@ -21,6 +27,15 @@ typename Vector::value_type asum(size_t n, const Vector& x, size_t incx = 1) {
 	}
 	return sum;
 }
+// 1-norm of a vector under an execution policy
+template<typename Vector>
+typename Vector::value_type asum(ExecutionPolicy policy, size_t n, const Vector& x, size_t incx = 1, unsigned nrThreads = 0) {
+	using value_type = typename Vector::value_type;
+	return reduce_terms<value_type>(policy, strided_count(n, incx), [&](size_t k) {
+		value_type e = x[k * incx];
+		return (e < 0 ? value_type(-e) : e);
+	}, nrThreads);
+}
 
 // sum of the vector elements, default increment stride is 1
 template<typename Vector>
@@ -41,6 +56,16 @@ void axpy(size_t n, Scalar a, const Vector& x, size_t incx, Vector& y, size_t in
 		y[iy] += a * x[ix];
 	}
 }
+// a times x plus y under an execution policy: all policies yield the same result
+template<typename Scalar, typename Vector>
+void axpy(ExecutionPolicy policy, size_t n, Scalar a, const Vector& x, size_t incx, Vector& y, size_t incy, unsigned nrThreads = 0) {
+	size_t cnt = std::min(n, std::min(strided_count(size(x), incx), strided_count(size(y), incy)));
+	for_each_chunk(policy, cnt, [&](size_t first, size_t last) {
+		for (size_t k = first; k < last; ++k) {
+			y[k * incy] += a * x[k * incx];
+		}
+	}, nrThreads);
+}
 
 // vector copy
 template<typename Vector>
@@ -68,6 +93,13 @@ typename Vector::value_type dot(size_t n, const Vector& x, size_t incx, const Ve
 	}
 	return sum_of_products;
 }
+// dot product under an execution policy
+template<typename Vector>
+typename Vector::value_type dot(ExecutionPolicy policy, size_t n, const Vector& x, size_t incx, const Vector& y, size_t incy, unsigned nrThreads = 0) {
+	using value_type = typename Vector::value_type;
+	size_t cnt = std::min(n, std::min(strided_count(size(x), incx), strided_count(size(y), incy)));
+	return reduce_terms<value_type>(policy, cnt, [&](size_t k) { return value_type(x[k * incx] * y[k * incy]); }, nrThreads);
+}
 // specialized dot product assuming constant stride
 template<typename Vector>
 typename Vector::value_type dot(const Vector& x, const Vector& y) {
@@ -81,6 +113,14 @@ typename Vector::value_type dot(const Vector& x, const Vector& y) {
 	}
 	return sum_of_products;
 }
+// specialized dot product assuming constant stride under an execution policy
+template<typename Vector>
+typename Vector::value_type dot(ExecutionPolicy policy, const Vector& x, const Vector& y, unsigned nrThreads = 0) {
+	using value_type = typename Vector::value_type;
+	size_t nx = size(x);
+	if (nx > size(y)) return value_type(0);
+	return reduce_terms<value_type>(policy, nx, [&](size_t i) { return value_type(x[i] * y[i]); }, nrThreads);
+}
 
 // rotation of points in the plane
 template<typename Rotation, typename Vector>
@@ -106,10 +146,20 @@ void rotg(T& a, T& b, T& c, T&s) {
 template<typename Scalar, typename Vector>
 void scale(size_t n, Scalar alpha, Vector& x, size_t incx) {
 	size_t cnt, ix;
-	for (cnt = 0, ix = 0; cnt < n && ix < size(x); ix += incx) {
+	for (cnt = 0, ix = 0; cnt < n && ix < size(x); ++cnt, ix += incx) {
 		x[ix] *= alpha;
 	}
 }
+// scale a vector under an execution policy: all policies yield the same result
+template<typename Scalar, typename Vector>
+void scale(ExecutionPolicy policy, size_t n, Scalar alpha, Vector& x, size_t incx, unsigned nrThreads = 0) {
+	size_t cnt = std::min(n, strided_count(size(x), incx));
+	for_each_chunk(policy, cnt, [&](size_t first, size_t last) {
+		for (size_t k = first; k < last; ++k) {
+			x[k * incx] *= alpha;
+		}
+	}, nrThreads);
+}
 
 // swap two vectors
 template<typename Vector>
@@ -127,7 +177,7 @@ template<typename Vector>
 size_t amax(size_t n, const Vector& x, size_t incx = 1) {
 	size_t ix{ 0 }, index{ 0 };
 	auto running_max = abs(x[ix]);
-	for (ix = 1; ix < n; ix += incx) {
+	for (ix = incx; ix < n; ix += incx) {
 		auto absolute = abs(x[ix]);
 		if (absolute > running_max) {
 			index = ix;
@@ -136,13 +186,40 @@ size_t amax(size_t n, const Vector& x, size_t incx = 1) {
 	}
 	return index;
 }
+// find the index of the element with maximum absolute value under an execution policy.
+// Chunk results are combined in order, so ties resolve to the first index as in the serial search.
+template<typename Vector>
+size_t amax(ExecutionPolicy policy, size_t n, const Vector& x, size_t incx = 1, unsigned nrThreads = 0) {
+	using Magnitude = decltype(abs(x[0]));
+	size_t cnt = strided_count(n, incx);
+	if (policy == ExecutionPolicy::Serial || cnt < 2) return amax(n, x, incx);
+	unsigned threads = blas_threads(cnt, nrThreads);
+	std::vector< std::pair<size_t, Magnitude> > partials(threads);
+	parallel_for(0, cnt, [&](size_t first, size_t last, unsigned t) {
+		size_t index = first;
+		Magnitude running_max = abs(x[first * incx]);
+		for (size_t k = first + 1; k < last; ++k) {
+			Magnitude absolute = abs(x[k * incx]);
+			if (absolute > running_max) {
+				index = k;
+				running_max = absolute;
+			}
+		}
+		partials[t] = std::make_pair(index, running_max);
+	}, threads);
+	std::pair<size_t, Magnitude> result = partials[0];
+	for (unsigned t = 1; t < threads; ++t) {
+		if (partials[t].second > result.second) result = partials[t];
+	}
+	return result.first * incx;
+}
 
 // find the index of the element with minimum absolute value
 template<typename Vector>
 size_t amin(size_t n, const Vector& x, size_t incx = 1) {
 	size_t ix{ 0 }, index{ 0 };
 	auto running_min = abs(x[ix]);
-	for (ix = 1; ix < n; ix += incx) {
+	for (ix = incx; ix < n; ix += incx) {
 		auto absolute = abs(x[ix]);
 		if (absolute < running_min) {
 			index = ix;
@@ -167,35 +244,45 @@ void strided_print(std::ostream& ostr, size_t n, Vector& x, size_t incx = 1) {
 	ostr << "]";
 }
 
-// norms
+// norms: the norms accept vectors and vector expressions, such as normL1(x_old - x), without materializing them
 
 // L1-norm of a vector
-template<typename Scalar>
-Scalar normL1(const sw::universal::blas::vector<Scalar>& v) {
+template<typename Expression>
+typename Expression::value_type normL1(const vector_expression<Expression>& expr) {
+	using Scalar = typename Expression::value_type;
+	const Expression& v = expr.derived();
 	Scalar L1Norm{ 0 };
-	for (const Scalar& e : v) {
+	for (size_t i = 0; i < v.size(); ++i) {
+		Scalar e = v[i];
 		L1Norm += abs(e);
 	}
 	return L1Norm;
 }
 
 // L2-norm of a vector
-template<typename Scalar>
-Scalar normL2(const sw::universal::blas::vector<Scalar>& v) {
+template<typename Expression>
+typename Expression::value_type normL2(const vector_expression<Expression>& expr) {
+	using Scalar = typename Expression::value_type;
+	using std::sqrt;
+	const Expression& v = expr.derived();
 	Scalar L2Norm{ 0 };
-	for (const Scalar& e : v) {
+	for (size_t i = 0; i < v.size(); ++i) {
+		Scalar e = v[i];
 		L2Norm += e * e;
 	}
 	return sqrt(L2Norm);
 }
 
 // L3-norm of a vector
-template<typename Scalar>
-Scalar normL3(const sw::universal::blas::vector<Scalar>& v) {
+template<typename Expression>
+typename Expression::value_type normL3(const vector_expression<Expression>& expr) {
+	using Scalar = typename Expression::value_type;
+	const Expression& v = expr.derived();
 	using namespace std;
 	using namespace sw::universal; // to specialize abs()
 	Scalar L3Norm{ 0 };
-	for (const Scalar& e : v) {
+	for (size_t i = 0; i < v.size(); ++i) {
+		Scalar e = v[i];
 		Scalar abse = abs(e);
 		L3Norm += abse * abse * abse;
 	}
@@ -203,10 +290,13 @@ Scalar normL3(const sw::universal::blas::vector<Scalar>& v) {
 }
 
 // L4-norm of a vector
-template<typename Scalar>
-Scalar normL4(const sw::universal::blas::vector<Scalar>& v) {
+template<typename Expression>
+typename Expression::value_type normL4(const vector_expression<Expression>& expr) {
+	using Scalar = typename Expression::value_type;
+	const Expression& v = expr.derived();
 	Scalar L4Norm{ 0 };
-	for (const Scalar& e : v) {
+	for (size_t i = 0; i < v.size(); ++i) {
+		Scalar e = v[i];
 		Scalar esqr = e * e;
 		L4Norm += esqr * esqr;
 	}
@@ -214,19 +304,24 @@ Scalar normL4(const sw::universal::blas::vector<Scalar>& v) {
 }
 
 // Linf-norm of a vector
-template<typename Scalar>
-Scalar normLinf(const sw::universal::blas::vector<Scalar>& v) {
+template<typename Expression>
+typename Expression::value_type normLinf(const vector_expression<Expression>& expr) {
+	using Scalar = typename Expression::value_type;
+	const Expression& v = expr.derived();
 	using namespace std;
 	using namespace sw::universal; // to specialize abs()
 	Scalar LinfNorm{ 0 };
-	for (const Scalar& e : v) {
+	for (size_t i = 0; i < v.size(); ++i) {
+		Scalar e = v[i];
 		LinfNorm = (abs(e) > LinfNorm) ? abs(e) : LinfNorm;
 	}
 	return LinfNorm;
 }
 
-template<typename Scalar>
-Scalar norm(const sw::universal::blas::vector<Scalar>& v, int p) {
+template<typename Expression>
+typename Expression::value_type norm(const vector_expression<Expression>& expr, int p) {
+	using Scalar = typename Expression::value_type;
+	const Expression& v = expr.derived();
 	using namespace std;
 	using namespace sw::universal; // to specialize pow() and abs()
 	Scalar norm{ 0 };
@@ -251,7 +346,8 @@ Scalar norm(const sw::universal::blas::vector<Scalar>& v, int p) {
 	default:
 		{
 			Scalar sp = Scalar( p );
-			for (const Scalar& e : v) {
+			for (size_t i = 0; i < v.size(); ++i) {
+				Scalar e = v[i];
 				norm += pow(abs(e), sp);
 			}
 			norm = pow(norm, Scalar( 1 ) / sp);
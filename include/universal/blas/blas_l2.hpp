@@ -30,4 +30,21 @@ namespace sw { namespace universal { namespace blas {
 		}
 	}
 
+	// Matrix-vector product b = A * x under an execution policy: blocks of rows are distributed 
+	// across threads and each row accumulates left to right, so all policies yield the same result.
+	// b is sized to the rows of A, as by the matrix-vector operator
+	template<typename Matrix, typename Vector>
+	void matvec(ExecutionPolicy policy, Vector& b, const Matrix& A, const Vector& x, unsigned nrThreads = 0) {
+		size_t rows = A.rows();
+		if (b.size() != rows) b.resize(rows);
+		if (policy == ExecutionPolicy::Serial) {
+			matvec_rows(b, A, x, 0, rows);
+		}
+		else {
+			parallel_for(0, rows, [&](size_t first, size_t last, unsigned) {
+				matvec_rows(b, A, x, first, last);
+			}, blas_threads(rows * A.cols(), nrThreads));
+		}
+	}
+
 }}}  // namespace sw::universal::blas
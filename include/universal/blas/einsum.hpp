@@ -0,0 +1,348 @@
+#pragma once
+// einsum.hpp: tensor contractions in Einstein summation notation, lowered to a packed and tiled matrix-matrix product
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <algorithm>
+#include <cctype>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include <universal/blas/exceptions.hpp>
+#include <universal/blas/execution.hpp>
+#include <universal/blas/tensor.hpp>
+
+namespace sw { namespace universal { namespace blas {
+
+// tiles of the packed matrix-matrix product: a GEMM_TILE_K x GEMM_TILE_N block of B is packed once and shared by
+// all threads, each thread packs GEMM_TILE_M x GEMM_TILE_K blocks of A, and a micro-kernel accumulates a
+// GEMM_MICRO_TILE x GEMM_MICRO_TILE block of C in registers from the two packed panels
+constexpr size_t GEMM_TILE_M     = 64;
+constexpr size_t GEMM_TILE_N     = 256;
+constexpr size_t GEMM_TILE_K     = 128;
+constexpr size_t GEMM_MICRO_TILE = 4;
+
+namespace detail {
+	// c[mr x nr] += a_panel * b_panel over kc, panels interleave GEMM_MICRO_TILE rows of A and columns of B per k
+	template<typename Scalar>
+	void gemm_micro_kernel(size_t kc, const Scalar* a, const Scalar* b, Scalar* c, std::ptrdiff_t rsC, std::ptrdiff_t csC, size_t mr, size_t nr) {
+		constexpr size_t MT = GEMM_MICRO_TILE;
+		Scalar acc[MT][MT];
+		for (size_t r = 0; r < MT; ++r) {
+			for (size_t s = 0; s < MT; ++s) acc[r][s] = (r < mr && s < nr ? c[static_cast<std::ptrdiff_t>(r) * rsC + static_cast<std::ptrdiff_t>(s) * csC] : Scalar(0));
+		}
+		for (size_t k = 0; k < kc; ++k, a += MT, b += MT) {
+			for (size_t r = 0; r < MT; ++r) {
+				const Scalar ar = a[r];
+				for (size_t s = 0; s < MT; ++s) acc[r][s] += ar * b[s];
+			}
+		}
+		for (size_t r = 0; r < mr; ++r) {
+			for (size_t s = 0; s < nr; ++s) c[static_cast<std::ptrdiff_t>(r) * rsC + static_cast<std::ptrdiff_t>(s) * csC] = acc[r][s];
+		}
+	}
+}
+
+// C[M x N] = A[M x K] * B[K x N] for operands with arbitrary row and column strides, such as transposed views.
+// Every element of C accumulates its K products left to right starting from zero, so the result is identical to
+// the triple loop for any tiling and any number of threads; the tiles of rows of C are distributed across threads.
+template<typename Scalar>
+void gemm_tiled(size_t M, size_t N, size_t K,
+	const Scalar* A, std::ptrdiff_t rsA, std::ptrdiff_t csA,
+	const Scalar* B, std::ptrdiff_t rsB, std::ptrdiff_t csB,
+	Scalar* C, std::ptrdiff_t rsC, std::ptrdiff_t csC, unsigned nrThreads = 0) {
+	constexpr size_t MT = GEMM_MICRO_TILE;
+	for (size_t i = 0; i < M; ++i) {
+		for (size_t j = 0; j < N; ++j) C[static_cast<std::ptrdiff_t>(i) * rsC + static_cast<std::ptrdiff_t>(j) * csC] = Scalar(0);
+	}
+	if (M == 0 || N == 0 || K == 0) return;
+	auto at = [](size_t i, std::ptrdiff_t stride) { return static_cast<std::ptrdiff_t>(i) * stride; };
+	std::vector<Scalar> packedB(GEMM_TILE_K * ((GEMM_TILE_N + MT - 1) / MT) * MT);
+	size_t nrRowTiles = (M + GEMM_TILE_M - 1) / GEMM_TILE_M;
+	for (size_t jc = 0; jc < N; jc += GEMM_TILE_N) {
+		size_t nc = std::min(GEMM_TILE_N, N - jc);
+		for (size_t pc = 0; pc < K; pc += GEMM_TILE_K) {
+			size_t kc = std::min(GEMM_TILE_K, K - pc);
+			// pack B[pc:pc+kc, jc:jc+nc] in panels of MT columns, padded with zeros
+			for (size_t jp = 0; jp < nc; jp += MT) {
+				Scalar* panel = packedB.data() + (jp / MT) * kc * MT;
+				for (size_t k = 0; k < kc; ++k) {
+					for (size_t s = 0; s < MT; ++s) panel[k * MT + s] = (jp + s < nc ? B[at(pc + k, rsB) + at(jc + jp + s, csB)] : Scalar(0));
+				}
+			}
+			unsigned threads = blas_threads(M * nc * kc / GEMM_TILE_K, nrThreads);
+			parallel_for(0, nrRowTiles, [&](size_t firstTile, size_t lastTile, unsigned) {
+				std::vector<Scalar> packedA(GEMM_TILE_M * kc);
+				for (size_t tile = firstTile; tile < lastTile; ++tile) {
+					size_t ic = tile * GEMM_TILE_M;
+					size_t mc = std::min(GEMM_TILE_M, M - ic);
+					// pack A[ic:ic+mc, pc:pc+kc] in panels of MT rows, padded with zeros
+					for (size_t ip = 0; ip < mc; ip += MT) {
+						Scalar* panel = packedA.data() + (ip / MT) * kc * MT;
+						for (size_t k = 0; k < kc; ++k) {
+							for (size_t r = 0; r < MT; ++r) panel[k * MT + r] = (ip + r < mc ? A[at(ic + ip + r, rsA) + at(pc + k, csA)] : Scalar(0));
+						}
+					}
+					for (size_t jp = 0; jp < nc; jp += MT) {
+						for (size_t ip = 0; ip < mc; ip += MT) {
+							detail::gemm_micro_kernel(kc, packedA.data() + (ip / MT) * kc * MT, packedB.data() + (jp / MT) * kc * MT,
+								C + at(ic + ip, rsC) + at(jc + jp, csC), rsC, csC, std::min(MT, mc - ip), std::min(MT, nc - jp));
+						}
+					}
+				}
+			}, threads);
+		}
+	}
+}
+
+/*
+ einsum evaluates a contraction of one or two tensors written in Einstein summation notation: each operand
+ names its dimensions with one letter each, letters that are not in the output are summed over, and an omitted
+ output ("ij,jk") consists of the letters that appear once, in alphabetical order.
+
+   einsum("ij,jk->ik", A, B)       matrix product          einsum("bij,bjk->bik", A, B)   batched matrix product
+   einsum("ijk,jkl->il", A, B)     double contraction      einsum("i,j->ij", x, y)        outer product
+   einsum("ii->", A)               trace                   einsum("ij->ji", A)            transposition
+
+ A contraction of two operands in which no operand repeats a letter is lowered to a batched matrix product:
+ the letters are grouped into batch letters (in both operands and the output), the free letters of each
+ operand, and the contracted letters, the operands are permuted to [batch, free, contracted] views, and each
+ group of dimensions is merged into a single strided matrix dimension. Operands whose groups are not mergeable
+ in place are copied to row-major order first; transposed and sliced views usually are not. Letters that
+ appear in one operand only are summed out of that operand first. All other contractions, such as traces and
+ diagonals, run as a direct strided loop over all letters.
+*/
+
+namespace detail {
+
+	struct einsum_expression {
+		std::vector<std::string> operands;
+		std::string output;
+	};
+
+	inline einsum_expression parse_einsum(const std::string& spec, size_t nrOperands) {
+		std::string s;
+		for (char c : spec) if (!std::isspace(static_cast<unsigned char>(c))) s += c;
+		einsum_expression e;
+		size_t arrow = s.find("->");
+		std::string inputs = s.substr(0, arrow);
+		size_t first = 0;
+		for (;;) {
+			size_t comma = inputs.find(',', first);
+			e.operands.push_back(inputs.substr(first, comma - first));
+			if (comma == std::string::npos) break;
+			first = comma + 1;
+		}
+		if (e.operands.size() != nrOperands) throw tensor_incompatible_shapes("einsum '" + spec + "' expects " + std::to_string(e.operands.size()) + " operands, received " + std::to_string(nrOperands));
+		for (const auto& op : e.operands) {
+			for (char c : op) if (!std::isalpha(static_cast<unsigned char>(c))) throw tensor_incompatible_shapes("einsum '" + spec + "' has an index that is not a letter");
+		}
+		if (arrow != std::string::npos) {
+			e.output = s.substr(arrow + 2);
+		}
+		else {
+			std::string all;
+			for (const auto& op : e.operands) all += op;
+			for (char c : all) if (std::count(all.begin(), all.end(), c) == 1) e.output += c;
+			std::sort(e.output.begin(), e.output.end());
+		}
+		for (char c : e.output) {
+			bool found = false;
+			for (const auto& op : e.operands) found = found || op.find(c) != std::string::npos;
+			if (!found || std::count(e.output.begin(), e.output.end(), c) != 1) throw tensor_incompatible_shapes("einsum '" + spec + "' has an output index '" + std::string(1, c) + "' that is repeated or not in an operand");
+		}
+		return e;
+	}
+
+	// record the extent of every letter of an operand and check that the extents agree
+	template<typename View>
+	void einsum_extents(const std::string& spec, const std::string& letters, const View& v, std::vector<size_t>& extents) {
+		if (letters.size() != v.rank()) throw tensor_incompatible_shapes("einsum operand '" + letters + "' of rank " + std::to_string(v.rank()) + " in '" + spec + "'");
+		for (size_t d = 0; d < letters.size(); ++d) {
+			size_t& e = extents[static_cast<unsigned char>(letters[d])];
+			if (e != 0 && e != v.extent(static_cast<unsigned>(d))) throw tensor_incompatible_shapes("einsum '" + spec + "' index '" + std::string(1, letters[d]) + "' has extents " + std::to_string(e) + " and " + std::to_string(v.extent(static_cast<unsigned>(d))));
+			e = v.extent(static_cast<unsigned>(d));
+		}
+	}
+
+	// strides of a view per letter of the loop nest: repeated letters of an operand add up, which walks the diagonal
+	template<typename View>
+	tensor_strides letter_strides(const std::string& loop, const std::string& letters, const View& v) {
+		tensor_strides strides(loop.size(), 0);
+		for (size_t d = 0; d < letters.size(); ++d) strides[loop.find(letters[d])] += v.stride(static_cast<unsigned>(d));
+		return strides;
+	}
+
+	// the loop nest over the output letters followed by the summed letters, row-major: every output element
+	// accumulates its terms in the lexicographic order of the summed letters
+	template<typename Scalar, typename... Views>
+	tensor<Scalar> einsum_direct(const einsum_expression& e, const std::vector<size_t>& extents, const Views&... views) {
+		std::string loop = e.output;
+		for (const auto& op : e.operands) for (char c : op) if (loop.find(c) == std::string::npos) loop += c;
+		tensor_shape outShape, loopShape;
+		for (char c : e.output) outShape.push_back(extents[static_cast<unsigned char>(c)]);
+		for (char c : loop) loopShape.push_back(extents[static_cast<unsigned char>(c)]);
+		tensor<Scalar> result(outShape);
+		tensor_view<Scalar> out = result.view();
+		tensor_strides outStrides = letter_strides(loop, e.output, out);
+		size_t k = 0;
+		std::vector<tensor_strides> strides{ letter_strides(loop, e.operands[k++], views)... };
+		Scalar* o = out.data();
+		if constexpr (sizeof...(Views) == 1) {
+			std::array<const std::ptrdiff_t*, 2> s{ outStrides.data(), strides[0].data() };
+			const Scalar* a = (views.data(), ...);
+			strided_for_each(loopShape, s, [&](const std::array<std::ptrdiff_t, 2>& offsets) { o[offsets[0]] += a[offsets[1]]; });
+		}
+		else {
+			std::array<const std::ptrdiff_t*, 3> s{ outStrides.data(), strides[0].data(), strides[1].data() };
+			const Scalar* p[] = { views.data()... };
+			const Scalar* a = p[0];
+			const Scalar* b = p[1];
+			strided_for_each(loopShape, s, [&](const std::array<std::ptrdiff_t, 3>& offsets) { o[offsets[0]] += a[offsets[1]] * b[offsets[2]]; });
+		}
+		return result;
+	}
+
+	// merge the dimensions [first, last) of a view into one dimension of the given extent and stride,
+	// which requires that each dimension steps over the extent of the next; dimensions of extent 1 are ignored
+	template<typename View>
+	bool merge_dimensions(const View& v, size_t first, size_t last, size_t& extent, std::ptrdiff_t& stride) {
+		extent = 1;
+		stride = 0;
+		bool any = false;
+		std::ptrdiff_t expected = 0;
+		for (size_t d = last; d > first; --d) {
+			size_t n = v.extent(static_cast<unsigned>(d - 1));
+			std::ptrdiff_t s = v.stride(static_cast<unsigned>(d - 1));
+			if (n == 1) continue;
+			if (!any) stride = s;
+			else if (s != expected) return false;
+			any = true;
+			extent *= n;
+			expected = s * static_cast<std::ptrdiff_t>(n);
+		}
+		return true;
+	}
+
+	// a batch of matrices [batch, rows, cols] laid over the dimension groups of a permuted view
+	template<typename Scalar>
+	struct matrix_batch {
+		Scalar* data{ nullptr };
+		size_t batch{ 1 }, rows{ 1 }, cols{ 1 };
+		std::ptrdiff_t batchStride{ 0 }, rowStride{ 0 }, colStride{ 0 };
+		bool lay(const tensor_view<Scalar>& v, size_t nrBatch, size_t nrRows) {
+			data = v.data();
+			return merge_dimensions(v, 0, nrBatch, batch, batchStride)
+				&& merge_dimensions(v, nrBatch, nrBatch + nrRows, rows, rowStride)
+				&& merge_dimensions(v, nrBatch + nrRows, v.rank(), cols, colStride);
+		}
+	};
+
+	inline std::vector<unsigned> axes_of(const std::string& letters, const std::string& order) {
+		std::vector<unsigned> axes;
+		for (char c : order) axes.push_back(static_cast<unsigned>(letters.find(c)));
+		return axes;
+	}
+
+	inline bool has_repeated_letter(const std::string& letters) {
+		for (char c : letters) if (std::count(letters.begin(), letters.end(), c) > 1) return true;
+		return false;
+	}
+
+	// the letters of an operand that are in the output or in the other operand
+	inline std::string kept_letters(const std::string& letters, const std::string& other, const std::string& output) {
+		std::string kept;
+		for (char c : letters) if (other.find(c) != std::string::npos || output.find(c) != std::string::npos) kept += c;
+		return kept;
+	}
+
+	template<typename Scalar>
+	tensor<Scalar> einsum_gemm(const einsum_expression& e, const std::vector<size_t>& extents, tensor_view<const Scalar> a, tensor_view<const Scalar> b) {
+		const std::string& out = e.output;
+		std::string la = e.operands[0], lb = e.operands[1];
+		// sum out the letters that only one operand carries
+		tensor<Scalar> reducedA, reducedB;
+		std::string ka = kept_letters(la, lb, out), kb = kept_letters(lb, la, out);
+		if (ka != la) {
+			reducedA = einsum_direct<Scalar>(einsum_expression{ { la }, ka }, extents, a);
+			a = reducedA.view();
+			la = ka;
+		}
+		if (kb != lb) {
+			reducedB = einsum_direct<Scalar>(einsum_expression{ { lb }, kb }, extents, b);
+			b = reducedB.view();
+			lb = kb;
+		}
+		// batch letters and free letters in output order, contracted letters in the order of operand a
+		std::string batch, freeA, freeB, contracted;
+		for (char c : out) {
+			bool inA = la.find(c) != std::string::npos, inB = lb.find(c) != std::string::npos;
+			if (inA && inB) batch += c;
+			else if (inA) freeA += c;
+			else freeB += c;
+		}
+		for (char c : la) if (lb.find(c) != std::string::npos && out.find(c) == std::string::npos) contracted += c;
+
+		tensor<Scalar> copyA, copyB, copyC;
+		matrix_batch<const Scalar> A, B;
+		tensor_view<const Scalar> pa = a.permute(axes_of(la, batch + freeA + contracted));
+		if (!A.lay(pa, batch.size(), freeA.size())) {
+			copyA = tensor<Scalar>(pa);
+			A.lay(copyA.view(), batch.size(), freeA.size());
+		}
+		tensor_view<const Scalar> pb = b.permute(axes_of(lb, batch + contracted + freeB));
+		if (!B.lay(pb, batch.size(), contracted.size())) {
+			copyB = tensor<Scalar>(pb);
+			B.lay(copyB.view(), batch.size(), contracted.size());
+		}
+		tensor_shape outShape;
+		for (char c : out) outShape.push_back(extents[static_cast<unsigned char>(c)]);
+		tensor<Scalar> result(outShape);
+		tensor_view<Scalar> pc = result.view().permute(axes_of(out, batch + freeA + freeB));
+		matrix_batch<Scalar> C;
+		bool direct = C.lay(pc, batch.size(), freeA.size());
+		if (!direct) {
+			tensor_shape shape = pc.shape();
+			copyC = tensor<Scalar>(shape);
+			C.lay(copyC.view(), batch.size(), freeA.size());
+		}
+		for (size_t i = 0; i < C.batch; ++i) {
+			gemm_tiled(C.rows, C.cols, A.cols,
+				A.data + static_cast<std::ptrdiff_t>(i) * A.batchStride, A.rowStride, A.colStride,
+				B.data + static_cast<std::ptrdiff_t>(i) * B.batchStride, B.rowStride, B.colStride,
+				C.data + static_cast<std::ptrdiff_t>(i) * C.batchStride, C.rowStride, C.colStride);
+		}
+		if (!direct) elementwise_into(pc, [](const Scalar& x) { return x; }, copyC);
+		return result;
+	}
+
+} // namespace detail
+
+// contraction of a single tensor: transposition, trace, diagonal, and sums over dimensions
+template<typename Operand>
+auto einsum(const std::string& spec, const Operand& a) {
+	using Scalar = typename decltype(as_view(a))::value_type;
+	detail::einsum_expression e = detail::parse_einsum(spec, 1);
+	std::vector<size_t> extents(256, 0);
+	tensor_view<const Scalar> va = as_view(a);
+	detail::einsum_extents(spec, e.operands[0], va, extents);
+	return detail::einsum_direct<Scalar>(e, extents, va);
+}
+
+// contraction of two tensors of the same scalar type
+template<typename LeftOperand, typename RightOperand>
+auto einsum(const std::string& spec, const LeftOperand& a, const RightOperand& b) {
+	using Scalar = typename decltype(as_view(a))::value_type;
+	static_assert(std::is_same_v<Scalar, typename decltype(as_view(b))::value_type>, "einsum operands must have the same scalar type");
+	detail::einsum_expression e = detail::parse_einsum(spec, 2);
+	std::vector<size_t> extents(256, 0);
+	tensor_view<const Scalar> va = as_view(a), vb = as_view(b);
+	detail::einsum_extents(spec, e.operands[0], va, extents);
+	detail::einsum_extents(spec, e.operands[1], vb, extents);
+	if (detail::has_repeated_letter(e.operands[0]) || detail::has_repeated_letter(e.operands[1])) return detail::einsum_direct<Scalar>(e, extents, va, vb);
+	return detail::einsum_gemm<Scalar>(e, extents, va, vb);
+}
+
+}}} // namespace sw::universal::blas
@@ -42,4 +42,13 @@ struct matmul_incompatible_matrices
 	};
 };
 
+// base class for tensor shape exceptions
+struct tensor_incompatible_shapes
+	: public std::runtime_error
+{
+	tensor_incompatible_shapes(const std::string& error)
+		: std::runtime_error(std::string("BLAS tensor operator: ") + error) {
+	};
+};
+
 }}} // namespace sw::universal::blas
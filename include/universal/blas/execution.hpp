@@ -0,0 +1,102 @@
+#pragma once
+// execution.hpp: execution policies for the BLAS kernels
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <cstddef>
+#include <vector>
+#include <universal/utility/parallel.hpp>
+
+namespace sw { namespace universal { namespace blas {
+
+// execution policies of the BLAS kernels
+//   Serial                : one thread, reductions accumulate left to right
+//   Parallel              : one contiguous chunk of the iteration space per thread, partial reductions
+//                           are combined in chunk order: the result depends on the number of threads
+//   ParallelDeterministic : reductions are organized in fixed size blocks, independent of the number of
+//                           threads, and combined in block order: the result is the same on 1 to all cores
+// Kernels without a reduction, such as axpy, scale, amax, and matvec, produce identical results under all policies.
+enum class ExecutionPolicy { Serial, Parallel, ParallelDeterministic };
+
+// iteration spaces below this many elements per thread are not worth the cost of spawning threads
+constexpr size_t BLAS_PARALLEL_GRAIN = 8192;
+// number of elements in a reduction block of the ParallelDeterministic policy
+constexpr size_t BLAS_REDUCTION_BLOCK = 2048;
+
+// number of threads to use for an iteration space of N elements: 0 requests all hardware threads
+inline unsigned blas_threads(size_t N, unsigned nrThreads = 0) {
+	if (nrThreads == 0) nrThreads = hardware_threads();
+	size_t maxThreads = (N + BLAS_PARALLEL_GRAIN - 1) / BLAS_PARALLEL_GRAIN;
+	if (maxThreads < nrThreads) nrThreads = static_cast<unsigned>(maxThreads);
+	return (nrThreads == 0 ? 1u : nrThreads);
+}
+
+// sum term(k) for k in [first, last) in four interleaved partial sums,
+// which breaks the dependency chain of a single accumulator
+template<typename Scalar, typename Term>
+Scalar interleaved_sum(size_t first, size_t last, Term& term) {
+	Scalar s0(0), s1(0), s2(0), s3(0);
+	size_t k = first;
+	for (; k + 4 <= last; k += 4) {
+		s0 += term(k);
+		s1 += term(k + 1);
+		s2 += term(k + 2);
+		s3 += term(k + 3);
+	}
+	for (; k < last; ++k) s0 += term(k);
+	s0 += s1;
+	s2 += s3;
+	s0 += s2;
+	return s0;
+}
+
+// sum of term(k) for k in [0, N) under an execution policy
+template<typename Scalar, typename Term>
+Scalar reduce_terms(ExecutionPolicy policy, size_t N, Term&& term, unsigned nrThreads = 0) {
+	Scalar sum(0);
+	switch (policy) {
+	case ExecutionPolicy::Serial:
+		for (size_t k = 0; k < N; ++k) sum += term(k);
+		break;
+	case ExecutionPolicy::Parallel:
+		{
+			unsigned threads = blas_threads(N, nrThreads);
+			std::vector<Scalar> partials(threads, Scalar(0));
+			parallel_for(0, N, [&](size_t first, size_t last, unsigned t) {
+				partials[t] = interleaved_sum<Scalar>(first, last, term);
+			}, threads);
+			for (const Scalar& partial : partials) sum += partial;
+		}
+		break;
+	case ExecutionPolicy::ParallelDeterministic:
+		{
+			size_t nrBlocks = (N + BLAS_REDUCTION_BLOCK - 1) / BLAS_REDUCTION_BLOCK;
+			std::vector<Scalar> partials(nrBlocks, Scalar(0));
+			parallel_for(0, nrBlocks, [&](size_t firstBlock, size_t lastBlock, unsigned) {
+				for (size_t b = firstBlock; b < lastBlock; ++b) {
+					size_t first = b * BLAS_REDUCTION_BLOCK;
+					size_t last = (first + BLAS_REDUCTION_BLOCK < N ? first + BLAS_REDUCTION_BLOCK : N);
+					partials[b] = interleaved_sum<Scalar>(first, last, term);
+				}
+			}, blas_threads(N, nrThreads));
+			for (const Scalar& partial : partials) sum += partial;
+		}
+		break;
+	}
+	return sum;
+}
+
+// apply f(first, last) to the iteration space [0, N) under an execution policy
+template<typename ChunkFunction>
+void for_each_chunk(ExecutionPolicy policy, size_t N, ChunkFunction&& f, unsigned nrThreads = 0) {
+	if (policy == ExecutionPolicy::Serial) {
+		f(size_t(0), N);
+	}
+	else {
+		parallel_for(0, N, [&](size_t first, size_t last, unsigned) { f(first, last); }, blas_threads(N, nrThreads));
+	}
+}
+
+}}} // namespace sw::universal::blas
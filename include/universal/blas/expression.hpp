@@ -0,0 +1,171 @@
+#pragma once
+// expression.hpp: expression templates for the lazy evaluation of element-wise vector arithmetic
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <cstddef>
+#include <cmath>
+#include <memory>
+#include <type_traits>
+
+namespace sw { namespace universal { namespace blas {
+
+template<typename Scalar, typename Allocator = std::allocator<Scalar>> class vector;
+
+// vector_expression<Expression> is the CRTP base of all vector valued expressions, including the vector itself.
+// The arithmetic operators on vector expressions do not compute anything: they return a lightweight node
+// that is evaluated element by element when it is assigned to a vector. An update like x = x + alpha * p
+// thus runs as a single loop without temporary vectors, which for the software number types saves an
+// allocation and N constructions per operator. eval() materializes an expression explicitly.
+// Nodes refer to the vectors they are built from, so an expression must not outlive its operands:
+// 'auto y = a + b;' captures a and b, whereas 'vector<Scalar> y = a + b;' evaluates the expression.
+template<typename Expression>
+class vector_expression {
+public:
+	const Expression& derived() const { return static_cast<const Expression&>(*this); }
+	auto eval() const { return vector<typename Expression::value_type>(derived()); }
+
+	// read-only iteration over the elements of the expression
+	class const_iterator {
+	public:
+		const_iterator(const Expression& e, size_t i) : e{ &e }, i{ i } {}
+		auto operator*() const { return (*e)[i]; }
+		const_iterator& operator++() { ++i; return *this; }
+		bool operator==(const const_iterator& rhs) const { return i == rhs.i; }
+		bool operator!=(const const_iterator& rhs) const { return i != rhs.i; }
+	private:
+		const Expression* e;
+		size_t i;
+	};
+	const_iterator begin() const { return const_iterator(derived(), 0); }
+	const_iterator end() const { return const_iterator(derived(), derived().size()); }
+
+	// reductions of the vector interface, evaluated without materializing the expression
+	auto sum() const {
+		typename Expression::value_type sum(0);
+		for (size_t i = 0; i < derived().size(); ++i) sum += derived()[i];
+		return sum;
+	}
+	auto norm() const {
+		using std::sqrt;
+		typename Expression::value_type twoNorm(0);
+		for (size_t i = 0; i < derived().size(); ++i) {
+			typename Expression::value_type v = derived()[i];
+			twoNorm += v * v;
+		}
+		return sqrt(twoNorm);
+	}
+	auto infnorm() const {
+		typename Expression::value_type infNorm(0);
+		for (size_t i = 0; i < derived().size(); ++i) {
+			typename Expression::value_type v = derived()[i];
+			infNorm = (abs(v) > infNorm) ? abs(v) : infNorm;
+		}
+		return infNorm;
+	}
+};
+
+// vectors are captured by reference, expression nodes are temporaries and are captured by value
+template<typename Expression> struct expression_operand { using type = const Expression; };
+template<typename Scalar, typename Allocator> struct expression_operand< vector<Scalar, Allocator> > { using type = const vector<Scalar, Allocator>&; };
+template<typename Expression> using expression_operand_t = typename expression_operand<Expression>::type;
+
+template<typename Lhs, typename Rhs>
+constexpr bool is_same_value_type_v = std::is_same_v<typename Lhs::value_type, typename Rhs::value_type>;
+
+// element-wise operators
+struct expression_add { template<typename Scalar> static Scalar apply(const Scalar& a, const Scalar& b) { return a + b; } };
+struct expression_sub { template<typename Scalar> static Scalar apply(const Scalar& a, const Scalar& b) { return a - b; } };
+struct expression_mul { template<typename Scalar> static Scalar apply(const Scalar& a, const Scalar& b) { return a * b; } };
+struct expression_div { template<typename Scalar> static Scalar apply(const Scalar& a, const Scalar& b) { return a / b; } };
+
+// element-wise operation on two vector expressions
+template<typename Operator, typename Lhs, typename Rhs>
+class vector_binary : public vector_expression< vector_binary<Operator, Lhs, Rhs> > {
+public:
+	using value_type = typename Lhs::value_type;
+	vector_binary(const Lhs& lhs, const Rhs& rhs) : lhs{ lhs }, rhs{ rhs } {}
+	size_t size() const { return lhs.size(); }
+	value_type operator[](size_t i) const { return Operator::apply(value_type(lhs[i]), value_type(rhs[i])); }
+	value_type operator()(size_t i) const { return (*this)[i]; }
+private:
+	expression_operand_t<Lhs> lhs;
+	expression_operand_t<Rhs> rhs;
+};
+
+// element-wise operation of a vector expression with a scalar
+template<typename Operator, typename Expression>
+class vector_scalar : public vector_expression< vector_scalar<Operator, Expression> > {
+public:
+	using value_type = typename Expression::value_type;
+	vector_scalar(const Expression& v, const value_type& alpha) : v{ v }, alpha{ alpha } {}
+	size_t size() const { return v.size(); }
+	value_type operator[](size_t i) const { return Operator::apply(value_type(v[i]), alpha); }
+	value_type operator()(size_t i) const { return (*this)[i]; }
+private:
+	expression_operand_t<Expression> v;
+	value_type alpha;
+};
+
+// negation of a vector expression
+template<typename Expression>
+class vector_negate : public vector_expression< vector_negate<Expression> > {
+public:
+	using value_type = typename Expression::value_type;
+	vector_negate(const Expression& v) : v{ v } {}
+	size_t size() const { return v.size(); }
+	value_type operator[](size_t i) const { return -value_type(v[i]); }
+	value_type operator()(size_t i) const { return (*this)[i]; }
+private:
+	expression_operand_t<Expression> v;
+};
+
+template<typename Expression>
+size_t size(const vector_expression<Expression>& e) { return e.derived().size(); }
+
+template<typename Expression>
+auto eval(const vector_expression<Expression>& e) { return e.eval(); }
+
+template<typename Lhs, typename Rhs, typename = std::enable_if_t< is_same_value_type_v<Lhs, Rhs> > >
+vector_binary<expression_add, Lhs, Rhs> operator+(const vector_expression<Lhs>& lhs, const vector_expression<Rhs>& rhs) {
+	return vector_binary<expression_add, Lhs, Rhs>(lhs.derived(), rhs.derived());
+}
+
+template<typename Lhs, typename Rhs, typename = std::enable_if_t< is_same_value_type_v<Lhs, Rhs> > >
+vector_binary<expression_sub, Lhs, Rhs> operator-(const vector_expression<Lhs>& lhs, const vector_expression<Rhs>& rhs) {
+	return vector_binary<expression_sub, Lhs, Rhs>(lhs.derived(), rhs.derived());
+}
+
+template<typename Expression>
+vector_negate<Expression> operator-(const vector_expression<Expression>& v) {
+	return vector_negate<Expression>(v.derived());
+}
+
+// scale a vector expression through operator* overload
+template<typename Scalar, typename Expression, typename = std::enable_if_t< std::is_same_v<Scalar, typename Expression::value_type> > >
+vector_scalar<expression_mul, Expression> operator*(const Scalar& alpha, const vector_expression<Expression>& x) {
+	return vector_scalar<expression_mul, Expression>(x.derived(), alpha);
+}
+
+// scale a vector expression through operator* overload
+template<typename Scalar, typename Expression, typename = std::enable_if_t< std::is_same_v<Scalar, typename Expression::value_type> > >
+vector_scalar<expression_mul, Expression> operator*(const vector_expression<Expression>& x, const Scalar& alpha) {
+	return vector_scalar<expression_mul, Expression>(x.derived(), alpha);
+}
+
+// scale a vector expression through operator/ overload
+template<typename Scalar, typename Expression, typename = std::enable_if_t< std::is_same_v<Scalar, typename Expression::value_type> > >
+vector_scalar<expression_div, Expression> operator/(const vector_expression<Expression>& v, const Scalar& normalizer) {
+	return vector_scalar<expression_div, Expression>(v.derived(), normalizer);
+}
+
+// scale a vector expression through operator/ overload with an integer normalizer
+template<typename Expression, typename = std::enable_if_t< !std::is_same_v<int, typename Expression::value_type> > >
+vector_scalar<expression_div, Expression> operator/(const vector_expression<Expression>& v, const int normalizer) {
+	using Scalar = typename Expression::value_type;
+	return vector_scalar<expression_div, Expression>(v.derived(), Scalar(normalizer));
+}
+
+}}} // namespace sw::universal::blas
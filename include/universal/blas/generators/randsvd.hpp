@@ -19,7 +19,7 @@ std::tuple<matrix<Scalar>,matrix<Scalar>, matrix<Scalar>> randsvd(const matrix<S
     Q.transpose();
     B = Q * A;
     matrix<Scalar> S(n, k), V(n, n), D(n, n);
-    std::tie(S, V, D) = svd(B,k);
+    std::tie(S, V, D) = svd(B);
     return std::make_tuple(S, V, D);
 }
 
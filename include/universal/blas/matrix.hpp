@@ -10,6 +10,7 @@
 #include <initializer_list>
 #include <map>
 #include <universal/blas/exceptions.hpp>
+#include <universal/blas/execution.hpp>
 
 #if defined(__clang__)
 /* Clang/LLVM. ---------------------------------------------- */
@@ -53,40 +54,42 @@
 
 namespace sw { namespace universal { namespace blas { 
 
-template<typename Scalar> class matrix;
+template<typename Scalar, typename Allocator = std::allocator<Scalar>> class matrix;
 template<typename Scalar>
 class ConstRowProxy {
 public:
-	typedef typename std::vector<Scalar>::size_type              size_type;
-	ConstRowProxy(typename std::vector<Scalar>::const_iterator iter) : _iter(iter) {}
-	Scalar operator[](size_type col) const { return *(_iter + static_cast<int64_t>(col)); }
+	typedef size_t                                               size_type;
+	ConstRowProxy(const Scalar* row) : _row(row) {}
+	Scalar operator[](size_type col) const { return _row[col]; }
 
 private:
-	typename std::vector<Scalar>::const_iterator _iter;
+	const Scalar* _row;
 };
 template<typename Scalar>
 class RowProxy {
 public:
-	typedef typename std::vector<Scalar>::size_type              size_type;
-	RowProxy(typename std::vector<Scalar>::iterator iter) : _iter(iter) {}
-	Scalar& operator[](size_type col) { return *(_iter + static_cast<int64_t>(col)); }
+	typedef size_t                                               size_type;
+	RowProxy(Scalar* row) : _row(row) {}
+	Scalar& operator[](size_type col) { return _row[col]; }
 
 private:
-	typename std::vector<Scalar>::iterator _iter;
+	Scalar* _row;
 };
 
-template<typename Scalar>
+// a dense row-major matrix, the Allocator provides the storage of the elements
+template<typename Scalar, typename Allocator>
 class matrix {
 public:
 	typedef Scalar									             value_type;
 	typedef const value_type&						             const_reference;
 	typedef value_type&								             reference;
 	typedef const value_type*						             const_pointer_type;
-	typedef typename std::vector<Scalar>::size_type              size_type;
-	typedef typename std::vector<Scalar>::iterator               iterator;
-	typedef typename std::vector<Scalar>::const_iterator         const_iterator;
-	typedef typename std::vector<Scalar>::reverse_iterator       reverse_iterator;
-	typedef typename std::vector<Scalar>::const_reverse_iterator const_reverse_iterator;
+	typedef typename std::vector<Scalar, Allocator>::size_type              size_type;
+	typedef typename std::vector<Scalar, Allocator>::iterator               iterator;
+	typedef typename std::vector<Scalar, Allocator>::const_iterator         const_iterator;
+	typedef typename std::vector<Scalar, Allocator>::reverse_iterator       reverse_iterator;
+	typedef typename std::vector<Scalar, Allocator>::const_reverse_iterator const_reverse_iterator;
+	typedef Allocator                                            allocator_type;
 	static constexpr unsigned AggregationType = UNIVERSAL_AGGREGATE_MATRIX;
 
 	matrix() : _m{ 0 }, _n{ 0 }, data(0) {}
@@ -112,8 +115,8 @@ public:
 	matrix(const matrix& A) : _m{ A._m }, _n{ A._n }, data(A.data) {}
 
 	// Converting Constructor (SourceType A --> Scalar B)
-	template<typename SourceType>
-	matrix(const matrix<SourceType>& A) : _m{ A.rows() }, _n{A.cols() } {
+	template<typename SourceType, typename SourceAllocator>
+	matrix(const matrix<SourceType, SourceAllocator>& A) : _m{ A.rows() }, _n{A.cols() } {
 		data.resize(_m*_n);
 		for (size_type i = 0; i < _m; ++i) {
 			for (size_type j = 0; j < _n; ++j) {
@@ -140,14 +143,10 @@ public:
 	Scalar operator()(size_type i, size_type j) const { return data[i*_n + j]; }
 	Scalar& operator()(size_type i, size_type j) { return data[i*_n + j]; }
 	RowProxy<Scalar> operator[](size_type i) {
-		typename std::vector<Scalar>::iterator it = data.begin() + static_cast<int64_t>(i * _n);
-		RowProxy<Scalar> proxy(it);
-		return proxy;
+		return RowProxy<Scalar>(data.data() + i * _n);
 	}
 	ConstRowProxy<Scalar> operator[](size_type i) const {
-		typename std::vector<Scalar>::const_iterator it = data.begin() + static_cast<int64_t>(i * _n);
-		ConstRowProxy<Scalar> proxy(it);
-		return proxy;
+		return ConstRowProxy<Scalar>(data.data() + i * _n);
 	}
 
 	// matrix element-wise sum
@@ -266,21 +265,21 @@ public:
 
 private:
 	size_type _m, _n; // m rows and n columns
-	std::vector<Scalar> data;
+	std::vector<Scalar, Allocator> data;
 
 };
 
-template<typename Scalar>
-inline typename matrix<Scalar>::size_type num_rows(const matrix<Scalar>& A) { return A.rows(); }
-template<typename Scalar>
-inline typename matrix<Scalar>::size_type num_cols(const matrix<Scalar>& A) { return A.cols(); }
-template<typename Scalar>
-inline std::pair<typename matrix<Scalar>::size_type, typename matrix<Scalar>::size_type> size(const matrix<Scalar>& A) { return std::make_pair(A.rows(), A.cols()); }
+template<typename Scalar, typename Allocator>
+inline typename matrix<Scalar, Allocator>::size_type num_rows(const matrix<Scalar, Allocator>& A) { return A.rows(); }
+template<typename Scalar, typename Allocator>
+inline typename matrix<Scalar, Allocator>::size_type num_cols(const matrix<Scalar, Allocator>& A) { return A.cols(); }
+template<typename Scalar, typename Allocator>
+inline std::pair<typename matrix<Scalar, Allocator>::size_type, typename matrix<Scalar, Allocator>::size_type> size(const matrix<Scalar, Allocator>& A) { return std::make_pair(A.rows(), A.cols()); }
 
 // ostream operator: no need to declare as friend as it only uses public interfaces
-template<typename Scalar>
-std::ostream& operator<<(std::ostream& ostr, const matrix<Scalar>& A) {
-	using size_type = typename matrix<Scalar>::size_type;
+template<typename Scalar, typename Allocator>
+std::ostream& operator<<(std::ostream& ostr, const matrix<Scalar, Allocator>& A) {
+	using size_type = typename matrix<Scalar, Allocator>::size_type;
 	auto width = ostr.width();
 	size_type m = A.rows();
 	size_type n = A.cols();
@@ -351,16 +350,48 @@ matrix<Scalar> operator/(const matrix<Scalar>& A, const Scalar& b) {
 }
 
  
-// matrix-vector multiply
+// row-blocked matrix-vector product b = A * x for the rows [firstRow, lastRow)
+// Blocks of four rows share each load of x[j], and each row still accumulates left to right,
+// so the result is identical to the row-by-row product and independent of how the rows are distributed.
+template<typename Matrix, typename Vector>
+void matvec_rows(Vector& b, const Matrix& A, const Vector& x, size_t firstRow, size_t lastRow) {
+	using Scalar = typename Vector::value_type;
+	size_t cols = A.cols();
+	size_t i = firstRow;
+	for (; i + 4 <= lastRow; i += 4) {
+		Scalar b0(0), b1(0), b2(0), b3(0);
+		for (size_t j = 0; j < cols; ++j) {
+			Scalar xj = x[j];
+			b0 += A(i, j) * xj;
+			b1 += A(i + 1, j) * xj;
+			b2 += A(i + 2, j) * xj;
+			b3 += A(i + 3, j) * xj;
+		}
+		b[i] = b0; b[i + 1] = b1; b[i + 2] = b2; b[i + 3] = b3;
+	}
+	for (; i < lastRow; ++i) {
+		Scalar bi(0);
+		for (size_t j = 0; j < cols; ++j) {
+			bi += A(i, j) * x[j];
+		}
+		b[i] = bi;
+	}
+}
+
+// matrix-vector multiply: products with enough elements for more than one thread distribute blocks of rows
+// across the hardware threads, smaller products run on the calling thread without querying the hardware
 template<typename Scalar>
 vector<Scalar> operator*(const matrix<Scalar>& A, const vector<Scalar>& x) {
-	using size_type = typename matrix<Scalar>::size_type;
 	vector<Scalar> b(A.rows());
-	for (size_type i = 0; i < A.rows(); ++i) {
-		b[i] = Scalar(0);
-		for (size_type j = 0; j < A.cols(); ++j) {
-			b[i] += A(i, j) * x[j];
-		}
+	size_t N = A.rows() * A.cols();
+	unsigned threads = (N < 2 * BLAS_PARALLEL_GRAIN ? 1u : blas_threads(N));
+	if (threads > 1) {
+		parallel_for(0, A.rows(), [&](size_t first, size_t last, unsigned) {
+			matvec_rows(b, A, x, first, last);
+		}, threads);
+	}
+	else {
+		matvec_rows(b, A, x, 0, A.rows());
 	}
 	return b;
 }
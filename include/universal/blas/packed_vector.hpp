@@ -0,0 +1,299 @@
+#pragma once
+// packed_vector.hpp: vector of a small number system that stores the encodings back to back at nbits bits per element
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <algorithm>
+#include <concepts>
+#include <cstdint>
+#include <initializer_list>
+#include <iostream>
+#include <iomanip>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+#include <universal/blas/blas_l1.hpp>
+#include <universal/blas/execution.hpp>
+#include <universal/number/shared/encoding_table.hpp>
+#include <universal/utility/bit_packing.hpp>
+
+namespace sw { namespace universal { namespace blas {
+
+/*
+ * A value of a small number system occupies at least a byte, the block of its storage: a blas::vector of
+ * cfloat<4,2> uses twice the memory of its encodings, and a vector of posit<6,1> a third more. A packed_vector
+ * stores the encodings back to back, so a kernel over a vector of a narrow format reads only the bits of the
+ * format. Elements are accessed through proxy references, and the kernels unpack a tile of encodings at a time
+ * into doubles through the value table of the format: dot accumulates the products of the values in double and
+ * rounds the sum to the format once, and axpy evaluates a * x + y in double and rounds it to the format once.
+ * The accumulation rounds in double, which is not exact for the products of 16-bit posits or of cfloats with a
+ * wide dynamic range, so dot is not the fused dot product of the format.
+ */
+
+// a number system whose encodings can be stored in a packed_vector
+template<typename Scalar>
+concept PackableScalar = requires(Scalar s) {
+	{ Scalar::nbits } -> std::convertible_to<unsigned>;
+	s.setbits(uint64_t(0));
+} && (Scalar::nbits <= 16);
+
+// raw encoding of a value of a small number system
+template<typename Scalar>
+uint32_t packed_encoding(const Scalar& v) noexcept {
+	constexpr uint32_t mask = bit_packing<Scalar::nbits>::mask;
+	if constexpr (requires { { v.encoding() } -> std::convertible_to<uint64_t>; }) {
+		return uint32_t(v.encoding()) & mask;
+	}
+	else if constexpr (requires { { v.bits() } -> std::convertible_to<uint64_t>; }) {
+		return uint32_t(v.bits()) & mask;
+	}
+	else {
+		uint64_t raw{ 0 };
+		for (unsigned b = 0; b < Scalar::nrBlocks; ++b) raw |= uint64_t(v.block(b)) << (b * Scalar::bitsInBlock);
+		return uint32_t(raw) & mask;
+	}
+}
+
+// values decoded per step of the packed kernels, a multiple of the encodings in a group of every packing
+constexpr size_t PACKED_TILE = 256;
+
+template<PackableScalar Scalar>
+class packed_vector {
+public:
+	static constexpr unsigned nbits = Scalar::nbits;
+	using packing         = bit_packing<nbits>;
+	using value_type      = Scalar;
+	using size_type       = size_t;
+	using difference_type = std::ptrdiff_t;
+
+	// proxy of an element: reads decode the encoding, writes encode the value
+	class reference {
+	public:
+		reference(packed_vector& v, size_t i) noexcept : _v{ &v }, _i{ i } {}
+		operator Scalar() const noexcept { return _v->get(_i); }
+		explicit operator double() const noexcept { return double(_v->get(_i)); }
+		reference& operator=(const Scalar& rhs) noexcept { _v->set(_i, rhs); return *this; }
+		reference& operator=(const reference& rhs) noexcept { return *this = Scalar(rhs); }
+		reference& operator+=(const Scalar& rhs) { return *this = Scalar(*this) + rhs; }
+		reference& operator-=(const Scalar& rhs) { return *this = Scalar(*this) - rhs; }
+		reference& operator*=(const Scalar& rhs) { return *this = Scalar(*this) * rhs; }
+		reference& operator/=(const Scalar& rhs) { return *this = Scalar(*this) / rhs; }
+		friend bool operator==(const reference& lhs, const Scalar& rhs) { return Scalar(lhs) == rhs; }
+		friend std::ostream& operator<<(std::ostream& ostr, const reference& r) { return ostr << Scalar(r); }
+	private:
+		packed_vector* _v;
+		size_t         _i;
+	};
+
+	template<bool isConst>
+	class basic_iterator {
+	public:
+		using container         = std::conditional_t<isConst, const packed_vector, packed_vector>;
+		using iterator_category = std::input_iterator_tag;
+		using value_type        = Scalar;
+		using difference_type   = std::ptrdiff_t;
+		using reference         = std::conditional_t<isConst, Scalar, typename packed_vector::reference>;
+
+		basic_iterator(container& v, size_t i) noexcept : _v{ &v }, _i{ i } {}
+		reference       operator*() const noexcept { return (*_v)[_i]; }
+		basic_iterator& operator++() noexcept { ++_i; return *this; }
+		basic_iterator  operator++(int) noexcept { basic_iterator tmp(*this); ++_i; return tmp; }
+		bool operator==(const basic_iterator& rhs) const noexcept { return _i == rhs._i; }
+		bool operator!=(const basic_iterator& rhs) const noexcept { return _i != rhs._i; }
+	private:
+		container* _v;
+		size_t     _i;
+	};
+	using iterator       = basic_iterator<false>;
+	using const_iterator = basic_iterator<true>;
+
+	packed_vector() : _size{ 0 } {}
+	// n elements of the zero encoding
+	explicit packed_vector(size_t n) : _size{ n }, _data(packing::bytes(n), uint8_t(0)) {}
+	packed_vector(size_t n, const Scalar& v) : packed_vector(n) { for (size_t i = 0; i < n; ++i) set(i, v); }
+	packed_vector(std::initializer_list<Scalar> values) : packed_vector(values.size()) {
+		size_t i{ 0 };
+		for (const Scalar& v : values) set(i++, v);
+	}
+	// the elements of a vector of Scalar, or of a vector of values that round to Scalar
+	template<typename Vector>
+		requires requires(const Vector& v) { v.size(); v[0]; }
+	explicit packed_vector(const Vector& v) : packed_vector(size_t(v.size())) {
+		for (size_t i = 0; i < _size; ++i) set(i, Scalar(v[i]));
+	}
+
+	size_t size() const noexcept { return _size; }
+	// bytes of the packed encodings
+	size_t bytes() const noexcept { return _data.size(); }
+	const uint8_t* data() const noexcept { return _data.data(); }
+	uint8_t*       data() noexcept { return _data.data(); }
+	void resize(size_t n) {
+		_data.resize(packing::bytes(n), uint8_t(0));
+		// clear the bits past the last element, so that the zero encoding is read when the vector grows again
+		if (n < _size && n * nbits % 8 != 0) _data.back() &= uint8_t((1u << (n * nbits % 8)) - 1);
+		_size = n;
+	}
+
+	Scalar    operator[](size_t i) const noexcept { return get(i); }
+	reference operator[](size_t i) noexcept { return reference(*this, i); }
+
+	Scalar get(size_t i) const noexcept {
+		Scalar v;
+		v.setbits(packing::get(_data.data(), i));
+		return v;
+	}
+	void set(size_t i, const Scalar& v) noexcept { packing::set(_data.data(), i, packed_encoding(v)); }
+
+	uint32_t encoding(size_t i) const noexcept { return packing::get(_data.data(), i); }
+	void     setencoding(size_t i, uint32_t code) noexcept { packing::set(_data.data(), i, code); }
+
+	// values of the elements [first, first + n)
+	template<typename Real>
+		requires std::is_floating_point_v<Real>
+	void unpack(size_t first, size_t n, Real* values) const noexcept {
+		const encoding_table<nbits>& table = value_table();
+		packing::unpack(_data.data(), first, n, [&](size_t k, uint32_t code) { values[k] = Real(table.value(code)); });
+	}
+	// encodings of the elements [first, first + n)
+	void unpack(size_t first, size_t n, uint32_t* codes) const noexcept {
+		packing::unpack(_data.data(), first, n, [&](size_t k, uint32_t code) { codes[k] = code; });
+	}
+	// round values[0, n) to the elements [first, first + n)
+	template<typename Real>
+		requires std::is_floating_point_v<Real>
+	void pack(size_t first, size_t n, const Real* values) noexcept {
+		uint32_t codes[PACKED_TILE];
+		for (size_t offset = 0; offset < n; offset += PACKED_TILE) {
+			size_t m = std::min(PACKED_TILE, n - offset);
+			for (size_t k = 0; k < m; ++k) codes[k] = packed_encoding(Scalar(values[offset + k]));
+			packing::pack(_data.data(), first + offset, m, codes);
+		}
+	}
+	// store the encodings codes[0, n) as the elements [first, first + n)
+	void pack(size_t first, size_t n, const uint32_t* codes) noexcept { packing::pack(_data.data(), first, n, codes); }
+
+	iterator       begin() noexcept { return iterator(*this, 0); }
+	iterator       end() noexcept { return iterator(*this, _size); }
+	const_iterator begin() const noexcept { return const_iterator(*this, 0); }
+	const_iterator end() const noexcept { return const_iterator(*this, _size); }
+
+	// values of all encodings of the format
+	static const encoding_table<nbits>& value_table() {
+		static const encoding_table<nbits> table([](uint64_t raw) { Scalar v; v.setbits(raw); return double(v); });
+		return table;
+	}
+
+private:
+	size_t               _size;
+	std::vector<uint8_t> _data;
+};
+
+template<typename Scalar>
+size_t size(const packed_vector<Scalar>& v) { return v.size(); }
+
+template<typename Scalar>
+std::ostream& operator<<(std::ostream& ostr, const packed_vector<Scalar>& v) {
+	auto width = ostr.width();
+	ostr << "[ ";
+	for (size_t j = 0; j < size(v); ++j) ostr << std::setw(width) << v[j] << " ";
+	ostr << " ]";
+	return ostr;
+}
+
+namespace detail {
+	// sum of the products of the values of the elements [first, last), unpacked a tile at a time
+	template<typename Scalar>
+	double packed_dot(const packed_vector<Scalar>& x, const packed_vector<Scalar>& y, size_t first, size_t last) {
+		double a[PACKED_TILE], b[PACKED_TILE];
+		double s0{ 0 }, s1{ 0 }, s2{ 0 }, s3{ 0 };
+		for (size_t offset = first; offset < last; offset += PACKED_TILE) {
+			size_t n = std::min(PACKED_TILE, last - offset);
+			x.unpack(offset, n, a);
+			y.unpack(offset, n, b);
+			size_t k = 0;
+			for (; k + 4 <= n; k += 4) {
+				s0 += a[k] * b[k];
+				s1 += a[k + 1] * b[k + 1];
+				s2 += a[k + 2] * b[k + 2];
+				s3 += a[k + 3] * b[k + 3];
+			}
+			for (; k < n; ++k) s0 += a[k] * b[k];
+		}
+		return (s0 + s1) + (s2 + s3);
+	}
+
+	// y[i] = alpha * x[i] + y[i] for the elements [first, last), rounded once
+	template<typename Scalar>
+	void packed_axpy(double alpha, const packed_vector<Scalar>& x, packed_vector<Scalar>& y, size_t first, size_t last) {
+		double a[PACKED_TILE], b[PACKED_TILE];
+		uint32_t codes[PACKED_TILE];
+		for (size_t offset = first; offset < last; offset += PACKED_TILE) {
+			size_t n = std::min(PACKED_TILE, last - offset);
+			x.unpack(offset, n, a);
+			y.unpack(offset, n, b);
+			for (size_t k = 0; k < n; ++k) codes[k] = packed_encoding(Scalar(alpha * a[k] + b[k]));
+			y.pack(offset, n, codes);
+		}
+	}
+}
+
+// dot product of packed vectors: the products of the values are accumulated in double, with the rounding of double,
+// and the sum is rounded to Scalar once
+template<typename Scalar>
+Scalar dot(const packed_vector<Scalar>& x, const packed_vector<Scalar>& y) {
+	if (size(x) > size(y)) return Scalar(0);
+	return Scalar(detail::packed_dot(x, y, 0, size(x)));
+}
+// dot product of packed vectors under an execution policy: the threads take whole tiles
+template<typename Scalar>
+Scalar dot(ExecutionPolicy policy, const packed_vector<Scalar>& x, const packed_vector<Scalar>& y, unsigned nrThreads = 0) {
+	size_t N = size(x);
+	if (N > size(y)) return Scalar(0);
+	if (policy == ExecutionPolicy::Serial) return Scalar(detail::packed_dot(x, y, 0, N));
+	// partial sums of chunks of whole tiles, per thread for Parallel, per reduction block for ParallelDeterministic
+	size_t chunk = (policy == ExecutionPolicy::Parallel ? PACKED_TILE : BLAS_REDUCTION_BLOCK);
+	size_t nrChunks = (N + chunk - 1) / chunk;
+	unsigned threads = blas_threads(N, nrThreads);
+	std::vector<double> partials(policy == ExecutionPolicy::Parallel ? threads : nrChunks, 0.0);
+	parallel_for(0, nrChunks, [&](size_t firstChunk, size_t lastChunk, unsigned t) {
+		if (policy == ExecutionPolicy::Parallel) {
+			partials[t] = detail::packed_dot(x, y, firstChunk * chunk, std::min(N, lastChunk * chunk));
+		}
+		else {
+			for (size_t c = firstChunk; c < lastChunk; ++c) partials[c] = detail::packed_dot(x, y, c * chunk, std::min(N, (c + 1) * chunk));
+		}
+	}, threads);
+	double sum{ 0 };
+	for (double partial : partials) sum += partial;
+	return Scalar(sum);
+}
+
+// a times x plus y of packed vectors: a * x[i] + y[i] is evaluated in double and rounded once
+template<typename Alpha, typename Scalar>
+void axpy(size_t n, Alpha a, const packed_vector<Scalar>& x, size_t incx, packed_vector<Scalar>& y, size_t incy) {
+	double alpha = double(a);
+	if (incx == 1 && incy == 1) {
+		detail::packed_axpy(alpha, x, y, 0, std::min(n, std::min(size(x), size(y))));
+		return;
+	}
+	size_t cnt = std::min(n, std::min(strided_count(size(x), incx), strided_count(size(y), incy)));
+	for (size_t k = 0; k < cnt; ++k) y[k * incy] = Scalar(alpha * double(x[k * incx]) + double(y[k * incy]));
+}
+// a times x plus y of packed vectors under an execution policy: the threads take whole tiles, and all policies yield the same result
+template<typename Alpha, typename Scalar>
+void axpy(ExecutionPolicy policy, size_t n, Alpha a, const packed_vector<Scalar>& x, size_t incx, packed_vector<Scalar>& y, size_t incy, unsigned nrThreads = 0) {
+	if (policy == ExecutionPolicy::Serial || incx != 1 || incy != 1) {
+		axpy(n, a, x, incx, y, incy);
+		return;
+	}
+	double alpha = double(a);
+	size_t N = std::min(n, std::min(size(x), size(y)));
+	size_t nrTiles = (N + PACKED_TILE - 1) / PACKED_TILE;
+	parallel_for(0, nrTiles, [&](size_t firstTile, size_t lastTile, unsigned) {
+		detail::packed_axpy(alpha, x, y, firstTile * PACKED_TILE, std::min(N, lastTile * PACKED_TILE));
+	}, blas_threads(N, nrThreads));
+}
+
+}}} // namespace sw::universal::blas
@@ -0,0 +1,141 @@
+#pragma once
+// reproducible.hpp: reproducible BLAS reductions through binned accumulation
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <cmath>
+#include <concepts>
+#include <limits>
+#include <vector>
+#include <universal/number/float/binned.hpp>
+#include <universal/blas/vector.hpp>
+#include <universal/blas/matrix.hpp>
+#include <universal/blas/execution.hpp>
+
+namespace sw { namespace universal { namespace blas {
+
+// The ParallelDeterministic policy fixes the reduction tree, so its result does not depend on the number
+// of threads, but it does depend on the block size and on the order of the elements. The reproducible
+// reductions accumulate into binned accumulators, whose state does not depend on the order of the terms
+// or on the grouping of the partial sums: the result is bitwise identical for any number of threads, any
+// chunking, and any permutation of the elements.
+//
+// binned_traits<Scalar> maps a scalar type onto the binned accumulator of a native type:
+//   float and double     accumulate in their own type
+//   dd                   accumulates its high and low components in a double accumulator
+//   cfloat, and other    accumulate in double when all their values are doubles, which
+//   small formats        makes their products exact for formats of up to 26 significand bits
+template<typename Scalar, typename Enable = void>
+struct binned_traits {
+	static_assert(sizeof(Scalar) == 0, "binned_traits: no binned accumulator for this scalar type");
+};
+
+template<typename Real>
+struct binned_traits<Real, std::enable_if_t<std::is_same_v<Real, float> || std::is_same_v<Real, double>>> {
+	using accumulator = binned_accumulator<Real>;
+	static void add(accumulator& acc, Real v) noexcept { acc += v; }
+	static void add_product(accumulator& acc, Real a, Real b) noexcept { acc += a * b; }
+	static Real result(const accumulator& acc) noexcept { return acc.value(); }
+};
+
+template<typename Scalar>
+concept double_double = requires(const Scalar & v) {
+	{ v.high() } -> std::same_as<double>;
+	{ v.low() } -> std::same_as<double>;
+};
+
+template<typename Scalar>
+struct binned_traits<Scalar, std::enable_if_t<double_double<Scalar>>> {
+	using accumulator = binned_accumulator<double>;
+	static void add(accumulator& acc, const Scalar& v) noexcept {
+		acc += v.high();
+		acc += v.low();
+	}
+	static void add_product(accumulator& acc, const Scalar& a, const Scalar& b) noexcept { add(acc, Scalar(a * b)); }
+	static Scalar result(const accumulator& acc) noexcept {
+		double hi, lo;
+		acc.value(hi, lo);
+		return Scalar(hi, lo);
+	}
+};
+
+// formats whose values are all exactly representable as doubles
+template<typename Scalar>
+constexpr bool is_double_representable = !std::is_same_v<Scalar, float> && !std::is_same_v<Scalar, double> && !double_double<Scalar>
+	&& std::numeric_limits<Scalar>::is_specialized && !std::numeric_limits<Scalar>::is_integer
+	&& std::numeric_limits<Scalar>::digits <= std::numeric_limits<double>::digits
+	&& std::numeric_limits<Scalar>::max_exponent <= std::numeric_limits<double>::max_exponent
+	&& std::numeric_limits<Scalar>::min_exponent - std::numeric_limits<Scalar>::digits >= std::numeric_limits<double>::min_exponent - std::numeric_limits<double>::digits;
+
+template<typename Scalar>
+struct binned_traits<Scalar, std::enable_if_t<is_double_representable<Scalar>>> {
+	using accumulator = binned_accumulator<double>;
+	static void add(accumulator& acc, const Scalar& v) noexcept { acc += double(v); }
+	static void add_product(accumulator& acc, const Scalar& a, const Scalar& b) noexcept { acc += double(a) * double(b); }
+	static Scalar result(const accumulator& acc) noexcept { return Scalar(acc.value()); }
+};
+
+// accumulate(acc, k) for k in [0, N) into one binned accumulator per thread, and merge the accumulators
+template<typename Scalar, typename Accumulate>
+Scalar binned_reduce(size_t N, Accumulate&& accumulate, unsigned nrThreads = 0) {
+	using Traits = binned_traits<Scalar>;
+	unsigned threads = blas_threads(N, nrThreads);
+	std::vector<typename Traits::accumulator> partials(threads);
+	parallel_for(0, N, [&](size_t first, size_t last, unsigned t) {
+		for (size_t k = first; k < last; ++k) accumulate(partials[t], k);
+	}, threads);
+	for (unsigned t = 1; t < threads; ++t) partials[0] += partials[t];
+	return Traits::result(partials[0]);
+}
+
+// reproducible sum of the elements of a vector
+template<typename Vector>
+typename Vector::value_type reproducible_sum(const Vector& x, unsigned nrThreads = 0) {
+	using Scalar = typename Vector::value_type;
+	using Traits = binned_traits<Scalar>;
+	return binned_reduce<Scalar>(size(x), [&](typename Traits::accumulator& acc, size_t i) { Traits::add(acc, x[i]); }, nrThreads);
+}
+
+// reproducible sum of the magnitudes of the elements of a vector
+template<typename Vector>
+typename Vector::value_type reproducible_asum(const Vector& x, unsigned nrThreads = 0) {
+	using Scalar = typename Vector::value_type;
+	using Traits = binned_traits<Scalar>;
+	return binned_reduce<Scalar>(size(x), [&](typename Traits::accumulator& acc, size_t i) { Traits::add(acc, (x[i] < Scalar(0) ? Scalar(-x[i]) : x[i])); }, nrThreads);
+}
+
+// reproducible dot product: the products are rounded to the accumulation type, which is exact for small formats
+template<typename Vector>
+typename Vector::value_type reproducible_dot(const Vector& x, const Vector& y, unsigned nrThreads = 0) {
+	using Scalar = typename Vector::value_type;
+	using Traits = binned_traits<Scalar>;
+	size_t nx = size(x);
+	if (nx > size(y)) return Scalar(0);
+	return binned_reduce<Scalar>(nx, [&](typename Traits::accumulator& acc, size_t i) { Traits::add_product(acc, x[i], y[i]); }, nrThreads);
+}
+
+// reproducible 2-norm of a vector
+template<typename Vector>
+typename Vector::value_type reproducible_nrm2(const Vector& x, unsigned nrThreads = 0) {
+	using std::sqrt;
+	return sqrt(reproducible_dot(x, x, nrThreads));
+}
+
+// reproducible matrix-vector product y = alpha * A * x + beta * y: the rows are distributed across threads
+// and each row is a binned dot product, so the result does not depend on the order of the columns either
+template<typename Scalar>
+void reproducible_gemv(const Scalar& alpha, const matrix<Scalar>& A, const vector<Scalar>& x, const Scalar& beta, vector<Scalar>& y, unsigned nrThreads = 0) {
+	using Traits = binned_traits<Scalar>;
+	size_t rows = A.rows(), cols = A.cols();
+	parallel_for(0, rows, [&](size_t first, size_t last, unsigned) {
+		for (size_t i = first; i < last; ++i) {
+			typename Traits::accumulator acc;
+			for (size_t j = 0; j < cols; ++j) Traits::add_product(acc, A(i, j), x[j]);
+			y[i] = alpha * Traits::result(acc) + beta * y[i];
+		}
+	}, blas_threads(rows * cols, nrThreads));
+}
+
+}}} // namespace sw::universal::blas
@@ -6,6 +6,8 @@
 // This file is part of the universal numbers project, which is released under an MIT Open Source license.
 #include <universal/number/posit/posit_fwd.hpp>
 #include <universal/blas/matrix.hpp>
+#include <universal/blas/blas_l2.hpp>
+#include <universal/utility/arena.hpp>
 
 namespace sw { namespace universal { namespace blas {
 
@@ -27,16 +29,20 @@ size_t cg(const Matrix& M, const Matrix& A, const Vector& b, Vector& x, Vector&
 	Scalar residual = Scalar(std::numeric_limits<Scalar>::max());
 	//size_t m = num_rows(A);
 	//size_t n = num_cols(A);
-	Vector rho(size(b));
-	Vector zeta(size(b));
-	Vector p(size(b));
-	Vector q(size(b));
+	// the workspace is drawn from the arena of the calling thread, and reclaimed when the solver returns
+	arena_scope scope;
+	using Workspace = vector<Scalar, arena_allocator<Scalar>>;
+	Workspace rho(size(b));
+	Workspace zeta(size(b));
+	Workspace p(size(b));
+	Workspace q(size(b));
+	Workspace x_1(size(b));  // previous iterate, reused across iterations
 	Scalar sigma_1{ 0 }, sigma_2{ 0 }, alpha{ 0 }, beta{ 0 };
 	rho = b;  // term is b - A * x, but if we use x(0) = 0 vector, rho = b is equivalent
 	size_t itr = 0;
 	bool firstIteration = true;
 	while (residual > tolerance && itr < MAX_ITERATIONS) {
-		zeta = M * rho;
+		matvec(ExecutionPolicy::Parallel, zeta, M, rho);  // M * rho, in place
 		sigma_2 = sigma_1;
 		sigma_1 = zeta * rho; // adaptive dot product, fused dot product if Scalar is a posit type, regular dot product if Scalar is native IEEE floating point
 		if (firstIteration) {
@@ -47,9 +53,9 @@ size_t cg(const Matrix& M, const Matrix& A, const Vector& b, Vector& x, Vector&
 			beta = sigma_1 / sigma_2;
 			p = zeta + beta * p;
 		}
-		q = A * p;
+		matvec(ExecutionPolicy::Parallel, q, A, p);  // A * p, in place
 		alpha = sigma_1 / (p * q); // adaptive dot product
-		Vector x_1(x);
+		x_1 = x;
 		x = x + alpha * p;
 		rho = rho - alpha * q;
 		// check for convergence of the system
@@ -7,6 +7,8 @@
 #include <cmath>
 #include <universal/number/posit/posit_fwd.hpp>
 #include <universal/blas/matrix.hpp>
+#include <universal/blas/stencil.hpp>
+#include <universal/utility/arena.hpp>
 
 namespace sw { namespace universal { namespace blas {
 
@@ -21,8 +23,10 @@ size_t Jacobi(const Matrix& A, const Vector& b, Vector& x, typename Matrix::valu
 	size_t m = num_rows(A);
 	size_t n = num_cols(A);
 	size_t itr = 0;
+	arena_scope scope;  // the workspace is drawn from the arena of the calling thread, and reclaimed on return
+	vector<Scalar, arena_allocator<Scalar>> x_old(size(x));  // previous iterate, reused across iterations
 	while (residual > tolerance && itr < MAX_ITERATIONS) {
-		Vector x_old = x;
+		x_old = x;
 		for (size_t i = 0; i < m; ++i) {
 			Scalar sigma = 0;
 			for (size_t j = 0; j < n; ++j) {
@@ -38,4 +42,20 @@ size_t Jacobi(const Matrix& A, const Vector& b, Vector& x, typename Matrix::valu
 	return itr;
 }
 
+// Jacobi on a matrix-free stencil: each sweep computes the new iterate from the previous one across the
+// threads, and the iteration stops when the largest absolute update falls below the tolerance
+template<typename Scalar, size_t MAX_ITERATIONS = 100, bool traceIteration = false>
+size_t Jacobi(const stencil<Scalar>& A, const vector<Scalar>& b, vector<Scalar>& x, Scalar tolerance = 0) {
+	Scalar residual = Scalar(std::numeric_limits<Scalar>::max());
+	vector<Scalar> x_new(size(x));
+	size_t itr = 0;
+	while (residual > tolerance && itr < MAX_ITERATIONS) {
+		residual = A.jacobi_sweep(b, x, x_new);
+		std::swap(x, x_new);
+		if constexpr (traceIteration) std::cout << '[' << itr << "] residual " << residual << std::endl;
+		++itr;
+	}
+	return itr;
+}
+
 }}} // namespace sw::universal::blas
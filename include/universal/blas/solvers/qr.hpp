@@ -209,6 +209,7 @@ vector<Scalar> subvec(const vector<Scalar>& v, size_t j,size_t n){
 // Given rotation setup (entries of rotation matrix)
 template<typename Scalar>
 vector<Scalar> givens(const Scalar a, const Scalar b){
+    using std::sqrt;
     vector<Scalar> x(2);
     if (abs(a) >= abs(b)){
         Scalar t = b/a;
@@ -246,6 +247,151 @@ void givensqr(const matrix<Scalar>& A, matrix<Scalar>& Q, matrix<Scalar>& R){
     }
 }
 
+/*
+ * Blocked Householder QR
+ *
+ * The columns are factored in panels of nb columns. Inside a panel the reflectors
+ * H_p = I - tau_p v_p v_p^T are generated and applied column by column, and then aggregated
+ * in the compact WY representation H_0 H_1 ... H_nb-1 = I - V T V^T, with V the unit lower
+ * trapezoidal matrix of the reflectors and T an nb x nb upper triangular matrix
+ * (Schreiber and Van Loan, A Storage-Efficient WY Representation for Products of Householder Transformations, 1989).
+ * The trailing columns of R and the columns of Q are then updated with three matrix-matrix products
+ * per panel, which stream rows of the row-major storage instead of walking columns.
+ */
+
+// factor the panel R(k:m, k:k+nb) into nb reflectors: V is (m-k) x nb unit lower trapezoidal,
+// and T is the nb x nb upper triangular factor of the compact WY representation
+template<typename Scalar>
+void householder_panel(matrix<Scalar>& R, size_t k, size_t nb, matrix<Scalar>& V, matrix<Scalar>& T){
+    using std::sqrt;
+    size_t m = num_rows(R);
+    V = matrix<Scalar>(m - k, nb);
+    T = matrix<Scalar>(nb, nb);
+    std::vector<Scalar> w(nb), z(nb);
+    for(size_t p = 0; p < nb; ++p){
+        size_t c = k + p;
+        Scalar alpha = R(c,c);
+        Scalar sigma(0);
+        for(size_t i = c + 1; i < m; ++i) sigma += R(i,c) * R(i,c);
+        V(p,p) = Scalar(1);
+        Scalar tau(0);
+        if(sigma != Scalar(0)){
+            // reflect x = R(c:m, c) onto beta e_1 with beta = -sign(alpha) ||x|| to avoid cancellation
+            Scalar beta = sqrt(alpha * alpha + sigma);
+            if(alpha > Scalar(0)) beta = -beta;
+            tau = (beta - alpha) / beta;
+            Scalar scale = Scalar(1) / (alpha - beta);
+            for(size_t i = c + 1; i < m; ++i){
+                V(i - k,p) = R(i,c) * scale;
+                R(i,c) = Scalar(0);
+            }
+            R(c,c) = beta;
+        }
+        // apply H_p to the remaining columns of the panel: R -= tau v (v^T R)
+        if(tau != Scalar(0) && p + 1 < nb){
+            for(size_t q = p + 1; q < nb; ++q) w[q] = R(c,k + q);
+            for(size_t i = c + 1; i < m; ++i){
+                Scalar vi = V(i - k,p);
+                for(size_t q = p + 1; q < nb; ++q) w[q] += vi * R(i,k + q);
+            }
+            for(size_t q = p + 1; q < nb; ++q) w[q] *= tau;
+            for(size_t q = p + 1; q < nb; ++q) R(c,k + q) -= w[q];
+            for(size_t i = c + 1; i < m; ++i){
+                Scalar vi = V(i - k,p);
+                for(size_t q = p + 1; q < nb; ++q) R(i,k + q) -= vi * w[q];
+            }
+        }
+        // T(0:p, p) = -tau T(0:p, 0:p) V(:, 0:p)^T v_p
+        T(p,p) = tau;
+        if(p > 0){
+            for(size_t r = 0; r < p; ++r) z[r] = Scalar(0);
+            for(size_t i = p; i < m - k; ++i){
+                Scalar vi = V(i,p);
+                for(size_t r = 0; r < p; ++r) z[r] += V(i,r) * vi;
+            }
+            for(size_t r = 0; r < p; ++r){
+                Scalar e(0);
+                for(size_t s = r; s < p; ++s) e += T(r,s) * z[s];
+                T(r,p) = -tau * e;
+            }
+        }
+    }
+}
+
+// apply the block reflector H = I - V T V^T, or its transpose, from the left to C(k:m, c0:n):
+// C = C - V (op(T) (V^T C)) with op(T) = T^T for H^T and op(T) = T for H.
+// Every thread owns a contiguous range of the columns, so the update is race free
+// and its rounding does not depend on the number of threads.
+template<typename Scalar>
+void householder_block_apply(matrix<Scalar>& C, size_t k, size_t c0, const matrix<Scalar>& V, const matrix<Scalar>& T, bool transpose){
+    size_t m = num_rows(C);
+    size_t n = num_cols(C);
+    size_t nb = num_cols(V);
+    if(c0 >= n) return;
+    parallel_for(c0, n, [&](size_t first, size_t last, unsigned){
+        size_t width = last - first;
+        matrix<Scalar> W(nb, width);
+        // W = V^T C
+        for(size_t i = k; i < m; ++i){
+            for(size_t p = 0; p < nb && p <= i - k; ++p){
+                Scalar vip = V(i - k,p);
+                if(vip == Scalar(0)) continue;
+                for(size_t j = 0; j < width; ++j) W(p,j) += vip * C(i,first + j);
+            }
+        }
+        // W = op(T) W in place: row p of T^T W depends on rows 0..p of W, row p of T W on rows p..nb-1
+        for(size_t step = 0; step < nb; ++step){
+            size_t p = (transpose ? nb - 1 - step : step);
+            for(size_t j = 0; j < width; ++j){
+                Scalar e(0);
+                if(transpose){
+                    for(size_t r = 0; r <= p; ++r) e += T(r,p) * W(r,j);
+                }
+                else{
+                    for(size_t r = p; r < nb; ++r) e += T(p,r) * W(r,j);
+                }
+                W(p,j) = e;
+            }
+        }
+        // C -= V W
+        for(size_t i = k; i < m; ++i){
+            for(size_t p = 0; p < nb && p <= i - k; ++p){
+                Scalar vip = V(i - k,p);
+                if(vip == Scalar(0)) continue;
+                for(size_t j = 0; j < width; ++j) C(i,first + j) -= vip * W(p,j);
+            }
+        }
+    }, blas_threads((m - k) * (n - c0) * nb));
+}
+
+// blocked Householder QR: A = Q R with Q an m x m orthogonal matrix and R m x n upper triangular
+// The panels are factored left to right, applying H^T of each panel to the trailing columns of R.
+// Q = H_panel0 H_panel1 ... is then accumulated backward from the identity, as each block reflector
+// only needs to be applied to the rows and columns that the later panels have already filled in.
+template<typename Scalar>
+void blocked_houseqr(const matrix<Scalar>& A, matrix<Scalar>& Q, matrix<Scalar>& R, size_t blockSize = 32){
+    size_t m = num_rows(A);
+    size_t n = num_cols(A);
+    if(blockSize == 0) blockSize = 1;
+    R = A;
+    size_t steps = (m < n ? m : n);
+    std::vector<matrix<Scalar>> V, T;
+    std::vector<size_t> panel;
+    for(size_t k = 0; k < steps; k += blockSize){
+        size_t nb = (k + blockSize < steps ? blockSize : steps - k);
+        V.emplace_back();
+        T.emplace_back();
+        panel.push_back(k);
+        householder_panel(R, k, nb, V.back(), T.back());
+        householder_block_apply(R, k, k + nb, V.back(), T.back(), true);
+    }
+    Q = matrix<Scalar>(m, m);
+    Q = Scalar(1);
+    for(size_t b = panel.size(); b-- > 0;){
+        householder_block_apply(Q, panel[b], panel[b], V[b], T[b], false);
+    }
+}
+
 // MAIN QR method (calls specific method within)
 template<typename Scalar>
 std::pair<matrix<Scalar>, matrix<Scalar>> qr(const matrix<Scalar>& A, size_t which = 1) {
@@ -287,6 +433,9 @@ std::pair<matrix<Scalar>, matrix<Scalar>> qr(const matrix<Scalar>& A, size_t whi
             houseqrpivot(A, Q, R, P);
         } 
 		break;
+	case 5:
+		blocked_houseqr(A, Q, R);
+		break;
 	default:
 		{
             Q = 1;
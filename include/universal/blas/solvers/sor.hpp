@@ -6,6 +6,8 @@
 // This file is part of the universal numbers project, which is released under an MIT Open Source license.
 #include <universal/number/posit/posit_fwd.hpp>
 #include <universal/blas/matrix.hpp>
+#include <universal/blas/stencil.hpp>
+#include <universal/utility/arena.hpp>
 
 namespace sw { namespace universal { namespace blas {
 
@@ -17,8 +19,10 @@ size_t sor(const Matrix& A, const Vector& b, Vector& x, typename Matrix::value_t
 	size_t m = num_rows(A);
 	size_t n = num_cols(A);
 	size_t itr = 0;
+	arena_scope scope;  // the workspace is drawn from the arena of the calling thread, and reclaimed on return
+	vector<Scalar, arena_allocator<Scalar>> x_old(size(x));  // previous iterate, reused across iterations
 	while (residual > tolerance && itr < MAX_ITERATIONS) {
-		Vector x_old = x;
+		x_old = x;
 		// Gauss-Seidel step
 		for (size_t i = 1; i <= m; ++i) {
 			Scalar sigma = 0;
@@ -39,4 +43,17 @@ size_t sor(const Matrix& A, const Vector& b, Vector& x, typename Matrix::value_t
 	return itr;
 }
 
+// sor on a matrix-free stencil in red-black ordering, which updates the points of a color in parallel:
+// the iteration stops when the largest absolute update falls below the tolerance
+template<typename Scalar, size_t MAX_ITERATIONS = 100>
+size_t sor(const stencil<Scalar>& A, const vector<Scalar>& b, vector<Scalar>& x, Scalar w, Scalar tolerance = Scalar(0.00001)) {
+	Scalar residual = Scalar(std::numeric_limits<Scalar>::max());
+	size_t itr = 0;
+	while (residual > tolerance && itr < MAX_ITERATIONS) {
+		residual = A.red_black_sweep(b, x, w);
+		++itr;
+	}
+	return itr;
+}
+
 }}} // namespace sw::universal::blas
@@ -1,68 +1,170 @@
-#pragma once
-// svd.hpp: generate bit patterns and values for a 16-bit takum
-//
-// Copyright (C) 2017 Stillwater Supercomputing, Inc.
-// SPDX-License-Identifier: MIT
-//
-// This file is part of the universal numbers project, which is released under an MIT Open Source license.
-#include <algorithm>
-
-#include <universal/blas/blas_l1.hpp>
-#include <universal/blas/matrix.hpp>
-
-namespace sw { namespace universal { namespace blas {
-
-template<typename Scalar, typename Tolerance = double>
-void svd(const matrix<Scalar>& A, matrix<Scalar>& S, matrix<Scalar>& V, matrix<Scalar>& D, Tolerance tol = 10e-10) {
-/*
-    using value_type = Scalar;
-    using size_type  = typename matrix<Scalar>::size_type;
-    size_type        ncols = num_cols(A), nrows = num_rows(A);
-    value_type       ref, zero = Scalar{ 0 }, one = Scalar{ 1 };
-    
-    // if (nrows != ncols) std::swap(row, col);
-
-    matrix<Scalar> Q(nrows, nrows), R(nrows, ncols), VT(nrows, ncols), E(nrows, ncols),QT(ncols, ncols), RT(ncols, nrows);
-    size_type l = 100 * std::max(nrows, ncols);
-    S = one; D = one; 
-    double err{ std::numeric_limits<double>::max() };
-    for (size_type i = 0; err > tol && i < l; ++i) {
-        double e, f;
-        std::tie(QT, RT) = qr(V);
-        S *= QT;
-        VT = RT.transpose();
-        std::tie(Q, R) = qr(VT);
-        D *= Q;
-        E = triu(R, 1);
-        V = trans(R);
-        f=norm(diag(R), 2);
-        e=norm(E);
-        if(f==zero) f=1;
-        err=e/f;
-    }
-    {
-	    V= 0;  
-	    matrix<Scalar>  ins_V(V), ins_S(S);
-	                
-	    for (size_type i= 0, end= std::min(nrows, ncols); i < end; ++i) {
-	        ins_V[i][i] *= std::abs(R[i][i]);
-	        if (R[i][i] < zero) 	
-		    for (size_type j= 0; j < nrows; ++j) 
-		    ins_S[j][i] *= -1; 
-	    }
-    }
-    */
-}
-
-template<typename Scalar, typename Tolerance>
-std::tuple<matrix<Scalar>, matrix<Scalar>, matrix<Scalar>> svd(const matrix<Scalar>& A, Tolerance tol= 10e-10) {
-    using size_type = typename matrix<Scalar>::size_type;
-    size_type    ncols = num_cols(A), nrows = num_rows(A);
-    //if (nrows != ncols) std::swap(row, col);
-    matrix<Scalar> ST(ncols, ncols), V(A), D(nrows, nrows);
-    svd(A, ST, V, D, tol);
-    return std::make_tuple(ST, V, D);
-
-}   
-
-}}} // namespace sw::universal::blas
+#pragma once
+// svd.hpp: singular value decomposition through one-sided Jacobi rotations
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <tuple>
+
+#include <universal/blas/blas_l1.hpp>
+#include <universal/blas/matrix.hpp>
+
+namespace sw { namespace universal { namespace blas {
+
+/*
+ * One-sided Jacobi SVD (Hestenes, 1958)
+ *
+ * The columns of B = A (or A^T when A has more columns than rows) are orthogonalized in place
+ * by plane rotations, which are accumulated in V. When all pairs of columns are orthogonal to
+ * within the tolerance, B = U diag(sigma) with sigma the column norms, and A = U diag(sigma) V^T.
+ * The algorithm computes the small singular values to high relative accuracy (Demmel and Veselic, 1992),
+ * which makes it the reference for conditioning studies of the test matrices.
+ *
+ * The columns are kept as rows of the row-major workspace so that a rotation streams two contiguous rows.
+ * Each sweep visits all column pairs in the round-robin order of a tournament, in which the n/2 pairs
+ * of a round are disjoint: they are rotated in parallel, and as each pair only touches its own two rows
+ * the result does not depend on the number of threads.
+ */
+
+// rotate rows i and j of G, and the same rows of Vt, to make them orthogonal: returns true if a rotation was applied
+template<typename Scalar>
+bool jacobi_rotate(matrix<Scalar>& G, matrix<Scalar>& Vt, size_t i, size_t j, const Scalar& threshold) {
+    using std::sqrt; using std::abs;
+    size_t m = num_cols(G);
+    size_t n = num_cols(Vt);
+    Scalar alpha(0), beta(0), gamma(0);
+    for (size_t k = 0; k < m; ++k) {
+        Scalar gi = G(i, k), gj = G(j, k);
+        alpha += gi * gi;
+        beta  += gj * gj;
+        gamma += gi * gj;
+    }
+    if (gamma == Scalar(0) || abs(gamma) <= threshold * sqrt(alpha * beta)) return false;
+    // t is the smaller root of t^2 + 2 zeta t - 1 = 0, which keeps the rotation angle below pi/4
+    Scalar zeta = (beta - alpha) / (Scalar(2) * gamma);
+    Scalar t = Scalar(1) / (abs(zeta) + sqrt(Scalar(1) + zeta * zeta));
+    if (zeta < Scalar(0)) t = -t;
+    Scalar c = Scalar(1) / sqrt(Scalar(1) + t * t);
+    Scalar s = c * t;
+    for (size_t k = 0; k < m; ++k) {
+        Scalar gi = G(i, k), gj = G(j, k);
+        G(i, k) = c * gi - s * gj;
+        G(j, k) = s * gi + c * gj;
+    }
+    for (size_t k = 0; k < n; ++k) {
+        Scalar vi = Vt(i, k), vj = Vt(j, k);
+        Vt(i, k) = c * vi - s * vj;
+        Vt(j, k) = s * vi + c * vj;
+    }
+    return true;
+}
+
+// one-sided Jacobi SVD: A = U diag(sigma) V^T with the singular values sigma in descending order,
+// U is m x k and V is n x k with k = min(m, n). Returns the number of sweeps.
+// The rotation threshold is the larger of tol and k times the machine epsilon of Scalar.
+template<typename Scalar, typename Tolerance = double>
+size_t jacobi_svd(const matrix<Scalar>& A, matrix<Scalar>& U, vector<Scalar>& sigma, matrix<Scalar>& V, Tolerance tol = 0, size_t maxSweeps = 64) {
+    using std::sqrt;
+    size_t m = num_rows(A);
+    size_t n = num_cols(A);
+    bool wide = m < n;
+    // G holds the columns of B as rows: B = A for tall matrices, B = A^T for wide matrices
+    size_t k = (wide ? m : n);     // number of columns of B
+    size_t len = (wide ? n : m);   // length of the columns of B
+    matrix<Scalar> G(k, len);
+    for (size_t i = 0; i < m; ++i) {
+        for (size_t j = 0; j < n; ++j) {
+            if (wide) G(i, j) = A(i, j); else G(j, i) = A(i, j);
+        }
+    }
+    matrix<Scalar> Vt(k, k);
+    Vt = Scalar(1);
+
+    Scalar threshold = Scalar(double(tol));
+    Scalar floor = Scalar(double(k)) * std::numeric_limits<Scalar>::epsilon();
+    if (threshold < floor) threshold = floor;
+
+    // round-robin tournament: an odd number of columns gets a bye, marked by the index k
+    size_t players = k + (k & 1);
+    std::vector<size_t> order(players);
+    std::iota(order.begin(), order.end(), size_t(0));
+    size_t nrPairs = players / 2;
+    std::vector<char> rotated(nrPairs);
+
+    size_t sweep = 0;
+    bool converged = (k < 2);
+    while (!converged && sweep < maxSweeps) {
+        ++sweep;
+        bool anyRotation = false;
+        for (size_t round = 0; round + 1 < players; ++round) {
+            parallel_for(0, nrPairs, [&](size_t first, size_t last, unsigned) {
+                for (size_t p = first; p < last; ++p) {
+                    size_t i = order[p];
+                    size_t j = order[players - 1 - p];
+                    if (i > j) std::swap(i, j);
+                    rotated[p] = (j < k) && jacobi_rotate(G, Vt, i, j, threshold);
+                }
+            }, blas_threads(nrPairs * (len + k)));
+            for (char r : rotated) anyRotation = anyRotation || r;
+            std::rotate(order.begin() + 1, order.end() - 1, order.end());
+        }
+        converged = !anyRotation;
+    }
+
+    // the singular values are the column norms, and the normalized columns are the singular vectors
+    std::vector<Scalar> norms(k);
+    for (size_t i = 0; i < k; ++i) {
+        Scalar sos(0);
+        for (size_t l = 0; l < len; ++l) sos += G(i, l) * G(i, l);
+        norms[i] = sqrt(sos);
+    }
+    std::vector<size_t> rank(k);
+    std::iota(rank.begin(), rank.end(), size_t(0));
+    std::stable_sort(rank.begin(), rank.end(), [&](size_t a, size_t b) { return norms[b] < norms[a]; });
+
+    // left singular vectors of B in Ub (len x k), right singular vectors of B in Vb (k x k)
+    matrix<Scalar> Ub(len, k), Vb(k, k);
+    sigma = vector<Scalar>(k);
+    for (size_t c = 0; c < k; ++c) {
+        size_t i = rank[c];
+        sigma[c] = norms[i];
+        for (size_t l = 0; l < len; ++l) Ub(l, c) = (norms[i] == Scalar(0) ? Scalar(0) : G(i, l) / norms[i]);
+        for (size_t l = 0; l < k; ++l) Vb(l, c) = Vt(i, l);
+    }
+    // A^T = Ub S Vb^T implies A = Vb S Ub^T
+    if (wide) {
+        U = Vb;
+        V = Ub;
+    }
+    else {
+        U = Ub;
+        V = Vb;
+    }
+    return sweep;
+}
+
+// singular value decomposition A = S * V * D^T:
+// S holds the left singular vectors (m x k), V the singular values on its diagonal (k x k),
+// and D the right singular vectors (n x k), with k = min(m, n)
+template<typename Scalar, typename Tolerance = double>
+void svd(const matrix<Scalar>& A, matrix<Scalar>& S, matrix<Scalar>& V, matrix<Scalar>& D, Tolerance tol = 10e-10) {
+    vector<Scalar> sigma;
+    jacobi_svd(A, S, sigma, D, tol);
+    size_t k = size(sigma);
+    V = matrix<Scalar>(k, k);
+    for (size_t i = 0; i < k; ++i) V(i, i) = sigma[i];
+}
+
+template<typename Scalar, typename Tolerance = double>
+std::tuple<matrix<Scalar>, matrix<Scalar>, matrix<Scalar>> svd(const matrix<Scalar>& A, Tolerance tol = 10e-10) {
+    matrix<Scalar> S, V, D;
+    svd(A, S, V, D, tol);
+    return std::make_tuple(S, V, D);
+}
+
+}}} // namespace sw::universal::blas
@@ -6,11 +6,450 @@
 //
 // This file is part of the universal numbers project, which is released under an MIT Open Source license.
 
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <iomanip>
 #include <limits>
+#include <vector>
 #include <universal/blas/vector.hpp>
+#include <universal/blas/execution.hpp>
+#include <universal/blas/exceptions.hpp>
 
 namespace sw { namespace universal { namespace blas {
 
+	/*
+	 Streaming statistics: each accumulator consumes a stream of values in one pass, in constant or
+	 logarithmic memory, without copying or sorting the data, and merges with the accumulator of another
+	 part of the stream, so a large data set is summarized by one accumulator per thread.
+
+	   moments          count, compensated sum, mean, variance, skewness, kurtosis, min, max
+	   tdigest          quantile sketch with accuracy that improves toward the tails
+	   scale_histogram  counts per binade of the values, with the binades of a number system as its range
+	*/
+
+	// single-pass moments that merge pairwise (Chan, Pebay), with a Kahan-Babuska compensated sum;
+	// NaN values are counted and excluded.
+	// The mean and second moment accumulate in Scalar as sums of the values shifted by the first value K,
+	// S1 = sum(x - K) and S2 = sum((x - K)^2), which is as stable as Welford's update as long as K is
+	// within a few standard deviations of the mean, and costs no division per value, the most expensive
+	// operation of an emulated Scalar. A merge recenters K on the merged mean. The third and fourth moments,
+	// which only describe the shape of the distribution, accumulate in double with Welford's update (Terriberry).
+	template<typename Scalar>
+	class moments {
+	public:
+		moments() : _n{ 0 }, _nan{ 0 }, _shift(0), _s1(0), _s2(0), _sum(0), _compensation(0), _min(0), _max(0), _meand{ 0 }, _m2d{ 0 }, _m3{ 0 }, _m4{ 0 } {}
+
+		void push(const Scalar& x) {
+			using std::isnan;
+			using std::abs;
+			if (isnan(x)) { ++_nan; return; }
+			if (_n == 0) { _min = x; _max = x; _shift = x; }
+			else {
+				if (x < _min) _min = x;
+				if (_max < x) _max = x;
+			}
+			// Neumaier's variant of the compensated sum
+			Scalar t = _sum + x;
+			_compensation += (abs(_sum) >= abs(x) ? (_sum - t) + x : (x - t) + _sum);
+			_sum = t;
+			Scalar shifted = x - _shift;
+			_s1 += shifted;
+			_s2 += shifted * shifted;
+			// shape moments, updated from the second moment before this value
+			++_n;
+			double n = double(_n);
+			double d = double(x) - _meand, dn = d / n, dn2 = dn * dn, term1 = d * dn * (n - 1.0);
+			_meand += dn;
+			_m4 += term1 * dn2 * (n * n - 3.0 * n + 3.0) + 6.0 * dn2 * _m2d - 4.0 * dn * _m3;
+			_m3 += term1 * dn * (n - 2.0) - 3.0 * dn * _m2d;
+			_m2d += term1;
+		}
+		template<typename Iterator>
+		void push(Iterator first, Iterator last) { for (; first != last; ++first) push(Scalar(*first)); }
+
+		// combine with the moments of another part of the stream
+		moments& merge(const moments& rhs) {
+			using std::abs;
+			_nan += rhs._nan;
+			if (rhs._n == 0) return *this;
+			if (_n == 0) {
+				uint64_t nan = _nan;
+				*this = rhs;
+				_nan = nan;
+				return *this;
+			}
+			double na = double(_n), nb = double(rhs._n), n = na + nb;
+			Scalar delta = rhs.mean() - mean();
+			Scalar m2 = secondMoment() + rhs.secondMoment() + delta * delta * Scalar(na * nb / n);
+			_shift = mean() + delta * Scalar(nb / n);
+			_s1 = Scalar(0);
+			_s2 = m2;
+			double d = rhs._meand - _meand, d2 = d * d;
+			_m4 += rhs._m4 + d2 * d2 * na * nb * (na * na - na * nb + nb * nb) / (n * n * n)
+				+ 6.0 * d2 * (na * na * rhs._m2d + nb * nb * _m2d) / (n * n) + 4.0 * d * (na * rhs._m3 - nb * _m3) / n;
+			_m3 += rhs._m3 + d * d2 * na * nb * (na - nb) / (n * n) + 3.0 * d * (na * rhs._m2d - nb * _m2d) / n;
+			_m2d += rhs._m2d + d2 * na * nb / n;
+			_meand += d * nb / n;
+			_n += rhs._n;
+			Scalar t = _sum + rhs._sum;
+			_compensation += (abs(_sum) >= abs(rhs._sum) ? (_sum - t) + rhs._sum : (rhs._sum - t) + _sum) + rhs._compensation;
+			_sum = t;
+			if (rhs._min < _min) _min = rhs._min;
+			if (_max < rhs._max) _max = rhs._max;
+			return *this;
+		}
+
+		uint64_t count() const noexcept { return _n; }
+		uint64_t nans() const noexcept { return _nan; }
+		Scalar sum() const { return _sum + _compensation; }
+		Scalar mean() const { return (_n > 0 ? _shift + _s1 / Scalar(double(_n)) : Scalar(0)); }
+		Scalar min() const { return _min; }
+		Scalar max() const { return _max; }
+		// sample variance, divided by n - 1
+		Scalar variance() const { return (_n > 1 ? secondMoment() / Scalar(double(_n - 1)) : Scalar(0)); }
+		Scalar population_variance() const { return (_n > 0 ? secondMoment() / Scalar(double(_n)) : Scalar(0)); }
+		Scalar stddev() const { using std::sqrt; return sqrt(variance()); }
+		double skewness() const {
+			if (_n < 2 || _m2d == 0.0) return 0.0;
+			return std::sqrt(double(_n)) * _m3 / (_m2d * std::sqrt(_m2d));
+		}
+		// excess kurtosis, 0 for a normal distribution
+		double kurtosis() const {
+			if (_n < 2 || _m2d == 0.0) return 0.0;
+			return double(_n) * _m4 / (_m2d * _m2d) - 3.0;
+		}
+
+	private:
+		uint64_t _n, _nan;
+		Scalar   _shift, _s1, _s2;
+		Scalar   _sum, _compensation;
+		Scalar   _min, _max;
+		double   _meand, _m2d, _m3, _m4;
+
+		// sum of the squared deviations from the mean
+		Scalar secondMoment() const {
+			if (_n == 0) return Scalar(0);
+			Scalar m2 = _s2 - _s1 * _s1 / Scalar(double(_n));
+			return (m2 < Scalar(0) ? Scalar(0) : m2);
+		}
+	};
+
+	// merging t-digest (Dunning, 2019): the stream is summarized by at most about compression centroids, sorted
+	// by mean, whose weights are bounded by the arcsine scale function k(q) = compression / (2 pi) * asin(2q - 1),
+	// so centroids near the tails hold few values and the extreme quantiles are resolved to a few values.
+	// Incoming values collect in a buffer that is merged into the centroids when it fills: the buffer is the
+	// only thing that is ever sorted, with a radix sort on the bit patterns of the values, which does not pay
+	// for the unpredictable branches of a comparison sort. The values are summarized in double precision.
+	class tdigest {
+	public:
+		explicit tdigest(double compression = 200.0) : _compression{ compression }, _count{ 0 }, _min{ 0 }, _max{ 0 } {
+			_buffer.reserve(bufferSize());
+		}
+
+		void push(double x) {
+			if (std::isnan(x)) return;
+			if (_count == 0) { _min = x; _max = x; }
+			else {
+				_min = std::min(_min, x);
+				_max = std::max(_max, x);
+			}
+			_count += 1.0;
+			_buffer.push_back(x);
+			if (_buffer.size() >= bufferSize()) compress();
+		}
+		template<typename Iterator>
+		void push(Iterator first, Iterator last) { for (; first != last; ++first) push(double(*first)); }
+
+		// combine with the digest of another part of the stream
+		tdigest& merge(const tdigest& rhs) {
+			if (rhs._count == 0) return *this;
+			if (_count == 0) { _min = rhs._min; _max = rhs._max; }
+			else {
+				_min = std::min(_min, rhs._min);
+				_max = std::max(_max, rhs._max);
+			}
+			_count += rhs._count;
+			compress();
+			rhs.compress();
+			absorb(rhs._centroids);
+			return *this;
+		}
+
+		double count() const noexcept { return _count; }
+		// a stream of fewer values than this is held exactly in the buffer, and has not been merged into centroids
+		size_t buffer_capacity() const { return bufferSize(); }
+		double min() const noexcept { return _min; }
+		double max() const noexcept { return _max; }
+		size_t centroids() const { compress(); return _centroids.size(); }
+
+		// the value below which a fraction q of the stream falls, interpolated between the centroids
+		double quantile(double q) const {
+			compress();
+			if (_centroids.empty()) return std::numeric_limits<double>::quiet_NaN();
+			if (q <= 0.0) return _min;
+			if (q >= 1.0) return _max;
+			const size_t n = _centroids.size();
+			if (n == 1) return _centroids[0].mean;
+			double index = q * _count;
+			// the first and last centroids are centered between the extremes and their neighbors
+			double half = _centroids[0].weight / 2.0;
+			if (index < half) return _min + (index / half) * (_centroids[0].mean - _min);
+			double weightSoFar = half;
+			for (size_t i = 0; i + 1 < n; ++i) {
+				double dw = (_centroids[i].weight + _centroids[i + 1].weight) / 2.0;
+				if (weightSoFar + dw > index) {
+					double z = (index - weightSoFar) / dw;
+					return _centroids[i].mean + z * (_centroids[i + 1].mean - _centroids[i].mean);
+				}
+				weightSoFar += dw;
+			}
+			half = _centroids[n - 1].weight / 2.0;
+			double z = std::min(1.0, (index - weightSoFar) / half);
+			return _centroids[n - 1].mean + z * (_max - _centroids[n - 1].mean);
+		}
+		// the fraction of the stream below x
+		double cdf(double x) const {
+			compress();
+			if (_centroids.empty() || x < _min) return 0.0;
+			if (x >= _max) return 1.0;
+			double weightSoFar = 0.0;
+			double prevMean = _min, prevWeight = 0.0;
+			for (const centroid& c : _centroids) {
+				if (x < c.mean) {
+					double dw = (prevWeight + c.weight) / 2.0;
+					double z = (c.mean > prevMean ? (x - prevMean) / (c.mean - prevMean) : 1.0);
+					return (weightSoFar + z * dw) / _count;
+				}
+				weightSoFar += (prevWeight + c.weight) / 2.0;
+				prevMean = c.mean;
+				prevWeight = c.weight;
+			}
+			double z = (_max > prevMean ? (x - prevMean) / (_max - prevMean) : 1.0);
+			return (weightSoFar + z * prevWeight / 2.0) / _count;
+		}
+
+	private:
+		struct centroid {
+			double mean;
+			double weight;
+		};
+		double _compression;
+		double _count;
+		double _min, _max;
+		mutable std::vector<centroid> _centroids;
+		mutable std::vector<double>   _buffer;
+		mutable std::vector<uint64_t> _keys, _scratch;
+		mutable std::vector<centroid> _sorted, _merged;
+
+		// the buffer holds this many values per unit of compression: a larger buffer amortizes the merge with
+		// the centroids over more values, at the cost of a longer sort
+		static constexpr double BUFFER_FACTOR = 16.0;
+		size_t bufferSize() const { return static_cast<size_t>(BUFFER_FACTOR * _compression) + 16; }
+		static constexpr double twoPi = 6.283185307179586476925286766559;
+		double k(double q) const { return _compression / twoPi * std::asin(2.0 * q - 1.0); }
+		double kinverse(double k) const { return (std::sin(std::min(k * twoPi / _compression, twoPi / 4.0)) + 1.0) / 2.0; }
+
+		// map a double to an unsigned key with the same order: flip all bits of negatives, and the sign bit of positives
+		static uint64_t key(double x) {
+			uint64_t u;
+			std::memcpy(&u, &x, sizeof(u));
+			return u ^ ((u >> 63) ? ~uint64_t(0) : (uint64_t(1) << 63));
+		}
+		static double value(uint64_t k) {
+			uint64_t u = k ^ ((k >> 63) ? (uint64_t(1) << 63) : ~uint64_t(0));
+			double x;
+			std::memcpy(&x, &u, sizeof(x));
+			return x;
+		}
+
+		// LSD radix sort of the keys a byte at a time, skipping the bytes all keys share
+		void radix_sort() const {
+			const size_t n = _keys.size();
+			_scratch.resize(n);
+			size_t counts[8][256] = {};
+			for (uint64_t k : _keys) {
+				for (unsigned b = 0; b < 8; ++b) counts[b][(k >> (8 * b)) & 0xFF]++;
+			}
+			for (unsigned b = 0; b < 8; ++b) {
+				size_t* count = counts[b];
+				if (count[(_keys[0] >> (8 * b)) & 0xFF] == n) continue;
+				size_t offset{ 0 };
+				for (unsigned d = 0; d < 256; ++d) {
+					size_t c = count[d];
+					count[d] = offset;
+					offset += c;
+				}
+				for (uint64_t k : _keys) _scratch[count[(k >> (8 * b)) & 0xFF]++] = k;
+				_keys.swap(_scratch);
+			}
+		}
+
+		// sort the buffer and merge it into the centroids
+		void compress() const {
+			if (_buffer.empty()) return;
+			_keys.resize(_buffer.size());
+			for (size_t i = 0; i < _buffer.size(); ++i) _keys[i] = key(_buffer[i]);
+			_buffer.clear();
+			radix_sort();
+			_sorted.resize(_keys.size());
+			for (size_t i = 0; i < _keys.size(); ++i) _sorted[i] = centroid{ value(_keys[i]), 1.0 };
+			absorb(_sorted);
+		}
+
+		// merge centroids sorted by mean into the centroids: a pass over the union absorbs each one into the
+		// current centroid as long as the weight to its right edge stays below the quantile limit k^-1(k(q) + 1)
+		void absorb(const std::vector<centroid>& incoming) const {
+			auto byMean = [](const centroid& a, const centroid& b) { return a.mean < b.mean; };
+			_merged.resize(incoming.size() + _centroids.size());
+			std::merge(incoming.begin(), incoming.end(), _centroids.begin(), _centroids.end(), _merged.begin(), byMean);
+			double total{ 0 };
+			for (const centroid& c : _merged) total += c.weight;
+			_centroids.clear();
+			// the current centroid accumulates the weighted sum of its means, divided once when it closes
+			double weightSoFar = 0.0;
+			double limit = total * kinverse(k(0.0) + 1.0);
+			double weight = _merged[0].weight, sum = _merged[0].mean * _merged[0].weight;
+			for (size_t i = 1; i < _merged.size(); ++i) {
+				const centroid& c = _merged[i];
+				if (weightSoFar + weight + c.weight <= limit) {
+					weight += c.weight;
+					sum += c.mean * c.weight;
+				}
+				else {
+					_centroids.push_back(centroid{ sum / weight, weight });
+					weightSoFar += weight;
+					limit = total * kinverse(k(weightSoFar / total) + 1.0);
+					weight = c.weight;
+					sum = c.mean * c.weight;
+				}
+			}
+			_centroids.push_back(centroid{ sum / weight, weight });
+		}
+	};
+
+	// histogram of the scales, floor(log2(|x|)), of a stream of values with a bucket per binade in [minScale, maxScale]
+	// for each sign, and counters for zeros, values below or above the range, infinities, and NaNs
+	class scale_histogram {
+	public:
+		scale_histogram(int minScale = -64, int maxScale = 64)
+			: _minScale{ minScale }, _maxScale{ maxScale }, _width{ size_t(maxScale - minScale + 1) }, _count(2 * _width, 0),
+			_zero{ 0 }, _underflow{ 0 }, _overflow{ 0 }, _inf{ 0 }, _nan{ 0 } {}
+
+		void push(double x) {
+			uint64_t bits;
+			std::memcpy(&bits, &x, sizeof(bits));
+			int biased = int((bits >> 52) & 0x7FF);
+			if (biased == 0x7FF) {
+				if (bits & 0x000F'FFFF'FFFF'FFFFull) ++_nan; else ++_inf;
+				return;
+			}
+			if ((bits << 1) == 0) { ++_zero; return; }
+			// the scale of a normal double is its biased exponent field, of a subnormal its ilogb
+			int scale = (biased != 0 ? biased - 1023 : std::ilogb(x));
+			if (scale < _minScale) ++_underflow;
+			else if (scale > _maxScale) ++_overflow;
+			else _count[size_t(bits >> 63) * _width + size_t(scale - _minScale)]++;
+		}
+		template<typename Iterator>
+		void push(Iterator first, Iterator last) { for (; first != last; ++first) push(double(*first)); }
+
+		// combine with the histogram of another part of the stream over the same range of scales
+		scale_histogram& merge(const scale_histogram& rhs) {
+			if (rhs._minScale != _minScale || rhs._maxScale != _maxScale) throw blas_exception("scale histograms of different ranges cannot be merged");
+			for (size_t i = 0; i < _count.size(); ++i) _count[i] += rhs._count[i];
+			_zero += rhs._zero;
+			_underflow += rhs._underflow;
+			_overflow += rhs._overflow;
+			_inf += rhs._inf;
+			_nan += rhs._nan;
+			return *this;
+		}
+
+		int minScale() const noexcept { return _minScale; }
+		int maxScale() const noexcept { return _maxScale; }
+		uint64_t positive(int scale) const { return (scale < _minScale || scale > _maxScale ? 0 : _count[size_t(scale - _minScale)]); }
+		uint64_t negative(int scale) const { return (scale < _minScale || scale > _maxScale ? 0 : _count[_width + size_t(scale - _minScale)]); }
+		uint64_t count(int scale) const { return positive(scale) + negative(scale); }
+		uint64_t zeros() const noexcept { return _zero; }
+		// values with a magnitude below 2^minScale, which a number system with that range flushes to zero
+		uint64_t underflow() const noexcept { return _underflow; }
+		// values with a magnitude of 2^(maxScale + 1) and above, which a number system with that range saturates
+		uint64_t overflow() const noexcept { return _overflow; }
+		uint64_t infinities() const noexcept { return _inf; }
+		uint64_t nans() const noexcept { return _nan; }
+		uint64_t total() const {
+			uint64_t t = _zero + _underflow + _overflow + _inf + _nan;
+			for (uint64_t c : _count) t += c;
+			return t;
+		}
+
+	private:
+		int _minScale, _maxScale;
+		size_t _width;
+		std::vector<uint64_t> _count;  // positive values by scale, followed by negative values by scale
+		uint64_t _zero, _underflow, _overflow, _inf, _nan;
+	};
+
+	// a scale histogram over the binades of the number system Scalar, from its smallest subnormal to its maxpos
+	template<typename Scalar>
+	scale_histogram make_scale_histogram() {
+		return scale_histogram(std::ilogb(double(std::numeric_limits<Scalar>::denorm_min())), std::ilogb(double(std::numeric_limits<Scalar>::max())));
+	}
+
+	// ostream operator: the occupied binades as rows of counts with a bar scaled to the fullest binade
+	inline std::ostream& operator<<(std::ostream& ostr, const scale_histogram& h) {
+		uint64_t fullest{ 1 };
+		for (int s = h.minScale(); s <= h.maxScale(); ++s) fullest = std::max(fullest, h.count(s));
+		ostr << "zero      : " << h.zeros() << "  underflow : " << h.underflow() << "  overflow : " << h.overflow()
+			<< "  inf : " << h.infinities() << "  nan : " << h.nans() << '\n';
+		for (int s = h.maxScale(); s >= h.minScale(); --s) {
+			if (h.count(s) == 0) continue;
+			ostr << "2^" << std::setw(6) << std::left << s << std::right << " : " << std::setw(10) << h.positive(s) << std::setw(10) << h.negative(s) << ' '
+				<< std::string(size_t(50 * h.count(s) / fullest), '*') << '\n';
+		}
+		return ostr;
+	}
+
+	// the moments, quantile sketch, and scale histogram of a data set in a single pass: each thread summarizes
+	// a contiguous chunk, and the summaries are merged in chunk order, so the result is reproducible for a
+	// given number of threads, and the moments agree across thread counts to within rounding
+	template<typename Scalar>
+	struct StreamingStats {
+		StreamingStats(double compression = 200.0, int minScale = -64, int maxScale = 64) : digest(compression), histogram(minScale, maxScale) {}
+
+		template<typename Value>
+		void push(const Value& x) {
+			moment.push(Scalar(x));
+			digest.push(double(x));
+			histogram.push(double(x));
+		}
+		StreamingStats& merge(const StreamingStats& rhs) {
+			moment.merge(rhs.moment);
+			digest.merge(rhs.digest);
+			histogram.merge(rhs.histogram);
+			return *this;
+		}
+
+		moments<Scalar> moment;
+		tdigest         digest;
+		scale_histogram histogram;
+	};
+
+	template<typename Vector>
+	StreamingStats<typename Vector::value_type> streamingStatistics(const Vector& data, unsigned nrThreads = 0, double compression = 200.0) {
+		using Scalar = typename Vector::value_type;
+		size_t N = size(data);
+		unsigned threads = blas_threads(N, nrThreads);
+		std::vector< StreamingStats<Scalar> > partials(threads, StreamingStats<Scalar>(compression));
+		parallel_for(0, N, [&](size_t first, size_t last, unsigned t) {
+			for (size_t i = first; i < last; ++i) partials[t].push(data[i]);
+		}, threads);
+		for (unsigned t = 1; t < threads; ++t) partials[0].merge(partials[t]);
+		return partials[0];
+	}
+
 	template<typename Scalar>
 	struct Quantiles {
 		Quantiles() = default;
@@ -25,13 +464,17 @@ namespace sw { namespace universal { namespace blas {
 			q[3] = q3;
 			q[4] = q4;
 		}
+		// min, quartiles, and max of a quantile sketch
+		void set(const tdigest& digest) {
+			set(Scalar(digest.min()), Scalar(digest.quantile(0.25)), Scalar(digest.quantile(0.5)), Scalar(digest.quantile(0.75)), Scalar(digest.max()));
+		}
 		Scalar q[5];
 	};
 
 	template<typename Scalar>
 	std::ostream& operator<<(std::ostream& ostr, const Quantiles<Scalar>& quantiles) {
 		ostr << "quantiles: ";
-		ostr << " [ " 
+		ostr << " [ "
 			<< quantiles.q[0] << ", "
 			<< quantiles.q[1] << ", "
 			<< quantiles.q[2] << ", "
@@ -58,56 +501,51 @@ namespace sw { namespace universal { namespace blas {
 		return ostr;
 	}
 
+	// min, quartiles, and max as the order statistics v[0], v[N/4], v[N/2], v[3N/4], and v[N-1] of a sorted copy
+	// of the data, with NaN ordered before all other values
 	template<typename Vector>
-	SummaryStats<typename Vector::value_type> summaryStatistics(const Vector& data) {
+	Quantiles<typename Vector::value_type> orderStatistics(const Vector& data) {
 		using std::isnan;
-		using std::sqrt;
 		using Scalar = typename Vector::value_type;
-		SummaryStats<Scalar> stats;
 		size_t N = size(data);
-		Scalar sum{0};
-		for (auto e : data) {
-			sum += e;
-		}
-		stats.mean = sum / Scalar(N);
-		sum = 0.0;
-		for (auto e : data) {
-			Scalar s = (e - stats.mean);
-			sum += s*s;
-		}
-		stats.stddev = sqrt(sum / Scalar(N - 1)); // use sample statistics formula
-					      //
 		Vector v(data); // create a copy you can sort
-		std::sort(v.begin(), v.end(), 
+		std::sort(v.begin(), v.end(),
 			[](const Scalar& a, const Scalar& b) {
 				// making NaN smaller than any other value
 				if (isnan(a) && !isnan(b)) return true;
 				if (!isnan(a) && isnan(b)) return false;
 				return a < b; // this assumes a reasonable interpretation of NaN < NaN
 			});
-		stats.quantiles.set(v[0],       // min
-							v[N/4],     // first quartile
-							v[N/2],     // second quartile
-							v[(3*N)/4], // third quartile
-							v[N-1]);    // max
-		return stats;
+		return Quantiles<Scalar>(v[0], v[N / 4], v[N / 2], v[(3 * N) / 4], v[N - 1]);
 	}
 
+	// mean, sample standard deviation, and the min, quartiles, and max, in one pass over the data without a copy.
+	// A data set that fits in the buffer of the t-digest reports the order statistics of orderStatistics, as the
+	// digest holds those values exactly; a larger data set reports the t-digest estimates of the quartiles,
+	// which interpolate between values, with the exact min and max
 	template<typename Vector>
-	Quantiles<typename Vector::value_type> quantiles(const Vector& data) {
-		using std::isnan;
+	SummaryStats<typename Vector::value_type> summaryStatistics(const Vector& data, unsigned nrThreads = 0) {
 		using Scalar = typename Vector::value_type;
+		StreamingStats<Scalar> streaming = streamingStatistics(data, nrThreads);
+		SummaryStats<Scalar> stats;
+		stats.mean = streaming.moment.mean();
+		stats.stddev = streaming.moment.stddev();
 		size_t N = size(data);
-		Vector v(data); // create a copy you can sort
-		std::sort(v.begin(), v.end(),
-			[](const Scalar& a, const Scalar& b) {
-				// making NaN smaller than any other value
-				if (isnan(a) && !isnan(b)) return true;
-				if (!isnan(a) && isnan(b)) return false;
-				return a < b; // this assumes a reasonable interpretation of NaN < NaN
-			});
+		if (N > 0 && N < streaming.digest.buffer_capacity()) stats.quantiles = orderStatistics(data);
+		else stats.quantiles.set(streaming.digest);
+		return stats;
+	}
 
-		Quantiles<Scalar> quantiles(v[0], v[N/4], v[N/2], v[(3*N)/4], v[N-1]);
+	// min, quartiles, and max: the order statistics of a data set that fits in the buffer of a t-digest,
+	// and the t-digest estimates of a larger data set, in one pass over the data without a copy
+	template<typename Vector>
+	Quantiles<typename Vector::value_type> quantiles(const Vector& data) {
+		tdigest digest;
+		size_t N = size(data);
+		if (N > 0 && N < digest.buffer_capacity()) return orderStatistics(data);
+		for (size_t i = 0; i < N; ++i) digest.push(double(data[i]));
+		Quantiles<typename Vector::value_type> quantiles;
+		quantiles.set(digest);
 		return quantiles;
 	}
 
@@ -0,0 +1,206 @@
+#pragma once
+// stencil.hpp: matrix-free constant coefficient stencil operators on 2D and 3D grids
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <cstddef>
+#include <vector>
+#include <universal/blas/vector.hpp>
+#include <universal/blas/execution.hpp>
+
+namespace sw { namespace universal { namespace blas {
+
+/*
+ * A stencil is the operator of a finite difference equation on the interior points of a regular
+ * nx x ny x nz grid with Dirichlet boundary conditions: the boundary values are folded into the
+ * right-hand side, and the unknown of grid point (x, y, z) is row (z * ny + y) * nx + x.
+ * The 5-point (2D) and 7-point (3D) star stencils are
+ *     (A u)(x, y, z) = d u(x, y, z) + ox (u(x-1) + u(x+1)) + oy (u(y-1) + u(y+1)) + oz (u(z-1) + u(z+1))
+ * Only the coefficients are stored, so a 4096 x 4096 grid takes the memory of its vectors.
+ *
+ * The stencil offers the interface of a matrix to the solvers: num_rows, num_cols, element access,
+ * and the product with a vector, as operator* and as matvec(policy, b, A, x). The products and the relaxation sweeps traverse the grid in tiles of
+ * lines that fit in cache, and distribute the tiles across threads. The Jacobi sweep reads the previous
+ * iterate, and the red-black sweeps update the points of one color from the points of the other color,
+ * so both produce the same result on any number of threads.
+ */
+template<typename Scalar>
+class stencil {
+public:
+	using value_type = Scalar;
+	using size_type = size_t;
+
+	// number of consecutive points of a line, and of consecutive lines, in a tile
+	static constexpr size_t tile_points = 512;
+	static constexpr size_t tile_lines = 16;
+
+	stencil(size_t nx, size_t ny, size_t nz, const Scalar& diagonal, const Scalar& ox, const Scalar& oy, const Scalar& oz)
+		: _nx{ nx }, _ny{ ny }, _nz{ nz }, _d{ diagonal }, _ox{ ox }, _oy{ oy }, _oz{ oz } {}
+
+	size_t nx() const noexcept { return _nx; }
+	size_t ny() const noexcept { return _ny; }
+	size_t nz() const noexcept { return _nz; }
+	size_t rows() const noexcept { return _nx * _ny * _nz; }
+	size_t cols() const noexcept { return rows(); }
+	const Scalar& diagonal() const noexcept { return _d; }
+
+	// matrix element of the operator
+	Scalar operator()(size_t row, size_t col) const {
+		if (row == col) return _d;
+		size_t lo = (row < col ? row : col), hi = (row < col ? col : row);
+		size_t x = lo % _nx, y = (lo / _nx) % _ny;
+		if (hi - lo == 1 && x + 1 < _nx) return _ox;
+		if (hi - lo == _nx && y + 1 < _ny) return _oy;
+		if (hi - lo == _nx * _ny) return _oz;
+		return Scalar(0);
+	}
+
+	// y = A x: each row sums its terms in column order, as the dense product of the equivalent matrix
+	template<typename Allocator>
+	void matvec(const vector<Scalar, Allocator>& x, vector<Scalar, Allocator>& y, unsigned nrThreads = 0) const {
+		if (y.size() != rows()) y.resize(rows());
+		traverse([&](size_t row, size_t px, size_t py, size_t pz) {
+			Scalar sum(0);
+			if (pz > 0) sum += _oz * x[row - _nx * _ny];
+			if (py > 0) sum += _oy * x[row - _nx];
+			if (px > 0) sum += _ox * x[row - 1];
+			sum += _d * x[row];
+			if (px + 1 < _nx) sum += _ox * x[row + 1];
+			if (py + 1 < _ny) sum += _oy * x[row + _nx];
+			if (pz + 1 < _nz) sum += _oz * x[row + _nx * _ny];
+			y[row] = sum;
+		}, nrThreads);
+	}
+
+	// one Jacobi sweep xnew = x + omega D^-1 (b - A x): returns the largest absolute update
+	Scalar jacobi_sweep(const vector<Scalar>& b, const vector<Scalar>& x, vector<Scalar>& xnew, const Scalar& omega = Scalar(1), unsigned nrThreads = 0) const {
+		if (xnew.size() != rows()) xnew = vector<Scalar>(rows());
+		return traverse_max([&](size_t row, size_t px, size_t py, size_t pz) {
+			xnew[row] = relax(b, x, row, px, py, pz, omega);
+			return xnew[row] - x[row];
+		}, 2, nrThreads);
+	}
+
+	// one red-black sweep, updating in place first the points with even x + y + z and then the points with odd x + y + z:
+	// omega = 1 is Gauss-Seidel, 1 < omega < 2 is successive over-relaxation. Returns the largest absolute update
+	Scalar red_black_sweep(const vector<Scalar>& b, vector<Scalar>& x, const Scalar& omega = Scalar(1), unsigned nrThreads = 0) const {
+		Scalar red = traverse_max([&](size_t row, size_t px, size_t py, size_t pz) {
+			Scalar value = relax(b, x, row, px, py, pz, omega);
+			Scalar update = value - x[row];
+			x[row] = value;
+			return update;
+		}, 0, nrThreads);
+		Scalar black = traverse_max([&](size_t row, size_t px, size_t py, size_t pz) {
+			Scalar value = relax(b, x, row, px, py, pz, omega);
+			Scalar update = value - x[row];
+			x[row] = value;
+			return update;
+		}, 1, nrThreads);
+		return (red < black ? black : red);
+	}
+
+private:
+	size_t _nx, _ny, _nz;
+	Scalar _d, _ox, _oy, _oz;
+
+	// relaxed value of a point: the value that satisfies its equation given its neighbors, x + omega (value - x) when omega != 1
+	Scalar relax(const vector<Scalar>& b, const vector<Scalar>& x, size_t row, size_t px, size_t py, size_t pz, const Scalar& omega) const {
+		Scalar sigma(0);
+		if (pz > 0) sigma += _oz * x[row - _nx * _ny];
+		if (py > 0) sigma += _oy * x[row - _nx];
+		if (px > 0) sigma += _ox * x[row - 1];
+		if (px + 1 < _nx) sigma += _ox * x[row + 1];
+		if (py + 1 < _ny) sigma += _oy * x[row + _nx];
+		if (pz + 1 < _nz) sigma += _oz * x[row + _nx * _ny];
+		Scalar value = (b[row] - sigma) / _d;
+		return (omega == Scalar(1) ? value : x[row] + omega * (value - x[row]));
+	}
+
+	size_t line_tiles() const noexcept { return (_ny * _nz + tile_lines - 1) / tile_lines; }
+	size_t point_tiles() const noexcept { return (_nx + tile_points - 1) / tile_points; }
+
+	// visit the points of tile t, restricted to one color when color is 0 or 1
+	template<typename PointFunction>
+	void visit_tile(size_t t, PointFunction& f, unsigned color) const {
+		size_t nrLines = _ny * _nz;
+		size_t lineTile = t / point_tiles(), pointTile = t % point_tiles();
+		size_t firstLine = lineTile * tile_lines;
+		size_t lastLine = (firstLine + tile_lines < nrLines ? firstLine + tile_lines : nrLines);
+		size_t firstPoint = pointTile * tile_points;
+		size_t lastPoint = (firstPoint + tile_points < _nx ? firstPoint + tile_points : _nx);
+		for (size_t line = firstLine; line < lastLine; ++line) {
+			size_t py = line % _ny, pz = line / _ny;
+			size_t px = firstPoint;
+			size_t step = 1;
+			if (color < 2) {
+				if (((px + py + pz) & 1) != color) ++px;
+				step = 2;
+			}
+			for (; px < lastPoint; px += step) f(line * _nx + px, px, py, pz);
+		}
+	}
+
+	template<typename PointFunction>
+	void traverse(PointFunction&& f, unsigned nrThreads) const {
+		size_t nrTiles = line_tiles() * point_tiles();
+		parallel_for(0, nrTiles, [&](size_t first, size_t last, unsigned) {
+			for (size_t t = first; t < last; ++t) visit_tile(t, f, 2);
+		}, blas_threads(7 * rows(), nrThreads));
+	}
+
+	// traverse the points of a color, or all points for color 2, and return the largest absolute value of f
+	template<typename PointFunction>
+	Scalar traverse_max(PointFunction&& f, unsigned color, unsigned nrThreads) const {
+		size_t nrTiles = line_tiles() * point_tiles();
+		unsigned threads = blas_threads(7 * rows(), nrThreads);
+		std::vector<Scalar> partials(threads, Scalar(0));
+		parallel_for(0, nrTiles, [&](size_t first, size_t last, unsigned tid) {
+			Scalar largest(0);
+			auto g = [&](size_t row, size_t px, size_t py, size_t pz) {
+				Scalar v = f(row, px, py, pz);
+				if (v < Scalar(0)) v = -v;
+				if (largest < v) largest = v;
+			};
+			for (size_t t = first; t < last; ++t) visit_tile(t, g, color);
+			partials[tid] = largest;
+		}, threads);
+		Scalar largest(0);
+		for (const Scalar& v : partials) if (largest < v) largest = v;
+		return largest;
+	}
+};
+
+// 5-point Laplacian of an m x n grid, the matrix-free equivalent of laplace2D(A, m, n)
+template<typename Scalar>
+stencil<Scalar> laplace_stencil(size_t m, size_t n) {
+	return stencil<Scalar>(n, m, 1, Scalar(4), Scalar(-1), Scalar(-1), Scalar(0));
+}
+
+// 7-point Laplacian of an l x m x n grid
+template<typename Scalar>
+stencil<Scalar> laplace_stencil(size_t l, size_t m, size_t n) {
+	return stencil<Scalar>(n, m, l, Scalar(6), Scalar(-1), Scalar(-1), Scalar(-1));
+}
+
+template<typename Scalar>
+inline size_t num_rows(const stencil<Scalar>& A) { return A.rows(); }
+template<typename Scalar>
+inline size_t num_cols(const stencil<Scalar>& A) { return A.cols(); }
+
+template<typename Scalar, typename Allocator>
+vector<Scalar, Allocator> operator*(const stencil<Scalar>& A, const vector<Scalar, Allocator>& x) {
+	vector<Scalar, Allocator> y(A.rows());
+	A.matvec(x, y);
+	return y;
+}
+
+// b = A x under an execution policy: the solvers written against matvec(policy, b, A, x) visit the
+// points of the stencil and not the elements of the equivalent dense matrix
+template<typename Scalar, typename Allocator>
+void matvec(ExecutionPolicy policy, vector<Scalar, Allocator>& b, const stencil<Scalar>& A, const vector<Scalar, Allocator>& x, unsigned nrThreads = 0) {
+	A.matvec(x, b, (policy == ExecutionPolicy::Serial ? 1u : nrThreads));
+}
+
+}}} // namespace sw::universal::blas
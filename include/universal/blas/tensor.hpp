@@ -1,15 +1,22 @@
 #pragma once
-// tensor.hpp: super-simple dense tensor class implementation
+// tensor.hpp: dense rank-N tensor with shape and stride metadata, non-owning strided views, and fused elementwise operators
 //
 // Copyright (C) 2017 Stillwater Supercomputing, Inc.
 // SPDX-License-Identifier: MIT
 //
 // This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <array>
+#include <cstddef>
 #include <iostream>
+#include <iomanip>
+#include <sstream>
 #include <vector>
 #include <initializer_list>
-#include <map>
+#include <tuple>
+#include <type_traits>
+#include <utility>
 #include <universal/blas/exceptions.hpp>
+#include <universal/blas/execution.hpp>
 
 #if defined(__clang__)
 /* Clang/LLVM. ---------------------------------------------- */
@@ -51,223 +58,422 @@
 #define _NODISCARD
 #endif // _HAS_NODISCARD
 
-namespace sw { namespace universal { namespace blas { 
+namespace sw { namespace universal { namespace blas {
+
+/*
+ A tensor owns a row-major array of elements, described by a shape, the extent of each dimension, and
+ the strides, the distance in elements between consecutive indices of each dimension. A tensor_view
+ is the same description on borrowed storage: slicing, selecting, permuting, reshaping, and broadcasting
+ a view only rewrite its shape, strides, and base pointer, and never copy elements. Views alias the
+ tensor they are taken from and are invalidated when that tensor is resized or destroyed.
+
+   tensor<float> T({ 2, 3, 4 });
+   auto S = T.view().slice(2, 1, 3);       // T(:, :, 1:3), writes through S update T
+   auto P = T.view().permute({ 2, 0, 1 }); // P(k, i, j) = T(i, j, k)
+   tensor<float> C(P);                     // materialize P as a row-major tensor
+*/
+
+using tensor_shape   = std::vector<size_t>;
+using tensor_strides = std::vector<std::ptrdiff_t>;
+
+inline std::string to_string(const tensor_shape& shape) {
+	std::stringstream ss;
+	ss << '(';
+	for (size_t d = 0; d < shape.size(); ++d) ss << (d > 0 ? ", " : "") << shape[d];
+	ss << ')';
+	return ss.str();
+}
+
+// number of elements of a tensor of the given shape
+inline size_t shape_size(const tensor_shape& shape) {
+	size_t n = 1;
+	for (size_t e : shape) n *= e;
+	return n;
+}
+
+// strides of a row-major tensor of the given shape
+inline tensor_strides row_major_strides(const tensor_shape& shape) {
+	tensor_strides strides(shape.size());
+	std::ptrdiff_t s = 1;
+	for (size_t d = shape.size(); d > 0; --d) {
+		strides[d - 1] = s;
+		s *= static_cast<std::ptrdiff_t>(shape[d - 1]);
+	}
+	return strides;
+}
+
+// call f(offsets) for every index of the shape in row-major order, where offsets[k] is the element offset
+// of the index in operand k: the innermost dimension runs as a strided loop, the outer dimensions as an odometer
+template<size_t N, typename Function>
+void strided_for_each(const tensor_shape& shape, const std::array<const std::ptrdiff_t*, N>& strides, Function&& f) {
+	std::array<std::ptrdiff_t, N> offsets{};
+	if (shape_size(shape) == 0) return;
+	if (shape.empty()) {
+		f(offsets);
+		return;
+	}
+	const size_t rank = shape.size();
+	const size_t inner = shape[rank - 1];
+	std::vector<size_t> index(rank, 0);
+	for (;;) {
+		std::array<std::ptrdiff_t, N> o = offsets;
+		for (size_t i = 0; i < inner; ++i) {
+			f(o);
+			for (size_t k = 0; k < N; ++k) o[k] += strides[k][rank - 1];
+		}
+		// advance the odometer of the outer dimensions
+		size_t d = rank - 1;
+		for (;;) {
+			if (d == 0) return;
+			--d;
+			++index[d];
+			for (size_t k = 0; k < N; ++k) offsets[k] += strides[k][d];
+			if (index[d] < shape[d]) break;
+			for (size_t k = 0; k < N; ++k) offsets[k] -= static_cast<std::ptrdiff_t>(index[d]) * strides[k][d];
+			index[d] = 0;
+		}
+	}
+}
 
+// non-owning strided view of a tensor, Scalar is const qualified for read-only views
 template<typename Scalar>
-class tensor {
+class tensor_view {
 public:
-	typedef Scalar									value_type;
-	typedef const value_type&						const_reference;
-	typedef value_type&								reference;
-	typedef const value_type*						const_pointer_type;
-	typedef typename std::vector<Scalar>::size_type size_type;
-	typedef typename std::vector<Scalar>::iterator     iterator;
-	typedef typename std::vector<Scalar>::const_iterator const_iterator;
-	typedef typename std::vector<Scalar>::reverse_iterator reverse_iterator;
-	typedef typename std::vector<Scalar>::const_reverse_iterator const_reverse_iterator;
-	static constexpr unsigned AggregationType = UNIVERSAL_AGGREGATE_TENSOR;
+	using value_type = std::remove_cv_t<Scalar>;
+	using pointer    = Scalar*;
+	using reference  = Scalar&;
 
-	tensor() : _m{ 0 }, _n{ 0 }, data(0) {}
-	tensor(unsigned m, unsigned n) : _m{ m }, _n{ n }, data(m*n, Scalar(0.0)) { }
-	tensor(std::initializer_list< std::initializer_list<Scalar> > values) {
-		unsigned nrows = values.size();
-		unsigned ncols = values.begin()->size();
-		data.resize(nrows * ncols);
-		unsigned r = 0;
-		for (auto l : values) {
-			if (l.size() == ncols) {
-				unsigned c = 0;
-				for (auto v : l) {
-					data[r*ncols + c] = v;
-					++c;
-				}
-				++r;
-			}
+	tensor_view() : _data{ nullptr }, _shape{}, _strides{} {}
+	tensor_view(Scalar* data, const tensor_shape& shape, const tensor_strides& strides) : _data{ data }, _shape(shape), _strides(strides) {}
+	tensor_view(Scalar* data, const tensor_shape& shape) : _data{ data }, _shape(shape), _strides(row_major_strides(shape)) {}
+
+	// a view is convertible to its read-only view
+	operator tensor_view<const Scalar>() const { return tensor_view<const Scalar>(_data, _shape, _strides); }
+
+	// selectors
+	unsigned rank() const noexcept { return static_cast<unsigned>(_shape.size()); }
+	const tensor_shape& shape() const noexcept { return _shape; }
+	size_t extent(unsigned dim) const { return _shape[dim]; }
+	const tensor_strides& strides() const noexcept { return _strides; }
+	std::ptrdiff_t stride(unsigned dim) const { return _strides[dim]; }
+	size_t size() const noexcept { return shape_size(_shape); }
+	Scalar* data() const noexcept { return _data; }
+	// true when the view enumerates a contiguous row-major block of elements
+	bool is_contiguous() const noexcept { return size() <= 1 || _strides == row_major_strides(_shape); }
+
+	template<typename... Indices>
+	reference operator()(Indices... indices) const {
+		std::ptrdiff_t offset{ 0 };
+		[[maybe_unused]] unsigned d{ 0 };
+		((offset += static_cast<std::ptrdiff_t>(indices) * _strides[d++]), ...);
+		return _data[offset];
+	}
+	reference at(const std::vector<size_t>& index) const {
+		if (index.size() != _shape.size()) throw tensor_incompatible_shapes("index of rank " + std::to_string(index.size()) + " into a tensor of shape " + to_string(_shape));
+		std::ptrdiff_t offset{ 0 };
+		for (size_t d = 0; d < index.size(); ++d) {
+			if (index[d] >= _shape[d]) throw tensor_incompatible_shapes("index out of bounds of a tensor of shape " + to_string(_shape));
+			offset += static_cast<std::ptrdiff_t>(index[d]) * _strides[d];
 		}
-		_m = nrows;
-		_n = ncols;
+		return _data[offset];
 	}
-	tensor(const tensor& A) : _m{ A._m }, _n{ A._n }, data(A.data) {}
 
-	// Converting Constructor (SourceType A --> Scalar B)
-	template<typename SourceType>
-	tensor(const tensor<SourceType>& A) : _m{ A.rows() }, _n{A.cols() }{
-		data.resize(_m*_n);
-		for (unsigned i = 0; i < _m; ++i){
-			for (unsigned j = 0; j < _n; ++j){
-				data[i*_n + j] = Scalar(A(i,j));
-			}
+	// the indices [first, last) with a step of dimension dim
+	tensor_view slice(unsigned dim, size_t first, size_t last, size_t step = 1) const {
+		if (dim >= rank() || first > last || last > _shape[dim] || step == 0) throw tensor_incompatible_shapes("slice [" + std::to_string(first) + ", " + std::to_string(last) + ") of dimension " + std::to_string(dim) + " of a tensor of shape " + to_string(_shape));
+		tensor_view v(*this);
+		v._data = _data + static_cast<std::ptrdiff_t>(first) * _strides[dim];
+		v._shape[dim] = (last - first + step - 1) / step;
+		v._strides[dim] = _strides[dim] * static_cast<std::ptrdiff_t>(step);
+		return v;
+	}
+	// the sub-tensor at index i of dimension dim, of one rank less
+	tensor_view select(unsigned dim, size_t i) const {
+		if (dim >= rank() || i >= _shape[dim]) throw tensor_incompatible_shapes("select of index " + std::to_string(i) + " of dimension " + std::to_string(dim) + " of a tensor of shape " + to_string(_shape));
+		tensor_view v(*this);
+		v._data = _data + static_cast<std::ptrdiff_t>(i) * _strides[dim];
+		v._shape.erase(v._shape.begin() + dim);
+		v._strides.erase(v._strides.begin() + dim);
+		return v;
+	}
+	// dimension d of the result is dimension axes[d] of this view
+	tensor_view permute(const std::vector<unsigned>& axes) const {
+		std::vector<bool> seen(rank(), false);
+		bool valid = (axes.size() == rank());
+		for (unsigned a : axes) {
+			if (!valid || a >= rank() || seen[a]) { valid = false; break; }
+			seen[a] = true;
+		}
+		if (!valid) throw tensor_incompatible_shapes("permutation of the dimensions of a tensor of shape " + to_string(_shape));
+		tensor_view v(*this);
+		for (size_t d = 0; d < axes.size(); ++d) {
+			v._shape[d] = _shape[axes[d]];
+			v._strides[d] = _strides[axes[d]];
+		}
+		return v;
+	}
+	// reverse the order of the dimensions
+	tensor_view transpose() const {
+		std::vector<unsigned> axes(rank());
+		for (unsigned d = 0; d < rank(); ++d) axes[d] = rank() - 1 - d;
+		return permute(axes);
+	}
+	// swap two dimensions
+	tensor_view transpose(unsigned dim0, unsigned dim1) const {
+		std::vector<unsigned> axes(rank());
+		for (unsigned d = 0; d < rank(); ++d) axes[d] = d;
+		if (dim0 >= rank() || dim1 >= rank()) throw tensor_incompatible_shapes("transpose of dimensions " + std::to_string(dim0) + " and " + std::to_string(dim1) + " of a tensor of shape " + to_string(_shape));
+		std::swap(axes[dim0], axes[dim1]);
+		return permute(axes);
+	}
+	// the same elements in row-major order under a new shape, which requires a contiguous view
+	tensor_view reshape(const tensor_shape& shape) const {
+		if (shape_size(shape) != size() || !is_contiguous()) throw tensor_incompatible_shapes("reshape of a " + std::string(is_contiguous() ? "" : "non-contiguous ") + "tensor of shape " + to_string(_shape) + " to " + to_string(shape));
+		return tensor_view(_data, shape);
+	}
+	// stretch dimensions of extent 1 to the extents of shape with a stride of 0, aligning the trailing dimensions
+	tensor_view broadcast(const tensor_shape& shape) const {
+		if (shape.size() < rank()) throw tensor_incompatible_shapes("broadcast of a tensor of shape " + to_string(_shape) + " to " + to_string(shape));
+		tensor_view v(_data, shape, tensor_strides(shape.size(), 0));
+		size_t lead = shape.size() - rank();
+		for (size_t d = 0; d < rank(); ++d) {
+			if (_shape[d] == shape[lead + d]) v._strides[lead + d] = _strides[d];
+			else if (_shape[d] != 1) throw tensor_incompatible_shapes("broadcast of a tensor of shape " + to_string(_shape) + " to " + to_string(shape));
 		}
+		return v;
 	}
 
+	// assign a value to all elements
+	const tensor_view& operator=(const value_type& value) const {
+		std::array<const std::ptrdiff_t*, 1> strides{ _strides.data() };
+		strided_for_each(_shape, strides, [&](const std::array<std::ptrdiff_t, 1>& o) { _data[o[0]] = value; });
+		return *this;
+	}
 
-	/* Operators
-	/ 	Binary and unitary operators, =,>,!=,...
-	*/
-	tensor& operator=(const tensor& M) = default;
-	tensor& operator=(tensor&& M) = default;
+private:
+	Scalar*        _data;
+	tensor_shape   _shape;
+	tensor_strides _strides;
+};
 
-	// Identity tensor operator
-	tensor& operator=(const Scalar& one) {
-		setzero();
-		unsigned smallestDimension = (_m < _n ? _m : _n);
-		for (unsigned i = 0; i < smallestDimension; ++i) data[i*_n + i] = one;
-		return *this;
+template<typename Scalar, typename Allocator = std::allocator<Scalar>>
+class tensor {
+public:
+	typedef Scalar									value_type;
+	typedef const value_type&						const_reference;
+	typedef value_type&								reference;
+	typedef const value_type*						const_pointer_type;
+	typedef typename std::vector<Scalar, Allocator>::size_type size_type;
+	typedef typename std::vector<Scalar, Allocator>::iterator     iterator;
+	typedef typename std::vector<Scalar, Allocator>::const_iterator const_iterator;
+	typedef typename std::vector<Scalar, Allocator>::reverse_iterator reverse_iterator;
+	typedef typename std::vector<Scalar, Allocator>::const_reverse_iterator const_reverse_iterator;
+	typedef Allocator                               allocator_type;
+	static constexpr unsigned AggregationType = UNIVERSAL_AGGREGATE_TENSOR;
+
+	tensor() : _shape{}, _strides{}, _data(1, Scalar(0)) {}
+	explicit tensor(const tensor_shape& shape, const Scalar& value = Scalar(0)) : _shape(shape), _strides(row_major_strides(shape)), _data(shape_size(shape), value) {}
+	tensor(const tensor_shape& shape, std::initializer_list<Scalar> values) : _shape(shape), _strides(row_major_strides(shape)), _data(values) {
+		if (_data.size() != shape_size(shape)) throw tensor_incompatible_shapes(std::to_string(values.size()) + " values for a tensor of shape " + to_string(shape));
 	}
+	tensor(const tensor&) = default;
+	tensor(tensor&&) = default;
 
-	Scalar operator()(unsigned i, unsigned j) const { return data[i*_n + j]; }
-	Scalar& operator()(unsigned i, unsigned j) { return data[i*_n + j]; }
-	RowProxy<Scalar> operator[](unsigned i) {
-		typename std::vector<Scalar>::iterator it = data.begin() + int64_t(i) * int64_t(_n);
-		RowProxy<Scalar> proxy(it);
-		return proxy;
+	// materialize a view, converting the elements (SourceType --> Scalar)
+	template<typename SourceType>
+	tensor(const tensor_view<SourceType>& v) : _shape(v.shape()), _strides(row_major_strides(v.shape())), _data(v.size()) {
+		std::array<const std::ptrdiff_t*, 1> strides{ v.strides().data() };
+		Scalar* p = _data.data();
+		const SourceType* s = v.data();
+		strided_for_each(_shape, strides, [&](const std::array<std::ptrdiff_t, 1>& o) { *p++ = Scalar(s[o[0]]); });
 	}
-	ConstRowProxy<Scalar> operator[](unsigned i) const {
-		typename std::vector<Scalar>::const_iterator it = data.begin() + static_cast<int64_t>(i * _n);
-		ConstRowProxy<Scalar> proxy(it);
-		return proxy;
+	// converting constructor (SourceType --> Scalar)
+	template<typename SourceType, typename SourceAllocator>
+	tensor(const tensor<SourceType, SourceAllocator>& A) : _shape(A.shape()), _strides(A.strides()), _data(A.size()) {
+		for (size_t e = 0; e < _data.size(); ++e) _data[e] = Scalar(A.data()[e]);
 	}
 
+	tensor& operator=(const tensor&) = default;
+	tensor& operator=(tensor&&) = default;
+
+	// selectors
+	unsigned rank() const noexcept { return static_cast<unsigned>(_shape.size()); }
+	const tensor_shape& shape() const noexcept { return _shape; }
+	size_t extent(unsigned dim) const { return _shape[dim]; }
+	const tensor_strides& strides() const noexcept { return _strides; }
+	size_t size() const noexcept { return _data.size(); }
+	Scalar* data() noexcept { return _data.data(); }
+	const Scalar* data() const noexcept { return _data.data(); }
+
+	template<typename... Indices>
+	Scalar& operator()(Indices... indices) { return _data[offset(indices...)]; }
+	template<typename... Indices>
+	const Scalar& operator()(Indices... indices) const { return _data[offset(indices...)]; }
+	Scalar& at(const std::vector<size_t>& index) { return view().at(index); }
+	const Scalar& at(const std::vector<size_t>& index) const { return view().at(index); }
+
+	// views
+	tensor_view<Scalar> view() { return tensor_view<Scalar>(_data.data(), _shape, _strides); }
+	tensor_view<const Scalar> view() const { return tensor_view<const Scalar>(_data.data(), _shape, _strides); }
+	operator tensor_view<Scalar>() { return view(); }
+	operator tensor_view<const Scalar>() const { return view(); }
+	tensor_view<Scalar> slice(unsigned dim, size_t first, size_t last, size_t step = 1) { return view().slice(dim, first, last, step); }
+	tensor_view<const Scalar> slice(unsigned dim, size_t first, size_t last, size_t step = 1) const { return view().slice(dim, first, last, step); }
+	tensor_view<Scalar> select(unsigned dim, size_t i) { return view().select(dim, i); }
+	tensor_view<const Scalar> select(unsigned dim, size_t i) const { return view().select(dim, i); }
+	tensor_view<Scalar> permute(const std::vector<unsigned>& axes) { return view().permute(axes); }
+	tensor_view<const Scalar> permute(const std::vector<unsigned>& axes) const { return view().permute(axes); }
+	tensor_view<Scalar> transpose() { return view().transpose(); }
+	tensor_view<const Scalar> transpose() const { return view().transpose(); }
+	tensor_view<Scalar> reshape(const tensor_shape& shape) { return view().reshape(shape); }
+	tensor_view<const Scalar> reshape(const tensor_shape& shape) const { return view().reshape(shape); }
+
 	// tensor element-wise sum
 	tensor& operator+=(const tensor& rhs) {
-		// check if the matrices are compatible
-		if (_m != rhs._m || _n != rhs._n) {
-			std::cerr << "Element-wise tensor sum received incompatible matrices ("
-				<< _m << ", " << _n << ") += (" << rhs._m << ", " << rhs._n << ")\n";
-			return *this; // return without changing
-		}
-		for (size_type e = 0; e < _m * _n; ++e) {
-			data[e] += rhs.data[e];
-		}
+		if (_shape != rhs._shape) throw tensor_incompatible_shapes(to_string(_shape) + " += " + to_string(rhs._shape));
+		for (size_type e = 0; e < _data.size(); ++e) _data[e] += rhs._data[e];
 		return *this;
 	}
 	// tensor element-wise difference
 	tensor& operator-=(const tensor& rhs) {
-		// check if the matrices are compatible
-		if (_m != rhs._m || _n != rhs._n) {
-			std::cerr << "Element-wise tensor difference received incompatible matrices ("
-				<< _m << ", " << _n << ") -= (" << rhs._m << ", " << rhs._n << ")\n";
-			return *this; // return without changing
-		}
-		for (size_type e = 0; e < _m*_n; ++e) {
-			data[e] -= rhs.data[e];
-		}
+		if (_shape != rhs._shape) throw tensor_incompatible_shapes(to_string(_shape) + " -= " + to_string(rhs._shape));
+		for (size_type e = 0; e < _data.size(); ++e) _data[e] -= rhs._data[e];
 		return *this;
 	}
-
 	// multiply all tensor elements
 	tensor& operator*=(const Scalar& a) {
-		using size_type = typename tensor<Scalar>::size_type;
-		for (size_type e = 0; e < _m*_n; ++e) {
-			data[e] *= a;
-		}
+		for (auto& e : _data) e *= a;
 		return *this;
 	}
 	// divide all tensor elements
 	tensor& operator/=(const Scalar& a) {
-		using size_type = typename tensor<Scalar>::size_type;
-		for (size_type e = 0; e < _m * _n; ++e) {
-			data[e] /= a;
-		}
+		for (auto& e : _data) e /= a;
 		return *this;
 	}
 
 	// modifiers
-	inline void setzero() { for (auto& elem : data) elem = Scalar(0); }
-	inline void resize(unsigned m, unsigned n) { _m = m; _n = n; data.resize(m * n); }
-	// selectors
-	inline unsigned rows() const { return _m; }
-	inline unsigned cols() const { return _n; }
-	inline std::pair<unsigned, unsigned> size() const { return std::make_pair(_m, _n); }
-
-	// in-place transpose
-	tensor& transpose() {
-		unsigned size = _m * _n - 1;
-		std::map<unsigned, bool> b; // mark visits
-		b[0] = true; // A(0,0) is stationary
-		b[size] = true; // A(m-1,n-1) is stationary
-		unsigned index = 1;
-		while (index < size) {
-			unsigned cycleStart = index; // holds start of cycle
-			Scalar e = data[index]; // holds value of the element to be swapped
-			do {
-				unsigned next = (index * _m) % size; // index of e
-				std::swap(data[next], e);
-				b[index] = true;
-				index = next;
-			} while (index != cycleStart);
-			// get the starting point of the next cycle
-			for (index = 1; index < size && b[index]; ++index) {}
-		}
-		std::swap(_m, _n);
-		return *this;
-	}
+	inline void setzero() { for (auto& elem : _data) elem = Scalar(0); }
+	// a new shape invalidates all views of the tensor
+	inline void resize(const tensor_shape& shape) { _shape = shape; _strides = row_major_strides(shape); _data.resize(shape_size(shape)); }
+
+	// iterators over the elements in row-major order
+	_NODISCARD iterator begin() noexcept { return _data.begin(); }
+	_NODISCARD const_iterator begin() const noexcept { return _data.begin(); }
+	_NODISCARD iterator end() noexcept { return _data.end(); }
+	_NODISCARD const_iterator end() const noexcept { return _data.end(); }
+	_NODISCARD reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+	_NODISCARD const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+	_NODISCARD reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+	_NODISCARD const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
 
-	// Eigen operators I need to reverse engineer
-	tensor Zero(unsigned m, unsigned n) {
-		tensor z(m, n);
-		return z;
-	}
-
-	// iterators
-	_NODISCARD iterator begin() noexcept {
-		return data.begin();
+private:
+	tensor_shape   _shape;
+	tensor_strides _strides;
+	std::vector<Scalar, Allocator> _data;
+
+	template<typename... Indices>
+	size_t offset(Indices... indices) const {
+		std::ptrdiff_t offset{ 0 };
+		[[maybe_unused]] unsigned d{ 0 };
+		((offset += static_cast<std::ptrdiff_t>(indices) * _strides[d++]), ...);
+		return static_cast<size_t>(offset);
 	}
+};
 
-	_NODISCARD const_iterator begin() const noexcept {
-		return data.begin();
-	}
+// the view of a tensor or a view, to write the free functions once for both
+template<typename Scalar, typename Allocator>
+tensor_view<const Scalar> as_view(const tensor<Scalar, Allocator>& A) { return A.view(); }
+template<typename Scalar, typename Allocator>
+tensor_view<Scalar> as_view(tensor<Scalar, Allocator>& A) { return A.view(); }
+template<typename Scalar>
+tensor_view<Scalar> as_view(const tensor_view<Scalar>& v) { return v; }
 
-	_NODISCARD iterator end() noexcept {
-		return data.end();
-	}
+template<typename Scalar, typename Allocator>
+inline size_t size(const tensor<Scalar, Allocator>& A) { return A.size(); }
 
-	_NODISCARD const_iterator end() const noexcept {
-		return data.end();
-	}
+// ostream operator: the elements of the innermost dimension on a line, a blank line between the matrices
+template<typename Scalar>
+std::ostream& operator<<(std::ostream& ostr, const tensor_view<Scalar>& v) {
+	auto width = ostr.width();
+	if (v.rank() == 0) return ostr << std::setw(width) << v.data()[0] << '\n';
+	std::array<const std::ptrdiff_t*, 1> strides{ v.strides().data() };
+	size_t inner = v.extent(v.rank() - 1), matrix = (v.rank() > 1 ? inner * v.extent(v.rank() - 2) : 0), count{ 0 };
+	strided_for_each(v.shape(), strides, [&](const std::array<std::ptrdiff_t, 1>& o) {
+		ostr << std::setw(width) << v.data()[o[0]] << ' ';
+		++count;
+		if (count % inner == 0) ostr << '\n';
+		if (matrix > 0 && count % matrix == 0 && count < v.size()) ostr << '\n';
+	});
+	return ostr;
+}
+template<typename Scalar, typename Allocator>
+std::ostream& operator<<(std::ostream& ostr, const tensor<Scalar, Allocator>& A) {
+	return ostr << A.view();
+}
 
-	_NODISCARD reverse_iterator rbegin() noexcept {
-		return reverse_iterator(end());
-	}
+////////////////////////////////////////////////////////////////////////////////////////////
+// fused elementwise operators
+//
+// A chain of elementwise operators, such as the bias, scale, and activation that follow a layer,
+// expressed as one function of the element values runs as a single pass over the index space
+// of the operands: no temporary tensors and a single read of every operand element.
+//
+//   auto Y = elementwise([](float x, float b, float s) { return std::max(0.0f, (x + b) * s); }, X, B.broadcast(X.shape()), S);
 
-	_NODISCARD const_reverse_iterator rbegin() const noexcept {
-		return const_reverse_iterator(end());
+namespace detail {
+	template<typename V>
+	void check_shape(const tensor_shape& shape, const V& v) {
+		if (v.shape() != shape) throw tensor_incompatible_shapes("elementwise operands of shapes " + to_string(shape) + " and " + to_string(v.shape()));
 	}
+}
 
-	_NODISCARD reverse_iterator rend() noexcept {
-		return reverse_iterator(begin());
+namespace detail {
+	template<typename OutScalar, typename Op, typename Views, size_t... Is>
+	void elementwise_into(const tensor_view<OutScalar>& out, Op& op, const Views& views, std::index_sequence<Is...>) {
+		std::array<const std::ptrdiff_t*, sizeof...(Is) + 1> strides{ out.strides().data(), std::get<Is>(views).strides().data()... };
+		OutScalar* o = out.data();
+		strided_for_each(out.shape(), strides, [&](const std::array<std::ptrdiff_t, sizeof...(Is) + 1>& offsets) {
+			o[offsets[0]] = op(std::get<Is>(views).data()[offsets[Is + 1]]...);
+		});
 	}
-
-	_NODISCARD const_reverse_iterator rend() const noexcept {
-		return const_reverse_iterator(begin());
+	template<typename Scalar, typename Op, typename Reduce, typename Views, size_t... Is>
+	Scalar elementwise_reduce(Op& op, Reduce& reduce, Scalar init, const Views& views, std::index_sequence<Is...>) {
+		std::array<const std::ptrdiff_t*, sizeof...(Is)> strides{ std::get<Is>(views).strides().data()... };
+		strided_for_each(std::get<0>(views).shape(), strides, [&](const std::array<std::ptrdiff_t, sizeof...(Is)>& offsets) {
+			init = reduce(init, op(std::get<Is>(views).data()[offsets[Is]]...));
+		});
+		return init;
 	}
+}
 
-private:
-	unsigned _m, _n; // m rows and n columns
-	std::vector<Scalar> data;
-
-};
+// out(i) = op(operands(i)...) for all indices i of out, in a single pass over the operands
+template<typename OutScalar, typename Op, typename... Operands>
+void elementwise_into(const tensor_view<OutScalar>& out, Op&& op, const Operands&... operands) {
+	auto views = std::make_tuple(as_view(operands)...);
+	std::apply([&](const auto&... v) { (detail::check_shape(out.shape(), v), ...); }, views);
+	detail::elementwise_into(out, op, views, std::index_sequence_for<Operands...>{});
+}
+template<typename OutScalar, typename Allocator, typename Op, typename... Operands>
+void elementwise_into(tensor<OutScalar, Allocator>& out, Op&& op, const Operands&... operands) {
+	elementwise_into(out.view(), std::forward<Op>(op), operands...);
+}
 
-template<typename Scalar>
-inline unsigned num_rows(const tensor<Scalar>& A) { return A.rows(); }
-template<typename Scalar>
-inline unsigned num_cols(const tensor<Scalar>& A) { return A.cols(); }
-template<typename Scalar>
-inline std::pair<unsigned, unsigned> size(const tensor<Scalar>& A) { return A.size(); }
+// the tensor of op(operands(i)...), of the shape of the first operand
+template<typename Op, typename First, typename... Operands>
+auto elementwise(Op&& op, const First& first, const Operands&... operands) {
+	using Scalar = std::remove_cv_t<std::invoke_result_t<Op, typename decltype(as_view(first))::value_type, typename decltype(as_view(operands))::value_type...>>;
+	tensor<Scalar> result(as_view(first).shape());
+	elementwise_into(result.view(), std::forward<Op>(op), first, operands...);
+	return result;
+}
 
-// ostream operator: no need to declare as friend as it only uses public interfaces
-template<typename Scalar>
-std::ostream& operator<<(std::ostream& ostr, const tensor<Scalar>& A) {
-	auto width = ostr.width();
-	unsigned m = A.rows();
-	unsigned n = A.cols();
-	for (unsigned i = 0; i < m; ++i) {
-		for (unsigned j = 0; j < n; ++j) {
-			ostr << std::setw(width) << A(i, j) << " ";
-		}
-		ostr << '\n';
-	}
-	return ostr;
+// reduce(... reduce(reduce(init, op(operands(i0)...)), op(operands(i1)...)) ...) over the indices in row-major order,
+// the fusion of an elementwise operator and the reduction of its result, as in a squared distance or a masked sum
+template<typename Scalar, typename Op, typename Reduce, typename First, typename... Operands>
+Scalar elementwise_reduce(Op&& op, Reduce&& reduce, Scalar init, const First& first, const Operands&... operands) {
+	auto views = std::make_tuple(as_view(first), as_view(operands)...);
+	std::apply([&](const auto&... v) { (detail::check_shape(std::get<0>(views).shape(), v), ...); }, views);
+	return detail::elementwise_reduce(op, reduce, init, views, std::index_sequence_for<First, Operands...>{});
 }
 
 // tensor element-wise sum
@@ -298,158 +504,25 @@ tensor<Scalar> operator/(const tensor<Scalar>& A, const Scalar& b) {
 	return B /= b;
 }
 
- 
-// tensor-vector multiply
-template<typename Scalar>
-vector<Scalar> operator*(const tensor<Scalar>& A, const vector<Scalar>& x) {
-	vector<Scalar> b(A.rows());
-	for (unsigned i = 0; i < A.rows(); ++i) {
-		b[i] = Scalar(0);
-		for (unsigned j = 0; j < A.cols(); ++j) {
-			b[i] += A(i, j) * x[j];
-		}
-	}
-	return b;
-}
-
-template<typename Scalar>
-tensor<Scalar> operator*(const tensor<Scalar>& A, const tensor<Scalar>& B) {
-	if (A.cols() != B.rows()) throw matmul_incompatible_matrices(incompatible_matrices(A.rows(), A.cols(), B.rows(), B.cols(), "*").what());
-	unsigned rows = A.rows();
-	unsigned cols = B.cols();
-	unsigned dots = A.cols();
-	tensor<Scalar> C(rows, cols);
-	for (unsigned i = 0; i < rows; ++i) {
-		for (unsigned j = 0; j < cols; ++j) {
-			Scalar e = Scalar(0);
-			for (unsigned k = 0; k < dots; ++k) {
-				e += A(i, k) * B(k, j);
-			}
-			C(i, j) = e;
-		}
-	}
-	return C;
-}
-
-
-
-
+// Hadamard product A.*B, element-wise multiplication
 template<typename Scalar>
 tensor<Scalar> operator%(const tensor<Scalar>& A, const tensor<Scalar>& B) {
-	// Hadamard Product A.*B.  Element-wise multiplication.
-	if (A.size() != B.size()) throw matmul_incompatible_matrices(incompatible_matrices(A.rows(), A.cols(), B.rows(), B.cols(), "%").what());
-	unsigned rows = A.rows();
-	unsigned cols = A.cols();
-	 
-	tensor<Scalar> C(rows, cols);
-	for (unsigned i = 0; i < rows; ++i) {
-		for (unsigned j = 0; j < cols; ++j) {
-			C(i, j) = A(i, j) * B(i, j);
-		}
-	}
-	return C;
+	return elementwise([](const Scalar& a, const Scalar& b) { return Scalar(a * b); }, A, B);
 }
 
-
 // tensor equivalence tests
 template<typename Scalar>
 bool operator==(const tensor<Scalar>& A, const tensor<Scalar>& B) {
-	if (num_rows(A) != num_rows(B) ||
-		num_cols(A) != num_cols(B)) return false;
-	bool equal = true;
-	for (unsigned i = 0; i < num_rows(A); ++i) {
-		for (unsigned j = 0; j < num_cols(A); ++j) {
-			if (A(i, j) != B(i, j)) {
-				equal = false;
-				break;
-			}
-		}
-		if (!equal) break;
+	if (A.shape() != B.shape()) return false;
+	for (size_t e = 0; e < A.size(); ++e) {
+		if (A.data()[e] != B.data()[e]) return false;
 	}
-	return equal;
+	return true;
 }
 
-
-
 template<typename Scalar>
 bool operator!=(const tensor<Scalar>& A, const tensor<Scalar>& B) {
 	return !(A == B);
 }
 
-
-
-// Matrix > x ==> Matrix with 1/0 representing True/False
-template<typename Scalar>
-tensor<Scalar> operator>(const tensor<Scalar>& A, const Scalar& x) {
-	tensor<Scalar> B(A.cols(), A.rows());
-	
-	for (unsigned i = 0; i < num_rows(A); ++i) {
-		for (unsigned j = 0; j < num_cols(A); ++j) {
-			B(i,j) = (A(i, j) > x) ? 1 : 0;
-		}
-	}
-	return B;
-}
- 
-
-// maxelement (jq 2022-10-15)
-template<typename Scalar>
-Scalar maxelement(const tensor<Scalar>&A) {
-	auto x = abs(A(0,0));
-	for (size_t i = 0; i < num_rows(A); ++i) {
-		for (size_t j = 0; j < num_cols(A); ++j) {
-			x = (abs(A(i, j)) > x) ? abs(A(i, j)) : x;
-		}
-	}
-	return x;
-}
-
-// minelement (jq 2022-10-15)
-template<typename Scalar>
-Scalar minelement(const tensor<Scalar>&A) {
-	auto x = maxelement(A);
-	for (size_t i = 0; i < num_rows(A); ++i) {
-		for (size_t j = 0; j < num_cols(A); ++j) {
-			x = ((abs(A(i, j)) < x) && (A(i,j)!=0)) ? abs(A(i, j)) : x;
-		}
-	}
-	return x;
-}
-
-
-// Gets the ith row of tensor A
-template<typename Scalar>
-vector<Scalar> getRow(unsigned i, const tensor<Scalar>&A) {
-	vector<Scalar> x(num_cols(A));
-	for (size_t j = 0; j < num_cols(A); ++j) {
-		x(j) = A(i,j);
-		}
-	return x;
-}
-
-// Gets the jth column of tensor A
-template<typename Scalar>
-vector<Scalar> getCol(unsigned j, const tensor<Scalar>&A) {
-	vector<Scalar> x(num_rows(A));
-	for (size_t i = 0; i < num_rows(A); ++i) {
-		x(i) = A(i,j);
-		}
-	return x;
-}
-
-
-// Display Matrix
-template<typename Scalar>
-void disp(const tensor<Scalar>& A, const size_t COLWIDTH = 10){
-    for (size_t i = 0;i<num_rows(A);++i){
-        for (size_t j = 0; j<num_cols(A);++j){
-            // std::cout <<std::setw(COLWIDTH) << A(i,j) << std::setw(COLWIDTH) << "\t" << std::fixed;
-			std::cout << "\t" << A(i,j) << "\t"; // << std::fixed;
-        }
-        std::cout << "\n";
-    }
-    std::cout << "\n" << std::endl;
-}
-
-
 }}} // namespace sw::universal::blas
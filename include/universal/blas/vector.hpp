@@ -11,6 +11,7 @@
 #include <vector>
 #include <initializer_list>
 #include <cmath>
+#include <universal/blas/expression.hpp>
 
 #if defined(__clang__)
 /* Clang/LLVM. ---------------------------------------------- */
@@ -54,19 +55,20 @@
 
 namespace sw { namespace universal { namespace blas {
 
-// a column vector
-template<typename Scalar>
-class vector {
+// a column vector, the Allocator provides the storage of the elements
+template<typename Scalar, typename Allocator>
+class vector : public vector_expression< vector<Scalar, Allocator> > {
 public:
 	typedef Scalar                            value_type;
 	typedef const value_type&                 const_reference;
 	typedef value_type&                       reference;
 	typedef const value_type*                 const_pointer_type;
-	typedef typename std::vector<Scalar>::size_type size_type;
-	typedef typename std::vector<Scalar>::iterator     iterator;
-	typedef typename std::vector<Scalar>::const_iterator const_iterator;
-	typedef typename std::vector<Scalar>::reverse_iterator reverse_iterator;
-	typedef typename std::vector<Scalar>::const_reverse_iterator const_reverse_iterator;
+	typedef typename std::vector<Scalar, Allocator>::size_type size_type;
+	typedef typename std::vector<Scalar, Allocator>::iterator     iterator;
+	typedef typename std::vector<Scalar, Allocator>::const_iterator const_iterator;
+	typedef typename std::vector<Scalar, Allocator>::reverse_iterator reverse_iterator;
+	typedef typename std::vector<Scalar, Allocator>::const_reverse_iterator const_reverse_iterator;
+	typedef Allocator                                 allocator_type;
 	static constexpr unsigned AggregationType = UNIVERSAL_AGGREGATE_VECTOR;
 
 	vector() : data(0) {}
@@ -74,24 +76,43 @@ public:
 	vector(size_t N, const Scalar& val) : data(N, val) {}
 	vector(std::initializer_list<Scalar> iList) : data(iList) {}
 	// Converting Constructor (SourceType A --> Scalar B)
-	template<typename SourceType>
-	vector(const vector<SourceType>& v) : data(v.size()) {
+	template<typename SourceType, typename SourceAllocator>
+	vector(const vector<SourceType, SourceAllocator>& v) : data(v.size()) {
 		for (size_t i = 0; i < size(); ++i){
 			data[i] = Scalar(v(i));
 		}
 	}
+	// evaluate a vector expression
+	template<typename Expression>
+	vector(const vector_expression<Expression>& e) : data(e.derived().size()) {
+		const Expression& expr = e.derived();
+		for (size_t i = 0; i < size(); ++i) {
+			data[i] = Scalar(expr[i]);
+		}
+	}
 	vector(const vector& v) = default;
 	vector(vector&& v) = default;
 
 	vector& operator=(const vector& v) = default;
 	vector& operator=(vector&& v) = default;
-	template<typename tgtScalar>
-	vector& operator=(const vector<tgtScalar>& v) {
+	template<typename tgtScalar, typename tgtAllocator>
+	vector& operator=(const vector<tgtScalar, tgtAllocator>& v) {
 		for (size_t i = 0; i < size(); ++i) {
 			data[i] = Scalar(v[i]); // conversion must be handled by number system
 		}
 		return *this;
 	}
+	// evaluate a vector expression in a single pass: element i of the expression only depends on
+	// element i of its operands, so the target vector may appear in the expression, as in x = x + alpha * p
+	template<typename Expression>
+	vector& operator=(const vector_expression<Expression>& e) {
+		const Expression& expr = e.derived();
+		if (expr.size() != size()) data.resize(expr.size());
+		for (size_t i = 0; i < size(); ++i) {
+			data[i] = Scalar(expr[i]);
+		}
+		return *this;
+	}
 
 // operators
 	vector& operator=(const Scalar& val) {
@@ -103,13 +124,6 @@ public:
 	value_type operator()(size_t index) const { return data[index]; }
 	value_type& operator()(size_t index) { return data[index]; }
 
-	// prefix operator
-	vector operator-() {
-		vector<value_type> n(*this);
-		for (auto& v : n.data) v = -v;
-		return n;
-	}
-
 	/// vector-wide operators
 	// vector-wide add
 	vector& operator+=(const Scalar& offset) {
@@ -133,28 +147,36 @@ public:
 	}
 
 	// element-wise add
-	vector& operator+=(const vector<Scalar>& offset) {
+	template<typename Expression>
+	vector& operator+=(const vector_expression<Expression>& e) {
+		const Expression& offset = e.derived();
 		for (size_t i = 0; i < size(); ++i) {
 			data[i] += offset[i];
 		}
 		return *this;
 	}
 	// element-wise subtract
-	vector& operator-=(const vector<Scalar>& offset) {
+	template<typename Expression>
+	vector& operator-=(const vector_expression<Expression>& e) {
+		const Expression& offset = e.derived();
 		for (size_t i = 0; i < size(); ++i) {
 			data[i] -= offset[i];
 		}
 		return *this;
 	}
 	// element-wise multiply
-	vector& operator*=(const vector<Scalar>& scaler) {
+	template<typename Expression>
+	vector& operator*=(const vector_expression<Expression>& e) {
+		const Expression& scaler = e.derived();
 		for (size_t i = 0; i < size(); ++i) {
 			data[i] *= scaler[i];
 		}
 		return *this;
 	}
 	// element-wise divide
-	vector& operator/=(const vector<Scalar>& normalizer) {
+	template<typename Expression>
+	vector& operator/=(const vector_expression<Expression>& e) {
+		const Expression& normalizer = e.derived();
 		for (size_t i = 0; i < size(); ++i) {
 			data[i] /= normalizer[i];
 		}
@@ -247,12 +269,12 @@ public:
 		return const_reverse_iterator(begin());
 	}
 private:
-	std::vector<Scalar> data;
+	std::vector<Scalar, Allocator> data;
 };
 
 // ostream operators
-template<typename Scalar>
-std::ostream& operator<<(std::ostream& ostr, const vector<Scalar>& v) {
+template<typename Scalar, typename Allocator>
+std::ostream& operator<<(std::ostream& ostr, const vector<Scalar, Allocator>& v) {
 	auto width = ostr.width();
 	ostr << "[ ";
 	for (size_t j = 0; j < size(v); ++j) ostr << std::setw(width) << v[j] << " ";
@@ -260,6 +282,11 @@ std::ostream& operator<<(std::ostream& ostr, const vector<Scalar>& v) {
 	return ostr;
 }
 
+template<typename Expression>
+std::ostream& operator<<(std::ostream& ostr, const vector_expression<Expression>& e) {
+	return ostr << e.eval();
+}
+
 // serialization operators
 
 template<typename Scalar>
@@ -294,50 +321,9 @@ void restore(std::istream& istr, const sw::universal::blas::vector<Scalar>& v) {
 	}
 }
 
-template<typename Scalar>
-vector<Scalar> operator+(const vector<Scalar>& lhs, const vector<Scalar>& rhs) {
-	vector<Scalar> sum(lhs);
-	return sum += rhs;
-}
+// the arithmetic operators +, -, and scaling by * and / are defined on vector expressions in expression.hpp
 
-template<typename Scalar>
-vector<Scalar> operator-(const vector<Scalar>& lhs, const vector<Scalar>& rhs) {
-	vector<Scalar> difference(lhs);
-	return difference -= rhs;
-}
-
-// scale a vector through operator* overload
-template<typename Scalar>
-vector<Scalar> operator*(const Scalar& alpha, const vector<Scalar>& x) {
-	vector<Scalar> scaled(x);
-	return scaled *= alpha;
-}
- 
-
-// scale a vector through operator* overload
-template<typename Scalar>
-vector<Scalar> operator*(const vector<Scalar>& x, const Scalar& alpha) {
-	vector<Scalar> scaled(x);
-	return scaled *= alpha;
-}
-
-// scale a vector through operator/ overload
-template<typename Scalar>
-vector<Scalar> operator/(const vector<Scalar>& v, const Scalar& normalizer) {
-	vector<Scalar> normalized(v);
-	return normalized /= normalizer;
-}
-
-// TODO: this next overload will create an ambiguous overload if Scalar is an int as it will be the same as the function above
-
-// scale a vector through operator/ overload
-template<typename Scalar>
-vector<Scalar> operator/(const vector<Scalar>& v, const int normalizer) {
-	vector<Scalar> normalized(v);
-	return normalized /= Scalar(normalizer);
-}
-
-template<typename Scalar> auto size(const vector<Scalar>& v) { return v.size(); }
+template<typename Scalar, typename Allocator> auto size(const vector<Scalar, Allocator>& v) { return v.size(); }
 
 // this design does not work well for universal as we would need to create
 // enable_if() configurations for all possible type combinations
@@ -379,12 +365,15 @@ typename std::enable_if<std::is_integral<Scalar>::value, Scalar>::type operator*
 }
 #endif
 
-template<typename Scalar>
-Scalar operator*(const vector<Scalar>& a, const vector<Scalar>& b) {
-	//	std::cout << "dot product for " << typeid(Scalar).name() << std::endl;
-	size_t N = size(a);
-	if (size(a) != size(b)) {
-		std::cerr << "vector sizes are different: " << N << " vs " << size(b) << '\n';
+// dot product of two vector expressions
+template<typename Lhs, typename Rhs, typename = std::enable_if_t< is_same_value_type_v<Lhs, Rhs> > >
+typename Lhs::value_type operator*(const vector_expression<Lhs>& lhs, const vector_expression<Rhs>& rhs) {
+	using Scalar = typename Lhs::value_type;
+	const Lhs& a = lhs.derived();
+	const Rhs& b = rhs.derived();
+	size_t N = a.size();
+	if (a.size() != b.size()) {
+		std::cerr << "vector sizes are different: " << N << " vs " << b.size() << '\n';
 		return Scalar{ 0 };
 	}
 	Scalar sum{ 0 };
@@ -395,17 +384,19 @@ Scalar operator*(const vector<Scalar>& a, const vector<Scalar>& b) {
 	return sum;
 }
 
-template<typename Scalar>
-bool operator==(const vector<Scalar>& lhs, const vector<Scalar>& rhs) {
-	if (lhs.size() != rhs.size()) return false;
-	for (unsigned i = 0; i < lhs.size(); ++i) {
-		if (lhs[i] != rhs[i]) return false;
+template<typename Lhs, typename Rhs, typename = std::enable_if_t< is_same_value_type_v<Lhs, Rhs> > >
+bool operator==(const vector_expression<Lhs>& lhs, const vector_expression<Rhs>& rhs) {
+	const Lhs& a = lhs.derived();
+	const Rhs& b = rhs.derived();
+	if (a.size() != b.size()) return false;
+	for (size_t i = 0; i < a.size(); ++i) {
+		if (a[i] != b[i]) return false;
 	}
 	return true;
 }
 
-template<typename Scalar>
-bool operator!=(const vector<Scalar>& lhs, const vector<Scalar>& rhs) {
+template<typename Lhs, typename Rhs, typename = std::enable_if_t< is_same_value_type_v<Lhs, Rhs> > >
+bool operator!=(const vector_expression<Lhs>& lhs, const vector_expression<Rhs>& rhs) {
 	return !(lhs == rhs);
 }
 
@@ -6,31 +6,49 @@
 //
 // This file is part of the universal numbers project, which is released under an MIT Open Source license.
 #include <cmath>
+#include <cstddef>
 #include <universal/blas/vector.hpp>
 
 namespace sw { namespace universal { namespace blas {
 
+// number systems with a batch sine and cosine over arrays, such as the CORDIC kernels of fixpnt
+template<typename Scalar>
+concept batch_sincos = requires(const Scalar* x, Scalar* y, size_t n) { sincos(x, y, y, n); };
+
+// vector sine and cosine functions: either output may be null
+template<typename Scalar>
+void sincos(const vector<Scalar>& radians, vector<Scalar>* s, vector<Scalar>* c) {
+	size_t n = radians.size();
+	if (s) s->resize(n);
+	if (c) c->resize(n);
+	if (n == 0) return;
+	if constexpr (batch_sincos<Scalar>) {
+		sincos(&*radians.begin(), (s ? &*s->begin() : nullptr), (c ? &*c->begin() : nullptr), n);
+	}
+	else {
+		using std::sin;
+		using std::cos;
+		using namespace sw::universal;
+		for (size_t i = 0; i < n; ++i) {
+			if (s) (*s)[i] = sin(radians[i]);
+			if (c) (*c)[i] = cos(radians[i]);
+		}
+	}
+}
+
 // vector sine function
 template<typename Scalar>
 vector<Scalar> sin(const vector<Scalar>& radians) {
-	using std::sin;
-	using namespace sw::universal;
 	vector<Scalar> v(radians.size());
-	for (size_t i = 0; i < radians.size(); ++i) {
-		v[i] = sin(radians[i]);
-	}
+	sincos(radians, &v, static_cast<vector<Scalar>*>(nullptr));
 	return v;
 }
 
 // vector cosine function
 template<typename Scalar>
 vector<Scalar> cos(const vector<Scalar>& radians) {
-	using std::cos;
-	using namespace sw::universal;
 	vector<Scalar> v(radians.size());
-	for (size_t i = 0; i < radians.size(); ++i) {
-		v[i] = cos(radians[i]);
-	}
+	sincos(radians, static_cast<vector<Scalar>*>(nullptr), &v);
 	return v;
 }
 // vector tangent function
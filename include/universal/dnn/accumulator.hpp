@@ -0,0 +1,63 @@
+#pragma once
+// accumulator.hpp: configurable accumulation engines for the DNN dot products
+//
+// Copyright (C) 2021-2022 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <type_traits>
+#include <universal/number/posit/posit_fwd.hpp>
+
+namespace sw { namespace universal { namespace dnn {
+
+// convert between number systems, marshalling through double when the types differ
+template<typename Target, typename Source>
+inline Target scalar_cast(const Source& v) {
+	if constexpr (std::is_same_v<Target, Source>) {
+		return v;
+	}
+	else {
+		return Target(double(v));
+	}
+}
+
+// accumulator<AccumulationType> gathers a sum of products of weights and activations.
+// Operands are presented in the operand_type of the accumulator so that the caller
+// can convert weights and activations once, outside of the inner product loops.
+// The generic engine rounds each product and partial sum to AccumulationType.
+template<typename AccumulationType>
+class accumulator {
+public:
+	using operand_type = AccumulationType;
+
+	void clear() { acc = AccumulationType(0); }
+	void add(const operand_type& w) { acc += w; }
+	void mac(const operand_type& w, const operand_type& a) { acc += w * a; }
+	template<typename Target>
+	Target value() const { return scalar_cast<Target>(acc); }
+
+private:
+	AccumulationType acc{ 0 };
+};
+
+// posit weights can accumulate in a quire, yielding a fused dot product with a single rounding step
+template<unsigned nbits, unsigned es, unsigned capacity>
+class accumulator< quire<nbits, es, capacity> > {
+public:
+	using Posit = posit<nbits, es>;
+	using operand_type = Posit;
+
+	void clear() { q.clear(); }
+	void add(const operand_type& w) { q += w; }
+	void mac(const operand_type& w, const operand_type& a) { q += quire_mul(w, a); }
+	template<typename Target>
+	Target value() const {
+		Posit p;
+		convert(q.to_value(), p);  // one and only rounding step of the fused dot product
+		return scalar_cast<Target>(p);
+	}
+
+private:
+	quire<nbits, es, capacity> q;
+};
+
+}}} // namespace sw::universal::dnn
@@ -12,6 +12,8 @@
 // Universal BLAS library
 #include <universal/blas/blas.hpp>
 
+#include <universal/dnn/tensor.hpp>
+#include <universal/dnn/accumulator.hpp>
 #include <universal/dnn/layer.hpp>
 #include <universal/dnn/dnn_impl.hpp>
 
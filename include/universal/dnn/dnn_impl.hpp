@@ -4,7 +4,13 @@
 // Copyright (C) 2021-2022 Stillwater Supercomputing, Inc.
 //
 // This file is part of the universal numbers project, which is released under an MIT Open Source license.
-#include <universal/blas/vector.hpp>
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <universal/utility/parallel.hpp>
+#include <universal/dnn/tensor.hpp>
+#include <universal/dnn/layer.hpp>
 
 namespace sw { namespace universal { namespace dnn {
 
@@ -19,6 +25,44 @@ public:
         layers.push_back(&layer);
     }
 
+    // forward inference of a batch of images through all the layers of the network
+    // the batch is partitioned across nrThreads threads (0 selects all hardware threads),
+    // and each thread propagates its sub-batch through the layers independently
+    template<typename ActivationScalarType>
+    tensor<ActivationScalarType> infer(const tensor<ActivationScalarType>& input, unsigned nrThreads = 0) const {
+        std::vector<const Layer<ActivationScalarType>*> pipeline;
+        for (auto layer : layers) {
+            auto l = dynamic_cast<const Layer<ActivationScalarType>*>(layer);
+            if (l == nullptr) throw std::runtime_error("dnn::infer: layer does not consume the activation type of the input");
+            pipeline.push_back(l);
+        }
+        unsigned C = input.channels(), H = input.height(), W = input.width();
+        for (auto l : pipeline) {
+            unsigned outC, outH, outW;
+            l->outputShape(C, H, W, outC, outH, outW);
+            C = outC; H = outH; W = outW;
+        }
+        tensor<ActivationScalarType> output(input.batch(), C, H, W);
+        size_t inputImageSize = input.imageSize();
+        size_t outputImageSize = output.imageSize();
+        sw::universal::parallel_for(0, input.batch(), [&](size_t first, size_t last, unsigned) {
+            unsigned N = static_cast<unsigned>(last - first);
+            tensor<ActivationScalarType> x(N, input.channels(), input.height(), input.width());
+            std::copy(input.image(static_cast<unsigned>(first)), input.image(static_cast<unsigned>(first)) + N * inputImageSize, x.image(0));
+            for (auto l : pipeline) {
+                unsigned outC, outH, outW;
+                l->outputShape(x.channels(), x.height(), x.width(), outC, outH, outW);
+                tensor<ActivationScalarType> y(N, outC, outH, outW);
+                l->forward(x, y);
+                x = std::move(y);
+            }
+            std::copy(x.image(0), x.image(0) + N * outputImageSize, output.image(static_cast<unsigned>(first)));
+        }, nrThreads);
+        return output;
+    }
+
+    size_t nrLayers() const noexcept { return layers.size(); }
+
 protected:
 
 
@@ -37,6 +81,7 @@ template<typename LearningRateType>
 std::ostream& operator<<(std::ostream& ostr, const dnn< LearningRateType>& network) {
     ostr << "Deep Neural Network : " << network.name << '\n';
     ostr << "Learning Rate       : " << network.learningRate << '\n';
+    ostr << "Number of layers    : " << network.layers.size() << '\n';
     return ostr;
 }
 
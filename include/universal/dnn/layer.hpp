@@ -4,100 +4,364 @@
 // Copyright (C) 2021-2022 Stillwater Supercomputing, Inc.
 //
 // This file is part of the universal numbers project, which is released under an MIT Open Source license.
-#include <universal/blas/vector.hpp>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <vector>
+#include <universal/dnn/tensor.hpp>
+#include <universal/dnn/accumulator.hpp>
 
 namespace sw { namespace universal { namespace dnn {
 
 
 
 enum class Activation {
-    ReLU, Sigmoid, Tanh
+    ReLU, Sigmoid, Tanh, Identity
 };
 
 enum class LayerOperation {
     FullyConnected, Sparse, MaxPooling, AvgPooling, Convolutional
 };
 
+// apply the activation function in the activation number system
+template<typename Scalar>
+Scalar activate(Activation f, const Scalar& x) {
+    switch (f) {
+    case Activation::ReLU:
+        return (x < Scalar(0)) ? Scalar(0) : x;
+    case Activation::Sigmoid:
+        return Scalar(1.0 / (1.0 + std::exp(-double(x))));
+    case Activation::Tanh:
+        return Scalar(std::tanh(double(x)));
+    case Activation::Identity:
+    default:
+        break;
+    }
+    return x;
+}
+
 class AbstractLayer {
 public:
     AbstractLayer() {};
     virtual ~AbstractLayer() = 0;
 };
 
-AbstractLayer::~AbstractLayer() {}
+inline AbstractLayer::~AbstractLayer() {}
 
+// Layer is the inference interface of all layers that consume and produce ActivationScalarType tensors
+template<typename ActivationScalarType>
+class Layer : public AbstractLayer {
+public:
+    // shape of the output image given the shape of the input image
+    virtual void outputShape(unsigned C, unsigned H, unsigned W, unsigned& outC, unsigned& outH, unsigned& outW) const = 0;
+    // forward propagation of a batch of images, out is sized by the caller through outputShape
+    virtual void forward(const tensor<ActivationScalarType>& in, tensor<ActivationScalarType>& out) const = 0;
+};
 
+// convert a parameter set to the operand type of the accumulator
+template<typename Operand, typename Scalar>
+std::vector<Operand> operands(const std::vector<Scalar>& v) {
+    std::vector<Operand> result(v.size());
+    for (size_t i = 0; i < v.size(); ++i) result[i] = scalar_cast<Operand>(v[i]);
+    return result;
+}
+
+// gemm_nt computes C = activation(A * B' + bias), with A an M x K weight matrix and B an N x K
+// activation matrix, both stored row-major with contiguous K. The output element (m, n) is stored
+// at C[m * csm + n * csn] so that the caller can select the output layout.
+// A and bias are presented in the operand type of the accumulator, B is converted once, before the product loops.
+template<typename AccumulationType, typename ActivationScalarType>
+void gemm_nt(size_t M, size_t N, size_t K,
+    const typename accumulator<AccumulationType>::operand_type* A, const ActivationScalarType* B,
+    const typename accumulator<AccumulationType>::operand_type* bias, Activation f,
+    ActivationScalarType* C, size_t csm, size_t csn) {
+    using Accumulator = accumulator<AccumulationType>;
+    using Operand = typename Accumulator::operand_type;
+    std::vector<Operand> b(N * K);
+    for (size_t i = 0; i < N * K; ++i) b[i] = scalar_cast<Operand>(B[i]);
+    Accumulator acc;
+    for (size_t m = 0; m < M; ++m) {
+        const Operand* am = A + m * K;
+        for (size_t n = 0; n < N; ++n) {
+            const Operand* bn = b.data() + n * K;
+            acc.clear();
+            for (size_t k = 0; k < K; ++k) {
+                acc.mac(am[k], bn[k]);
+            }
+            acc.add(bias[m]);
+            C[m * csm + n * csn] = activate(f, acc.template value<ActivationScalarType>());
+        }
+    }
+}
+
+// Xavier/Glorot uniform initialization of a weight set
+template<typename WeightScalarType>
+void glorot_uniform(std::vector<WeightScalarType>& weight, unsigned fanIn, unsigned fanOut, std::uint64_t seed) {
+    std::mt19937_64 generator(seed);
+    double limit = std::sqrt(6.0 / double(fanIn + fanOut));
+    std::uniform_real_distribution<double> distribution(-limit, limit);
+    for (auto& w : weight) w = WeightScalarType(distribution(generator));
+}
 
 //////////////////////////////////////////////////////////////////////////////
 ///           FULLY CONNECTED LAYER
 
-template<typename WeightScalarType, typename ActivationScalarType>
-class FullyConnectedLayer : public AbstractLayer {
+template<typename WeightScalarType, typename ActivationScalarType, typename AccumulationType = ActivationScalarType>
+class FullyConnectedLayer : public Layer<ActivationScalarType> {
 public:
+    using Operand = typename accumulator<AccumulationType>::operand_type;
+
     FullyConnectedLayer() noexcept = default;
-    FullyConnectedLayer(unsigned nrNodes, unsigned nrChannels, Activation activation) : nrChannels{ nrChannels }, weight(nrNodes), bias(nrNodes), activation{ activation } {}
+    FullyConnectedLayer(unsigned nrInputs, unsigned nrNodes, Activation activation) : nrInputs{ nrInputs }, nrNodes{ nrNodes }, weight(size_t(nrNodes) * nrInputs, WeightScalarType(0)), bias(nrNodes, WeightScalarType(0)), activation{ activation } { convert(); }
+
+    void initialize(std::uint64_t seed) {
+        glorot_uniform(weight, nrInputs, nrNodes, seed);
+        for (auto& b : bias) b = WeightScalarType(0);
+        convert();
+    }
+
+    void outputShape(unsigned C, unsigned H, unsigned W, unsigned& outC, unsigned& outH, unsigned& outW) const override {
+        if (size_t(C) * H * W != nrInputs) throw std::runtime_error("fully connected layer: input size does not match the number of inputs");
+        outC = nrNodes; outH = 1; outW = 1;
+    }
+
+    // the batch is a N x nrInputs matrix, the output is (W * X' + b)' which is N x nrNodes
+    void forward(const tensor<ActivationScalarType>& in, tensor<ActivationScalarType>& out) const override {
+        gemm_nt<AccumulationType>(nrNodes, in.batch(), nrInputs, weightOperands.data(), in.image(0), biasOperands.data(), activation, out.image(0), 1, nrNodes);
+    }
+
+    // load trained parameters: weights are stored as a row-major nrNodes x nrInputs matrix
+    void setWeights(const std::vector<WeightScalarType>& w) {
+        if (w.size() != weight.size()) throw std::runtime_error("fully connected layer: weight set does not match the layer shape");
+        weight = w;
+        convert();
+    }
+    void setBiases(const std::vector<WeightScalarType>& b) {
+        if (b.size() != bias.size()) throw std::runtime_error("fully connected layer: bias set does not match the number of nodes");
+        bias = b;
+        convert();
+    }
+    const std::vector<WeightScalarType>& weights() const noexcept { return weight; }
+    const std::vector<WeightScalarType>& biases() const noexcept { return bias; }
 
 protected:
+    // the parameters are converted to the operand type of the accumulator once, when they are set, not on every forward
+    void convert() {
+        weightOperands = operands<Operand>(weight);
+        biasOperands = operands<Operand>(bias);
+    }
 
 private:
-    unsigned nrChannels;
-    sw::universal::blas::vector<WeightScalarType> weight;
-    sw::universal::blas::vector<WeightScalarType> bias;
+    unsigned nrInputs, nrNodes;
+    std::vector<WeightScalarType> weight;
+    std::vector<WeightScalarType> bias;
+    std::vector<Operand> weightOperands;
+    std::vector<Operand> biasOperands;
     Activation activation;
 
-    template<typename WWeightScalarType, typename AActivationScalarType>
-    friend std::ostream& operator<<(std::ostream& ostr, FullyConnectedLayer<WWeightScalarType, AActivationScalarType>& fcLayer);
+    template<typename WWeightScalarType, typename AActivationScalarType, typename AAccumulationType>
+    friend std::ostream& operator<<(std::ostream& ostr, const FullyConnectedLayer<WWeightScalarType, AActivationScalarType, AAccumulationType>& fcLayer);
 };
 
-template<typename WeightScalarType, typename ActivationScalarType>
-FullyConnectedLayer<WeightScalarType, ActivationScalarType> CreateFullyConnectedLayer(unsigned nrNodes, Activation activation) {
-    return FullyConnectedLayer<WeightScalarType, ActivationScalarType>(nrNodes, 1, activation);
+template<typename WeightScalarType, typename ActivationScalarType, typename AccumulationType = ActivationScalarType>
+FullyConnectedLayer<WeightScalarType, ActivationScalarType, AccumulationType> CreateFullyConnectedLayer(unsigned nrInputs, unsigned nrNodes, Activation activation) {
+    return FullyConnectedLayer<WeightScalarType, ActivationScalarType, AccumulationType>(nrInputs, nrNodes, activation);
 }
 
-template<typename WeightScalarType, typename ActivationScalarType>
-std::ostream& operator<<(std::ostream& ostr, FullyConnectedLayer<WeightScalarType, ActivationScalarType>& fcLayer) {
+template<typename WeightScalarType, typename ActivationScalarType, typename AccumulationType>
+std::ostream& operator<<(std::ostream& ostr, const FullyConnectedLayer<WeightScalarType, ActivationScalarType, AccumulationType>& fcLayer) {
     ostr << "Fully Connected Layer\n";
-    ostr << "weights :\n" << fcLayer.weight << '\n';
-    ostr << "biases  :\n" << fcLayer.bias << '\n';
+    ostr << "inputs      : " << fcLayer.nrInputs << '\n';
+    ostr << "nodes       : " << fcLayer.nrNodes << '\n';
+    ostr << "weights     : " << fcLayer.weight.size() << '\n';
+    ostr << "biases      : " << fcLayer.bias.size() << '\n';
     return ostr;
 }
 
 //////////////////////////////////////////////////////////////////////////////
 ///           CONVOLUTIONAL LAYER
 
-template<typename WeightScalarType, typename ActivationScalarType>
-class ConvolutionalLayer : public AbstractLayer {
+template<typename WeightScalarType, typename ActivationScalarType, typename AccumulationType = ActivationScalarType>
+class ConvolutionalLayer : public Layer<ActivationScalarType> {
 public:
+    using Operand = typename accumulator<AccumulationType>::operand_type;
+
     ConvolutionalLayer() noexcept = default;
-    ConvolutionalLayer(unsigned N, unsigned C, unsigned H, unsigned W, Activation activation) : N{N}, C{C}, H{H}, W{W}, weight(C*H*W), bias(C*H*W), activation{activation} {}
+    ConvolutionalLayer(unsigned C, unsigned K, unsigned R, unsigned S, unsigned stride, unsigned padding, Activation activation)
+        : C{ C }, K{ K }, R{ R }, S{ S }, stride{ stride }, padding{ padding }, weight(size_t(K) * C * R * S, WeightScalarType(0)), bias(K, WeightScalarType(0)), activation{ activation } {
+        if (stride == 0) throw std::runtime_error("convolutional layer: stride must be positive");
+        convert();
+    }
+
+    void initialize(std::uint64_t seed) {
+        glorot_uniform(weight, C * R * S, K * R * S, seed);
+        for (auto& b : bias) b = WeightScalarType(0);
+        convert();
+    }
+
+    void outputShape(unsigned inC, unsigned H, unsigned W, unsigned& outC, unsigned& outH, unsigned& outW) const override {
+        if (inC != C) throw std::runtime_error("convolutional layer: input channels do not match the filter bank");
+        if (H + 2 * padding < R || W + 2 * padding < S) throw std::runtime_error("convolutional layer: filter is larger than the input");
+        outC = K;
+        outH = (H + 2 * padding - R) / stride + 1;
+        outW = (W + 2 * padding - S) / stride + 1;
+    }
+
+    // im2col lowering: each output pixel gathers its C x R x S receptive field into a row of the patch matrix,
+    // so that the convolution becomes the (K x CRS) * (CRS x P) product of the filter bank and the patches
+    void forward(const tensor<ActivationScalarType>& in, tensor<ActivationScalarType>& out) const override {
+        unsigned H = in.height(), W = in.width();
+        unsigned outC, outH, outW;
+        outputShape(in.channels(), H, W, outC, outH, outW);
+        size_t CRS = size_t(C) * R * S;
+        size_t P = size_t(outH) * outW;
+        std::vector<ActivationScalarType> patches(P * CRS);
+        for (unsigned n = 0; n < in.batch(); ++n) {
+            const ActivationScalarType* image = in.image(n);
+            for (unsigned oh = 0; oh < outH; ++oh) {
+                for (unsigned ow = 0; ow < outW; ++ow) {
+                    ActivationScalarType* patch = patches.data() + (size_t(oh) * outW + ow) * CRS;
+                    for (unsigned c = 0; c < C; ++c) {
+                        for (unsigned r = 0; r < R; ++r) {
+                            int h = int(oh * stride + r) - int(padding);
+                            for (unsigned s = 0; s < S; ++s) {
+                                int w = int(ow * stride + s) - int(padding);
+                                bool inside = (h >= 0 && h < int(H) && w >= 0 && w < int(W));
+                                *patch++ = inside ? image[(size_t(c) * H + unsigned(h)) * W + unsigned(w)] : ActivationScalarType(0);
+                            }
+                        }
+                    }
+                }
+            }
+            gemm_nt<AccumulationType>(K, P, CRS, weightOperands.data(), patches.data(), biasOperands.data(), activation, out.image(n), P, 1);
+        }
+    }
+
+    // load trained parameters: weights are stored in KCRS order
+    void setWeights(const std::vector<WeightScalarType>& w) {
+        if (w.size() != weight.size()) throw std::runtime_error("convolutional layer: weight set does not match the filter bank");
+        weight = w;
+        convert();
+    }
+    void setBiases(const std::vector<WeightScalarType>& b) {
+        if (b.size() != bias.size()) throw std::runtime_error("convolutional layer: bias set does not match the output channels");
+        bias = b;
+        convert();
+    }
+    const std::vector<WeightScalarType>& weights() const noexcept { return weight; }
+    const std::vector<WeightScalarType>& biases() const noexcept { return bias; }
 
 protected:
+    // the parameters are converted to the operand type of the accumulator once, when they are set, not on every forward
+    void convert() {
+        weightOperands = operands<Operand>(weight);
+        biasOperands = operands<Operand>(bias);
+    }
 
 private:
-    unsigned N, C, H, W;
-    sw::universal::blas::vector<WeightScalarType> weight;
-    sw::universal::blas::vector<WeightScalarType> bias;
+    unsigned C, K, R, S;      // input channels, output channels, filter height, filter width
+    unsigned stride, padding;
+    std::vector<WeightScalarType> weight;
+    std::vector<WeightScalarType> bias;
+    std::vector<Operand> weightOperands;
+    std::vector<Operand> biasOperands;
     Activation activation;
 
-    template<typename W, typename A>
-    friend std::ostream& operator<<(std::ostream& ostr, ConvolutionalLayer<W, A>& fcLayer);
+    template<typename WW, typename AA, typename CC>
+    friend std::ostream& operator<<(std::ostream& ostr, const ConvolutionalLayer<WW, AA, CC>& convLayer);
 };
 
-template<typename WeightScalarType, typename ActivationScalarType>
-ConvolutionalLayer<WeightScalarType, ActivationScalarType> CreateConvolutionLayer(unsigned N, unsigned C, unsigned H, unsigned W, Activation activation) {
-    return ConvolutionalLayer<WeightScalarType, ActivationScalarType>(N, C, H, W, activation);
+template<typename WeightScalarType, typename ActivationScalarType, typename AccumulationType = ActivationScalarType>
+ConvolutionalLayer<WeightScalarType, ActivationScalarType, AccumulationType> CreateConvolutionLayer(unsigned C, unsigned K, unsigned R, unsigned S, unsigned stride, unsigned padding, Activation activation) {
+    return ConvolutionalLayer<WeightScalarType, ActivationScalarType, AccumulationType>(C, K, R, S, stride, padding, activation);
 }
 
-template<typename WeightScalarType, typename ActivationScalarType>
-std::ostream& operator<<(std::ostream& ostr, ConvolutionalLayer<WeightScalarType, ActivationScalarType>& convLayer) {
+template<typename WeightScalarType, typename ActivationScalarType, typename AccumulationType>
+std::ostream& operator<<(std::ostream& ostr, const ConvolutionalLayer<WeightScalarType, ActivationScalarType, AccumulationType>& convLayer) {
     ostr << "Convolutional Layer\n";
-    ostr << "batch size  : " << convLayer.N << '\n';
-    ostr << "channels    : " << convLayer.C << '\n';
-    ostr << "height      : " << convLayer.H << '\n';
-    ostr << "width       : " << convLayer.W << '\n';
+    ostr << "channels    : " << convLayer.C << " -> " << convLayer.K << '\n';
+    ostr << "filter      : " << convLayer.R << 'x' << convLayer.S << '\n';
+    ostr << "stride      : " << convLayer.stride << '\n';
+    ostr << "padding     : " << convLayer.padding << '\n';
     ostr << "weights     : " << convLayer.weight.size() << '\n';
     ostr << "biases      : " << convLayer.bias.size() << '\n';
     return ostr;
 }
 
+//////////////////////////////////////////////////////////////////////////////
+///           POOLING LAYER
+
+template<typename ActivationScalarType>
+class PoolingLayer : public Layer<ActivationScalarType> {
+public:
+    PoolingLayer() noexcept = default;
+    PoolingLayer(LayerOperation op, unsigned window, unsigned stride) : op{ op }, window{ window }, stride{ stride } {
+        if (op != LayerOperation::MaxPooling && op != LayerOperation::AvgPooling) throw std::runtime_error("pooling layer: operation must be MaxPooling or AvgPooling");
+        if (stride == 0) throw std::runtime_error("pooling layer: stride must be positive");
+    }
+
+    void outputShape(unsigned C, unsigned H, unsigned W, unsigned& outC, unsigned& outH, unsigned& outW) const override {
+        if (H < window || W < window) throw std::runtime_error("pooling layer: window is larger than the input");
+        outC = C;
+        outH = (H - window) / stride + 1;
+        outW = (W - window) / stride + 1;
+    }
+
+    void forward(const tensor<ActivationScalarType>& in, tensor<ActivationScalarType>& out) const override {
+        unsigned C = in.channels(), H = in.height(), W = in.width();
+        unsigned outC, outH, outW;
+        outputShape(C, H, W, outC, outH, outW);
+        double normalizer = double(window) * double(window);
+        for (unsigned n = 0; n < in.batch(); ++n) {
+            for (unsigned c = 0; c < C; ++c) {
+                for (unsigned oh = 0; oh < outH; ++oh) {
+                    for (unsigned ow = 0; ow < outW; ++ow) {
+                        unsigned h0 = oh * stride, w0 = ow * stride;
+                        if (op == LayerOperation::MaxPooling) {
+                            ActivationScalarType running_max = in(n, c, h0, w0);
+                            for (unsigned r = 0; r < window; ++r) {
+                                for (unsigned s = 0; s < window; ++s) {
+                                    ActivationScalarType e = in(n, c, h0 + r, w0 + s);
+                                    if (e > running_max) running_max = e;
+                                }
+                            }
+                            out(n, c, oh, ow) = running_max;
+                        }
+                        else {
+                            double sum{ 0.0 };
+                            for (unsigned r = 0; r < window; ++r) {
+                                for (unsigned s = 0; s < window; ++s) {
+                                    sum += double(in(n, c, h0 + r, w0 + s));
+                                }
+                            }
+                            out(n, c, oh, ow) = ActivationScalarType(sum / normalizer);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+private:
+    LayerOperation op;
+    unsigned window, stride;
+
+    template<typename AA>
+    friend std::ostream& operator<<(std::ostream& ostr, const PoolingLayer<AA>& poolLayer);
+};
+
+template<typename ActivationScalarType>
+PoolingLayer<ActivationScalarType> CreatePoolingLayer(LayerOperation op, unsigned window, unsigned stride) {
+    return PoolingLayer<ActivationScalarType>(op, window, stride);
+}
+
+template<typename ActivationScalarType>
+std::ostream& operator<<(std::ostream& ostr, const PoolingLayer<ActivationScalarType>& poolLayer) {
+    ostr << (poolLayer.op == LayerOperation::MaxPooling ? "Max" : "Average") << " Pooling Layer\n";
+    ostr << "window      : " << poolLayer.window << 'x' << poolLayer.window << '\n';
+    ostr << "stride      : " << poolLayer.stride << '\n';
+    return ostr;
+}
+
 }}} // namespace sw::universal::dnn
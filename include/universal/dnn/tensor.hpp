@@ -0,0 +1,60 @@
+#pragma once
+// tensor.hpp: batched NCHW activation tensor for the DNN library
+//
+// Copyright (C) 2021-2022 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <iostream>
+#include <vector>
+
+namespace sw { namespace universal { namespace dnn {
+
+// a batch of N images, each with C channels of H rows by W columns, stored in NCHW order
+template<typename Scalar>
+class tensor {
+public:
+	using value_type = Scalar;
+	using size_type  = size_t;
+
+	tensor() : _N{ 0 }, _C{ 0 }, _H{ 0 }, _W{ 0 }, data(0) {}
+	tensor(unsigned N, unsigned C, unsigned H, unsigned W) : _N{ N }, _C{ C }, _H{ H }, _W{ W }, data(size_t(N) * C * H * W, Scalar(0)) {}
+
+	Scalar  operator()(unsigned n, unsigned c, unsigned h, unsigned w) const { return data[index(n, c, h, w)]; }
+	Scalar& operator()(unsigned n, unsigned c, unsigned h, unsigned w)       { return data[index(n, c, h, w)]; }
+	Scalar  operator[](size_t i) const { return data[i]; }
+	Scalar& operator[](size_t i)       { return data[i]; }
+
+	// modifiers
+	void resize(unsigned N, unsigned C, unsigned H, unsigned W) {
+		_N = N; _C = C; _H = H; _W = W;
+		data.resize(size_t(N) * C * H * W);
+	}
+	void setzero() { for (auto& e : data) e = Scalar(0); }
+
+	// selectors
+	unsigned batch()    const noexcept { return _N; }
+	unsigned channels() const noexcept { return _C; }
+	unsigned height()   const noexcept { return _H; }
+	unsigned width()    const noexcept { return _W; }
+	size_t   size()     const noexcept { return data.size(); }
+	size_t   imageSize() const noexcept { return size_t(_C) * _H * _W; }
+
+	// raw access to the n-th image of the batch
+	const Scalar* image(unsigned n) const noexcept { return data.data() + n * imageSize(); }
+	Scalar*       image(unsigned n)       noexcept { return data.data() + n * imageSize(); }
+
+private:
+	unsigned _N, _C, _H, _W;
+	std::vector<Scalar> data;
+
+	size_t index(unsigned n, unsigned c, unsigned h, unsigned w) const noexcept {
+		return ((size_t(n) * _C + c) * _H + h) * _W + w;
+	}
+};
+
+template<typename Scalar>
+std::ostream& operator<<(std::ostream& ostr, const tensor<Scalar>& t) {
+	return ostr << "tensor(" << t.batch() << ", " << t.channels() << ", " << t.height() << ", " << t.width() << ')';
+}
+
+}}} // namespace sw::universal::dnn
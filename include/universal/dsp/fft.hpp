@@ -0,0 +1,334 @@
+#pragma once
+// fft.hpp: fast Fourier transforms over arbitrary Universal scalar types
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <universal/utility/parallel.hpp>
+
+namespace sw { namespace universal { namespace dsp {
+
+/*
+ * The transforms are iterative and in place: the input is permuted into bit-reversed order,
+ * followed by radix-4 decimation-in-time stages, with a single radix-2 stage when log2(N) is odd.
+ * A radix-4 butterfly combines two radix-2 stages with three complex multiplies instead of four,
+ * and halves the number of passes over the data.
+ *
+ * The twiddle factors are tabulated once per plan in the target type, so that the transform
+ * only exercises the arithmetic of Scalar, and std::complex<Scalar> is used as storage only:
+ * the butterflies operate on the real and imaginary parts directly.
+ *
+ * Fixed-point formats overflow when the magnitude of the spectrum exceeds their range: forward_scaled
+ * and inverse scale each radix-2 stage by 1/2 and each radix-4 stage by 1/4, which keeps every
+ * intermediate value within the magnitude of the input.
+ */
+
+struct fft_invalid_size : public std::runtime_error {
+	explicit fft_invalid_size(size_t N) : std::runtime_error("fft size " + std::to_string(N) + " is not a power of two") {}
+};
+
+// smallest power of two that is not smaller than N
+inline size_t fft_size(size_t N) {
+	size_t n = 1;
+	while (n < N) n <<= 1;
+	return n;
+}
+
+// plan for complex transforms of size N, N a power of two
+template<typename Scalar>
+class fft_plan {
+public:
+	using complex = std::complex<Scalar>;
+
+	explicit fft_plan(size_t N) : _N{ N }, _log2N{ 0 }, _cos(N), _sin(N), _bitrev(N) {
+		if (N == 0 || (N & (N - 1)) != 0) throw fft_invalid_size(N);
+		while ((size_t(1) << _log2N) < N) ++_log2N;
+		// twiddle w^j = exp(-2 pi i j / N) = cos - i sin, computed in long double and rounded once into Scalar
+		constexpr long double two_pi = 6.283185307179586476925286766559005768L;
+		for (size_t j = 0; j < N; ++j) {
+			long double angle = two_pi * static_cast<long double>(j) / static_cast<long double>(N);
+			_cos[j] = Scalar(static_cast<double>(std::cos(angle)));
+			_sin[j] = Scalar(static_cast<double>(std::sin(angle)));
+		}
+		for (size_t i = 0; i < N; ++i) {
+			size_t r = 0;
+			for (unsigned b = 0; b < _log2N; ++b) if (i & (size_t(1) << b)) r |= size_t(1) << (_log2N - 1 - b);
+			_bitrev[i] = r;
+		}
+	}
+
+	size_t size() const noexcept { return _N; }
+
+	// X[k] = sum_n x[n] exp(-2 pi i n k / N)
+	void forward(complex* x) const { permute(x); transform(x, false, false); }
+	// X[k] / N, with the scaling distributed over the stages
+	void forward_scaled(complex* x) const { permute(x); transform(x, false, true); }
+	// x[n] = 1/N sum_k X[k] exp(2 pi i n k / N), with the scaling distributed over the stages
+	void inverse(complex* x) const { permute(x); transform(x, true, true); }
+
+	void forward(std::vector<complex>& x) const { check(x.size()); forward(x.data()); }
+	void forward_scaled(std::vector<complex>& x) const { check(x.size()); forward_scaled(x.data()); }
+	void inverse(std::vector<complex>& x) const { check(x.size()); inverse(x.data()); }
+
+	// batched transforms of count contiguous signals of size N: the signals are distributed
+	// across threads, and as every transform is independent the result does not depend on the number of threads
+	void forward(complex* x, size_t count, unsigned nrThreads = 0) const {
+		parallel_for(0, count, [&](size_t first, size_t last, unsigned) {
+			for (size_t s = first; s < last; ++s) forward(x + s * _N);
+		}, nrThreads);
+	}
+	void inverse(complex* x, size_t count, unsigned nrThreads = 0) const {
+		parallel_for(0, count, [&](size_t first, size_t last, unsigned) {
+			for (size_t s = first; s < last; ++s) inverse(x + s * _N);
+		}, nrThreads);
+	}
+
+	// twiddle factor exp(-2 pi i j / N) split in its cosine and sine
+	const Scalar& cosine(size_t j) const noexcept { return _cos[j]; }
+	const Scalar& sine(size_t j) const noexcept { return _sin[j]; }
+
+private:
+	size_t              _N;
+	unsigned            _log2N;
+	std::vector<Scalar> _cos, _sin;
+	std::vector<size_t> _bitrev;
+
+	void check(size_t N) const {
+		if (N != _N) throw std::invalid_argument("fft signal of size " + std::to_string(N) + " does not match the plan size " + std::to_string(_N));
+	}
+
+	void permute(complex* x) const {
+		for (size_t i = 0; i < _N; ++i) {
+			size_t r = _bitrev[i];
+			if (i < r) std::swap(x[i], x[r]);
+		}
+	}
+
+	// (rr, ri) = (ar + i ai) * (br + i bi)
+	static void cmul(const Scalar& ar, const Scalar& ai, const Scalar& br, const Scalar& bi, Scalar& rr, Scalar& ri) {
+		rr = ar * br - ai * bi;
+		ri = ar * bi + ai * br;
+	}
+
+	void transform(complex* x, bool inverse, bool scaled) const {
+		const Scalar half(0.5), quarter(0.25);
+		size_t h = 1;
+		if (_log2N & 1) {
+			for (size_t i = 0; i < _N; i += 2) {
+				Scalar ar = x[i].real(), ai = x[i].imag(), br = x[i + 1].real(), bi = x[i + 1].imag();
+				if (scaled) { ar *= half; ai *= half; br *= half; bi *= half; }
+				x[i] = complex(ar + br, ai + bi);
+				x[i + 1] = complex(ar - br, ai - bi);
+			}
+			h = 2;
+		}
+		// radix-4 stages combine the four sub-transforms A0..A3 of size h at offsets 0, h, 2h, 3h,
+		// which hold the inputs that are 0, 2, 1, 3 mod 4, into a transform of size 4h:
+		//   c1 = W^2 A1, c2 = W A2, c3 = W^3 A3 with W = exp(-2 pi i k / 4h)
+		//   X[k]    = A0 + c1 + (c2 + c3)      X[k + 2h] = A0 + c1 - (c2 + c3)
+		//   X[k+h]  = A0 - c1 - i (c2 - c3)    X[k + 3h] = A0 - c1 + i (c2 - c3)
+		// and the inverse transform flips the sign of i
+		for (; h < _N; h *= 4) {
+			size_t stride = _N / (4 * h);
+			for (size_t block = 0; block < _N; block += 4 * h) {
+				for (size_t k = 0; k < h; ++k) {
+					complex* p = x + block + k;
+					Scalar a0r = p[0].real(), a0i = p[0].imag();
+					Scalar a1r = p[h].real(), a1i = p[h].imag();
+					Scalar a2r = p[2 * h].real(), a2i = p[2 * h].imag();
+					Scalar a3r = p[3 * h].real(), a3i = p[3 * h].imag();
+					if (scaled) {
+						a0r *= quarter; a0i *= quarter; a1r *= quarter; a1i *= quarter;
+						a2r *= quarter; a2i *= quarter; a3r *= quarter; a3i *= quarter;
+					}
+					Scalar c1r, c1i, c2r, c2i, c3r, c3i;
+					if (k == 0) {
+						c1r = a1r; c1i = a1i; c2r = a2r; c2i = a2i; c3r = a3r; c3i = a3i;
+					}
+					else {
+						size_t j = k * stride;
+						Scalar w1i = inverse ? _sin[j] : -_sin[j];
+						Scalar w2i = inverse ? _sin[2 * j] : -_sin[2 * j];
+						Scalar w3i = inverse ? _sin[3 * j] : -_sin[3 * j];
+						cmul(a1r, a1i, _cos[2 * j], w2i, c1r, c1i);
+						cmul(a2r, a2i, _cos[j], w1i, c2r, c2i);
+						cmul(a3r, a3i, _cos[3 * j], w3i, c3r, c3i);
+					}
+					Scalar sr = c2r + c3r, si = c2i + c3i;   // c2 + c3
+					Scalar dr = c2r - c3r, di = c2i - c3i;   // c2 - c3
+					Scalar er = a0r + c1r, ei = a0i + c1i;   // A0 + c1
+					Scalar fr = a0r - c1r, fi = a0i - c1i;   // A0 - c1
+					p[0] = complex(er + sr, ei + si);
+					p[2 * h] = complex(er - sr, ei - si);
+					if (inverse) {
+						p[h] = complex(fr - di, fi + dr);      // f + i d
+						p[3 * h] = complex(fr + di, fi - dr);  // f - i d
+					}
+					else {
+						p[h] = complex(fr + di, fi - dr);      // f - i d
+						p[3 * h] = complex(fr - di, fi + dr);  // f + i d
+					}
+				}
+			}
+		}
+	}
+};
+
+// plan for transforms of real signals of size N: the N/2 + 1 non-redundant bins of the spectrum
+// are computed with a complex transform of size N/2 of the even and odd samples, z[n] = x[2n] + i x[2n+1],
+// followed by a split step X[k] = E[k] + w^k O[k] with E and O the spectra of the even and odd samples
+template<typename Scalar>
+class rfft_plan {
+public:
+	using complex = std::complex<Scalar>;
+
+	explicit rfft_plan(size_t N) : _N{ N }, _half(N < 2 ? 1 : N / 2), _cos(N / 2), _sin(N / 2) {
+		if (N < 2 || (N & (N - 1)) != 0) throw fft_invalid_size(N);
+		constexpr long double two_pi = 6.283185307179586476925286766559005768L;
+		for (size_t k = 0; k < N / 2; ++k) {
+			long double angle = two_pi * static_cast<long double>(k) / static_cast<long double>(N);
+			_cos[k] = Scalar(static_cast<double>(std::cos(angle)));
+			_sin[k] = Scalar(static_cast<double>(std::sin(angle)));
+		}
+	}
+
+	size_t size() const noexcept { return _N; }
+	size_t bins() const noexcept { return _N / 2 + 1; }
+
+	// X[0..N/2] of the real signal x[0..N-1]; scaled computes X / N
+	void forward(const Scalar* x, complex* X, bool scaled = false) const {
+		size_t M = _N / 2;
+		std::vector<complex> z(M);
+		for (size_t n = 0; n < M; ++n) z[n] = complex(x[2 * n], x[2 * n + 1]);
+		if (scaled) _half.forward_scaled(z.data()); else _half.forward(z.data());
+		const Scalar half(scaled ? 0.25 : 0.5);
+		for (size_t k = 0; k <= M; ++k) {
+			const complex& Zk = z[k % M];
+			const complex& Zm = z[(M - k) % M];
+			// E = (Zk + conj(Zm)) / 2, O = -i (Zk - conj(Zm)) / 2
+			Scalar er = (Zk.real() + Zm.real()) * half, ei = (Zk.imag() - Zm.imag()) * half;
+			Scalar or_ = (Zk.imag() + Zm.imag()) * half, oi = (Zm.real() - Zk.real()) * half;
+			Scalar tr, ti;
+			if (k == M) { tr = -or_; ti = -oi; }
+			else { tr = or_ * _cos[k] + oi * _sin[k]; ti = oi * _cos[k] - or_ * _sin[k]; }  // w^k O with w^k = cos - i sin
+			X[k] = complex(er + tr, ei + ti);
+		}
+	}
+	// x[0..N-1] from the spectrum X[0..N/2], scaled by 1/N
+	void inverse(const complex* X, Scalar* x) const {
+		size_t M = _N / 2;
+		std::vector<complex> z(M);
+		const Scalar half(0.5);
+		for (size_t k = 0; k < M; ++k) {
+			const complex& Xk = X[k];
+			const complex& Xm = X[M - k];
+			// E = (Xk + conj(Xm)) / 2, O = conj(w^k) (Xk - conj(Xm)) / 2, Z = E + i O
+			Scalar er = (Xk.real() + Xm.real()) * half, ei = (Xk.imag() - Xm.imag()) * half;
+			Scalar dr = (Xk.real() - Xm.real()) * half, di = (Xk.imag() + Xm.imag()) * half;
+			Scalar or_ = dr * _cos[k] - di * _sin[k], oi = di * _cos[k] + dr * _sin[k];
+			z[k] = complex(er - oi, ei + or_);
+		}
+		_half.inverse(z.data());
+		for (size_t n = 0; n < M; ++n) {
+			x[2 * n] = z[n].real();
+			x[2 * n + 1] = z[n].imag();
+		}
+	}
+
+	std::vector<complex> forward(const std::vector<Scalar>& x, bool scaled = false) const {
+		if (x.size() != _N) throw std::invalid_argument("rfft signal of size " + std::to_string(x.size()) + " does not match the plan size " + std::to_string(_N));
+		std::vector<complex> X(bins());
+		forward(x.data(), X.data(), scaled);
+		return X;
+	}
+	std::vector<Scalar> inverse(const std::vector<complex>& X) const {
+		if (X.size() != bins()) throw std::invalid_argument("rfft spectrum of size " + std::to_string(X.size()) + " does not match the plan size " + std::to_string(bins()));
+		std::vector<Scalar> x(_N);
+		inverse(X.data(), x.data());
+		return x;
+	}
+
+private:
+	size_t              _N;
+	fft_plan<Scalar>    _half;
+	std::vector<Scalar> _cos, _sin;
+};
+
+// linear convolution y = x * h of size x.size() + h.size() - 1 through real transforms:
+// fixed-point formats need log2 of the transform size of headroom for the unscaled forward transforms
+template<typename Scalar>
+std::vector<Scalar> fft_convolve(const std::vector<Scalar>& x, const std::vector<Scalar>& h) {
+	using complex = std::complex<Scalar>;
+	if (x.empty() || h.empty()) return std::vector<Scalar>{};
+	size_t L = x.size() + h.size() - 1;
+	size_t N = fft_size(L < 2 ? 2 : L);
+	rfft_plan<Scalar> plan(N);
+	std::vector<Scalar> xp(N, Scalar(0)), hp(N, Scalar(0));
+	for (size_t i = 0; i < x.size(); ++i) xp[i] = x[i];
+	for (size_t i = 0; i < h.size(); ++i) hp[i] = h[i];
+	std::vector<complex> X = plan.forward(xp), H = plan.forward(hp);
+	for (size_t k = 0; k < X.size(); ++k) {
+		Scalar yr = X[k].real() * H[k].real() - X[k].imag() * H[k].imag();
+		Scalar yi = X[k].real() * H[k].imag() + X[k].imag() * H[k].real();
+		X[k] = complex(yr, yi);
+	}
+	std::vector<Scalar> y = plan.inverse(X);
+	y.resize(L);
+	return y;
+}
+
+// FIR filter y[n] = sum_k taps[k] x[n - k] evaluated by overlap-add of blocks of the signal:
+// the spectrum of the taps is computed once, and every block costs two real transforms of size N
+template<typename Scalar>
+class fft_fir_filter {
+public:
+	using complex = std::complex<Scalar>;
+
+	// the transform size defaults to the smallest power of two that holds twice the number of taps
+	explicit fft_fir_filter(const std::vector<Scalar>& taps, size_t N = 0)
+		: _taps{ taps.size() }, _N{ N == 0 ? fft_size(2 * (taps.empty() ? 1 : taps.size())) : N }, _plan(_N) {
+		if (taps.empty() || _N < taps.size()) throw std::invalid_argument("fft_fir_filter transform size must hold the taps");
+		std::vector<Scalar> hp(_N, Scalar(0));
+		for (size_t i = 0; i < taps.size(); ++i) hp[i] = taps[i];
+		_H = _plan.forward(hp);
+	}
+
+	size_t block_size() const noexcept { return _N - _taps + 1; }
+
+	// filter x from a zero initial state, the output has the size of x
+	std::vector<Scalar> filter(const std::vector<Scalar>& x) const {
+		size_t L = block_size();
+		std::vector<Scalar> y(x.size() + _N, Scalar(0));
+		std::vector<Scalar> block(_N);
+		std::vector<complex> X(_plan.bins());
+		for (size_t start = 0; start < x.size(); start += L) {
+			size_t len = (start + L < x.size() ? L : x.size() - start);
+			for (size_t i = 0; i < _N; ++i) block[i] = (i < len ? x[start + i] : Scalar(0));
+			_plan.forward(block.data(), X.data());
+			for (size_t k = 0; k < X.size(); ++k) {
+				Scalar yr = X[k].real() * _H[k].real() - X[k].imag() * _H[k].imag();
+				Scalar yi = X[k].real() * _H[k].imag() + X[k].imag() * _H[k].real();
+				X[k] = complex(yr, yi);
+			}
+			_plan.inverse(X.data(), block.data());
+			for (size_t i = 0; i < _N; ++i) y[start + i] += block[i];
+		}
+		y.resize(x.size());
+		return y;
+	}
+
+private:
+	size_t               _taps;
+	size_t               _N;
+	rfft_plan<Scalar>    _plan;
+	std::vector<complex> _H;
+};
+
+}}} // namespace sw::universal::dsp
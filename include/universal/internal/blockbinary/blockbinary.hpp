@@ -10,6 +10,7 @@
 #include <string>
 #include <sstream>
 #include <universal/number/shared/specific_value_encoding.hpp>
+#include <universal/native/limb_arithmetic.hpp>
 
 namespace sw { namespace universal {
 
@@ -256,58 +257,15 @@ public:
 #define BLOCKBINARY_FAST_MUL
 #ifdef BLOCKBINARY_FAST_MUL
 	blockbinary& operator*=(const blockbinary& rhs) {
-		if constexpr (NumberType == BinaryNumberType::Signed) {
-			if constexpr (nrBlocks == 1) {
-				_block[0] = static_cast<bt>(_block[0] * rhs.block(0));
-			}
-			else {
-				// is there a better way than upconverting to deal with maxneg in a 2's complement encoding?
-				blockbinary<nbits + 1, BlockType, NumberType> base(*this);
-				blockbinary<nbits + 1, BlockType, NumberType> multiplicant(rhs);
-				bool resultIsNeg = (base.isneg() ^ multiplicant.isneg());
-				if (base.isneg()) {
-					base.twosComplement();
-				}
-				if (multiplicant.isneg()) {
-					multiplicant.twosComplement();
-				}
-				clear();
-				for (unsigned i = 0; i < static_cast<unsigned>(nrBlocks); ++i) {
-					std::uint64_t segment(0);
-					for (unsigned j = 0; j < static_cast<unsigned>(nrBlocks); ++j) {
-						segment += static_cast<std::uint64_t>(base.block(i)) * static_cast<std::uint64_t>(multiplicant.block(j));
-
-						if (i + j < static_cast<unsigned>(nrBlocks)) {
-							segment += _block[i + j];
-							_block[i + j] = static_cast<bt>(segment);
-							segment >>= bitsInBlock;
-						}
-					}
-				}
-				if (resultIsNeg) twosComplement();
-			}
+		if constexpr (nrBlocks == 1) {
+			_block[0] = static_cast<bt>(_block[0] * rhs.block(0));
 		}
-		else {  // unsigned
-			if constexpr (nrBlocks == 1) {
-				_block[0] = static_cast<bt>(_block[0] * rhs.block(0));
-			}
-			else {
-				blockbinary base(*this);
-				blockbinary multiplicant(rhs);
-				clear();
-				for (unsigned i = 0; i < static_cast<unsigned>(nrBlocks); ++i) {
-					std::uint64_t segment(0);
-					for (unsigned j = 0; j < static_cast<unsigned>(nrBlocks); ++j) {
-						segment += static_cast<std::uint64_t>(base.block(i)) * static_cast<std::uint64_t>(multiplicant.block(j));
-
-						if (i + j < static_cast<unsigned>(nrBlocks)) {
-							segment += _block[i + j];
-							_block[i + j] = static_cast<bt>(segment);
-							segment >>= bitsInBlock;
-						}
-					}
-				}
-			}
+		else {
+			// the low nbits of a 2's complement product do not depend on the signs of the operands,
+			// so signed and unsigned encodings share the truncated limb-by-limb product
+			blockbinary product;
+			limb_multiply(product._block, nrBlocks, _block, nrBlocks, rhs._block, nrBlocks);
+			*this = product;
 		}
 		// null any leading bits that fall outside of nbits
 		_block[MSU] = static_cast<bt>(MSU_MASK & _block[MSU]);
@@ -936,25 +894,20 @@ quorem<N, B, T> longdivision(const blockbinary<N, B, T>& _a, const blockbinary<N
 		result.rem = _a; // a % b = a when a / b = 0
 		return result;   // a / b = 0 when b > a
 	}
-	// initialize the long division
-	BlockBinary accumulator = a;
-	// prepare the subtractand
-	BlockBinary subtractand = b;
-	int msb_b = b.msb();
-	int msb_a = a.msb();
-	int shift = msb_a - msb_b;
-	subtractand <<= shift;
-	// long division
-	for (int i = shift; i >= 0; --i) {
-		if (subtractand <= accumulator) {
-			accumulator -= subtractand;
-			result.quo.setbit(static_cast<unsigned>(i));
-		}
-		else {
-			result.quo.setbit(static_cast<unsigned>(i), false);
-		}
-		subtractand >>= 1;
+	// divide the magnitudes a limb at a time
+	constexpr unsigned nrLimbs = BlockBinary::nrBlocks;
+	B aLimbs[nrLimbs], bLimbs[nrLimbs], qLimbs[nrLimbs], rLimbs[nrLimbs];
+	for (unsigned i = 0; i < nrLimbs; ++i) {
+		aLimbs[i] = a.block(i);
+		bLimbs[i] = b.block(i);
 	}
+	limb_divide<nrLimbs, nrLimbs>(qLimbs, rLimbs, aLimbs, bLimbs);
+	BlockBinary quotient, accumulator;
+	for (unsigned i = 0; i < nrLimbs; ++i) {
+		quotient.setblock(i, qLimbs[i]);
+		accumulator.setblock(i, rLimbs[i]);
+	}
+	result.quo = quotient;
 	if (result_negative) {  // take 2's complement
 		result.quo.flip();
 		result.quo += 1;
@@ -987,7 +940,7 @@ inline blockbinary<N + 1, B, T> ursub(const blockbinary<N, B, T>& a, const block
 
 #define TRACE_URMUL 0
 // unrounded multiplication, returns a blockbinary that is of size 2*nbits
-// using brute-force sign-extending of operands to yield correct sign-extended result for 2*nbits 2's complement.
+// using sign-extension of the operands to 2*nbits and a 2*nbits modulo product, which yields the 2's complement result.
 template<unsigned N, typename B, BinaryNumberType T>
 inline blockbinary<2*N, B, T> urmul(const blockbinary<N, B, T>& a, const blockbinary<N, B, T>& b) {
 	using BlockBinary = blockbinary<2 * N, B, T>;
@@ -995,60 +948,45 @@ inline blockbinary<2*N, B, T> urmul(const blockbinary<N, B, T>& a, const blockbi
 	if (a.iszero() || b.iszero()) return result;
 
 	// compute the result
-	BlockBinary signextended_a(a);
-	BlockBinary multiplicant(b);
-#if TRACE_URMUL
-	std::cout << "    " << to_binary(a) << " * " << to_binary(b) << std::endl;
-	std::cout << std::setw(3) << 0 << ' ' << to_binary(multiplicant) << ' ' << to_binary(result) << std::endl;
-#endif
-	for (unsigned i = 0; i < 2*N; ++i) {
-		if (signextended_a.at(i)) {
-			result += multiplicant;
-		}
-		multiplicant <<= 1;
-#if TRACE_URMUL
-		std::cout << std::setw(3) << i << ' ' << to_binary(multiplicant) << ' ' << to_binary(result) << std::endl;
-#endif
-
-	}
+	result = a;
+	result *= BlockBinary(b);
 #if TRACE_URMUL
+	std::cout << "    " << to_binary(a) << " * " << to_binary(b) << '\n';
 	std::cout << "fnl " << to_binary(result) << std::endl;
 #endif
-	//blockbinary<2 * nbits, bt> clipped(result);
-	// since we used operator+=, which enforces the nulling of leading bits
-	// we don't need to null here
 	return result;
 }
 
 // unrounded multiplication, returns a blockbinary that is of size 2*nbits
-// using nbits modulo arithmetic with final sign
+// using a limb-by-limb widening product of the magnitudes with final sign
 template<unsigned N, typename B, BinaryNumberType T>
 inline blockbinary<2 * N, B, T> urmul2(const blockbinary<N, B, T>& a, const blockbinary<N, B, T>& b) {
-	blockbinary<2 * N, B, T> result(0);
+	using Product   = blockbinary<2 * N, B, T>;
+	using Magnitude = blockbinary<N + 1, B, T>;
+	Product result(0);
 	if (a.iszero() || b.iszero()) return result;
 
 	// compute the result
-	bool result_sign = a.sign() ^ b.sign();
-	// normalize both arguments to positive in new size
-	blockbinary<N + 1, B, T> a_new(a); // TODO optimize: now create a, create _a.bb, copy, destroy _a.bb_copy
-	blockbinary<N + 1, B, T> b_new(b);
-	if (a.sign()) a_new.twosComplement();
-	if (b.sign()) b_new.twosComplement();
-	blockbinary<2*N, B, T> multiplicant(b_new);
+	bool a_sign = (T == BinaryNumberType::Signed) && a.sign();
+	bool b_sign = (T == BinaryNumberType::Signed) && b.sign();
+	bool result_sign = a_sign ^ b_sign;
+	// normalize both arguments to positive in new size, which requires expansion by 1-bit to deal with maxneg
+	Magnitude a_new(a);
+	Magnitude b_new(b);
+	if (a_sign) a_new.twosComplement();
+	if (b_sign) b_new.twosComplement();
 
+	B aLimbs[Magnitude::nrBlocks], bLimbs[Magnitude::nrBlocks], cLimbs[Product::nrBlocks];
+	for (unsigned i = 0; i < Magnitude::nrBlocks; ++i) {
+		aLimbs[i] = a_new.block(i);
+		bLimbs[i] = b_new.block(i);
+	}
+	limb_multiply(cLimbs, Product::nrBlocks, aLimbs, Magnitude::nrBlocks, bLimbs, Magnitude::nrBlocks);
+	for (unsigned i = 0; i < Product::nrBlocks; ++i) result.setblock(i, cLimbs[i]);
 #if TRACE_URMUL
-	std::cout << "    " << a_new << " * " << b_new << std::endl;
-	std::cout << std::setw(3) << 0 << ' ' << multiplicant << ' ' << result << std::endl;
-#endif
-	for (unsigned i = 0; i < (N+1); ++i) {
-		if (a_new.at(i)) {
-			result += multiplicant;  // if multiplicant is not the same size as result, the assignment will get sign-extended if the MSB is true, this is not correct because we are assuming unsigned binaries in this loop
-		}
-		multiplicant <<= 1;
-#if TRACE_URMUL
-		std::cout << std::setw(3) << i << ' ' << multiplicant << ' ' << result << std::endl;
+	std::cout << "    " << a_new << " * " << b_new << '\n';
+	std::cout << "mag " << result << '\n';
 #endif
-	}
 	if (result_sign) result.twosComplement();
 #if TRACE_URMUL
 	std::cout << "fnl " << result << std::endl;
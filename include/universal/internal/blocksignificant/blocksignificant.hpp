@@ -11,6 +11,7 @@
 #include <string>
 #include <sstream>
 
+#include <universal/native/limb_arithmetic.hpp>
 #include <universal/internal/blocksignificant/blocksignificant_fwd.hpp>
 
 /*
@@ -250,21 +251,43 @@ public:
 		// since we used operator+=, which enforces the nulling of leading bits
 		// we don't need to null here
 	}
+	// quotient of lhs and rhs with the radix of lhs: the quotient bits are developed a limb at a time
+	// and the remainder is jammed into the lsb so that rounding sees an exact sticky bit
 	void div(const blocksignificant& lhs, const blocksignificant& rhs) noexcept {
-		blocksignificant<nbits, bt> base(lhs);
-		blocksignificant<nbits, bt> divider(rhs);
-		clear();
 		unsigned outputRadix = static_cast<unsigned>(lhs.radix());
 		unsigned fbits = (outputRadix >> 1);
-		for (unsigned i = 0; i <= 2*fbits; ++i) {
-//			std::cout << "base    : " << to_binary(base) << " : " << base << '\n';
-//			std::cout << "divider : " << to_binary(divider) << " : " << divider << '\n';
-			if (divider <= base) {
-				base.sub(base, divider);
-				this->setbit(outputRadix - i);
-			}
-			divider >>= 1;
+		unsigned quotientBits = 2 * fbits;
+		// the dividend lhs << quotientBits needs at most 2 * nbits bits
+		bt u[2 * nrBlocks], v[nrBlocks], q[2 * nrBlocks], r[nrBlocks];
+		unsigned limbShift = quotientBits / bitsInBlock;
+		unsigned bitShift = quotientBits % bitsInBlock;
+		for (unsigned i = 0; i < 2 * nrBlocks; ++i) u[i] = bt(0);
+		for (unsigned i = 0; i < nrBlocks; ++i) {
+			u[i + limbShift] = bt(u[i + limbShift] | bt(lhs._block[i] << bitShift));
+			if (bitShift > 0) u[i + limbShift + 1] = bt(lhs._block[i] >> (bitsInBlock - bitShift));
+			v[i] = rhs._block[i];
+		}
+		limb_divide<2 * nrBlocks, nrBlocks>(q, r, u, v);
+		clear();
+		for (unsigned i = 0; i < nrBlocks; ++i) _block[i] = q[i];
+		_block[MSU] &= MSU_MASK;
+		*this <<= static_cast<int>(outputRadix - quotientBits);
+		bool sticky{ false };
+		for (unsigned i = 0; i < nrBlocks; ++i) sticky |= (r[i] != 0);
+		if (sticky) setbit(0);
+	}
+	// integer square root of the bits of the radicand: the radix of the output is set by the caller,
+	// and a nonzero remainder is jammed into the lsb so that rounding sees an exact sticky bit
+	void sqrt(const blocksignificant& radicand) noexcept {
+		bt root[nrBlocks], rem[nrBlocks];
+		limb_sqrt<nrBlocks>(root, rem, radicand._block);
+		clear();
+		bool sticky{ false };
+		for (unsigned i = 0; i < nrBlocks; ++i) {
+			_block[i] = root[i];
+			sticky |= (rem[i] != 0);
 		}
+		if (sticky) setbit(0);
 	}
 
 #ifdef FRACTION_REMAINDER
@@ -386,8 +409,8 @@ public:
 		}
 		else if constexpr (1 < nrBlocks) {
 			if constexpr (bitsInBlock == 64) {
-				// just set the highest bits with the value provided
-				_block[MSU] = value;
+				_block[0] = value;
+				for (unsigned i = 1; i < nrBlocks; ++i) _block[i] = 0;
 			}
 			else {
 				for (unsigned i = 0; i < nrBlocks; ++i) {
@@ -426,10 +449,7 @@ public:
 	constexpr bool isneg() const noexcept { return sign(); }
 	constexpr bool test(unsigned bitIndex) const noexcept { return at(bitIndex); }
 	constexpr bool at(unsigned bitIndex) const noexcept {
-		if (bitIndex >= nbits) return false;
-		bt word = _block[bitIndex / bitsInBlock];
-		bt mask = bt(1ull << (bitIndex % bitsInBlock));
-		return (word & mask);
+		return (bitIndex < nbits) && (_block[bitIndex / bitsInBlock] & bt(1ull << (bitIndex % bitsInBlock)));
 	}
 	// check carry bit in output of the ALU
 	constexpr bool checkCarry() const noexcept { return at(nbits - 2); }
@@ -42,6 +42,10 @@ namespace sw { namespace universal {
 
 	for multiply
 	unsigned bfbits = 2*fhbits;
+
+	for square root
+	blocksignificant = radicand 1.ffff at radix fbits, scaled up to 0000001.ffffeee at radix 2*(fbits + 3)
+	unsigned bfbits = 2*fbits + 8;
 	*/
 
  // operator specialization tag for blocktriple
@@ -127,7 +131,7 @@ public:
 	static constexpr unsigned mbits    = 2 * fbits;          // size of the fraction bits of the multiplier
 	static constexpr unsigned divbits  = 3 * fbits + 4;      // size of the fraction bits of the divider
 	static constexpr unsigned divshift = divbits - fbits;    // alignment shift for divider operands
-	static constexpr unsigned sqrtbits = 2 * fhbits;      // size of the square root output
+	static constexpr unsigned sqrtbits = 2 * fbits + 8;      // size of the square root radicand: the root carries fbits plus 3 rounding bits
 	// we transform input operands into the operation's target output size
 	// so that everything is aligned correctly before the operation starts.
 	static constexpr unsigned bfbits =
@@ -140,7 +144,7 @@ public:
 		(op == BlockTripleOperator::ADD ? static_cast<int>(abits) :
 			(op == BlockTripleOperator::MUL ? static_cast<int>(mbits) :
 				(op == BlockTripleOperator::DIV ? static_cast<int>(divbits) :
-					(op == BlockTripleOperator::SQRT ? static_cast<int>(sqrtbits) : static_cast<int>(fbits)))));  // REPRESENTATION is the fall through condition
+					(op == BlockTripleOperator::SQRT ? static_cast<int>(fbits + rbits) : static_cast<int>(fbits)))));  // REPRESENTATION is the fall through condition
 //	static constexpr BitEncoding encoding =
 //		(op == BlockTripleOperator::ADD ? BitEncoding::Twos :
 //			(op == BlockTripleOperator::MUL ? BitEncoding::Ones :
@@ -621,6 +625,34 @@ public:
 		}
 	}
 
+	// square root of a normalized, positive argument of the form 1.ffff at radix fbits.
+	// An odd scale moves a bit of the exponent into the radicand, so that the root scale is exact,
+	// and the radicand is scaled so that its integer square root carries fbits plus 3 rounding bits,
+	// with the remainder jammed into the lsb: the root is 1.ffffeee at radix fbits + 3.
+	void sqrt(blocktriple& a) {
+		if (a.iszero()) {
+			clear();
+			return;
+		}
+		int scale = a.scale();
+		int odd = (scale & 1);
+		a._significant <<= static_cast<int>(2 * rbits + fbits) + odd;
+		_significant.sqrt(a._significant);
+		_significant.setradix(radix);
+		_nan = false;
+		_inf = false;
+		_zero = false;
+		_sign = false;
+		_scale = (scale - odd) / 2;
+
+		if constexpr (_trace_btriple_sqrt) {
+			std::cout << "blocktriple sqrt\n";
+			std::cout << typeid(*this).name() << '\n';
+			std::cout << "radicand : " << to_binary(a._significant) << " : " << a._significant << '\n';
+			std::cout << "sqrt     : " << to_binary(*this) << " : " << *this << '\n';
+		}
+	}
+
 private:
 	// special cases to keep track of
 	bool _nan; // most dominant state
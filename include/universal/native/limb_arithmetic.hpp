@@ -0,0 +1,325 @@
+#pragma once
+// limb_arithmetic.hpp: multi-precision multiplication, division, square root, and Montgomery reduction on arrays of native unsigned integer limbs
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <cstdint>
+#include <bit>
+#include <type_traits>
+
+namespace sw { namespace universal {
+
+#if defined(__SIZEOF_INT128__)
+__extension__ typedef unsigned __int128 limb_uint128;
+#endif
+
+// widening multiply-accumulate of a single limb: returns the low limb of a * b + addend + carry
+// and leaves the high limb in carry. The sum cannot overflow two limbs: (2^n - 1)^2 + 2 * (2^n - 1) = 2^2n - 1
+template<typename Limb>
+inline constexpr Limb limb_muladd(Limb a, Limb b, Limb addend, Limb& carry) noexcept {
+	static_assert(std::is_unsigned_v<Limb>, "limbs must be unsigned integers");
+	constexpr unsigned bitsInLimb = sizeof(Limb) * 8;
+	if constexpr (bitsInLimb <= 32) {
+		std::uint64_t t = std::uint64_t(a) * std::uint64_t(b) + std::uint64_t(addend) + std::uint64_t(carry);
+		carry = static_cast<Limb>(t >> bitsInLimb);
+		return static_cast<Limb>(t);
+	}
+	else {
+#if defined(__SIZEOF_INT128__)
+		limb_uint128 t = limb_uint128(a) * limb_uint128(b) + limb_uint128(addend) + limb_uint128(carry);
+		carry = static_cast<Limb>(t >> 64);
+		return static_cast<Limb>(t);
+#else
+		// assemble the 128-bit product from four 32x32->64 bit partial products
+		constexpr std::uint64_t LOW_HALF = 0xFFFF'FFFFull;
+		std::uint64_t aLo = a & LOW_HALF, aHi = a >> 32, bLo = b & LOW_HALF, bHi = b >> 32;
+		std::uint64_t ll = aLo * bLo, lh = aLo * bHi, hl = aHi * bLo, hh = aHi * bHi;
+		std::uint64_t mid = (ll >> 32) + (lh & LOW_HALF) + (hl & LOW_HALF);
+		std::uint64_t lo = (ll & LOW_HALF) | (mid << 32);
+		std::uint64_t hi = hh + (lh >> 32) + (hl >> 32) + (mid >> 32);
+		lo += addend;
+		hi += (lo < addend ? 1 : 0);
+		lo += carry;
+		hi += (lo < carry ? 1 : 0);
+		carry = hi;
+		return lo;
+#endif
+	}
+}
+
+// schoolbook product of the unsigned limb arrays a[0, nrA) and b[0, nrB), least significant limb first:
+// writes the low nrC limbs of the product into c, which must not alias a or b.
+// Partial products that fall entirely outside of c are never formed, so a modulo product of
+// n limbs costs n(n+1)/2 limb multiplies and a full product of n limbs into 2n limbs costs n^2.
+template<typename Limb>
+inline constexpr void limb_multiply(Limb* c, unsigned nrC, const Limb* a, unsigned nrA, const Limb* b, unsigned nrB) noexcept {
+	for (unsigned k = 0; k < nrC; ++k) c[k] = 0;
+	for (unsigned i = 0; i < nrA && i < nrC; ++i) {
+		if (a[i] == 0) continue;
+		Limb carry{ 0 };
+		unsigned last = (nrB < nrC - i ? nrB : nrC - i);
+		for (unsigned j = 0; j < last; ++j) {
+			c[i + j] = limb_muladd(a[i], b[j], c[i + j], carry);
+		}
+		if (i + last < nrC) c[i + last] = carry;
+	}
+}
+
+// double-width integer type that holds the intermediate results of single limb operations
+template<typename Limb> struct limb_wide { using type = std::uint64_t; };
+#if defined(__SIZEOF_INT128__)
+template<> struct limb_wide<std::uint64_t> { using type = limb_uint128; };
+#endif
+template<typename Limb> using limb_wide_t = typename limb_wide<Limb>::type;
+
+// Algorithm D proper: Limb must have a double-width limb_wide_t
+template<unsigned NU, unsigned NV, typename Limb>
+inline void limb_divide_knuth(Limb* q, Limb* r, const Limb* u, const Limb* v) noexcept {
+	constexpr unsigned bitsInLimb = sizeof(Limb) * 8;
+	for (unsigned i = 0; i < NU; ++i) q[i] = 0;
+	for (unsigned i = 0; i < NV; ++i) r[i] = 0;
+	unsigned m = NU; while (m > 0 && u[m - 1] == 0) --m;
+	unsigned n = NV; while (n > 0 && v[n - 1] == 0) --n;
+	if (n == 0) return;  // division by zero is the responsibility of the caller
+	if (m < n) {         // u < v
+		for (unsigned i = 0; i < m; ++i) r[i] = u[i];
+		return;
+	}
+
+	// native division when the dividend fits in 64 bits
+	if (m * bitsInLimb <= 64) {
+		std::uint64_t a{ 0 }, b{ 0 };
+		for (unsigned i = m; i > 0; --i) a = (bitsInLimb < 64 ? (a << (bitsInLimb % 64)) : 0) | std::uint64_t(u[i - 1]);
+		for (unsigned i = n; i > 0; --i) b = (bitsInLimb < 64 ? (b << (bitsInLimb % 64)) : 0) | std::uint64_t(v[i - 1]);
+		std::uint64_t quo = a / b, rem = a % b;
+		for (unsigned i = 0; i < m; ++i) { q[i] = Limb(quo); quo = (bitsInLimb < 64 ? quo >> (bitsInLimb % 64) : 0); }
+		for (unsigned i = 0; i < n; ++i) { r[i] = Limb(rem); rem = (bitsInLimb < 64 ? rem >> (bitsInLimb % 64) : 0); }
+		return;
+	}
+
+	using Wide = limb_wide_t<Limb>;
+	constexpr Wide LIMB_BASE = Wide(1) << bitsInLimb;
+	if (n == 1) {  // short division by a single limb
+		Wide rem{ 0 };
+		for (unsigned j = m; j > 0; --j) {
+			Wide t = (rem << bitsInLimb) | Wide(u[j - 1]);
+			q[j - 1] = Limb(t / v[0]);
+			rem = t % v[0];
+		}
+		r[0] = Limb(rem);
+		return;
+	}
+
+	// normalize so that the most significant limb of the divisor has its top bit set
+	unsigned s = static_cast<unsigned>(std::countl_zero(v[n - 1]));
+	Limb vn[NV], un[NU + 1];
+	// the shifts read the unnormalized operands only, so the limbs are normalized in any order; the bounds on NV
+	// and NU let the compiler prove the stores stay inside the scratch arrays
+	vn[0] = Limb(v[0] << s);
+	for (unsigned i = 1; i < n && i < NV; ++i) vn[i] = Limb(Limb(v[i] << s) | (s ? Limb(v[i - 1] >> (bitsInLimb - s)) : Limb(0)));
+	un[0] = Limb(u[0] << s);
+	for (unsigned i = 1; i < m && i < NU; ++i) un[i] = Limb(Limb(u[i] << s) | (s ? Limb(u[i - 1] >> (bitsInLimb - s)) : Limb(0)));
+	un[m] = (s ? Limb(u[m - 1] >> (bitsInLimb - s)) : Limb(0));
+
+	for (unsigned j = m - n + 1; j > 0; --j) {
+		unsigned k = j - 1;
+		// estimate the quotient limb from the top two limbs of the remainder, off by at most 2
+		Wide numerator = (Wide(un[k + n]) << bitsInLimb) | Wide(un[k + n - 1]);
+		Wide qhat = numerator / vn[n - 1];
+		Wide rhat = numerator % vn[n - 1];
+		while (qhat >= LIMB_BASE || qhat * vn[n - 2] > ((rhat << bitsInLimb) | Wide(un[k + n - 2]))) {
+			--qhat;
+			rhat += vn[n - 1];
+			if (rhat >= LIMB_BASE) break;
+		}
+		// multiply and subtract
+		Limb carry{ 0 }, borrow{ 0 };
+		for (unsigned i = 0; i < n; ++i) {
+			Wide p = qhat * vn[i] + carry;
+			carry = Limb(p >> bitsInLimb);
+			Limb x = un[i + k], y = Limb(p);
+			Limb d = Limb(x - y);
+			Limb b1 = (x < y ? 1 : 0);
+			un[i + k] = Limb(d - borrow);
+			borrow = Limb(b1 | (d < borrow ? 1 : 0));
+		}
+		Limb x = un[k + n];
+		Limb d = Limb(x - carry);
+		Limb b1 = (x < carry ? 1 : 0);
+		un[k + n] = Limb(d - borrow);
+		borrow = Limb(b1 | (d < borrow ? 1 : 0));
+		q[k] = Limb(qhat);
+		if (borrow) {  // the estimate was one too large: add the divisor back
+			q[k] = Limb(q[k] - 1);
+			Limb c{ 0 };
+			for (unsigned i = 0; i < n; ++i) {
+				Wide sum = Wide(un[i + k]) + Wide(vn[i]) + Wide(c);
+				un[i + k] = Limb(sum);
+				c = Limb(sum >> bitsInLimb);
+			}
+			un[k + n] = Limb(un[k + n] + c);
+		}
+	}
+	// denormalize the remainder
+	for (unsigned i = 0; i + 1 < n; ++i) r[i] = Limb(Limb(un[i] >> s) | (s ? Limb(un[i + 1] << (bitsInLimb - s)) : Limb(0)));
+	r[n - 1] = Limb(un[n - 1] >> s);
+}
+
+// quotient and remainder of the unsigned limb arrays u[0, NU) / v[0, NV), least significant limb first:
+// q receives NU limbs and r receives NV limbs; v must not be zero and q and r must not alias u or v.
+// Operands that fit a native integer are divided natively, the others run Knuth's Algorithm D
+// (TAOCP Vol 2, 4.3.1), which develops the quotient a limb at a time instead of a bit at a time.
+template<unsigned NU, unsigned NV, typename Limb>
+inline void limb_divide(Limb* q, Limb* r, const Limb* u, const Limb* v) noexcept {
+	static_assert(std::is_unsigned_v<Limb>, "limbs must be unsigned integers");
+	if constexpr (sizeof(Limb) == 8 && std::is_same_v<limb_wide_t<Limb>, std::uint64_t>) {
+		// no 128-bit integer: run the algorithm on the 32-bit halves of the limbs
+		std::uint32_t uh[2 * NU], vh[2 * NV], qh[2 * NU], rh[2 * NV];
+		for (unsigned i = 0; i < NU; ++i) { uh[2 * i] = std::uint32_t(u[i]); uh[2 * i + 1] = std::uint32_t(u[i] >> 32); }
+		for (unsigned i = 0; i < NV; ++i) { vh[2 * i] = std::uint32_t(v[i]); vh[2 * i + 1] = std::uint32_t(v[i] >> 32); }
+		limb_divide<2 * NU, 2 * NV>(qh, rh, uh, vh);
+		for (unsigned i = 0; i < NU; ++i) q[i] = Limb(qh[2 * i]) | (Limb(qh[2 * i + 1]) << 32);
+		for (unsigned i = 0; i < NV; ++i) r[i] = Limb(rh[2 * i]) | (Limb(rh[2 * i + 1]) << 32);
+	}
+	else {
+		limb_divide_knuth<NU, NV>(q, r, u, v);
+	}
+}
+
+// seeds for isqrt64: entry t is the smallest s with s * s >= 256 * (t + 1), which bounds the square root
+// of any 16-bit value with top byte t from above
+struct isqrt_seed_table {
+	std::uint16_t seed[256];
+	constexpr isqrt_seed_table() : seed{} {
+		std::uint32_t s{ 0 };
+		for (std::uint32_t t = 0; t < 256; ++t) {
+			while (s * s < 256 * (t + 1)) ++s;
+			seed[t] = static_cast<std::uint16_t>(s);
+		}
+	}
+};
+inline constexpr isqrt_seed_table isqrtSeeds{};
+
+// floor of the square root of a 64-bit integer: the top byte of the argument selects a seed that is
+// accurate to 8 bits and never too small, from which Newton's iteration descends monotonically onto
+// the root, doubling the number of correct bits per step
+inline constexpr std::uint64_t isqrt64(std::uint64_t a) noexcept {
+	if (a == 0) return 0;
+	int width = (64 - std::countl_zero(a) + 1) & ~1;  // bit length rounded up to an even number
+	std::uint64_t top = (width >= 8 ? a >> (width - 8) : a << (8 - width));
+	std::uint64_t x = isqrtSeeds.seed[top];
+	int scale = (width - 16) / 2;
+	if (scale >= 0) x <<= scale; else x = (x + (1ull << -scale) - 1) >> -scale;
+	for (;;) {
+		std::uint64_t y = (x + a / x) >> 1;
+		if (y >= x) return x;
+		x = y;
+	}
+}
+
+// floor of the square root of the unsigned limb array a[0, N), least significant limb first:
+// root receives the N limbs of floor(sqrt(a)) and rem the N limbs of a - root^2.
+// Radicands that fit a native integer take the table seeded isqrt64, the others are developed
+// a root bit per step by the digit-by-digit method, which only needs shifts and subtractions.
+template<unsigned N, typename Limb>
+inline constexpr void limb_sqrt(Limb* root, Limb* rem, const Limb* a) noexcept {
+	static_assert(std::is_unsigned_v<Limb>, "limbs must be unsigned integers");
+	constexpr unsigned bitsInLimb = sizeof(Limb) * 8;
+	for (unsigned i = 0; i < N; ++i) { root[i] = 0; rem[i] = 0; }
+	unsigned m = N; while (m > 0 && a[m - 1] == 0) --m;
+	if (m == 0) return;
+
+	if (m * bitsInLimb <= 64) {
+		std::uint64_t v{ 0 };
+		for (unsigned i = m; i > 0; --i) v = (bitsInLimb < 64 ? (v << (bitsInLimb % 64)) : 0) | std::uint64_t(a[i - 1]);
+		std::uint64_t r = isqrt64(v);
+		std::uint64_t d = v - r * r;
+		for (unsigned i = 0; i < m; ++i) {
+			root[i] = Limb(r); r = (bitsInLimb < 64 ? r >> (bitsInLimb % 64) : 0);
+			rem[i] = Limb(d);  d = (bitsInLimb < 64 ? d >> (bitsInLimb % 64) : 0);
+		}
+		return;
+	}
+
+	// bring down the radicand two bits at a time: with root q and remainder r of the leading bits,
+	// the next root bit is set when the remainder can absorb (4q + 1), and r < 2q + 1 stays within N limbs
+	Limb t[N]{};
+	for (unsigned bit = m * bitsInLimb; bit > 0; bit -= 2) {
+		unsigned pair = static_cast<unsigned>((a[(bit - 2) / bitsInLimb] >> ((bit - 2) % bitsInLimb)) & 0x3u);
+		// r = (r << 2) | pair, t = (q << 2) | 1, q <<= 1
+		for (unsigned i = N - 1; i > 0; --i) {
+			rem[i]  = Limb(Limb(rem[i] << 2)  | Limb(rem[i - 1] >> (bitsInLimb - 2)));
+			t[i]    = Limb(Limb(root[i] << 2) | Limb(root[i - 1] >> (bitsInLimb - 2)));
+			root[i] = Limb(Limb(root[i] << 1) | Limb(root[i - 1] >> (bitsInLimb - 1)));
+		}
+		rem[0]  = Limb(Limb(rem[0] << 2) | Limb(pair));
+		t[0]    = Limb(Limb(root[0] << 2) | Limb(1));
+		root[0] = Limb(root[0] << 1);
+		// if r >= t then r -= t and set the root bit
+		bool geq{ true };
+		for (unsigned i = N; i > 0; --i) {
+			if (rem[i - 1] != t[i - 1]) { geq = rem[i - 1] > t[i - 1]; break; }
+		}
+		if (geq) {
+			Limb borrow{ 0 };
+			for (unsigned i = 0; i < N; ++i) {
+				Limb x = rem[i], y = t[i];
+				Limb d = Limb(x - y);
+				Limb b1 = (x < y ? 1 : 0);
+				rem[i] = Limb(d - borrow);
+				borrow = Limb(b1 | (d < borrow ? 1 : 0));
+			}
+			root[0] = Limb(root[0] | Limb(1));
+		}
+	}
+}
+
+// -m^-1 mod 2^n of the low limb m of an odd modulus: Newton's iteration x <- x(2 - mx) doubles the number
+// of correct low bits per step, and x = m is already correct to 3 bits because m * m = 1 mod 8 for all odd m
+template<typename Limb>
+inline constexpr Limb limb_montgomery_inverse(Limb m) noexcept {
+	static_assert(std::is_unsigned_v<Limb>, "limbs must be unsigned integers");
+	Limb x = m;
+	for (unsigned bits = 3; bits < sizeof(Limb) * 8; bits *= 2) x = Limb(x * Limb(Limb(2) - Limb(m * x)));
+	return Limb(Limb(0) - x);
+}
+
+// Montgomery product r = a * b / 2^(n * bitsInLimb) mod m of the n-limb residues a, b < m of an odd modulus m,
+// with minv = limb_montgomery_inverse(m[0]): the coarsely integrated operand scanning (CIOS) method of
+// Koc, Acar, and Kaliski interleaves every row of the schoolbook product with a limb of the reduction, so
+// the scratch space t of n + 2 limbs never holds more than one row. r may alias a or b.
+template<typename Limb>
+inline constexpr void limb_montgomery_multiply(Limb* r, const Limb* a, const Limb* b, const Limb* m, unsigned n, Limb minv, Limb* t) noexcept {
+	for (unsigned i = 0; i < n + 2; ++i) t[i] = 0;
+	for (unsigned i = 0; i < n; ++i) {
+		Limb carry{ 0 };
+		for (unsigned j = 0; j < n; ++j) t[j] = limb_muladd(a[j], b[i], t[j], carry);
+		t[n] = Limb(t[n] + carry);
+		t[n + 1] = Limb(t[n] < carry ? 1 : 0);
+		// add the multiple of m that clears the low limb and shift the row down by one limb
+		Limb q = Limb(t[0] * minv);
+		carry = 0;
+		limb_muladd(q, m[0], t[0], carry);
+		for (unsigned j = 1; j < n; ++j) t[j - 1] = limb_muladd(q, m[j], t[j], carry);
+		t[n - 1] = Limb(t[n] + carry);
+		t[n] = Limb(t[n + 1] + (t[n - 1] < carry ? 1 : 0));
+	}
+	// t < 2m: a single conditional subtraction completes the reduction. The subtraction always runs and its
+	// result is selected by a mask, so the sequence of operations does not depend on the operands
+	Limb borrow{ 0 };
+	for (unsigned i = 0; i < n; ++i) {
+		Limb x = t[i], y = m[i];
+		Limb d = Limb(x - y);
+		Limb b1 = (x < y ? 1 : 0);
+		t[i] = Limb(d - borrow);
+		borrow = Limb(b1 | (d < borrow ? 1 : 0));
+		r[i] = x;
+	}
+	// t - m is negative when the borrow out of the top limb exceeds t[n]
+	Limb keep = Limb(Limb(0) - Limb(borrow > t[n] ? 1 : 0));
+	for (unsigned i = 0; i < n; ++i) r[i] = Limb((r[i] & keep) | (t[i] & Limb(~keep)));
+}
+
+}} // namespace sw::universal
@@ -44,11 +44,19 @@
 #endif
 #endif
 
+////////////////////////////////////////////////////////////////////////////////////////
+// enable native integer arithmetic for cfloats of 16 bits or less
+// the small configurations bypass the blocktriple and compute the sum, product, or quotient
+// with machine integer operations, producing the same bits as the blocktriple path
+#if !defined(CFLOAT_NATIVE_ARITHMETIC)
+#define CFLOAT_NATIVE_ARITHMETIC 1
+#endif
+
 ////////////////////////////////////////////////////////////////////////////////////////
 // enable native sqrt implementation
 // 
 #if !defined(CFLOAT_NATIVE_SQRT)
-#define CFLOAT_NATIVE_SQRT 0
+#define CFLOAT_NATIVE_SQRT 1
 #endif
 
 ///////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,75 @@
+#pragma once
+// cfloat_c_batch.h: vectorized C API for common cfloat formats, exported by the shared library universal_c
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <stddef.h>
+#include <stdint.h>
+
+#ifndef UNIVERSAL_C_EXPORT
+#if defined(_WIN32) && defined(UNIVERSAL_C_BUILDING)
+#define UNIVERSAL_C_EXPORT __declspec(dllexport)
+#elif defined(_WIN32)
+#define UNIVERSAL_C_EXPORT __declspec(dllimport)
+#elif defined(__GNUC__)
+#define UNIVERSAL_C_EXPORT __attribute__((visibility("default")))
+#else
+#define UNIVERSAL_C_EXPORT
+#endif
+#endif
+
+#ifdef __cplusplus
+// export a C interface if used by C++ source code
+extern "C" {
+#endif
+
+	//////////////////////////////////////////////////////////////////////
+	/// IEEE-754 compatible cfloat configurations: subnormals, no supernormals, not saturating
+	typedef union fp16_u {
+		uint8_t x[2];
+		uint16_t v;
+	}							fp16_t;		// cfloat<16,5>, IEEE-754 binary16
+	typedef union bfloat16_u {
+		uint8_t x[2];
+		uint16_t v;
+	}							bfloat16_t;	// cfloat<16,8>, Google Brain float
+	typedef union fp32_u {
+		uint8_t x[4];
+		uint32_t v;
+	}							fp32_t;		// cfloat<32,8>, IEEE-754 binary32
+
+/*
+ * The batch entry points mirror the posit batch API of posit_c_batch.h: fp16 and bfloat16 use the native
+ * integer arithmetic of the 16-bit cfloats, and the encoding of fp32 is IEEE-754 binary32, so its arithmetic
+ * runs on the hardware. The fused dot product adds the exact products, which are floats, in a Kulisch
+ * accumulator and rounds the sum once.
+ *
+ *   T_from_doubles(in, out, n)        out[i] = T(in[i])
+ *   T_to_doubles(in, out, n)          out[i] = double(in[i])
+ *   T_dot(x, y, n)                    sum of x[i] * y[i], rounded after every operation
+ *   T_fdot(x, y, n)                   sum of x[i] * y[i], accumulated exactly
+ *   T_axpy(a, x, y, n)                y[i] = a * x[i] + y[i]
+ *   T_gemm(m, n, k, alpha, A, B, beta, C)
+ *                                     C = alpha * A * B + beta * C, row-major, with A m-by-k, B k-by-n, and
+ *                                     C m-by-n; C is not read when beta is zero
+ */
+#define CFLOAT_BATCH_API(T) \
+	UNIVERSAL_C_EXPORT void T##_from_doubles(const double* in, T##_t* out, size_t n); \
+	UNIVERSAL_C_EXPORT void T##_to_doubles(const T##_t* in, double* out, size_t n); \
+	UNIVERSAL_C_EXPORT T##_t T##_dot(const T##_t* x, const T##_t* y, size_t n); \
+	UNIVERSAL_C_EXPORT T##_t T##_fdot(const T##_t* x, const T##_t* y, size_t n); \
+	UNIVERSAL_C_EXPORT void T##_axpy(T##_t a, const T##_t* x, T##_t* y, size_t n); \
+	UNIVERSAL_C_EXPORT void T##_gemm(size_t m, size_t n, size_t k, T##_t alpha, const T##_t* A, \
+		const T##_t* B, T##_t beta, T##_t* C);
+
+CFLOAT_BATCH_API(fp16)
+CFLOAT_BATCH_API(bfloat16)
+CFLOAT_BATCH_API(fp32)
+
+#undef CFLOAT_BATCH_API
+
+#ifdef __cplusplus
+}
+#endif
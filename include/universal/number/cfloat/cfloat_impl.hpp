@@ -27,6 +27,7 @@
 #include <universal/number/shared/nan_encoding.hpp>
 #include <universal/number/shared/infinite_encoding.hpp>
 #include <universal/number/shared/specific_value_encoding.hpp>
+#include <universal/number/shared/encoding_table.hpp>
 // arithmetic tracing options
 #include <universal/number/algorithm/trace_constants.hpp>
 // cfloat exception structure
@@ -292,6 +293,20 @@ inline /*constexpr*/ void convert(const blocktriple<srcbits, op, bt>& src, cfloa
 				std::cerr << "exponent value is out of range: " << exponent << '\n';
 			}
 			//std::cout << "add exponent  : " << to_binary(tgt) << '\n';
+			if (alignment.first) {
+				// round up the magnitude: the next encoding carries a fraction overflow into the exponent
+				tgt.setsign(false);
+				++tgt;
+				tgt.setsign(src.sign());
+				if (tgt.isnan()) {
+					if constexpr (isSaturating) {
+						if (src.sign()) tgt.maxneg(); else tgt.maxpos();
+					}
+					else {
+						tgt.setinf(src.sign());
+					}
+				}
+			}
 		}
 	}
 }
@@ -358,6 +373,9 @@ public:
 	static constexpr bool     hasSubnormals   = _hasSubnormals;
 	static constexpr bool     hasSupernormals = _hasSupernormals;
 	static constexpr bool     isSaturating    = _isSaturating;
+	// configurations of 16 bits or less have significands that fit comfortably in a machine word,
+	// so their arithmetic is carried out with native integer operations instead of blocktriples
+	static constexpr bool     NATIVE_ARITHMETIC = (CFLOAT_NATIVE_ARITHMETIC != 0) && (nbits <= 16) && (nrBlocks <= 2);
 	typedef bt BlockType;
 
 	// constructors
@@ -484,6 +502,13 @@ public:
 
 	cfloat& operator+=(const cfloat& rhs) CFLOAT_EXCEPT {
 		if constexpr (_trace_add) std::cout << "---------------------- ADD -------------------" << std::endl;
+		// finite, nonzero operands of small configurations take the native integer path
+		if constexpr (NATIVE_ARITHMETIC) {
+			if (isnativeregular() && rhs.isnativeregular()) {
+				nativeAddition(rhs);
+				return *this;
+			}
+		}
 		// special case handling of the inputs
 #if CFLOAT_THROW_ARITHMETIC_EXCEPTION
 		if (isnan(NAN_TYPE_SIGNALLING) || rhs.isnan(NAN_TYPE_SIGNALLING)) {
@@ -558,6 +583,13 @@ public:
 	}
 	cfloat& operator*=(const cfloat& rhs) CFLOAT_EXCEPT {
 		if constexpr (_trace_mul) std::cout << "---------------------- MUL -------------------\n";
+		// finite, nonzero operands of small configurations take the native integer path
+		if constexpr (NATIVE_ARITHMETIC) {
+			if (isnativeregular() && rhs.isnativeregular()) {
+				nativeMultiplication(rhs);
+				return *this;
+			}
+		}
 		// special case handling of the inputs
 #if CFLOAT_THROW_ARITHMETIC_EXCEPTION
 		if (isnan(NAN_TYPE_SIGNALLING) || rhs.isnan(NAN_TYPE_SIGNALLING)) {
@@ -624,6 +656,13 @@ public:
 	}
 	cfloat& operator/=(const cfloat& rhs) CFLOAT_EXCEPT {
 		if constexpr (_trace_div) std::cout << "---------------------- DIV -------------------" << std::endl;
+		// finite, nonzero operands of small configurations take the native integer path
+		if constexpr (NATIVE_ARITHMETIC) {
+			if (isnativeregular() && rhs.isnativeregular()) {
+				nativeDivision(rhs);
+				return *this;
+			}
+		}
 
 		// special case handling of the inputs
 		// qnan / qnan = qnan
@@ -1834,7 +1873,16 @@ public:
 	// A more accurate approximation would require an adaptive precision algorithm
 	// with a final rounding step.
 	template<typename TargetFloat>
-	TargetFloat to_native() const { 
+	TargetFloat to_native() const {
+		if constexpr (nbits <= max_implicit_encoding_table_nbits && std::is_same_v<TargetFloat, double>) {
+			return value_table().value(encoding());
+		}
+		else {
+			return arithmetic_to_native<TargetFloat>();
+		}
+	}
+	template<typename TargetFloat>
+	TargetFloat arithmetic_to_native() const { 
 		TargetFloat v{ 0.0 };
 		if (iszero()) {
 			// the optimizer might destroy the sign
@@ -2177,6 +2225,44 @@ public:
 		tgt.setradix(blocktriple<fbits, BlockTripleOperator::DIV, bt>::radix);
 	}
 
+	// normalize a positive cfloat to a blocktriple used in sqrt, which has the form 0'00000'00001.fffff
+	// that is 2*fbits + 8 bits, with the radix set at <fbits>: blocktriple::sqrt scales the radicand
+	// into the upper bits, and the result radix will go to fbits + 3.
+	constexpr void normalizeSqrt(blocktriple<fbits, BlockTripleOperator::SQRT, bt>& tgt) const {
+		// test special cases
+		if (isnan()) {
+			tgt.setnan();
+		}
+		else if (isinf()) {
+			tgt.setinf();
+		}
+		else if (iszero()) {
+			tgt.setzero();
+		}
+		else {
+			tgt.setnormal(); // a blocktriple is always normalized
+			int scale = this->scale();
+			tgt.setsign(sign());
+			tgt.setscale(scale);
+			bool subnormal = !(isnormal() || issupernormal());
+			if (subnormal && !hasSubnormals) {
+				tgt.setzero(tgt.sign()); // this cfloat has no subnormals
+			}
+			else if constexpr (fbits < 64) {
+				uint64_t raw = fraction_ull();
+				if (subnormal) raw <<= (MIN_EXP_NORMAL - scale);
+				raw |= (1ull << fbits);
+				tgt.setbits(raw);
+			}
+			else {
+				blockcopy(tgt);
+				if (subnormal) tgt.bitShift(MIN_EXP_NORMAL - scale);
+				tgt.setbit(fbits); // add the hidden bit
+			}
+		}
+		tgt.setradix(fbits);
+	}
+
 	// helper debug function
 	void constexprClassParameters() const noexcept {
 		std::cout << "-------------------------------------------------------------\n";
@@ -2845,6 +2931,222 @@ public:
 
 protected:
 
+	// raw bits of a configuration of 64 bits or less
+	constexpr uint64_t encoding() const noexcept {
+		uint64_t raw{ 0 };
+		for (unsigned b = 0; b < nrBlocks; ++b) raw |= (uint64_t(_block[b]) << (b * bitsInBlock));
+		return raw;
+	}
+
+	// values of all encodings: the conversion from double is a few bit manipulations, faster than a search of the table
+	static const encoding_table<nbits>& value_table() {
+		static const encoding_table<nbits> table(
+			[](uint64_t raw) { cfloat v; v.setbits(raw); return v.template arithmetic_to_native<double>(); });
+		return table;
+	}
+
+	///////////////////////////////////////////////////////////////////////////
+	// native integer arithmetic for configurations of 16 bits or less
+	// The significands of the operands are at most 15 bits, so the exact sum and product, 
+	// and a quotient with enough bits for guard, round, and sticky, fit in a uint64_t.
+	// The rounding replicates convert(blocktriple, cfloat) so the results are bit-identical
+	// to the blocktriple path. Preconditions: both operands are finite and nonzero.
+
+	// the encoding as a native unsigned integer
+	constexpr uint32_t nativeBits() const noexcept {
+		uint32_t raw = uint32_t(_block[0]);
+		if constexpr (nrBlocks > 1) raw |= uint32_t(_block[1]) << bitsInBlock;
+		return raw;
+	}
+
+	// a finite, nonzero encoding, that is, an operand that needs no special case handling
+	constexpr bool isnativeregular() const noexcept {
+		constexpr uint32_t ENCODING_MASK = (0xFFFF'FFFFul >> (33 - nbits)); // all bits except the sign
+		uint32_t raw = nativeBits() & ENCODING_MASK;
+		uint32_t biasedExponent = raw >> fbits;
+		if (biasedExponent == ALL_ONES_ES) {
+			// all-ones exponent encodings are NaN or Inf, unless they are supernormals
+			if constexpr (hasSupernormals) return (raw & ALL_ONES_FR) < INF_ENCODING; else return false;
+		}
+		if constexpr (hasSubnormals) return raw != 0; else return biasedExponent != 0;
+	}
+
+	// decode the significand, including the hidden bit, and the scale of its lsb
+	constexpr uint64_t nativeSignificand(int& lsbScale) const noexcept {
+		uint32_t raw = nativeBits();
+		uint32_t biasedExponent = (raw >> fbits) & ALL_ONES_ES;
+		uint64_t significand = raw & ALL_ONES_FR;
+		if (biasedExponent == 0) {
+			lsbScale = MIN_EXP_NORMAL - static_cast<int>(fbits);
+		}
+		else {
+			significand |= (1ull << fbits);
+			lsbScale = static_cast<int>(biasedExponent) - EXP_BIAS - static_cast<int>(fbits);
+		}
+		return significand;
+	}
+
+	constexpr void nativeAddition(const cfloat& rhs) noexcept {
+		// any alignment beyond this shift leaves the smaller operand entirely below the 
+		// rounding position of the result, where it only contributes a sticky bit
+		constexpr int maxAlignment = 40;
+		int lhsScale{ 0 }, rhsScale{ 0 };
+		uint64_t lhsSignificand = nativeSignificand(lhsScale);
+		uint64_t rhsSignificand = rhs.nativeSignificand(rhsScale);
+		bool lhsSign = sign();
+		bool rhsSign = rhs.sign();
+		if (lhsScale < rhsScale) {
+			std::swap(lhsScale, rhsScale);
+			std::swap(lhsSignificand, rhsSignificand);
+			std::swap(lhsSign, rhsSign);
+		}
+		int alignment = lhsScale - rhsScale;
+		if (alignment > maxAlignment) {
+			rhsSignificand = 1;
+			rhsScale = lhsScale - maxAlignment;
+			alignment = maxAlignment;
+		}
+		lhsSignificand <<= alignment;
+		uint64_t magnitude{ 0 };
+		bool resultSign = lhsSign;
+		if (lhsSign == rhsSign) {
+			magnitude = lhsSignificand + rhsSignificand;
+		}
+		else if (lhsSignificand >= rhsSignificand) {
+			magnitude = lhsSignificand - rhsSignificand;
+		}
+		else {
+			magnitude = rhsSignificand - lhsSignificand;
+			resultSign = rhsSign;
+		}
+		if (magnitude == 0) {
+			setzero();  // exact cancellation yields +0
+			return;
+		}
+		nativeRound(resultSign, magnitude, rhsScale);
+	}
+
+	constexpr void nativeMultiplication(const cfloat& rhs) noexcept {
+		int lhsScale{ 0 }, rhsScale{ 0 };
+		uint64_t lhsSignificand = nativeSignificand(lhsScale);
+		uint64_t rhsSignificand = rhs.nativeSignificand(rhsScale);
+		nativeRound(sign() != rhs.sign(), lhsSignificand * rhsSignificand, lhsScale + rhsScale);
+	}
+
+	constexpr void nativeDivision(const cfloat& rhs) noexcept {
+		// scale the dividend so that the quotient carries at least fhbits + 2 bits, 
+		// even for a subnormal dividend, and append the remainder as a sticky bit
+		constexpr int divShift = 2 * static_cast<int>(fhbits) + 2;
+		int lhsScale{ 0 }, rhsScale{ 0 };
+		uint64_t dividend = nativeSignificand(lhsScale) << divShift;
+		uint64_t divisor = rhs.nativeSignificand(rhsScale);
+		uint64_t quotient = dividend / divisor;
+		bool sticky = (dividend % divisor) != 0;
+		quotient = (quotient << 1) | (sticky ? 1ull : 0ull);
+		nativeRound(sign() != rhs.sign(), quotient, lhsScale - rhsScale - divShift - 1);
+	}
+
+	constexpr void nativeSqrt() noexcept {
+		// normalize the significand so that its integer square root carries fhbits + 3 bits,
+		// and make the scale even, so that the scale of the root is exact: the remainder is
+		// appended as a sticky bit. The radicand has at most 2*fhbits + 7 <= 37 bits
+		// and its root is computed by the table seeded isqrt64
+		constexpr int rootBits = static_cast<int>(fhbits) + 3;
+		int lsbScale{ 0 };
+		uint64_t radicand = nativeSignificand(lsbScale);
+		int shift = 2 * rootBits - static_cast<int>(find_msb(radicand));
+		if ((lsbScale - shift) & 1) ++shift;
+		radicand <<= shift;
+		lsbScale -= shift;
+		uint64_t root = isqrt64(radicand);
+		bool sticky = (radicand != root * root);
+		root = (root << 1) | (sticky ? 1ull : 0ull);
+		nativeRound(false, root, lsbScale / 2 - 1);
+	}
+
+	// round the value (-1)^sign * significand * 2^lsbScale to the nearest encoding, ties to even
+	constexpr void nativeRound(bool sign, uint64_t significand, int lsbScale) noexcept {
+		int exponent = lsbScale + static_cast<int>(find_msb(significand)) - 1;
+		// special case of underflow
+		if constexpr (hasSubnormals) {
+			if (exponent < MIN_EXP_SUBNORMAL) {
+				setzero();
+				// anything above the halfway point between 0 and minpos rounds up to minpos
+				if (exponent == (MIN_EXP_SUBNORMAL - 1) && (significand & (significand - 1))) ++(*this);
+				setsign(sign);
+				return;
+			}
+		}
+		else {
+			if (exponent + EXP_BIAS <= 0) {  // value is in the subnormal range, which maps to 0
+				setzero();
+				setsign(sign);
+				return;
+			}
+		}
+		// special case of overflow
+		if (exponent > MAX_EXP) {
+			if constexpr (isSaturating) {
+				if (sign) maxneg(); else maxpos();
+			}
+			else {
+				setinf(sign);
+			}
+			return;
+		}
+
+		uint64_t biasedExponent{ 0 };
+		int targetScale{ 0 };  // scale of the lsb of the target encoding
+		if (hasSubnormals && exponent < MIN_EXP_NORMAL) {
+			targetScale = MIN_EXP_NORMAL - static_cast<int>(fbits);
+		}
+		else {
+			biasedExponent = static_cast<uint64_t>(exponent + EXP_BIAS);
+			targetScale = exponent - static_cast<int>(fbits);
+		}
+		uint64_t fracbits{ 0 };
+		bool roundup{ false };
+		int rightShift = targetScale - lsbScale;
+		if (rightShift > 0) {
+			uint64_t lsbMask = (1ull << rightShift);
+			uint64_t guardMask = (lsbMask >> 1);
+			bool lsb = (significand & lsbMask);
+			bool guard = (significand & guardMask);
+			bool sticky = (significand & (guardMask - 1ull));  // round and sticky bits
+			roundup = guard && (lsb || sticky);
+			fracbits = significand >> rightShift;
+		}
+		else {
+			fracbits = significand << -rightShift;
+		}
+		fracbits &= ALL_ONES_FR; // remove the hidden bit
+		if (roundup) ++fracbits;
+		if (fracbits == (1ull << fbits)) { // check for overflow
+			if (biasedExponent == ALL_ONES_ES) {
+				fracbits = INF_ENCODING; // project to INF
+			}
+			else {
+				++biasedExponent;
+				fracbits = 0;
+			}
+		}
+		uint64_t raw = (sign ? 1ull : 0ull);
+		raw <<= es;
+		raw |= biasedExponent;
+		raw <<= fbits;
+		raw |= fracbits;
+		setbits(raw);
+		if (biasedExponent == ALL_ONES_ES && isnan()) {
+			// when you get too far, map it back to +-inf, or to maxpos/maxneg when saturating
+			if constexpr (isSaturating) {
+				if (sign) maxneg(); else maxpos();
+			}
+			else {
+				setinf(sign);
+			}
+		}
+	}
+
 	/// <summary>
 	/// round a set of source bits to the present representation.
 	/// srcbits is the number of bits of significant in the source representation
@@ -3106,6 +3408,9 @@ private:
 	template<unsigned nnbits, unsigned nes, typename nbt, bool nsub, bool nsup, bool nsat>
 	friend std::istream& operator>> (std::istream& istr, cfloat<nnbits,nes,nbt,nsub,nsup,nsat>& r);
 
+	template<unsigned nnbits, unsigned nes, typename nbt, bool nsub, bool nsup, bool nsat>
+	friend cfloat<nnbits,nes,nbt,nsub,nsup,nsat> sqrt(const cfloat<nnbits,nes,nbt,nsub,nsup,nsat>& a);
+
 	template<unsigned nnbits, unsigned nes, typename nbt, bool nsub, bool nsup, bool nsat>
 	friend bool operator==(const cfloat<nnbits,nes,nbt,nsub,nsup,nsat>& lhs, const cfloat<nnbits,nes,nbt,nsub,nsup,nsat>& rhs);
 	template<unsigned nnbits, unsigned nes, typename nbt, bool nsub, bool nsup, bool nsat>
@@ -9,7 +9,7 @@
 #include <universal/number/cfloat/math/sqrt_tables.hpp>
 
 #ifndef CFLOAT_NATIVE_SQRT
-#define CFLOAT_NATIVE_SQRT 0
+#define CFLOAT_NATIVE_SQRT 1
 #endif
 
 namespace sw { namespace universal {
@@ -76,16 +76,36 @@ namespace sw { namespace universal {
 
 
 #if CFLOAT_NATIVE_SQRT
-	// sqrt for arbitrary cfloat
+	// correctly rounded sqrt for arbitrary cfloat: the configurations of the NATIVE_ARITHMETIC gate, that is
+	// CFLOAT_NATIVE_ARITHMETIC set, nbits <= 16, and at most two blocks, take the table seeded integer square root
+	// of the significand; all wider configurations take the digit-by-digit square root of a blocktriple
 	template<unsigned nbits, unsigned es, typename bt, bool hasSubnormal, bool hasSupernormal, bool isSaturating>
 	inline cfloat<nbits, es, bt, hasSubnormal, hasSupernormal, isSaturating> sqrt(const cfloat<nbits, es, bt, hasSubnormal, hasSupernormal, isSaturating>& a) {
+		using Cfloat = cfloat<nbits, es, bt, hasSubnormal, hasSupernormal, isSaturating>;
+		if (a.isnan() || a.iszero()) return a;  // sqrt(-0) = -0
+		if (a.isneg()) {
 #if CFLOAT_THROW_ARITHMETIC_EXCEPTION
-		if (a.isneg()) throw cfloat_negative_sqrt_arg();
+			throw cfloat_negative_sqrt_arg();
 #else
-		if (a.isneg()) std::cerr << "cfloat argument to sqrt is negative: " << a << std::endl;
+			std::cerr << "cfloat argument to sqrt is negative: " << a << std::endl;
+			Cfloat nan;
+			nan.setnan(NAN_TYPE_QUIET);
+			return nan;
 #endif
-		if (a.iszero()) return a;
-		return cfloat<nbits, es, bt, hasSubnormal, hasSupernormal, isSaturating>(std::sqrt((double)a));  // TBD
+		}
+		if (a.isinf()) return a;
+		Cfloat root(a);
+		if constexpr (Cfloat::NATIVE_ARITHMETIC) {
+			if (a.isnativeregular()) {
+				root.nativeSqrt();
+				return root;
+			}
+		}
+		blocktriple<Cfloat::fbits, BlockTripleOperator::SQRT, bt> radicand, result;
+		a.normalizeSqrt(radicand);
+		result.sqrt(radicand);
+		convert(result, root);
+		return root;
 	}
 #else
 	template<unsigned nbits, unsigned es, typename bt, bool hasSubnormal, bool hasSupernormal, bool isSaturating>
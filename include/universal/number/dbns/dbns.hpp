@@ -57,6 +57,6 @@
 
 ///////////////////////////////////////////////////////////////////////////////////////
 /// math functions
-//#include <universal/number/dbns/mathlib.hpp>
+#include <universal/number/dbns/mathlib.hpp>
 
 #endif // _DBNS_STANDARD_HEADER_
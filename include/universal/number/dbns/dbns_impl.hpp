@@ -537,6 +537,113 @@ public:
 		uint32_t e1 = extractExponent(1);
 		return static_cast<int>(e0 + e1 * log2of3);
 	}
+	// log2|x| of a nonzero value: x = (-1)^s * 0.5^a * 3^b
+	constexpr double log2magnitude() const noexcept {
+		return -double(extractExponent(0)) + double(extractExponent(1)) * log2of3;
+	}
+	// set the sign and the exponent pair (a, b) that best approximates log2|x| = scale
+	CONSTEXPRESSION dbns& set_log2(bool s, double scale) noexcept {
+		using std::abs;
+		using std::pow;
+		using std::round;
+		// we search for the a and b in v = 2^a * 3^b, with both a and b positive
+		// in our representation we have 0.5^a * 3^b, which would be equivalent
+		// to a being negative
+		// 
+		// v = 2^a * 3^b =>
+		// v = 2^(a + b*log2of3) =>
+		// scale of v = (a + b*log2of3)
+		// we use this relationship to search among the second base exponents 
+		// and find a first base exponent that minimizes the error
+		// between the result and the value we are trying to approximate.
+		// beyond the dynamic range the value saturates to maxpos or underflows to 0 without a search
+		constexpr double range = double(MAX_A) + double(MAX_B) * log2of3 + 1.0;
+		if (scale != scale) { setnan(); return *this; }
+		if (scale >= range) { maxpos(); setsign(s); return *this; }
+		if (scale <= -range) { setzero(); return *this; }
+		constexpr bool bDebug = false;
+		if constexpr (bDebug) std::cout << "scale : " << scale << '\n';
+		double lowestError = 1.0e10;
+		bool found{ false };
+		int best_a{ 0 };
+		int best_b{ 0 };
+		for (int b = 0; b <= static_cast<int>(SB_MASK); ++b) {
+			int a = static_cast<int>(round((scale - b * log2of3))); // find the first base exponent that is closest to the value
+			if (a > 0 || a > static_cast<int>(MAX_A)) {
+				if constexpr (bCollectDbnsEventStatistics) ++dbnsStats.exponentOverflowDuringSearch;
+				continue;
+			}
+			double err = abs(scale - (a + b * log2of3));
+			if constexpr (bDebug) {
+				double fb = pow(2.0, a);
+				double sb = pow(3.0, b);
+				double value = fb * sb;
+				std::cout << "a : " << a << " b : " << b << " err : " << err << " fb : " << fb << " sb : " << sb << " value : " << value << '\n';
+			}
+			if (err < lowestError) {
+				lowestError = err;
+				best_a = a;
+				best_b = b;
+				found = true;
+			}
+		}
+		if constexpr (bDebug) std::cout << "best a : " << best_a << " best b : " << best_b << " lowest err : " << lowestError << '\n';
+		if (!found) {
+			// no exponent pair approximates the scale: it lies just beyond maxpos or minpos
+			if (scale > 0) { maxpos(); setsign(s); }
+			else setzero();
+			return *this;
+		}
+		assert(best_b >= 0); // second exponent is negative
+		clear();
+		int a = -best_a;
+		int b = best_b;
+		if (a < 0 || a > static_cast<int>(MAX_A) || b > static_cast<int>(MAX_B)) {
+			// try to project the value back into valid pairs
+			// the approximations of unity looks like (8,-5), (19,-12), (84,-53),... 
+			// they grow too fast and in a rather irregular manner. There are more 
+			// subtle number theoretic considerations, but the ones outlined above 
+			// should be sufficient to figure out a good solution to the problem.
+			// 2^3*3^-2 = 0.888  2^-3*3^2 = 1.125
+			// 2^8*3^-5 = 1.053  2^-8*3^5 = 0.949
+			// multiplier   0.5, 1.5, 0.6, 0.889, 1.125, 0.949, 1.053.....
+			int first[]  = { 1, 1, -1, 3, -3, 5, -5, 8, -8, 19, -19, 84, -84 };
+			int second[] = { 0, 1, -1, 2, -2, 3, -3, 5, -5, 12, -12, 53, -53 };
+			bool unableToAdjust{ true };
+			for (unsigned i = 0; i < 13; ++i) {
+				int adjusted_a = a - first[i];
+				int adjusted_b = b - second[i];
+				if (adjusted_a >= 0 && adjusted_a < static_cast<int>(MAX_A) && adjusted_b >= 0 && adjusted_b < static_cast<int>(MAX_B)) {
+					setexponent(0, static_cast<unsigned>(adjusted_a));
+					setexponent(1, static_cast<unsigned>(adjusted_b));
+					setsign(s);
+					unableToAdjust = false;
+					break;
+				}
+			}
+			if (unableToAdjust) {
+				if constexpr (bCollectDbnsEventStatistics) ++dbnsStats.roundingFailure;
+				//if (a > b) {
+				if (best_a < 0 && best_b >= 0) {
+					setexponent(0, MAX_A);
+					setexponent(1, 0);
+					setsign(false); // we need to avoid nan(ind)
+				}
+				else {   // we have maxed out
+					setexponent(0, 0);
+					setexponent(1, MAX_B);
+					setsign(s);
+				}
+			}
+		}
+		else {
+			a <<= sbbits;
+			_block[MSU] = static_cast<bt>(static_cast<bt>(s ? SIGN_BIT_MASK : 0u) | static_cast<bt>(a) | static_cast<bt>(b));
+		}
+		// avoid assigning to nan(ind)
+		if (isnan()) setzero();
+		return *this;
+	}
 	// fraction returns 0
 	constexpr uint64_t fraction() const noexcept { return 0; }
 	constexpr bool at(unsigned bitIndex) const noexcept {
@@ -702,93 +809,9 @@ protected:
 		}
 
 		// it is too expensive to check if the value is in the representable range
-		// the search below will end up at 0 or maxpos
+		// the search in set_log2 will end up at 0 or maxpos
 
-		// we search for the a and b in v = 2^a * 3^b, with both a and b positive
-		// in our representation we have 0.5^a * 3^b, which would be equivalent
-		// to a being negative
-		// 
-		// v = 2^a * 3^b =>
-		// v = 2^(a + b*log2of3) =>
-		// scale of v = (a + b*log2of3)
-		// we use this relationship to search among the second base exponents 
-		// and find a first base exponent that minimizes the error
-		// between the result and the value we are trying to approximate.
-		constexpr bool bDebug = false;
-		double scale = log2(abs(v)); 
-		if constexpr (bDebug) std::cout << "scale : " << scale << '\n';
-		double lowestError = 1.0e10;
-		int best_a = std::numeric_limits<int>::max();
-		int best_b = std::numeric_limits<int>::max();
-		for (int b = 0; b <= static_cast<int>(SB_MASK); ++b) {
-			int a = static_cast<int>(round((scale - b * log2of3))); // find the first base exponent that is closest to the value
-			if (a > 0 || a > static_cast<int>(MAX_A)) {
-				if constexpr (bCollectDbnsEventStatistics) ++dbnsStats.exponentOverflowDuringSearch;
-				continue;
-			}
-			double err = abs(scale - (a + b * log2of3));
-			if constexpr (bDebug) {
-				double fb = pow(2.0, a);
-				double sb = pow(3.0, b);
-				double value = fb * sb;
-				std::cout << "a : " << a << " b : " << b << " err : " << err << " fb : " << fb << " sb : " << sb << " value : " << value << '\n';
-			}
-			if (err < lowestError) {
-				lowestError = err;
-				best_a = a;
-				best_b = b;
-			}
-		}
-		if constexpr (bDebug) std::cout << "best a : " << best_a << " best b : " << best_b << " lowest err : " << lowestError << '\n';
-		assert(best_b >= 0); // second exponent is negative
-		clear();
-		int a = -best_a;
-		int b = best_b;
-		if (a < 0 || a > static_cast<int>(MAX_A) || b > static_cast<int>(MAX_B)) {
-			// try to project the value back into valid pairs
-			// the approximations of unity looks like (8,-5), (19,-12), (84,-53),... 
-			// they grow too fast and in a rather irregular manner. There are more 
-			// subtle number theoretic considerations, but the ones outlined above 
-			// should be sufficient to figure out a good solution to the problem.
-			// 2^3*3^-2 = 0.888  2^-3*3^2 = 1.125
-			// 2^8*3^-5 = 1.053  2^-8*3^5 = 0.949
-			// multiplier   0.5, 1.5, 0.6, 0.889, 1.125, 0.949, 1.053.....
-			int first[]  = { 1, 1, -1, 3, -3, 5, -5, 8, -8, 19, -19, 84, -84 };
-			int second[] = { 0, 1, -1, 2, -2, 3, -3, 5, -5, 12, -12, 53, -53 };
-			bool unableToAdjust{ true };
-			for (unsigned i = 0; i < 13; ++i) {
-				int adjusted_a = a - first[i];
-				int adjusted_b = b - second[i];
-				if (adjusted_a >= 0 && adjusted_a < static_cast<int>(MAX_A) && adjusted_b >= 0 && adjusted_b < static_cast<int>(MAX_B)) {
-					setexponent(0, static_cast<unsigned>(adjusted_a));
-					setexponent(1, static_cast<unsigned>(adjusted_b));
-					setsign(s);
-					unableToAdjust = false;
-					break;
-				}
-			}
-			if (unableToAdjust) {
-				if constexpr (bCollectDbnsEventStatistics) ++dbnsStats.roundingFailure;
-				//if (a > b) {
-				if (best_a < 0 && best_b >= 0) {
-					setexponent(0, MAX_A);
-					setexponent(1, 0);
-					setsign(false); // we need to avoid nan(ind)
-				}
-				else {   // we have maxed out
-					setexponent(0, 0);
-					setexponent(1, MAX_B);
-					setsign(s);
-				}
-			}
-		}
-		else {
-			a <<= sbbits;
-			_block[MSU] = static_cast<bt>(static_cast<bt>(s ? SIGN_BIT_MASK : 0u) | static_cast<bt>(a) | static_cast<bt>(b));
-		}
-		// avoid assigning to nan(ind)
-		if (isnan()) setzero();
-		return *this;
+		return set_log2(s, log2(abs(v)));
 	}
 
 	//////////////////////////////////////////////////////
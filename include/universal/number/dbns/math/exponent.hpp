@@ -0,0 +1,34 @@
+#pragma once
+// exponent.hpp: exponent functions for double base number systems
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <numbers>
+
+namespace sw { namespace universal {
+
+// e^x, 2^x, and 10^x search the exponent pair of x times the log2 of the base
+template<unsigned nbits, unsigned fbbits, typename bt, auto... xtra>
+dbns<nbits, fbbits, bt, xtra...> exp(const dbns<nbits, fbbits, bt, xtra...>& x) {
+	if (x.isnan()) return x;
+	dbns<nbits, fbbits, bt, xtra...> r;
+	return r.set_log2(false, double(x) * std::numbers::log2e);
+}
+
+template<unsigned nbits, unsigned fbbits, typename bt, auto... xtra>
+dbns<nbits, fbbits, bt, xtra...> exp2(const dbns<nbits, fbbits, bt, xtra...>& x) {
+	if (x.isnan()) return x;
+	dbns<nbits, fbbits, bt, xtra...> r;
+	return r.set_log2(false, double(x));
+}
+
+template<unsigned nbits, unsigned fbbits, typename bt, auto... xtra>
+dbns<nbits, fbbits, bt, xtra...> exp10(const dbns<nbits, fbbits, bt, xtra...>& x) {
+	if (x.isnan()) return x;
+	dbns<nbits, fbbits, bt, xtra...> r;
+	return r.set_log2(false, double(x) * (std::numbers::ln10 / std::numbers::ln2));
+}
+
+}} // namespace sw::universal
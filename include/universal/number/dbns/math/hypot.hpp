@@ -0,0 +1,25 @@
+#pragma once
+// hypot.hpp: hypotenuse functions for double base number systems
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <numbers>
+
+namespace sw { namespace universal {
+
+// with |x| >= |y| and d = log2|y| - log2|x| <= 0, log2 hypot(x, y) = log2|x| + log2(1 + 2^(2d)) / 2
+template<unsigned nbits, unsigned fbbits, typename bt, auto... xtra>
+dbns<nbits, fbbits, bt, xtra...> hypot(const dbns<nbits, fbbits, bt, xtra...>& x, const dbns<nbits, fbbits, bt, xtra...>& y) {
+	using DbnsType = dbns<nbits, fbbits, bt, xtra...>;
+	if (x.isnan() || y.isnan()) return DbnsType(SpecificValue::qnan);
+	if (x.iszero()) return (y.isneg() ? -y : y);
+	if (y.iszero()) return (x.isneg() ? -x : x);
+	double lx = x.log2magnitude(), ly = y.log2magnitude();
+	if (lx < ly) std::swap(lx, ly);
+	DbnsType r;
+	return r.set_log2(false, lx + 0.5 * std::log1p(std::exp2(2.0 * (ly - lx))) / std::numbers::ln2);
+}
+
+}} // namespace sw::universal
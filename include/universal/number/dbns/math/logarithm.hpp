@@ -0,0 +1,37 @@
+#pragma once
+// logarithm.hpp: logarithm functions for double base number systems
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <numbers>
+
+namespace sw { namespace universal {
+
+// the logarithms of x are read from its exponent pair: log2|x| = -a + b * log2(3)
+template<unsigned nbits, unsigned fbbits, typename bt, auto... xtra>
+dbns<nbits, fbbits, bt, xtra...> log(const dbns<nbits, fbbits, bt, xtra...>& x) {
+	using DbnsType = dbns<nbits, fbbits, bt, xtra...>;
+	if (x.isnan() || x.isneg()) return DbnsType(SpecificValue::qnan);
+	if (x.iszero()) return DbnsType(SpecificValue::infneg);
+	return DbnsType(x.log2magnitude() * std::numbers::ln2);
+}
+
+template<unsigned nbits, unsigned fbbits, typename bt, auto... xtra>
+dbns<nbits, fbbits, bt, xtra...> log2(const dbns<nbits, fbbits, bt, xtra...>& x) {
+	using DbnsType = dbns<nbits, fbbits, bt, xtra...>;
+	if (x.isnan() || x.isneg()) return DbnsType(SpecificValue::qnan);
+	if (x.iszero()) return DbnsType(SpecificValue::infneg);
+	return DbnsType(x.log2magnitude());
+}
+
+template<unsigned nbits, unsigned fbbits, typename bt, auto... xtra>
+dbns<nbits, fbbits, bt, xtra...> log10(const dbns<nbits, fbbits, bt, xtra...>& x) {
+	using DbnsType = dbns<nbits, fbbits, bt, xtra...>;
+	if (x.isnan() || x.isneg()) return DbnsType(SpecificValue::qnan);
+	if (x.iszero()) return DbnsType(SpecificValue::infneg);
+	return DbnsType(x.log2magnitude() * (std::numbers::ln2 / std::numbers::ln10));
+}
+
+}} // namespace sw::universal
@@ -0,0 +1,36 @@
+#pragma once
+// pow.hpp: pow functions for double base number systems
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+
+namespace sw { namespace universal {
+
+// x^y multiplies log2|x| by y
+template<unsigned nbits, unsigned fbbits, typename bt, auto... xtra>
+dbns<nbits, fbbits, bt, xtra...> pow(const dbns<nbits, fbbits, bt, xtra...>& x, double y) {
+	using DbnsType = dbns<nbits, fbbits, bt, xtra...>;
+	if (y == 0.0) return DbnsType(1);
+	if (x.isnan() || std::isnan(y)) return DbnsType(SpecificValue::qnan);
+	bool integral = (y == std::trunc(y));
+	if (x.iszero()) return (y > 0.0 ? x : DbnsType(SpecificValue::qnan));
+	if (x.isneg() && !integral) return DbnsType(SpecificValue::qnan);
+	bool negative = x.isneg() && std::fmod(y, 2.0) != 0.0;
+	DbnsType r;
+	return r.set_log2(negative, x.log2magnitude() * y);
+}
+
+template<unsigned nbits, unsigned fbbits, typename bt, auto... xtra>
+dbns<nbits, fbbits, bt, xtra...> pow(const dbns<nbits, fbbits, bt, xtra...>& x, const dbns<nbits, fbbits, bt, xtra...>& y) {
+	if (y.isnan()) return dbns<nbits, fbbits, bt, xtra...>(SpecificValue::qnan);
+	return pow(x, double(y));
+}
+
+template<unsigned nbits, unsigned fbbits, typename bt, auto... xtra>
+dbns<nbits, fbbits, bt, xtra...> pow(const dbns<nbits, fbbits, bt, xtra...>& x, int y) {
+	return pow(x, double(y));
+}
+
+}} // namespace sw::universal
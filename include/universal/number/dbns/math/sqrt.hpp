@@ -0,0 +1,39 @@
+#pragma once
+// sqrt.hpp: square and cube root functions for double base number systems
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+
+namespace sw { namespace universal {
+
+// the roots scale log2|x| = -a + b * log2(3) and search the exponent pair of the result, without leaving the log domain
+
+template<unsigned nbits, unsigned fbbits, typename bt, auto... xtra>
+dbns<nbits, fbbits, bt, xtra...> sqrt(const dbns<nbits, fbbits, bt, xtra...>& x) {
+	using DbnsType = dbns<nbits, fbbits, bt, xtra...>;
+	if (x.isnan() || x.isneg()) return DbnsType(SpecificValue::qnan);
+	if (x.iszero()) return x;
+	DbnsType r;
+	return r.set_log2(false, x.log2magnitude() / 2.0);
+}
+
+template<unsigned nbits, unsigned fbbits, typename bt, auto... xtra>
+dbns<nbits, fbbits, bt, xtra...> rsqrt(const dbns<nbits, fbbits, bt, xtra...>& x) {
+	using DbnsType = dbns<nbits, fbbits, bt, xtra...>;
+	if (x.isnan() || x.isneg()) return DbnsType(SpecificValue::qnan);
+	if (x.iszero()) return DbnsType(SpecificValue::infpos);
+	DbnsType r;
+	return r.set_log2(false, -x.log2magnitude() / 2.0);
+}
+
+template<unsigned nbits, unsigned fbbits, typename bt, auto... xtra>
+dbns<nbits, fbbits, bt, xtra...> cbrt(const dbns<nbits, fbbits, bt, xtra...>& x) {
+	using DbnsType = dbns<nbits, fbbits, bt, xtra...>;
+	if (x.isnan() || x.iszero()) return x;
+	DbnsType r;
+	return r.set_log2(x.sign(), x.log2magnitude() / 3.0);
+}
+
+}} // namespace sw::universal
@@ -5,20 +5,11 @@
 //
 // This file is part of the universal numbers project, which is released under an MIT Open Source license.
 
-#include <universal/number/dbns/math/classify.hpp>
-#include <universal/number/dbns/math/complex.hpp>
-#include <universal/number/dbns/math/error_and_gamma.hpp>
 #include <universal/number/dbns/math/exponent.hpp>
-#include <universal/number/dbns/math/fractional.hpp>
-#include <universal/number/dbns/math/hyperbolic.hpp>
 #include <universal/number/dbns/math/hypot.hpp>
 #include <universal/number/dbns/math/logarithm.hpp>
-#include <universal/number/dbns/math/minmax.hpp>
-#include <universal/number/dbns/math/next.hpp>
 #include <universal/number/dbns/math/pow.hpp>
 #include <universal/number/dbns/math/sqrt.hpp>
-#include <universal/number/dbns/math/trigonometry.hpp>
-#include <universal/number/dbns/math/truncate.hpp>
 
 namespace sw {
     namespace universal {
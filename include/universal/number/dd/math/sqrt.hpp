@@ -17,7 +17,7 @@ namespace sw { namespace universal {
 
     /* Computes the square root of the double-double number dd.
    NOTE: dd must be a non-negative number.                   */
-    inline dd sqrt(const dd& a) {
+    inline dd sqrt(dd a) {
         /* Strategy:  Use Karp's trick:  if x is an approximation
            to sqrt(a), then
 
@@ -35,10 +35,14 @@ namespace sw { namespace universal {
 #else
         if (a.isneg()) std::cerr << "doubledouble argument to sqrt is negative: " << a << std::endl;
 #endif
+        // the iteration multiplies a by 1/sqrt(a), which turns +inf into inf * 0 = nan
+        if (a.isnan() || (a.isinf() && !a.isneg())) return a;
 
         double x = 1.0 / std::sqrt(a.high());
         double ax = a.high() * x;
-        return add(ax, (a - sqr(dd(ax))).high() * (x * 0.5));
+        volatile double error{ 0.0 };
+        double root = two_sum(ax, (a - sqr(dd(ax))).high() * (x * 0.5), error);
+        return dd(root, error);
     }
 
 #else
@@ -44,6 +44,13 @@
 #define EDECIMAL_THROW_ARITHMETIC_EXCEPTION 0
 #endif
 
+////////////////////////////////////////////////////////////////////////////////////////
+// number of digits an edecimal stores inside the object before its digits move to the heap
+#if !defined(EDECIMAL_INLINE_DIGITS)
+// default covers the 20 digits of a 64-bit integer
+#define EDECIMAL_INLINE_DIGITS 24
+#endif
+
 ////////////////////////////////////////////////////////////////////////////////////////
 /// support functions
 #include <universal/native/ieee754.hpp>
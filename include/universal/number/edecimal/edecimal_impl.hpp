@@ -12,6 +12,7 @@
 #if EDECIMAL_OPERATIONS_COUNT
 #include <universal/utility/occurrence.hpp>
 #endif
+#include <universal/utility/small_vector.hpp>
 
 namespace sw { namespace universal {
 
@@ -19,7 +20,8 @@ namespace sw { namespace universal {
 /// Adaptive precision decimal integer number type
 /// </summary>
 /// The digits are managed as a vector with the digit for 10^0 stored at index 0, 10^1 stored at index 1, etc.
-class edecimal : public std::vector<uint8_t> {
+/// Up to EDECIMAL_INLINE_DIGITS digits are stored inside the object, larger values allocate.
+class edecimal : public small_vector<uint8_t, EDECIMAL_INLINE_DIGITS> {
 #if EDECIMAL_OPERATIONS_COUNT
 	static bool enableAdd;
 	static occurrence<edecimal> ops;
@@ -31,6 +31,13 @@
 #define EINTEGER_THROW_ARITHMETIC_EXCEPTION 0
 #endif
 
+////////////////////////////////////////////////////////////////////////////////////////
+// number of bits an einteger stores inside the object before its limbs move to the heap
+#if !defined(EINTEGER_INLINE_BITS)
+// default covers the 128-bit products of 64-bit operands
+#define EINTEGER_INLINE_BITS 128
+#endif
+
 ////////////////////////////////////////////////////////////////////////////////////////
 /// INCLUDE FILES that make up the library
 #include <universal/number/einteger/einteger_impl.hpp>
@@ -12,6 +12,7 @@
 #include <map>
 #include <vector>
 
+#include <universal/utility/small_vector.hpp>
 #include <universal/number/einteger/exceptions.hpp>
 #include <universal/number/einteger/einteger_fwd.hpp>
 
@@ -29,6 +30,9 @@ public:
 	static constexpr bt       ALL_ONES = bt(0xFFFF'FFFF'FFFF'FFFFull); // block type specific all 1's value
 	static constexpr uint64_t BASE = uint64_t(ALL_ONES) + 1ull;
 	static_assert(bitsInBlock <= 32, "BlockType must be one of [uint8_t, uint16_t, uint32_t]");
+	// limbs live inline up to EINTEGER_INLINE_BITS, so small values do not allocate
+	static constexpr size_t inlineLimbs = (EINTEGER_INLINE_BITS + bitsInBlock - 1) / bitsInBlock;
+	using limb_store = small_vector<BlockType, inlineLimbs>;
 
 	einteger() : _sign(false), _block{} { }
 
@@ -200,8 +204,8 @@ public:
 		if (lhsSize < rhsSize) _block.resize(rhsSize, 0);
 
 		std::uint64_t carry{ 0 };
-		typename std::vector<BlockType>::iterator li = _block.begin();
-		typename std::vector<BlockType>::const_iterator ri = rhs._block.begin();
+		typename limb_store::iterator li = _block.begin();
+		typename limb_store::const_iterator ri = rhs._block.begin();
 		while (li != _block.end()) {
 			if (ri != rhs._block.end()) {
 				carry += static_cast<std::uint64_t>(*li) + static_cast<std::uint64_t>(*ri);
@@ -242,7 +246,7 @@ public:
 		// prep storage
 		if (lhsSize < rhsSize) _block.resize(rhsSize, 0);
 
-		typename std::vector<BlockType>::const_iterator aIter, bIter;
+		typename limb_store::const_iterator aIter, bIter;
 		if (magnitude == 1) {
 			aIter = _block.begin();
 			bIter = rhs._block.begin();
@@ -658,7 +662,7 @@ public:
 
 protected:
 	bool                   _sign;   // sign of the number: -1 if true, +1 if false, zero is positive
-	std::vector<BlockType> _block;  // building blocks representing a 1's complement magnitude
+	limb_store _block;  // building blocks representing a 1's complement magnitude
 
 	// HELPER methods
 	// compare_magnitude returns 1 if a > b, 0 if they are equal, and -1 if a < b
@@ -679,7 +683,7 @@ protected:
 	}
 	void remove_leading_zeros() {
 		unsigned leadingZeroBlocks{ 0 };
-		typename std::vector<BlockType>::reverse_iterator rit = _block.rbegin();
+		typename limb_store::reverse_iterator rit = _block.rbegin();
 		while (rit != _block.rend()) {
 			if (*rit == 0) {
 				++leadingZeroBlocks;
@@ -1150,8 +1154,8 @@ inline bool operator==(const einteger<BlockType>& lhs, const einteger<BlockType>
 	if (lhs.limbs() != rhs.limbs()) {
 		return false;
 	}
-	typename std::vector<BlockType>::const_iterator li = lhs._block.begin();
-	typename std::vector<BlockType>::const_iterator ri = rhs._block.begin();
+	typename einteger<BlockType>::limb_store::const_iterator li = lhs._block.begin();
+	typename einteger<BlockType>::limb_store::const_iterator ri = rhs._block.begin();
 	while (li != lhs._block.end()) {
 		if (*li != *ri) return false;
 		++li; ++ri;
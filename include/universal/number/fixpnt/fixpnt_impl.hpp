@@ -17,6 +17,7 @@
 // supporting types and functions
 #include <universal/native/ieee754.hpp>   // IEEE-754 decoders
 #include <universal/number/shared/specific_value_encoding.hpp>
+#include <universal/number/shared/encoding_table.hpp>
 #include <universal/native/integers.hpp>   // manipulators for native integer types
 
 /*
@@ -247,7 +248,7 @@ public:
 	// guard long double support to enable ARM and RISC-V embedded environments
 #if LONG_DOUBLE_SUPPORT
 	fixpnt(long double initial_value)   noexcept : fixpnt{ convert(initial_value) } {}
-	fixpnt& operator=(long double rhs)  noexcept { return convert(rhs);  }
+	fixpnt& operator=(long double rhs)  noexcept { return *this = convert(rhs); }
 	explicit operator long double() const noexcept { return to_native<long double>(); }
 #endif
 
@@ -635,6 +636,13 @@ public:
 	// collect a copy of the underlying bit representation
 	blockbinary<nbits, bt, BinaryNumberType::Signed> bits() const noexcept { return _block; }
 
+	// raw bits of a configuration of 64 bits or less
+	constexpr uint64_t encoding() const noexcept {
+		uint64_t raw{ 0 };
+		for (unsigned b = 0; b < nrBlocks; ++b) raw |= (uint64_t(_block.block(b)) << (b * bitsInBlock));
+		return raw;
+	}
+
 protected:
 	// HELPER methods
 	// 
@@ -727,7 +735,7 @@ protected:
 				}
 				bool sticky = (mask & fraction);
 
-				fraction >>= shiftRight;  // shift out the bits we are rounding away
+				fraction = (shiftRight < 64 ? fraction >> shiftRight : 0);  // shift out the bits we are rounding away
 				bool lsb = (fraction & 0x1ul);
 				//  ... lsb | guard  round sticky   round
 				//       x     0       x     x       down
@@ -799,6 +807,15 @@ protected:
 
 	template<typename TargetFloat>
 	TargetFloat to_native() const {
+		if constexpr (nbits <= max_implicit_encoding_table_nbits && std::is_same_v<TargetFloat, double>) {
+			return value_table().value(encoding());
+		}
+		else {
+			return arithmetic_to_native<TargetFloat>();
+		}
+	}
+	template<typename TargetFloat>
+	TargetFloat arithmetic_to_native() const {
 		// pick up the absolute value of the minimum normal and subnormal exponents 
 		constexpr unsigned minNormalExponent = static_cast<unsigned>(-ieee754_parameter<TargetFloat > ::minNormalExp);
 		constexpr unsigned minSubnormalExponent = static_cast<unsigned>(-ieee754_parameter<TargetFloat>::minSubnormalExp);
@@ -831,6 +848,13 @@ protected:
 private:
 	blockbinary<nbits, bt, BinaryNumberType::Signed> _block;
 
+	// values of all encodings: the conversion from double is a scale and a rounding, faster than a search of the table
+	static const encoding_table<nbits>& value_table() {
+		static const encoding_table<nbits> table(
+			[](uint64_t raw) { fixpnt v; v.setbits(raw); return v.template arithmetic_to_native<double>(); });
+		return table;
+	}
+
 	// convert
 	template<unsigned nnbits, unsigned rrbits, bool aarithmetic, typename Bbt>
 	friend std::string convert_to_decimal_string(const fixpnt<nnbits, rrbits, aarithmetic, Bbt>& value);
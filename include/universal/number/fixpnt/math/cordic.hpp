@@ -0,0 +1,418 @@
+#pragma once
+// cordic.hpp: CORDIC kernels of the fixed-point math library
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+/*
+ * The elementary functions of fixpnt evaluate in a working format of a signed 64-bit integer with
+ * F = min(nbits + rbits + 12, 60) fraction bits, with shifts and adds only:
+ *   circular rotation      (K, 0) rotated by z                      yields (cos z, sin z)
+ *   circular vectoring     (x, y) rotated onto the x axis            yields atan(y / x) and |(x, y)| / K
+ *   hyperbolic rotation    (1 / Kh, 0) rotated by z                 yields cosh z + sinh z = e^z
+ *   hyperbolic vectoring   (w + 1, w - 1) rotated onto the x axis    yields atanh((w - 1) / (w + 1)) = ln(w) / 2
+ *                          (w + 1/4, w - 1/4)                        yields Kh sqrt(w)
+ * Each iteration adds one bit of the result, so the iteration counts, the arctangent tables, and the
+ * gains K and Kh are constexpr functions of F. The nbits + 12 guard bits absorb the truncation error
+ * of the iterations, the amplification of the error of tan near its poles, and the results that are
+ * close to a rounding tie, so that the formats of up to 16 bits round correctly for every input. The arguments are reduced modulo pi/2 and ln(2) with
+ * 124-bit constants in 128-bit integer arithmetic, and the results round once to the fixpnt.
+ * Configurations of more than 64 bits, and compilers without a 128-bit integer, use the double shims.
+ */
+#ifndef FIXPNT_NATIVE_MATH
+#if defined(__SIZEOF_INT128__)
+#define FIXPNT_NATIVE_MATH 1
+#else
+#define FIXPNT_NATIVE_MATH 0
+#endif
+#endif
+
+namespace sw { namespace universal {
+
+// configurations evaluated by the CORDIC kernels
+template<unsigned nbits>
+constexpr bool fixpnt_cordic = (FIXPNT_NATIVE_MATH != 0) && nbits <= 64;
+
+#if FIXPNT_NATIVE_MATH
+__extension__ typedef __int128 cordic_int128;
+__extension__ typedef unsigned __int128 cordic_uint128;
+
+// fraction bits of the working format of a configuration
+constexpr unsigned cordic_fraction_bits(unsigned nbits, unsigned rbits) { return (nbits + rbits + 12 < 60 ? nbits + rbits + 12 : 60); }
+
+// constants scaled by 2^124, 2^62, and 2^60
+constexpr cordic_int128 cordic_pio2_124 = (cordic_int128(0x1921fb54442d1846ull) << 64) | cordic_int128(0x9898cc51701b839aull);
+constexpr cordic_int128 cordic_ln2_124  = (cordic_int128(0x0b17217f7d1cf79aull) << 64) | cordic_int128(0xbc9e3b39803f2f6bull);
+constexpr int64_t cordic_2opi_62  = 0x28be60db9391054all;
+constexpr int64_t cordic_log2e_60 = 0x171547652b82fe17ll;
+constexpr int64_t cordic_log2_10_60 = 0x35269e12f346e2c0ll;
+constexpr int64_t cordic_log10e_60 = 0x06f2dec549b9438dll;
+
+// v * 2^-shift rounded to nearest, ties to even
+constexpr cordic_int128 cordic_round(cordic_int128 v, unsigned shift) noexcept {
+	if (shift == 0) return v;
+	cordic_int128 q = v >> shift;
+	cordic_int128 rem = v - (q << shift);
+	cordic_int128 half = cordic_int128(1) << (shift - 1);
+	if (rem > half || (rem == half && (q & 1))) ++q;
+	return q;
+}
+
+constexpr long double cordic_pow2(int e) noexcept {
+	long double v = 1.0L;
+	for (; e > 0; --e) v *= 2.0L;
+	for (; e < 0; ++e) v *= 0.5L;
+	return v;
+}
+// atan(x), or atanh(x), for |x| <= 1/2
+constexpr long double cordic_series(long double x, bool hyperbolic) noexcept {
+	long double x2 = x * x, term = x, sum = 0.0L;
+	for (int k = 0; k < 40; ++k) {
+		sum += ((k & 1) && !hyperbolic ? -term : term) / (2 * k + 1);
+		term *= x2;
+	}
+	return sum;
+}
+// square root of a value near 1
+constexpr long double cordic_sqrt(long double v) noexcept {
+	long double r = 1.0L;
+	for (int k = 0; k < 8; ++k) r = (r + v / r) / 2.0L;
+	return r;
+}
+constexpr int64_t cordic_fixed(long double v, unsigned F) noexcept {
+	long double s = v * cordic_pow2(int(F));
+	return int64_t(s < 0 ? s - 0.5L : s + 0.5L);
+}
+
+// the hyperbolic iterations 4, 13, 40, ... are repeated to converge
+template<unsigned F, typename Step>
+constexpr void cordic_hyperbolic_schedule(Step&& step) {
+	unsigned repeat = 4;
+	for (unsigned i = 1; i <= F; ++i) {
+		step(i);
+		if (i == repeat) {
+			step(i);
+			repeat = 3 * repeat + 1;
+		}
+	}
+}
+
+// arctangent tables and gains of a working format with F fraction bits
+template<unsigned F>
+struct cordic_tables {
+	static_assert(F <= 60, "cordic_tables: the working format is limited to 60 fraction bits");
+	static constexpr int64_t one = int64_t(1) << F;
+	static constexpr std::array<int64_t, F + 1> atan = [] {
+		std::array<int64_t, F + 1> t{};
+		t[0] = cordic_fixed(0.785398163397448309615660845819875721L, F);
+		for (unsigned i = 1; i <= F; ++i) t[i] = cordic_fixed(cordic_series(cordic_pow2(-int(i)), false), F);
+		return t;
+	}();
+	static constexpr std::array<int64_t, F + 1> atanh = [] {
+		std::array<int64_t, F + 1> t{};
+		for (unsigned i = 1; i <= F; ++i) t[i] = cordic_fixed(cordic_series(cordic_pow2(-int(i)), true), F);
+		return t;
+	}();
+	// K = prod 1 / sqrt(1 + 2^-2i): the circular iterations scale a vector by 1 / K
+	static constexpr int64_t circularGain = [] {
+		long double k = 1.0L;
+		for (unsigned i = 0; i <= F; ++i) k /= cordic_sqrt(1.0L + cordic_pow2(-2 * int(i)));
+		return cordic_fixed(k, F);
+	}();
+	// 1 / Kh = prod 1 / sqrt(1 - 2^-2i): the hyperbolic iterations scale a vector by Kh
+	static constexpr int64_t hyperbolicGain = [] {
+		long double k = 1.0L;
+		cordic_hyperbolic_schedule<F>([&](unsigned i) { k /= cordic_sqrt(1.0L - cordic_pow2(-2 * int(i))); });
+		return cordic_fixed(k, F);
+	}();
+};
+
+// circular rotation of (x, y) by z, |z| <= 1.74: the sign of z selects the direction of each step without a branch
+template<unsigned F>
+constexpr void cordic_rotate(int64_t& x, int64_t& y, int64_t z) noexcept {
+	const auto& atan = cordic_tables<F>::atan;
+	for (unsigned i = 0; i <= F; ++i) {
+		int64_t d = z >> 63;   // 0 or -1
+		int64_t dx = y >> i, dy = x >> i;
+		x -= (dx ^ d) - d;
+		y += (dy ^ d) - d;
+		z -= (atan[i] ^ d) - d;
+	}
+}
+
+// circular vectoring of (x, y), x >= 0, onto the x axis: returns atan(y / x) and leaves |(x, y)| / K in x
+template<unsigned F>
+constexpr int64_t cordic_vectoring(int64_t& x, int64_t& y) noexcept {
+	const auto& atan = cordic_tables<F>::atan;
+	int64_t z = 0;
+	for (unsigned i = 0; i <= F; ++i) {
+		int64_t d = y >> 63;
+		int64_t dx = y >> i, dy = x >> i;
+		x += (dx ^ d) - d;
+		y -= (dy ^ d) - d;
+		z += (atan[i] ^ d) - d;
+	}
+	return z;
+}
+
+// hyperbolic rotation of (x, y) by z, |z| <= 1.11
+template<unsigned F>
+constexpr void cordic_hyperbolic_rotate(int64_t& x, int64_t& y, int64_t z) noexcept {
+	const auto& atanh = cordic_tables<F>::atanh;
+	cordic_hyperbolic_schedule<F>([&](unsigned i) {
+		int64_t d = z >> 63;
+		int64_t dx = y >> i, dy = x >> i;
+		x += (dx ^ d) - d;
+		y += (dy ^ d) - d;
+		z -= (atanh[i] ^ d) - d;
+	});
+}
+
+// hyperbolic vectoring of (x, y), |y| < 0.8 x, onto the x axis: returns atanh(y / x) and leaves Kh sqrt(x^2 - y^2) in x
+template<unsigned F>
+constexpr int64_t cordic_hyperbolic_vectoring(int64_t& x, int64_t& y) noexcept {
+	const auto& atanh = cordic_tables<F>::atanh;
+	int64_t z = 0;
+	cordic_hyperbolic_schedule<F>([&](unsigned i) {
+		int64_t d = y >> 63;
+		int64_t dx = y >> i, dy = x >> i;
+		x -= (dx ^ d) - d;
+		y -= (dy ^ d) - d;
+		z += (atanh[i] ^ d) - d;
+	});
+	return z;
+}
+
+// the fixpnt nearest to v * 2^-fractionBits: values out of range saturate or wrap like the arithmetic of the fixpnt
+template<typename Fixed>
+Fixed cordic_fixpnt(cordic_int128 v, int64_t fractionBits) noexcept {
+	constexpr cordic_int128 maxRaw = (cordic_int128(1) << (Fixed::nbits - 1)) - 1;
+	constexpr cordic_int128 minRaw = -maxRaw - 1;
+	int64_t shift = fractionBits - int64_t(Fixed::rbits);
+	cordic_int128 raw{ 0 };
+	if (shift >= 127) {
+		raw = 0;
+	}
+	else if (shift >= 0) {
+		raw = cordic_round(v, unsigned(shift));
+	}
+	else if (v != 0) {
+		unsigned left = (shift < -127 ? 127u : unsigned(-shift));
+		if (left < 127 && v <= (maxRaw >> left) && v >= (minRaw >> left)) {
+			raw = v << left;
+		}
+		else if constexpr (Fixed::arithmetic == Saturate) {
+			raw = (v > 0 ? maxRaw : minRaw);
+		}
+		else {
+			raw = (left < 128 ? cordic_int128(cordic_uint128(v) << left) : 0);
+		}
+	}
+	if constexpr (Fixed::arithmetic == Saturate) {
+		if (raw > maxRaw) raw = maxRaw;
+		if (raw < minRaw) raw = minRaw;
+	}
+	Fixed f;
+	f.setbits(static_cast<uint64_t>(raw));
+	return f;
+}
+
+// the encoding of a fixpnt as a signed integer
+template<typename Fixed>
+constexpr int64_t cordic_raw(const Fixed& x) noexcept {
+	constexpr unsigned unused = 64 - Fixed::nbits;
+	return static_cast<int64_t>(x.encoding() << unused) >> unused;
+}
+
+// x = raw 2^-rbits reduced to q pi/2 + z with |z| <= pi/4: z in the working format, and q modulo 4
+template<unsigned nbits, unsigned rbits, unsigned F>
+constexpr void cordic_reduce_pio2(int64_t raw, int64_t& z, unsigned& quadrant) noexcept {
+	constexpr unsigned S = (127 - nbits + rbits < 124 ? 127 - nbits + rbits : 124);   // raw 2^(S - rbits) fits 127 bits
+	constexpr cordic_int128 pio2 = cordic_round(cordic_pio2_124, 124 - S);
+	cordic_int128 X = cordic_int128(raw) << (S - rbits);
+	cordic_int128 q = cordic_round(cordic_int128(raw) * cordic_2opi_62, rbits + 62);
+	cordic_int128 r = X - q * pio2;
+	if (r > pio2 / 2) { r -= pio2; ++q; }
+	else if (r < -pio2 / 2) { r += pio2; --q; }
+	z = static_cast<int64_t>(cordic_round(r, S - F));
+	quadrant = static_cast<unsigned>(q & 3);
+}
+
+// cos and sin of the reduced angle z mapped to the quadrant
+constexpr void cordic_quadrant(unsigned quadrant, int64_t c, int64_t s, int64_t& cosine, int64_t& sine) noexcept {
+	switch (quadrant) {
+	case 0: cosine = c;  sine = s;  break;
+	case 1: cosine = -s; sine = c;  break;
+	case 2: cosine = -c; sine = -s; break;
+	default: cosine = s; sine = -c; break;
+	}
+}
+
+// cos and sin of x = raw 2^-rbits in the working format
+template<unsigned nbits, unsigned rbits, unsigned F = cordic_fraction_bits(nbits, rbits)>
+constexpr void cordic_sincos(int64_t raw, int64_t& cosine, int64_t& sine) noexcept {
+	int64_t z;
+	unsigned quadrant;
+	cordic_reduce_pio2<nbits, rbits, F>(raw, z, quadrant);
+	int64_t c = cordic_tables<F>::circularGain, s = 0;
+	cordic_rotate<F>(c, s, z);
+	cordic_quadrant(quadrant, c, s, cosine, sine);
+}
+
+// n / d in the working format, rounded to nearest: d == 0 returns a value beyond any fixpnt
+template<unsigned F>
+constexpr cordic_int128 cordic_divide(cordic_int128 n, cordic_int128 d) noexcept {
+	if (d == 0) return (n < 0 ? -(cordic_int128(1) << 126) : (cordic_int128(1) << 126));
+	if (d < 0) { n = -n; d = -d; }
+	n <<= F;
+	return (n >= 0 ? (n + d / 2) / d : -((-n + d / 2) / d));
+}
+
+// atan2(y, x) of two values with the same scale, and |(x, y)| in that scale, in the working format
+template<unsigned F>
+constexpr int64_t cordic_atan2(cordic_int128 y, cordic_int128 x, cordic_int128* magnitude = nullptr) noexcept {
+	constexpr int64_t pi = static_cast<int64_t>(cordic_round(cordic_pio2_124, 123 - F));
+	if (x == 0 && y == 0) {
+		if (magnitude) *magnitude = 0;
+		return 0;
+	}
+	// normalize the larger magnitude to [1/2, 1)
+	cordic_uint128 m = cordic_uint128(x < 0 ? -x : x) | cordic_uint128(y < 0 ? -y : y);
+	uint64_t high = uint64_t(m >> 64);
+	int scale = int(F) - (high ? 64 + int(std::bit_width(high)) : int(std::bit_width(uint64_t(m))));
+	int64_t xs, ys;
+	if (scale >= 0) { xs = int64_t(x << scale); ys = int64_t(y << scale); }
+	else { xs = int64_t(x >> -scale); ys = int64_t(y >> -scale); }
+	int64_t offset = 0;
+	if (xs < 0) {
+		offset = (ys >= 0 ? pi : -pi);
+		xs = -xs;
+		ys = -ys;
+	}
+	int64_t angle = cordic_vectoring<F>(xs, ys) + offset;
+	if (magnitude) {
+		cordic_int128 r = cordic_round(cordic_int128(xs) * cordic_tables<F>::circularGain, F);   // |(x, y)| 2^scale
+		*magnitude = (scale >= 0 ? cordic_round(r, unsigned(scale)) : r << -scale);
+	}
+	return angle;
+}
+
+// square root of 0 <= v 2^-2F <= 1, in the working format
+template<unsigned F>
+constexpr int64_t cordic_sqrt_unit(cordic_int128 v) noexcept {
+	if (v <= 0) return 0;
+	// v 2^-2F = w 4^-k with w in [1/4, 1)
+	uint64_t high = uint64_t(cordic_uint128(v) >> 64);
+	int width = (high ? 64 + int(std::bit_width(high)) : int(std::bit_width(uint64_t(v))));
+	int shift = int(F) - width;
+	if ((shift + int(F)) & 1) --shift;
+	int64_t w = static_cast<int64_t>(shift >= 0 ? v << shift : v >> -shift);
+	int64_t quarter = cordic_tables<F>::one >> 2;
+	int64_t x = w + quarter, y = w - quarter;
+	cordic_hyperbolic_vectoring<F>(x, y);
+	cordic_int128 r = cordic_round(cordic_int128(x) * cordic_tables<F>::hyperbolicGain, F);   // sqrt(w)
+	int k = (shift + int(F)) / 2;
+	return static_cast<int64_t>(k >= 0 ? cordic_round(r, unsigned(k)) : r << -k);
+}
+
+// x = raw 2^-rbits in the working format, rounded when rbits > F
+template<unsigned rbits, unsigned F>
+constexpr int64_t cordic_working(int64_t raw) noexcept {
+	if constexpr (F >= rbits) return raw << (F - rbits); else return static_cast<int64_t>(cordic_round(raw, rbits - F));
+}
+
+// 2^t for t = raw 2^-T, T <= 62: returns m in [0.7, 1.42) in the working format, and 2^t = m 2^k
+template<unsigned F>
+constexpr int64_t cordic_exp2(cordic_int128 t, unsigned T, int64_t& k) noexcept {
+	constexpr int64_t ln2_63 = static_cast<int64_t>(cordic_round(cordic_ln2_124, 61));
+	constexpr int64_t limit = int64_t(1) << 20;   // beyond the range of any fixpnt
+	if (t > (cordic_int128(limit) << T)) { k = limit; return cordic_tables<F>::one; }
+	if (t < -(cordic_int128(limit) << T)) { k = -limit; return cordic_tables<F>::one; }
+	cordic_int128 q = cordic_round(t, T);
+	cordic_int128 f = t - (q << T);   // |f| <= 2^(T - 1)
+	k = static_cast<int64_t>(q);
+	if (f == 0) return cordic_tables<F>::one;   // exact powers of two round like their ties
+	int64_t r = static_cast<int64_t>(cordic_round(f * ln2_63, T + 63 - F));
+	int64_t x = cordic_tables<F>::hyperbolicGain, y = 0;
+	cordic_hyperbolic_rotate<F>(x, y, r);
+	return x + y;
+}
+
+// t = raw 2^-rbits times a constant c 2^-60, as raw 2^-62
+template<unsigned rbits>
+constexpr cordic_int128 cordic_scale(cordic_int128 raw, int64_t c) noexcept {
+	cordic_int128 t = raw * c;
+	if constexpr (rbits >= 2) return cordic_round(t, rbits - 2); else return t << (2 - rbits);
+}
+
+// 2^t = m 2^k as a value in the working format, with k limited to keep it in 128 bits
+template<unsigned F>
+constexpr cordic_int128 cordic_ldexp(int64_t m, int64_t k) noexcept {
+	if (k > 64) return cordic_int128(1) << 126;
+	return (k >= 0 ? cordic_int128(m) << k : (k > -126 ? cordic_round(m, unsigned(-k)) : 0));
+}
+
+// x = raw 2^-rbits > 0 as w 2^e with w in [1/2, 1): returns ln(w) in the working format and e - rbits
+template<unsigned rbits, unsigned F>
+constexpr int64_t cordic_log(int64_t raw, int& exponent) noexcept {
+	int e = int(std::bit_width(uint64_t(raw)));
+	int64_t w = (int(F) >= e ? raw << (int(F) - e) : static_cast<int64_t>(cordic_round(raw, unsigned(e - int(F)))));
+	int64_t x = w + cordic_tables<F>::one, y = w - cordic_tables<F>::one;
+	int64_t z = cordic_hyperbolic_vectoring<F>(x, y);
+	exponent = e - int(rbits);
+	return 2 * z;
+}
+
+// ln(x) of x = raw 2^-rbits > 0, scaled by 2^(F + 56)
+template<unsigned rbits, unsigned F>
+constexpr cordic_int128 cordic_ln(int64_t raw) noexcept {
+	constexpr cordic_int128 ln2 = cordic_round(cordic_ln2_124, 68 - F);
+	int e;
+	int64_t lnw = cordic_log<rbits, F>(raw, e);
+	return (cordic_int128(lnw) << 56) + cordic_int128(e) * ln2;
+}
+
+// cos and sin of n elements: the iterations run in the outer loop over a block of elements, so that
+// the inner loop is a branch-free update of independent lanes
+template<typename Fixed>
+void cordic_sincos_batch(const Fixed* x, Fixed* sine, Fixed* cosine, size_t n) {
+	constexpr unsigned nbits = Fixed::nbits, rbits = Fixed::rbits;
+	constexpr unsigned F = cordic_fraction_bits(nbits, rbits);
+	constexpr size_t B = 64;
+	const auto& atan = cordic_tables<F>::atan;
+	int64_t X[B], Y[B], Z[B];
+	unsigned Q[B];
+	for (size_t base = 0; base < n; base += B) {
+		size_t m = (n - base < B ? n - base : B);
+		for (size_t j = 0; j < m; ++j) {
+			cordic_reduce_pio2<nbits, rbits, F>(cordic_raw(x[base + j]), Z[j], Q[j]);
+			X[j] = cordic_tables<F>::circularGain;
+			Y[j] = 0;
+		}
+		for (unsigned i = 0; i <= F; ++i) {
+			int64_t a = atan[i];
+			for (size_t j = 0; j < m; ++j) {
+				int64_t d = Z[j] >> 63;
+				int64_t dx = Y[j] >> i, dy = X[j] >> i;
+				X[j] -= (dx ^ d) - d;
+				Y[j] += (dy ^ d) - d;
+				Z[j] -= (a ^ d) - d;
+			}
+		}
+		for (size_t j = 0; j < m; ++j) {
+			int64_t c, s;
+			cordic_quadrant(Q[j], X[j], Y[j], c, s);
+			if (sine) sine[base + j] = cordic_fixpnt<Fixed>(s, F);
+			if (cosine) cosine[base + j] = cordic_fixpnt<Fixed>(c, F);
+		}
+	}
+}
+#endif // FIXPNT_NATIVE_MATH
+
+}} // namespace sw::universal
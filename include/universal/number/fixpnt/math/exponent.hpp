@@ -5,15 +5,25 @@
 // SPDX-License-Identifier: MIT
 //
 // This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/number/fixpnt/math/cordic.hpp>
 
 namespace sw { namespace universal {
 
 // the current shims are NON-COMPLIANT with the Universal standard, which says that every function must be
 // correctly rounded for every input value. Anything less sacrifices bitwise reproducibility of results.
+// Configurations of up to 64 bits evaluate exp, exp2, and exp10 with the hyperbolic CORDIC instead.
 
 // Base-e exponential function
 template<unsigned nbits, unsigned rbits, bool arithmetic, typename bt>
 fixpnt<nbits, rbits, arithmetic, bt> exp(fixpnt<nbits, rbits, arithmetic, bt> x) {
+#if FIXPNT_NATIVE_MATH
+	if constexpr (fixpnt_cordic<nbits>) {
+		constexpr unsigned F = cordic_fraction_bits(nbits, rbits);
+		int64_t k;
+		int64_t m = cordic_exp2<F>(cordic_scale<rbits>(cordic_raw(x), cordic_log2e_60), 62, k);
+		return cordic_fixpnt<fixpnt<nbits, rbits, arithmetic, bt>>(m, int64_t(F) - k);
+	}
+#endif
 	//if (isnan(x)) return x;
 	fixpnt<nbits, rbits, arithmetic, bt> p;
 	double d = std::exp(double(x));
@@ -29,6 +39,14 @@ fixpnt<nbits, rbits, arithmetic, bt> exp(fixpnt<nbits, rbits, arithmetic, bt> x)
 // Base-2 exponential function
 template<unsigned nbits, unsigned rbits, bool arithmetic, typename bt>
 fixpnt<nbits, rbits, arithmetic, bt> exp2(fixpnt<nbits, rbits, arithmetic, bt> x) {
+#if FIXPNT_NATIVE_MATH
+	if constexpr (fixpnt_cordic<nbits>) {
+		constexpr unsigned F = cordic_fraction_bits(nbits, rbits);
+		int64_t k;
+		int64_t m = cordic_exp2<F>(cordic_scale<rbits>(cordic_raw(x), int64_t(1) << 60), 62, k);
+		return cordic_fixpnt<fixpnt<nbits, rbits, arithmetic, bt>>(m, int64_t(F) - k);
+	}
+#endif
 	//if (isnan(x)) return x;
 	fixpnt<nbits, rbits, arithmetic, bt> p;
 	double d = std::exp2(double(x));
@@ -44,6 +62,14 @@ fixpnt<nbits, rbits, arithmetic, bt> exp2(fixpnt<nbits, rbits, arithmetic, bt> x
 // Base-10 exponential function
 template<unsigned nbits, unsigned rbits, bool arithmetic, typename bt>
 fixpnt<nbits, rbits, arithmetic, bt> exp10(fixpnt<nbits, rbits, arithmetic, bt> x) {
+#if FIXPNT_NATIVE_MATH
+	if constexpr (fixpnt_cordic<nbits>) {
+		constexpr unsigned F = cordic_fraction_bits(nbits, rbits);
+		int64_t k;
+		int64_t m = cordic_exp2<F>(cordic_scale<rbits>(cordic_raw(x), cordic_log2_10_60), 62, k);
+		return cordic_fixpnt<fixpnt<nbits, rbits, arithmetic, bt>>(m, int64_t(F) - k);
+	}
+#endif
 	return fixpnt<nbits, rbits, arithmetic, bt>(std::pow(10.0, double(x)));
 }
 		
@@ -5,6 +5,7 @@
 // SPDX-License-Identifier: MIT
 //
 // This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/number/fixpnt/math/cordic.hpp>
 
 namespace sw { namespace universal {
 
@@ -14,18 +15,51 @@ namespace sw { namespace universal {
 // hyperbolic sine of an angle of x radians
 template<unsigned nbits, unsigned rbits, bool arithmetic, typename bt>
 fixpnt<nbits, rbits, arithmetic, bt> sinh(fixpnt<nbits, rbits, arithmetic, bt> x) {
+#if FIXPNT_NATIVE_MATH
+	if constexpr (fixpnt_cordic<nbits>) {
+		constexpr unsigned F = cordic_fraction_bits(nbits, rbits);
+		int64_t raw = cordic_raw(x);
+		cordic_int128 t = cordic_scale<rbits>(raw < 0 ? -cordic_int128(raw) : cordic_int128(raw), cordic_log2e_60);   // |x| log2(e)
+		int64_t kp, kn;
+		int64_t mp = cordic_exp2<F>(t, 62, kp), mn = cordic_exp2<F>(-t, 62, kn);
+		cordic_int128 d = cordic_ldexp<F>(mp, kp) - cordic_ldexp<F>(mn, kn);   // 2 sinh(|x|)
+		return cordic_fixpnt<fixpnt<nbits, rbits, arithmetic, bt>>(raw < 0 ? -d : d, F + 1);
+	}
+#endif
 	return fixpnt<nbits, rbits, arithmetic, bt>(std::sinh(double(x)));
 }
 
 // hyperbolic cosine of an angle of x radians
 template<unsigned nbits, unsigned rbits, bool arithmetic, typename bt>
 fixpnt<nbits, rbits, arithmetic, bt> cosh(fixpnt<nbits, rbits, arithmetic, bt> x) {
+#if FIXPNT_NATIVE_MATH
+	if constexpr (fixpnt_cordic<nbits>) {
+		constexpr unsigned F = cordic_fraction_bits(nbits, rbits);
+		int64_t raw = cordic_raw(x);
+		cordic_int128 t = cordic_scale<rbits>(raw < 0 ? -cordic_int128(raw) : cordic_int128(raw), cordic_log2e_60);   // |x| log2(e)
+		int64_t kp, kn;
+		int64_t mp = cordic_exp2<F>(t, 62, kp), mn = cordic_exp2<F>(-t, 62, kn);
+		return cordic_fixpnt<fixpnt<nbits, rbits, arithmetic, bt>>(cordic_ldexp<F>(mp, kp) + cordic_ldexp<F>(mn, kn), F + 1);
+	}
+#endif
 	return fixpnt<nbits, rbits, arithmetic, bt>(std::cosh(double(x)));
 }
 
 // hyperbolic tangent of an angle of x radians
 template<unsigned nbits, unsigned rbits, bool arithmetic, typename bt>
 fixpnt<nbits, rbits, arithmetic, bt> tanh(fixpnt<nbits, rbits, arithmetic, bt> x) {
+#if FIXPNT_NATIVE_MATH
+	if constexpr (fixpnt_cordic<nbits>) {
+		constexpr unsigned F = cordic_fraction_bits(nbits, rbits);
+		int64_t raw = cordic_raw(x);
+		cordic_int128 t = cordic_scale<rbits>(raw < 0 ? -cordic_int128(raw) : cordic_int128(raw), cordic_log2e_60);   // |x| log2(e)
+		int64_t k;
+		int64_t m = cordic_exp2<F>(-2 * t, 62, k);
+		cordic_int128 e = cordic_ldexp<F>(m, k), one = cordic_tables<F>::one;   // e^(-2|x|)
+		cordic_int128 h = cordic_divide<F>(one - e, one + e);
+		return cordic_fixpnt<fixpnt<nbits, rbits, arithmetic, bt>>(raw < 0 ? -h : h, F);
+	}
+#endif
 	return fixpnt<nbits, rbits, arithmetic, bt>(std::tanh(double(x)));
 }
 
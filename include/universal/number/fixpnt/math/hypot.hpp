@@ -38,11 +38,19 @@ POSIX specifies that underflow may only occur when both arguments are subnormal
 
 hypot(INFINITY, NAN) returns +8, but sqrt(INFINITY*INFINITY+NAN*NAN) returns NaN.
 */
+#include <universal/number/fixpnt/math/cordic.hpp>
 
 namespace sw { namespace universal {
 
 template<unsigned nbits, unsigned rbits, bool arithmetic, typename bt>
 fixpnt<nbits, rbits, arithmetic, bt> hypot(fixpnt<nbits, rbits, arithmetic, bt> x, fixpnt<nbits, rbits, arithmetic, bt> y) {
+#if FIXPNT_NATIVE_MATH
+	if constexpr (fixpnt_cordic<nbits>) {
+		cordic_int128 magnitude;
+		cordic_atan2<cordic_fraction_bits(nbits, rbits)>(cordic_raw(y), cordic_raw(x), &magnitude);
+		return cordic_fixpnt<fixpnt<nbits, rbits, arithmetic, bt>>(magnitude, rbits);
+	}
+#endif
 	return fixpnt<nbits, rbits, arithmetic, bt>(std::hypot(double(x),double(y)));
 }
 
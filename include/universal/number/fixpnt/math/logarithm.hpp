@@ -5,24 +5,56 @@
 // SPDX-License-Identifier: MIT
 //
 // This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/number/fixpnt/math/cordic.hpp>
 
 namespace sw { namespace universal {
 
 // Natural logarithm of x
 template<unsigned nbits, unsigned rbits, bool arithmetic, typename bt>
 fixpnt<nbits, rbits, arithmetic, bt> log(fixpnt<nbits, rbits, arithmetic, bt> x) {
+#if FIXPNT_NATIVE_MATH
+	if constexpr (fixpnt_cordic<nbits>) {
+		constexpr unsigned F = cordic_fraction_bits(nbits, rbits);
+		int64_t raw = cordic_raw(x);
+		if (raw > 0) {
+			return cordic_fixpnt<fixpnt<nbits, rbits, arithmetic, bt>>(cordic_ln<rbits, F>(raw), F + 56);
+		}
+	}
+#endif
 	return fixpnt<nbits, rbits, arithmetic, bt>(std::log(double(x)));
 }
 
 // Binary logarithm of x
 template<unsigned nbits, unsigned rbits, bool arithmetic, typename bt>
 fixpnt<nbits, rbits, arithmetic, bt> log2(fixpnt<nbits, rbits, arithmetic, bt> x) {
+#if FIXPNT_NATIVE_MATH
+	if constexpr (fixpnt_cordic<nbits>) {
+		constexpr unsigned F = cordic_fraction_bits(nbits, rbits);
+		int64_t raw = cordic_raw(x);
+		if (raw > 0) {
+			int e;
+			int64_t lnw = cordic_log<rbits, F>(raw, e);
+			cordic_int128 l = cordic_int128(lnw) * cordic_log2e_60 + (cordic_int128(e) << (F + 60));
+			return cordic_fixpnt<fixpnt<nbits, rbits, arithmetic, bt>>(l, F + 60);
+		}
+	}
+#endif
 	return fixpnt<nbits, rbits, arithmetic, bt>(std::log2(double(x)));
 }
 
 // Decimal logarithm of x
 template<unsigned nbits, unsigned rbits, bool arithmetic, typename bt>
 fixpnt<nbits, rbits, arithmetic, bt> log10(fixpnt<nbits, rbits, arithmetic, bt> x) {
+#if FIXPNT_NATIVE_MATH
+	if constexpr (fixpnt_cordic<nbits>) {
+		constexpr unsigned F = cordic_fraction_bits(nbits, rbits);
+		int64_t raw = cordic_raw(x);
+		if (raw > 0) {
+			cordic_int128 l = cordic_round(cordic_ln<rbits, F>(raw), 56) * cordic_log10e_60;
+			return cordic_fixpnt<fixpnt<nbits, rbits, arithmetic, bt>>(l, F + 60);
+		}
+	}
+#endif
 	return fixpnt<nbits, rbits, arithmetic, bt>(std::log10(double(x)));
 }
 		
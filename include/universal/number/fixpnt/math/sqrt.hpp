@@ -119,28 +119,41 @@ namespace sw { namespace universal {
 
 
 #if FIXPNT_NATIVE_SQRT
-	// sqrt for arbitrary cfloat
+	// correctly rounded sqrt for arbitrary fixpnt: for a value v = raw * 2^-rbits, sqrt(v) = sqrt(raw * 2^rbits) * 2^-rbits,
+	// so the root encoding is the integer square root of the raw bits scaled by 2^rbits, rounded to nearest.
+	// The root r of radicand R rounds up when R - r^2 > r, that is, when R > (r + 1/2)^2, which cannot tie
 	template<unsigned nbits, unsigned rbits, bool arithmetic, typename bt>
 	inline fixpnt<nbits, rbits, arithmetic, bt> sqrt(const fixpnt<nbits, rbits, arithmetic, bt>& a) {
-		if (a < 0) std::cout << "sqrt arg is negative: " << a << std::endl;
-		if (a < 0) throw fixpnt_arithmetic_exception("argument to sqrt is negative");
 		using Fixed = fixpnt<nbits, rbits, arithmetic, bt>;
-		constexpr Fixed eps = std::numeric_limits<Fixed>::epsilon();
-		Fixed y(a);
-		Fixed x(a);
-		x >>= 1; // divide by 2
-		Fixed diff = (x * x - y);
-		int iterations = 0;
-		while (sw::universal::abs(diff) > eps) {
-			x = (x + y);
-			x >>= 1;
-			y = a / x;
-			diff = x - y;
-//			std::cout << " x: " << x << " y: " << y << " diff " << diff << '\n';
-			if (++iterations > static_cast<int>(rbits)) break;
+		using Radicand = blockbinary<nbits + rbits, bt, BinaryNumberType::Unsigned>;
+		constexpr unsigned N = Radicand::nrBlocks;
+#if FIXPNT_THROW_ARITHMETIC_EXCEPTION
+		if (a.isneg()) throw fixpnt_negative_sqrt_arg();
+#else
+		if (a.isneg()) {
+			std::cerr << "fixpnt_negative_sqrt_arg\n";
+			return Fixed(0);
 		}
-		if (iterations > static_cast<int>(rbits)) std::cerr << "sqrt(" << double(a) << ") failed to converge\n";
-		return x;
+#endif
+		blockbinary<nbits, bt> raw = a.bits();
+		Radicand radicand;
+		radicand.clear();
+		for (unsigned i = 0; i < blockbinary<nbits, bt>::nrBlocks; ++i) radicand.setblock(i, raw.block(i));
+		radicand <<= static_cast<int>(rbits);
+		bt limbs[N], root[N], rem[N];
+		for (unsigned i = 0; i < N; ++i) limbs[i] = radicand.block(i);
+		limb_sqrt<N>(root, rem, limbs);
+		bool roundup{ false };
+		for (unsigned i = N; i > 0; --i) {
+			if (rem[i - 1] != root[i - 1]) { roundup = rem[i - 1] > root[i - 1]; break; }
+		}
+		blockbinary<nbits, bt> bits;
+		bits.clear();
+		for (unsigned i = 0; i < blockbinary<nbits, bt>::nrBlocks; ++i) bits.setblock(i, root[i]);
+		Fixed result;
+		result = bits;
+		if (roundup) ++result;
+		return result;
 	}
 #else
 	template<unsigned nbits, unsigned rbits, bool arithmetic, typename bt>
@@ -6,6 +6,7 @@
 //
 // This file is part of the universal numbers project, which is released under an MIT Open Source license.
 #include <universal/math/math_constants.hpp>
+#include <universal/number/fixpnt/math/cordic.hpp>
 
 namespace sw { namespace universal {
 
@@ -15,42 +16,115 @@ namespace sw { namespace universal {
 // sine of an angle of x radians
 template<unsigned nbits, unsigned rbits, bool arithmetic, typename bt>
 fixpnt<nbits, rbits, arithmetic, bt> sin(fixpnt<nbits, rbits, arithmetic, bt> x) {
+#if FIXPNT_NATIVE_MATH
+	if constexpr (fixpnt_cordic<nbits>) {
+		constexpr unsigned F = cordic_fraction_bits(nbits, rbits);
+		int64_t c, s;
+		cordic_sincos<nbits, rbits>(cordic_raw(x), c, s);
+		return cordic_fixpnt<fixpnt<nbits, rbits, arithmetic, bt>>(s, F);
+	}
+#endif
 	return fixpnt<nbits, rbits, arithmetic, bt>(std::sin(double(x)));
 }
 
 // cosine of an angle of x radians
 template<unsigned nbits, unsigned rbits, bool arithmetic, typename bt>
 fixpnt<nbits, rbits, arithmetic, bt> cos(fixpnt<nbits, rbits, arithmetic, bt> x) {
+#if FIXPNT_NATIVE_MATH
+	if constexpr (fixpnt_cordic<nbits>) {
+		constexpr unsigned F = cordic_fraction_bits(nbits, rbits);
+		int64_t c, s;
+		cordic_sincos<nbits, rbits>(cordic_raw(x), c, s);
+		return cordic_fixpnt<fixpnt<nbits, rbits, arithmetic, bt>>(c, F);
+	}
+#endif
 	return fixpnt<nbits, rbits, arithmetic, bt>(std::cos(double(x)));
 }
 
 // tangent of an angle of x radians
 template<unsigned nbits, unsigned rbits, bool arithmetic, typename bt>
 fixpnt<nbits, rbits, arithmetic, bt> tan(fixpnt<nbits, rbits, arithmetic, bt> x) {
+#if FIXPNT_NATIVE_MATH
+	if constexpr (fixpnt_cordic<nbits>) {
+		constexpr unsigned F = cordic_fraction_bits(nbits, rbits);
+		int64_t c, s;
+		cordic_sincos<nbits, rbits>(cordic_raw(x), c, s);
+		return cordic_fixpnt<fixpnt<nbits, rbits, arithmetic, bt>>(cordic_divide<F>(s, c), F);
+	}
+#endif
 	return fixpnt<nbits, rbits, arithmetic, bt>(std::tan(double(x)));
 }
 
-// cotangent of an angle of x radians
+// sine and cosine of n angles: either output may be null
+template<unsigned nbits, unsigned rbits, bool arithmetic, typename bt>
+void sincos(const fixpnt<nbits, rbits, arithmetic, bt>* x, fixpnt<nbits, rbits, arithmetic, bt>* s, fixpnt<nbits, rbits, arithmetic, bt>* c, size_t n) {
+#if FIXPNT_NATIVE_MATH
+	if constexpr (fixpnt_cordic<nbits>) {
+		cordic_sincos_batch(x, s, c, n);
+		return;
+	}
+#endif
+	for (size_t i = 0; i < n; ++i) {
+		if (s) s[i] = sin(x[i]);
+		if (c) c[i] = cos(x[i]);
+	}
+}
+
+// arc tangent of x
 template<unsigned nbits, unsigned rbits, bool arithmetic, typename bt>
 fixpnt<nbits, rbits, arithmetic, bt> atan(fixpnt<nbits, rbits, arithmetic, bt> x) {
+#if FIXPNT_NATIVE_MATH
+	if constexpr (fixpnt_cordic<nbits>) {
+		constexpr unsigned F = cordic_fraction_bits(nbits, rbits);
+		return cordic_fixpnt<fixpnt<nbits, rbits, arithmetic, bt>>(cordic_atan2<F>(cordic_raw(x), cordic_int128(1) << rbits), F);
+	}
+#endif
 	return fixpnt<nbits, rbits, arithmetic, bt>(std::atan(double(x)));
 }
 		
 // Arc tangent with two parameters
 template<unsigned nbits, unsigned rbits, bool arithmetic, typename bt>
 fixpnt<nbits, rbits, arithmetic, bt> atan2(fixpnt<nbits, rbits, arithmetic, bt> y, fixpnt<nbits, rbits, arithmetic, bt> x) {
+#if FIXPNT_NATIVE_MATH
+	if constexpr (fixpnt_cordic<nbits>) {
+		constexpr unsigned F = cordic_fraction_bits(nbits, rbits);
+		return cordic_fixpnt<fixpnt<nbits, rbits, arithmetic, bt>>(cordic_atan2<F>(cordic_raw(y), cordic_raw(x)), F);
+	}
+#endif
 	return fixpnt<nbits, rbits, arithmetic, bt>(std::atan2(double(y),double(x)));
 }
 
-// cosecant of an angle of x radians
+// arc cosine of x
 template<unsigned nbits, unsigned rbits, bool arithmetic, typename bt>
 fixpnt<nbits, rbits, arithmetic, bt> acos(fixpnt<nbits, rbits, arithmetic, bt> x) {
+#if FIXPNT_NATIVE_MATH
+	if constexpr (fixpnt_cordic<nbits>) {
+		constexpr unsigned F = cordic_fraction_bits(nbits, rbits);
+		int64_t raw = cordic_raw(x);
+		if (raw <= (int64_t(1) << rbits) && raw >= -(int64_t(1) << rbits)) {
+			int64_t v = cordic_working<rbits, F>(raw), one = cordic_tables<F>::one;
+			int64_t c = cordic_sqrt_unit<F>(cordic_int128(one - v) * (one + v));   // sqrt(1 - x^2)
+			return cordic_fixpnt<fixpnt<nbits, rbits, arithmetic, bt>>(cordic_atan2<F>(c, v), F);
+		}
+	}
+#endif
 	return fixpnt<nbits, rbits, arithmetic, bt>(std::acos(double(x)));
 }
 
-// secant of an angle of x radians
+// arc sine of x
 template<unsigned nbits, unsigned rbits, bool arithmetic, typename bt>
 fixpnt<nbits, rbits, arithmetic, bt> asin(fixpnt<nbits, rbits, arithmetic, bt> x) {
+#if FIXPNT_NATIVE_MATH
+	if constexpr (fixpnt_cordic<nbits>) {
+		constexpr unsigned F = cordic_fraction_bits(nbits, rbits);
+		int64_t raw = cordic_raw(x);
+		if (raw <= (int64_t(1) << rbits) && raw >= -(int64_t(1) << rbits)) {
+			int64_t v = cordic_working<rbits, F>(raw), one = cordic_tables<F>::one;
+			int64_t c = cordic_sqrt_unit<F>(cordic_int128(one - v) * (one + v));   // sqrt(1 - x^2)
+			return cordic_fixpnt<fixpnt<nbits, rbits, arithmetic, bt>>(cordic_atan2<F>(v, c), F);
+		}
+	}
+#endif
 	return fixpnt<nbits, rbits, arithmetic, bt>(std::asin(double(x)));
 }
 
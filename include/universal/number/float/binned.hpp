@@ -0,0 +1,215 @@
+#pragma once
+// binned.hpp: pre-rounded binned accumulator for reproducible sums of IEEE-754 floats and doubles
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+namespace sw { namespace universal {
+
+/*
+ * binned_accumulator<Real, K> is the indexed sum of Demmel and Nguyen, as implemented by ReproBLAS.
+ * The exponent range of Real is cut into bins of W bits on a fixed grid, and the accumulator keeps the
+ * K consecutive bins below the largest magnitude seen so far. Each bin is a floating-point value M + s
+ * with an extractor M = 1.5 * 2^(a + p - 1), so that (x + M) - M rounds x to a multiple of 2^a, the
+ * least significant bit of the bin. A term deposits that rounded part in the top bin, and its exact
+ * remainder in the bins below: the part of a term that lands in a bin depends on the term and the grid
+ * only, and the bins add multiples of their least significant bit without rounding. The state is thus
+ * the same for any order of the terms and any grouping of accumulators, and so is the rounded sum.
+ * The bins resolve at least (K - 1) * W bits below the largest term, 80 bits for double and 26 bits for
+ * float, and the sum is rounded once from the bins.
+ *
+ * A bin absorbs 2^(p - W - 4) deposits before its value must be renormalized by moving multiples of a
+ * quarter of M to an integer carry. The bins above 2^(emax - p) are scaled by 2^-p to keep their
+ * extractors finite. Infinities and NaNs are summed separately, which is order independent as well.
+ */
+template<typename Real, unsigned K = 3>
+class binned_accumulator {
+	static_assert(std::is_same_v<Real, float> || std::is_same_v<Real, double>, "binned_accumulator: Real must be float or double");
+	static_assert(K >= 2, "binned_accumulator: at least two bins are required");
+public:
+	static constexpr int      p = std::numeric_limits<Real>::digits;
+	static constexpr int      W = (p > 24 ? 40 : 13);                                  // bits per bin
+	static constexpr int      lsb = std::numeric_limits<Real>::min_exponent - p;       // least significant bit of the lowest bin
+	static constexpr int      emax = std::numeric_limits<Real>::max_exponent;          // finite values are smaller than 2^emax
+	static constexpr int      nrBins = (emax - W + 1 - lsb + W - 1) / W + 1;
+	static constexpr uint64_t endurance = uint64_t(1) << (p - W - 4);                  // deposits between renormalizations
+
+	binned_accumulator() noexcept { clear(); }
+
+	void clear() noexcept {
+		_top = -1;
+		_folds = 0;
+		_scaledFolds = 0;
+		_limit = Real(0);
+		_pending = 0;
+		_special = Real(0);
+		for (unsigned k = 0; k < K; ++k) { _primary[k] = Real(0); _carry[k] = 0; }
+	}
+	bool iszero() const noexcept { return value() == Real(0); }
+
+	binned_accumulator& operator+=(Real x) noexcept {
+		if (!(std::abs(x) < _limit)) {
+			if (!std::isfinite(x)) { _special += x; return *this; }
+			if (x == Real(0)) return *this;
+			raise(bin_of(x));
+		}
+		deposit(x);
+		if (++_pending == endurance) renormalize();
+		return *this;
+	}
+	binned_accumulator& operator-=(Real x) noexcept { return *this += -x; }
+
+	// merge the bins of another accumulator: the carries and the bin values are integer multiples, so this is exact
+	binned_accumulator& operator+=(const binned_accumulator& rhs) noexcept {
+		_special += rhs._special;
+		if (rhs._top < 0) return *this;
+		binned_accumulator other(rhs);
+		if (other._top > _top) raise(other._top); else other.raise(_top);
+		renormalize();
+		other.renormalize();
+		for (unsigned k = 0; k < _folds; ++k) {
+			_primary[k] += other._primary[k] - _M[k];
+			_carry[k] += other._carry[k];
+		}
+		renormalize();
+		return *this;
+	}
+
+	// the sum rounded to Real
+	Real value() const noexcept {
+		double hi, lo;
+		resolve(hi, lo);
+		return (std::is_same_v<Real, float> ? Real(hi + lo) : Real(hi));
+	}
+	explicit operator Real() const noexcept { return value(); }
+
+	// the sum as an unevaluated pair hi + lo of doubles with |lo| <= ulp(hi) / 2
+	void value(double& hi, double& lo) const noexcept { resolve(hi, lo); }
+
+private:
+	int      _top;            // grid index of the top bin, -1 when empty
+	unsigned _folds;          // number of bins above the bottom of the grid, at most K
+	unsigned _scaledFolds;    // number of top bins that are scaled by 2^-p
+	Real     _limit;          // terms smaller than this magnitude fit in the top bin
+	Real     _M[K];           // extractors of the bins
+	Real     _primary[K];     // M + the sum of the deposits since the last renormalization
+	int64_t  _carry[K];       // number of quarters of M moved out of the primary value
+	uint64_t _pending;
+	Real     _special;        // sum of the infinities and NaNs
+
+	struct grid {
+		Real extractor[nrBins];
+		Real quarter[nrBins];
+		Real limit[nrBins];
+		bool scaled[nrBins];
+		grid() {
+			for (int j = 0; j < nrBins; ++j) {
+				int a = lsb + j * W;
+				scaled[j] = (a > emax - p);
+				int e = (scaled[j] ? a - p : a);
+				extractor[j] = std::ldexp(Real(1.5), e + p - 1);
+				quarter[j] = std::ldexp(Real(1), e + p - 3);
+				limit[j] = (a + W - 1 < emax ? std::ldexp(Real(1), a + W - 1) : std::numeric_limits<Real>::infinity());
+			}
+		}
+	};
+	static const grid& bins() {
+		static const grid g;
+		return g;
+	}
+
+	// lowest grid index of a top bin that holds x
+	static int bin_of(Real x) noexcept {
+		int e = std::ilogb(x) + 1;   // |x| < 2^e
+		int j = (e - W + 1 - lsb + W - 1) / W;
+		return (j < 0 ? 0 : (j < nrBins ? j : nrBins - 1));
+	}
+
+	// move the bins up so that the top bin is grid index j
+	void raise(int j) noexcept {
+		if (j <= _top) return;
+		const grid& g = bins();
+		unsigned shift = unsigned(j - _top);
+		for (unsigned k = K; k-- > 0;) {
+			if (_top >= 0 && k >= shift) {
+				_primary[k] = _primary[k - shift];
+				_carry[k] = _carry[k - shift];
+			}
+			else if (j >= int(k)) {
+				_primary[k] = g.extractor[j - int(k)];
+				_carry[k] = 0;
+			}
+		}
+		_top = j;
+		_folds = (j + 1 < int(K) ? unsigned(j + 1) : K);
+		_scaledFolds = 0;
+		for (unsigned k = 0; k < _folds; ++k) {
+			_M[k] = g.extractor[j - k];
+			if (g.scaled[j - k]) ++_scaledFolds;
+		}
+		_limit = g.limit[j];
+	}
+
+	// split x over the bins: the part of x in a bin is x rounded to the least significant bit of the bin
+	void deposit(Real x) noexcept {
+		unsigned k = 0;
+		for (; k < _scaledFolds; ++k) {
+			Real y = std::ldexp(x, -p);
+			Real t = (y + _M[k]) - _M[k];
+			_primary[k] += t;
+			if (t != Real(0)) x = std::ldexp(y - t, p);
+		}
+		for (; k < _folds; ++k) {
+			Real t = (x + _M[k]) - _M[k];
+			_primary[k] += t;
+			x -= t;
+		}
+	}
+
+	// move whole quarters of M from the primary values to the carries, leaving |primary - M| <= M / 12
+	void renormalize() noexcept {
+		const grid& g = bins();
+		for (unsigned k = 0; k < _folds; ++k) {
+			Real quarter = g.quarter[_top - int(k)];
+			Real q = std::floor((_primary[k] - _M[k]) / quarter + Real(0.5));
+			_primary[k] -= q * quarter;
+			_carry[k] += int64_t(q);
+		}
+		_pending = 0;
+	}
+
+	// add the bins from the top down in double-double arithmetic: the state is canonical after the
+	// renormalization, so the result is a function of the exact bin sums only
+	void resolve(double& hi, double& lo) const noexcept {
+		hi = 0.0;
+		lo = 0.0;
+		if (_special != Real(0) || std::isnan(_special)) { hi = double(_special); return; }
+		binned_accumulator a(*this);
+		a.renormalize();
+		const grid& g = bins();
+		auto add = [&](double v) {
+			double s = hi + v;
+			double bv = s - hi;
+			lo += (hi - (s - bv)) + (v - bv);
+			hi = s;
+		};
+		for (unsigned k = 0; k < a._folds; ++k) {
+			int j = a._top - int(k);
+			double scale = (g.scaled[j] ? std::ldexp(1.0, p) : 1.0);
+			if (a._carry[k] != 0) add(double(a._carry[k]) * double(g.quarter[j]) * scale);
+			add(double(a._primary[k] - a._M[k]) * scale);
+		}
+		if (!std::isfinite(hi)) { lo = 0.0; return; }   // the top bins of a sum beyond the range of double
+		double s = hi + lo;
+		lo -= s - hi;
+		hi = s;
+	}
+};
+
+}} // namespace sw::universal
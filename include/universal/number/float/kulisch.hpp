@@ -0,0 +1,249 @@
+#pragma once
+// kulisch.hpp: word-based exact accumulator for the dot products of IEEE-754 floats and doubles
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+#include <vector>
+#include <universal/native/limb_arithmetic.hpp>
+#include <universal/utility/parallel.hpp>
+
+namespace sw { namespace universal {
+
+/*
+ * kulisch_accumulator<Real> holds the exact sum of products of floats or doubles in a fixed-point register
+ * that spans the squares of the smallest subnormal and of the largest value of Real, plus 64 capacity bits:
+ * 4260 bits for double and 618 bits for float. The bitblock quire of sw::ieee adds a product bit by bit;
+ * this register is an array of signed 64-bit limbs that each hold a 32-bit digit. The upper half of a limb
+ * absorbs the carries and borrows of 2^30 additions, so a product is added with a few independent limb
+ * additions, and the carries are resolved lazily: when the pending additions could overflow a limb, when
+ * accumulators are merged, and when the sum is rounded. The sum is exact, so it does not depend on the
+ * order of the additions, and dot products are reproducible across blockings and thread counts.
+ */
+template<typename Real>
+class kulisch_accumulator {
+	static_assert(std::is_same_v<Real, float> || std::is_same_v<Real, double>, "kulisch_accumulator: Real must be float or double");
+public:
+	using Bits = std::conditional_t<std::is_same_v<Real, float>, uint32_t, uint64_t>;
+	static constexpr int      fbits = std::numeric_limits<Real>::digits;                // significand bits including the hidden bit
+	static constexpr int      emin = std::numeric_limits<Real>::min_exponent - fbits;   // exponent of the smallest subnormal
+	static constexpr int      emax = std::numeric_limits<Real>::max_exponent;           // finite values are smaller than 2^emax
+	static constexpr int      lsb = 2 * emin;                                           // exponent of the least significant bit of the register
+	static constexpr unsigned capacity = 64;
+	static constexpr unsigned qbits = unsigned(2 * emax - lsb) + capacity;
+	static constexpr unsigned digitBits = 32;
+	static constexpr unsigned nrLimbs = (qbits + digitBits - 1) / digitBits + 1;       // the top limb holds the sign
+	static constexpr unsigned nrProductDigits = (2 * fbits + 63 + digitBits - 1) / digitBits;   // a product aligned to a pair of digits
+	static constexpr uint64_t maxPending = uint64_t(1) << 30;                           // additions before the carries must be resolved
+	static constexpr size_t   blockSize = 256;                                          // products between checks of the pending additions
+
+	kulisch_accumulator() noexcept { clear(); }
+
+	void clear() noexcept {
+		for (unsigned i = 0; i < nrLimbs; ++i) _limb[i] = 0;
+		_pending = 0;
+		_nan = _posInf = _negInf = false;
+	}
+	bool iszero() const noexcept {
+		if (_nan || _posInf || _negInf) return false;
+		kulisch_accumulator a(*this);
+		a.normalize();
+		for (unsigned i = 0; i < nrLimbs; ++i) if (a._limb[i] != 0) return false;
+		return true;
+	}
+
+	// add the exact product a * b
+	kulisch_accumulator& add_product(Real a, Real b) noexcept {
+		if (_pending >= maxPending) normalize();
+		accumulate(a, b);
+		++_pending;
+		return *this;
+	}
+	kulisch_accumulator& operator+=(Real a) noexcept { return add_product(a, Real(1)); }
+	kulisch_accumulator& operator-=(Real a) noexcept { return add_product(a, Real(-1)); }
+
+	// add the exact products x[i] * y[i] for i in [0, n): the pending additions are checked once per block
+	kulisch_accumulator& add_products(const Real* x, const Real* y, size_t n) noexcept {
+		for (size_t first = 0; first < n; first += blockSize) {
+			size_t last = (first + blockSize < n ? first + blockSize : n);
+			if (_pending + blockSize > maxPending) normalize();
+			for (size_t i = first; i < last; ++i) accumulate(x[i], y[i]);
+			_pending += last - first;
+		}
+		return *this;
+	}
+
+	// exact sum of two accumulators
+	kulisch_accumulator& operator+=(const kulisch_accumulator& rhs) noexcept {
+		kulisch_accumulator r(rhs);
+		r.normalize();
+		normalize();
+		for (unsigned i = 0; i < nrLimbs; ++i) _limb[i] += r._limb[i];
+		_pending = 2;
+		_nan = _nan || r._nan;
+		_posInf = _posInf || r._posInf;
+		_negInf = _negInf || r._negInf;
+		return *this;
+	}
+
+	// the sum rounded to nearest, ties to even: an overflow of inf - inf is NaN
+	Real value() const noexcept {
+		if (_nan || (_posInf && _negInf)) return std::numeric_limits<Real>::quiet_NaN();
+		if (_posInf) return std::numeric_limits<Real>::infinity();
+		if (_negInf) return -std::numeric_limits<Real>::infinity();
+		kulisch_accumulator a(*this);
+		a.normalize();
+		bool negative = a._limb[nrLimbs - 1] < 0;
+		if (negative) {
+			for (unsigned i = 0; i < nrLimbs; ++i) a._limb[i] = -a._limb[i];
+			a.normalize();
+		}
+		Real magnitude = a.round_magnitude();
+		return (negative ? -magnitude : magnitude);
+	}
+	explicit operator Real() const noexcept { return value(); }
+
+private:
+	alignas(16) int64_t _limb[nrLimbs];   // 32-bit digits with the carries of the pending additions, least significant first
+	uint64_t _pending;                    // additions since the carries were last resolved
+	bool     _nan, _posInf, _negInf;
+
+	static constexpr int      bias = std::numeric_limits<Real>::max_exponent - 1;
+	static constexpr Bits     fractionMask = (Bits(1) << (fbits - 1)) - 1;
+	static constexpr unsigned exponentMask = (1u << (sizeof(Real) * 8 - fbits)) - 1;
+	static constexpr uint64_t digitMask = 0xFFFF'FFFFull;
+
+	// add the product of a and b with the carries left pending
+	void accumulate(Real a, Real b) noexcept {
+		Bits ba, bb;
+		std::memcpy(&ba, &a, sizeof(Real));
+		std::memcpy(&bb, &b, sizeof(Real));
+		unsigned ea = unsigned(ba >> (fbits - 1)) & exponentMask;
+		unsigned eb = unsigned(bb >> (fbits - 1)) & exponentMask;
+		bool negative = ((ba ^ bb) >> (sizeof(Real) * 8 - 1)) != 0;
+		if (ea == exponentMask || eb == exponentMask) {
+			special(a, b, negative);
+			return;
+		}
+		// significands and exponents of the least significant bits, subnormals included
+		uint64_t ma = uint64_t(ba & fractionMask) | (ea != 0 ? (uint64_t(1) << (fbits - 1)) : 0);
+		uint64_t mb = uint64_t(bb & fractionMask) | (eb != 0 ? (uint64_t(1) << (fbits - 1)) : 0);
+		unsigned position = (ea != 0 ? ea : 1u) + (eb != 0 ? eb : 1u) - 2 * unsigned(bias + fbits - 1) - unsigned(lsb);
+		uint64_t lo, hi{ 0 };
+		if constexpr (fbits > 32) {
+			lo = limb_muladd<uint64_t>(ma, mb, 0, hi);
+		}
+		else {
+			lo = ma * mb;
+		}
+		// the product starts at an even digit, so that the products touch the same aligned pairs of limbs,
+		// which the compiler may update with 128-bit loads and stores that forward to each other
+		unsigned k = 2 * (position / 64), s = position % 64;
+		uint64_t w0 = lo << s;
+		uint64_t w1 = (hi << s) | ((lo >> 1) >> (63 - s));  // two shifts avoid the undefined shift by 64 when s is 0
+		uint64_t w2 = (hi >> 1) >> (63 - s);
+		// negate the digits of a negative product instead of branching on the sign
+		int64_t m = -int64_t(negative);
+		int64_t* limb = _limb + k;
+		limb[0] += (int64_t(w0 & digitMask) ^ m) - m;
+		limb[1] += (int64_t(w0 >> 32) ^ m) - m;
+		limb[2] += (int64_t(w1 & digitMask) ^ m) - m;
+		limb[3] += (int64_t(w1 >> 32) ^ m) - m;
+		if constexpr (nrProductDigits > 4) {
+			limb[4] += (int64_t(w2 & digitMask) ^ m) - m;
+			limb[5] += (int64_t(w2 >> 32) ^ m) - m;
+		}
+	}
+
+	// products with an infinite or NaN operand
+	void special(Real a, Real b, bool negative) noexcept {
+		if (std::isnan(a) || std::isnan(b) || a == Real(0) || b == Real(0)) {
+			_nan = true;
+		}
+		else {
+			(negative ? _negInf : _posInf) = true;
+		}
+	}
+
+	// resolve the carries: all limbs but the top one hold a digit in [0, 2^32), the top limb holds the sign
+	void normalize() noexcept {
+		int64_t carry{ 0 };
+		for (unsigned i = 0; i < nrLimbs - 1; ++i) {
+			int64_t v = _limb[i] + carry;
+			carry = v >> digitBits;  // arithmetic shift: a borrow is a carry of -1
+			_limb[i] = int64_t(uint64_t(v) & digitMask);
+		}
+		_limb[nrLimbs - 1] += carry;
+		_pending = 0;
+	}
+
+	uint64_t digit(int i) const noexcept { return (i >= 0 && i < int(nrLimbs)) ? uint64_t(_limb[i]) : 0; }
+
+	// the count <= 53 bits of the normalized register starting at bit position from
+	uint64_t field(unsigned from, unsigned count) const noexcept {
+		int i = int(from / digitBits);
+		unsigned offset = from % digitBits;
+		uint64_t w = (digit(i) >> offset) | (digit(i + 1) << (digitBits - offset));
+		if (offset != 0) w |= digit(i + 2) << (64 - offset);
+		return w & ((uint64_t(1) << count) - 1);
+	}
+
+	// any bit set below bit position p of the normalized register
+	bool sticky(unsigned p) const noexcept {
+		unsigned i = p / digitBits;
+		for (unsigned j = 0; j < i; ++j) if (_limb[j] != 0) return true;
+		return (uint64_t(_limb[i]) & ((uint64_t(1) << (p % digitBits)) - 1)) != 0;
+	}
+
+	// round the normalized, non-negative register to nearest, ties to even
+	Real round_magnitude() const noexcept {
+		int top = int(nrLimbs) - 1;
+		while (top >= 0 && _limb[top] == 0) --top;
+		if (top < 0) return Real(0);
+		int msb = top * int(digitBits) + std::bit_width(uint64_t(_limb[top])) - 1;
+		int scale = msb + lsb;
+		if (scale >= emax) return std::numeric_limits<Real>::infinity();
+		int resultLsb = (scale - (fbits - 1) > emin ? scale - (fbits - 1) : emin);
+		unsigned from = unsigned(resultLsb - lsb);
+		uint64_t significand = field(from, unsigned(msb) - from + 1);
+		bool guard = field(from - 1, 1) != 0;
+		if (guard && (significand & 1 || sticky(from - 1))) ++significand;
+		return std::ldexp(Real(significand), resultLsb);
+	}
+};
+
+// grain of the parallel fused dot product: fewer products per thread are not worth spawning threads
+constexpr size_t KULISCH_PARALLEL_GRAIN = 16384;
+
+// fused dot product of the float or double arrays x[0, n) and y[0, n) with one rounding
+template<typename Real>
+std::enable_if_t<std::is_floating_point_v<Real>, Real> fdp(const Real* x, const Real* y, size_t n) {
+	kulisch_accumulator<Real> q;
+	q.add_products(x, y, n);
+	return q.value();
+}
+
+// fused dot product on nrThreads threads, 0 for all hardware threads: the accumulators of the threads
+// are merged exactly, so the result is identical to the serial fused dot product for any number of threads
+template<typename Real>
+std::enable_if_t<std::is_floating_point_v<Real>, Real> fdp_parallel(const Real* x, const Real* y, size_t n, unsigned nrThreads = 0) {
+	if (nrThreads == 0) nrThreads = hardware_threads();
+	size_t maxThreads = (n + KULISCH_PARALLEL_GRAIN - 1) / KULISCH_PARALLEL_GRAIN;
+	if (maxThreads < nrThreads) nrThreads = static_cast<unsigned>(maxThreads);
+	if (nrThreads <= 1) return fdp(x, y, n);
+	std::vector<kulisch_accumulator<Real>> partials(nrThreads);
+	parallel_for(0, n, [&](size_t first, size_t last, unsigned t) {
+		partials[t].add_products(x + first, y + first, last - first);
+	}, nrThreads);
+	for (unsigned t = 1; t < nrThreads; ++t) partials[0] += partials[t];
+	return partials[0].value();
+}
+
+}} // namespace sw::universal
@@ -32,6 +32,11 @@ struct integer_negative_sqrt_arg : public integer_arithmetic_exception {
 	integer_negative_sqrt_arg() : integer_arithmetic_exception("negative input argument to sqrt function") {}
 };
 
+// Montgomery arithmetic requires an odd modulus larger than 1
+struct integer_modulus_not_odd : public integer_arithmetic_exception {
+	integer_modulus_not_odd() : integer_arithmetic_exception("modulus of Montgomery arithmetic is not odd") {}
+};
+
 // encoding exception for Whole Integers
 struct integer_wholenumber_cannot_be_zero : public integer_encoding_exception {
 	integer_wholenumber_cannot_be_zero() : integer_encoding_exception("whole numbers can't be zero") {}
@@ -56,6 +56,7 @@
 #include <universal/number/integer/sieves.hpp>
 #include <universal/number/integer/manipulators.hpp>
 #include <universal/number/integer/attributes.hpp>
+#include <universal/number/integer/modular.hpp>
 
 ///////////////////////////////////////////////////////////////////////////////////////
 /// math library specialized for integer<>
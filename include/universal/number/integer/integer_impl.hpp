@@ -17,6 +17,7 @@
 #include <universal/number/shared/specific_value_encoding.hpp>
 #include <universal/number/shared/blocktype.hpp>
 #include <universal/native/integers.hpp> // just for printing native integers in binary form
+#include <universal/native/limb_arithmetic.hpp>
 
 /*
 the integer arithmetic can be configured to:
@@ -80,6 +81,22 @@ struct idiv_t {
 	integer<nbits, BlockType, NumberType> rem;  // remainder
 };
 
+// unsigned division of the magnitudes a and b, a limb at a time: q = a / b, r = a % b
+template<unsigned nbits, typename BlockType, IntegerNumberType NumberType>
+void udivmod(const integer<nbits, BlockType, NumberType>& a, const integer<nbits, BlockType, NumberType>& b, integer<nbits, BlockType, NumberType>& q, integer<nbits, BlockType, NumberType>& r) {
+	constexpr unsigned nrLimbs = integer<nbits, BlockType, NumberType>::nrBlocks;
+	BlockType aLimbs[nrLimbs], bLimbs[nrLimbs], qLimbs[nrLimbs], rLimbs[nrLimbs];
+	for (unsigned i = 0; i < nrLimbs; ++i) {
+		aLimbs[i] = a.block(i);
+		bLimbs[i] = b.block(i);
+	}
+	limb_divide<nrLimbs, nrLimbs>(qLimbs, rLimbs, aLimbs, bLimbs);
+	for (unsigned i = 0; i < nrLimbs; ++i) {
+		q.setblock(i, qLimbs[i]);
+		r.setblock(i, rLimbs[i]);
+	}
+}
+
 /*
 The rules for detecting overflow in a two's complement sum are simple:
  - If the sum of two positive numbers yields a negative result, the sum has overflowed.
@@ -326,57 +343,15 @@ public:
 		return *this;
 	}
 	integer& operator*=(const integer& rhs) {
-		if constexpr (NumberType == IntegerNumberType::IntegerNumber) {
-			if constexpr (nrBlocks == 1) {
-				_block[0] = static_cast<bt>(_block[0] * rhs.block(0));
-			}
-			else {
-				// is there a better way than upconverting to deal with maxneg in a 2's complement encoding?
-				integer<nbits + 1, BlockType, NumberType> base(*this);
-				integer<nbits + 1, BlockType, NumberType> multiplicant(rhs);
-				bool resultIsNeg = (base.isneg() ^ multiplicant.isneg());
-				if (base.isneg()) {
-					base.twosComplement();
-				}
-				if (multiplicant.isneg()) {
-					multiplicant.twosComplement();
-				}
-				clear();
-				for (unsigned i = 0; i < static_cast<unsigned>(nrBlocks); ++i) {
-					std::uint64_t segment(0);
-					for (unsigned j = 0; j < static_cast<unsigned>(nrBlocks); ++j) {
-						segment += static_cast<std::uint64_t>(base.block(i)) * static_cast<std::uint64_t>(multiplicant.block(j));
-
-						if (i + j < static_cast<unsigned>(nrBlocks)) {
-							segment += _block[i + j];
-							_block[i + j] = static_cast<bt>(segment);
-							segment >>= bitsInBlock;
-						}
-					}
-				}
-				if (resultIsNeg) twosComplement();
-			}
+		if constexpr (nrBlocks == 1) {
+			_block[0] = static_cast<bt>(_block[0] * rhs.block(0));
 		}
-		else {  // whole and natural numbers are closed under multiplication (modulo)
-			if constexpr (nrBlocks == 1) {
-				_block[0] = static_cast<bt>(_block[0] * rhs.block(0));
-			}
-			else {
-				integer<nbits, BlockType, NumberType> base(*this), multiplicant(rhs);
-				clear();
-				for (unsigned i = 0; i < static_cast<unsigned>(nrBlocks); ++i) {
-					std::uint64_t segment(0);
-					for (unsigned j = 0; j < static_cast<unsigned>(nrBlocks); ++j) {
-						segment += static_cast<std::uint64_t>(base.block(i)) * static_cast<std::uint64_t>(multiplicant.block(j));
-
-						if (i + j < static_cast<unsigned>(nrBlocks)) {
-							segment += _block[i + j];
-							_block[i + j] = static_cast<bt>(segment);
-							segment >>= bitsInBlock;
-						}
-					}
-				}
-			}
+		else {
+			// the low nbits of a 2's complement product do not depend on the signs of the operands,
+			// so integer, whole, and natural numbers share the truncated limb-by-limb product
+			integer product;
+			limb_multiply(product._block, nrBlocks, _block, nrBlocks, rhs._block, nrBlocks);
+			*this = product;
 		}
 		// null any leading bits that fall outside of nbits
 		_block[MSU] = static_cast<bt>(MSU_MASK & _block[MSU]);
@@ -892,111 +867,12 @@ public:
 			// filter out the easy stuff
 			if (_a < _b) { r = a; clear(); return; }
 
-			// determine first non-zero limbs
-			unsigned m{ 0 }, n{ 0 };
-			for (unsigned i = nrBlocks; i > 0; --i) {
-				if (_a.block(i - 1) != 0) {
-					m = static_cast<unsigned>(i);
-					break;
-				}
-			}
-			for (unsigned i = nrBlocks; i > 0; --i) {
-				if (_b.block(i - 1) != 0) {
-					n = static_cast<unsigned>(i);
-					break;
-				}
-			}
-
-			// single limb divisor
-			if (n == 1) {
-				std::uint64_t remainder{ 0 };
-				auto divisor = _b.block(0);
-				for (unsigned j = m; j > 0; --j) {
-					std::uint64_t dividend = remainder * BASE + _a.block(j - 1);
-					std::uint64_t limbQuotient = dividend / divisor;
-					_block[j - 1] = static_cast<BlockType>(limbQuotient);
-					remainder = dividend - limbQuotient * divisor;
-				}
-				r._block[0] = static_cast<BlockType>(remainder);
-				if (sign_q) twosComplement();
-				return;
-			}
-
-			// Knuth's algorithm calculates a normalization factor d
-			// that perfectly aligns b so that b0 >= floor(BASE/2),
-			// a requirement for the relationship: (qHat - 2) <= q <= qHat
-
-			using OriginalInteger = integer<nbits, BlockType, NumberType>;
-			using ExpandedInteger = integer<nbits + sizeof(BlockType) * 8, BlockType, NumberType>; // need room for overflow to receive the normalization bits
-
-			int shift = nlz(b.block(n - 1));
-			ExpandedInteger normalized_a;
-			normalized_a.setblock(m, static_cast<BlockType>((_a.block(m - 1) >> (bitsInBlock - shift))));
-			for (unsigned i = m - 1; i > 0; --i) {
-				normalized_a.setblock(i, static_cast<BlockType>((_a.block(i) << shift) | (_a.block(i - 1) >> (bitsInBlock - shift))));
-			}
-			normalized_a.setblock(0, static_cast<BlockType>(_a.block(0) << shift));
-			// normalize b
-			OriginalInteger normalized_b;
-			unsigned n_minus_1 = n - 1;
-			for (unsigned i = n_minus_1; i > 0; --i) {
-				normalized_b.setblock(i, static_cast<BlockType>((_b.block(i) << shift) | (_b.block(i - 1) >> (bitsInBlock - shift))));
-			}
-			normalized_b.setblock(0, static_cast<BlockType>(_b.block(0) << shift));
-
-//			std::cout << "normalized a : " << normalized_a.showLimbs() << " : " << normalized_a.showLimbValues() << '\n';
-//			std::cout << "normalized b :             " << normalized_b.showLimbs() << " : " << normalized_b.showLimbValues() << '\n';
-
-			// divide by limb
-			std::uint64_t divisor = normalized_b._block[n - 1];
-			std::uint64_t v_nminus2 = normalized_b._block[n - 2]; // n > 1 at this point
-			for (int j = static_cast<int>(m - n); j >= 0; --j) {
-				std::uint64_t dividend = normalized_a.block(j + n) * BASE + normalized_a.block(j + n - 1);
-				std::uint64_t qhat = dividend / divisor;
-				std::uint64_t rhat = dividend - qhat * divisor;
-
-				while (qhat >= BASE || qhat * v_nminus2 > BASE * rhat + normalized_a.block(j + n - 2)) {
-					--qhat;
-					rhat += divisor;
-					if (rhat < BASE) continue;
-				}
-				std::uint64_t borrow{ 0 };
-				std::uint64_t diff{ 0 };
-				for (unsigned i = 0; i < n; ++i) {
-					std::uint64_t p = qhat * normalized_b.block(i);
-					diff = normalized_a.block(i + j) - static_cast<BlockType>(p) - borrow;
-					normalized_a.setblock(i + j, static_cast<BlockType>(diff));
-					borrow = (p >> bitsInBlock) - (diff >> bitsInBlock);
-				}
-				std::int64_t signedBorrow = static_cast<int64_t>(normalized_a.block(j + n) - borrow);
-				normalized_a.setblock(j + n, static_cast<BlockType>(signedBorrow));
-
-//				std::cout << "   updated a : " << normalized_a.showLimbs() << " : " << normalized_a.showLimbValues() << '\n';
-
-				setblock(static_cast<unsigned>(j), static_cast<BlockType>(qhat));
-				if (signedBorrow < 0) { // subtracted too much, add back
-					std::cout << "subtracted too much, add back\n";
-					_block[j] -= 1;
-					std::uint64_t carry{ 0 };
-					for (unsigned i = 0; i < n; ++i) {
-						carry += static_cast<std::uint64_t>(normalized_a.block(i + j)) + static_cast<std::uint64_t>(normalized_b.block(i));
-						normalized_a.setblock(i + j, static_cast<BlockType>(carry));
-						carry >>= 32;
-					}
-					BlockType rectified = static_cast<BlockType>(normalized_a.block(j + n) + carry);
-					normalized_a.setblock(j + n, rectified);
-				}
-//				std::cout << "   updated a : " << normalized_a.showLimbs() << " : " << normalized_a.showLimbValues() << '\n';
-			}
+			Integer q, rem;
+			udivmod(_a, _b, q, rem);
+			*this = q;
 			if (sign_q) twosComplement();
-
-			// remainder needs to be normalized
-			for (unsigned i = 0; i < n - 1; ++i) {
-				std::uint64_t remainder = static_cast<uint64_t>(normalized_a.block(i) >> shift);
-				remainder |= static_cast<uint64_t>(normalized_a.block(i + 1) << (32 - shift));
-				r.setblock(i, static_cast<BlockType>(remainder));
-			}
-			r.setblock(n - 1, static_cast<BlockType>(normalized_a.block(n - 1) >> shift));
+			r = rem;
+			if (sign_a) r.twosComplement();
 		}
 	}
 	// signed integer conversion
@@ -1337,27 +1213,9 @@ idiv_t<nbits, BlockType, NumberType> idiv(const integer<nbits, BlockType, Number
 			divresult.rem = _a; // a % b = a when a / b = 0
 			return divresult;
 		}
-		// initialize the long division
-		integer<nbits + 1, BlockType, NumberType> accumulator = a;
-		// prepare the subtractand
-		integer<nbits + 1, BlockType, NumberType> subtractand = b;
-		int msb_b = findMsb(b);
-		int msb_a = findMsb(a);
-		int shift = msb_a - msb_b;
-		subtractand <<= shift;
-		divresult.quot = 0;
-		// long division
-		for (int i = shift; i >= 0; --i) {
-			if (subtractand <= accumulator) {
-				accumulator -= subtractand;
-				divresult.quot.setbit(static_cast<unsigned>(i));
-			}
-			else {
-				divresult.quot.setbit(static_cast<unsigned>(i), false);
-			}
-			subtractand >>= 1;
-			//		std::cout << "i = " << i << " subtractand : " << long(subtractand) << '\n';
-		}
+		Integer quotient, accumulator;
+		udivmod(a, b, quotient, accumulator);
+		divresult.quot = quotient;
 		if (result_negative) {  // take 2's complement
 			divresult.quot.flip();
 			divresult.quot += 1;
@@ -1374,24 +1232,8 @@ idiv_t<nbits, BlockType, NumberType> idiv(const integer<nbits, BlockType, Number
 			divresult.rem = _a; // a % b = a when a / b = 0
 			return divresult; // a / b = 0 when b > a
 		}
-		using Integer = integer<nbits, BlockType, NumberType>;
-		Integer accumulator(_a), subtractand(_b);
-		int msb_b = findMsb(_b);
-		int msb_a = findMsb(_a);
-		int shift = msb_a - msb_b;
-		subtractand <<= shift;
-		// long division
-		for (int i = shift; i >= 0; --i) {
-			if (subtractand <= accumulator) {
-				accumulator -= subtractand;
-				divresult.quot.setbit(static_cast<unsigned>(i));
-			}
-			else {
-				divresult.quot.setbit(static_cast<unsigned>(i), false);
-			}
-			subtractand >>= 1;
-			//		std::cout << "i = " << i << " subtractand : " << long(subtractand) << '\n';
-		}
+		integer<nbits, BlockType, NumberType> accumulator;
+		udivmod(_a, _b, divresult.quot, accumulator);
 		divresult.rem = accumulator;
 	}
 
@@ -0,0 +1,375 @@
+#pragma once
+// modular.hpp: modular arithmetic engines for fixed-size integers: Montgomery form, Barrett reduction, and modular exponentiation
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <iostream>
+#include <universal/native/limb_arithmetic.hpp>
+#include <universal/number/integer/exceptions.hpp>
+
+namespace sw { namespace universal {
+
+/*
+ The modular engines run on native 64-bit limbs instead of the blocks of the integer: a modular product
+ of integer<nbits> costs O(N^2) limb multiplies, N = ceil(nbits / 64), where operator% runs a long division
+ for every reduction.
+
+   montgomery<nbits, bt>   odd moduli: residues in Montgomery form a * 2^(64N) mod m, reduced without division
+   barrett<nbits, bt>      any modulus > 1: reduction by a precomputed reciprocal of the modulus
+
+ Both offer pow, a sliding window exponentiation whose running time depends on the exponent, and
+ montgomery adds pow_ct, a fixed window exponentiation with a constant sequence of operations and memory
+ accesses for exponents that must stay secret. powmod and mulmod select an engine by the parity of the modulus.
+*/
+
+// number of 64-bit limbs of the modular engines of integer<nbits>
+template<unsigned nbits>
+constexpr unsigned modular_limbs = (nbits + 63) / 64;
+
+// the magnitude of a non-negative integer as an array of 64-bit limbs, least significant limb first
+template<std::size_t N, unsigned nbits, typename BlockType, IntegerNumberType NumberType>
+void to_limbs(const integer<nbits, BlockType, NumberType>& a, std::array<std::uint64_t, N>& limbs) {
+	using Integer = integer<nbits, BlockType, NumberType>;
+	limbs.fill(0);
+	for (unsigned i = 0; i < Integer::nrBlocks; ++i) {
+		unsigned bit = i * Integer::bitsInBlock;
+		if (bit / 64 < N) limbs[bit / 64] |= static_cast<std::uint64_t>(a.block(i)) << (bit % 64);
+	}
+	if constexpr (Integer::nrBlocks * Integer::bitsInBlock > nbits) {
+		// clear the unused bits of the most significant block
+		constexpr unsigned topBit = nbits % 64;
+		if constexpr (topBit != 0 && (nbits - 1) / 64 < N) limbs[(nbits - 1) / 64] &= (~std::uint64_t(0) >> (64 - topBit));
+	}
+}
+
+template<std::size_t N, unsigned nbits, typename BlockType, IntegerNumberType NumberType>
+void from_limbs(const std::array<std::uint64_t, N>& limbs, integer<nbits, BlockType, NumberType>& a) {
+	using Integer = integer<nbits, BlockType, NumberType>;
+	for (unsigned i = 0; i < Integer::nrBlocks; ++i) {
+		unsigned bit = i * Integer::bitsInBlock;
+		a.setblock(i, static_cast<BlockType>(bit / 64 < N ? limbs[bit / 64] >> (bit % 64) : 0));
+	}
+}
+
+// left-to-right sliding window exponentiation (HAC 14.85) on the residues of a modular engine: the odd powers
+// x, x^3, ..., x^(2^w - 1) are precomputed, and every window of the exponent that starts and ends with a 1
+// costs a single multiplication, for about bits / (w + 1) multiplications next to the bits squarings
+template<typename Engine, typename Residue, std::size_t E>
+Residue sliding_window_pow(const Engine& engine, const Residue& x, const std::array<std::uint64_t, E>& e) {
+	unsigned bits{ 0 };
+	for (std::size_t i = E; i > 0 && bits == 0; --i) {
+		if (e[i - 1] != 0) bits = static_cast<unsigned>(64 * (i - 1) + std::bit_width(e[i - 1]));
+	}
+	Residue r = engine.one();
+	if (bits == 0) return r;
+	unsigned w = (bits > 671 ? 6 : bits > 239 ? 5 : bits > 79 ? 4 : bits > 23 ? 3 : bits > 6 ? 2 : 1);
+	std::array<Residue, 32> table;      // the odd powers x^(2j + 1)
+	table[0] = x;
+	if (w > 1) {
+		Residue x2;
+		engine.multiply(x2, x, x);
+		for (unsigned j = 1; j < (1u << (w - 1)); ++j) engine.multiply(table[j], table[j - 1], x2);
+	}
+	auto bit = [&e](int i) { return static_cast<unsigned>((e[static_cast<unsigned>(i) / 64] >> (static_cast<unsigned>(i) % 64)) & 1u); };
+	bool started = false;
+	int i = static_cast<int>(bits) - 1;
+	while (i >= 0) {
+		if (bit(i) == 0) {
+			engine.multiply(r, r, r);
+			--i;
+			continue;
+		}
+		// the longest window [l, i] of at most w bits that ends with a 1
+		int l = (i - static_cast<int>(w) + 1 > 0 ? i - static_cast<int>(w) + 1 : 0);
+		while (bit(l) == 0) ++l;
+		unsigned value{ 0 };
+		for (int j = i; j >= l; --j) value = (value << 1) | bit(j);
+		if (started) {
+			for (int j = i; j >= l; --j) engine.multiply(r, r, r);
+			engine.multiply(r, r, table[value >> 1]);
+		}
+		else {
+			r = table[value >> 1];
+			started = true;
+		}
+		i = l - 1;
+	}
+	return r;
+}
+
+// Montgomery arithmetic modulo an odd m > 1 of integer<nbits>: residues are held in Montgomery form
+// a * R mod m, R = 2^(64N), so a modular product is a limb_montgomery_multiply of 2N^2 + N limb multiplies
+// without any division. Arguments that are negative or not smaller than m are reduced on entry.
+template<unsigned nbits, typename BlockType = std::uint32_t, IntegerNumberType NumberType = IntegerNumber>
+class montgomery {
+public:
+	using Integer = integer<nbits, BlockType, NumberType>;
+	static constexpr unsigned N = modular_limbs<nbits>;
+	using residue = std::array<std::uint64_t, N>;
+
+	explicit montgomery(const Integer& modulus) : _modulus(modulus), _m{}, _one{}, _rr{}, _minv{ 0 } {
+		if (modulus <= 1 || modulus.iseven()) {
+#if INTEGER_THROW_ARITHMETIC_EXCEPTION
+			throw integer_modulus_not_odd{};
+#else
+			std::cerr << "integer_modulus_not_odd\n";
+			return;
+#endif // INTEGER_THROW_ARITHMETIC_EXCEPTION
+		}
+		to_limbs(modulus, _m);
+		_minv = limb_montgomery_inverse(_m[0]);
+		// R mod m and R^2 mod m are the remainders of 2^(64N) and 2^(128N)
+		std::uint64_t u[2 * N + 1]{}, q[2 * N + 1];
+		u[N] = 1;
+		limb_divide<2 * N + 1, N>(q, _one.data(), u, _m.data());
+		u[N] = 0;
+		u[2 * N] = 1;
+		limb_divide<2 * N + 1, N>(q, _rr.data(), u, _m.data());
+	}
+
+	const Integer& modulus() const noexcept { return _modulus; }
+	// the Montgomery form of 1
+	const residue& one() const noexcept { return _one; }
+
+	// r = a * b * R^-1 mod m, the Montgomery form of the product of the residues a and b; r may alias a or b
+	void multiply(residue& r, const residue& a, const residue& b) const noexcept {
+		std::uint64_t t[N + 2];
+		limb_montgomery_multiply(r.data(), a.data(), b.data(), _m.data(), N, _minv, t);
+	}
+
+	residue to_montgomery(const Integer& a) const {
+		residue x;
+		to_limbs(magnitude(a), x);
+		multiply(x, x, _rr);     // a * R^2 * R^-1, which is fully reduced for any a < R
+		if (a.isneg()) negate(x);
+		return x;
+	}
+	Integer from_montgomery(const residue& x) const {
+		residue unit{}, r;
+		unit[0] = 1;
+		multiply(r, x, unit);
+		Integer a;
+		from_limbs(r, a);
+		return a;
+	}
+
+	// a * b mod m
+	Integer mul(const Integer& a, const Integer& b) const {
+		residue x = to_montgomery(a), y = to_montgomery(b);
+		multiply(x, x, y);
+		return from_montgomery(x);
+	}
+	// base^exponent mod m for an exponent >= 0, by sliding window exponentiation
+	Integer pow(const Integer& base, const Integer& exponent) const {
+		residue e;
+		to_limbs(exponent, e);
+		return from_montgomery(sliding_window_pow(*this, to_montgomery(base), e));
+	}
+	// base^exponent mod m for an exponent >= 0 in constant time: windows of CT_WINDOW bits across the full width
+	// of the exponent, each of which costs CT_WINDOW squarings and a multiplication by a table entry that is
+	// selected by reading every entry, so neither the sequence of operations nor the memory access pattern
+	// depends on the exponent or the base
+	Integer pow_ct(const Integer& base, const Integer& exponent) const {
+		constexpr unsigned CT_WINDOW = 4;
+		constexpr unsigned TABLE_SIZE = 1u << CT_WINDOW;
+		residue e;
+		to_limbs(exponent, e);
+		std::array<residue, TABLE_SIZE> table;
+		table[0] = _one;
+		table[1] = to_montgomery(base);
+		for (unsigned j = 2; j < TABLE_SIZE; ++j) multiply(table[j], table[j - 1], table[1]);
+		residue r = _one, s;
+		for (unsigned i = 64 * N; i > 0; i -= CT_WINDOW) {
+			for (unsigned k = 0; k < CT_WINDOW; ++k) multiply(r, r, r);
+			unsigned shift = i - CT_WINDOW;
+			std::uint64_t window = (e[shift / 64] >> (shift % 64)) & (TABLE_SIZE - 1);
+			s.fill(0);
+			for (unsigned j = 0; j < TABLE_SIZE; ++j) {
+				std::uint64_t mask = std::uint64_t(0) - std::uint64_t(j == window);
+				for (unsigned k = 0; k < N; ++k) s[k] |= table[j][k] & mask;
+			}
+			multiply(r, r, s);
+		}
+		return from_montgomery(r);
+	}
+
+private:
+	Integer        _modulus;
+	residue        _m;
+	residue        _one;     // R mod m
+	residue        _rr;      // R^2 mod m, which maps values into Montgomery form
+	std::uint64_t  _minv;    // -m^-1 mod 2^64
+
+	static Integer magnitude(const Integer& a) { return (a.isneg() ? -a : a); }
+	// x = m - x for a nonzero x, and 0 for x = 0
+	void negate(residue& x) const noexcept {
+		std::uint64_t nonzero{ 0 };
+		for (unsigned i = 0; i < N; ++i) nonzero |= x[i];
+		std::uint64_t mask = std::uint64_t(0) - std::uint64_t(nonzero != 0);
+		std::uint64_t borrow{ 0 };
+		for (unsigned i = 0; i < N; ++i) {
+			std::uint64_t y = _m[i], v = x[i];
+			std::uint64_t d = y - v;
+			std::uint64_t b1 = (y < v ? 1 : 0);
+			x[i] = (d - borrow) & mask;
+			borrow = b1 | (d < borrow ? 1 : 0);
+		}
+	}
+};
+
+// Barrett reduction modulo any m > 1 of integer<nbits> (HAC 14.42): with k the number of significant limbs of
+// m and mu = floor(2^(128k) / m), the quotient of a double-width product x < m^2 is estimated from the top
+// limbs of x and mu to within 2, so a reduction costs two partial products and at most two subtractions
+template<unsigned nbits, typename BlockType = std::uint32_t, IntegerNumberType NumberType = IntegerNumber>
+class barrett {
+public:
+	using Integer = integer<nbits, BlockType, NumberType>;
+	static constexpr unsigned N = modular_limbs<nbits>;
+	using residue = std::array<std::uint64_t, N>;
+	using product = std::array<std::uint64_t, 2 * N>;
+
+	explicit barrett(const Integer& modulus) : _modulus(modulus), _m{}, _mu{}, _k{ 1 } {
+		if (modulus <= 1) {
+#if INTEGER_THROW_ARITHMETIC_EXCEPTION
+			throw integer_divide_by_zero{};
+#else
+			std::cerr << "integer_divide_by_zero\n";
+			_m[0] = 1;
+			return;
+#endif // INTEGER_THROW_ARITHMETIC_EXCEPTION
+		}
+		to_limbs(modulus, _m);
+		_k = N;
+		while (_k > 1 && _m[_k - 1] == 0) --_k;
+		std::uint64_t u[2 * N + 1]{}, q[2 * N + 1], r[N];
+		u[2 * _k] = 1;
+		limb_divide<2 * N + 1, N>(q, r, u, _m.data());
+		for (unsigned i = 0; i <= _k && i < N + 1; ++i) _mu[i] = q[i];
+	}
+
+	const Integer& modulus() const noexcept { return _modulus; }
+	residue one() const noexcept { residue r{}; r[0] = 1; reduce_short(r); return r; }
+
+	// r = x mod m for x < 2^(128k)
+	void reduce(residue& r, const product& x) const noexcept {
+		const unsigned k = _k;
+		std::uint64_t q2[2 * N + 2]{}, q3[N + 1]{}, r2[N + 1]{}, r1[N + 1]{};
+		// q3 = floor(floor(x / b^(k-1)) * mu / b^(k+1))
+		limb_multiply(q2, 2 * k + 2, x.data() + (k - 1), k + 1, _mu.data(), k + 1);
+		for (unsigned i = 0; i <= k; ++i) q3[i] = q2[k + 1 + i];
+		// r = (x - q3 * m) mod b^(k+1), which is smaller than 3m
+		limb_multiply(r2, k + 1, q3, k + 1, _m.data(), k);
+		for (unsigned i = 0; i <= k; ++i) r1[i] = (i < 2 * N ? x[i] : 0);
+		std::uint64_t borrow{ 0 };
+		for (unsigned i = 0; i <= k; ++i) {
+			std::uint64_t a = r1[i], b = r2[i];
+			std::uint64_t d = a - b;
+			std::uint64_t b1 = (a < b ? 1 : 0);
+			r1[i] = d - borrow;
+			borrow = b1 | (d < borrow ? 1 : 0);
+		}
+		while (!below_modulus(r1, k + 1)) subtract_modulus(r1, k + 1);
+		r.fill(0);
+		for (unsigned i = 0; i < k; ++i) r[i] = r1[i];
+	}
+	// r = a * b mod m of the residues a, b < m; r may alias a or b
+	void multiply(residue& r, const residue& a, const residue& b) const noexcept {
+		product x;
+		limb_multiply(x.data(), 2 * N, a.data(), N, b.data(), N);
+		reduce(r, x);
+	}
+
+	// a mod m, the least non-negative residue
+	Integer reduce(const Integer& a) const {
+		product x{};
+		residue v, r;
+		to_limbs((a.isneg() ? -a : a), v);
+		for (unsigned i = 0; i < N; ++i) x[i] = v[i];
+		if (_k * 2 < N) {
+			// a may exceed b^(2k): reduce it a limb at a time from the top with Horner's rule
+			r.fill(0);
+			for (unsigned i = N; i > 0; --i) {
+				product t{};
+				for (unsigned j = 0; j + 1 < 2 * N && j < N; ++j) t[j + 1] = r[j];
+				t[0] = v[i - 1];
+				reduce(r, t);
+			}
+		}
+		else {
+			reduce(r, x);
+		}
+		Integer result;
+		from_limbs(r, result);
+		if (a.isneg() && !result.iszero()) result = _modulus - result;
+		return result;
+	}
+	// a * b mod m
+	Integer mul(const Integer& a, const Integer& b) const {
+		residue x, y;
+		to_limbs(reduce(a), x);
+		to_limbs(reduce(b), y);
+		multiply(x, x, y);
+		Integer result;
+		from_limbs(x, result);
+		return result;
+	}
+	// base^exponent mod m for an exponent >= 0, by sliding window exponentiation
+	Integer pow(const Integer& base, const Integer& exponent) const {
+		residue x, e;
+		to_limbs(reduce(base), x);
+		to_limbs(exponent, e);
+		residue r = sliding_window_pow(*this, x, e);
+		Integer result;
+		from_limbs(r, result);
+		return result;
+	}
+
+private:
+	Integer  _modulus;
+	residue  _m;
+	std::array<std::uint64_t, N + 1> _mu;
+	unsigned _k;
+
+	bool below_modulus(const std::uint64_t* r, unsigned n) const noexcept {
+		for (unsigned i = n; i > 0; --i) {
+			std::uint64_t mi = (i - 1 < N ? _m[i - 1] : 0);
+			if (r[i - 1] != mi) return r[i - 1] < mi;
+		}
+		return false;
+	}
+	void subtract_modulus(std::uint64_t* r, unsigned n) const noexcept {
+		std::uint64_t borrow{ 0 };
+		for (unsigned i = 0; i < n; ++i) {
+			std::uint64_t a = r[i], b = (i < N ? _m[i] : 0);
+			std::uint64_t d = a - b;
+			std::uint64_t b1 = (a < b ? 1 : 0);
+			r[i] = d - borrow;
+			borrow = b1 | (d < borrow ? 1 : 0);
+		}
+	}
+	void reduce_short(residue& r) const noexcept {
+		while (!below_modulus(r.data(), N)) subtract_modulus(r.data(), N);
+	}
+};
+
+// base^exponent mod modulus for an exponent >= 0: Montgomery exponentiation for odd moduli and Barrett
+// exponentiation for the even ones. Engines that are set up once serve repeated exponentiations modulo
+// the same modulus without recomputing their constants.
+template<unsigned nbits, typename BlockType, IntegerNumberType NumberType>
+integer<nbits, BlockType, NumberType> powmod(const integer<nbits, BlockType, NumberType>& base, const integer<nbits, BlockType, NumberType>& exponent, const integer<nbits, BlockType, NumberType>& modulus) {
+	if (modulus.isodd() && modulus > 1) return montgomery<nbits, BlockType, NumberType>(modulus).pow(base, exponent);
+	return barrett<nbits, BlockType, NumberType>(modulus).pow(base, exponent);
+}
+
+// a * b mod modulus without the overflow of the product a * b in integer<nbits>
+template<unsigned nbits, typename BlockType, IntegerNumberType NumberType>
+integer<nbits, BlockType, NumberType> mulmod(const integer<nbits, BlockType, NumberType>& a, const integer<nbits, BlockType, NumberType>& b, const integer<nbits, BlockType, NumberType>& modulus) {
+	return barrett<nbits, BlockType, NumberType>(modulus).mul(a, b);
+}
+
+}} // namespace sw::universal
@@ -4,8 +4,14 @@
 // Copyright (C) 2017-2022 Stillwater Supercomputing, Inc.
 //
 // This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <type_traits>
 #include <vector>
+#include <universal/native/limb_arithmetic.hpp>
 #include <universal/number/integer/exceptions.hpp>
+#include <universal/number/integer/sieves.hpp>
 
 namespace sw { namespace universal {
 
@@ -117,6 +123,664 @@ IntegerType lcm(const std::vector< IntegerType >& v) {
 	return lcm;
 }
 
+///////////////////////////////////////////////////////////////////////////////////////
+// number theoretic kernels
+//
+// The primality test and the factorization algorithms run on the magnitude of their argument held in
+// a vector of 64-bit limbs, least significant limb first, so that the modular arithmetic runs on native
+// words independent of the block type of the IntegerType and of the fixed or adaptive precision.
+
+using nt_limb   = std::uint64_t;
+using nt_number = std::vector<nt_limb>;
+
+// remove the leading zero limbs, keeping at least one limb
+inline void nt_trim(nt_number& a) {
+	while (a.size() > 1 && a.back() == 0) a.pop_back();
+	if (a.empty()) a.push_back(0);
+}
+
+inline bool nt_iszero(const nt_number& a) {
+	for (nt_limb l : a) if (l != 0) return false;
+	return true;
+}
+
+inline bool nt_isone(const nt_number& a) {
+	if (a.empty() || a[0] != 1) return false;
+	for (size_t i = 1; i < a.size(); ++i) if (a[i] != 0) return false;
+	return true;
+}
+
+// number of significant bits
+inline unsigned nt_bits(const nt_number& a) {
+	for (size_t i = a.size(); i > 0; --i) {
+		if (a[i - 1] != 0) return static_cast<unsigned>(64 * (i - 1) + std::bit_width(a[i - 1]));
+	}
+	return 0;
+}
+
+inline bool nt_bit(const nt_number& a, unsigned i) {
+	return (i / 64 < a.size()) && ((a[i / 64] >> (i % 64)) & 1u);
+}
+
+// three-way comparison of the magnitudes a and b, which may have different numbers of limbs
+inline int nt_compare(const nt_number& a, const nt_number& b) {
+	size_t n = std::max(a.size(), b.size());
+	for (size_t i = n; i > 0; --i) {
+		nt_limb x = (i <= a.size() ? a[i - 1] : 0), y = (i <= b.size() ? b[i - 1] : 0);
+		if (x != y) return (x < y ? -1 : 1);
+	}
+	return 0;
+}
+
+// a += b
+inline void nt_add(nt_number& a, const nt_number& b) {
+	if (a.size() < b.size()) a.resize(b.size(), 0);
+	nt_limb carry{ 0 };
+	for (size_t i = 0; i < a.size(); ++i) {
+		nt_limb s = a[i] + carry;
+		carry = (s < carry ? 1 : 0);
+		if (i < b.size()) {
+			s += b[i];
+			carry |= (s < b[i] ? 1 : 0);
+		}
+		a[i] = s;
+	}
+	if (carry) a.push_back(carry);
+}
+
+// a -= b for a >= b
+inline void nt_sub(nt_number& a, const nt_number& b) {
+	nt_limb borrow{ 0 };
+	for (size_t i = 0; i < a.size(); ++i) {
+		nt_limb x = a[i], y = (i < b.size() ? b[i] : 0);
+		nt_limb d = x - y;
+		nt_limb b1 = (x < y ? 1 : 0);
+		a[i] = d - borrow;
+		borrow = b1 | (d < borrow ? 1 : 0);
+	}
+	nt_trim(a);
+}
+
+inline void nt_shift_right(nt_number& a, unsigned shift) {
+	size_t limbShift = shift / 64;
+	unsigned bitShift = shift % 64;
+	size_t n = a.size();
+	for (size_t i = 0; i < n; ++i) {
+		nt_limb lo = (i + limbShift < n ? a[i + limbShift] : 0);
+		nt_limb hi = (i + limbShift + 1 < n ? a[i + limbShift + 1] : 0);
+		a[i] = (bitShift == 0 ? lo : (lo >> bitShift) | (hi << (64 - bitShift)));
+	}
+	nt_trim(a);
+}
+
+inline void nt_shift_left(nt_number& a, unsigned shift) {
+	size_t limbShift = shift / 64;
+	unsigned bitShift = shift % 64;
+	size_t n = a.size();
+	a.resize(n + limbShift + 1, 0);
+	for (size_t i = n + limbShift + 1; i > 0; --i) {
+		size_t k = i - 1;
+		nt_limb hi = (k >= limbShift && k - limbShift < n ? a[k - limbShift] : 0);
+		nt_limb lo = (k >= limbShift + 1 && k - limbShift - 1 < n ? a[k - limbShift - 1] : 0);
+		a[k] = (bitShift == 0 ? hi : (hi << bitShift) | (lo >> (64 - bitShift)));
+	}
+	nt_trim(a);
+}
+
+// number of trailing zero bits of a nonzero a
+inline unsigned nt_trailing_zeros(const nt_number& a) {
+	unsigned zeros{ 0 };
+	for (nt_limb l : a) {
+		if (l != 0) return zeros + static_cast<unsigned>(std::countr_zero(l));
+		zeros += 64;
+	}
+	return zeros;
+}
+
+// remainder of a / d for a divisor d < 2^32, developed a half limb at a time in native 64-bit division
+inline std::uint32_t nt_mod_small(const nt_number& a, std::uint32_t d) {
+	if (a.size() == 1) return static_cast<std::uint32_t>(a[0] % d);
+	std::uint64_t r{ 0 };
+	for (size_t i = a.size(); i > 0; --i) {
+		r = ((r << 32) | (a[i - 1] >> 32)) % d;
+		r = ((r << 32) | (a[i - 1] & 0xFFFF'FFFFull)) % d;
+	}
+	return static_cast<std::uint32_t>(r);
+}
+
+// a /= d for a divisor d < 2^32, returning the remainder
+inline std::uint32_t nt_div_small(nt_number& a, std::uint32_t d) {
+	std::uint64_t r{ 0 };
+	for (size_t i = a.size(); i > 0; --i) {
+		std::uint64_t hi = (r << 32) | (a[i - 1] >> 32);
+		std::uint64_t qhi = hi / d;
+		r = hi % d;
+		std::uint64_t lo = (r << 32) | (a[i - 1] & 0xFFFF'FFFFull);
+		std::uint64_t qlo = lo / d;
+		r = lo % d;
+		a[i - 1] = (qhi << 32) | qlo;
+	}
+	nt_trim(a);
+	return static_cast<std::uint32_t>(r);
+}
+
+// quotient a / b of a nonzero b by binary long division
+inline nt_number nt_divide(const nt_number& a, const nt_number& b) {
+	nt_number q(a.size(), 0), r(1, 0);
+	for (unsigned i = nt_bits(a); i > 0; --i) {
+		nt_shift_left(r, 1);
+		if (nt_bit(a, i - 1)) r[0] |= 1u;
+		if (nt_compare(r, b) >= 0) {
+			nt_sub(r, b);
+			q[(i - 1) / 64] |= nt_limb(1) << ((i - 1) % 64);
+		}
+	}
+	nt_trim(q);
+	return q;
+}
+
+// greatest common divisor by Stein's binary algorithm, which only shifts and subtracts
+inline nt_number nt_gcd(nt_number a, nt_number b) {
+	nt_trim(a);
+	nt_trim(b);
+	if (nt_iszero(a)) return b;
+	if (nt_iszero(b)) return a;
+	unsigned za = nt_trailing_zeros(a), zb = nt_trailing_zeros(b);
+	nt_shift_right(a, za);
+	do {
+		nt_shift_right(b, nt_trailing_zeros(b));
+		if (nt_compare(a, b) > 0) std::swap(a, b);
+		nt_sub(b, a);
+	} while (!nt_iszero(b));
+	nt_shift_left(a, std::min(za, zb));
+	return a;
+}
+
+// true if a is a perfect square: the digit-by-digit square root leaves no remainder
+inline bool nt_is_square(const nt_number& a) {
+	nt_number rem(a), root(1, 0), bit(1, 1), t;
+	unsigned bits = nt_bits(a);
+	if (bits == 0) return true;
+	nt_shift_left(bit, (bits - 1) & ~1u);  // the largest power of four not larger than a
+	while (!nt_iszero(bit)) {
+		t = root;
+		nt_add(t, bit);
+		nt_shift_right(root, 1);
+		if (nt_compare(rem, t) >= 0) {
+			nt_sub(rem, t);
+			nt_add(root, bit);
+		}
+		nt_shift_right(bit, 2);
+	}
+	return nt_iszero(rem);
+}
+
+// magnitude of a non-negative integer as a limb vector without leading zero limbs
+template<typename IntegerType>
+nt_number to_nt_number(const IntegerType& a) {
+	nt_number n;
+	if constexpr (std::is_integral_v<IntegerType>) {
+		n.push_back(static_cast<nt_limb>(a));
+	}
+	else {
+		// the block types divide 64, so a block never straddles two limbs
+		constexpr unsigned bitsInBlock = IntegerType::bitsInBlock;
+		unsigned nrBlocks{ 0 };
+		if constexpr (requires { a.limbs(); }) nrBlocks = a.limbs(); else nrBlocks = IntegerType::nrBlocks;
+		n.assign((nrBlocks * bitsInBlock + 63) / 64 + 1, 0);
+		for (unsigned i = 0; i < nrBlocks; ++i) {
+			unsigned bit = i * bitsInBlock;
+			n[bit / 64] |= static_cast<nt_limb>(a.block(i)) << (bit % 64);
+		}
+	}
+	nt_trim(n);
+	return n;
+}
+
+// the IntegerType of value n, which must be representable
+template<typename IntegerType>
+IntegerType from_nt_number(const nt_number& n) {
+	if constexpr (std::is_integral_v<IntegerType>) {
+		return static_cast<IntegerType>(n[0]);
+	}
+	else {
+		constexpr unsigned bitsInBlock = IntegerType::bitsInBlock;
+		using Block = std::remove_cvref_t<decltype(std::declval<IntegerType>().block(0))>;
+		IntegerType a(0);
+		// only set the significant blocks, so an adaptive precision integer does not grow leading zero blocks
+		unsigned nrBlocks = (nt_bits(n) + bitsInBlock - 1) / bitsInBlock;
+		if constexpr (!requires { a.limbs(); }) nrBlocks = std::min(nrBlocks, static_cast<unsigned>(IntegerType::nrBlocks));
+		for (unsigned i = 0; i < nrBlocks; ++i) {
+			unsigned bit = i * bitsInBlock;
+			a.setblock(i, static_cast<Block>(n[bit / 64] >> (bit % 64)));
+		}
+		return a;
+	}
+}
+
+// the primes below 1000, the trial divisors of the primality test and of the factorization
+inline const std::vector<std::uint64_t>& nt_small_primes() {
+	static const std::vector<std::uint64_t> primes = sieveOfEratosthenes(1000);
+	return primes;
+}
+
+// arithmetic modulo an odd n > 1 on residues in Montgomery form x * R mod n, with R = 2^(64 * limbs of n):
+// every residue has exactly as many limbs as n. The scratch space makes the products non-reentrant,
+// so every thread needs its own montgomery_modulus.
+class montgomery_modulus {
+public:
+	explicit montgomery_modulus(const nt_number& n)
+		: _n(n), _size(static_cast<unsigned>(n.size())), _minv(limb_montgomery_inverse(n[0])), _t(n.size() + 2) {
+		// R mod n and R^2 mod n by modular doubling of 1
+		nt_number r(_size, 0);
+		r[0] = 1;
+		unsigned bitsInR = 64 * _size;
+		for (unsigned i = 0; i < bitsInR; ++i) add(r, r, r);
+		_one = r;
+		for (unsigned i = 0; i < bitsInR; ++i) add(r, r, r);
+		_rr = r;
+	}
+
+	unsigned size() const noexcept { return _size; }
+	const nt_number& modulus() const noexcept { return _n; }
+	const nt_number& one() const noexcept { return _one; }
+	nt_number zero() const { return nt_number(_size, 0); }
+
+	// Montgomery form of a < R
+	nt_number to(const nt_number& a) const {
+		nt_number x(a);
+		x.resize(_size, 0);
+		mul(x, x, _rr);
+		return x;
+	}
+	// value of the residue x, without leading zero limbs
+	nt_number from(const nt_number& x) const {
+		nt_number unit(_size, 0), r(_size, 0);
+		unit[0] = 1;
+		mul(r, x, unit);
+		nt_trim(r);
+		return r;
+	}
+
+	// r = a * b * R^-1 mod n, which is the Montgomery form of the product; r may alias a or b
+	void mul(nt_number& r, const nt_number& a, const nt_number& b) const {
+		limb_montgomery_multiply(r.data(), a.data(), b.data(), _n.data(), _size, _minv, _t.data());
+	}
+	// r = a + b mod n
+	void add(nt_number& r, const nt_number& a, const nt_number& b) const {
+		nt_limb carry{ 0 };
+		for (unsigned i = 0; i < _size; ++i) {
+			nt_limb x = a[i], y = b[i];
+			nt_limb s = x + carry;
+			nt_limb c = (s < carry ? 1 : 0);
+			s += y;
+			r[i] = s;
+			carry = c | (s < y ? 1 : 0);
+		}
+		if (carry || !below_modulus(r)) subtract_modulus(r);
+	}
+	// r = a - b mod n
+	void sub(nt_number& r, const nt_number& a, const nt_number& b) const {
+		nt_limb borrow{ 0 };
+		for (unsigned i = 0; i < _size; ++i) {
+			nt_limb x = a[i], y = b[i];
+			nt_limb d = x - y;
+			nt_limb b1 = (x < y ? 1 : 0);
+			r[i] = d - borrow;
+			borrow = b1 | (d < borrow ? 1 : 0);
+		}
+		if (borrow) {
+			nt_limb carry{ 0 };
+			for (unsigned i = 0; i < _size; ++i) {
+				nt_limb s = r[i] + carry;
+				carry = (s < carry ? 1 : 0);
+				s += _n[i];
+				carry |= (s < _n[i] ? 1 : 0);
+				r[i] = s;
+			}
+		}
+	}
+	// r = a / 2 mod n: an odd residue is made even by adding the odd modulus
+	void half(nt_number& r, const nt_number& a) const {
+		nt_limb carry{ 0 };
+		if (a[0] & 1u) {
+			for (unsigned i = 0; i < _size; ++i) {
+				nt_limb s = a[i] + carry;
+				carry = (s < carry ? 1 : 0);
+				s += _n[i];
+				carry |= (s < _n[i] ? 1 : 0);
+				r[i] = s;
+			}
+		}
+		else {
+			if (&r != &a) r = a;
+		}
+		for (unsigned i = 0; i < _size; ++i) {
+			nt_limb next = (i + 1 < _size ? r[i + 1] : carry);
+			r[i] = (r[i] >> 1) | (next << 63);
+		}
+	}
+	// x^e in Montgomery form, by left-to-right binary exponentiation
+	nt_number pow(const nt_number& x, const nt_number& e) const {
+		nt_number r = _one;
+		for (unsigned i = nt_bits(e); i > 0; --i) {
+			mul(r, r, r);
+			if (nt_bit(e, i - 1)) mul(r, r, x);
+		}
+		return r;
+	}
+
+private:
+	nt_number _n;
+	unsigned  _size;
+	nt_limb   _minv;
+	nt_number _one;     // R mod n, the Montgomery form of 1
+	nt_number _rr;      // R^2 mod n, which maps a value into Montgomery form
+	mutable nt_number _t;
+
+	bool below_modulus(const nt_number& r) const {
+		for (unsigned i = _size; i > 0; --i) {
+			if (r[i - 1] != _n[i - 1]) return r[i - 1] < _n[i - 1];
+		}
+		return false;
+	}
+	void subtract_modulus(nt_number& r) const {
+		nt_limb borrow{ 0 };
+		for (unsigned i = 0; i < _size; ++i) {
+			nt_limb x = r[i], y = _n[i];
+			nt_limb d = x - y;
+			nt_limb b1 = (x < y ? 1 : 0);
+			r[i] = d - borrow;
+			borrow = b1 | (d < borrow ? 1 : 0);
+		}
+	}
+};
+
+// strong probable prime test of the odd n > 3 to the given base, a round of the Miller-Rabin test:
+// with n - 1 = d * 2^s and d odd, n passes if base^d = 1 or base^(d * 2^r) = -1 for some 0 <= r < s
+inline bool nt_strong_probable_prime(const montgomery_modulus& M, nt_limb base) {
+	const nt_number& n = M.modulus();
+	nt_number d(n);
+	d[0] -= 1;
+	unsigned s = nt_trailing_zeros(d);
+	nt_shift_right(d, s);
+	nt_number a(1, (n.size() == 1 ? base % n[0] : base));
+	if (nt_iszero(a)) return true;
+	nt_number x = M.pow(M.to(a), d);
+	nt_number minusOne = M.zero();
+	M.sub(minusOne, minusOne, M.one());
+	if (x == M.one() || x == minusOne) return true;
+	for (unsigned r = 1; r < s; ++r) {
+		M.mul(x, x, x);
+		if (x == minusOne) return true;
+		if (x == M.one()) return false;
+	}
+	return false;
+}
+
+// Jacobi symbol (a/n) of an odd n
+inline int nt_jacobi(std::uint64_t a, std::uint64_t n) {
+	a %= n;
+	int result = 1;
+	while (a != 0) {
+		while ((a & 1u) == 0) {
+			a >>= 1;
+			std::uint64_t r = n & 7u;
+			if (r == 3 || r == 5) result = -result;
+		}
+		std::swap(a, n);
+		if ((a & 3u) == 3 && (n & 3u) == 3) result = -result;
+		a %= n;
+	}
+	return (n == 1 ? result : 0);
+}
+
+// Jacobi symbol (D/n) of a small odd D and an odd n, by quadratic reciprocity
+inline int nt_jacobi(std::int64_t D, const nt_number& n) {
+	std::uint64_t a = static_cast<std::uint64_t>(D < 0 ? -D : D);
+	int result = 1;
+	if (D < 0 && (n[0] & 3u) == 3) result = -result;
+	if ((a & 3u) == 3 && (n[0] & 3u) == 3) result = -result;
+	return result * nt_jacobi(nt_mod_small(n, static_cast<std::uint32_t>(a)), a);
+}
+
+// strong Lucas probable prime test of the odd n > 3 that is free of small factors, with the parameters
+// P = 1 and Q = (1 - D) / 4 of Selfridge's method A, where D is the first of 5, -7, 9, -11, ... with
+// Jacobi symbol (D/n) = -1: with n + 1 = d * 2^s and d odd, n passes if U_d = 0 or V_(d * 2^r) = 0
+// for some 0 <= r < s
+inline bool nt_strong_lucas_probable_prime(const montgomery_modulus& M) {
+	const nt_number& n = M.modulus();
+	std::int64_t D = 5;
+	for (unsigned k = 0; ; ++k) {
+		int j = nt_jacobi(D, n);
+		if (j == -1) break;
+		if (j == 0) return false;                     // |D| < n shares a factor with n
+		if (k == 8 && nt_is_square(n)) return false;  // no D qualifies for a square
+		D = (D > 0 ? -(D + 2) : -D + 2);
+	}
+	auto residue = [&M](std::int64_t v) {
+		nt_number x = M.to(nt_number(1, static_cast<nt_limb>(v < 0 ? -v : v)));
+		if (v < 0) M.sub(x, M.zero(), x);
+		return x;
+	};
+	nt_number d(n);
+	nt_add(d, nt_number(1, 1));
+	unsigned s = nt_trailing_zeros(d);
+	nt_shift_right(d, s);
+	nt_number Dm = residue(D), Q = residue((1 - D) / 4);
+	nt_number U = M.one(), V = M.one(), Qk = Q, DU = M.zero();   // U_1 = 1, V_1 = P, Q^1
+	for (unsigned i = nt_bits(d) - 1; i > 0; --i) {
+		// U_2k = U_k V_k, V_2k = V_k^2 - 2 Q^k, Q^2k = (Q^k)^2
+		M.mul(U, U, V);
+		M.mul(V, V, V);
+		M.sub(V, V, Qk);
+		M.sub(V, V, Qk);
+		M.mul(Qk, Qk, Qk);
+		if (nt_bit(d, i - 1)) {
+			// U_k+1 = (P U_k + V_k) / 2, V_k+1 = (D U_k + P V_k) / 2, Q^k+1 = Q^k Q
+			M.mul(DU, Dm, U);
+			M.add(U, U, V);
+			M.half(U, U);
+			M.add(V, V, DU);
+			M.half(V, V);
+			M.mul(Qk, Qk, Q);
+		}
+	}
+	nt_number zero = M.zero();
+	if (U == zero || V == zero) return true;
+	for (unsigned r = 1; r < s; ++r) {
+		M.mul(V, V, V);
+		M.sub(V, V, Qk);
+		M.sub(V, V, Qk);
+		M.mul(Qk, Qk, Qk);
+		if (V == zero) return true;
+	}
+	return false;
+}
+
+// Baillie-PSW primality test: trial division by the primes below 256, a strong probable prime test to
+// base 2, and a strong Lucas probable prime test. No composite below 2^64 passes, so the test is
+// deterministic for 64-bit values, and no composite of any size is known to pass.
+inline bool nt_isprime(const nt_number& n) {
+	if (n.size() == 1 && n[0] < 2) return false;
+	for (std::uint64_t p : nt_small_primes()) {
+		if (p > 256) break;
+		if (n.size() == 1 && n[0] == p) return true;
+		if (nt_mod_small(n, static_cast<std::uint32_t>(p)) == 0) return false;
+	}
+	if (n.size() == 1 && n[0] < 257 * 257) return true;
+	montgomery_modulus M(n);
+	return nt_strong_probable_prime(M, 2) && nt_strong_lucas_probable_prime(M);
+}
+
+// Brent's variant of Pollard's rho method with the iteration x <- x^2 + c: the differences |x - y| of the
+// cycle search are multiplied together, so only every batch of them costs a gcd, and a batch that
+// overshoots is retraced one step at a time. Returns a nontrivial factor of the odd composite n, or zero
+// if the cycle closes without one or the search exceeds maxIterations.
+inline nt_number nt_pollard_brent(const nt_number& n, nt_limb c, std::uint64_t maxIterations) {
+	constexpr std::uint64_t BATCH = 128;
+	montgomery_modulus M(n);
+	nt_number cm = M.to(nt_number(1, c)), y = M.to(nt_number(1, 2)), x, ys, q = M.one(), diff = M.zero();
+	auto f = [&M, &cm](nt_number& v) { M.mul(v, v, v); M.add(v, v, cm); };
+	nt_number g(1, 1);
+	for (std::uint64_t r = 1; nt_isone(g); r *= 2) {
+		if (r > maxIterations) return nt_number(1, 0);
+		x = y;
+		for (std::uint64_t i = 0; i < r; ++i) f(y);
+		for (std::uint64_t k = 0; k < r && nt_isone(g); k += BATCH) {
+			ys = y;
+			std::uint64_t steps = std::min(BATCH, r - k);
+			for (std::uint64_t i = 0; i < steps; ++i) {
+				f(y);
+				M.sub(diff, x, y);
+				M.mul(q, q, diff);
+			}
+			g = nt_gcd(q, n);
+		}
+	}
+	if (nt_compare(g, n) == 0) {
+		do {
+			f(ys);
+			M.sub(diff, x, ys);
+			g = nt_gcd(diff, n);
+		} while (nt_isone(g));
+	}
+	if (nt_compare(g, n) == 0) return nt_number(1, 0);
+	return g;
+}
+
+// stage 1 of Lenstra's elliptic curve method on the Montgomery curve of Suyama's parametrization with
+// parameter sigma > 5, in projective x-only coordinates: carrying the curve constant (A + 2) / 4 as a
+// fraction avoids all modular inversions. The point is multiplied by every prime power up to B1, and
+// the result is a nontrivial factor of n if the order of the curve modulo a prime factor of n is
+// B1-smooth, and zero otherwise.
+inline nt_number nt_ecm_stage1(const nt_number& n, std::uint64_t sigma, std::uint64_t B1, const std::vector<std::uint64_t>& primes) {
+	montgomery_modulus M(n);
+	auto residue = [&M](std::uint64_t v) { return M.to(nt_number(1, v)); };
+	nt_number u = M.zero(), v = M.zero(), s = residue(sigma), a = M.zero(), b = M.zero(), c = M.zero(), e = M.zero();
+	// u = sigma^2 - 5, v = 4 sigma, x0 = u^3 / v^3, (A + 2) / 4 = (v - u)^3 (3u + v) / (16 u^3 v)
+	M.mul(u, s, s);
+	M.sub(u, u, residue(5));
+	M.add(v, s, s);
+	M.add(v, v, v);
+	nt_number X = M.zero(), Z = M.zero(), num = M.zero(), den = M.zero();
+	M.mul(X, u, u);
+	M.mul(X, X, u);
+	M.mul(Z, v, v);
+	M.mul(Z, Z, v);
+	M.sub(a, v, u);
+	M.mul(num, a, a);
+	M.mul(num, num, a);
+	M.add(a, u, u);
+	M.add(a, a, u);
+	M.add(a, a, v);
+	M.mul(num, num, a);
+	M.mul(den, X, v);
+	for (int i = 0; i < 4; ++i) M.add(den, den, den);
+	// 2P: X2 = den (X + Z)^2 (X - Z)^2, Z2 = 4XZ (den (X - Z)^2 + num 4XZ)
+	auto dbl = [&](nt_number& X2, nt_number& Z2, const nt_number& X1, const nt_number& Z1) {
+		M.add(a, X1, Z1);
+		M.mul(a, a, a);
+		M.sub(b, X1, Z1);
+		M.mul(b, b, b);
+		M.sub(c, a, b);
+		M.mul(X2, a, b);
+		M.mul(X2, X2, den);
+		M.mul(e, den, b);
+		M.mul(a, num, c);
+		M.add(e, e, a);
+		M.mul(Z2, c, e);
+	};
+	// P + Q from P, Q, and P - Q
+	auto add = [&](nt_number& X3, nt_number& Z3, const nt_number& X1, const nt_number& Z1,
+	               const nt_number& X2, const nt_number& Z2, const nt_number& Xd, const nt_number& Zd) {
+		M.sub(a, X1, Z1);
+		M.add(b, X2, Z2);
+		M.mul(a, a, b);
+		M.add(b, X1, Z1);
+		M.sub(c, X2, Z2);
+		M.mul(b, b, c);
+		M.add(c, a, b);
+		M.mul(c, c, c);
+		M.sub(e, a, b);
+		M.mul(e, e, e);
+		M.mul(X3, Zd, c);
+		M.mul(Z3, Xd, e);
+	};
+	nt_number X0, Z0, X1 = M.zero(), Z1 = M.zero(), Xd, Zd;
+	for (std::uint64_t p : primes) {
+		if (p > B1) break;
+		std::uint64_t k = p;
+		while (k <= B1 / p) k *= p;
+		// Montgomery ladder for (X, Z) <- k (X, Z), which keeps the difference of the two points at (X, Z)
+		Xd = X; Zd = Z; X0 = X; Z0 = Z;
+		dbl(X1, Z1, X, Z);
+		for (unsigned i = static_cast<unsigned>(std::bit_width(k)) - 1; i > 0; --i) {
+			if ((k >> (i - 1)) & 1u) {
+				add(X0, Z0, X0, Z0, X1, Z1, Xd, Zd);
+				dbl(X1, Z1, X1, Z1);
+			}
+			else {
+				add(X1, Z1, X0, Z0, X1, Z1, Xd, Zd);
+				dbl(X0, Z0, X0, Z0);
+			}
+		}
+		X = X0; Z = Z0;
+	}
+	nt_number g = nt_gcd(Z, n);
+	if (nt_isone(g) || nt_compare(g, n) == 0) return nt_number(1, 0);
+	return g;
+}
+
+// a nontrivial factor of the odd composite n: Pollard-Brent rho finds the factors of up to about 40 bits,
+// and the elliptic curve method takes over for the larger ones, with a schedule of growing bounds B1 that
+// each run the number of curves that is expected to find a factor of matching size
+inline nt_number nt_find_factor(const nt_number& n) {
+	for (nt_limb c = 1; c <= 2; ++c) {
+		nt_number g = nt_pollard_brent(n, c, 1ull << 20);
+		if (!nt_iszero(g)) return g;
+	}
+	constexpr std::uint64_t schedule[][2] = { { 2000, 25 }, { 11000, 90 }, { 50000, 300 }, { 250000, 700 }, { 1000000, 1800 } };
+	std::uint64_t sigma = 6;
+	for (const auto& level : schedule) {
+		std::vector<std::uint64_t> primes = sieveOfEratosthenes(level[0]);
+		for (std::uint64_t curve = 0; curve < level[1]; ++curve) {
+			nt_number g = nt_ecm_stage1(n, sigma++, level[0], primes);
+			if (!nt_iszero(g)) return g;
+		}
+	}
+	// out of budget: rho without limits terminates, if slowly
+	for (nt_limb c = 3; ; ++c) {
+		nt_number g = nt_pollard_brent(n, c, ~0ull);
+		if (!nt_iszero(g)) return g;
+	}
+}
+
+// prime factors of n > 0 with multiplicity, in no particular order
+inline void nt_factor(nt_number n, std::vector<nt_number>& factors) {
+	nt_trim(n);
+	for (std::uint64_t p : nt_small_primes()) {
+		if (n.size() == 1 && p * p > n[0]) break;
+		while (nt_mod_small(n, static_cast<std::uint32_t>(p)) == 0) {
+			nt_div_small(n, static_cast<std::uint32_t>(p));
+			factors.push_back(nt_number(1, p));
+		}
+	}
+	std::vector<nt_number> unfactored;
+	if (!nt_isone(n)) unfactored.push_back(n);
+	while (!unfactored.empty()) {
+		nt_number m = unfactored.back();
+		unfactored.pop_back();
+		if (nt_isprime(m)) {
+			factors.push_back(m);
+			continue;
+		}
+		nt_number f = nt_find_factor(m);
+		unfactored.push_back(nt_divide(m, f));
+		unfactored.push_back(f);
+	}
+}
+
 // check if a number is prime
 template<typename IntegerType>
 bool isPrime_(const IntegerType& a) {
@@ -125,13 +789,11 @@ bool isPrime_(const IntegerType& a) {
 	return true;
 }
 
+// check if a number is prime with the Baillie-PSW test
 template<typename IntegerType>
 bool isPrime(const IntegerType& a) {
 	if (a <= 1) return false; // smallest prime number is 2
-	if (a <= 3) return true; // 2 and 3 are primes
-	if (a % 2 == 0 || a % 3 == 0) return false; // this allows us to skip middle 
-	for (IntegerType i = 5; i*i <= a; i += 6) if ((a % i) == 0 || a % (i + 2) == 0) return false;
-	return true;
+	return nt_isprime(to_nt_number(a));
 }
 
 template<typename IntegerType>
@@ -146,11 +808,22 @@ bool isPrimeTracer(const IntegerType& a) {
 	return true;
 }
 
-// generate prime numbers in a range
+// generate prime numbers in a range: ranges of 64-bit values that are wide enough to amortize the
+// sieving primes up to sqrt(high) run the segmented sieve, the others test every candidate
 template<typename IntegerType>
 bool primeNumbersInRange(const IntegerType low, const IntegerType high, std::vector< IntegerType >& primes) {
 	bool bFound = false;
-	for (IntegerType i = low; i < high; ++i) {
+	IntegerType first = (low < 2 ? IntegerType(2) : low);
+	if (high <= first) return bFound;
+	nt_number lo = to_nt_number(first), hi = to_nt_number(high);
+	if (hi.size() == 1 && isqrt64(hi[0]) <= 4 * (hi[0] - lo[0])) {
+		for (std::uint64_t p : segmentedSieve(lo[0], hi[0])) {
+			primes.push_back(from_nt_number<IntegerType>(nt_number(1, p)));
+			bFound = true;
+		}
+		return bFound;
+	}
+	for (IntegerType i = first; i < high; ++i) {
 		if (isPrime(i)) {
 			primes.push_back(i);
 			bFound = true;
@@ -193,24 +866,23 @@ class primefactors : public std::vector< std::pair< IntegerType, IntegerType > >
 
 
 
-// generate prime factors of an arbitrary integer
+// generate prime factors of an arbitrary integer, in increasing order: trial division by the primes below 1000,
+// the Baillie-PSW test to recognize prime cofactors, and Pollard-Brent rho and the elliptic curve method to split
+// the composite ones
 template<typename IntegerType>
 void primeFactorization(const IntegerType& a, primefactors<IntegerType>& factors) {
-	IntegerType i(a);
-	IntegerType factor = 2;
-	IntegerType power = 0;
-	// powers of 2
-	while (i.iseven()) { ++power; i >>= 1; }
-	if (power > 0) factors.push_back(std::pair<IntegerType, IntegerType>(factor, power));
-	// powers of odd numbers > 2
-	for (factor = 3; factor <= sqrt(i); factor += 2) {
-		if (isPrime(factor)) {
-			power = 0;
-			while ((i % factor) == 0) { ++power; i /= factor; }
-			if (power > 0) factors.push_back(std::pair<IntegerType, IntegerType>(factor, power));
-		}
-	}
-	if (i > 2) factors.push_back(std::pair < IntegerType, IntegerType>(i, 1));
+	if (a <= 1) return;
+	std::vector<nt_number> primes;
+	nt_factor(to_nt_number(a), primes);
+	std::sort(primes.begin(), primes.end(), [](const nt_number& x, const nt_number& y) { return nt_compare(x, y) < 0; });
+	for (size_t i = 0; i < primes.size(); ) {
+		size_t j = i + 1;
+		while (j < primes.size() && nt_compare(primes[j], primes[i]) == 0) ++j;
+		IntegerType factor = from_nt_number<IntegerType>(primes[i]);
+		IntegerType power(static_cast<unsigned long long>(j - i));
+		factors.push_back(std::pair<IntegerType, IntegerType>(factor, power));
+		i = j;
+	}
 }
 
 // Factorization using Fermat's method: precondition number must be odd
@@ -4,10 +4,99 @@
 // Copyright (C) 2017-2022 Stillwater Supercomputing, Inc.
 //
 // This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <algorithm>
+#include <cstdint>
 #include <vector>
+#include <universal/native/limb_arithmetic.hpp>
+#include <universal/utility/parallel.hpp>
 #include <universal/number/integer/exceptions.hpp>
 
 namespace sw { namespace universal {
 
+// primes in [2, limit] by the Sieve of Eratosthenes over the odd numbers
+inline std::vector<std::uint64_t> sieveOfEratosthenes(std::uint64_t limit) {
+	std::vector<std::uint64_t> primes;
+	if (limit < 2) return primes;
+	primes.push_back(2);
+	// composite[i] marks the odd number 2i + 1
+	size_t nrOdds = static_cast<size_t>((limit - 1) / 2 + 1);
+	std::vector<std::uint8_t> composite(nrOdds, 0);
+	for (size_t i = 1; i < nrOdds; ++i) {
+		if (composite[i]) continue;
+		std::uint64_t p = 2 * i + 1;
+		primes.push_back(p);
+		if (p > limit / p) continue;
+		for (std::uint64_t j = (p * p) / 2; j < nrOdds; j += p) composite[static_cast<size_t>(j)] = 1;
+	}
+	return primes;
+}
+
+// number of odd numbers that a single segment of segmentedSieve covers: one byte per odd number
+// keeps the segment resident in a 32KB L1 data cache
+constexpr size_t SIEVE_SEGMENT_ODDS = 32768;
+
+// primes in [low, high) by a segmented Sieve of Eratosthenes: only the sieving primes up to sqrt(high)
+// are held in memory, the odd numbers of the range are crossed off one cache sized segment at a time,
+// and the segments are distributed over nrThreads threads (0 selects all hardware threads).
+// The primes are returned in increasing order for any number of threads.
+inline std::vector<std::uint64_t> segmentedSieve(std::uint64_t low, std::uint64_t high, unsigned nrThreads = 0) {
+	std::vector<std::uint64_t> primes;
+	if (high <= 2 || high <= low) return primes;
+	if (low <= 2) {
+		primes.push_back(2);
+		low = 3;
+		if (high <= low) return primes;
+	}
+	std::vector<std::uint64_t> sievingPrimes = sieveOfEratosthenes(isqrt64(high - 1));
+	constexpr std::uint64_t SEGMENT_SPAN = 2 * SIEVE_SEGMENT_ODDS;
+	std::uint64_t range = high - low;
+	size_t nrSegments = static_cast<size_t>(range / SEGMENT_SPAN + (range % SEGMENT_SPAN ? 1 : 0));
+	if (nrThreads == 0) nrThreads = hardware_threads();
+	std::vector< std::vector<std::uint64_t> > found(nrThreads);
+	parallel_for(0, nrSegments, [&](size_t first, size_t last, unsigned t) {
+		std::vector<std::uint8_t> composite(SIEVE_SEGMENT_ODDS);
+		std::vector<std::uint64_t>& segmentPrimes = found[t];
+		// next[k] is the index of the next odd multiple of sievingPrimes[k] to cross off, relative to the start of
+		// the current segment: it carries over from segment to segment, so only the first segment of a thread
+		// and the first segment that reaches p^2 pay for a division
+		std::vector<std::uint64_t> next(sievingPrimes.size(), 0);
+		size_t active = 1;
+		for (size_t s = first; s < last; ++s) {
+			std::uint64_t segmentLow = low + s * SEGMENT_SPAN;
+			std::uint64_t span = (high - segmentLow < SEGMENT_SPAN ? high - segmentLow : SEGMENT_SPAN);
+			std::uint64_t start = segmentLow | 1u;        // first odd number of the segment
+			if (start - segmentLow >= span) continue;
+			size_t nrOdds = static_cast<size_t>((span - (start - segmentLow) + 1) / 2);
+			std::fill(composite.begin(), composite.begin() + static_cast<std::ptrdiff_t>(nrOdds), std::uint8_t(0));
+			// activate the sieving primes whose first multiple to cross off, p^2 or the first odd multiple in
+			// the segment, falls into this segment
+			while (active < sievingPrimes.size()) {
+				std::uint64_t p = sievingPrimes[active];
+				std::uint64_t offset;
+				if (p * p >= start) {
+					offset = p * p - start;
+					if (offset / 2 >= nrOdds) break;  // the remaining sieving primes start in a later segment
+				}
+				else {
+					std::uint64_t r = start % p;
+					offset = (r == 0 ? 0 : p - r);
+					if ((start + offset) % 2 == 0) offset += p;
+				}
+				next[active++] = offset / 2;
+			}
+			for (size_t k = 1; k < active; ++k) {
+				std::uint64_t p = sievingPrimes[k];
+				std::uint64_t j = next[k];
+				for (; j < nrOdds; j += p) composite[static_cast<size_t>(j)] = 1;
+				next[k] = j - nrOdds;
+			}
+			for (size_t i = 0; i < nrOdds; ++i) {
+				if (!composite[i]) segmentPrimes.push_back(start + 2 * i);
+			}
+		}
+	}, nrThreads);
+	for (const auto& segmentPrimes : found) primes.insert(primes.end(), segmentPrimes.begin(), segmentPrimes.end());
+	return primes;
+}
 
 }} // namespace sw::universal
@@ -5,6 +5,7 @@
 // SPDX-License-Identifier: MIT
 //
 // This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <array>
 #include <cassert>
 #include <limits>
 
@@ -12,6 +13,7 @@
 #include <universal/internal/blockbinary/blockbinary.hpp>
 #include <universal/internal/abstract/triple.hpp>
 #include <universal/number/shared/specific_value_encoding.hpp>
+#include <universal/number/shared/encoding_table.hpp>
 #include <universal/behavior/arithmetic.hpp>
 #include <universal/number/lns/lns_fwd.hpp>
 
@@ -452,6 +454,35 @@ public:
 		exp >>= rbits;
 		return long(exp);
 	}
+	// the exponent field is log2|x| as a signed fixed-point integer with rbits fraction bits
+	// the most negative field is the encoding of zero, and of NaN when the sign is set
+	static constexpr int64_t minExponentField = (nbits <= 64 ? -(int64_t(1) << (nbits - 2)) : 0);
+	static constexpr int64_t maxExponentField = (nbits <= 64 ? -(minExponentField + 1) : 0);
+	constexpr int64_t exponent_field() const noexcept {
+		static_assert(nbits <= 64, "lns::exponent_field: the exponent field must fit in 64 bits");
+		uint64_t field = encoding() << (65 - nbits);   // drop the sign bit and align the field to the msb
+		return static_cast<int64_t>(field) >> (65 - nbits);
+	}
+	// log2|x| of a nonzero value
+	constexpr double log2magnitude() const noexcept { return double(exponent_field()) / scaling; }
+	// set the sign and the exponent field: fields above maxpos saturate to maxpos, and fields at or below
+	// the encoding of zero underflow to zero
+	constexpr lns& set_exponent_field(bool negative, int64_t field) noexcept {
+		static_assert(nbits <= 64, "lns::set_exponent_field: the exponent field must fit in 64 bits");
+		if (field <= minExponentField) return zero();
+		if (field > maxExponentField) field = maxExponentField;
+		setbits(static_cast<uint64_t>(field) & (~0ull >> (65 - nbits)));
+		setsign(negative);
+		return *this;
+	}
+	// set the sign and log2|x|, rounded to the nearest exponent field, ties to even
+	lns& set_log2(bool negative, double log2magnitude) noexcept {
+		if (std::isnan(log2magnitude)) { setnan(); return *this; }
+		double field = log2magnitude * scaling;
+		if (field >= double(maxExponentField)) return set_exponent_field(negative, maxExponentField);
+		if (field <= double(minExponentField)) return zero();
+		return set_exponent_field(negative, static_cast<int64_t>(std::nearbyint(field)));
+	}
 	constexpr blockbinary<nbits+2, std::uint32_t, BinaryNumberType::Unsigned> fraction() const noexcept {
 		blockbinary<nbits + 2, std::uint32_t, BinaryNumberType::Unsigned> bb{ 0 };
 		// TODO: how? and what is the size of the blockbinary? it is much bigger than nbits+2
@@ -591,27 +622,24 @@ protected:
 
 		// check if the value is in the representable range
 		// NOTE: this is required to protect the rounding code below, which only works for values between [minpos, maxpos]
-		// TODO: this is all incredibly slow as we are creating special values and converting them to Real to compare
+		// the special values are converted to Real once, outside of constant expressions
 		if constexpr (behavior == Behavior::Saturating) {
 			constexpr lns maxpos(SpecificValue::maxpos);
 			constexpr lns maxneg(SpecificValue::maxneg);
+			constexpr lns minpos(SpecificValue::minpos);
+			std::array<Real, 4> threshold = (std::is_constant_evaluated() ? saturation_thresholds<Real>() : cached_saturation_thresholds<Real>());
 			Real absoluteValue = std::abs(v);
-			//std::cout << "maxpos : " << to_binary(maxpos) << " : " << maxpos << '\n';
-			if (v > 0 && v >= Real(maxpos)) {
+			if (v > 0 && v >= threshold[0]) {
 				return *this = maxpos;
 			}
-			if (v < 0 && v <= Real(maxneg)) {
+			if (v < 0 && v <= threshold[1]) {
 				return *this = maxneg;
 			}
-			constexpr lns minpos(SpecificValue::minpos);
-			constexpr lns<nbits + 1, rbits + 1, bt, xtra...> halfMinpos(SpecificValue::minpos); // in log space
-			//std::cout << "minpos     : " << minpos << '\n';
-			//std::cout << "halfMinpos : " << halfMinpos << '\n';
-			if (absoluteValue <= Real(halfMinpos)) {
+			if (absoluteValue <= threshold[2]) {
 				setzero();
 				return *this;
 			}
-			else if (absoluteValue <= Real(minpos)) {
+			else if (absoluteValue <= threshold[3]) {
 				return *this = (v > 0 ? minpos : -minpos);
 			}
 		}
@@ -714,8 +742,16 @@ protected:
 		to_unsigned() const {
 		return UnsignedInt(to_ieee754<double>());
 	}
+	// configurations of 12 bits or less decode to double through the encoding table, outside of constant expressions
+	template<typename TargetFloat>
+	CONSTEXPRESSION TargetFloat to_ieee754() const noexcept {
+		if constexpr (nbits <= max_implicit_encoding_table_nbits && std::is_same_v<TargetFloat, double>) {
+			if (!std::is_constant_evaluated()) return value_table().value(encoding());
+		}
+		return arithmetic_to_ieee754<TargetFloat>();
+	}
 	template<typename TargetFloat>
-	CONSTEXPRESSION TargetFloat to_ieee754() const noexcept {   // TODO: don't use bit math, use proper limb math to speed this up
+	CONSTEXPRESSION TargetFloat arithmetic_to_ieee754() const noexcept {   // TODO: don't use bit math, use proper limb math to speed this up
 		// special case handling
 		if (isnan()) return TargetFloat(NAN);
 		if (iszero()) return TargetFloat(0.0f);
@@ -764,6 +800,39 @@ protected:
 private:
 	BlockBinary _block;
 
+	// raw bits of a configuration of 64 bits or less
+	constexpr uint64_t encoding() const noexcept {
+		uint64_t raw{ 0 };
+		for (unsigned b = 0; b < nrBlocks; ++b) raw |= (uint64_t(_block[b]) << (b * bitsInBlock));
+		return raw;
+	}
+
+	// the saturating conversion compares against maxpos, maxneg, the value halfway to minpos in log space, and minpos
+	template<typename Real>
+	static CONSTEXPRESSION std::array<Real, 4> saturation_thresholds() noexcept {
+		constexpr lns maxpos(SpecificValue::maxpos);
+		constexpr lns maxneg(SpecificValue::maxneg);
+		constexpr lns minpos(SpecificValue::minpos);
+		constexpr lns<nbits + 1, rbits + 1, bt, xtra...> halfMinpos(SpecificValue::minpos); // in log space
+		return { maxpos.template arithmetic_to_ieee754<Real>(), maxneg.template arithmetic_to_ieee754<Real>(),
+			halfMinpos.template arithmetic_to_ieee754<Real>(), minpos.template arithmetic_to_ieee754<Real>() };
+	}
+	template<typename Real>
+	static const std::array<Real, 4>& cached_saturation_thresholds() noexcept {
+		static const std::array<Real, 4> threshold = saturation_thresholds<Real>();
+		return threshold;
+	}
+	// the thresholds include the minpos of the configuration with one more bit
+	template<unsigned nnbits, unsigned rrbits, typename bbt, auto... xxtra>
+	friend class lns;
+
+	// values of all encodings: the conversion from double is a logarithm and a rounding, faster than a search of the table
+	static const encoding_table<nbits>& value_table() {
+		static const encoding_table<nbits> table(
+			[](uint64_t raw) { lns v; v.setbits(raw); return v.template arithmetic_to_ieee754<double>(); });
+		return table;
+	}
+
 	////////////////////// operators
 
 	/// stream operators
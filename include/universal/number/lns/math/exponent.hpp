@@ -5,46 +5,48 @@
 // SPDX-License-Identifier: MIT
 //
 // This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <numbers>
 
 namespace sw { namespace universal {
 
 // the current shims are NON-COMPLIANT with the Universal standard, which says that every function must be
 // correctly rounded for every input value. Anything less sacrifices bitwise reproducibility of results.
 
-// Base-e exponential function
+// e^x, 2^x, and 10^x set the exponent field to x times the log2 of the base, rounded once:
+// the exponentials saturate at maxpos, and return minpos instead of underflowing to zero
 template<unsigned nbits, unsigned rbits, typename bt, auto... xtra>
-lns<nbits, rbits, bt, xtra...> exp(lns<nbits, rbits, bt, xtra...> x) {
+lns<nbits, rbits, bt, xtra...> lns_exponential(lns<nbits, rbits, bt, xtra...> x, double log2base) {
+	using LnsType = lns<nbits, rbits, bt, xtra...>;
 	if (isnan(x)) return x;
-	lns<nbits, rbits, bt, xtra...> p;
-	double d = std::exp(double(x));
-	if (d == 0.0) {
-		p.minpos();
+	LnsType p;
+	if constexpr (nbits <= 64) {
+		// the value of x from its exponent field, which is faster than the conversion to double
+		double v = (x.iszero() ? 0.0 : std::exp2(x.log2magnitude()));
+		p.set_log2(false, (x.isneg() ? -v : v) * log2base);
 	}
 	else {
-		p = d;
+		p = std::exp2(double(x) * log2base);
 	}
+	if (p.iszero()) p.minpos();
 	return p;
 }
 
+// Base-e exponential function
+template<unsigned nbits, unsigned rbits, typename bt, auto... xtra>
+lns<nbits, rbits, bt, xtra...> exp(lns<nbits, rbits, bt, xtra...> x) {
+	return lns_exponential(x, std::numbers::log2e);
+}
+
 // Base-2 exponential function
 template<unsigned nbits, unsigned rbits, typename bt, auto... xtra>
 lns<nbits, rbits, bt, xtra...> exp2(lns<nbits, rbits, bt, xtra...> x) {
-	if (isnan(x)) return x;
-	lns<nbits, rbits, bt, xtra...> p;
-	double d = std::exp2(double(x));
-	if (d == 0.0) {
-		p.minpos();
-	}
-	else {
-		p = d;
-	}
-	return p;
+	return lns_exponential(x, 1.0);
 }
 
 // Base-10 exponential function
 template<unsigned nbits, unsigned rbits, typename bt, auto... xtra>
 lns<nbits, rbits, bt, xtra...> exp10(lns<nbits, rbits, bt, xtra...> x) {
-	return lns<nbits, rbits, bt, xtra...>(std::pow(10.0, double(x)));
+	return lns_exponential(x, std::numbers::ln10 / std::numbers::ln2);
 }
 		
 // Base-e exponential function exp(x)-1
@@ -38,12 +38,27 @@ POSIX specifies that underflow may only occur when both arguments are subnormal
 
 hypot(INFINITY, NAN) returns +8, but sqrt(INFINITY*INFINITY+NAN*NAN) returns NaN.
 */
+#include <numbers>
 
 namespace sw { namespace universal {
 
+// with |x| >= |y| and d = log2|y| - log2|x| <= 0, log2 hypot(x, y) = log2|x| + log2(1 + 2^(2d)) / 2,
+// which neither squares the arguments nor leaves the log domain
 template<unsigned nbits, unsigned rbits, typename bt, auto... xtra>
 lns<nbits, rbits, bt, xtra...> hypot(lns<nbits, rbits, bt, xtra...> x, lns<nbits, rbits, bt, xtra...> y) {
-	return lns<nbits, rbits, bt, xtra...>(std::hypot(double(x),double(y)));
+	using LnsType = lns<nbits, rbits, bt, xtra...>;
+	if constexpr (nbits <= 64) {
+		if (x.isnan() || y.isnan()) return LnsType(SpecificValue::qnan);
+		if (x.iszero()) return (y.isneg() ? -y : y);
+		if (y.iszero()) return (x.isneg() ? -x : x);
+		double lx = x.log2magnitude(), ly = y.log2magnitude();
+		if (lx < ly) std::swap(lx, ly);
+		LnsType r;
+		return r.set_log2(false, lx + 0.5 * std::log1p(std::exp2(2.0 * (ly - lx))) / std::numbers::ln2);
+	}
+	else {
+		return LnsType(std::hypot(double(x), double(y)));
+	}
 }
 
 template<unsigned nbits, unsigned rbits, typename bt, auto... xtra>
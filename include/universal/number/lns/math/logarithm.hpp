@@ -4,25 +4,41 @@
 // Copyright (C) 2017 Stillwater Supercomputing, Inc.
 //
 // This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <numbers>
 
 namespace sw { namespace universal {
 
+// the logarithms of x are read from its exponent field: log2 is exact before the conversion of the
+// result, and log and log10 scale it by the log of 2 in the target base
+template<unsigned nbits, unsigned rbits, typename bt, auto... xtra>
+lns<nbits, rbits, bt, xtra...> lns_logarithm(lns<nbits, rbits, bt, xtra...> x, double log2scale) {
+	using LnsType = lns<nbits, rbits, bt, xtra...>;
+	if constexpr (nbits <= 64) {
+		if (x.isnan() || x.isneg()) return LnsType(SpecificValue::qnan);
+		if (x.iszero()) return LnsType(SpecificValue::infneg);
+		return LnsType(x.log2magnitude() * log2scale);
+	}
+	else {
+		return LnsType(std::log2(double(x)) * log2scale);
+	}
+}
+
 // Natural logarithm of x
 template<unsigned nbits, unsigned rbits, typename bt, auto... xtra>
 lns<nbits, rbits, bt, xtra...> log(lns<nbits, rbits, bt, xtra...> x) {
-	return lns<nbits, rbits, bt, xtra...>(std::log(double(x)));
+	return lns_logarithm(x, std::numbers::ln2);
 }
 
 // Binary logarithm of x
 template<unsigned nbits, unsigned rbits, typename bt, auto... xtra>
 lns<nbits, rbits, bt, xtra...> log2(lns<nbits, rbits, bt, xtra...> x) {
-	return lns<nbits, rbits, bt, xtra...>(std::log2(double(x)));
+	return lns_logarithm(x, 1.0);
 }
 
 // Decimal logarithm of x
 template<unsigned nbits, unsigned rbits, typename bt, auto... xtra>
 lns<nbits, rbits, bt, xtra...> log10(lns<nbits, rbits, bt, xtra...> x) {
-	return lns<nbits, rbits, bt, xtra...>(std::log10(double(x)));
+	return lns_logarithm(x, std::numbers::ln2 / std::numbers::ln10);
 }
 		
 // Natural logarithm of 1+x
@@ -8,19 +8,64 @@
 
 namespace sw { namespace universal {
 
+// x^y multiplies the exponent field of x by y, which rounds once in the log domain
+template<unsigned nbits, unsigned rbits, typename bt, auto... xtra>
+lns<nbits, rbits, bt, xtra...> pow(lns<nbits, rbits, bt, xtra...> x, double y) {
+	using LnsType = lns<nbits, rbits, bt, xtra...>;
+	if constexpr (nbits <= 64) {
+		if (y == 0.0) return LnsType(1);
+		if (x.isnan() || std::isnan(y)) return LnsType(SpecificValue::qnan);
+		bool integral = (y == std::trunc(y));
+		if (x.iszero()) return (y > 0.0 ? x : LnsType(SpecificValue::qnan));
+		if (x.isneg() && !integral) return LnsType(SpecificValue::qnan);
+		bool negative = x.isneg() && std::fmod(y, 2.0) != 0.0;
+		LnsType r;
+		return r.set_log2(negative, x.log2magnitude() * y);
+	}
+	else {
+		return LnsType(std::pow(double(x), y));
+	}
+}
+
 template<unsigned nbits, unsigned rbits, typename bt, auto... xtra>
 lns<nbits, rbits, bt, xtra...> pow(lns<nbits, rbits, bt, xtra...> x, lns<nbits, rbits, bt, xtra...> y) {
-	return lns<nbits, rbits, bt, xtra...>(std::pow(double(x), double(y)));
+	if (y.isnan()) return lns<nbits, rbits, bt, xtra...>(SpecificValue::qnan);
+	return pow(x, double(y));
 }
-		
+
+// integer powers are exact in the log domain until the exponent field saturates
 template<unsigned nbits, unsigned rbits, typename bt, auto... xtra>
 lns<nbits, rbits, bt, xtra...> pow(lns<nbits, rbits, bt, xtra...> x, int y) {
-	return lns<nbits, rbits, bt, xtra...>(std::pow(double(x), double(y)));
+	using LnsType = lns<nbits, rbits, bt, xtra...>;
+	if constexpr (nbits <= 64) {
+		if (y == 0) return LnsType(1);
+		if (x.isnan()) return x;
+		if (x.iszero()) return (y > 0 ? x : LnsType(SpecificValue::qnan));
+		bool negative = x.isneg() && (y & 1);
+		int64_t field = x.exponent_field();
+		LnsType r;
+		if (field == 0) return r.set_exponent_field(negative, 0);
+		if (std::abs(field) <= LnsType::maxExponentField / std::abs(int64_t(y))) return r.set_exponent_field(negative, field * y);
+		return r.set_exponent_field(negative, ((field > 0) == (y > 0)) ? LnsType::maxExponentField + 1 : LnsType::minExponentField);
+	}
+	else {
+		return LnsType(std::pow(double(x), double(y)));
+	}
 }
-		
+
+// 1/x negates the exponent field, which is exact
 template<unsigned nbits, unsigned rbits, typename bt, auto... xtra>
-lns<nbits, rbits, bt, xtra...> pow(lns<nbits, rbits, bt, xtra...> x, double y) {
-	return lns<nbits, rbits, bt, xtra...>(std::pow(double(x), y));
+lns<nbits, rbits, bt, xtra...> reciprocal(const lns<nbits, rbits, bt, xtra...>& x) {
+	using LnsType = lns<nbits, rbits, bt, xtra...>;
+	if (x.isnan()) return x;
+	if (x.iszero()) return LnsType(x.sign() ? SpecificValue::infneg : SpecificValue::infpos);
+	if constexpr (nbits <= 64) {
+		LnsType r;
+		return r.set_exponent_field(x.sign(), -x.exponent_field());
+	}
+	else {
+		return LnsType(1.0 / double(x));
+	}
 }
 
 }} // namespace sw::universal
@@ -9,7 +9,7 @@
 //#include <universal/number/lns/math/sqrt_tables.hpp>
 
 #ifndef LNS_NATIVE_SQRT
-#define LNS_NATIVE_SQRT 0
+#define LNS_NATIVE_SQRT 1
 #endif
 
 namespace sw { namespace universal {
@@ -76,17 +76,36 @@ namespace sw { namespace universal {
 	*/
 
 
+	// n / d rounded to the nearest integer, ties to even, for d > 0
+	constexpr int64_t lns_rounded_quotient(int64_t n, int64_t d) noexcept {
+		int64_t q = n / d, r = n % d;
+		if (r < 0) { --q; r += d; }   // floor division
+		if (2 * r > d || (2 * r == d && (q & 1))) ++q;
+		return q;
+	}
+
 #if LNS_NATIVE_SQRT
-	// sqrt for arbitrary lns
+	// sqrt for arbitrary lns: the root of 2^(L / 2^rbits) halves the exponent field L, which is rounded once
 	template<unsigned nbits, unsigned rbits, typename bt, auto... xtra>
 	inline lns<nbits, rbits, bt, xtra...> sqrt(const lns<nbits, rbits, bt, xtra...>& a) {
+		using LnsType = lns<nbits, rbits, bt, xtra...>;
+		if (a.isnan()) return a;
 #if LNS_THROW_ARITHMETIC_EXCEPTION
 		if (a.isneg()) throw lns_negative_sqrt_arg();
 #else
-		if (a.isneg()) std::cerr << "lns argument to sqrt is negative: " << a << std::endl;
+		if (a.isneg()) {
+			std::cerr << "lns argument to sqrt is negative: " << a << std::endl;
+			return LnsType(SpecificValue::qnan);
+		}
 #endif
 		if (a.iszero()) return a;
-		return lns<nbits, rbits, bt, xtra...>(std::sqrt((double)a));  // TBD
+		if constexpr (nbits <= 64) {
+			LnsType r;
+			return r.set_exponent_field(false, lns_rounded_quotient(a.exponent_field(), 2));
+		}
+		else {
+			return LnsType(std::sqrt(double(a)));
+		}
 	}
 #else
 	template<unsigned nbits, unsigned rbits, typename bt, auto... xtra>
@@ -101,11 +120,33 @@ namespace sw { namespace universal {
 	}
 #endif
 
-	// reciprocal sqrt
+	// reciprocal sqrt: the negated and halved exponent field
 	template<unsigned nbits, unsigned rbits, typename bt, auto... xtra>
 	inline lns<nbits, rbits, bt, xtra...> rsqrt(const lns<nbits, rbits, bt, xtra...>& a) {
-		lns<nbits, rbits, bt, xtra...> v = sqrt(a);
-		return v.reciprocate();
+		using LnsType = lns<nbits, rbits, bt, xtra...>;
+		if (a.isnan() || a.isneg()) return LnsType(SpecificValue::qnan);
+		if (a.iszero()) return LnsType(SpecificValue::infpos);
+		if constexpr (nbits <= 64) {
+			LnsType r;
+			return r.set_exponent_field(false, lns_rounded_quotient(-a.exponent_field(), 2));
+		}
+		else {
+			return LnsType(1.0 / std::sqrt(double(a)));
+		}
+	}
+
+	// cube root: a third of the exponent field, which never ties, and the sign of the argument
+	template<unsigned nbits, unsigned rbits, typename bt, auto... xtra>
+	inline lns<nbits, rbits, bt, xtra...> cbrt(const lns<nbits, rbits, bt, xtra...>& a) {
+		using LnsType = lns<nbits, rbits, bt, xtra...>;
+		if (a.isnan() || a.iszero()) return a;
+		if constexpr (nbits <= 64) {
+			LnsType r;
+			return r.set_exponent_field(a.sign(), lns_rounded_quotient(a.exponent_field(), 3));
+		}
+		else {
+			return LnsType(std::cbrt(double(a)));
+		}
 	}
 
 	///////////////////////////////////////////////////////////////////
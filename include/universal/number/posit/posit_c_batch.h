@@ -0,0 +1,62 @@
+#pragma once
+// posit_c_batch.h: vectorized C API for the standard posits, exported by the shared library universal_c
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <stddef.h>
+
+// posit C types
+#include <universal/number/posit/positctypes.h>
+
+#ifndef UNIVERSAL_C_EXPORT
+#if defined(_WIN32) && defined(UNIVERSAL_C_BUILDING)
+#define UNIVERSAL_C_EXPORT __declspec(dllexport)
+#elif defined(_WIN32)
+#define UNIVERSAL_C_EXPORT __declspec(dllimport)
+#elif defined(__GNUC__)
+#define UNIVERSAL_C_EXPORT __attribute__((visibility("default")))
+#else
+#define UNIVERSAL_C_EXPORT
+#endif
+#endif
+
+#ifdef __cplusplus
+// export a C interface if used by C++ source code
+extern "C" {
+#endif
+
+/*
+ * The batch entry points operate on arrays of posits and decode every element straight into the fast
+ * C++ specializations of posit<8,0>, posit<16,1>, and posit<32,2>, and into posit<64,3>. Matrices are
+ * dense and row-major.
+ *
+ *   positN_from_doubles(in, out, n)   out[i] = positN(in[i])
+ *   positN_to_doubles(in, out, n)     out[i] = double(in[i])
+ *   positN_dot(x, y, n)               sum of x[i] * y[i], rounded after every operation
+ *   positN_fdot(x, y, n)              sum of x[i] * y[i] accumulated exactly, as in the quire, and rounded once
+ *   positN_axpy(a, x, y, n)           y[i] = a * x[i] + y[i]
+ *   positN_gemm(m, n, k, alpha, A, B, beta, C)
+ *                                     C = alpha * A * B + beta * C, with A m-by-k, B k-by-n, and C m-by-n;
+ *                                     C is not read when beta is zero
+ */
+#define POSIT_BATCH_API(nbits) \
+	UNIVERSAL_C_EXPORT void posit##nbits##_from_doubles(const double* in, posit##nbits##_t* out, size_t n); \
+	UNIVERSAL_C_EXPORT void posit##nbits##_to_doubles(const posit##nbits##_t* in, double* out, size_t n); \
+	UNIVERSAL_C_EXPORT posit##nbits##_t posit##nbits##_dot(const posit##nbits##_t* x, const posit##nbits##_t* y, size_t n); \
+	UNIVERSAL_C_EXPORT posit##nbits##_t posit##nbits##_fdot(const posit##nbits##_t* x, const posit##nbits##_t* y, size_t n); \
+	UNIVERSAL_C_EXPORT void posit##nbits##_axpy(posit##nbits##_t a, const posit##nbits##_t* x, posit##nbits##_t* y, size_t n); \
+	UNIVERSAL_C_EXPORT void posit##nbits##_gemm(size_t m, size_t n, size_t k, posit##nbits##_t alpha, const posit##nbits##_t* A, \
+		const posit##nbits##_t* B, posit##nbits##_t beta, posit##nbits##_t* C);
+
+POSIT_BATCH_API(8)
+POSIT_BATCH_API(16)
+POSIT_BATCH_API(32)
+POSIT_BATCH_API(64)
+
+#undef POSIT_BATCH_API
+
+#ifdef __cplusplus
+}
+#endif
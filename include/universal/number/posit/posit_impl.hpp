@@ -40,6 +40,7 @@
 #include <universal/internal/bitblock/bitblock.hpp>
 #include <universal/internal/value/value.hpp>
 #include <universal/number/shared/specific_value_encoding.hpp>
+#include <universal/number/shared/encoding_table.hpp>
 
 // posit environment
 #include <universal/number/posit/posit_fwd.hpp>
@@ -1145,6 +1146,40 @@ public:
 		return ss.str();
 	}
 
+	// arithmetic conversions to and from double, which the encoding table of posits of 12 bits or less reproduces
+	double arithmetic_to_double() const {
+		if (iszero())	return 0.0;
+		if (isnar())	return std::numeric_limits<double>::quiet_NaN();
+		bool		     	 _sign{ false };
+		positRegime<nbits, es>    _positRegime;
+		positExponent<nbits, es>  _positExponent;
+		positFraction<fbits>      _positFraction;
+		decode(_bits, _sign, _positRegime, _positExponent, _positFraction);
+		double s = (_sign ? -1.0 : 1.0);
+		double r = double(_positRegime.value());
+		double e = double(_positExponent.value());
+		double f = (1.0 + double(_positFraction.value()));
+		return s * r * e * f;
+	}
+	template <typename T>
+	constexpr posit<nbits, es>& arithmetic_convert_ieee754(const T& rhs) {
+		constexpr int dfbits = std::numeric_limits<T>::digits - 1;
+		internal::value<dfbits> v(static_cast<T>(rhs));
+
+		// special case processing
+		if (v.iszero()) {
+			setzero();
+			return *this;
+		}
+		if (v.isinf() || v.isnan()) {  // posit encode for FP_INFINITE and NaN as NaR (Not a Real)
+			setnar();
+			return *this;
+		}
+
+		convert(v, *this);
+		return *this;
+	}
+
 private:
 	internal::bitblock<nbits>      _bits;	// raw bit representation
 
@@ -1206,18 +1241,12 @@ private:
 		return (float)to_double();
 	}
 	double to_double() const {
-		if (iszero())	return 0.0;
-		if (isnar())	return std::numeric_limits<double>::quiet_NaN();
-		bool		     	 _sign{ false };
-		positRegime<nbits, es>    _positRegime;
-		positExponent<nbits, es>  _positExponent;
-		positFraction<fbits>      _positFraction;
-		decode(_bits, _sign, _positRegime, _positExponent, _positFraction);
-		double s = (_sign ? -1.0 : 1.0);
-		double r = double(_positRegime.value());
-		double e = double(_positExponent.value());
-		double f = (1.0 + double(_positFraction.value()));
-		return s * r * e * f;
+		if constexpr (nbits <= max_implicit_encoding_table_nbits) {
+			return value_table().value(bits());
+		}
+		else {
+			return arithmetic_to_double();
+		}
 	}
 	long double to_long_double() const {
 		if (iszero())  return 0.0l;
@@ -1233,23 +1262,24 @@ private:
 		long double f = (1.0l + _positFraction.value());
 		return s * r * e * f;
 	}
+	// posits of 12 bits or less convert through the encoding table, outside of constant expressions
 	template <typename T>
 	constexpr posit<nbits, es>& convert_ieee754(const T& rhs) {
-		constexpr int dfbits = std::numeric_limits<T>::digits - 1;
-		internal::value<dfbits> v(static_cast<T>(rhs));
-
-		// special case processing
-		if (v.iszero()) {
-			setzero();
-			return *this;
-		}
-		if (v.isinf() || v.isnan()) {  // posit encode for FP_INFINITE and NaN as NaR (Not a Real)
-			setnar();
-			return *this;
+		if constexpr (nbits <= max_implicit_encoding_table_nbits && (std::is_same_v<T, float> || std::is_same_v<T, double>)) {
+			if (!std::is_constant_evaluated()) {
+				uint64_t raw{ 0 };
+				if (value_table().encode(double(rhs), raw)) return setbits(raw);
+			}
 		}
+		return arithmetic_convert_ieee754(rhs);
+	}
 
-		convert(v, *this);
-		return *this;
+	// values of all encodings, and the rounding boundaries of the arithmetic conversion from double
+	static const encoding_table<nbits>& value_table() {
+		static const encoding_table<nbits> table(
+			[](uint64_t raw) { posit p; p.setbits(raw); return p.arithmetic_to_double(); },
+			[](double v) { posit p; p.arithmetic_convert_ieee754(v); return uint64_t(p.bits()); });
+		return table;
 	}
 
 	// friend functions
@@ -0,0 +1,165 @@
+#pragma once
+// encoding_table.hpp: value tables that turn the conversions of small formats to and from double into table lookups
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <numeric>
+#include <vector>
+
+namespace sw { namespace universal {
+
+/*
+ * A format of at most 16 bits has at most 65536 encodings, so its conversions to and from double
+ * can be tables generated from the arithmetic conversions of the format. The decode table maps an
+ * encoding to its double value. The encode table holds the distinct finite values in increasing order,
+ * together with the smallest double that rounds to each of them. These rounding boundaries are found
+ * by evaluating the arithmetic conversion between neighboring values, so the table reproduces the
+ * rounding of the format, ties and the geometric rounding of posit and lns included. Decoding is a
+ * single load, and encoding is a branchless binary search over the boundaries. The search is only
+ * faster than an arithmetic conversion that takes many steps, such as the regime of a posit: a format
+ * whose conversion from double is a few bit manipulations tabulates its decode only.
+ *
+ * The tables are generated on the first conversion of a format: the arithmetic conversions are not
+ * constant expressions for all formats, and a 16-bit encode table evaluates several conversions per
+ * encoding, which is more than a compiler allows in a constant expression. NaN, values outside of the
+ * finite range of the format, and values that round to zero are left to the arithmetic conversion,
+ * which owns saturation, wrap around, infinities, and signed zeros.
+ *
+ * Generating a table is not free: a 12-bit table takes a few milliseconds, but a 16-bit table takes
+ * tens of milliseconds, the posit encode and the lns decode tables up to a tenth of a second. The
+ * conversions of a format tabulate themselves up to 12 bits only, so that a program that converts a
+ * handful of 16-bit values does not pay for 65536 of them. Wider formats up to 16 bits are tabulated
+ * only when a caller asks for a table, such as the quantizer that converts whole tensors.
+ */
+
+// formats with at most this many bits can be tabulated
+constexpr unsigned max_encoding_table_nbits = 16;
+// formats with at most this many bits convert to and from double through an encoding table
+constexpr unsigned max_implicit_encoding_table_nbits = 12;
+
+template<unsigned nbits>
+class encoding_table {
+public:
+	static_assert(nbits <= max_encoding_table_nbits, "encoding_table: format is too large to tabulate");
+	static constexpr size_t   nrEncodings = size_t(1) << nbits;
+	static constexpr uint64_t mask = nrEncodings - 1;
+
+	// decode(uint64_t encoding) -> double is the arithmetic conversion of the format to double
+	template<typename Decoder>
+	explicit encoding_table(Decoder&& decode) : _value(nrEncodings) {
+		for (size_t e = 0; e < nrEncodings; ++e) _value[e] = decode(uint64_t(e));
+	}
+
+	// encode(double) -> uint64_t is the arithmetic conversion of the format from double
+	template<typename Decoder, typename Encoder>
+	encoding_table(Decoder&& decode, Encoder&& encode) : encoding_table(decode) {
+		// distinct finite values in increasing order, represented by their lowest encoding
+		for (size_t e = 0; e < nrEncodings; ++e) if (std::isfinite(_value[e])) _encoding.push_back(uint32_t(e));
+		std::stable_sort(_encoding.begin(), _encoding.end(), [this](uint32_t a, uint32_t b) { return _value[a] < _value[b]; });
+		_encoding.erase(std::unique(_encoding.begin(), _encoding.end(), [this](uint32_t a, uint32_t b) { return _value[a] == _value[b]; }), _encoding.end());
+
+		_bound.resize(_encoding.size());
+		_zero = _encoding.size();
+		for (size_t k = 0; k < _encoding.size(); ++k) {
+			double v = _value[_encoding[k]];
+			_bound[k] = (k == 0 ? v : boundary(_value[_encoding[k - 1]], v, encode));
+			if (v == 0.0) _zero = k;
+		}
+		_highest = (_encoding.empty() ? 0.0 : _value[_encoding.back()]);
+	}
+
+	// value of an encoding
+	double value(uint64_t encoding) const noexcept { return _value[encoding & mask]; }
+
+	// encoding of v, or false when the conversion of v belongs to the arithmetic conversion or the table has no encode
+	bool encode(double v, uint64_t& encoding) const noexcept {
+		if (_bound.empty() || !(v >= _bound[0] && v <= _highest)) return false;
+		const double* base = _bound.data();
+		size_t n = _bound.size();
+		while (n > 1) {
+			size_t half = n >> 1;
+			base += static_cast<size_t>(base[half] <= v) * half;
+			n -= half;
+		}
+		size_t k = static_cast<size_t>(base - _bound.data());
+		if (k == _zero) return false;
+		encoding = _encoding[k];
+		return true;
+	}
+
+	size_t size() const noexcept { return _encoding.size(); }
+	// k-th distinct finite value in increasing order, and the smallest double that rounds to it
+	double ordered_value(size_t k) const noexcept { return _value[_encoding[k]]; }
+	double rounding_bound(size_t k) const noexcept { return _bound[k]; }
+
+private:
+	std::vector<double>   _value;     // value of each encoding
+	std::vector<uint32_t> _encoding;  // encodings of the distinct finite values, in increasing order
+	std::vector<double>   _bound;     // smallest double that rounds to _encoding[k]
+	double                _highest{ 0.0 };
+	size_t                _zero{ 0 };   // index of the value zero, or size() when zero is not a value
+
+	// doubles mapped to integers in the same order, so that a bisection can visit every double of an interval
+	static int64_t key(double x) noexcept {
+		int64_t bits;
+		std::memcpy(&bits, &x, sizeof(bits));
+		return (bits < 0 ? -(bits & 0x7FFF'FFFF'FFFF'FFFFll) : bits);
+	}
+	static double from_key(int64_t k) noexcept {
+		uint64_t bits = (k < 0 ? (uint64_t(-k) | 0x8000'0000'0000'0000ull) : uint64_t(k));
+		double x;
+		std::memcpy(&x, &bits, sizeof(x));
+		return x;
+	}
+
+	// smallest double in (lo, hi] that the arithmetic conversion rounds above lo
+	template<typename Encoder>
+	double boundary(double lo, double hi, Encoder& encode) const {
+		auto roundsUp = [&](double x) { return _value[encode(x) & mask] > lo; };
+		int64_t loKey = key(lo), hiKey = key(hi);
+		// the boundary is the arithmetic midpoint for linear rounding, and the geometric midpoint for rounding in the exponent
+		double candidates[2] = { std::midpoint(lo, hi), (lo > 0.0 ? std::sqrt(lo * hi) : (hi < 0.0 ? -std::sqrt(lo * hi) : lo)) };
+		int probes = 0;
+		bool above = false;
+		for (double c : candidates) {
+			int64_t k = key(c);
+			if (k <= loKey || k >= hiKey) continue;
+			++probes;
+			above = roundsUp(c);
+			if (above) {
+				if (!roundsUp(from_key(k - 1))) return c;
+				hiKey = k - 1;
+			}
+			else {
+				if (roundsUp(from_key(k + 1))) return from_key(k + 1);
+				loKey = k + 1;
+			}
+		}
+		// the boundary is within a few doubles of the last candidate when the conversion rounds in double arithmetic
+		if (probes > 0) {
+			for (int64_t step = 1; hiKey - loKey > step; step *= 2) {
+				if (above) {
+					int64_t k = hiKey - step;
+					if (roundsUp(from_key(k))) hiKey = k; else { loKey = k; break; }
+				}
+				else {
+					int64_t k = loKey + step;
+					if (roundsUp(from_key(k))) { hiKey = k; break; } else loKey = k;
+				}
+			}
+		}
+		while (hiKey - loKey > 1) {
+			int64_t k = loKey + (hiKey - loKey) / 2;
+			if (roundsUp(from_key(k))) hiKey = k; else loKey = k;
+		}
+		return from_key(hiKey);
+	}
+};
+
+}} // namespace sw::universal
@@ -0,0 +1,265 @@
+#pragma once
+// runge_kutta.hpp: explicit Runge-Kutta integrators defined by a Butcher tableau, for single trajectories and ensembles
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <chrono>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <universal/native/ieee754_type_tag.hpp>
+#include <universal/utility/parallel.hpp>
+
+namespace sw { namespace universal { namespace ode {
+
+/*
+ * An explicit s-stage Runge-Kutta method advances y' = f(t, y) by
+ *     k_i     = f(t + c_i h, y + h sum_{j<i} a_ij k_j)     i = 1..s
+ *     y_{n+1} = y_n + h sum_i b_i k_i
+ * The coefficients of the tableau are rationals, which are converted into the target type with a
+ * single rounding, so that a method is as accurate in a wide type as in double.
+ *
+ * Precision studies, such as the reliable computation time of a chaotic system, need thousands of
+ * trajectories. An ensemble stores its members as a structure of arrays, component by component,
+ * and the right-hand side is evaluated on blocks of members, which exposes the member loop to the
+ * compiler. The members are distributed across threads, and each member is integrated with exactly
+ * the operations of a single trajectory, so the result does not depend on the number of threads.
+ */
+
+// rational coefficient num / den of a Butcher tableau
+struct rk_coefficient {
+	long long num;
+	long long den;
+};
+
+struct butcher_tableau {
+	std::string                name;
+	unsigned                   order;
+	size_t                     stages;
+	std::vector<rk_coefficient> a;  // stages x stages, row-major, strictly lower triangular
+	std::vector<rk_coefficient> b;  // weights
+	std::vector<rk_coefficient> c;  // nodes
+};
+
+inline butcher_tableau forward_euler() {
+	return { "forward Euler", 1, 1, { {0,1} }, { {1,1} }, { {0,1} } };
+}
+inline butcher_tableau explicit_midpoint() {
+	return { "explicit midpoint", 2, 2, { {0,1}, {0,1}, {1,2}, {0,1} }, { {0,1}, {1,1} }, { {0,1}, {1,2} } };
+}
+inline butcher_tableau heun() {
+	return { "Heun", 2, 2, { {0,1}, {0,1}, {1,1}, {0,1} }, { {1,2}, {1,2} }, { {0,1}, {1,1} } };
+}
+inline butcher_tableau kutta3() {
+	return { "Kutta third order", 3, 3,
+		{ {0,1}, {0,1}, {0,1},
+		  {1,2}, {0,1}, {0,1},
+		  {-1,1}, {2,1}, {0,1} },
+		{ {1,6}, {2,3}, {1,6} },
+		{ {0,1}, {1,2}, {1,1} } };
+}
+inline butcher_tableau classic_rk4() {
+	return { "classic Runge-Kutta", 4, 4,
+		{ {0,1}, {0,1}, {0,1}, {0,1},
+		  {1,2}, {0,1}, {0,1}, {0,1},
+		  {0,1}, {1,2}, {0,1}, {0,1},
+		  {0,1}, {0,1}, {1,1}, {0,1} },
+		{ {1,6}, {1,3}, {1,3}, {1,6} },
+		{ {0,1}, {1,2}, {1,2}, {1,1} } };
+}
+inline butcher_tableau rk38() {
+	return { "Kutta 3/8 rule", 4, 4,
+		{ {0,1}, {0,1}, {0,1}, {0,1},
+		  {1,3}, {0,1}, {0,1}, {0,1},
+		  {-1,3}, {1,1}, {0,1}, {0,1},
+		  {1,1}, {-1,1}, {1,1}, {0,1} },
+		{ {1,8}, {3,8}, {3,8}, {1,8} },
+		{ {0,1}, {1,3}, {2,3}, {1,1} } };
+}
+
+// ensemble of members of a system of the given dimension, stored component by component
+template<typename Scalar>
+class ensemble {
+public:
+	ensemble(size_t dimension, size_t members) : _dimension{ dimension }, _members{ members }, _data(dimension * members) {}
+
+	size_t dimension() const noexcept { return _dimension; }
+	size_t members() const noexcept { return _members; }
+
+	Scalar& operator()(size_t member, size_t component) { return _data[component * _members + member]; }
+	const Scalar& operator()(size_t member, size_t component) const { return _data[component * _members + member]; }
+	Scalar* component(size_t c) noexcept { return _data.data() + c * _members; }
+	const Scalar* component(size_t c) const noexcept { return _data.data() + c * _members; }
+
+	// state of a single member
+	std::vector<Scalar> member(size_t m) const {
+		std::vector<Scalar> y(_dimension);
+		for (size_t c = 0; c < _dimension; ++c) y[c] = (*this)(m, c);
+		return y;
+	}
+
+private:
+	size_t              _dimension;
+	size_t              _members;
+	std::vector<Scalar> _data;
+};
+
+// block of consecutive members of an ensemble: component c of member j is block[c][j], j in [0, size())
+template<typename Scalar>
+struct soa_block {
+	Scalar* base;
+	size_t  stride;
+	size_t  count;
+
+	Scalar* operator[](size_t component) const noexcept { return base + component * stride; }
+	size_t size() const noexcept { return count; }
+};
+
+template<typename Scalar>
+class explicit_runge_kutta {
+public:
+	// number of members that a thread advances together through all the steps
+	static constexpr size_t tile = 64;
+
+	explicit explicit_runge_kutta(const butcher_tableau& tableau) : _tableau{ tableau }, _s{ tableau.stages }, _a(_s * _s), _b(_s), _c(_s) {
+		if (_s == 0 || tableau.a.size() != _s * _s || tableau.b.size() != _s || tableau.c.size() != _s) {
+			throw std::invalid_argument("Butcher tableau " + tableau.name + " has inconsistent dimensions");
+		}
+		for (size_t i = 0; i < _s; ++i) {
+			for (size_t j = i; j < _s; ++j) {
+				if (tableau.a[i * _s + j].num != 0) throw std::invalid_argument("Butcher tableau " + tableau.name + " is not explicit");
+			}
+		}
+		for (size_t i = 0; i < _s * _s; ++i) _a[i] = convert(tableau.a[i]);
+		for (size_t i = 0; i < _s; ++i) {
+			_b[i] = convert(tableau.b[i]);
+			_c[i] = convert(tableau.c[i]);
+		}
+	}
+
+	const butcher_tableau& tableau() const noexcept { return _tableau; }
+	size_t stages() const noexcept { return _s; }
+
+	// integrate a single trajectory y' = f(t, y), with f(t, const std::vector<Scalar>& y, std::vector<Scalar>& dydt),
+	// over the given number of steps: returns the final time
+	template<typename System>
+	Scalar integrate(System&& f, Scalar t, std::vector<Scalar>& y, const Scalar& h, size_t steps) const {
+		size_t n = y.size();
+		std::vector<std::vector<Scalar>> k(_s, std::vector<Scalar>(n));
+		std::vector<Scalar> Y(n);
+		for (size_t step = 0; step < steps; ++step) {
+			for (size_t i = 0; i < _s; ++i) {
+				for (size_t c = 0; c < n; ++c) {
+					Scalar acc(0);
+					for (size_t j = 0; j < i; ++j) if (!iszero(_tableau.a[i * _s + j])) acc += _a[i * _s + j] * k[j][c];
+					Y[c] = y[c] + h * acc;
+				}
+				f(t + _c[i] * h, Y, k[i]);
+			}
+			for (size_t c = 0; c < n; ++c) {
+				Scalar acc(0);
+				for (size_t i = 0; i < _s; ++i) if (!iszero(_tableau.b[i])) acc += _b[i] * k[i][c];
+				y[c] += h * acc;
+			}
+			t += h;
+		}
+		return t;
+	}
+
+	// integrate all members of an ensemble y' = f(t, y), with f(t, soa_block<const Scalar> y, soa_block<Scalar> dydt)
+	// evaluating the right-hand side for all members of the block: returns the final time
+	template<typename System>
+	Scalar integrate(System&& f, const Scalar& t0, ensemble<Scalar>& y, const Scalar& h, size_t steps, unsigned nrThreads = 0) const {
+		size_t members = y.members();
+		size_t n = y.dimension();
+		size_t nrTiles = (members + tile - 1) / tile;
+		parallel_for(0, nrTiles, [&](size_t firstTile, size_t lastTile, unsigned) {
+			// stage derivatives and stage state of one tile, stored component by component
+			std::vector<Scalar> k(_s * n * tile), Y(n * tile);
+			for (size_t tl = firstTile; tl < lastTile; ++tl) {
+				size_t first = tl * tile;
+				size_t count = (first + tile < members ? tile : members - first);
+				soa_block<Scalar> state{ y.component(0) + first, members, count };
+				soa_block<const Scalar> stage{ Y.data(), tile, count };
+				Scalar t = t0;
+				for (size_t step = 0; step < steps; ++step) {
+					for (size_t i = 0; i < _s; ++i) {
+						for (size_t c = 0; c < n; ++c) {
+							for (size_t m = 0; m < count; ++m) {
+								Scalar acc(0);
+								for (size_t j = 0; j < i; ++j) if (!iszero(_tableau.a[i * _s + j])) acc += _a[i * _s + j] * k[(j * n + c) * tile + m];
+								Y[c * tile + m] = state[c][m] + h * acc;
+							}
+						}
+						f(t + _c[i] * h, stage, soa_block<Scalar>{ k.data() + i * n * tile, tile, count });
+					}
+					for (size_t c = 0; c < n; ++c) {
+						for (size_t m = 0; m < count; ++m) {
+							Scalar acc(0);
+							for (size_t i = 0; i < _s; ++i) if (!iszero(_tableau.b[i])) acc += _b[i] * k[(i * n + c) * tile + m];
+							state[c][m] += h * acc;
+						}
+					}
+					t += h;
+				}
+			}
+		}, nrThreads);
+		Scalar t = t0;
+		for (size_t step = 0; step < steps; ++step) t += h;
+		return t;
+	}
+
+private:
+	butcher_tableau     _tableau;
+	size_t              _s;
+	std::vector<Scalar> _a, _b, _c;
+
+	static bool iszero(const rk_coefficient& coef) noexcept { return coef.num == 0; }
+
+	// coefficients with a power of two denominator are exact in double, the others are rounded once in Scalar
+	static Scalar convert(const rk_coefficient& coef) {
+		if ((coef.den & (coef.den - 1)) == 0) return Scalar(double(coef.num) / double(coef.den));
+		return Scalar(double(coef.num)) / Scalar(double(coef.den));
+	}
+};
+
+// throughput and final state of an ensemble integration in one number system
+struct ensemble_run {
+	std::string         type;
+	double              seconds;
+	double              steps_per_second;  // member steps per second
+	ensemble<double>    state;
+};
+
+// integrate the same ensemble in each of the number systems Scalars, with f a generic right-hand side
+// that accepts the soa_block of any of them: the initial state is rounded into each type
+template<typename... Scalars, typename System>
+std::vector<ensemble_run> ensemble_study(const butcher_tableau& tableau, System&& f, const ensemble<double>& y0, double t0, double h, size_t steps, unsigned nrThreads = 0) {
+	std::vector<ensemble_run> runs;
+	auto run = [&](auto scalar) {
+		using Scalar = decltype(scalar);
+		explicit_runge_kutta<Scalar> rk(tableau);
+		ensemble<Scalar> y(y0.dimension(), y0.members());
+		for (size_t c = 0; c < y0.dimension(); ++c) {
+			for (size_t m = 0; m < y0.members(); ++m) y(m, c) = Scalar(y0(m, c));
+		}
+		using namespace std::chrono;
+		steady_clock::time_point begin = steady_clock::now();
+		rk.integrate(f, Scalar(t0), y, Scalar(h), steps, nrThreads);
+		steady_clock::time_point end = steady_clock::now();
+		double elapsed = duration_cast<duration<double>>(end - begin).count();
+		ensemble<double> state(y0.dimension(), y0.members());
+		for (size_t c = 0; c < y0.dimension(); ++c) {
+			for (size_t m = 0; m < y0.members(); ++m) state(m, c) = double(y(m, c));
+		}
+		double work = double(steps) * double(y0.members());
+		runs.push_back(ensemble_run{ type_tag(Scalar()), elapsed, (elapsed > 0.0 ? work / elapsed : 0.0), std::move(state) });
+	};
+	(run(Scalars{}), ...);
+	return runs;
+}
+
+}}} // namespace sw::universal::ode
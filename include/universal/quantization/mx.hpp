@@ -0,0 +1,610 @@
+#pragma once
+// mx.hpp: microscaling (MX) block-scaled formats: blocks of elements that share a power of two scale
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include <universal/blas/exceptions.hpp>
+#include <universal/blas/execution.hpp>
+#include <universal/blas/matrix.hpp>
+#include <universal/quantization/quantizer.hpp>
+#include <universal/utility/bit_packing.hpp>
+
+namespace sw { namespace universal {
+
+/*
+ * The OCP Microscaling Formats (MX) Specification v1.0 defines formats in which a block of 32 elements
+ * shares a scale X = 2^e, encoded as an E8M0 exponent, and each element P is a narrow number: the block
+ * represents the values X * P. The element formats are FP8 (E4M3 and E5M2), FP6 (E3M2 and E2M3), FP4 (E2M1),
+ * and INT8, a two's complement integer with an implicit scale of 2^-6. These are not the cfloat
+ * configurations of the same field widths: E4M3 has no infinities and a single NaN, so its largest value is
+ * 448, and the FP6 and FP4 formats use every encoding for a finite value, so FP4 E2M1 represents 4 and 6.
+ *
+ * Quantization follows the specification: the shared exponent of a block is the exponent of its largest
+ * magnitude minus the exponent of the largest binade of the element format, and the elements are the values
+ * divided by the scale, rounded to nearest even, and saturated to the largest element. A block that holds
+ * a NaN or an infinity gets the NaN scale, which makes all of its values NaN.
+ *
+ * Every element value is an integer multiple of the smallest subnormal of its format, 2^unit_exponent.
+ * A block dot product is therefore a dot product of small integers, which is exact in a 32-bit or 64-bit
+ * integer accumulator, scaled by the product of the two block scales. The block products are accumulated
+ * in double, in block order, so the result does not depend on the number of threads. E5M2 elements span
+ * 32 binades, and products of E5M2 elements are accumulated in double, which rounds within a block.
+ */
+
+// E8M0: the shared scale of an MX block, an unsigned biased exponent of a power of two
+class e8m0 {
+public:
+	static constexpr int     bias = 127;
+	static constexpr int     min_exponent = -127;
+	static constexpr int     max_exponent = 127;
+	static constexpr uint8_t nan_encoding = 0xFF;
+
+	constexpr e8m0() noexcept : _bits{ uint8_t(bias) } {}
+	// 2^exponent, with the exponent clamped to the range of the format
+	explicit constexpr e8m0(int exponent) noexcept : _bits{ uint8_t(std::clamp(exponent, min_exponent, max_exponent) + bias) } {}
+
+	static constexpr e8m0 nan() noexcept { e8m0 s; s._bits = nan_encoding; return s; }
+
+	constexpr bool    isnan() const noexcept { return _bits == nan_encoding; }
+	constexpr int     exponent() const noexcept { return int(_bits) - bias; }
+	constexpr uint8_t bits() const noexcept { return _bits; }
+	constexpr void    setbits(uint64_t raw) noexcept { _bits = uint8_t(raw); }
+
+	explicit operator double() const noexcept { return isnan() ? std::numeric_limits<double>::quiet_NaN() : std::ldexp(1.0, exponent()); }
+
+private:
+	uint8_t _bits;
+};
+
+inline std::string type_tag(const e8m0&) { return "e8m0"; }
+
+///////////////////////////////////////////////////////////////////////////
+// element formats of the OCP MX specification
+//   a minifloat with fbits fraction bits and an exponent bias, whose largest finite encoding is maxcode,
+//   or an integer with an implicit scale of 2^-fbits
+
+struct mx_e4m3 {
+	static constexpr const char* name = "mxfp8_e4m3";
+	static constexpr unsigned nbits = 8, fbits = 3;
+	static constexpr int      bias = 7;
+	static constexpr bool     integer = false;
+	static constexpr uint32_t maxcode = 0x7E;   // 448: S.1111.111 is NaN, and there are no infinities
+	static constexpr bool     hasInf = false;
+	static constexpr uint32_t infcode = 0;
+};
+struct mx_e5m2 {
+	static constexpr const char* name = "mxfp8_e5m2";
+	static constexpr unsigned nbits = 8, fbits = 2;
+	static constexpr int      bias = 15;
+	static constexpr bool     integer = false;
+	static constexpr uint32_t maxcode = 0x7B;   // 57344: the exponent 11111 encodes infinity and NaN
+	static constexpr bool     hasInf = true;
+	static constexpr uint32_t infcode = 0x7C;
+};
+struct mx_e3m2 {
+	static constexpr const char* name = "mxfp6_e3m2";
+	static constexpr unsigned nbits = 6, fbits = 2;
+	static constexpr int      bias = 3;
+	static constexpr bool     integer = false;
+	static constexpr uint32_t maxcode = 0x1F;   // 28
+	static constexpr bool     hasInf = false;
+	static constexpr uint32_t infcode = 0;
+};
+struct mx_e2m3 {
+	static constexpr const char* name = "mxfp6_e2m3";
+	static constexpr unsigned nbits = 6, fbits = 3;
+	static constexpr int      bias = 1;
+	static constexpr bool     integer = false;
+	static constexpr uint32_t maxcode = 0x1F;   // 7.5
+	static constexpr bool     hasInf = false;
+	static constexpr uint32_t infcode = 0;
+};
+struct mx_e2m1 {
+	static constexpr const char* name = "mxfp4_e2m1";
+	static constexpr unsigned nbits = 4, fbits = 1;
+	static constexpr int      bias = 1;
+	static constexpr bool     integer = false;
+	static constexpr uint32_t maxcode = 0x7;    // 6
+	static constexpr bool     hasInf = false;
+	static constexpr uint32_t infcode = 0;
+};
+struct mx_int8 {
+	static constexpr const char* name = "mxint8";
+	static constexpr unsigned nbits = 8, fbits = 6;
+	static constexpr int      bias = 0;
+	static constexpr bool     integer = true;
+	static constexpr uint32_t maxcode = 0x7F;   // 127/64: quantization saturates symmetrically to +-127
+	static constexpr bool     hasInf = false;
+	static constexpr uint32_t infcode = 0;
+};
+
+namespace detail {
+	// 2^k for k in the normal exponent range of double
+	inline double mx_pow2(int k) noexcept {
+		uint64_t u = uint64_t(1023 + k) << 52;
+		double p;
+		std::memcpy(&p, &u, sizeof(p));
+		return p;
+	}
+
+	// round a non-negative y < 2^52 to the nearest integer, ties to even, in the rounding mode of the FPU
+	inline double mx_round_even(double y) noexcept {
+		constexpr double magic = 0x1p52;
+		return (y + magic) - magic;
+	}
+
+	template<int64_t max>
+	using mx_integer_t = std::conditional_t<(max <= INT8_MAX), int8_t, std::conditional_t<(max <= INT16_MAX), int16_t, std::conditional_t<(max <= INT32_MAX), int32_t, double>>>;
+}
+
+// encoding and decoding of an MX element format
+template<typename Element>
+class mx_element {
+public:
+	static constexpr unsigned nbits = Element::nbits;
+	static constexpr size_t   nrEncodings = size_t(1) << nbits;
+	static constexpr uint32_t mask = uint32_t(nrEncodings - 1);
+	static constexpr uint32_t signbit = uint32_t(1) << (nbits - 1);
+	static constexpr uint32_t fmask = (uint32_t(1) << Element::fbits) - 1;
+	// exponent of the smallest normal binade
+	static constexpr int emin = 1 - Element::bias;
+	// exponent of the largest binade, which the shared exponent of a block aligns with the largest magnitude of the block
+	static constexpr int emax = (Element::integer ? int(nbits) - 2 - int(Element::fbits) : int(Element::maxcode >> Element::fbits) - Element::bias);
+	// element values are integer multiples of 2^unit_exponent
+	static constexpr int unit_exponent = (Element::integer ? -int(Element::fbits) : emin - int(Element::fbits));
+	// largest magnitude in units of 2^unit_exponent
+	static constexpr int64_t maxint = (Element::integer || (Element::maxcode >> Element::fbits) == 0
+		? int64_t(Element::maxcode)
+		: int64_t((fmask + 1) | (Element::maxcode & fmask)) << ((Element::maxcode >> Element::fbits) - 1));
+	// the smallest type that holds the element values in units of 2^unit_exponent, or double when an integer does not
+	using integer_type = detail::mx_integer_t<maxint>;
+
+	// value of the encoding
+	double value(uint32_t code) const noexcept { return _value[code & mask]; }
+	// value of the encoding in units of 2^unit_exponent, 0 for infinity and NaN
+	integer_type integer(uint32_t code) const noexcept { return _integer[code & mask]; }
+	// largest finite value
+	static constexpr double maxvalue() noexcept { return double(maxint) * (unit_exponent < 0 ? 1.0 / double(int64_t(1) << -unit_exponent) : double(int64_t(1) << unit_exponent)); }
+
+	// encoding of v rounded to nearest even and saturated to the largest finite value: v is finite
+	static uint32_t encode(double v) noexcept {
+		uint64_t u;
+		std::memcpy(&u, &v, sizeof(u));
+		uint32_t sign = static_cast<uint32_t>(u >> 63);
+		double a = std::abs(v);
+		uint32_t code;
+		if (a >= maxvalue()) {
+			code = Element::maxcode;
+		}
+		else if constexpr (Element::integer) {
+			code = uint32_t(detail::mx_round_even(a * detail::mx_pow2(int(Element::fbits))));
+		}
+		else {
+			// the binade of the result, with the subnormals in the binade of emin
+			int scale = std::max(int((u >> 52) & 0x7FF) - 1023, emin);
+			// significand in units of the lsb of the binade: the carry of a round up increments the exponent field
+			double q = detail::mx_round_even(a * detail::mx_pow2(int(Element::fbits) - scale));
+			code = std::min((uint32_t(scale - emin) << Element::fbits) + uint32_t(q), Element::maxcode);
+		}
+		if constexpr (Element::integer) return (sign ? (0u - code) & mask : code);
+		else return code | (sign ? signbit : 0u);
+	}
+
+	// the tables of a format are generated on first use and shared by all threads
+	static const mx_element& instance() {
+		static const mx_element e;
+		return e;
+	}
+
+private:
+	std::array<double, nrEncodings>       _value;
+	std::array<integer_type, nrEncodings> _integer;
+
+	mx_element() {
+		constexpr double unit = (unit_exponent < 0 ? 1.0 / double(int64_t(1) << -unit_exponent) : double(int64_t(1) << unit_exponent));
+		for (uint32_t code = 0; code < nrEncodings; ++code) {
+			int64_t magnitude{ 0 };
+			bool negative{ false }, finite{ true };
+			if constexpr (Element::integer) {
+				magnitude = (code & signbit ? int64_t(code) - int64_t(nrEncodings) : int64_t(code));
+				if (magnitude < 0) { negative = true; magnitude = -magnitude; }
+			}
+			else {
+				negative = (code & signbit) != 0;
+				uint32_t m = code & ~signbit;
+				uint32_t field = m >> Element::fbits;
+				magnitude = (field == 0 ? int64_t(m & fmask) : int64_t((fmask + 1) | (m & fmask)) << (field - 1));
+				finite = (m <= Element::maxcode);
+				if (!finite) {
+					double special = (Element::hasInf && m == Element::infcode ? std::numeric_limits<double>::infinity() : std::numeric_limits<double>::quiet_NaN());
+					_value[code] = (negative ? -special : special);
+					_integer[code] = integer_type(0);
+					continue;
+				}
+			}
+			_value[code] = (negative ? -1.0 : 1.0) * double(magnitude) * unit;
+			_integer[code] = integer_type(negative ? -magnitude : magnitude);
+		}
+	}
+};
+
+///////////////////////////////////////////////////////////////////////////
+// an MX format: an element format and the number of elements that share a scale
+template<typename Element, unsigned _blockSize = 32>
+struct mx_format {
+	using element = Element;
+	static constexpr unsigned blockSize = _blockSize;
+	// bytes of the packed elements of a block
+	static constexpr size_t   blockBytes = (size_t(blockSize) * Element::nbits + 7) / 8;
+};
+
+using mxfp8_e4m3 = mx_format<mx_e4m3>;
+using mxfp8_e5m2 = mx_format<mx_e5m2>;
+using mxfp6_e3m2 = mx_format<mx_e3m2>;
+using mxfp6_e2m3 = mx_format<mx_e2m3>;
+using mxfp4      = mx_format<mx_e2m1>;
+using mxint8     = mx_format<mx_int8>;
+
+template<typename Element, unsigned blockSize>
+std::string type_tag(const mx_format<Element, blockSize>&) {
+	return std::string(Element::name) + (blockSize == 32 ? std::string() : std::string("<") + std::to_string(blockSize) + '>');
+}
+
+// a block of an MX format: the shared scale and the elements, packed back to back at Element::nbits bits per element
+template<typename Format>
+struct mx_block {
+	using element = typename Format::element;
+	using packing = bit_packing<element::nbits>;
+	static constexpr unsigned nbits = element::nbits;
+	static constexpr unsigned blockSize = Format::blockSize;
+	static constexpr uint32_t mask = packing::mask;
+
+	e8m0                                    scale;
+	std::array<uint8_t, Format::blockBytes> codes{};
+
+	uint32_t code(unsigned i) const noexcept { return packing::get(codes.data(), i); }
+
+	// f(i, code) for each element in order
+	template<typename Function>
+	void for_each_code(Function&& f) const {
+		packing::unpack(codes.data(), 0, blockSize, [&](size_t i, uint32_t code) { f(unsigned(i), code); });
+	}
+
+	// pack the encodings of all elements
+	void pack(const uint32_t* c) noexcept { packing::pack(codes.data(), 0, blockSize, c); }
+};
+
+// round x[0, n) into a block, n <= blockSize: the elements past n are zero
+template<typename Format>
+void quantize(const double* x, size_t n, mx_block<Format>& block) noexcept {
+	using Element = typename Format::element;
+	using codec = mx_element<Element>;
+	constexpr unsigned blockSize = Format::blockSize;
+	double amax{ 0 };
+	bool finite{ true };
+	for (size_t i = 0; i < n; ++i) {
+		finite &= std::isfinite(x[i]);
+		amax = std::max(amax, std::abs(x[i]));
+	}
+	uint32_t c[blockSize] = {};
+	if (!finite) {
+		block.scale = e8m0::nan();
+		block.pack(c);
+		return;
+	}
+	int shared{ 0 };
+	if (amax > 0.0) {
+		uint64_t u;
+		std::memcpy(&u, &amax, sizeof(u));
+		int exponent = ((u >> 52) == 0 ? std::ilogb(amax) : int(u >> 52) - 1023);
+		shared = std::clamp(exponent - codec::emax, e8m0::min_exponent, e8m0::max_exponent);
+	}
+	block.scale = e8m0(shared);
+	double inverse = detail::mx_pow2(-shared);
+	for (size_t i = 0; i < n; ++i) c[i] = codec::encode(x[i] * inverse);
+	block.pack(c);
+}
+
+// values of the first n elements of a block
+template<typename Format>
+void dequantize(const mx_block<Format>& block, double* y, size_t n) noexcept {
+	const mx_element<typename Format::element>& codec = mx_element<typename Format::element>::instance();
+	double scale = double(block.scale);
+	if (n == Format::blockSize) {
+		block.for_each_code([&](unsigned i, uint32_t code) { y[i] = codec.value(code) * scale; });
+	}
+	else {
+		for (size_t i = 0; i < n; ++i) y[i] = codec.value(block.code(unsigned(i))) * scale;
+	}
+}
+
+namespace detail {
+	// the accumulator of a block dot product of two element formats: an integer that cannot overflow, or double
+	template<typename EA, typename EB, unsigned blockSize>
+	struct mx_accumulator {
+		static constexpr int64_t maxA = mx_element<EA>::maxint, maxB = mx_element<EB>::maxint;
+		static constexpr bool integral = std::is_integral_v<typename mx_element<EA>::integer_type> && std::is_integral_v<typename mx_element<EB>::integer_type>;
+		static constexpr bool fits32 = integral && maxA <= INT32_MAX / maxB / int64_t(blockSize);
+		static constexpr bool fits64 = integral && maxA <= INT64_MAX / maxB / int64_t(blockSize);
+		using type = std::conditional_t<fits32, int32_t, std::conditional_t<fits64, int64_t, double>>;
+	};
+
+	// unpacked block: the elements in units of 2^unit_exponent and the shared exponent, or INT_MIN for a NaN scale
+	constexpr int MX_NAN_EXPONENT = std::numeric_limits<int>::min();
+
+	template<typename Format>
+	int unpack(const mx_block<Format>& block, typename mx_element<typename Format::element>::integer_type* elements) noexcept {
+		const auto& codec = mx_element<typename Format::element>::instance();
+		block.for_each_code([&](unsigned i, uint32_t code) { elements[i] = codec.integer(code); });
+		return (block.scale.isnan() ? MX_NAN_EXPONENT : block.scale.exponent());
+	}
+
+	template<typename Accumulator, unsigned blockSize, typename TA, typename TB>
+	Accumulator block_dot(const TA* a, const TB* b) noexcept {
+		Accumulator s0(0), s1(0);
+		for (unsigned k = 0; k < blockSize; k += 2) {
+			s0 += Accumulator(a[k]) * Accumulator(b[k]);
+			s1 += Accumulator(a[k + 1]) * Accumulator(b[k + 1]);
+		}
+		return s0 + s1;
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////
+// MX vector: a vector of values quantized in blocks of Format::blockSize consecutive elements
+template<typename Format>
+class mx_vector {
+public:
+	using format     = Format;
+	using block_type = mx_block<Format>;
+	static constexpr unsigned blockSize = Format::blockSize;
+
+	mx_vector() : _size{ 0 } {}
+	explicit mx_vector(size_t n) : _size{ n }, _blocks((n + blockSize - 1) / blockSize) {}
+	template<typename Vector>
+	explicit mx_vector(const Vector& v, unsigned nrThreads = 0) : mx_vector(v.size()) { quantize(v, nrThreads); }
+
+	// quantize the values of v, which has size() elements
+	template<typename Vector>
+	void quantize(const Vector& v, unsigned nrThreads = 0) {
+		if (size_t(v.size()) != _size) throw blas::blas_exception("mx_vector quantize: size of the source does not match");
+		parallel_for(0, _blocks.size(), [&](size_t first, size_t last, unsigned) {
+			double x[blockSize];
+			for (size_t b = first; b < last; ++b) {
+				size_t offset = b * blockSize, n = std::min(size_t(blockSize), _size - offset);
+				for (size_t i = 0; i < n; ++i) x[i] = double(v[offset + i]);
+				sw::universal::quantize(x, n, _blocks[b]);
+			}
+		}, blas::blas_threads(_size, nrThreads));
+	}
+
+	// the values of the vector
+	template<typename Vector>
+	void dequantize(Vector& v) const {
+		double y[blockSize];
+		for (size_t b = 0; b < _blocks.size(); ++b) {
+			size_t offset = b * blockSize, n = std::min(size_t(blockSize), _size - offset);
+			sw::universal::dequantize(_blocks[b], y, n);
+			for (size_t i = 0; i < n; ++i) v[offset + i] = typename Vector::value_type(y[i]);
+		}
+	}
+
+	double operator[](size_t i) const noexcept {
+		const block_type& b = _blocks[i / blockSize];
+		return mx_element<typename Format::element>::instance().value(b.code(unsigned(i % blockSize))) * double(b.scale);
+	}
+
+	size_t            size() const noexcept { return _size; }
+	size_t            blocks() const noexcept { return _blocks.size(); }
+	const block_type& block(size_t b) const noexcept { return _blocks[b]; }
+	block_type&       block(size_t b) noexcept { return _blocks[b]; }
+	// storage of the scales and the packed elements
+	size_t            bytes() const noexcept { return _blocks.size() * (1 + Format::blockBytes); }
+
+private:
+	size_t                  _size;
+	std::vector<block_type> _blocks;
+};
+
+// blocks of an MX matrix run along its rows, or down its columns
+enum class mx_axis { rows, columns };
+
+///////////////////////////////////////////////////////////////////////////
+// MX matrix: a matrix quantized in blocks along one axis. The left operand of a product is blocked along its
+// rows and the right operand down its columns, so that both are blocked along the reduction dimension.
+template<typename Format>
+class mx_matrix {
+public:
+	using format     = Format;
+	using block_type = mx_block<Format>;
+	static constexpr unsigned blockSize = Format::blockSize;
+
+	mx_matrix() : _m{ 0 }, _n{ 0 }, _axis{ mx_axis::rows }, _lineBlocks{ 0 } {}
+	mx_matrix(size_t m, size_t n, mx_axis axis = mx_axis::rows)
+		: _m{ m }, _n{ n }, _axis{ axis }, _lineBlocks{ (length() + blockSize - 1) / blockSize }, _blocks(lines() * _lineBlocks) {}
+	template<typename Matrix>
+	explicit mx_matrix(const Matrix& A, mx_axis axis = mx_axis::rows, unsigned nrThreads = 0) : mx_matrix(A.rows(), A.cols(), axis) { quantize(A, nrThreads); }
+
+	// quantize the values of A, which has rows() x cols() elements
+	template<typename Matrix>
+	void quantize(const Matrix& A, unsigned nrThreads = 0) {
+		if (size_t(A.rows()) != _m || size_t(A.cols()) != _n) throw blas::matmul_incompatible_matrices("mx_matrix quantize: shape of the source does not match");
+		const size_t L = length();
+		parallel_for(0, lines(), [&](size_t first, size_t last, unsigned) {
+			double x[blockSize];
+			for (size_t line = first; line < last; ++line) {
+				for (size_t b = 0; b < _lineBlocks; ++b) {
+					size_t offset = b * blockSize, n = std::min(size_t(blockSize), L - offset);
+					for (size_t k = 0; k < n; ++k) x[k] = double(_axis == mx_axis::rows ? A(line, offset + k) : A(offset + k, line));
+					sw::universal::quantize(x, n, _blocks[line * _lineBlocks + b]);
+				}
+			}
+		}, blas::blas_threads(_m * _n, nrThreads));
+	}
+
+	// the values of the matrix
+	template<typename Real>
+	void dequantize(blas::matrix<Real>& A) const {
+		A.resize(_m, _n);
+		const size_t L = length();
+		double y[blockSize];
+		for (size_t line = 0; line < lines(); ++line) {
+			for (size_t b = 0; b < _lineBlocks; ++b) {
+				size_t offset = b * blockSize, n = std::min(size_t(blockSize), L - offset);
+				sw::universal::dequantize(_blocks[line * _lineBlocks + b], y, n);
+				for (size_t k = 0; k < n; ++k) {
+					if (_axis == mx_axis::rows) A(line, offset + k) = Real(y[k]); else A(offset + k, line) = Real(y[k]);
+				}
+			}
+		}
+	}
+
+	double operator()(size_t i, size_t j) const noexcept {
+		size_t line = (_axis == mx_axis::rows ? i : j), k = (_axis == mx_axis::rows ? j : i);
+		const block_type& b = _blocks[line * _lineBlocks + k / blockSize];
+		return mx_element<typename Format::element>::instance().value(b.code(unsigned(k % blockSize))) * double(b.scale);
+	}
+
+	size_t            rows() const noexcept { return _m; }
+	size_t            cols() const noexcept { return _n; }
+	mx_axis           axis() const noexcept { return _axis; }
+	// the rows of a matrix blocked along its rows, or the columns of a matrix blocked down its columns
+	size_t            lines() const noexcept { return (_axis == mx_axis::rows ? _m : _n); }
+	size_t            length() const noexcept { return (_axis == mx_axis::rows ? _n : _m); }
+	size_t            blocksPerLine() const noexcept { return _lineBlocks; }
+	const block_type& block(size_t line, size_t b) const noexcept { return _blocks[line * _lineBlocks + b]; }
+	size_t            bytes() const noexcept { return _blocks.size() * (1 + Format::blockBytes); }
+
+private:
+	size_t                  _m, _n;
+	mx_axis                 _axis;
+	size_t                  _lineBlocks;
+	std::vector<block_type> _blocks;
+};
+
+///////////////////////////////////////////////////////////////////////////
+// block-scaled kernels
+
+// dot product of two MX vectors of the same block size: integer block dot products scaled by the block scales
+template<typename FA, typename FB>
+double dot(const mx_vector<FA>& a, const mx_vector<FB>& b) {
+	static_assert(FA::blockSize == FB::blockSize, "dot: MX vectors must share the block size");
+	using EA = typename FA::element;
+	using EB = typename FB::element;
+	using Accumulator = typename detail::mx_accumulator<EA, EB, FA::blockSize>::type;
+	constexpr int unit = mx_element<EA>::unit_exponent + mx_element<EB>::unit_exponent;
+	if (a.size() != b.size()) throw blas::blas_exception("mx dot: vectors of different size");
+	typename mx_element<EA>::integer_type x[FA::blockSize];
+	typename mx_element<EB>::integer_type y[FB::blockSize];
+	double sum{ 0 };
+	for (size_t blk = 0; blk < a.blocks(); ++blk) {
+		int ea = detail::unpack(a.block(blk), x);
+		int eb = detail::unpack(b.block(blk), y);
+		if (ea == detail::MX_NAN_EXPONENT || eb == detail::MX_NAN_EXPONENT) return std::numeric_limits<double>::quiet_NaN();
+		sum += double(detail::block_dot<Accumulator, FA::blockSize>(x, y)) * detail::mx_pow2(ea + eb + unit);
+	}
+	return sum;
+}
+
+/// <summary>
+/// C = A * B of an A blocked along its rows and a B blocked down its columns. B is unpacked once into its
+/// element integers, the rows of A four at a time, and each block of B is reused for the four rows while
+/// it is in registers. Rows of C are distributed over the threads, and each element of C accumulates its
+/// block products in block order, so the result is the same for any number of threads.
+/// </summary>
+/// <param name="A">M x K matrix, blocked along its rows</param>
+/// <param name="B">K x N matrix, blocked down its columns</param>
+/// <param name="nrThreads">number of threads, 0 for all hardware threads</param>
+/// <returns>M x N matrix of the products</returns>
+template<typename Real = float, typename FA, typename FB>
+blas::matrix<Real> gemm(const mx_matrix<FA>& A, const mx_matrix<FB>& B, unsigned nrThreads = 0) {
+	static_assert(FA::blockSize == FB::blockSize, "gemm: MX matrices must share the block size");
+	using EA = typename FA::element;
+	using EB = typename FB::element;
+	using TA = typename mx_element<EA>::integer_type;
+	using TB = typename mx_element<EB>::integer_type;
+	using Accumulator = typename detail::mx_accumulator<EA, EB, FA::blockSize>::type;
+	constexpr unsigned blockSize = FA::blockSize;
+	constexpr int unit = mx_element<EA>::unit_exponent + mx_element<EB>::unit_exponent;
+	constexpr size_t MR = 4;
+	if (A.axis() != mx_axis::rows || B.axis() != mx_axis::columns) throw blas::matmul_incompatible_matrices("mx gemm: A must be blocked along its rows and B down its columns");
+	if (A.cols() != B.rows()) throw blas::matmul_incompatible_matrices("mx gemm: columns of A do not match the rows of B");
+	const size_t M = A.rows(), N = B.cols(), nrBlocks = A.blocksPerLine(), Kp = nrBlocks * blockSize;
+	blas::matrix<Real> C(M, N);
+	if (M == 0 || N == 0) return C;
+
+	std::vector<TB>  b(N * Kp);
+	std::vector<int> eb(N * nrBlocks);
+	for (size_t j = 0; j < N; ++j) {
+		for (size_t blk = 0; blk < nrBlocks; ++blk) eb[j * nrBlocks + blk] = detail::unpack(B.block(j, blk), b.data() + j * Kp + blk * blockSize);
+	}
+
+	const size_t panels = (M + MR - 1) / MR;
+	parallel_for(0, panels, [&](size_t firstPanel, size_t lastPanel, unsigned) {
+		std::vector<TA>  a(MR * Kp, TA(0));
+		std::vector<int> ea(MR * nrBlocks, 0);
+		for (size_t panel = firstPanel; panel < lastPanel; ++panel) {
+			size_t i0 = panel * MR, rows = std::min(MR, M - i0);
+			for (size_t r = 0; r < rows; ++r) {
+				for (size_t blk = 0; blk < nrBlocks; ++blk) ea[r * nrBlocks + blk] = detail::unpack(A.block(i0 + r, blk), a.data() + r * Kp + blk * blockSize);
+			}
+			for (size_t j = 0; j < N; ++j) {
+				const TB* bj = b.data() + j * Kp;
+				const int* ebj = eb.data() + j * nrBlocks;
+				double sum[MR] = {};
+				bool nan[MR] = {};
+				for (size_t blk = 0; blk < nrBlocks; ++blk) {
+					const TB* y = bj + blk * blockSize;
+					for (size_t r = 0; r < MR; ++r) {
+						const TA* x = a.data() + r * Kp + blk * blockSize;
+						int e = ea[r * nrBlocks + blk];
+						if (e == detail::MX_NAN_EXPONENT || ebj[blk] == detail::MX_NAN_EXPONENT) { nan[r] = true; continue; }
+						sum[r] += double(detail::block_dot<Accumulator, blockSize>(x, y)) * detail::mx_pow2(e + ebj[blk] + unit);
+					}
+				}
+				for (size_t r = 0; r < rows; ++r) C(i0 + r, j) = Real(nan[r] ? std::numeric_limits<double>::quiet_NaN() : sum[r]);
+			}
+		}
+	}, blas::blas_threads(M * N, nrThreads));
+	return C;
+}
+
+///////////////////////////////////////////////////////////////////////////
+// quantizer of an MX format: an MX format rounds a block of values at a time, so it has no rounding of
+// a single double. The quantization sweep rounds the values of a tile in blocks that start at the tile.
+template<typename Element, unsigned _blockSize>
+class quantizer<mx_format<Element, _blockSize>> {
+public:
+	using format = mx_format<Element, _blockSize>;
+	static constexpr size_t blockSize = _blockSize;
+
+	// q[i] = value of x[i] rounded in the blocks of x[0, n)
+	void operator()(const double* x, double* q, size_t n) const noexcept {
+		mx_block<format> block;
+		for (size_t offset = 0; offset < n; offset += blockSize) {
+			size_t m = std::min(blockSize, n - offset);
+			quantize(x + offset, m, block);
+			dequantize(block, q + offset, m);
+		}
+	}
+
+	bool tabulated() const noexcept { return true; }
+
+	static const quantizer& instance() {
+		static const quantizer q;
+		return q;
+	}
+};
+
+}} // namespace sw::universal
@@ -1,11 +1,19 @@
+#pragma once
 // qsnr.hpp: Quantization Signal to Noise ratio for a sampling
 //
 // Copyright (C) 2023-2023 Stillwater Supercomputing, Inc.
 //
 // This file is part of the universal numbers project, which is released under an MIT Open Source license.
-
+#include <array>
+#include <cmath>
+#include <iomanip>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
 #include <universal/blas/blas.hpp>
 #include <universal/blas/statistics.hpp>
+#include <universal/quantization/quantizer.hpp>
 
 namespace sw { namespace universal {
 
@@ -21,11 +29,11 @@ namespace sw { namespace universal {
 		// std::cout << type_tag(Scalar()) << " : " << symmetry_range<Scalar>() << '\n';
 		size_t N = size(v);
 
-		blas::SummaryStats<double> stats = blas::summaryStatistics(v);
-		auto stddev = stats.stddev;
-
+		// signal moments and quantization noise in a single pass over the data
+		blas::moments<double> signal;
 		double sum = 0.0;
 		for (auto number : v) {
+			signal.push(number);
 			double quantized = double(Scalar(number)); // Quantize to Scalar
 			double error = number - quantized;
 			// std::cout << number << " : " << quantized << " : " << error << '\n';
@@ -33,11 +41,178 @@ namespace sw { namespace universal {
 		}
 
 		double noise_power = sum / N;
-		double signal_power = stddev * stddev;
+		double signal_power = signal.variance();
 		double SNR = 10 * log10(signal_power / noise_power);
 
 		return SNR;
 	}
 
-} } // namespace sw::universal
+	///////////////////////////////////////////////////////////////////////////
+	// quantization sweep: the quantization error of a data set for a list of target formats
+
+	// a list of target formats: using fp8_formats = format_list<fp8e4m3, fp8e5m2, posit<8,2>>;
+	template<typename... Targets>
+	struct format_list {
+		static constexpr size_t size = sizeof...(Targets);
+	};
+
+	// the source is read in tiles of this many values, which every target quantizes while the tile is in cache
+	constexpr size_t QSNR_SWEEP_TILE = 16 * 1024;
+
+	// quantization error of a data set for one target format
+	struct quantization_report {
+		quantization_report() : count{ 0 }, signal_power{ 0 }, noise_power{ 0 }, qsnr{ 0 }, max_error{ 0 }, zeros{ 0 }, overflows{ 0 }, error_histogram(-1074, 1023) {}
+
+		std::string           format;
+		uint64_t              count;           // values quantized to a finite value
+		double                signal_power;    // sample variance of the data
+		double                noise_power;     // mean squared quantization error
+		double                qsnr;            // signal to quantization noise ratio in dB
+		double                max_error;       // largest absolute quantization error
+		uint64_t              zeros;           // nonzero values that quantize to zero
+		uint64_t              overflows;       // values that quantize to infinity or NaN, excluded from the noise power
+		blas::scale_histogram error_histogram; // binades of the quantization errors x - q(x), by sign
+	};
 
+	inline std::ostream& operator<<(std::ostream& ostr, const quantization_report& r) {
+		return ostr << std::setw(60) << std::left << r.format << std::right
+			<< " QSNR " << std::setw(8) << std::fixed << std::setprecision(3) << r.qsnr << " dB"
+			<< "  max error " << std::setw(12) << std::scientific << std::setprecision(4) << r.max_error << std::defaultfloat
+			<< "  zeros " << std::setw(8) << r.zeros << "  overflows " << std::setw(8) << r.overflows;
+	}
+
+	namespace detail {
+
+		// error sums of one target over the tiles of one thread
+		struct quantization_error {
+			quantization_error() : count{ 0 }, noise{ 0 }, max_error{ 0 }, zeros{ 0 }, overflows{ 0 }, histogram(-1074, 1023) {}
+
+			uint64_t              count;
+			double                noise;
+			double                max_error;
+			uint64_t              zeros;
+			uint64_t              overflows;
+			blas::scale_histogram histogram;
+
+			void merge(const quantization_error& rhs) {
+				count += rhs.count;
+				noise += rhs.noise;
+				max_error = std::max(max_error, rhs.max_error);
+				zeros += rhs.zeros;
+				overflows += rhs.overflows;
+				histogram.merge(rhs.histogram);
+			}
+		};
+
+		template<typename Target, typename Vector>
+		void quantize_tile(const Vector& data, size_t first, size_t last, quantization_error& error) {
+			const quantizer<Target>& q = quantizer<Target>::instance();
+			// sums in locals, which the stores into the histogram cannot alias
+			double noise{ 0 }, maxError{ error.max_error };
+			uint64_t count{ 0 }, zeros{ 0 }, overflows{ 0 };
+			auto tally = [&](double x, double quantized) {
+				if (std::isnan(x)) return;
+				if (!std::isfinite(quantized)) { ++overflows; return; }
+				double e = x - quantized;
+				noise += e * e;
+				maxError = std::max(maxError, std::abs(e));
+				zeros += static_cast<uint64_t>((quantized == 0.0) & (x != 0.0));
+				error.histogram.push(e);
+				++count;
+			};
+			if constexpr (BlockQuantization<quantizer<Target>>) {
+				// a block-scaled target rounds the tile in blocks that start at the start of the tile
+				constexpr size_t blockSize = quantizer<Target>::blockSize;
+				double x[blockSize], quantized[blockSize];
+				for (size_t i = first; i < last; i += blockSize) {
+					size_t n = std::min(blockSize, last - i);
+					for (size_t k = 0; k < n; ++k) x[k] = double(data[i + k]);
+					q(x, quantized, n);
+					for (size_t k = 0; k < n; ++k) tally(x[k], quantized[k]);
+				}
+			}
+			else {
+				for (size_t i = first; i < last; ++i) {
+					double x = double(data[i]);
+					tally(x, (std::isnan(x) ? x : q(x)));
+				}
+			}
+			error.count += count;
+			error.noise += noise;
+			error.max_error = maxError;
+			error.zeros += zeros;
+			error.overflows += overflows;
+		}
+
+		template<typename... Targets, typename Vector, size_t... I>
+		std::vector<quantization_report> qsnr_sweep(const Vector& data, unsigned nrThreads, size_t tileSize, std::index_sequence<I...>) {
+			constexpr size_t nrTargets = sizeof...(Targets);
+			// generate the quantizers before the threads start
+			(quantizer<Targets>::instance(), ...);
+
+			struct partial {
+				blas::moments<double>                        signal;
+				std::array<quantization_error, nrTargets>    error;
+			};
+			size_t N = size(data);
+			if (tileSize == 0) tileSize = QSNR_SWEEP_TILE;
+			size_t nrTiles = (N + tileSize - 1) / tileSize;
+			unsigned threads = blas::blas_threads(N, nrThreads);
+			if (threads > nrTiles) threads = static_cast<unsigned>(nrTiles == 0 ? 1 : nrTiles);
+			std::vector<partial> partials(threads);
+			parallel_for(0, nrTiles, [&](size_t firstTile, size_t lastTile, unsigned t) {
+				partial& p = partials[t];
+				for (size_t tile = firstTile; tile < lastTile; ++tile) {
+					size_t first = tile * tileSize;
+					size_t last = std::min(N, first + tileSize);
+					for (size_t i = first; i < last; ++i) p.signal.push(double(data[i]));
+					(quantize_tile<Targets>(data, first, last, p.error[I]), ...);
+				}
+			}, threads);
+			// combine the partial results in thread order
+			for (unsigned t = 1; t < threads; ++t) {
+				partials[0].signal.merge(partials[t].signal);
+				for (size_t k = 0; k < nrTargets; ++k) partials[0].error[k].merge(partials[t].error[k]);
+			}
+
+			const partial& total = partials[0];
+			std::array<std::string, nrTargets> formats = { type_tag(Targets())... };
+			std::vector<quantization_report> reports(nrTargets);
+			for (size_t k = 0; k < nrTargets; ++k) {
+				quantization_report& r = reports[k];
+				const quantization_error& e = total.error[k];
+				r.format = formats[k];
+				r.count = e.count;
+				r.signal_power = total.signal.variance();
+				r.noise_power = (e.count > 0 ? e.noise / double(e.count) : 0.0);
+				r.qsnr = 10.0 * std::log10(r.signal_power / r.noise_power);
+				r.max_error = e.max_error;
+				r.zeros = e.zeros;
+				r.overflows = e.overflows;
+				r.error_histogram = e.histogram;
+			}
+			return reports;
+		}
+
+	} // namespace detail
+
+	/// <summary>
+	/// quantization error of a data set for a list of target formats in a single pass over the data:
+	/// the data is read once, in tiles that each target quantizes while the tile is in cache, and the
+	/// tiles are distributed over the threads
+	/// </summary>
+	/// <param name="data">data set to quantize</param>
+	/// <param name="nrThreads">number of threads, 0 for all hardware threads</param>
+	/// <param name="tileSize">number of values in a tile</param>
+	/// <returns>a quantization report per target, in the order of the format list</returns>
+	template<typename... Targets, typename Vector>
+	std::vector<quantization_report> qsnr_sweep(format_list<Targets...>, const Vector& data, unsigned nrThreads = 0, size_t tileSize = QSNR_SWEEP_TILE) {
+		return detail::qsnr_sweep<Targets...>(data, nrThreads, tileSize, std::index_sequence_for<Targets...>{});
+	}
+
+	template<typename... Targets, typename Vector>
+	std::vector<quantization_report> qsnr_sweep(const Vector& data, unsigned nrThreads = 0, size_t tileSize = QSNR_SWEEP_TILE) {
+		return detail::qsnr_sweep<Targets...>(data, nrThreads, tileSize, std::index_sequence_for<Targets...>{});
+	}
+
+} } // namespace sw::universal
@@ -0,0 +1,167 @@
+#pragma once
+// quantizer.hpp: table-driven rounding of double to a small number system
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <utility>
+#include <vector>
+#include <universal/number/shared/encoding_table.hpp>
+
+namespace sw { namespace universal {
+
+/*
+ * A quantizer rounds a double to a target number system and returns the value of the result as a double,
+ * which is the inner loop of a quantization error study. For a target of at most 16 bits, the rounding
+ * boundaries of the target's conversion from double are tabulated with an encoding_table, and a second
+ * table indexed by the sign, exponent, and leading four fraction bits of the input narrows the search to
+ * the few boundaries within that sixteenth of a binade. Rounding then costs two loads and a short search,
+ * whatever the cost of the arithmetic conversion of the target. Inputs outside of the finite range of
+ * the target, and NaN, take the arithmetic conversion, which owns saturation, wrap around, and infinities.
+ * The table presumes a conversion that rounds monotonically: a target whose conversion does not round
+ * each boundary, its predecessor, and each value as tabulated, quantizes through its arithmetic conversion.
+ */
+
+// a target whose encodings can be enumerated and tabulated
+template<typename Target>
+concept TabulatedQuantization = requires(Target t) {
+	{ Target::nbits } -> std::convertible_to<unsigned>;
+	t.setbits(uint64_t(0));
+} && (Target::nbits <= max_encoding_table_nbits);
+
+template<typename Target>
+class quantizer {
+public:
+	quantizer() {
+		if constexpr (TabulatedQuantization<Target>) build();
+	}
+
+	// the double value of Target(x)
+	double operator()(double x) const {
+		if constexpr (TabulatedQuantization<Target>) {
+			if (x >= _low && x <= _high) {
+				size_t k = _first[static_cast<size_t>((key(x) >> BUCKET_SHIFT) - _firstBucket)];
+				if (_steps <= MAX_LINEAR_STEPS) {
+					// a fixed number of branchless steps over the boundaries of the bucket, padded with infinity
+					for (unsigned s = 0; s < _steps; ++s) k += static_cast<size_t>(_bound[k + 1] <= x);
+				}
+				else {
+					const double* base = _bound.data() + k;
+					size_t n = _steps + 1;
+					while (n > 1) {
+						size_t half = n >> 1;
+						base += static_cast<size_t>(base[half] <= x) * half;
+						n -= half;
+					}
+					k = static_cast<size_t>(base - _bound.data());
+				}
+				return _value[k];
+			}
+		}
+		return double(Target(x));
+	}
+
+	// true when the quantizer rounds through the table
+	bool tabulated() const noexcept { return !_value.empty(); }
+
+	// the quantizer of a target is generated on first use and shared by all threads
+	static const quantizer& instance() {
+		static const quantizer q;
+		return q;
+	}
+
+private:
+	// buckets are the leading 16 bits of the ordered key of a double: sign, exponent, and four fraction bits
+	static constexpr unsigned BUCKET_SHIFT = 48;
+	// buckets with at most this many boundaries are searched linearly, otherwise by bisection
+	static constexpr unsigned MAX_LINEAR_STEPS = 8;
+	std::vector<double>   _value;   // distinct finite values of the target in increasing order
+	std::vector<double>   _bound;   // smallest double that rounds to _value[k]
+	std::vector<uint32_t> _first;   // index of the value of the smallest double of each bucket
+	uint64_t              _firstBucket{ 0 };
+	unsigned              _steps{ 0 };  // largest number of boundaries in a bucket
+	double                _low{ 1.0 }, _high{ 0.0 };
+
+	// doubles mapped to unsigned integers in the same order
+	static uint64_t key(double x) noexcept {
+		uint64_t u;
+		std::memcpy(&u, &x, sizeof(u));
+		uint64_t negative = static_cast<uint64_t>(static_cast<int64_t>(u) >> 63);
+		return u ^ (negative | (uint64_t(1) << 63));
+	}
+	static double from_key(uint64_t k) noexcept {
+		uint64_t u = k ^ ((k >> 63) ? (uint64_t(1) << 63) : ~uint64_t(0));
+		double x;
+		std::memcpy(&x, &u, sizeof(x));
+		return x;
+	}
+
+	void build() {
+		constexpr unsigned nbits = Target::nbits;
+		auto decode = [](uint64_t raw) { Target t; t.setbits(raw); return double(t); };
+		// the table only compares the values of the encodings its encoder returns, so any encoding
+		// of the value of the conversion serves
+		std::vector<std::pair<double, uint64_t>> byValue;
+		for (uint64_t raw = 0; raw < (uint64_t(1) << nbits); ++raw) {
+			double v = decode(raw);
+			if (std::isfinite(v)) byValue.push_back({ v, raw });
+		}
+		if (byValue.empty()) return;
+		std::sort(byValue.begin(), byValue.end());
+		uint64_t nonFinite{ 0 };
+		for (uint64_t raw = 0; raw < (uint64_t(1) << nbits); ++raw) if (!std::isfinite(decode(raw))) { nonFinite = raw; break; }
+		auto encode = [&](double x) {
+			double v = double(Target(x));
+			auto it = std::lower_bound(byValue.begin(), byValue.end(), std::pair<double, uint64_t>{ v, 0 });
+			return (it != byValue.end() && it->first == v ? it->second : nonFinite);
+		};
+		encoding_table<nbits> table(decode, encode);
+
+		const size_t n = table.size();
+		_value.resize(n);
+		_bound.resize(n);
+		for (size_t k = 0; k < n; ++k) {
+			_value[k] = table.ordered_value(k);
+			_bound[k] = table.rounding_bound(k);
+		}
+		for (size_t k = 0; k < n; ++k) {
+			bool monotonic = double(Target(_value[k])) == _value[k]
+				&& (k == 0 || (double(Target(_bound[k])) == _value[k] && double(Target(std::nextafter(_bound[k], -std::numeric_limits<double>::infinity()))) == _value[k - 1]));
+			if (!monotonic) {
+				_value.clear();
+				_bound.clear();
+				return;
+			}
+		}
+		_low = _bound.front();
+		_high = _value.back();
+		_firstBucket = key(_low) >> BUCKET_SHIFT;
+		uint64_t lastBucket = key(_high) >> BUCKET_SHIFT;
+		_first.resize(size_t(lastBucket - _firstBucket) + 2);
+		for (uint64_t b = _firstBucket; b <= lastBucket + 1; ++b) {
+			// the value of the smallest double of the bucket, clamped to the range of the table
+			double start = std::max(_low, from_key(b << BUCKET_SHIFT));
+			size_t k = static_cast<size_t>(std::upper_bound(_bound.begin(), _bound.end(), start) - _bound.begin());
+			_first[size_t(b - _firstBucket)] = uint32_t(k == 0 ? 0 : std::min(k - 1, n - 1));
+		}
+		for (size_t b = 0; b + 1 < _first.size(); ++b) _steps = std::max(_steps, _first[b + 1] - _first[b]);
+		// the search may look a bucket past the last value
+		_bound.resize(n + _steps + 1, std::numeric_limits<double>::infinity());
+	}
+};
+
+// a quantizer that rounds a block of values at a time, such as the quantizer of a block-scaled format
+template<typename Quantizer>
+concept BlockQuantization = requires(const Quantizer& q, const double* x, double* y, size_t n) {
+	{ Quantizer::blockSize } -> std::convertible_to<size_t>;
+	q(x, y, n);
+};
+
+}} // namespace sw::universal
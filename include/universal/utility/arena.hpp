@@ -0,0 +1,136 @@
+#pragma once
+// arena.hpp: thread-local monotonic arena for scratch storage of solver workspaces
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <vector>
+
+namespace sw { namespace universal {
+
+	// arena hands out storage from large blocks by bumping an offset. Individual deallocations are no-ops:
+	// storage is reclaimed in bulk by rewinding to a mark or resetting the arena, and the blocks are kept
+	// for reuse, so a workspace that is rebuilt every iteration stops allocating after the first one.
+	class arena {
+	public:
+		static constexpr size_t DEFAULT_BLOCK_SIZE = 1024 * 1024;
+
+		// position in the arena, used to reclaim everything that was allocated after it
+		struct marker {
+			size_t block;
+			size_t offset;
+		};
+
+		explicit arena(size_t blockSize = DEFAULT_BLOCK_SIZE) : blockSize{ blockSize }, current{ 0 }, offset{ 0 }, blocks{} {}
+		arena(const arena&) = delete;
+		arena& operator=(const arena&) = delete;
+
+		void* allocate(size_t bytes, size_t alignment = alignof(std::max_align_t)) {
+			if (bytes == 0) bytes = 1;
+			while (current < blocks.size()) {
+				void* p = carve(blocks[current], bytes, alignment);
+				if (p != nullptr) return p;
+				++current;
+				offset = 0;
+			}
+			size_t size = (bytes + alignment > blockSize ? bytes + alignment : blockSize);
+			blocks.push_back(block{ std::make_unique<std::byte[]>(size), size });
+			current = blocks.size() - 1;
+			offset = 0;
+			return carve(blocks[current], bytes, alignment);
+		}
+		void deallocate(void*, size_t) noexcept {}
+
+		marker mark() const noexcept { return marker{ current, offset }; }
+		// reclaim all storage allocated after the mark
+		void rewind(const marker& m) noexcept {
+			current = m.block;
+			offset = m.offset;
+		}
+		// reclaim all storage, keeping the blocks for reuse
+		void reset() noexcept { rewind(marker{ 0, 0 }); }
+		// reclaim all storage and return the blocks to the system
+		void release() noexcept {
+			blocks.clear();
+			reset();
+		}
+
+		size_t capacity() const noexcept {
+			size_t total{ 0 };
+			for (const block& b : blocks) total += b.size;
+			return total;
+		}
+		size_t bytes_in_use() const noexcept {
+			size_t total{ 0 };
+			for (size_t i = 0; i < current && i < blocks.size(); ++i) total += blocks[i].size;
+			return total + offset;
+		}
+
+	private:
+		struct block {
+			std::unique_ptr<std::byte[]> storage;
+			size_t size;
+		};
+		size_t blockSize;
+		size_t current;   // block that is being carved
+		size_t offset;    // first free byte in the current block
+		std::vector<block> blocks;
+
+		void* carve(block& b, size_t bytes, size_t alignment) noexcept {
+			std::uintptr_t base = reinterpret_cast<std::uintptr_t>(b.storage.get());
+			std::uintptr_t aligned = (base + offset + alignment - 1) & ~(std::uintptr_t(alignment) - 1);
+			size_t end = static_cast<size_t>(aligned - base) + bytes;
+			if (end > b.size) return nullptr;
+			offset = end;
+			return reinterpret_cast<void*>(aligned);
+		}
+	};
+
+	// the arena of the calling thread
+	inline arena& thread_arena() {
+		thread_local arena threadArena;
+		return threadArena;
+	}
+
+	// arena_scope reclaims the storage that the thread arena handed out during its lifetime:
+	// containers that allocate from the thread arena must not outlive the scope they were created in
+	class arena_scope {
+	public:
+		arena_scope() : a{ thread_arena() }, m{ a.mark() } {}
+		explicit arena_scope(arena& a) : a{ a }, m{ a.mark() } {}
+		arena_scope(const arena_scope&) = delete;
+		arena_scope& operator=(const arena_scope&) = delete;
+		~arena_scope() { a.rewind(m); }
+	private:
+		arena& a;
+		arena::marker m;
+	};
+
+	// standard allocator that draws from the arena of the calling thread, for example
+	//   using Workspace = sw::universal::blas::vector<Scalar, arena_allocator<Scalar>>;
+	template<typename T>
+	class arena_allocator {
+	public:
+		using value_type = T;
+
+		arena_allocator() noexcept = default;
+		template<typename U>
+		arena_allocator(const arena_allocator<U>&) noexcept {}
+
+		T* allocate(size_t n) {
+			return static_cast<T*>(thread_arena().allocate(n * sizeof(T), alignof(T)));
+		}
+		void deallocate(T*, size_t) noexcept {}
+	};
+
+	template<typename T, typename U>
+	inline bool operator==(const arena_allocator<T>&, const arena_allocator<U>&) noexcept { return true; }
+	template<typename T, typename U>
+	inline bool operator!=(const arena_allocator<T>&, const arena_allocator<U>&) noexcept { return false; }
+
+}} // namespace sw::universal
@@ -0,0 +1,78 @@
+#pragma once
+// bit_packing.hpp: back to back storage of encodings that are not a whole number of bytes
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+
+namespace sw { namespace universal {
+
+	// Encodings of nbits bits are stored back to back in a byte array, little endian: encoding i occupies the bits
+	// [i * nbits, (i + 1) * nbits). A group of lcm(nbits, 8) bits holds a whole number of encodings in a whole number
+	// of bytes, such as two 4-bit encodings in a byte or four 6-bit encodings in three bytes, so a run of encodings
+	// that starts at a group is unpacked with a load of each group into a register and constant shifts.
+	template<unsigned nbits>
+	struct bit_packing {
+		static_assert(nbits >= 1 && nbits <= 16, "bit_packing: encodings are 1 to 16 bits");
+		static constexpr uint32_t mask       = (uint32_t(1) << nbits) - 1;
+		static constexpr unsigned groupBits  = std::lcm(nbits, 8u);
+		static constexpr unsigned groupSize  = groupBits / nbits;   // encodings in a group
+		static constexpr unsigned groupBytes = groupBits / 8;
+		// a group fits in a 64-bit register
+		static constexpr bool     registerGroups = (groupBits <= 64);
+
+		// bytes of n encodings
+		static constexpr size_t bytes(size_t n) noexcept { return (n * nbits + 7) / 8; }
+
+		static uint32_t get(const uint8_t* data, size_t i) noexcept {
+			size_t bit = i * nbits, byte = bit >> 3;
+			unsigned shift = unsigned(bit & 7), span = (shift + nbits + 7) / 8;
+			uint32_t w{ 0 };
+			for (unsigned k = 0; k < span; ++k) w |= uint32_t(data[byte + k]) << (8 * k);
+			return (w >> shift) & mask;
+		}
+
+		static void set(uint8_t* data, size_t i, uint32_t code) noexcept {
+			size_t bit = i * nbits, byte = bit >> 3;
+			unsigned shift = unsigned(bit & 7), span = (shift + nbits + 7) / 8;
+			uint32_t w = (code & mask) << shift, m = mask << shift;
+			for (unsigned k = 0; k < span; ++k) data[byte + k] = uint8_t((data[byte + k] & ~(m >> (8 * k))) | (w >> (8 * k)));
+		}
+
+		// f(k, code) for the encodings first + k, k in [0, n)
+		template<typename Function>
+		static void unpack(const uint8_t* data, size_t first, size_t n, Function&& f) {
+			size_t groups{ 0 };
+			if constexpr (registerGroups) {
+				if (first % groupSize == 0) groups = n / groupSize;
+				const uint8_t* group = data + (first / groupSize) * groupBytes;
+				for (size_t g = 0; g < groups; ++g, group += groupBytes) {
+					uint64_t w{ 0 };
+					for (unsigned b = 0; b < groupBytes; ++b) w |= uint64_t(group[b]) << (8 * b);
+					for (unsigned j = 0; j < groupSize; ++j) f(g * groupSize + j, uint32_t(w >> (j * nbits)) & mask);
+				}
+			}
+			for (size_t k = groups * groupSize; k < n; ++k) f(k, get(data, first + k));
+		}
+
+		// store codes[0, n) as the encodings [first, first + n)
+		static void pack(uint8_t* data, size_t first, size_t n, const uint32_t* codes) noexcept {
+			size_t groups{ 0 };
+			if constexpr (registerGroups) {
+				if (first % groupSize == 0) groups = n / groupSize;
+				uint8_t* group = data + (first / groupSize) * groupBytes;
+				for (size_t g = 0; g < groups; ++g, group += groupBytes) {
+					uint64_t w{ 0 };
+					for (unsigned j = 0; j < groupSize; ++j) w |= uint64_t(codes[g * groupSize + j] & mask) << (j * nbits);
+					for (unsigned b = 0; b < groupBytes; ++b) group[b] = uint8_t(w >> (8 * b));
+				}
+			}
+			for (size_t k = groups * groupSize; k < n; ++k) set(data, first + k, codes[k]);
+		}
+	};
+
+}} // namespace sw::universal
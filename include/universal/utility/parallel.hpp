@@ -0,0 +1,65 @@
+#pragma once
+// parallel.hpp: minimal fork-join utilities to distribute work across hardware threads
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <cstddef>
+#include <algorithm>
+#include <exception>
+#include <thread>
+#include <vector>
+
+namespace sw { namespace universal {
+
+	// number of hardware threads, guaranteed to be at least 1
+	inline unsigned hardware_threads() {
+		unsigned nrThreads = std::thread::hardware_concurrency();
+		return (nrThreads == 0 ? 1u : nrThreads);
+	}
+
+	// parallel_for partitions the iteration space [begin, end) into nrThreads contiguous chunks
+	// and calls f(first, last, threadId) on each chunk. The partition is static and only depends on
+	// the size of the iteration space and the number of threads, so results that are combined
+	// per chunk in chunk order are reproducible for a given thread count.
+	// The calling thread executes the first chunk. Exceptions thrown by a worker are rethrown in the caller.
+	template<typename ChunkFunction>
+	void parallel_for(size_t begin, size_t end, ChunkFunction&& f, unsigned nrThreads = 0) {
+		if (end <= begin) return;
+		size_t N = end - begin;
+		if (nrThreads == 0) nrThreads = hardware_threads();
+		if (nrThreads > N) nrThreads = static_cast<unsigned>(N);
+		if (nrThreads <= 1) {
+			f(begin, end, 0u);
+			return;
+		}
+		size_t chunk = N / nrThreads;
+		size_t remainder = N % nrThreads;
+		std::vector<std::thread> workers;
+		std::vector<std::exception_ptr> errors(nrThreads);
+		workers.reserve(nrThreads - 1);
+		size_t first = begin + chunk + (remainder > 0 ? 1 : 0);
+		for (unsigned t = 1; t < nrThreads; ++t) {
+			size_t last = first + chunk + (t < remainder ? 1 : 0);
+			workers.emplace_back([&f, &errors, first, last, t]() {
+				try {
+					f(first, last, t);
+				}
+				catch (...) {
+					errors[t] = std::current_exception();
+				}
+			});
+			first = last;
+		}
+		try {
+			f(begin, begin + chunk + (remainder > 0 ? 1 : 0), 0u);
+		}
+		catch (...) {
+			errors[0] = std::current_exception();
+		}
+		for (auto& w : workers) w.join();
+		for (auto& e : errors) if (e) std::rethrow_exception(e);
+	}
+
+}} // namespace sw::universal
@@ -0,0 +1,246 @@
+#pragma once
+// small_vector.hpp: sequence container that stores up to N elements inline before it allocates
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <cstddef>
+#include <cstring>
+#include <algorithm>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+
+namespace sw { namespace universal {
+
+	// small_vector<T, N> is a std::vector work-alike for the limbs and digits of the elastic number types.
+	// The first N elements live inside the object, so values that fit in N limbs are constructed, copied,
+	// and destroyed without touching the heap. Larger values move to storage obtained from the Allocator.
+	// The elements must be trivially copyable, which is what makes the inline storage cheap to copy.
+	template<typename T, size_t N, typename Allocator = std::allocator<T>>
+	class small_vector {
+		static_assert(std::is_trivially_copyable_v<T>, "small_vector elements must be trivially copyable");
+		static_assert(N > 0, "small_vector needs at least one inline element");
+		using alloc_traits = std::allocator_traits<Allocator>;
+	public:
+		using value_type             = T;
+		using allocator_type         = Allocator;
+		using size_type              = size_t;
+		using difference_type        = std::ptrdiff_t;
+		using reference              = T&;
+		using const_reference        = const T&;
+		using pointer                = T*;
+		using const_pointer          = const T*;
+		using iterator               = T*;
+		using const_iterator         = const T*;
+		using reverse_iterator       = std::reverse_iterator<iterator>;
+		using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+		static constexpr size_t inline_capacity = N;
+
+		small_vector() noexcept(noexcept(Allocator())) : small_vector(Allocator()) {}
+		explicit small_vector(const Allocator& allocator) noexcept : _allocator(allocator), _data(_inline), _size(0), _capacity(N) {}
+		explicit small_vector(size_type count, const T& value = T(), const Allocator& allocator = Allocator()) : small_vector(allocator) {
+			assign(count, value);
+		}
+		small_vector(std::initializer_list<T> iList, const Allocator& allocator = Allocator()) : small_vector(allocator) {
+			assign(iList.begin(), iList.end());
+		}
+		template<typename InputIterator, typename = std::enable_if_t<!std::is_integral_v<InputIterator>>>
+		small_vector(InputIterator first, InputIterator last, const Allocator& allocator = Allocator()) : small_vector(allocator) {
+			assign(first, last);
+		}
+		small_vector(const small_vector& rhs) : small_vector(alloc_traits::select_on_container_copy_construction(rhs._allocator)) {
+			assign(rhs.begin(), rhs.end());
+		}
+		small_vector(small_vector&& rhs) noexcept : small_vector(rhs._allocator) {
+			steal(rhs);
+		}
+		~small_vector() { release(); }
+
+		small_vector& operator=(const small_vector& rhs) {
+			if (this != &rhs) assign(rhs.begin(), rhs.end());
+			return *this;
+		}
+		small_vector& operator=(small_vector&& rhs) noexcept {
+			if (this != &rhs) {
+				release();
+				_allocator = rhs._allocator;
+				_data = _inline;
+				_capacity = N;
+				steal(rhs);
+			}
+			return *this;
+		}
+		small_vector& operator=(std::initializer_list<T> iList) {
+			assign(iList.begin(), iList.end());
+			return *this;
+		}
+
+		void assign(size_type count, const T& value) {
+			T v = value;  // value may refer to an element of this container
+			_size = 0;
+			reserve(count);
+			std::fill_n(_data, count, v);
+			_size = count;
+		}
+		template<typename InputIterator, typename = std::enable_if_t<!std::is_integral_v<InputIterator>>>
+		void assign(InputIterator first, InputIterator last) {
+			clear();
+			using category = typename std::iterator_traits<InputIterator>::iterator_category;
+			if constexpr (std::is_base_of_v<std::forward_iterator_tag, category>) {
+				size_type count = static_cast<size_type>(std::distance(first, last));
+				reserve(count);
+				std::copy(first, last, _data);
+				_size = count;
+			}
+			else {
+				for (; first != last; ++first) push_back(*first);
+			}
+		}
+
+		// element access
+		reference       operator[](size_type i) noexcept       { return _data[i]; }
+		const_reference operator[](size_type i) const noexcept { return _data[i]; }
+		reference at(size_type i) {
+			if (i >= _size) throw std::out_of_range("small_vector::at index out of range");
+			return _data[i];
+		}
+		const_reference at(size_type i) const {
+			if (i >= _size) throw std::out_of_range("small_vector::at index out of range");
+			return _data[i];
+		}
+		reference       front() noexcept       { return _data[0]; }
+		const_reference front() const noexcept { return _data[0]; }
+		reference       back() noexcept        { return _data[_size - 1]; }
+		const_reference back() const noexcept  { return _data[_size - 1]; }
+		pointer         data() noexcept        { return _data; }
+		const_pointer   data() const noexcept  { return _data; }
+
+		// iterators
+		iterator               begin() noexcept         { return _data; }
+		const_iterator         begin() const noexcept   { return _data; }
+		const_iterator         cbegin() const noexcept  { return _data; }
+		iterator               end() noexcept           { return _data + _size; }
+		const_iterator         end() const noexcept     { return _data + _size; }
+		const_iterator         cend() const noexcept    { return _data + _size; }
+		reverse_iterator       rbegin() noexcept        { return reverse_iterator(end()); }
+		const_reverse_iterator rbegin() const noexcept  { return const_reverse_iterator(end()); }
+		reverse_iterator       rend() noexcept          { return reverse_iterator(begin()); }
+		const_reverse_iterator rend() const noexcept    { return const_reverse_iterator(begin()); }
+
+		// capacity
+		bool      empty() const noexcept     { return _size == 0; }
+		size_type size() const noexcept      { return _size; }
+		size_type capacity() const noexcept  { return _capacity; }
+		bool      is_inline() const noexcept { return _data == _inline; }
+		allocator_type get_allocator() const noexcept { return _allocator; }
+		void reserve(size_type newCapacity) {
+			if (newCapacity <= _capacity) return;
+			T* storage = alloc_traits::allocate(_allocator, newCapacity);
+			if (_size > 0) std::memcpy(storage, _data, _size * sizeof(T));
+			if (!is_inline()) alloc_traits::deallocate(_allocator, _data, _capacity);
+			_data = storage;
+			_capacity = newCapacity;
+		}
+		// return heap storage when the elements fit inline again
+		void shrink_to_fit() {
+			if (is_inline() || _size > N) return;
+			if (_size > 0) std::memcpy(_inline, _data, _size * sizeof(T));
+			alloc_traits::deallocate(_allocator, _data, _capacity);
+			_data = _inline;
+			_capacity = N;
+		}
+
+		// modifiers
+		void clear() noexcept { _size = 0; }
+		void push_back(const T& value) {
+			if (_size == _capacity) {
+				T v = value;  // value may refer to an element of this container
+				grow(_size + 1);
+				_data[_size++] = v;
+			}
+			else {
+				_data[_size++] = value;
+			}
+		}
+		void pop_back() noexcept { --_size; }
+		void resize(size_type count) { resize(count, T()); }
+		void resize(size_type count, const T& value) {
+			if (count > _size) {
+				T v = value;
+				if (count > _capacity) grow(count);
+				std::fill(_data + _size, _data + count, v);
+			}
+			_size = count;
+		}
+		iterator insert(const_iterator pos, const T& value) { return insert(pos, 1, value); }
+		iterator insert(const_iterator pos, size_type count, const T& value) {
+			size_type index = static_cast<size_type>(pos - _data);
+			T v = value;
+			if (_size + count > _capacity) grow(_size + count);
+			std::memmove(_data + index + count, _data + index, (_size - index) * sizeof(T));
+			std::fill_n(_data + index, count, v);
+			_size += count;
+			return _data + index;
+		}
+		iterator erase(const_iterator pos) { return erase(pos, pos + 1); }
+		iterator erase(const_iterator first, const_iterator last) {
+			size_type index = static_cast<size_type>(first - _data);
+			size_type count = static_cast<size_type>(last - first);
+			std::memmove(_data + index, _data + index + count, (_size - index - count) * sizeof(T));
+			_size -= count;
+			return _data + index;
+		}
+		void swap(small_vector& rhs) noexcept {
+			small_vector tmp(std::move(rhs));
+			rhs = std::move(*this);
+			*this = std::move(tmp);
+		}
+
+	private:
+		[[no_unique_address]] Allocator _allocator;
+		T*        _data;
+		size_type _size;
+		size_type _capacity;
+		T         _inline[N];
+
+		// geometric growth keeps push_back amortized constant
+		void grow(size_type minCapacity) {
+			reserve(std::max(minCapacity, 2 * _capacity));
+		}
+		void release() noexcept {
+			if (!is_inline()) alloc_traits::deallocate(_allocator, _data, _capacity);
+		}
+		// take over the elements of rhs, which is left empty and inline; this object must be empty and inline
+		void steal(small_vector& rhs) noexcept {
+			if (rhs.is_inline()) {
+				if (rhs._size > 0) std::memcpy(_inline, rhs._inline, rhs._size * sizeof(T));
+			}
+			else {
+				_data = rhs._data;
+				_capacity = rhs._capacity;
+				rhs._data = rhs._inline;
+				rhs._capacity = N;
+			}
+			_size = rhs._size;
+			rhs._size = 0;
+		}
+	};
+
+	template<typename T, size_t N, typename Allocator>
+	inline bool operator==(const small_vector<T, N, Allocator>& lhs, const small_vector<T, N, Allocator>& rhs) {
+		return lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+	}
+	template<typename T, size_t N, typename Allocator>
+	inline bool operator!=(const small_vector<T, N, Allocator>& lhs, const small_vector<T, N, Allocator>& rhs) {
+		return !(lhs == rhs);
+	}
+	template<typename T, size_t N, typename Allocator>
+	inline void swap(small_vector<T, N, Allocator>& lhs, small_vector<T, N, Allocator>& rhs) noexcept {
+		lhs.swap(rhs);
+	}
+
+}} // namespace sw::universal
@@ -576,5 +576,47 @@ int VerifyHypot(bool reportTestCases) {
 	return nrOfFailedTests;
 }
 
+
+// enumerate all square root, reciprocal square root, and cube root cases for an lns configuration
+// the roots divide the exponent field: half of an odd field is a tie that rounds to the even field,
+// while the reference rounds the double root, which can land on either side of the tie
+template<typename TestType, typename Root, typename Reference>
+int VerifyRoot(bool reportTestCases, const char* op, bool halves, Root&& root, Reference&& reference) {
+	constexpr unsigned nbits = TestType::nbits;
+	constexpr unsigned NR_TEST_CASES = (1 << nbits);
+	int nrOfFailedTests = 0;
+	TestType a, result, ref;
+
+	for (unsigned i = 0; i < NR_TEST_CASES; ++i) {
+		a.setbits(i);
+		if (a.isnan() || a.isneg() || a.iszero()) continue;
+		result = root(a);
+		ref = reference(double(a));
+		if (result != ref) {
+			int64_t distance = result.exponent_field() - ref.exponent_field();
+			bool tie = halves && (a.exponent_field() % 2 != 0) && (result.exponent_field() % 2 == 0) && (distance == 1 || distance == -1);
+			if (tie) continue;
+			nrOfFailedTests++;
+			if (reportTestCases)	ReportOneInputFunctionError("FAIL", op, a, result, ref);
+		}
+	}
+	return nrOfFailedTests;
+}
+
+template<typename TestType>
+int VerifySqrt(bool reportTestCases) {
+	return VerifyRoot<TestType>(reportTestCases, "sqrt", true, [](const TestType& a) { return sw::universal::sqrt(a); }, [](double da) { return std::sqrt(da); });
+}
+
+template<typename TestType>
+int VerifyRsqrt(bool reportTestCases) {
+	return VerifyRoot<TestType>(reportTestCases, "rsqrt", true, [](const TestType& a) { return sw::universal::rsqrt(a); }, [](double da) { return 1.0 / std::sqrt(da); });
+}
+
+template<typename TestType>
+int VerifyCbrt(bool reportTestCases) {
+	return VerifyRoot<TestType>(reportTestCases, "cbrt", false, [](const TestType& a) { return sw::universal::cbrt(a); }, [](double da) { return std::cbrt(da); });
+}
+
 }} // namespace sw::universal
 
@@ -8,6 +8,7 @@
 #include <iostream>
 #include <iomanip>
 #include <typeinfo>
+#include <random>
 
 #include <universal/internal/blockbinary/blockbinary.hpp>
 #include <universal/verification/test_status.hpp>
@@ -72,6 +73,35 @@ int VerifyDivision(bool bReportIndividualTestCases) {
 	return nrOfFailedTests;
 }
 
+// verify the quotient and remainder of random multi-limb operands through the identity a = q * b + r, |r| < |b|
+template<size_t nbits, typename BlockType = uint8_t>
+int VerifyRandomLongDivision(bool bReportIndividualTestCases, unsigned nrOfRandoms) {
+	using namespace sw::universal;
+	using BlockBinary = blockbinary<nbits, BlockType>;
+	std::mt19937_64 generator(nbits);
+	std::uniform_int_distribution<uint64_t> distribution;
+	int nrOfFailedTests = 0;
+	for (unsigned n = 0; n < nrOfRandoms; ++n) {
+		BlockBinary a, b;
+		for (unsigned i = 0; i < BlockBinary::nrBlocks; ++i) {
+			a.setblock(i, static_cast<BlockType>(distribution(generator)));
+			b.setblock(i, static_cast<BlockType>(distribution(generator)));
+		}
+		b >>= static_cast<int>(distribution(generator) % nbits);  // vary the number of divisor limbs
+		if (b.iszero()) continue;
+		quorem<nbits, BlockType, BinaryNumberType::Signed> result = longdivision(a, b);
+		BlockBinary identity = result.quo * b + result.rem;
+		BlockBinary absr = (result.rem.isneg() ? -result.rem : result.rem);
+		BlockBinary absb = (b.isneg() ? -b : b);
+		bool remainderSignOk = result.rem.iszero() || (result.rem.isneg() == a.isneg());
+		if (identity != a || !(absr < absb) || !remainderSignOk) {
+			++nrOfFailedTests;
+			if (bReportIndividualTestCases) std::cout << "FAIL: " << to_binary(a) << " / " << to_binary(b) << " = " << to_binary(result.quo) << " rem " << to_binary(result.rem) << '\n';
+		}
+	}
+	return nrOfFailedTests;
+}
+
 template<size_t nbits, typename BlockType = uint8_t>
 void TestMostSignificantBit() {
 	using namespace sw::universal;
@@ -147,6 +177,7 @@ try {
 
 	nrOfFailedTestCases += ReportTestResult(VerifyDivision<4, uint8_t>(bReportIndividualTestCases), "blockbinary<4>", test_tag);
 	nrOfFailedTestCases += ReportTestResult(VerifyDivision<8, uint8_t>(bReportIndividualTestCases), "blockbinary<8>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyRandomLongDivision<128, uint32_t>(bReportIndividualTestCases, 10000), "blockbinary<128,uint32_t>", test_tag);
 
 	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
 	return EXIT_SUCCESS; // ignore failures
@@ -160,6 +191,11 @@ try {
 	nrOfFailedTestCases += ReportTestResult(VerifyDivision< 9, uint8_t>(bReportIndividualTestCases), "blockbinary< 9,uint8_t>", test_tag);
 	nrOfFailedTestCases += ReportTestResult(VerifyDivision<10, uint8_t>(bReportIndividualTestCases), "blockbinary<10,uint8_t>", test_tag);
 
+	nrOfFailedTestCases += ReportTestResult(VerifyRandomLongDivision< 96, uint8_t >(bReportIndividualTestCases, 10000), "blockbinary< 96,uint8_t>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyRandomLongDivision<128, uint16_t>(bReportIndividualTestCases, 10000), "blockbinary<128,uint16_t>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyRandomLongDivision<128, uint32_t>(bReportIndividualTestCases, 10000), "blockbinary<128,uint32_t>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyRandomLongDivision<256, uint32_t>(bReportIndividualTestCases, 10000), "blockbinary<256,uint32_t>", test_tag);
+
 #if REGRESSION_LEVEL_4
 	nrOfFailedTestCases += ReportTestResult(VerifyDivision<12, uint8_t >(bReportIndividualTestCases), "blockbinary<12,uint8_t>", test_tag);
 
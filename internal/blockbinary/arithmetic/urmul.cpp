@@ -7,6 +7,7 @@
 #include <universal/utility/long_double.hpp>
 #include <iostream>
 #include <iomanip>
+#include <random>
 
 #include <universal/internal/blockbinary/blockbinary.hpp>
 #include <universal/verification/test_status.hpp> // ReportTestResult
@@ -68,6 +69,64 @@ int VerifyUnroundedMultiplication(bool bReportIndividualTestCases) {
 	return nrOfFailedTests;
 }
 
+// enumerate all cases of the sign-magnitude (urmul2) and sign-extended (urmul) unrounded products
+template<unsigned nbits, typename BlockType = uint8_t>
+int VerifyUrmulVariants(bool bReportIndividualTestCases) {
+	constexpr size_t NR_VALUES = (size_t(1) << nbits);
+	using namespace sw::universal;
+
+	int nrOfFailedTests = 0;
+	blockbinary<nbits, BlockType> a, b;
+	blockbinary<2 * nbits, BlockType> c1, c2, result_reference;
+	for (size_t i = 0; i < NR_VALUES; i++) {
+		a.setbits(i);
+		int64_t aref = a.to_long_long();
+		for (size_t j = 0; j < NR_VALUES; j++) {
+			b.setbits(j);
+			int64_t bref = b.to_long_long();
+			int64_t cref = aref * bref;
+			result_reference.setbits(static_cast<uint64_t>(cref));
+			c1 = urmul(a, b);
+			c2 = urmul2(a, b);
+			if (c1 != result_reference || c2 != result_reference) {
+				nrOfFailedTests++;
+				if (bReportIndividualTestCases) std::cout << "FAIL: " << aref << " * " << bref << " = " << c1.to_long_long() << " | " << c2.to_long_long() << " reference " << cref << '\n';
+			}
+			if (nrOfFailedTests > 100) return nrOfFailedTests;
+		}
+	}
+	return nrOfFailedTests;
+}
+
+// randomized cases of the unrounded products for configurations too large to enumerate:
+// the limb-by-limb magnitude product and the sign-extended modulo product must agree
+template<unsigned nbits, typename BlockType = uint32_t>
+int VerifyRandomUrmulVariants(bool bReportIndividualTestCases, unsigned nrOfRandoms) {
+	using namespace sw::universal;
+	using Operand = blockbinary<nbits, BlockType>;
+
+	std::mt19937_64 generator(nbits);
+	std::uniform_int_distribution<uint64_t> distribution;
+	int nrOfFailedTests = 0;
+	Operand a, b;
+	for (unsigned n = 0; n < nrOfRandoms; ++n) {
+		for (unsigned i = 0; i < Operand::nrBlocks; ++i) {
+			a.setblock(i, static_cast<BlockType>(distribution(generator)));
+			b.setblock(i, static_cast<BlockType>(distribution(generator)));
+		}
+		a.flip().flip();  // null the bits outside of nbits
+		b.flip().flip();
+		if (n == 0) a.maxneg();
+		if (n == 1) b.maxneg();
+		blockbinary<2 * nbits, BlockType> c1 = urmul(a, b), c2 = urmul2(a, b);
+		if (c1 != c2) {
+			nrOfFailedTests++;
+			if (bReportIndividualTestCases) std::cout << "FAIL: " << to_binary(a) << " * " << to_binary(b) << " : " << to_binary(c1) << " != " << to_binary(c2) << '\n';
+		}
+	}
+	return nrOfFailedTests;
+}
+
 // generate specific test case that you can trace with the trace conditions in fixpnt.h
 // for most bugs they are traceable with _trace_conversion and _trace_add
 template<size_t nbits, typename StorageBlockType = uint8_t>
@@ -143,6 +202,17 @@ try {
 	nrOfFailedTestCases += ReportTestResult(VerifyUnroundedMultiplication<10, uint16_t>(bReportIndividualTestCases), "blockbinary<10,uint16>", test_tag);
 //	nrOfFailedTestCases += ReportTestResult(VerifyUnroundedMultiplication<10, uint32_t>(bReportIndividualTestCases), "blockbinary<10,uint32>", test_tag);
 
+	nrOfFailedTestCases += ReportTestResult(VerifyUrmulVariants< 4, uint8_t >(bReportIndividualTestCases), "blockbinary< 4,uint8 >", "urmul/urmul2");
+	nrOfFailedTestCases += ReportTestResult(VerifyUrmulVariants< 8, uint8_t >(bReportIndividualTestCases), "blockbinary< 8,uint8 >", "urmul/urmul2");
+	nrOfFailedTestCases += ReportTestResult(VerifyUrmulVariants< 9, uint8_t >(bReportIndividualTestCases), "blockbinary< 9,uint8 >", "urmul/urmul2");
+	nrOfFailedTestCases += ReportTestResult(VerifyUrmulVariants<10, uint16_t>(bReportIndividualTestCases), "blockbinary<10,uint16>", "urmul/urmul2");
+
+	nrOfFailedTestCases += ReportTestResult(VerifyRandomUrmulVariants< 32, uint8_t >(bReportIndividualTestCases, 1000), "blockbinary< 32,uint8 >", "urmul/urmul2");
+	nrOfFailedTestCases += ReportTestResult(VerifyRandomUrmulVariants< 32, uint64_t>(bReportIndividualTestCases, 1000), "blockbinary< 32,uint64>", "urmul/urmul2");
+	nrOfFailedTestCases += ReportTestResult(VerifyRandomUrmulVariants< 64, uint16_t>(bReportIndividualTestCases, 1000), "blockbinary< 64,uint16>", "urmul/urmul2");
+	nrOfFailedTestCases += ReportTestResult(VerifyRandomUrmulVariants< 67, uint32_t>(bReportIndividualTestCases, 1000), "blockbinary< 67,uint32>", "urmul/urmul2");
+	nrOfFailedTestCases += ReportTestResult(VerifyRandomUrmulVariants<256, uint32_t>(bReportIndividualTestCases,  100), "blockbinary<256,uint32>", "urmul/urmul2");
+
 
 #if STRESS_TESTING
 
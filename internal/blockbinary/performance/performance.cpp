@@ -76,6 +76,51 @@ namespace sw::universal::bb {
 		}
 	}
 
+	// the bit-serial unrounded multiplication that urmul2 used before the limb-by-limb product:
+	// one full-width add and shift per bit of the multiplier, kept as the reference for the benchmark
+	template<unsigned N, typename B, BinaryNumberType T>
+	blockbinary<2 * N, B, T> urmul2_bitserial(const blockbinary<N, B, T>& a, const blockbinary<N, B, T>& b) {
+		blockbinary<2 * N, B, T> result(0);
+		if (a.iszero() || b.iszero()) return result;
+		bool result_sign = a.sign() ^ b.sign();
+		blockbinary<N + 1, B, T> a_new(a);
+		blockbinary<N + 1, B, T> b_new(b);
+		if (a.sign()) a_new.twosComplement();
+		if (b.sign()) b_new.twosComplement();
+		blockbinary<2 * N, B, T> multiplicant(b_new);
+		for (unsigned i = 0; i < (N + 1); ++i) {
+			if (a_new.at(i)) result += multiplicant;
+			multiplicant <<= 1;
+		}
+		if (result_sign) result.twosComplement();
+		return result;
+	}
+
+	// blockbinary set of unrounded multiplies, the kernel of fixpnt multiplication
+	template<typename BlockbinaryConfiguration, bool bitSerial = false>
+	void UnroundedMultiplicationWorkload(size_t NR_OPS) {
+		BlockbinaryConfiguration a, b;
+		for (unsigned i = 0; i < BlockbinaryConfiguration::nrBlocks; ++i) {  // populate every limb
+			a.setblock(i, typename BlockbinaryConfiguration::BlockType(0x5A5A5A5A5A5A5A5Aull));
+			b.setblock(i, typename BlockbinaryConfiguration::BlockType(0xC3C3C3C3C3C3C3C3ull));
+		}
+		a.flip().flip();  // null the bits outside of nbits
+		b.flip().flip();
+		decltype(urmul2(a, b)) c{ 0 };
+		for (size_t i = 0; i < NR_OPS; ++i) {
+			if constexpr (bitSerial) {
+				c = urmul2_bitserial(a, b);
+			}
+			else {
+				c = urmul2(a, b);
+			}
+			a.setbit(i % BlockbinaryConfiguration::nbits, !a.at(i % BlockbinaryConfiguration::nbits));
+		}
+		if (c.iszero()) {
+			std::cout << "dummy case to fool the optimizer\n";
+		}
+	}
+
 	// blockbinary set of divides for a given number system type
 	template<typename BlockbinaryConfiguration>
 	void DivisionWorkload(size_t NR_OPS) {
@@ -333,6 +378,32 @@ void TestBlockPerformanceOnMul() {
 	PerformanceRunner("blockbinary<1024,uint32>  mul   ", bb::MultiplicationWorkload< blockbinary<1024, uint32_t> >, NR_OPS / 256);
 }
 
+// unrounded multiplication is the kernel of fixpnt multiplication
+void TestBlockPerformanceOnUnroundedMul() {
+	using namespace sw::universal;
+	std::cout << "\nUNROUNDED MULTIPLICATION: bit-serial versus limb-by-limb urmul2 as a function of size and BlockType\n";
+
+	constexpr size_t NR_OPS = 512ull * 1024;
+	PerformanceRunner("blockbinary<8,uint8>      urmul2 bit-serial", bb::UnroundedMultiplicationWorkload< blockbinary<8, uint8_t>, true >, NR_OPS);
+	PerformanceRunner("blockbinary<8,uint8>      urmul2 limb-wise ", bb::UnroundedMultiplicationWorkload< blockbinary<8, uint8_t> >, NR_OPS);
+	PerformanceRunner("blockbinary<16,uint16>    urmul2 bit-serial", bb::UnroundedMultiplicationWorkload< blockbinary<16, uint16_t>, true >, NR_OPS);
+	PerformanceRunner("blockbinary<16,uint16>    urmul2 limb-wise ", bb::UnroundedMultiplicationWorkload< blockbinary<16, uint16_t> >, NR_OPS);
+	PerformanceRunner("blockbinary<32,uint8>     urmul2 bit-serial", bb::UnroundedMultiplicationWorkload< blockbinary<32, uint8_t>, true >, NR_OPS);
+	PerformanceRunner("blockbinary<32,uint8>     urmul2 limb-wise ", bb::UnroundedMultiplicationWorkload< blockbinary<32, uint8_t> >, NR_OPS);
+	PerformanceRunner("blockbinary<32,uint32>    urmul2 bit-serial", bb::UnroundedMultiplicationWorkload< blockbinary<32, uint32_t>, true >, NR_OPS);
+	PerformanceRunner("blockbinary<32,uint32>    urmul2 limb-wise ", bb::UnroundedMultiplicationWorkload< blockbinary<32, uint32_t> >, NR_OPS);
+	PerformanceRunner("blockbinary<64,uint8>     urmul2 bit-serial", bb::UnroundedMultiplicationWorkload< blockbinary<64, uint8_t>, true >, NR_OPS / 2);
+	PerformanceRunner("blockbinary<64,uint8>     urmul2 limb-wise ", bb::UnroundedMultiplicationWorkload< blockbinary<64, uint8_t> >, NR_OPS / 2);
+	PerformanceRunner("blockbinary<64,uint32>    urmul2 bit-serial", bb::UnroundedMultiplicationWorkload< blockbinary<64, uint32_t>, true >, NR_OPS / 2);
+	PerformanceRunner("blockbinary<64,uint32>    urmul2 limb-wise ", bb::UnroundedMultiplicationWorkload< blockbinary<64, uint32_t> >, NR_OPS / 2);
+	PerformanceRunner("blockbinary<128,uint32>   urmul2 bit-serial", bb::UnroundedMultiplicationWorkload< blockbinary<128, uint32_t>, true >, NR_OPS / 8);
+	PerformanceRunner("blockbinary<128,uint32>   urmul2 limb-wise ", bb::UnroundedMultiplicationWorkload< blockbinary<128, uint32_t> >, NR_OPS / 8);
+	PerformanceRunner("blockbinary<256,uint32>   urmul2 bit-serial", bb::UnroundedMultiplicationWorkload< blockbinary<256, uint32_t>, true >, NR_OPS / 32);
+	PerformanceRunner("blockbinary<256,uint32>   urmul2 limb-wise ", bb::UnroundedMultiplicationWorkload< blockbinary<256, uint32_t> >, NR_OPS / 32);
+	PerformanceRunner("blockbinary<512,uint32>   urmul2 bit-serial", bb::UnroundedMultiplicationWorkload< blockbinary<512, uint32_t>, true >, NR_OPS / 128);
+	PerformanceRunner("blockbinary<512,uint32>   urmul2 limb-wise ", bb::UnroundedMultiplicationWorkload< blockbinary<512, uint32_t> >, NR_OPS / 128);
+}
+
 #define MANUAL_TESTING 0
 #define STRESS_TESTING 0
 
@@ -366,6 +437,7 @@ try {
 	TestBlockPerformanceOnShift();
 	TestBlockPerformanceOnAdd();
 	TestBlockPerformanceOnMul();
+	TestBlockPerformanceOnUnroundedMul();
 	TestBlockPerformanceOnDiv();
 	TestBlockPerformanceOnRem();
 
@@ -0,0 +1,222 @@
+// allocators.cpp: verify the blas containers on arena storage and the small buffer limb store
+//
+// Copyright (C) 2017-2023 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <universal/utility/arena.hpp>
+#include <universal/utility/small_vector.hpp>
+#include <universal/number/posit/posit.hpp>
+#include <universal/number/einteger/einteger.hpp>
+#include <universal/blas/blas.hpp>
+#include <universal/blas/solvers/jacobi.hpp>
+#include <universal/blas/solvers/cg_dot_dot.hpp>
+#include <universal/verification/test_suite.hpp>
+
+// arena backed vectors and matrices must compute what the default allocated ones compute,
+// and a workspace that is rebuilt inside an arena_scope must not grow the arena
+template<typename Scalar>
+int VerifyArenaContainers(bool reportTestCases, size_t N) {
+	using namespace sw::universal;
+	using namespace sw::universal::blas;
+	using Workspace = vector<Scalar, arena_allocator<Scalar>>;
+
+	vector<Scalar> x(N), y(N);
+	for (size_t i = 0; i < N; ++i) {
+		x[i] = Scalar(double(i) / double(N));
+		y[i] = Scalar(1.0 - double(i) / double(N));
+	}
+	Scalar alpha(0.5);
+	vector<Scalar> reference = x + alpha * y;
+
+	int nrOfFailedTests = 0;
+	arena& a = thread_arena();
+	size_t inUse = a.bytes_in_use();
+	size_t capacity{ 0 };
+	for (int iteration = 0; iteration < 4; ++iteration) {
+		arena_scope scope;
+		Workspace w(x);
+		Workspace z(N);
+		z = w + alpha * y;
+		if (!(vector<Scalar>(z) == reference)) {
+			++nrOfFailedTests;
+			if (reportTestCases) std::cerr << "FAIL: arena vector expression in iteration " << iteration << '\n';
+		}
+		matrix<Scalar, arena_allocator<Scalar>> A(N, N);
+		A = Scalar(1);
+		if (A[N - 1][N - 1] != Scalar(1) || num_rows(A) != N) ++nrOfFailedTests;
+		if (iteration == 0) capacity = a.capacity();
+		else if (a.capacity() != capacity) {
+			++nrOfFailedTests;
+			if (reportTestCases) std::cerr << "FAIL: arena grew from " << capacity << " to " << a.capacity() << " bytes in iteration " << iteration << '\n';
+		}
+	}
+	if (a.bytes_in_use() != inUse) {
+		++nrOfFailedTests;
+		if (reportTestCases) std::cerr << "FAIL: arena_scope did not rewind the arena\n";
+	}
+	return nrOfFailedTests;
+}
+
+// the iterative solvers draw their workspace from the thread arena and rewind it when they return,
+// so a repeated solve does not grow the arena
+template<typename Scalar>
+int VerifySolverWorkspaces(bool reportTestCases, size_t N) {
+	using namespace sw::universal;
+	using namespace sw::universal::blas;
+	using Matrix = matrix<Scalar>;
+	using Vector = vector<Scalar>;
+
+	// diagonally dominant, symmetric positive definite system
+	Matrix A(N, N), M(N, N);
+	for (size_t i = 0; i < N; ++i) {
+		for (size_t j = 0; j < N; ++j) A[i][j] = (i == j ? Scalar(4) : (i + 1 == j || j + 1 == i ? Scalar(-1) : Scalar(0)));
+		M[i][i] = Scalar(0.25);
+	}
+	using Stencil = stencil<Scalar>;
+	Stencil S(N, 1, 1, Scalar(4), Scalar(-1), Scalar(0), Scalar(0)), P(N, 1, 1, Scalar(0.25), Scalar(0), Scalar(0), Scalar(0));
+	Vector b(N);
+	for (size_t i = 0; i < N; ++i) b[i] = Scalar(1);
+
+	int nrOfFailedTests = 0;
+	arena& a = thread_arena();
+	a.release();
+	size_t capacity{ 0 };
+	for (int solve = 0; solve < 2; ++solve) {
+		Vector x(N), y(N), z(N), residuals, stencilResiduals;
+		Jacobi<Matrix, Vector, 100, false>(A, b, x, Scalar(1.0e-5));
+		cg_dot_dot<Matrix, Vector, 100>(M, A, b, y, residuals, Scalar(1.0e-5));
+		// the same system as a matrix-free stencil: its products write into the arena workspace of the solver
+		cg_dot_dot<Stencil, Vector, 100>(P, S, b, z, stencilResiduals, Scalar(1.0e-5));
+		Vector r = b - A * x, s = b - A * y, t = b - S * z;
+		if (normLinf(r) > Scalar(1.0e-4) || normLinf(s) > Scalar(1.0e-4) || normLinf(t) > Scalar(1.0e-4)) {
+			++nrOfFailedTests;
+			if (reportTestCases) std::cerr << "FAIL: solver residuals " << normLinf(r) << ", " << normLinf(s) << " and " << normLinf(t) << '\n';
+		}
+		if (!(y == z)) {
+			++nrOfFailedTests;
+			if (reportTestCases) std::cerr << "FAIL: cg on the stencil differs from cg on its matrix\n";
+		}
+		if (a.bytes_in_use() != 0) {
+			++nrOfFailedTests;
+			if (reportTestCases) std::cerr << "FAIL: solver left " << a.bytes_in_use() << " bytes in the arena\n";
+		}
+		if (solve == 0) {
+			capacity = a.capacity();
+			if (capacity == 0) {
+				++nrOfFailedTests;
+				if (reportTestCases) std::cerr << "FAIL: solver workspace did not come from the arena\n";
+			}
+		}
+		else if (a.capacity() != capacity) {
+			++nrOfFailedTests;
+			if (reportTestCases) std::cerr << "FAIL: arena grew from " << capacity << " to " << a.capacity() << " bytes in solve " << solve << '\n';
+		}
+	}
+	return nrOfFailedTests;
+}
+
+// the limb store must behave as a std::vector across the inline to heap transition
+int VerifySmallVector(bool reportTestCases) {
+	using namespace sw::universal;
+	int nrOfFailedTests = 0;
+	small_vector<uint32_t, 4> v;
+	std::vector<uint32_t> reference;
+	for (uint32_t i = 0; i < 16; ++i) {
+		v.push_back(i);
+		reference.push_back(i);
+		if (i == 3 && !v.is_inline()) ++nrOfFailedTests;
+		if (i == 4 && v.is_inline()) ++nrOfFailedTests;
+	}
+	v.insert(v.begin() + 2, 3, 99u);
+	reference.insert(reference.begin() + 2, 3, 99u);
+	v.erase(v.begin() + 10, v.begin() + 12);
+	reference.erase(reference.begin() + 10, reference.begin() + 12);
+	if (!std::equal(v.begin(), v.end(), reference.begin(), reference.end())) ++nrOfFailedTests;
+
+	small_vector<uint32_t, 4> copy(v), moved(std::move(copy));
+	if (moved != v || !copy.empty()) ++nrOfFailedTests;
+	moved.resize(3);
+	moved.shrink_to_fit();
+	if (!moved.is_inline() || moved[2] != 99u) ++nrOfFailedTests;
+	if (reportTestCases && nrOfFailedTests > 0) std::cerr << "FAIL: small_vector operations\n";
+	return nrOfFailedTests;
+}
+
+// einteger values that fit the inline limbs must not differ from values that spill to the heap
+int VerifyInlineLimbs(bool reportTestCases) {
+	using namespace sw::universal;
+	int nrOfFailedTests = 0;
+	einteger<uint32_t> a, b, c;
+	a.assign("123456789012345678901234567890");
+	b.assign("15241578751777335113164448644332513954804068924292796060740");
+	c = a * a;  // beyond the inline limbs
+	if (c != b) {
+		++nrOfFailedTests;
+		if (reportTestCases) std::cerr << "FAIL: " << c << " != " << b << '\n';
+	}
+	c -= b;
+	c += a;
+	if (c != a) {
+		++nrOfFailedTests;
+		if (reportTestCases) std::cerr << "FAIL: " << c << " != " << a << '\n';
+	}
+	return nrOfFailedTests;
+}
+
+// Regression testing guards: typically set by the cmake configuration, but MANUAL_TESTING is an override
+#define MANUAL_TESTING 0
+// REGRESSION_LEVEL_OVERRIDE is set by the cmake file to drive a specific regression intensity
+// It is the responsibility of the regression test to organize the tests in a quartile progression.
+//#undef REGRESSION_LEVEL_OVERRIDE
+#ifndef REGRESSION_LEVEL_OVERRIDE
+#undef REGRESSION_LEVEL_1
+#undef REGRESSION_LEVEL_2
+#undef REGRESSION_LEVEL_3
+#undef REGRESSION_LEVEL_4
+#define REGRESSION_LEVEL_1 1
+#define REGRESSION_LEVEL_2 1
+#define REGRESSION_LEVEL_3 1
+#define REGRESSION_LEVEL_4 1
+#endif
+
+int main()
+try {
+	using namespace sw::universal;
+
+	std::string test_suite  = "BLAS container allocators";
+	std::string test_tag    = "allocators";
+	bool reportTestCases    = true;
+	int nrOfFailedTestCases = 0;
+
+	ReportTestSuiteHeader(test_suite, reportTestCases);
+
+	nrOfFailedTestCases += ReportTestResult(VerifyArenaContainers<float>(reportTestCases, 64), "float", "arena containers");
+	nrOfFailedTestCases += ReportTestResult(VerifyArenaContainers< posit<32, 2> >(reportTestCases, 64), "posit<32,2>", "arena containers");
+	nrOfFailedTestCases += ReportTestResult(VerifySolverWorkspaces<double>(reportTestCases, 32), "double", "solver workspaces");
+	nrOfFailedTestCases += ReportTestResult(VerifySmallVector(reportTestCases), "small_vector", "limb store");
+	nrOfFailedTestCases += ReportTestResult(VerifyInlineLimbs(reportTestCases), "einteger", "inline limbs");
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return (nrOfFailedTestCases == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_arithmetic_exception& err) {
+	std::cerr << "Uncaught universal arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_internal_exception& err) {
+	std::cerr << "Uncaught universal internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
@@ -0,0 +1,209 @@
+// decompositions.cpp: verify the blocked Householder QR and the one-sided Jacobi SVD
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <universal/number/posit/posit.hpp>
+#include <universal/number/cfloat/cfloat.hpp>
+#include <universal/number/dd/dd.hpp>
+#include <universal/blas/blas.hpp>
+#include <universal/blas/matrices/testsuite.hpp>
+#include <universal/verification/test_suite.hpp>
+
+// largest absolute element of A - B, relative to the largest absolute element of reference
+template<typename Scalar>
+double RelativeDifference(const sw::universal::blas::matrix<Scalar>& A, const sw::universal::blas::matrix<Scalar>& B, const sw::universal::blas::matrix<Scalar>& reference) {
+	using namespace sw::universal::blas;
+	double diff{ 0 }, scale{ 0 };
+	for (size_t i = 0; i < num_rows(A); ++i) {
+		for (size_t j = 0; j < num_cols(A); ++j) {
+			diff = std::max(diff, std::abs(double(A(i, j) - B(i, j))));
+		}
+	}
+	for (size_t i = 0; i < num_rows(reference); ++i) {
+		for (size_t j = 0; j < num_cols(reference); ++j) {
+			scale = std::max(scale, std::abs(double(reference(i, j))));
+		}
+	}
+	return (scale == 0.0 ? diff : diff / scale);
+}
+
+template<typename Scalar>
+sw::universal::blas::matrix<Scalar> Transpose(const sw::universal::blas::matrix<Scalar>& A) {
+	using namespace sw::universal::blas;
+	matrix<Scalar> At(num_cols(A), num_rows(A));
+	for (size_t i = 0; i < num_rows(A); ++i) {
+		for (size_t j = 0; j < num_cols(A); ++j) At(j, i) = A(i, j);
+	}
+	return At;
+}
+
+// A = Q R with Q orthogonal and R upper triangular, for panels narrower and wider than the matrix
+template<typename Scalar>
+int VerifyBlockedQR(bool reportTestCases, const std::string& matrixName, double tolerance) {
+	using namespace sw::universal::blas;
+	matrix<Scalar> A = getTestMatrix(matrixName);
+	size_t m = num_rows(A), n = num_cols(A);
+	double eps = double(std::numeric_limits<Scalar>::epsilon());
+	matrix<Scalar> I(m, m);
+	I = Scalar(1);
+
+	int nrOfFailedTests = 0;
+	for (size_t blockSize : { size_t(1), size_t(3), size_t(32) }) {
+		matrix<Scalar> Q, R;
+		blocked_houseqr(A, Q, R, blockSize);
+		double backward = RelativeDifference(Q * R, A, A);
+		double orthogonality = RelativeDifference(Transpose(Q) * Q, I, I);
+		bool triangular = true;
+		for (size_t i = 1; i < m; ++i) {
+			for (size_t j = 0; j < i && j < n; ++j) if (R(i, j) != Scalar(0)) triangular = false;
+		}
+		if (backward > tolerance * m * eps || orthogonality > tolerance * m * eps || !triangular) {
+			++nrOfFailedTests;
+			if (reportTestCases) std::cerr << "FAIL: blocked_houseqr(" << matrixName << ", nb = " << blockSize << ") backward error " << backward
+				<< " orthogonality " << orthogonality << (triangular ? "" : " R is not upper triangular") << '\n';
+		}
+	}
+	return nrOfFailedTests;
+}
+
+// A = U diag(sigma) V^T with orthonormal U and V, and descending singular values:
+// the condition number sigma_max / sigma_min must match the double precision reference
+template<typename Scalar>
+int VerifyJacobiSVD(bool reportTestCases, const std::string& matrixName, double tolerance, double condition = 0.0) {
+	using namespace sw::universal::blas;
+	matrix<Scalar> A = getTestMatrix(matrixName);
+	double eps = double(std::numeric_limits<Scalar>::epsilon());
+
+	int nrOfFailedTests = 0;
+	// the wide case runs on the transpose
+	for (bool wide : { false, true }) {
+		matrix<Scalar> B = (wide ? Transpose(A) : A);
+		size_t m = num_rows(B), n = num_cols(B), k = std::min(m, n);
+		matrix<Scalar> U, V;
+		vector<Scalar> sigma;
+		jacobi_svd(B, U, sigma, V);
+		matrix<Scalar> S(k, k), I(k, k);
+		I = Scalar(1);
+		for (size_t i = 0; i < k; ++i) S(i, i) = sigma[i];
+		double backward = RelativeDifference(U * S * Transpose(V), B, B);
+		double orthogonalityU = RelativeDifference(Transpose(U) * U, I, I);
+		double orthogonalityV = RelativeDifference(Transpose(V) * V, I, I);
+		bool descending = true;
+		for (size_t i = 1; i < k; ++i) if (sigma[i - 1] < sigma[i]) descending = false;
+		double scale = tolerance * std::max(m, n) * eps;
+		if (backward > scale || orthogonalityU > scale || orthogonalityV > scale || !descending) {
+			++nrOfFailedTests;
+			if (reportTestCases) std::cerr << "FAIL: jacobi_svd(" << matrixName << (wide ? "^T" : "") << ") backward error " << backward
+				<< " orthogonality " << orthogonalityU << ' ' << orthogonalityV << (descending ? "" : " singular values are not sorted") << '\n';
+		}
+		if (condition > 0.0) {
+			double kappa = double(sigma[0]) / double(sigma[k - 1]);
+			if (std::abs(kappa - condition) > 1.0e-3 * condition) {
+				++nrOfFailedTests;
+				if (reportTestCases) std::cerr << "FAIL: condition number of " << matrixName << " is " << kappa << " instead of " << condition << '\n';
+			}
+		}
+	}
+	return nrOfFailedTests;
+}
+
+// the svd and qr entry points must agree with the algorithms they dispatch to
+template<typename Scalar>
+int VerifyEntryPoints(bool reportTestCases) {
+	using namespace sw::universal::blas;
+	matrix<Scalar> A = getTestMatrix("q5");
+	int nrOfFailedTests = 0;
+	matrix<Scalar> Q, R, Qb, Rb;
+	std::tie(Q, R) = qr(A, 5);
+	blocked_houseqr(A, Qb, Rb);
+	if (!(Q == Qb) || !(R == Rb)) ++nrOfFailedTests;
+	matrix<Scalar> S, V, D;
+	std::tie(S, V, D) = svd(A);
+	double backward = RelativeDifference(S * V * Transpose(D), A, A);
+	if (backward > 1.0e3 * double(std::numeric_limits<Scalar>::epsilon())) ++nrOfFailedTests;
+	if (reportTestCases && nrOfFailedTests > 0) std::cerr << "FAIL: qr(A, 5) or svd(A) entry points\n";
+	return nrOfFailedTests;
+}
+
+// Regression testing guards: typically set by the cmake configuration, but MANUAL_TESTING is an override
+#define MANUAL_TESTING 0
+// REGRESSION_LEVEL_OVERRIDE is set by the cmake file to drive a specific regression intensity
+// It is the responsibility of the regression test to organize the tests in a quartile progression.
+//#undef REGRESSION_LEVEL_OVERRIDE
+#ifndef REGRESSION_LEVEL_OVERRIDE
+#undef REGRESSION_LEVEL_1
+#undef REGRESSION_LEVEL_2
+#undef REGRESSION_LEVEL_3
+#undef REGRESSION_LEVEL_4
+#define REGRESSION_LEVEL_1 1
+#define REGRESSION_LEVEL_2 1
+#define REGRESSION_LEVEL_3 1
+#define REGRESSION_LEVEL_4 1
+#endif
+
+int main()
+try {
+	using namespace sw::universal;
+
+	std::string test_suite  = "BLAS QR and SVD decompositions";
+	std::string test_tag    = "decompositions";
+	bool reportTestCases    = true;
+	int nrOfFailedTestCases = 0;
+
+	ReportTestSuiteHeader(test_suite, reportTestCases);
+
+#if REGRESSION_LEVEL_1
+	nrOfFailedTestCases += ReportTestResult(VerifyBlockedQR<double>(reportTestCases, "q5", 10.0), "double", "blocked QR q5");
+	nrOfFailedTestCases += ReportTestResult(VerifyBlockedQR<double>(reportTestCases, "faires74x3", 10.0), "double", "blocked QR faires74x3");
+	nrOfFailedTestCases += ReportTestResult(VerifyJacobiSVD<double>(reportTestCases, "q5", 10.0), "double", "Jacobi SVD q5");
+	nrOfFailedTestCases += ReportTestResult(VerifyEntryPoints<double>(reportTestCases), "double", "qr/svd entry points");
+#endif
+
+#if REGRESSION_LEVEL_2
+	using Posit = posit<32, 2>;
+	using Cfloat = cfloat<32, 8, uint32_t, true, false, false>;
+	nrOfFailedTestCases += ReportTestResult(VerifyBlockedQR<double>(reportTestCases, "Stranke94", 10.0), "double", "blocked QR Stranke94");
+	nrOfFailedTestCases += ReportTestResult(VerifyJacobiSVD<double>(reportTestCases, "Stranke94", 10.0, 5.1733e+01), "double", "Jacobi SVD Stranke94");
+	nrOfFailedTestCases += ReportTestResult(VerifyBlockedQR<Posit>(reportTestCases, "Stranke94", 10.0), "posit<32,2>", "blocked QR Stranke94");
+	nrOfFailedTestCases += ReportTestResult(VerifyJacobiSVD<Posit>(reportTestCases, "Stranke94", 10.0, 5.1733e+01), "posit<32,2>", "Jacobi SVD Stranke94");
+	nrOfFailedTestCases += ReportTestResult(VerifyBlockedQR<Cfloat>(reportTestCases, "Stranke94", 10.0), "cfloat<32,8>", "blocked QR Stranke94");
+	nrOfFailedTestCases += ReportTestResult(VerifyJacobiSVD<Cfloat>(reportTestCases, "Stranke94", 10.0, 5.1733e+01), "cfloat<32,8>", "Jacobi SVD Stranke94");
+#endif
+
+#if REGRESSION_LEVEL_3
+	nrOfFailedTestCases += ReportTestResult(VerifyBlockedQR<double>(reportTestCases, "pores_1", 10.0), "double", "blocked QR pores_1");
+	nrOfFailedTestCases += ReportTestResult(VerifyJacobiSVD<double>(reportTestCases, "pores_1", 10.0, 1.812616e+06), "double", "Jacobi SVD pores_1");
+	nrOfFailedTestCases += ReportTestResult(VerifyBlockedQR<dd>(reportTestCases, "Trefethen_20", 10.0), "dd", "blocked QR Trefethen_20");
+	nrOfFailedTestCases += ReportTestResult(VerifyJacobiSVD<dd>(reportTestCases, "Trefethen_20", 10.0, 6.308860e+01), "dd", "Jacobi SVD Trefethen_20");
+#endif
+
+#if REGRESSION_LEVEL_4
+	nrOfFailedTestCases += ReportTestResult(VerifyJacobiSVD<dd>(reportTestCases, "pores_1", 10.0, 1.812616e+06), "dd", "Jacobi SVD pores_1");
+#endif
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return (nrOfFailedTestCases == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_arithmetic_exception& err) {
+	std::cerr << "Uncaught universal arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_internal_exception& err) {
+	std::cerr << "Uncaught universal internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
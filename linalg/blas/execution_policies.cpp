@@ -0,0 +1,150 @@
+// execution_policies.cpp: verify the serial, parallel, and parallel deterministic BLAS kernels
+//
+// Copyright (C) 2017-2023 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <random>
+// configure posit environment using fast posits
+#define POSIT_FAST_POSIT_16_1 1
+#include <universal/number/posit/posit.hpp>
+#include <universal/number/cfloat/cfloat.hpp>
+#include <universal/blas/blas.hpp>
+#include <universal/verification/test_suite.hpp>
+
+template<typename Scalar>
+void RandomFill(sw::universal::blas::vector<Scalar>& v, std::mt19937_64& generator) {
+	std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+	for (size_t i = 0; i < size(v); ++i) v[i] = Scalar(distribution(generator));
+}
+
+// the ParallelDeterministic reductions must yield the same bits for every thread count,
+// and the Serial policy must yield the legacy left-to-right result
+template<typename Scalar>
+int VerifyReductions(bool reportTestCases, size_t N) {
+	using namespace sw::universal;
+	using namespace sw::universal::blas;
+	std::mt19937_64 generator(17);
+	vector<Scalar> x(N), y(N);
+	RandomFill(x, generator);
+	RandomFill(y, generator);
+
+	int nrOfFailedTests = 0;
+	if (dot(ExecutionPolicy::Serial, x, y) != dot(x, y)) ++nrOfFailedTests;
+	if (dot(ExecutionPolicy::Serial, N / 2, x, 2, y, 2) != dot(N / 2, x, 2, y, 2)) ++nrOfFailedTests;
+	if (asum(ExecutionPolicy::Serial, N, x) != asum(N, x)) ++nrOfFailedTests;
+
+	Scalar dotReference  = dot(ExecutionPolicy::ParallelDeterministic, x, y, 1);
+	Scalar asumReference = asum(ExecutionPolicy::ParallelDeterministic, N, x, 1, 1);
+	for (unsigned nrThreads = 2; nrThreads <= 8; ++nrThreads) {
+		Scalar d = dot(ExecutionPolicy::ParallelDeterministic, x, y, nrThreads);
+		if (d != dotReference) {
+			++nrOfFailedTests;
+			if (reportTestCases) std::cerr << "FAIL: dot with " << nrThreads << " threads " << d << " != " << dotReference << '\n';
+		}
+		Scalar a = asum(ExecutionPolicy::ParallelDeterministic, N, x, 1, nrThreads);
+		if (a != asumReference) {
+			++nrOfFailedTests;
+			if (reportTestCases) std::cerr << "FAIL: asum with " << nrThreads << " threads " << a << " != " << asumReference << '\n';
+		}
+	}
+	return nrOfFailedTests;
+}
+
+// kernels without a reduction must yield the serial result under every policy and thread count
+template<typename Scalar>
+int VerifyElementwise(bool reportTestCases, size_t N) {
+	using namespace sw::universal;
+	using namespace sw::universal::blas;
+	std::mt19937_64 generator(31);
+	vector<Scalar> x(N), y(N);
+	RandomFill(x, generator);
+	RandomFill(y, generator);
+	size_t rows = N / 64, cols = 64;
+	matrix<Scalar> A(rows, cols);
+	for (size_t i = 0; i < rows; ++i) for (size_t j = 0; j < cols; ++j) A(i, j) = x[i * cols + j];
+	vector<Scalar> v(cols);
+	RandomFill(v, generator);
+
+	vector<Scalar> yReference(y), bReference(rows);
+	Scalar alpha(0.5);
+	axpy(N, alpha, x, 1, yReference, 1);
+	scale(N, alpha, yReference, 1);
+	matvec(bReference, A, v);
+	size_t amaxReference = amax(N, x, 3);
+
+	int nrOfFailedTests = 0;
+	if (!(A * v == bReference)) ++nrOfFailedTests;
+	for (unsigned nrThreads = 1; nrThreads <= 8; ++nrThreads) {
+		vector<Scalar> z(y), b;   // matvec sizes b to the rows of A
+		axpy(ExecutionPolicy::Parallel, N, alpha, x, 1, z, 1, nrThreads);
+		scale(ExecutionPolicy::Parallel, N, alpha, z, 1, nrThreads);
+		matvec(ExecutionPolicy::Parallel, b, A, v, nrThreads);
+		if (!(z == yReference) || !(b == bReference) || amax(ExecutionPolicy::Parallel, N, x, 3, nrThreads) != amaxReference) {
+			++nrOfFailedTests;
+			if (reportTestCases) std::cerr << "FAIL: elementwise kernels with " << nrThreads << " threads\n";
+		}
+	}
+	return nrOfFailedTests;
+}
+
+// Regression testing guards: typically set by the cmake configuration, but MANUAL_TESTING is an override
+#define MANUAL_TESTING 0
+// REGRESSION_LEVEL_OVERRIDE is set by the cmake file to drive a specific regression intensity
+// It is the responsibility of the regression test to organize the tests in a quartile progression.
+//#undef REGRESSION_LEVEL_OVERRIDE
+#ifndef REGRESSION_LEVEL_OVERRIDE
+#undef REGRESSION_LEVEL_1
+#undef REGRESSION_LEVEL_2
+#undef REGRESSION_LEVEL_3
+#undef REGRESSION_LEVEL_4
+#define REGRESSION_LEVEL_1 1
+#define REGRESSION_LEVEL_2 1
+#define REGRESSION_LEVEL_3 1
+#define REGRESSION_LEVEL_4 1
+#endif
+
+int main()
+try {
+	using namespace sw::universal;
+
+	std::string test_suite  = "BLAS execution policies";
+	std::string test_tag    = "execution policy";
+	bool reportTestCases    = true;
+	int nrOfFailedTestCases = 0;
+
+	ReportTestSuiteHeader(test_suite, reportTestCases);
+
+	constexpr size_t N = 64 * 1024 + 3;  // not a multiple of the reduction block
+	nrOfFailedTestCases += ReportTestResult(VerifyReductions<float>(reportTestCases, N), "float", "reductions");
+	nrOfFailedTestCases += ReportTestResult(VerifyReductions<double>(reportTestCases, N), "double", "reductions");
+	nrOfFailedTestCases += ReportTestResult(VerifyReductions< cfloat<16, 5, uint16_t, true, false, false> >(reportTestCases, N), "cfloat<16,5>", "reductions");
+	nrOfFailedTestCases += ReportTestResult(VerifyReductions< posit<16, 1> >(reportTestCases, N), "posit<16,1>", "reductions");
+
+	nrOfFailedTestCases += ReportTestResult(VerifyElementwise<float>(reportTestCases, N), "float", "axpy/scale/amax/matvec");
+	nrOfFailedTestCases += ReportTestResult(VerifyElementwise<double>(reportTestCases, N), "double", "axpy/scale/amax/matvec");
+	nrOfFailedTestCases += ReportTestResult(VerifyElementwise< posit<16, 1> >(reportTestCases, N), "posit<16,1>", "axpy/scale/amax/matvec");
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return (nrOfFailedTestCases == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_arithmetic_exception& err) {
+	std::cerr << "Uncaught universal arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_internal_exception& err) {
+	std::cerr << "Uncaught universal internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
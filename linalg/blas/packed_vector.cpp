@@ -0,0 +1,324 @@
+// packed_vector.cpp: verify the packed storage, proxy references, unpack kernels, and dot and axpy of packed vectors
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <random>
+#include <universal/number/cfloat/cfloat.hpp>
+#include <universal/number/posit/posit.hpp>
+#include <universal/number/lns/lns.hpp>
+#include <universal/number/fixpnt/fixpnt.hpp>
+#include <universal/number/takum/takum.hpp>
+#include <universal/blas/blas.hpp>
+#include <universal/verification/test_suite.hpp>
+
+// Regression testing guards: typically set by the cmake configuration, but MANUAL_TESTING is an override
+#define MANUAL_TESTING 0
+// REGRESSION_LEVEL_OVERRIDE is set by the cmake file to drive a specific regression intensity
+// It is the responsibility of the regression test to organize the tests in a quartile progression.
+//#undef REGRESSION_LEVEL_OVERRIDE
+#ifndef REGRESSION_LEVEL_OVERRIDE
+#undef REGRESSION_LEVEL_1
+#undef REGRESSION_LEVEL_2
+#undef REGRESSION_LEVEL_3
+#undef REGRESSION_LEVEL_4
+#define REGRESSION_LEVEL_1 1
+#define REGRESSION_LEVEL_2 1
+#define REGRESSION_LEVEL_3 1
+#define REGRESSION_LEVEL_4 1
+#endif
+
+namespace sw { namespace universal {
+	using fp4e2m1 = cfloat<4, 2, std::uint8_t, true, true, false>;
+	using fp5e2m2 = cfloat<5, 2, std::uint8_t, true, true, false>;
+	using fp6e3m2 = cfloat<6, 3, std::uint8_t, true, true, false>;
+}}
+
+template<typename Scalar>
+void RandomFill(sw::universal::blas::packed_vector<Scalar>& v, std::mt19937_64& generator) {
+	std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+	for (size_t i = 0; i < size(v); ++i) v[i] = Scalar(distribution(generator));
+}
+
+// every encoding is stored and read back, without disturbing its neighbors, and the raw encoding of a value is its bits
+template<typename Scalar>
+int VerifyPacking(size_t N, bool reportTestCases) {
+	using namespace sw::universal;
+	using namespace sw::universal::blas;
+	constexpr unsigned nbits = Scalar::nbits;
+	int nrOfFailedTestCases = 0;
+	auto fail = [&](const std::string& what) {
+		++nrOfFailedTestCases;
+		if (reportTestCases && nrOfFailedTestCases < 10) std::cerr << "FAIL: " << type_tag(Scalar()) << ' ' << what << '\n';
+	};
+	for (uint64_t raw = 0; raw < (uint64_t(1) << nbits); ++raw) {
+		Scalar s;
+		s.setbits(raw);
+		if (packed_encoding(s) != raw) { fail("encoding of " + std::to_string(raw)); break; }
+	}
+
+	packed_vector<Scalar> v(N);
+	if (v.bytes() != (N * nbits + 7) / 8) fail("storage of " + std::to_string(v.bytes()) + " bytes");
+	std::mt19937_64 generator(0x5eed);
+	std::vector<uint32_t> model(N);
+	for (size_t i = 0; i < N; ++i) {
+		model[i] = uint32_t(generator()) & bit_packing<nbits>::mask;
+		v.setencoding(i, model[i]);
+	}
+	// overwrite a random subset through the proxy references
+	for (size_t trial = 0; trial < N; ++trial) {
+		size_t i = generator() % N;
+		Scalar s;
+		s.setbits(generator() & bit_packing<nbits>::mask);
+		v[i] = s;
+		model[i] = packed_encoding(s);
+	}
+	for (size_t i = 0; i < N; ++i) {
+		if (v.encoding(i) != model[i] || packed_encoding(Scalar(v[i])) != model[i]) { fail("element " + std::to_string(i)); break; }
+	}
+	// the encodings of a tile, from a start on and off a group
+	for (size_t first : { size_t(0), size_t(1), size_t(3), size_t(PACKED_TILE) }) {
+		if (first >= N) continue;
+		size_t n = std::min(N - first, size_t(37));
+		std::vector<uint32_t> codes(n);
+		v.unpack(first, n, codes.data());
+		for (size_t k = 0; k < n; ++k) if (codes[k] != model[first + k]) { fail("unpack of the encodings at " + std::to_string(first)); break; }
+		for (size_t k = 0; k < n; ++k) codes[k] = (codes[k] + 1) & bit_packing<nbits>::mask;
+		v.pack(first, n, codes.data());
+		for (size_t k = 0; k < n; ++k) model[first + k] = codes[k];
+	}
+	for (size_t i = 0; i < N; ++i) if (v.encoding(i) != model[i]) { fail("pack of the encodings"); break; }
+	// shrinking clears the bits past the end
+	v.resize(N / 2 + 1);
+	v.resize(N);
+	for (size_t i = N / 2 + 1; i < N; ++i) if (v.encoding(i) != 0) { fail("resize"); break; }
+	return nrOfFailedTestCases;
+}
+
+// the proxy references and the iterators behave as the elements of a vector
+template<typename Scalar>
+int VerifyReferences(bool reportTestCases) {
+	using namespace sw::universal;
+	using namespace sw::universal::blas;
+	int nrOfFailedTestCases = 0;
+	packed_vector<Scalar> v = { Scalar(0.5), Scalar(1.0), Scalar(1.5), Scalar(2.0), Scalar(-1.0) };
+	v[0] = v[3];
+	v[1] += Scalar(0.5);
+	v[2] *= Scalar(2.0);
+	v[4] -= Scalar(1.0);
+	Scalar expected[] = { Scalar(2.0), Scalar(1.0) + Scalar(0.5), Scalar(1.5) * Scalar(2.0), Scalar(2.0), Scalar(-1.0) - Scalar(1.0) };
+	size_t i{ 0 };
+	const packed_vector<Scalar>& c = v;
+	for (Scalar s : c) {
+		if (s != expected[i]) {
+			++nrOfFailedTestCases;
+			if (reportTestCases) std::cerr << "FAIL: " << type_tag(Scalar()) << " element " << i << " is " << s << " instead of " << expected[i] << '\n';
+		}
+		++i;
+	}
+	for (auto r : v) r = Scalar(1.0);
+	for (size_t k = 0; k < size(v); ++k) if (v[k] != Scalar(1.0)) { ++nrOfFailedTestCases; break; }
+	// a blas::vector converts to a packed_vector
+	blas::vector<Scalar> w = { Scalar(0.5), Scalar(-0.25) };
+	packed_vector<Scalar> p(w);
+	if (p[0] != w[0] || p[1] != w[1]) ++nrOfFailedTestCases;
+	return nrOfFailedTestCases;
+}
+
+// the values of a tile are the values of its elements, and values pack to the elements they round to
+template<typename Scalar>
+int VerifyUnpack(size_t N, bool reportTestCases) {
+	using namespace sw::universal;
+	using namespace sw::universal::blas;
+	int nrOfFailedTestCases = 0;
+	std::mt19937_64 generator(0x5eed);
+	packed_vector<Scalar> v(N);
+	RandomFill(v, generator);
+	std::vector<double> values(N);
+	std::vector<float> floats(N);
+	for (size_t first : { size_t(0), size_t(1), size_t(5) }) {
+		v.unpack(first, N - first, values.data());
+		v.unpack(first, N - first, floats.data());
+		for (size_t k = 0; k + first < N; ++k) {
+			double expected = double(v[first + k]);
+			if (values[k] != expected || floats[k] != float(expected)) {
+				++nrOfFailedTestCases;
+				if (reportTestCases) std::cerr << "FAIL: " << type_tag(Scalar()) << " unpack of element " << first + k << '\n';
+				break;
+			}
+		}
+	}
+	std::uniform_real_distribution<double> distribution(-4.0, 4.0);
+	for (auto& x : values) x = distribution(generator);
+	v.pack(3, N - 3, values.data());
+	for (size_t k = 0; k + 3 < N; ++k) {
+		if (v.encoding(3 + k) != packed_encoding(Scalar(values[k]))) {
+			++nrOfFailedTestCases;
+			if (reportTestCases) std::cerr << "FAIL: " << type_tag(Scalar()) << " pack of " << values[k] << '\n';
+			break;
+		}
+	}
+	return nrOfFailedTestCases;
+}
+
+// dot rounds the sum of the products of the values once, and the products of narrow formats sum exactly in double,
+// so every policy and thread count yields the rounding of the exact dot product
+template<typename Scalar>
+int VerifyDot(size_t N, bool reportTestCases) {
+	using namespace sw::universal;
+	using namespace sw::universal::blas;
+	int nrOfFailedTestCases = 0;
+	std::mt19937_64 generator(0x5eed);
+	packed_vector<Scalar> x(N), y(N);
+	RandomFill(x, generator);
+	RandomFill(y, generator);
+	double exact{ 0 };
+	for (size_t i = 0; i < N; ++i) exact += double(x[i]) * double(y[i]);
+	Scalar expected(exact);
+	if (!isfinite(expected)) {
+		++nrOfFailedTestCases;
+		if (reportTestCases) std::cerr << "FAIL: " << type_tag(Scalar()) << " dot of " << exact << " is outside of the range of the format\n";
+	}
+	auto check = [&](Scalar result, const std::string& what) {
+		if (result != expected) {
+			++nrOfFailedTestCases;
+			if (reportTestCases) std::cerr << "FAIL: " << type_tag(Scalar()) << ' ' << what << " dot " << result << " instead of " << expected << '\n';
+		}
+	};
+	check(dot(x, y), "serial");
+	for (unsigned threads : { 1u, 2u, 3u }) {
+		check(dot(ExecutionPolicy::Parallel, x, y, threads), "parallel");
+		check(dot(ExecutionPolicy::ParallelDeterministic, x, y, threads), "deterministic");
+	}
+	return nrOfFailedTestCases;
+}
+
+// axpy rounds a * x + y once per element, for unit and non-unit strides and under every policy
+template<typename Scalar>
+int VerifyAxpy(size_t N, bool reportTestCases) {
+	using namespace sw::universal;
+	using namespace sw::universal::blas;
+	int nrOfFailedTestCases = 0;
+	std::mt19937_64 generator(0x5eed);
+	packed_vector<Scalar> x(N), y(N);
+	RandomFill(x, generator);
+	RandomFill(y, generator);
+	Scalar a(0.75);
+	auto reference = [&](size_t n, size_t incx, size_t incy) {
+		packed_vector<Scalar> z(y);
+		for (size_t k = 0; k < n && k * incx < N && k * incy < N; ++k) z[k * incy] = Scalar(double(a) * double(x[k * incx]) + double(z[k * incy]));
+		return z;
+	};
+	auto check = [&](const packed_vector<Scalar>& result, const packed_vector<Scalar>& expected, const std::string& what) {
+		for (size_t i = 0; i < N; ++i) {
+			if (result.encoding(i) != expected.encoding(i)) {
+				++nrOfFailedTestCases;
+				if (reportTestCases) std::cerr << "FAIL: " << type_tag(Scalar()) << ' ' << what << " axpy element " << i << " is " << result[i] << " instead of " << expected[i] << '\n';
+				return;
+			}
+		}
+	};
+	packed_vector<Scalar> expected = reference(N, 1, 1);
+	{
+		packed_vector<Scalar> z(y);
+		axpy(N, a, x, 1, z, 1);
+		check(z, expected, "serial");
+	}
+	for (unsigned threads : { 2u, 3u }) {
+		packed_vector<Scalar> z(y);
+		axpy(ExecutionPolicy::Parallel, N, a, x, 1, z, 1, threads);
+		check(z, expected, "parallel");
+	}
+	{
+		packed_vector<Scalar> z(y);
+		axpy(N / 2, a, x, 2, z, 1);
+		check(z, reference(N / 2, 2, 1), "strided");
+	}
+	return nrOfFailedTestCases;
+}
+
+int main()
+try {
+	using namespace sw::universal;
+
+	std::string test_suite  = "packed vector";
+	std::string test_tag    = "packed_vector";
+	bool reportTestCases    = true;
+	int nrOfFailedTestCases = 0;
+
+	ReportTestSuiteHeader(test_suite, reportTestCases);
+
+#if MANUAL_TESTING
+
+	blas::packed_vector<fp4e2m1> v = { fp4e2m1(0.5), fp4e2m1(1.0), fp4e2m1(1.5) };
+	std::cout << v << " in " << v.bytes() << " bytes\n";
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return EXIT_SUCCESS;
+#else
+
+#if REGRESSION_LEVEL_1
+	nrOfFailedTestCases += ReportTestResult(VerifyPacking<fp4e2m1>(1000, reportTestCases), type_tag(fp4e2m1()), "packing");
+	nrOfFailedTestCases += ReportTestResult(VerifyPacking<fp5e2m2>(1000, reportTestCases), type_tag(fp5e2m2()), "packing");
+	nrOfFailedTestCases += ReportTestResult(VerifyPacking<fp6e3m2>(1000, reportTestCases), type_tag(fp6e3m2()), "packing");
+	nrOfFailedTestCases += ReportTestResult(VerifyPacking<posit<6, 1>>(1000, reportTestCases), type_tag(posit<6, 1>()), "packing");
+	nrOfFailedTestCases += ReportTestResult(VerifyPacking<posit<8, 2>>(1000, reportTestCases), type_tag(posit<8, 2>()), "packing");
+	nrOfFailedTestCases += ReportTestResult(VerifyPacking<lns<6, 2>>(1000, reportTestCases), type_tag(lns<6, 2>()), "packing");
+	nrOfFailedTestCases += ReportTestResult(VerifyPacking<fixpnt<4, 2>>(1000, reportTestCases), type_tag(fixpnt<4, 2>()), "packing");
+	nrOfFailedTestCases += ReportTestResult(VerifyPacking<takum<8>>(1000, reportTestCases), type_tag(takum<8>()), "packing");
+	nrOfFailedTestCases += ReportTestResult(VerifyPacking<posit<12, 1>>(1000, reportTestCases), type_tag(posit<12, 1>()), "packing");
+
+	nrOfFailedTestCases += ReportTestResult(VerifyReferences<fp6e3m2>(reportTestCases), type_tag(fp6e3m2()), "proxy references");
+	nrOfFailedTestCases += ReportTestResult(VerifyReferences<posit<6, 1>>(reportTestCases), type_tag(posit<6, 1>()), "proxy references");
+
+	nrOfFailedTestCases += ReportTestResult(VerifyUnpack<fp4e2m1>(1000, reportTestCases), type_tag(fp4e2m1()), "unpack");
+	nrOfFailedTestCases += ReportTestResult(VerifyUnpack<posit<6, 1>>(1000, reportTestCases), type_tag(posit<6, 1>()), "unpack");
+	nrOfFailedTestCases += ReportTestResult(VerifyUnpack<lns<8, 3>>(1000, reportTestCases), type_tag(lns<8, 3>()), "unpack");
+
+	nrOfFailedTestCases += ReportTestResult(VerifyDot<fp8e4m3>(10000, reportTestCases), type_tag(fp8e4m3()), "dot");
+	nrOfFailedTestCases += ReportTestResult(VerifyDot<fp6e3m2>(2500, reportTestCases), type_tag(fp6e3m2()), "dot");
+	nrOfFailedTestCases += ReportTestResult(VerifyDot<posit<6, 1>>(10000, reportTestCases), type_tag(posit<6, 1>()), "dot");
+
+	nrOfFailedTestCases += ReportTestResult(VerifyAxpy<fp6e3m2>(10000, reportTestCases), type_tag(fp6e3m2()), "axpy");
+	nrOfFailedTestCases += ReportTestResult(VerifyAxpy<posit<6, 1>>(10000, reportTestCases), type_tag(posit<6, 1>()), "axpy");
+#endif
+
+#if REGRESSION_LEVEL_2
+	nrOfFailedTestCases += ReportTestResult(VerifyDot<posit<8, 2>>(100000, reportTestCases), type_tag(posit<8, 2>()), "dot");
+	nrOfFailedTestCases += ReportTestResult(VerifyAxpy<posit<8, 2>>(100000, reportTestCases), type_tag(posit<8, 2>()), "axpy");
+#endif
+
+#if REGRESSION_LEVEL_3
+
+#endif
+
+#if REGRESSION_LEVEL_4
+
+#endif
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+#endif
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_arithmetic_exception& err) {
+	std::cerr << "Uncaught universal arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_internal_exception& err) {
+	std::cerr << "Uncaught universal internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
@@ -0,0 +1,238 @@
+// reproducible.cpp: verify that the binned BLAS reductions are bitwise reproducible and accurate
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <algorithm>
+#include <random>
+#include <universal/number/cfloat/cfloat.hpp>
+#include <universal/number/dd/dd.hpp>
+#include <universal/number/float/kulisch.hpp>
+#include <universal/blas/blas.hpp>
+#include <universal/verification/test_suite.hpp>
+
+// values over 40 binades, or 10 for a small format, with pairs that cancel to stress the order dependence of a rounded sum
+template<typename Scalar>
+void RandomFill(sw::universal::blas::vector<Scalar>& v, std::mt19937_64& generator) {
+	std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+	constexpr bool small = std::numeric_limits<Scalar>::max_exponent < 64;
+	for (size_t i = 0; i < size(v); ++i) {
+		v[i] = Scalar(small ? std::ldexp(distribution(generator), int(i % 11) - 10) : std::ldexp(distribution(generator), int(i % 41) - 20));
+		if (i % 7 == 6) v[i] = -v[i - 3];
+	}
+}
+
+template<typename Scalar>
+bool SameBits(const Scalar& a, const Scalar& b) {
+	if constexpr (std::is_floating_point_v<Scalar>) return (a == b && std::signbit(a) == std::signbit(b)) || (std::isnan(a) && std::isnan(b));
+	else if constexpr (sw::universal::blas::double_double<Scalar>) return a.high() == b.high() && a.low() == b.low();
+	else return a == b;
+}
+
+template<typename Scalar>
+int ReportReduction(bool reportTestCases, const std::string& label, const Scalar& result, const Scalar& reference) {
+	if (SameBits(result, reference)) return 0;
+	if (reportTestCases) std::cerr << "FAIL: " << label << ' ' << result << " != " << reference << '\n';
+	return 1;
+}
+
+// sum, asum, dot, and nrm2 must produce the same bits on any number of threads and for any permutation of the elements
+template<typename Scalar>
+int VerifyReproducibility(bool reportTestCases, size_t N) {
+	using namespace sw::universal::blas;
+	std::mt19937_64 generator(17);
+	vector<Scalar> x(N), y(N);
+	RandomFill(x, generator);
+	RandomFill(y, generator);
+
+	Scalar sumReference  = reproducible_sum(x, 1);
+	Scalar asumReference = reproducible_asum(x, 1);
+	Scalar dotReference  = reproducible_dot(x, y, 1);
+	Scalar nrm2Reference = reproducible_nrm2(x, 1);
+	int nrOfFailedTests = 0;
+	for (unsigned nrThreads = 2; nrThreads <= 8; ++nrThreads) {
+		std::string threads = " with " + std::to_string(nrThreads) + " threads";
+		nrOfFailedTests += ReportReduction(reportTestCases, "sum" + threads, reproducible_sum(x, nrThreads), sumReference);
+		nrOfFailedTests += ReportReduction(reportTestCases, "asum" + threads, reproducible_asum(x, nrThreads), asumReference);
+		nrOfFailedTests += ReportReduction(reportTestCases, "dot" + threads, reproducible_dot(x, y, nrThreads), dotReference);
+		nrOfFailedTests += ReportReduction(reportTestCases, "nrm2" + threads, reproducible_nrm2(x, nrThreads), nrm2Reference);
+	}
+	std::vector<size_t> order(N);
+	for (size_t i = 0; i < N; ++i) order[i] = i;
+	for (int permutation = 0; permutation < 3; ++permutation) {
+		std::shuffle(order.begin(), order.end(), generator);
+		vector<Scalar> px(N), py(N);
+		for (size_t i = 0; i < N; ++i) { px[i] = x[order[i]]; py[i] = y[order[i]]; }
+		unsigned nrThreads = 1u + unsigned(permutation) * 3u;
+		nrOfFailedTests += ReportReduction(reportTestCases, "sum of a permutation", reproducible_sum(px, nrThreads), sumReference);
+		nrOfFailedTests += ReportReduction(reportTestCases, "dot of a permutation", reproducible_dot(px, py, nrThreads), dotReference);
+	}
+	return nrOfFailedTests;
+}
+
+// the rows of gemv must not depend on the number of threads or on the order of the columns
+template<typename Scalar>
+int VerifyGemv(bool reportTestCases, size_t rows, size_t cols) {
+	using namespace sw::universal::blas;
+	std::mt19937_64 generator(31);
+	vector<Scalar> data(rows * cols), x(cols), y0(rows);
+	RandomFill(data, generator);
+	RandomFill(x, generator);
+	RandomFill(y0, generator);
+	std::vector<size_t> order(cols);
+	for (size_t j = 0; j < cols; ++j) order[j] = j;
+	std::shuffle(order.begin(), order.end(), generator);
+	matrix<Scalar> A(rows, cols), P(rows, cols);
+	vector<Scalar> px(cols);
+	for (size_t i = 0; i < rows; ++i) for (size_t j = 0; j < cols; ++j) {
+		A(i, j) = data[i * cols + j];
+		P(i, j) = data[i * cols + order[j]];
+	}
+	for (size_t j = 0; j < cols; ++j) px[j] = x[order[j]];
+
+	Scalar alpha(0.5), beta(-2.0);
+	vector<Scalar> reference(y0);
+	reproducible_gemv(alpha, A, x, beta, reference, 1);
+	int nrOfFailedTests = 0;
+	for (unsigned nrThreads = 2; nrThreads <= 8; nrThreads += 3) {
+		vector<Scalar> y(y0), py(y0);
+		reproducible_gemv(alpha, A, x, beta, y, nrThreads);
+		reproducible_gemv(alpha, P, px, beta, py, nrThreads);
+		for (size_t i = 0; i < rows; ++i) {
+			nrOfFailedTests += ReportReduction(reportTestCases, "gemv row " + std::to_string(i), y[i], reference[i]);
+			nrOfFailedTests += ReportReduction(reportTestCases, "gemv row with permuted columns " + std::to_string(i), py[i], reference[i]);
+			if (nrOfFailedTests > 0) return nrOfFailedTests;
+		}
+	}
+	return nrOfFailedTests;
+}
+
+// the binned sum is within an ulp of the correctly rounded sum, which the fused dot product computes
+template<typename Real>
+int VerifyAccuracy(bool reportTestCases, size_t N) {
+	using namespace sw::universal;
+	using namespace sw::universal::blas;
+	std::mt19937_64 generator(5);
+	vector<Real> x(N), y(N);
+	RandomFill(x, generator);
+	RandomFill(y, generator);
+	std::vector<double> dx(N), dy(N);
+	for (size_t i = 0; i < N; ++i) { dx[i] = double(x[i]) * double(y[i]); dy[i] = 1.0; }
+	// the float products of the binned dot product are rounded, so the reference sums the rounded products
+	if constexpr (std::is_same_v<Real, float>) for (size_t i = 0; i < N; ++i) dx[i] = double(x[i] * y[i]);
+	Real expected = Real(fdp(dx.data(), dy.data(), N));
+	Real result = reproducible_dot(x, y);
+	if (std::abs(result - expected) <= std::abs(expected) * std::numeric_limits<Real>::epsilon()) return 0;
+	if (reportTestCases) std::cerr << "FAIL: binned dot " << result << " is not within an ulp of " << expected << '\n';
+	return 1;
+}
+
+// catastrophic cancellation, the extremes of the exponent range, and the special values
+template<typename Real>
+int VerifySpecialCases(bool reportTestCases) {
+	using namespace sw::universal;
+	using limits = std::numeric_limits<Real>;
+	Real one(1), big = limits::max(), tiny = limits::denorm_min(), inf = limits::infinity();
+	Real eps = limits::epsilon(), large = std::ldexp(one, limits::digits);
+	struct Case { std::vector<Real> terms; Real expected; const char* label; };
+	const Case cases[] = {
+		{ { large, one, -large }, one, "cancellation" },
+		{ { one, eps / 4, eps / 4, -one }, eps / 2, "terms below the ulp of the running sum" },
+		{ { big, big / 2, -big }, big / 2, "largest values" },
+		{ { big, big }, inf, "overflow" },
+		{ { tiny, tiny, tiny }, 3 * tiny, "subnormals" },
+		{ { inf, one }, inf, "infinity" },
+		{ { inf, -inf }, limits::quiet_NaN(), "inf - inf" },
+		{ { limits::quiet_NaN(), one }, limits::quiet_NaN(), "nan" },
+		{ {}, Real(0), "empty" },
+	};
+	int nrOfFailedTests = 0;
+	for (const Case& c : cases) {
+		binned_accumulator<Real> forward, reverse;
+		for (Real t : c.terms) forward += t;
+		for (auto t = c.terms.rbegin(); t != c.terms.rend(); ++t) reverse += *t;
+		nrOfFailedTests += ReportReduction(reportTestCases, c.label, forward.value(), c.expected);
+		nrOfFailedTests += ReportReduction(reportTestCases, std::string(c.label) + " in reverse", reverse.value(), c.expected);
+	}
+	return nrOfFailedTests;
+}
+
+// Regression testing guards: typically set by the cmake configuration, but MANUAL_TESTING is an override
+#define MANUAL_TESTING 0
+// REGRESSION_LEVEL_OVERRIDE is set by the cmake file to drive a specific regression intensity
+// It is the responsibility of the regression test to organize the tests in a quartile progression.
+//#undef REGRESSION_LEVEL_OVERRIDE
+#ifndef REGRESSION_LEVEL_OVERRIDE
+#undef REGRESSION_LEVEL_1
+#undef REGRESSION_LEVEL_2
+#undef REGRESSION_LEVEL_3
+#undef REGRESSION_LEVEL_4
+#define REGRESSION_LEVEL_1 1
+#define REGRESSION_LEVEL_2 1
+#define REGRESSION_LEVEL_3 1
+#define REGRESSION_LEVEL_4 1
+#endif
+
+int main()
+try {
+	using namespace sw::universal;
+
+	std::string test_suite  = "BLAS reproducible reductions";
+	std::string test_tag    = "reproducible";
+	bool reportTestCases    = true;
+	int nrOfFailedTestCases = 0;
+
+	ReportTestSuiteHeader(test_suite, reportTestCases);
+
+	constexpr size_t N = 64 * 1024 + 3;
+
+#if REGRESSION_LEVEL_1
+	nrOfFailedTestCases += ReportTestResult(VerifySpecialCases<float>(reportTestCases), "float", "special cases");
+	nrOfFailedTestCases += ReportTestResult(VerifySpecialCases<double>(reportTestCases), "double", "special cases");
+	nrOfFailedTestCases += ReportTestResult(VerifyReproducibility<float>(reportTestCases, N), "float", "reproducibility");
+	nrOfFailedTestCases += ReportTestResult(VerifyReproducibility<double>(reportTestCases, N), "double", "reproducibility");
+	nrOfFailedTestCases += ReportTestResult(VerifyAccuracy<float>(reportTestCases, N), "float", "accuracy");
+	nrOfFailedTestCases += ReportTestResult(VerifyAccuracy<double>(reportTestCases, N), "double", "accuracy");
+#endif
+
+#if REGRESSION_LEVEL_2
+	using Cfloat = cfloat<16, 5, uint16_t, true, false, false>;
+	nrOfFailedTestCases += ReportTestResult(VerifyReproducibility<Cfloat>(reportTestCases, N), "cfloat<16,5>", "reproducibility");
+	nrOfFailedTestCases += ReportTestResult(VerifyReproducibility<dd>(reportTestCases, N), "dd", "reproducibility");
+	nrOfFailedTestCases += ReportTestResult(VerifyGemv<double>(reportTestCases, 64, 1024), "double", "gemv");
+	nrOfFailedTestCases += ReportTestResult(VerifyGemv<dd>(reportTestCases, 64, 1024), "dd", "gemv");
+#endif
+
+#if REGRESSION_LEVEL_3
+	nrOfFailedTestCases += ReportTestResult(VerifyReproducibility<double>(reportTestCases, 1024 * 1024), "double", "reproducibility");
+#endif
+
+#if REGRESSION_LEVEL_4
+	nrOfFailedTestCases += ReportTestResult(VerifyReproducibility<float>(reportTestCases, 1024 * 1024), "float", "reproducibility");
+#endif
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return (nrOfFailedTestCases == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_arithmetic_exception& err) {
+	std::cerr << "Uncaught universal arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_internal_exception& err) {
+	std::cerr << "Uncaught universal internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
@@ -0,0 +1,249 @@
+// stencil.cpp: verify the matrix-free stencil operators and their relaxation solvers
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <chrono>
+#include <universal/number/posit/posit.hpp>
+#include <universal/number/cfloat/cfloat.hpp>
+#include <universal/blas/blas.hpp>
+#include <universal/blas/solvers/jacobi.hpp>
+#include <universal/blas/solvers/gauss_seidel.hpp>
+#include <universal/blas/solvers/sor.hpp>
+#include <universal/blas/solvers/cg.hpp>
+#include <universal/verification/test_suite.hpp>
+
+// the 2D Laplace stencil must be the matrix of laplace2D, element by element and in its product with a vector
+template<typename Scalar>
+int VerifyLaplaceOperator(bool reportTestCases, size_t m, size_t n) {
+	using namespace sw::universal::blas;
+	matrix<Scalar> A;
+	laplace2D(A, m, n);
+	stencil<Scalar> S = laplace_stencil<Scalar>(m, n);
+	int nrOfFailedTests = 0;
+	if (num_rows(S) != num_rows(A) || num_cols(S) != num_cols(A)) return 1;
+	for (size_t i = 0; i < num_rows(A); ++i) {
+		for (size_t j = 0; j < num_cols(A); ++j) {
+			if (S(i, j) != A(i, j)) {
+				++nrOfFailedTests;
+				if (reportTestCases) std::cerr << "FAIL: stencil element (" << i << ',' << j << ") is " << S(i, j) << " instead of " << A(i, j) << '\n';
+				return nrOfFailedTests;
+			}
+		}
+	}
+	vector<Scalar> x(num_cols(A));
+	for (size_t i = 0; i < size(x); ++i) x[i] = Scalar(std::sin(0.37 * double(i)));
+	if (!(S * x == A * x)) {
+		++nrOfFailedTests;
+		if (reportTestCases) std::cerr << "FAIL: stencil product differs from the dense product of laplace2D(" << m << ", " << n << ")\n";
+	}
+	return nrOfFailedTests;
+}
+
+// the 3D Laplace stencil against the explicit 7-point sum
+template<typename Scalar>
+int VerifyLaplace3D(bool reportTestCases, size_t l, size_t m, size_t n) {
+	using namespace sw::universal::blas;
+	stencil<Scalar> S = laplace_stencil<Scalar>(l, m, n);
+	vector<Scalar> x(l * m * n);
+	for (size_t i = 0; i < size(x); ++i) x[i] = Scalar(std::cos(0.11 * double(i)));
+	vector<Scalar> y = S * x;
+	int nrOfFailedTests = 0;
+	for (size_t h = 0; h < l; ++h) {
+		for (size_t i = 0; i < m; ++i) {
+			for (size_t j = 0; j < n; ++j) {
+				size_t row = (h * m + i) * n + j;
+				Scalar sum(0);
+				if (h > 0) sum -= x[row - m * n];
+				if (i > 0) sum -= x[row - n];
+				if (j > 0) sum -= x[row - 1];
+				sum += Scalar(6) * x[row];
+				if (j + 1 < n) sum -= x[row + 1];
+				if (i + 1 < m) sum -= x[row + n];
+				if (h + 1 < l) sum -= x[row + m * n];
+				if (std::abs(double(sum) - double(y[row])) > 8.0 * double(std::numeric_limits<Scalar>::epsilon())) {
+					++nrOfFailedTests;
+					if (reportTestCases) std::cerr << "FAIL: 3D stencil row " << row << " is " << y[row] << " instead of " << sum << '\n';
+					return nrOfFailedTests;
+				}
+			}
+		}
+	}
+	return nrOfFailedTests;
+}
+
+// Jacobi, red-black Gauss-Seidel, and SOR must converge to the solution of A x = b for a known x,
+// SOR with the optimal relaxation factor in fewer iterations, and the iterates must not depend on the number of threads
+template<typename Scalar>
+int VerifyRelaxation(bool reportTestCases, size_t m, size_t n, double tolerance) {
+	using namespace sw::universal::blas;
+	stencil<Scalar> A = laplace_stencil<Scalar>(m, n);
+	vector<Scalar> solution(m * n);
+	for (size_t i = 0; i < m; ++i) {
+		for (size_t j = 0; j < n; ++j) solution[i * n + j] = Scalar(double(i) / double(m) - double(j * j) / double(n * n));
+	}
+	vector<Scalar> b = A * solution;
+	auto error = [&](const vector<Scalar>& x) {
+		double e{ 0 };
+		for (size_t i = 0; i < size(x); ++i) e = std::max(e, std::abs(double(x[i]) - double(solution[i])));
+		return e;
+	};
+	double w = 2.0 / (1.0 + std::sin(3.14159265358979323846 / double(std::max(m, n) + 1)));
+
+	// the updates stagnate at the rounding noise of the sweeps, which bounds the update tolerance from below
+	Scalar updateTolerance = Scalar(std::max(tolerance / 1.0e4, 64.0 * double(std::numeric_limits<Scalar>::epsilon())));
+
+	int nrOfFailedTests = 0;
+	vector<Scalar> xj(m * n, Scalar(0)), xg(m * n, Scalar(0)), xs(m * n, Scalar(0));
+	size_t itrJacobi = Jacobi<Scalar, 100000>(A, b, xj, updateTolerance);
+	size_t itrGaussSeidel = GaussSeidel<Scalar, 100000>(A, b, xg, updateTolerance);
+	size_t itrSor = sor<Scalar, 100000>(A, b, xs, Scalar(w), updateTolerance);
+	if (error(xj) > tolerance || error(xg) > tolerance || error(xs) > tolerance || !(itrSor < itrGaussSeidel && itrGaussSeidel < itrJacobi)) {
+		++nrOfFailedTests;
+		if (reportTestCases) std::cerr << "FAIL: relaxation on " << m << 'x' << n << " errors " << error(xj) << ' ' << error(xg) << ' ' << error(xs)
+			<< " iterations " << itrJacobi << ' ' << itrGaussSeidel << ' ' << itrSor << '\n';
+	}
+
+	for (unsigned nrThreads : { 1u, 3u, 0u }) {
+		vector<Scalar> x(m * n, Scalar(0)), xnew, y(m * n, Scalar(0)), reference(m * n, Scalar(0)), referenceNew;
+		for (int sweep = 0; sweep < 5; ++sweep) {
+			A.jacobi_sweep(b, x, xnew, Scalar(0.8), nrThreads);
+			std::swap(x, xnew);
+			A.red_black_sweep(b, y, Scalar(w), nrThreads);
+		}
+		vector<Scalar> z(m * n, Scalar(0));
+		for (int sweep = 0; sweep < 5; ++sweep) {
+			A.jacobi_sweep(b, reference, referenceNew, Scalar(0.8), 1);
+			std::swap(reference, referenceNew);
+			A.red_black_sweep(b, z, Scalar(w), 1);
+		}
+		if (!(x == reference) || !(y == z)) {
+			++nrOfFailedTests;
+			if (reportTestCases) std::cerr << "FAIL: relaxation sweeps on " << nrThreads << " threads differ from the serial sweeps\n";
+		}
+	}
+	return nrOfFailedTests;
+}
+
+// conjugate gradients on the stencil must take the iterates of conjugate gradients on the matrix of laplace2D, and the
+// products of the solver must visit the points of the stencil: the dense traversal of the elements of a 128x128 grid
+// is 2.7e8 element evaluations per product, and takes tens of seconds for the iterations the stencil solves in milliseconds
+template<typename Scalar>
+int VerifyConjugateGradients(bool reportTestCases, size_t m, size_t n) {
+	using namespace sw::universal::blas;
+	using namespace std::chrono;
+	constexpr size_t MAX_ITERATIONS = 50;
+	auto rhs = [](size_t rows) {
+		vector<Scalar> b(rows);
+		for (size_t i = 0; i < rows; ++i) b[i] = Scalar(std::sin(0.29 * double(i)));
+		return b;
+	};
+	int nrOfFailedTests = 0;
+
+	size_t rows = m * n;
+	matrix<Scalar> A, M(rows, rows);
+	laplace2D(A, m, n);
+	M = Scalar(1);   // identity preconditioner
+	stencil<Scalar> S = laplace_stencil<Scalar>(m, n), I(n, m, 1, Scalar(1), Scalar(0), Scalar(0), Scalar(0));
+	vector<Scalar> b = rhs(rows), x(rows, Scalar(0)), xs(rows, Scalar(0)), residuals, residualsStencil;
+	cg<matrix<Scalar>, vector<Scalar>, MAX_ITERATIONS>(M, A, b, x, residuals);
+	cg<stencil<Scalar>, vector<Scalar>, MAX_ITERATIONS>(I, S, b, xs, residualsStencil);
+	if (!(residuals[size(residuals) - 1] < Scalar(0.00001))) {
+		++nrOfFailedTests;
+		if (reportTestCases) std::cerr << "FAIL: cg on laplace2D(" << m << ", " << n << ") did not converge\n";
+	}
+	if (!(x == xs) || !(residuals == residualsStencil)) {
+		++nrOfFailedTests;
+		if (reportTestCases) std::cerr << "FAIL: cg on the " << m << 'x' << n << " stencil differs from cg on laplace2D\n";
+	}
+
+	stencil<Scalar> L = laplace_stencil<Scalar>(128, 128), J(128, 128, 1, Scalar(1), Scalar(0), Scalar(0), Scalar(0));
+	b = rhs(L.rows());
+	vector<Scalar> y(L.rows(), Scalar(0));
+	residuals = vector<Scalar>();
+	steady_clock::time_point begin = steady_clock::now();
+	cg<stencil<Scalar>, vector<Scalar>, 25>(J, L, b, y, residuals);
+	double elapsed = duration_cast<duration<double>>(steady_clock::now() - begin).count();
+	if (elapsed > 5.0 || !(residuals[size(residuals) - 1] < residuals[0])) {
+		++nrOfFailedTests;
+		if (reportTestCases) std::cerr << "FAIL: cg on the 128x128 stencil took " << elapsed << " sec for " << size(residuals) << " iterations\n";
+	}
+	return nrOfFailedTests;
+}
+
+// Regression testing guards: typically set by the cmake configuration, but MANUAL_TESTING is an override
+#define MANUAL_TESTING 0
+// REGRESSION_LEVEL_OVERRIDE is set by the cmake file to drive a specific regression intensity
+// It is the responsibility of the regression test to organize the tests in a quartile progression.
+//#undef REGRESSION_LEVEL_OVERRIDE
+#ifndef REGRESSION_LEVEL_OVERRIDE
+#undef REGRESSION_LEVEL_1
+#undef REGRESSION_LEVEL_2
+#undef REGRESSION_LEVEL_3
+#undef REGRESSION_LEVEL_4
+#define REGRESSION_LEVEL_1 1
+#define REGRESSION_LEVEL_2 1
+#define REGRESSION_LEVEL_3 1
+#define REGRESSION_LEVEL_4 1
+#endif
+
+int main()
+try {
+	using namespace sw::universal;
+
+	std::string test_suite  = "BLAS matrix-free stencil operators";
+	std::string test_tag    = "stencil";
+	bool reportTestCases    = true;
+	int nrOfFailedTestCases = 0;
+
+	ReportTestSuiteHeader(test_suite, reportTestCases);
+
+#if REGRESSION_LEVEL_1
+	nrOfFailedTestCases += ReportTestResult(VerifyLaplaceOperator<double>(reportTestCases, 5, 7), "double", "laplace 5x7");
+	nrOfFailedTestCases += ReportTestResult(VerifyLaplaceOperator<double>(reportTestCases, 1, 9), "double", "laplace 1x9");
+	nrOfFailedTestCases += ReportTestResult(VerifyLaplace3D<double>(reportTestCases, 4, 5, 6), "double", "laplace 4x5x6");
+	nrOfFailedTestCases += ReportTestResult(VerifyRelaxation<double>(reportTestCases, 16, 20, 1.0e-8), "double", "relaxation 16x20");
+	nrOfFailedTestCases += ReportTestResult(VerifyConjugateGradients<double>(reportTestCases, 5, 6), "double", "conjugate gradients");
+#endif
+
+#if REGRESSION_LEVEL_2
+	using Posit = posit<32, 2>;
+	using Cfloat = cfloat<32, 8, uint32_t, true, false, false>;
+	nrOfFailedTestCases += ReportTestResult(VerifyLaplaceOperator<Posit>(reportTestCases, 6, 6), "posit<32,2>", "laplace 6x6");
+	nrOfFailedTestCases += ReportTestResult(VerifyLaplaceOperator<Cfloat>(reportTestCases, 6, 6), "cfloat<32,8>", "laplace 6x6");
+	nrOfFailedTestCases += ReportTestResult(VerifyRelaxation<Posit>(reportTestCases, 12, 12, 1.0e-4), "posit<32,2>", "relaxation 12x12");
+#endif
+
+#if REGRESSION_LEVEL_3
+	nrOfFailedTestCases += ReportTestResult(VerifyRelaxation<double>(reportTestCases, 48, 700, 1.0e-8), "double", "relaxation 48x700");
+#endif
+
+#if REGRESSION_LEVEL_4
+	nrOfFailedTestCases += ReportTestResult(VerifyRelaxation<float>(reportTestCases, 40, 40, 1.0e-2), "float", "relaxation 40x40");
+#endif
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return (nrOfFailedTestCases == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_arithmetic_exception& err) {
+	std::cerr << "Uncaught universal arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_internal_exception& err) {
+	std::cerr << "Uncaught universal internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
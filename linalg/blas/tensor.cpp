@@ -0,0 +1,261 @@
+// tensor.cpp: verify the rank-N tensor, its strided views, the fused elementwise operators, and einsum contractions
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <random>
+#include <universal/number/cfloat/cfloat.hpp>
+#include <universal/number/posit/posit.hpp>
+#include <universal/blas/blas.hpp>
+#include <universal/verification/test_suite.hpp>
+
+// small integers, which every scalar type represents and sums exactly
+template<typename Scalar>
+sw::universal::blas::tensor<Scalar> RandomTensor(const sw::universal::blas::tensor_shape& shape, std::mt19937_64& generator) {
+	sw::universal::blas::tensor<Scalar> T(shape);
+	std::uniform_int_distribution<int> distribution(-4, 4);
+	for (auto& e : T) e = Scalar(distribution(generator));
+	return T;
+}
+
+// the contraction by brute force over all values of all letters, through checked element access
+template<typename Scalar>
+sw::universal::blas::tensor<Scalar> ReferenceEinsum(const std::string& a, const std::string& b, const std::string& out,
+	const sw::universal::blas::tensor_view<const Scalar>& A, const sw::universal::blas::tensor_view<const Scalar>& B) {
+	using namespace sw::universal::blas;
+	std::string letters;
+	std::vector<size_t> extents;
+	auto addLetters = [&](const std::string& l, const tensor_view<const Scalar>& v) {
+		for (size_t d = 0; d < l.size(); ++d) {
+			if (letters.find(l[d]) == std::string::npos) { letters += l[d]; extents.push_back(v.extent(unsigned(d))); }
+		}
+	};
+	addLetters(a, A);
+	addLetters(b, B);
+	tensor_shape shape;
+	for (char c : out) shape.push_back(extents[letters.find(c)]);
+	tensor<Scalar> C(shape);
+	std::vector<size_t> value(letters.size(), 0);
+	auto indexOf = [&](const std::string& l) {
+		std::vector<size_t> index;
+		for (char c : l) index.push_back(value[letters.find(c)]);
+		return index;
+	};
+	for (;;) {
+		C.at(indexOf(out)) += A.at(indexOf(a)) * B.at(indexOf(b));
+		size_t d = 0;
+		while (d < letters.size() && ++value[d] == extents[d]) value[d++] = 0;
+		if (d == letters.size()) break;
+	}
+	return C;
+}
+
+// shape, strides, element access, and views that alias the tensor
+template<typename Scalar>
+int VerifyViews(bool reportTestCases) {
+	using namespace sw::universal::blas;
+	int nrOfFailedTests = 0;
+	tensor<Scalar> T({ 2, 3, 4 });
+	if (T.rank() != 3 || T.size() != 24 || T.strides() != tensor_strides{ 12, 4, 1 }) ++nrOfFailedTests;
+	int k = 0;
+	for (auto& e : T) e = Scalar(k++);
+	if (T(1, 2, 3) != Scalar(23) || T.at({ 1, 0, 2 }) != Scalar(14)) ++nrOfFailedTests;
+
+	auto P = T.permute({ 2, 0, 1 });
+	if (P.shape() != tensor_shape{ 4, 2, 3 } || P(3, 1, 2) != T(1, 2, 3) || P.is_contiguous()) ++nrOfFailedTests;
+	auto S = T.view().slice(2, 1, 4, 2);            // T(:, :, [1, 3])
+	if (S.shape() != tensor_shape{ 2, 3, 2 } || S(1, 1, 1) != T(1, 1, 3)) ++nrOfFailedTests;
+	auto R = T.view().select(0, 1).transpose();      // T(1, :, :)'
+	if (R.shape() != tensor_shape{ 4, 3 } || R(2, 1) != T(1, 1, 2)) ++nrOfFailedTests;
+	auto M = T.reshape({ 6, 4 });
+	if (M(5, 3) != T(1, 2, 3)) ++nrOfFailedTests;
+	// writes through a view update the tensor
+	S(0, 2, 0) = Scalar(-1);
+	if (T(0, 2, 1) != Scalar(-1)) ++nrOfFailedTests;
+	S = Scalar(0);
+	if (T(1, 2, 3) != Scalar(0) || T(1, 2, 2) != Scalar(22)) ++nrOfFailedTests;
+	// materializing a view copies it in row-major order
+	tensor<Scalar> C(P);
+	if (C.shape() != P.shape() || C(3, 1, 2) != P(3, 1, 2) || C(0, 1, 0) != T(1, 0, 0)) ++nrOfFailedTests;
+	// a row vector broadcast over the rows
+	tensor<Scalar> v({ 4 }, { Scalar(1), Scalar(2), Scalar(3), Scalar(4) });
+	auto V = v.view().broadcast({ 3, 4 });
+	if (V(2, 3) != Scalar(4) || V.stride(0) != 0) ++nrOfFailedTests;
+	// reshaping a view that is not contiguous throws
+	bool caught = false;
+	try { P.reshape({ 24 }); }
+	catch (const tensor_incompatible_shapes&) { caught = true; }
+	if (!caught) ++nrOfFailedTests;
+	if (nrOfFailedTests > 0 && reportTestCases) std::cerr << "FAIL: tensor views\n" << T;
+	return nrOfFailedTests;
+}
+
+// fused elementwise operators on views of different strides agree with the elementwise loop
+template<typename Scalar>
+int VerifyElementwise(bool reportTestCases) {
+	using namespace sw::universal::blas;
+	int nrOfFailedTests = 0;
+	std::mt19937_64 generator(7);
+	tensor<Scalar> X = RandomTensor<Scalar>({ 5, 7 }, generator), W = RandomTensor<Scalar>({ 7, 5 }, generator), b = RandomTensor<Scalar>({ 7 }, generator);
+	// relu(X + W' + b) in one pass, with a transposed and a broadcast operand
+	auto Y = elementwise([](Scalar x, Scalar w, Scalar c) { Scalar s = x + w + c; return (s > Scalar(0) ? s : Scalar(0)); },
+		X, W.transpose(), b.view().broadcast(X.shape()));
+	Scalar sumOfSquares = elementwise_reduce([](Scalar x, Scalar y) { return Scalar(x * y); }, [](Scalar s, Scalar p) { return Scalar(s + p); }, Scalar(0), X, X);
+	Scalar reference(0);
+	for (size_t i = 0; i < 5; ++i) {
+		for (size_t j = 0; j < 7; ++j) {
+			Scalar s = X(i, j) + W(j, i) + b(j);
+			if (Y(i, j) != (s > Scalar(0) ? s : Scalar(0))) ++nrOfFailedTests;
+			reference += X(i, j) * X(i, j);
+		}
+	}
+	if (sumOfSquares != reference) ++nrOfFailedTests;
+	// elementwise_into writes through a strided view
+	tensor<Scalar> Z({ 7, 5 });
+	elementwise_into(Z.transpose(), [](Scalar x) { return Scalar(x + x); }, X);
+	if (Z(6, 4) != X(4, 6) + X(4, 6)) ++nrOfFailedTests;
+	bool caught = false;
+	try { elementwise([](Scalar x, Scalar y) { return x + y; }, X, W); }
+	catch (const tensor_incompatible_shapes&) { caught = true; }
+	if (!caught) ++nrOfFailedTests;
+	if (nrOfFailedTests > 0 && reportTestCases) std::cerr << "FAIL: fused elementwise operators\n";
+	return nrOfFailedTests;
+}
+
+template<typename Scalar>
+int VerifyContraction(bool reportTestCases, const std::string& spec, const sw::universal::blas::tensor_view<const Scalar>& A, const sw::universal::blas::tensor_view<const Scalar>& B) {
+	using namespace sw::universal::blas;
+	size_t comma = spec.find(','), arrow = spec.find("->");
+	tensor<Scalar> reference = ReferenceEinsum<Scalar>(spec.substr(0, comma), spec.substr(comma + 1, arrow - comma - 1), spec.substr(arrow + 2), A, B);
+	tensor<Scalar> C = einsum(spec, A, B);
+	if (C == reference) return 0;
+	if (reportTestCases) std::cerr << "FAIL: einsum " << spec << '\n' << C << "!=\n" << reference;
+	return 1;
+}
+
+// contractions lowered to the tiled matrix product, and direct ones, on contiguous and strided operands
+template<typename Scalar>
+int VerifyEinsum(bool reportTestCases) {
+	using namespace sw::universal::blas;
+	int nrOfFailedTests = 0;
+	std::mt19937_64 generator(11);
+	tensor<Scalar> A = RandomTensor<Scalar>({ 70, 130 }, generator), B = RandomTensor<Scalar>({ 130, 45 }, generator);
+	nrOfFailedTests += VerifyContraction<Scalar>(reportTestCases, "ij,jk->ik", A, B);
+	nrOfFailedTests += VerifyContraction<Scalar>(reportTestCases, "ji,jk->ki", A.transpose(), B);       // transposed operand and output
+	nrOfFailedTests += VerifyContraction<Scalar>(reportTestCases, "ij,kj->ik", A.view().slice(0, 3, 70, 3), A.view().slice(1, 0, 130)); // strided rows
+	tensor<Scalar> X = RandomTensor<Scalar>({ 3, 5, 6 }, generator), Y = RandomTensor<Scalar>({ 3, 6, 4 }, generator);
+	nrOfFailedTests += VerifyContraction<Scalar>(reportTestCases, "bij,bjk->bik", X, Y);
+	nrOfFailedTests += VerifyContraction<Scalar>(reportTestCases, "bij,bjk->kib", X, Y);
+	nrOfFailedTests += VerifyContraction<Scalar>(reportTestCases, "ijk,ikl->jl", X, Y);
+	nrOfFailedTests += VerifyContraction<Scalar>(reportTestCases, "ijk,lkm->ijlm", X, Y);
+	nrOfFailedTests += VerifyContraction<Scalar>(reportTestCases, "ijk,imn->j", X, Y);                 // summed-out letters
+	nrOfFailedTests += VerifyContraction<Scalar>(reportTestCases, "ijk,ijk->", X, X);                  // full contraction
+	nrOfFailedTests += VerifyContraction<Scalar>(reportTestCases, "ijj,ijl->il", X.view().slice(2, 0, 5), Y.view().slice(1, 0, 5)); // diagonal
+	tensor<Scalar> u = RandomTensor<Scalar>({ 9 }, generator), v = RandomTensor<Scalar>({ 11 }, generator);
+	nrOfFailedTests += VerifyContraction<Scalar>(reportTestCases, "i,j->ij", u, v);
+
+	// single operand contractions and the implicit output
+	tensor<Scalar> S = RandomTensor<Scalar>({ 6, 6 }, generator);
+	Scalar trace(0);
+	for (size_t i = 0; i < 6; ++i) trace += S(i, i);
+	if (einsum("ii->", S)() != trace || einsum("ii->i", S)(4) != S(4, 4) || einsum("ij->ji", S) != tensor<Scalar>(S.transpose())) ++nrOfFailedTests;
+	if (einsum("ij,jk", A, B) != einsum("ij,jk->ik", A, B) || einsum("ij->i", S)(2) != S(2, 0) + S(2, 1) + S(2, 2) + S(2, 3) + S(2, 4) + S(2, 5)) ++nrOfFailedTests;
+	bool caught = false;
+	try { einsum("ij,jk->ik", A, A); }
+	catch (const tensor_incompatible_shapes&) { caught = true; }
+	if (!caught) ++nrOfFailedTests;
+	if (nrOfFailedTests > 0 && reportTestCases) std::cerr << "FAIL: einsum\n";
+	return nrOfFailedTests;
+}
+
+// the tiled product accumulates every element in the order of the triple loop: the bits match the matrix product
+int VerifyTiledGemmOrder(bool reportTestCases) {
+	using namespace sw::universal::blas;
+	std::mt19937_64 generator(3);
+	std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+	size_t M = 67, K = 300, N = 261;
+	matrix<double> A(M, K), B(K, N);
+	tensor<double> TA({ M, K }), TB({ K, N });
+	for (size_t i = 0; i < M; ++i) for (size_t k = 0; k < K; ++k) TA(i, k) = A(i, k) = distribution(generator);
+	for (size_t k = 0; k < K; ++k) for (size_t j = 0; j < N; ++j) TB(k, j) = B(k, j) = distribution(generator);
+	matrix<double> C = A * B;
+	tensor<double> TC = einsum("ik,kj->ij", TA, TB);
+	int nrOfFailedTests = 0;
+	for (size_t i = 0; i < M; ++i) for (size_t j = 0; j < N; ++j) if (C(i, j) != TC(i, j)) ++nrOfFailedTests;
+	if (nrOfFailedTests > 0 && reportTestCases) std::cerr << "FAIL: tiled gemm differs from the matrix product in " << nrOfFailedTests << " elements\n";
+	return nrOfFailedTests;
+}
+
+// Regression testing guards: typically set by the cmake configuration, but MANUAL_TESTING is an override
+#define MANUAL_TESTING 0
+// REGRESSION_LEVEL_OVERRIDE is set by the cmake file to drive a specific regression intensity
+// It is the responsibility of the regression test to organize the tests in a quartile progression.
+//#undef REGRESSION_LEVEL_OVERRIDE
+#ifndef REGRESSION_LEVEL_OVERRIDE
+#undef REGRESSION_LEVEL_1
+#undef REGRESSION_LEVEL_2
+#undef REGRESSION_LEVEL_3
+#undef REGRESSION_LEVEL_4
+#define REGRESSION_LEVEL_1 1
+#define REGRESSION_LEVEL_2 1
+#define REGRESSION_LEVEL_3 1
+#define REGRESSION_LEVEL_4 1
+#endif
+
+int main()
+try {
+	using namespace sw::universal;
+
+	std::string test_suite  = "BLAS rank-N tensors, views, and contractions";
+	std::string test_tag    = "tensor";
+	bool reportTestCases    = true;
+	int nrOfFailedTestCases = 0;
+
+	ReportTestSuiteHeader(test_suite, reportTestCases);
+
+#if REGRESSION_LEVEL_1
+	nrOfFailedTestCases += ReportTestResult(VerifyViews<float>(reportTestCases), "float", "views");
+	nrOfFailedTestCases += ReportTestResult(VerifyElementwise<float>(reportTestCases), "float", "elementwise");
+	nrOfFailedTestCases += ReportTestResult(VerifyEinsum<double>(reportTestCases), "double", "einsum");
+	nrOfFailedTestCases += ReportTestResult(VerifyTiledGemmOrder(reportTestCases), "double", "tiled gemm");
+#endif
+
+#if REGRESSION_LEVEL_2
+	using Cfloat = cfloat<32, 8, uint32_t, true, false, false>;
+	nrOfFailedTestCases += ReportTestResult(VerifyViews<posit<16, 1>>(reportTestCases), "posit<16,1>", "views");
+	nrOfFailedTestCases += ReportTestResult(VerifyElementwise<posit<16, 1>>(reportTestCases), "posit<16,1>", "elementwise");
+	nrOfFailedTestCases += ReportTestResult(VerifyEinsum<Cfloat>(reportTestCases), "cfloat<32,8>", "einsum");
+#endif
+
+#if REGRESSION_LEVEL_3
+	nrOfFailedTestCases += ReportTestResult(VerifyEinsum<posit<32, 2>>(reportTestCases), "posit<32,2>", "einsum");
+#endif
+
+#if REGRESSION_LEVEL_4
+#endif
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return (nrOfFailedTestCases == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_arithmetic_exception& err) {
+	std::cerr << "Uncaught universal arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_internal_exception& err) {
+	std::cerr << "Uncaught universal internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
@@ -94,6 +94,47 @@ int VerifyVectorScale(unsigned vectorSize ) {
 	return (success ? 0 : 1);
 }
 
+// lazy evaluation of vector expressions must yield the element-by-element result of the eager operators
+template<typename Scalar>
+int VerifyVectorExpressions(unsigned vectorSize) {
+	using namespace sw::universal;
+
+	blas::vector<Scalar> x(vectorSize), p(vectorSize), q(vectorSize);
+	for (unsigned i = 0; i < vectorSize; ++i) {
+		x[i] = Scalar(1.0 + 0.125 * i);
+		p[i] = Scalar(0.5 - 0.0625 * i);
+		q[i] = Scalar(0.25 * i);
+	}
+	Scalar alpha(0.375), beta(-1.5);
+
+	blas::vector<Scalar> reference(vectorSize);
+	for (unsigned i = 0; i < vectorSize; ++i) reference[i] = (x[i] + (p[i] * alpha)) - (q[i] * beta) / alpha + (-p[i]);
+	blas::vector<Scalar> y = x + alpha * p - beta * q / alpha + -p;
+	int nrOfFailedTests = (y == reference ? 0 : 1);
+	if (!(y == (x + alpha * p - beta * q / alpha + -p).eval())) ++nrOfFailedTests;
+
+	// the target may appear in the expression
+	for (unsigned i = 0; i < vectorSize; ++i) reference[i] = x[i] + (p[i] * alpha);
+	y = x;
+	y = y + alpha * p;
+	if (y != reference) ++nrOfFailedTests;
+	y = x;
+	y += alpha * p;
+	if (y != reference) ++nrOfFailedTests;
+
+	// reductions over expressions
+	Scalar dotReference(0), normReference(0);
+	for (unsigned i = 0; i < vectorSize; ++i) {
+		Scalar d = x[i] - p[i];
+		dotReference += d * q[i];
+		normReference += abs(d);
+	}
+	if ((x - p) * q != dotReference) ++nrOfFailedTests;
+	if (blas::normL1(x - p) != normReference) ++nrOfFailedTests;
+	if (size(x - p) != vectorSize) ++nrOfFailedTests;
+	return nrOfFailedTests;
+}
+
 // Regression testing guards: typically set by the cmake configuration, but MANUAL_TESTING is an override
 #define MANUAL_TESTING 0
 // REGRESSION_LEVEL_OVERRIDE is set by the cmake file to drive a specific regression intensity
@@ -135,6 +176,11 @@ try {
 	nrOfFailedTestCases += ReportTestResult(VerifyVectorScale< bfloat_t >(100), "vector scale", "scale bfloat16 vector");
 	nrOfFailedTestCases += ReportTestResult(VerifyVectorScale< lns<16, 8> >(100), "vector scale", "scale lns vector");
 
+	std::cout << "Verify lazy evaluation of vector expressions\n";
+	nrOfFailedTestCases += ReportTestResult(VerifyVectorExpressions< float >(100), "vector expression", "float vector expressions");
+	nrOfFailedTestCases += ReportTestResult(VerifyVectorExpressions< posit<32, 2> >(100), "vector expression", "posit vector expressions");
+	nrOfFailedTestCases += ReportTestResult(VerifyVectorExpressions< cfloat<32, 8, uint32_t, true, false, false> >(100), "vector expression", "cfloat vector expressions");
+
 	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
 	return (nrOfFailedTestCases == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
 }
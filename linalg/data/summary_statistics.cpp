@@ -5,7 +5,9 @@
 //
 // This file is part of the universal numbers project, which is released under an MIT Open Source license.
 #include <universal/utility/directives.hpp>
+#include <algorithm>
 #include <cmath>
+#include <random>
 #include <universal/number/integer/integer.hpp>
 #include <universal/number/fixpnt/fixpnt.hpp>
 #include <universal/number/cfloat/cfloat.hpp>
@@ -18,7 +20,7 @@
 
 
 // Regression testing guards: typically set by the cmake configuration, but MANUAL_TESTING is an override
-#define MANUAL_TESTING 1
+#define MANUAL_TESTING 0
 // REGRESSION_LEVEL_OVERRIDE is set by the cmake file to drive a specific regression intensity
 // It is the responsibility of the regression test to organize the tests in a quartile progression.
 //#undef REGRESSION_LEVEL_OVERRIDE
@@ -33,24 +35,186 @@
 #define REGRESSION_LEVEL_4 1
 #endif
 
-/*
- 
- stats for a couple of 1M element runs:
- mean     : -0.000105222
- stddev   : 0.999774
- quartiles
- [ -4.40803, -0.673688, 0.00028514, 0.672469, 4.67264]
- mean     : -0.000603408
- stddev   : 1.00284
- quartiles
- [ -5.29692, -0.675401, -0.000193462, 0.674231, 4.90644]
- mean     : -0.0010701
- stddev   : 0.997858
- quartiles
- [ -4.99329, -0.674899, -0.00123088, 0.673464, 4.73132]
-
- */
+// moments of a single pass against the two-pass mean and variance
+template<typename Scalar>
+int VerifyMoments(bool reportTestCases) {
+	using namespace sw::universal;
+	int nrOfFailedTestCases = 0;
+	size_t N = 100000;
+	std::vector<Scalar> data(N);
+	std::mt19937_64 generator(0x5eed);
+	std::normal_distribution<double> distribution(3.0, 2.0);
+	for (auto& e : data) e = Scalar(distribution(generator));
+
+	double sum{ 0 };
+	for (auto e : data) sum += double(e);
+	double mean = sum / double(N);
+	double m2{ 0 }, m3{ 0 }, m4{ 0 };
+	for (auto e : data) {
+		double d = double(e) - mean;
+		m2 += d * d;
+		m3 += d * d * d;
+		m4 += d * d * d * d;
+	}
+	double variance = m2 / double(N - 1);
+	double skewness = std::sqrt(double(N)) * m3 / (m2 * std::sqrt(m2));
+	double kurtosis = double(N) * m4 / (m2 * m2) - 3.0;
+
+	blas::moments<Scalar> moment;
+	moment.push(data.begin(), data.end());
+	double tolerance = 1.0e-4;
+	auto check = [&](const std::string& name, double computed, double reference) {
+		if (std::abs(computed - reference) > tolerance * (1.0 + std::abs(reference))) {
+			++nrOfFailedTestCases;
+			if (reportTestCases) std::cerr << "FAIL: " << name << " " << computed << " != " << reference << '\n';
+		}
+	};
+	check("count", double(moment.count()), double(N));
+	check("sum", double(moment.sum()), sum);
+	check("mean", double(moment.mean()), mean);
+	check("variance", double(moment.variance()), variance);
+	check("skewness", double(moment.skewness()), skewness);
+	check("kurtosis", double(moment.kurtosis()), kurtosis);
+	return nrOfFailedTestCases;
+}
+
+// merging the moments of parts of a stream reproduces the moments of the whole stream, for any number of threads
+int VerifyMerge(bool reportTestCases) {
+	using namespace sw::universal;
+	int nrOfFailedTestCases = 0;
+	size_t N = 200000;
+	std::vector<double> data(N);
+	std::mt19937_64 generator(0xfeed);
+	std::lognormal_distribution<double> distribution(0.0, 1.0);
+	for (auto& e : data) e = distribution(generator);
+	data[17] = std::numeric_limits<double>::quiet_NaN();
+
+	blas::moments<double> serial;
+	serial.push(data.begin(), data.end());
+	for (unsigned threads : { 1u, 2u, 3u, 7u, 16u }) {
+		blas::moments<double> merged;
+		size_t chunk = (N + threads - 1) / threads;
+		for (size_t first = 0; first < N; first += chunk) {
+			blas::moments<double> part;
+			part.push(data.begin() + first, data.begin() + std::min(N, first + chunk));
+			merged.merge(part);
+		}
+		auto streaming = blas::streamingStatistics(data, threads);
+		for (const blas::moments<double>* m : { &merged, &streaming.moment }) {
+			bool pass = m->count() == serial.count() && m->nans() == 1
+				&& m->min() == serial.min() && m->max() == serial.max()
+				&& std::abs(m->mean() - serial.mean()) < 1.0e-12 * serial.mean()
+				&& std::abs(m->variance() - serial.variance()) < 1.0e-10 * serial.variance()
+				&& std::abs(m->skewness() - serial.skewness()) < 1.0e-8 * serial.skewness()
+				&& std::abs(m->kurtosis() - serial.kurtosis()) < 1.0e-8 * serial.kurtosis()
+				&& m->sum() == serial.sum();
+			if (!pass) {
+				++nrOfFailedTestCases;
+				if (reportTestCases) std::cerr << "FAIL: merge of " << threads << " parts differs from a single pass\n";
+			}
+		}
+	}
+	return nrOfFailedTestCases;
+}
+
+// the rank error of the t-digest quantiles against the exact order statistics of a sorted copy
+int VerifyQuantileSketch(bool reportTestCases, size_t N) {
+	using namespace sw::universal;
+	int nrOfFailedTestCases = 0;
+	std::vector<double> data(N);
+	blas::gaussian_random(data, 0.0, 1.0);
+	blas::tdigest digest;
+	digest.push(data.begin(), data.end());
+	auto stats = blas::streamingStatistics(data, 4);
+	std::vector<double> sorted(data);
+	std::sort(sorted.begin(), sorted.end());
 
+	if (digest.min() != sorted.front() || digest.max() != sorted.back()) {
+		++nrOfFailedTestCases;
+		if (reportTestCases) std::cerr << "FAIL: t-digest extremes\n";
+	}
+	for (double q : { 0.0001, 0.001, 0.01, 0.1, 0.25, 0.5, 0.75, 0.9, 0.99, 0.999, 0.9999 }) {
+		for (const blas::tdigest* d : { &digest, &stats.digest }) {
+			double estimate = d->quantile(q);
+			// rank of the estimate in the sorted data
+			double rank = double(std::lower_bound(sorted.begin(), sorted.end(), estimate) - sorted.begin()) / double(N);
+			// the error bound tightens toward the tails, proportional to q(1 - q)
+			double bound = 0.0005 + 0.02 * q * (1.0 - q);
+			if (std::abs(rank - q) > bound) {
+				++nrOfFailedTestCases;
+				if (reportTestCases) std::cerr << "FAIL: quantile " << q << " estimate " << estimate << " has rank " << rank << '\n';
+			}
+		}
+		double cdf = digest.cdf(sorted[size_t(q * double(N))]);
+		if (std::abs(cdf - q) > 0.0005 + 0.02 * q * (1.0 - q)) {
+			++nrOfFailedTestCases;
+			if (reportTestCases) std::cerr << "FAIL: cdf at quantile " << q << " is " << cdf << '\n';
+		}
+	}
+	if (digest.centroids() > 400) {
+		++nrOfFailedTestCases;
+		if (reportTestCases) std::cerr << "FAIL: t-digest holds " << digest.centroids() << " centroids\n";
+	}
+	return nrOfFailedTestCases;
+}
+
+// the scale histogram counts each value in its binade, and the range of a number system bounds the binades
+int VerifyScaleHistogram(bool reportTestCases) {
+	using namespace sw::universal;
+	int nrOfFailedTestCases = 0;
+	blas::scale_histogram h(-4, 4);
+	for (double v : { 1.0, 1.5, -1.75, 2.0, 3.0, 0.25, 0.0, 1.0e-3, 64.0, std::numeric_limits<double>::infinity(), std::numeric_limits<double>::quiet_NaN() }) h.push(v);
+	bool pass = h.positive(0) == 2 && h.negative(0) == 1 && h.positive(1) == 2 && h.positive(-2) == 1
+		&& h.zeros() == 1 && h.underflow() == 1 && h.overflow() == 1 && h.infinities() == 1 && h.nans() == 1 && h.total() == 11;
+	blas::scale_histogram g(-4, 4);
+	g.push(1.25);
+	h.merge(g);
+	pass = pass && h.positive(0) == 3;
+	if (!pass) {
+		++nrOfFailedTestCases;
+		if (reportTestCases) std::cerr << "FAIL: scale histogram counts\n" << h;
+	}
+
+	using Fp16 = cfloat<16, 5, uint16_t, true, false, false>;
+	auto fp16 = blas::make_scale_histogram<Fp16>();
+	if (fp16.minScale() != -24 || fp16.maxScale() != 15) {
+		++nrOfFailedTestCases;
+		if (reportTestCases) std::cerr << "FAIL: fp16 scale range [" << fp16.minScale() << ", " << fp16.maxScale() << "]\n";
+	}
+	return nrOfFailedTestCases;
+}
+
+// summaryStatistics and quantiles on the streaming path
+int VerifySummaryStatistics(bool reportTestCases) {
+	using namespace sw::universal;
+	int nrOfFailedTestCases = 0;
+	blas::vector<double> data(100001);
+	for (size_t i = 0; i < size(data); ++i) data[i] = double(i);
+	auto stats = blas::summaryStatistics(data);
+	auto quantiles = blas::quantiles(data);
+	double N = double(size(data));
+	bool pass = stats.mean == 50000.0 && std::abs(stats.stddev - std::sqrt(N * (N + 1.0) / 12.0)) < 1.0e-6
+		&& stats.quantiles.q[0] == 0.0 && stats.quantiles.q[4] == 100000.0 && std::abs(stats.quantiles.q[2] - 50000.0) < 50.0
+		&& quantiles.q[0] == 0.0 && quantiles.q[4] == 100000.0 && std::abs(quantiles.q[1] - 25000.0) < 50.0 && std::abs(quantiles.q[3] - 75000.0) < 50.0;
+	if (!pass) {
+		++nrOfFailedTestCases;
+		if (reportTestCases) std::cerr << "FAIL: summary statistics\n" << stats << quantiles << '\n';
+	}
+
+	// a data set that fits in the buffer of the digest reports its order statistics
+	blas::vector<double> small = { 4.0, 2.0, 1.0, 3.0 };
+	auto smallStats = blas::summaryStatistics(small);
+	auto smallQuantiles = blas::quantiles(small);
+	const double order[5] = { 1.0, 2.0, 3.0, 4.0, 4.0 };
+	for (int i = 0; i < 5; ++i) {
+		if (smallStats.quantiles.q[i] != order[i] || smallQuantiles.q[i] != order[i]) {
+			++nrOfFailedTestCases;
+			if (reportTestCases) std::cerr << "FAIL: order statistics of { 4, 2, 1, 3 }\n" << smallStats << smallQuantiles << '\n';
+			break;
+		}
+	}
+	return nrOfFailedTestCases;
+}
 
 int main()
 try {
@@ -72,12 +236,23 @@ try {
 
 	std::cout << "Summary statistics:\n" << stats << '\n';
 
+	auto streaming = blas::streamingStatistics(data);
+	std::cout << "skewness : " << streaming.moment.skewness() << "  kurtosis : " << streaming.moment.kurtosis() << '\n';
+	std::cout << streaming.histogram << '\n';
+
+	nrOfFailedTestCases += ReportTestResult(VerifyQuantileSketch(reportTestCases, N), "t-digest", "1M gaussian");
+
 	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
 	return EXIT_SUCCESS;
 #else
 
 #if REGRESSION_LEVEL_1
-
+	nrOfFailedTestCases += ReportTestResult(VerifyMoments<double>(reportTestCases), "moments", "double");
+	nrOfFailedTestCases += ReportTestResult(VerifyMoments<float>(reportTestCases), "moments", "float");
+	nrOfFailedTestCases += ReportTestResult(VerifyMerge(reportTestCases), "merge", "double");
+	nrOfFailedTestCases += ReportTestResult(VerifyScaleHistogram(reportTestCases), "scale histogram", "double");
+	nrOfFailedTestCases += ReportTestResult(VerifySummaryStatistics(reportTestCases), "summary statistics", "double");
+	nrOfFailedTestCases += ReportTestResult(VerifyQuantileSketch(reportTestCases, 100000), "t-digest", "100K gaussian");
 #endif
 
 #if REGRESSION_LEVEL_2
@@ -89,7 +264,7 @@ try {
 #endif
 
 #if REGRESSION_LEVEL_4
-
+	nrOfFailedTestCases += ReportTestResult(VerifyQuantileSketch(reportTestCases, 1024 * 1024), "t-digest", "1M gaussian");
 #endif
 
 	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
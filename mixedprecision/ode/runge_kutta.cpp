@@ -0,0 +1,203 @@
+// runge_kutta.cpp: verify the explicit Runge-Kutta integrators and their ensemble mode
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <universal/number/posit/posit.hpp>
+#include <universal/number/cfloat/cfloat.hpp>
+#include <universal/number/dd/dd.hpp>
+#include <universal/ode/runge_kutta.hpp>
+#include <universal/verification/test_suite.hpp>
+
+// harmonic oscillator y0' = y1, y1' = -y0 with solution y0 = cos(t), y1 = -sin(t) from (1, 0)
+struct Oscillator {
+	template<typename Scalar>
+	void operator()(const Scalar&, const std::vector<Scalar>& y, std::vector<Scalar>& dydt) const {
+		dydt[0] = y[1];
+		dydt[1] = -y[0];
+	}
+};
+
+// Lorenz system with the classic parameters, on single trajectories and on blocks of an ensemble
+struct Lorenz {
+	template<typename Scalar>
+	void operator()(const Scalar&, const std::vector<Scalar>& y, std::vector<Scalar>& dydt) const {
+		dydt[0] = Scalar(10) * (y[1] - y[0]);
+		dydt[1] = y[0] * (Scalar(28) - y[2]) - y[1];
+		dydt[2] = y[0] * y[1] - Scalar(8) / Scalar(3) * y[2];
+	}
+	template<typename Scalar>
+	void operator()(const Scalar&, sw::universal::ode::soa_block<const Scalar> y, sw::universal::ode::soa_block<Scalar> dydt) const {
+		for (size_t j = 0; j < y.size(); ++j) {
+			dydt[0][j] = Scalar(10) * (y[1][j] - y[0][j]);
+			dydt[1][j] = y[0][j] * (Scalar(28) - y[2][j]) - y[1][j];
+			dydt[2][j] = y[0][j] * y[1][j] - Scalar(8) / Scalar(3) * y[2][j];
+		}
+	}
+};
+
+// the global error at t = 1 must decrease as h^p when the step is halved
+template<typename Scalar>
+int VerifyOrder(bool reportTestCases, const sw::universal::ode::butcher_tableau& tableau) {
+	using namespace sw::universal::ode;
+	explicit_runge_kutta<Scalar> rk(tableau);
+	double errors[2];
+	size_t steps = 32;
+	for (int r = 0; r < 2; ++r, steps *= 2) {
+		std::vector<Scalar> y{ Scalar(1), Scalar(0) };
+		rk.integrate(Oscillator{}, Scalar(0), y, Scalar(1.0 / double(steps)), steps);
+		errors[r] = std::max(std::abs(double(y[0]) - std::cos(1.0)), std::abs(double(y[1]) + std::sin(1.0)));
+	}
+	double observed = std::log2(errors[0] / errors[1]);
+	if (std::abs(observed - double(tableau.order)) > 0.2) {
+		if (reportTestCases) std::cerr << "FAIL: " << tableau.name << " observed order " << observed << " instead of " << tableau.order << '\n';
+		return 1;
+	}
+	return 0;
+}
+
+// every member of an ensemble must be bit identical to the single trajectory from the same initial state,
+// independent of the number of threads
+template<typename Scalar>
+int VerifyEnsemble(bool reportTestCases, size_t members, size_t steps) {
+	using namespace sw::universal::ode;
+	explicit_runge_kutta<Scalar> rk(classic_rk4());
+	Scalar h(0.01);
+	ensemble<Scalar> initial(3, members);
+	for (size_t m = 0; m < members; ++m) {
+		initial(m, 0) = Scalar(1.0 + 1.0e-3 * double(m));
+		initial(m, 1) = Scalar(1.0);
+		initial(m, 2) = Scalar(20.0);
+	}
+	int nrOfFailedTests = 0;
+	for (unsigned nrThreads : { 1u, 3u, 0u }) {
+		ensemble<Scalar> y(initial);
+		rk.integrate(Lorenz{}, Scalar(0), y, h, steps, nrThreads);
+		for (size_t m = 0; m < members; ++m) {
+			std::vector<Scalar> single = initial.member(m);
+			rk.integrate(Lorenz{}, Scalar(0), single, h, steps);
+			if (single != y.member(m)) {
+				++nrOfFailedTests;
+				if (reportTestCases) std::cerr << "FAIL: ensemble member " << m << " with " << nrThreads << " threads differs from the single trajectory\n";
+				break;
+			}
+		}
+	}
+	return nrOfFailedTests;
+}
+
+// a precision study integrates the same ensemble in several types: over a short interval the types agree to their precision
+int VerifyStudy(bool reportTestCases) {
+	using namespace sw::universal;
+	using namespace sw::universal::ode;
+	ensemble<double> y0(3, 100);
+	for (size_t m = 0; m < y0.members(); ++m) {
+		y0(m, 0) = 1.0 + 1.0e-2 * double(m);
+		y0(m, 1) = 1.0;
+		y0(m, 2) = 20.0;
+	}
+	auto lorenz = [](const auto& t, auto y, auto dydt) { Lorenz{}(t, y, dydt); };
+	std::vector<ensemble_run> runs = ensemble_study<float, double, posit<32, 2>>(classic_rk4(), lorenz, y0, 0.0, 0.01, 50);
+	int nrOfFailedTests = 0;
+	if (runs.size() != 3 || runs[0].type != "float" || runs[1].type != "double") {
+		if (reportTestCases) std::cerr << "FAIL: ensemble study did not run the requested types\n";
+		return 1;
+	}
+	for (const ensemble_run& run : runs) {
+		double diff{ 0 };
+		for (size_t c = 0; c < 3; ++c) {
+			for (size_t m = 0; m < y0.members(); ++m) diff = std::max(diff, std::abs(run.state(m, c) - runs[1].state(m, c)));
+		}
+		if (diff > 1.0e-3 || !(run.steps_per_second > 0.0)) {
+			++nrOfFailedTests;
+			if (reportTestCases) std::cerr << "FAIL: " << run.type << " ensemble differs by " << diff << " from double\n";
+		}
+	}
+	return nrOfFailedTests;
+}
+
+// Regression testing guards: typically set by the cmake configuration, but MANUAL_TESTING is an override
+#define MANUAL_TESTING 0
+// REGRESSION_LEVEL_OVERRIDE is set by the cmake file to drive a specific regression intensity
+// It is the responsibility of the regression test to organize the tests in a quartile progression.
+//#undef REGRESSION_LEVEL_OVERRIDE
+#ifndef REGRESSION_LEVEL_OVERRIDE
+#undef REGRESSION_LEVEL_1
+#undef REGRESSION_LEVEL_2
+#undef REGRESSION_LEVEL_3
+#undef REGRESSION_LEVEL_4
+#define REGRESSION_LEVEL_1 1
+#define REGRESSION_LEVEL_2 1
+#define REGRESSION_LEVEL_3 1
+#define REGRESSION_LEVEL_4 1
+#endif
+
+int main()
+try {
+	using namespace sw::universal;
+	using namespace sw::universal::ode;
+
+	std::string test_suite  = "explicit Runge-Kutta integrators";
+	std::string test_tag    = "runge-kutta";
+	bool reportTestCases    = true;
+	int nrOfFailedTestCases = 0;
+
+	ReportTestSuiteHeader(test_suite, reportTestCases);
+
+	// implicit tableaus are rejected
+	try {
+		butcher_tableau implicit{ "backward Euler", 1, 1, { {1,1} }, { {1,1} }, { {1,1} } };
+		explicit_runge_kutta<double> rk(implicit);
+		++nrOfFailedTestCases;
+		if (reportTestCases) std::cerr << "FAIL: implicit tableau was accepted\n";
+	}
+	catch (const std::invalid_argument&) {
+		// expected
+	}
+
+#if REGRESSION_LEVEL_1
+	for (const butcher_tableau& tableau : { forward_euler(), explicit_midpoint(), heun(), kutta3(), classic_rk4(), rk38() }) {
+		nrOfFailedTestCases += ReportTestResult(VerifyOrder<double>(reportTestCases, tableau), "double", tableau.name);
+	}
+	nrOfFailedTestCases += ReportTestResult(VerifyEnsemble<double>(reportTestCases, 150, 200), "double", "ensemble");
+#endif
+
+#if REGRESSION_LEVEL_2
+	nrOfFailedTestCases += ReportTestResult(VerifyOrder<dd>(reportTestCases, classic_rk4()), "dd", "classic Runge-Kutta");
+	nrOfFailedTestCases += ReportTestResult(VerifyEnsemble<posit<32, 2>>(reportTestCases, 70, 100), "posit<32,2>", "ensemble");
+	nrOfFailedTestCases += ReportTestResult(VerifyStudy(reportTestCases), "float/double/posit", "ensemble study");
+#endif
+
+#if REGRESSION_LEVEL_3
+	nrOfFailedTestCases += ReportTestResult(VerifyEnsemble<cfloat<32, 8, uint32_t, true, false, false>>(reportTestCases, 70, 100), "cfloat<32,8>", "ensemble");
+#endif
+
+#if REGRESSION_LEVEL_4
+	nrOfFailedTestCases += ReportTestResult(VerifyEnsemble<dd>(reportTestCases, 130, 200), "dd", "ensemble");
+#endif
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_arithmetic_exception& err) {
+	std::cerr << "Uncaught universal arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_internal_exception& err) {
+	std::cerr << "Uncaught universal internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
@@ -0,0 +1,308 @@
+// fft.cpp: verify the fast Fourier transforms and FFT-based convolution over Universal scalar types
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <random>
+#include <universal/number/posit/posit.hpp>
+#include <universal/number/cfloat/cfloat.hpp>
+#include <universal/number/fixpnt/fixpnt.hpp>
+#include <universal/dsp/fft.hpp>
+#include <universal/verification/test_suite.hpp>
+
+// deterministic test signal with samples in [-1, 1)
+std::vector<double> TestSignal(size_t N, unsigned seed) {
+	std::mt19937 generator(seed);
+	std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+	std::vector<double> x(N);
+	for (auto& v : x) v = distribution(generator);
+	return x;
+}
+
+// direct O(N^2) discrete Fourier transform in long double
+std::vector<std::complex<double>> ReferenceDFT(const std::vector<std::complex<double>>& x) {
+	size_t N = x.size();
+	constexpr long double two_pi = 6.283185307179586476925286766559005768L;
+	std::vector<std::complex<double>> X(N);
+	for (size_t k = 0; k < N; ++k) {
+		long double re{ 0 }, im{ 0 };
+		for (size_t n = 0; n < N; ++n) {
+			long double angle = two_pi * static_cast<long double>((n * k) % N) / static_cast<long double>(N);
+			long double c = std::cos(angle), s = std::sin(angle);
+			re += x[n].real() * c + x[n].imag() * s;
+			im += x[n].imag() * c - x[n].real() * s;
+		}
+		X[k] = std::complex<double>(double(re), double(im));
+	}
+	return X;
+}
+
+// largest absolute difference between the components of X and Xref, relative to the largest component of Xref
+template<typename Scalar>
+double RelativeError(const std::vector<std::complex<Scalar>>& X, const std::vector<std::complex<double>>& Xref, double scale = 1.0) {
+	double diff{ 0 }, norm{ 0 };
+	for (size_t k = 0; k < Xref.size(); ++k) {
+		diff = std::max(diff, std::abs(double(X[k].real()) - scale * Xref[k].real()));
+		diff = std::max(diff, std::abs(double(X[k].imag()) - scale * Xref[k].imag()));
+		norm = std::max(norm, std::max(std::abs(scale * Xref[k].real()), std::abs(scale * Xref[k].imag())));
+	}
+	return (norm == 0.0 ? diff : diff / norm);
+}
+
+// forward and inverse complex transforms against the direct DFT: the error bound grows with log2(N)
+template<typename Scalar>
+int VerifyComplexFFT(bool reportTestCases, size_t maxN, double tolerance) {
+	using namespace sw::universal::dsp;
+	using Complex = std::complex<Scalar>;
+	double eps = double(std::numeric_limits<Scalar>::epsilon());
+	int nrOfFailedTests = 0;
+	for (size_t N = 1, log2N = 0; N <= maxN; N *= 2, ++log2N) {
+		std::vector<double> re = TestSignal(N, 17), im = TestSignal(N, 29);
+		std::vector<std::complex<double>> xref(N);
+		std::vector<Complex> x(N);
+		for (size_t n = 0; n < N; ++n) {
+			x[n] = Complex(Scalar(re[n]), Scalar(im[n]));
+			xref[n] = std::complex<double>(double(x[n].real()), double(x[n].imag()));
+		}
+		std::vector<std::complex<double>> Xref = ReferenceDFT(xref);
+		fft_plan<Scalar> plan(N);
+		std::vector<Complex> X(x);
+		plan.forward(X);
+		double bound = tolerance * double(log2N + 1) * eps;
+		double forwardError = RelativeError(X, Xref);
+		plan.inverse(X);
+		double roundtripError = RelativeError(X, xref);
+		if (forwardError > bound || roundtripError > 2.0 * bound) {
+			++nrOfFailedTests;
+			if (reportTestCases) std::cerr << "FAIL: fft of size " << N << " forward error " << forwardError << " round trip error " << roundtripError << " bound " << bound << '\n';
+		}
+	}
+	return nrOfFailedTests;
+}
+
+// the scaled forward transform keeps fixed-point values in range: verify against DFT / N with an absolute bound
+template<typename Scalar>
+int VerifyScaledFFT(bool reportTestCases, size_t maxN, double tolerance) {
+	using namespace sw::universal::dsp;
+	using Complex = std::complex<Scalar>;
+	double ulp = double(std::numeric_limits<Scalar>::epsilon());
+	int nrOfFailedTests = 0;
+	for (size_t N = 2, log2N = 1; N <= maxN; N *= 2, ++log2N) {
+		std::vector<double> re = TestSignal(N, 5), im = TestSignal(N, 7);
+		std::vector<std::complex<double>> xref(N);
+		std::vector<Complex> X(N);
+		for (size_t n = 0; n < N; ++n) {
+			X[n] = Complex(Scalar(re[n]), Scalar(im[n]));
+			xref[n] = std::complex<double>(double(X[n].real()), double(X[n].imag()));
+		}
+		std::vector<std::complex<double>> Xref = ReferenceDFT(xref);
+		fft_plan<Scalar> plan(N);
+		plan.forward_scaled(X);
+		double diff{ 0 };
+		for (size_t k = 0; k < N; ++k) {
+			diff = std::max(diff, std::abs(double(X[k].real()) - Xref[k].real() / double(N)));
+			diff = std::max(diff, std::abs(double(X[k].imag()) - Xref[k].imag() / double(N)));
+		}
+		double bound = tolerance * double(log2N) * ulp;
+		if (diff > bound) {
+			++nrOfFailedTests;
+			if (reportTestCases) std::cerr << "FAIL: scaled fft of size " << N << " absolute error " << diff << " bound " << bound << '\n';
+		}
+	}
+	return nrOfFailedTests;
+}
+
+// the real transform must match the complex transform of the same signal, and invert to the signal
+template<typename Scalar>
+int VerifyRealFFT(bool reportTestCases, size_t maxN, double tolerance) {
+	using namespace sw::universal::dsp;
+	using Complex = std::complex<Scalar>;
+	double eps = double(std::numeric_limits<Scalar>::epsilon());
+	int nrOfFailedTests = 0;
+	for (size_t N = 2, log2N = 1; N <= maxN; N *= 2, ++log2N) {
+		std::vector<double> samples = TestSignal(N, 11);
+		std::vector<Scalar> x(N);
+		std::vector<std::complex<double>> xref(N);
+		for (size_t n = 0; n < N; ++n) {
+			x[n] = Scalar(samples[n]);
+			xref[n] = std::complex<double>(double(x[n]), 0.0);
+		}
+		std::vector<std::complex<double>> Xref = ReferenceDFT(xref);
+		Xref.resize(N / 2 + 1);
+		rfft_plan<Scalar> plan(N);
+		std::vector<Complex> X = plan.forward(x);
+		double bound = tolerance * double(log2N + 1) * eps;
+		double forwardError = RelativeError(X, Xref);
+		std::vector<Scalar> y = plan.inverse(X);
+		double roundtripError{ 0 };
+		for (size_t n = 0; n < N; ++n) roundtripError = std::max(roundtripError, std::abs(double(y[n]) - double(x[n])));
+		if (forwardError > bound || roundtripError > 2.0 * bound) {
+			++nrOfFailedTests;
+			if (reportTestCases) std::cerr << "FAIL: rfft of size " << N << " forward error " << forwardError << " round trip error " << roundtripError << " bound " << bound << '\n';
+		}
+	}
+	return nrOfFailedTests;
+}
+
+// FFT-based convolution and the overlap-add FIR filter against direct convolution
+template<typename Scalar>
+int VerifyConvolution(bool reportTestCases, size_t signalLength, size_t nrTaps, double tolerance) {
+	using namespace sw::universal::dsp;
+	double eps = double(std::numeric_limits<Scalar>::epsilon());
+	std::vector<double> samples = TestSignal(signalLength, 3), coefficients = TestSignal(nrTaps, 13);
+	std::vector<Scalar> x(signalLength), h(nrTaps);
+	for (size_t i = 0; i < signalLength; ++i) x[i] = Scalar(samples[i]);
+	for (size_t i = 0; i < nrTaps; ++i) h[i] = Scalar(coefficients[i]);
+	std::vector<double> yref(signalLength + nrTaps - 1, 0.0);
+	for (size_t i = 0; i < signalLength; ++i) {
+		for (size_t j = 0; j < nrTaps; ++j) yref[i + j] += double(x[i]) * double(h[j]);
+	}
+	double norm{ 0 };
+	for (double v : yref) norm = std::max(norm, std::abs(v));
+
+	int nrOfFailedTests = 0;
+	std::vector<Scalar> y = fft_convolve(x, h);
+	double convolutionError{ 0 };
+	for (size_t i = 0; i < yref.size(); ++i) convolutionError = std::max(convolutionError, std::abs(double(y[i]) - yref[i]));
+	fft_fir_filter<Scalar> fir(h);
+	std::vector<Scalar> z = fir.filter(x);
+	double filterError{ 0 };
+	for (size_t i = 0; i < signalLength; ++i) filterError = std::max(filterError, std::abs(double(z[i]) - yref[i]));
+	size_t log2N = 0;
+	while ((size_t(1) << log2N) < yref.size()) ++log2N;
+	double bound = tolerance * double(log2N) * eps * norm;
+	if (y.size() != yref.size() || z.size() != signalLength || convolutionError > bound || filterError > bound) {
+		++nrOfFailedTests;
+		if (reportTestCases) std::cerr << "FAIL: convolution of " << signalLength << " samples with " << nrTaps << " taps error " << convolutionError
+			<< " overlap-add error " << filterError << " bound " << bound << '\n';
+	}
+	return nrOfFailedTests;
+}
+
+// batched transforms must be identical to transforms of the individual signals, independent of the thread count
+template<typename Scalar>
+int VerifyBatchedFFT(bool reportTestCases, size_t N, size_t count) {
+	using namespace sw::universal::dsp;
+	using Complex = std::complex<Scalar>;
+	std::vector<double> re = TestSignal(N * count, 23), im = TestSignal(N * count, 31);
+	std::vector<Complex> x(N * count);
+	for (size_t i = 0; i < x.size(); ++i) x[i] = Complex(Scalar(re[i]), Scalar(im[i]));
+	fft_plan<Scalar> plan(N);
+	std::vector<Complex> reference(x);
+	for (size_t s = 0; s < count; ++s) plan.forward(reference.data() + s * N);
+
+	int nrOfFailedTests = 0;
+	for (unsigned nrThreads : { 1u, 3u, 0u }) {
+		std::vector<Complex> X(x);
+		plan.forward(X.data(), count, nrThreads);
+		if (X != reference) {
+			++nrOfFailedTests;
+			if (reportTestCases) std::cerr << "FAIL: batched fft with " << nrThreads << " threads differs from the individual transforms\n";
+		}
+		plan.inverse(X.data(), count, nrThreads);
+		std::vector<Complex> Y(reference);
+		for (size_t s = 0; s < count; ++s) plan.inverse(Y.data() + s * N);
+		if (X != Y) {
+			++nrOfFailedTests;
+			if (reportTestCases) std::cerr << "FAIL: batched inverse fft with " << nrThreads << " threads differs from the individual transforms\n";
+		}
+	}
+	return nrOfFailedTests;
+}
+
+// Regression testing guards: typically set by the cmake configuration, but MANUAL_TESTING is an override
+#define MANUAL_TESTING 0
+// REGRESSION_LEVEL_OVERRIDE is set by the cmake file to drive a specific regression intensity
+// It is the responsibility of the regression test to organize the tests in a quartile progression.
+//#undef REGRESSION_LEVEL_OVERRIDE
+#ifndef REGRESSION_LEVEL_OVERRIDE
+#undef REGRESSION_LEVEL_1
+#undef REGRESSION_LEVEL_2
+#undef REGRESSION_LEVEL_3
+#undef REGRESSION_LEVEL_4
+#define REGRESSION_LEVEL_1 1
+#define REGRESSION_LEVEL_2 1
+#define REGRESSION_LEVEL_3 1
+#define REGRESSION_LEVEL_4 1
+#endif
+
+int main()
+try {
+	using namespace sw::universal;
+
+	std::string test_suite  = "fast Fourier transforms";
+	std::string test_tag    = "fft";
+	bool reportTestCases    = true;
+	int nrOfFailedTestCases = 0;
+
+	ReportTestSuiteHeader(test_suite, reportTestCases);
+
+	// invalid sizes are rejected
+	try {
+		dsp::fft_plan<double> plan(12);
+		++nrOfFailedTestCases;
+		if (reportTestCases) std::cerr << "FAIL: fft plan of size 12 was accepted\n";
+	}
+	catch (const dsp::fft_invalid_size&) {
+		// expected
+	}
+
+#if REGRESSION_LEVEL_1
+	nrOfFailedTestCases += ReportTestResult(VerifyComplexFFT<double>(reportTestCases, 256, 4.0), "double", "complex fft");
+	nrOfFailedTestCases += ReportTestResult(VerifyRealFFT<double>(reportTestCases, 256, 4.0), "double", "real fft");
+	nrOfFailedTestCases += ReportTestResult(VerifyConvolution<double>(reportTestCases, 200, 17, 8.0), "double", "convolution");
+	nrOfFailedTestCases += ReportTestResult(VerifyBatchedFFT<double>(reportTestCases, 64, 37), "double", "batched fft");
+#endif
+
+#if REGRESSION_LEVEL_2
+	using Posit32 = posit<32, 2>;
+	using Cfloat32 = cfloat<32, 8, uint32_t, true, false, false>;
+	using Fixed = fixpnt<16, 12, Saturate, uint16_t>;
+	nrOfFailedTestCases += ReportTestResult(VerifyComplexFFT<Posit32>(reportTestCases, 256, 4.0), "posit<32,2>", "complex fft");
+	nrOfFailedTestCases += ReportTestResult(VerifyComplexFFT<Cfloat32>(reportTestCases, 256, 4.0), "cfloat<32,8>", "complex fft");
+	nrOfFailedTestCases += ReportTestResult(VerifyRealFFT<Posit32>(reportTestCases, 256, 4.0), "posit<32,2>", "real fft");
+	nrOfFailedTestCases += ReportTestResult(VerifyScaledFFT<Fixed>(reportTestCases, 256, 2.0), "fixpnt<16,12>", "scaled fft");
+#endif
+
+#if REGRESSION_LEVEL_3
+	using Posit16 = posit<16, 1>;
+	using Posit32 = posit<32, 2>;
+	using Cfloat16 = cfloat<16, 5, uint16_t, true, false, false>;
+	using Cfloat32 = cfloat<32, 8, uint32_t, true, false, false>;
+	nrOfFailedTestCases += ReportTestResult(VerifyComplexFFT<Posit16>(reportTestCases, 128, 4.0), "posit<16,1>", "complex fft");
+	nrOfFailedTestCases += ReportTestResult(VerifyComplexFFT<Cfloat16>(reportTestCases, 128, 4.0), "cfloat<16,5>", "complex fft");
+	nrOfFailedTestCases += ReportTestResult(VerifyConvolution<Posit32>(reportTestCases, 300, 31, 8.0), "posit<32,2>", "convolution");
+	nrOfFailedTestCases += ReportTestResult(VerifyConvolution<Cfloat32>(reportTestCases, 300, 31, 8.0), "cfloat<32,8>", "convolution");
+	nrOfFailedTestCases += ReportTestResult(VerifyBatchedFFT<Posit16>(reportTestCases, 32, 19), "posit<16,1>", "batched fft");
+#endif
+
+#if REGRESSION_LEVEL_4
+	nrOfFailedTestCases += ReportTestResult(VerifyComplexFFT<double>(reportTestCases, 4096, 4.0), "double", "complex fft");
+	nrOfFailedTestCases += ReportTestResult(VerifyConvolution<double>(reportTestCases, 4000, 129, 8.0), "double", "convolution");
+#endif
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_arithmetic_exception& err) {
+	std::cerr << "Uncaught universal arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_internal_exception& err) {
+	std::cerr << "Uncaught universal internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
@@ -0,0 +1,354 @@
+// mx.cpp: microscaling (MX) block-scaled formats: encodings, block quantization, and block-scaled dot products and GEMM
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <random>
+#include <universal/blas/blas.hpp>
+#include <universal/quantization/mx.hpp>
+#include <universal/quantization/qsnr.hpp>
+#include <universal/verification/test_suite.hpp>
+
+// Regression testing guards: typically set by the cmake configuration, but MANUAL_TESTING is an override
+#define MANUAL_TESTING 0
+// REGRESSION_LEVEL_OVERRIDE is set by the cmake file to drive a specific regression intensity
+// It is the responsibility of the regression test to organize the tests in a quartile progression.
+//#undef REGRESSION_LEVEL_OVERRIDE
+#ifndef REGRESSION_LEVEL_OVERRIDE
+#undef REGRESSION_LEVEL_1
+#undef REGRESSION_LEVEL_2
+#undef REGRESSION_LEVEL_3
+#undef REGRESSION_LEVEL_4
+#define REGRESSION_LEVEL_1 1
+#define REGRESSION_LEVEL_2 1
+#define REGRESSION_LEVEL_3 1
+#define REGRESSION_LEVEL_4 1
+#endif
+
+// the element values of the OCP MX specification: smallest subnormal, smallest normal, and largest finite value,
+// and every encoding rounds back to itself
+template<typename Element>
+int VerifyElementFormat(double minsub, double minnorm, double maxval, bool reportTestCases) {
+	using namespace sw::universal;
+	using codec = mx_element<Element>;
+	int nrOfFailedTestCases = 0;
+	const codec& e = codec::instance();
+	auto fail = [&](const std::string& what) {
+		++nrOfFailedTestCases;
+		if (reportTestCases) std::cerr << "FAIL: " << Element::name << ' ' << what << '\n';
+	};
+	if (e.value(1) != minsub) fail("smallest subnormal " + std::to_string(e.value(1)));
+	if (!Element::integer && e.value(uint32_t(1) << Element::fbits) != minnorm) fail("smallest normal " + std::to_string(e.value(uint32_t(1) << Element::fbits)));
+	if (e.value(Element::maxcode) != maxval || codec::maxvalue() != maxval) fail("largest value " + std::to_string(e.value(Element::maxcode)));
+	for (uint32_t code = 0; code < codec::nrEncodings; ++code) {
+		double v = e.value(code);
+		if (!std::isfinite(v) || (Element::integer && code == codec::signbit)) continue;
+		if (codec::encode(v) != code) fail("encoding " + std::to_string(code) + " does not round to itself");
+		if (double(e.integer(code)) * std::ldexp(1.0, codec::unit_exponent) != v) fail("integer of encoding " + std::to_string(code));
+	}
+	return nrOfFailedTestCases;
+}
+
+// encode rounds to the nearest element value, ties to the even encoding, and saturates to the largest value
+template<typename Element>
+int VerifyElementRounding(bool reportTestCases) {
+	using namespace sw::universal;
+	using codec = mx_element<Element>;
+	int nrOfFailedTestCases = 0;
+	const codec& e = codec::instance();
+	// the distinct non-negative finite values in increasing order, which are the encodings in increasing order
+	std::vector<uint32_t> ordered;
+	for (uint32_t code = 0; code <= Element::maxcode; ++code) ordered.push_back(code);
+	auto reference = [&](double x) {
+		double a = std::abs(x);
+		uint32_t best = Element::maxcode;
+		if (a < codec::maxvalue()) {
+			for (size_t k = 0; k + 1 < ordered.size(); ++k) {
+				double lo = e.value(ordered[k]), hi = e.value(ordered[k + 1]);
+				if (a >= lo && a <= hi) {
+					double mid = (lo + hi) / 2.0;
+					best = (a < mid ? ordered[k] : (a > mid ? ordered[k + 1] : ((ordered[k] & 1) ? ordered[k + 1] : ordered[k])));
+					break;
+				}
+			}
+		}
+		if (x < 0.0) return (Element::integer ? (0u - best) & codec::mask : best | codec::signbit);
+		return best;
+	};
+	auto check = [&](double x) {
+		uint32_t code = codec::encode(x);
+		uint32_t expected = reference(x);
+		if (code != expected && !(x == 0.0)) {
+			++nrOfFailedTestCases;
+			if (reportTestCases && nrOfFailedTestCases < 10) std::cerr << "FAIL: " << Element::name << " encodes " << std::setprecision(17) << x << " to " << code << " instead of " << expected << '\n';
+		}
+	};
+	for (size_t k = 0; k + 1 < ordered.size(); ++k) {
+		double lo = e.value(ordered[k]), hi = e.value(ordered[k + 1]), mid = (lo + hi) / 2.0;
+		for (double x : { lo, mid, std::nextafter(mid, 0.0), std::nextafter(mid, hi), hi }) {
+			check(x);
+			check(-x);
+		}
+	}
+	std::mt19937_64 generator(0x5eed);
+	std::uniform_real_distribution<double> uniform(-2.0 * codec::maxvalue(), 2.0 * codec::maxvalue());
+	for (int i = 0; i < 10000; ++i) check(uniform(generator));
+	for (double x : { 1.0e300, -1.0e300, 1.0e-300, -1.0e-300 }) check(x);
+	return nrOfFailedTestCases;
+}
+
+// a block gets the shared exponent of the specification, round trips through its values, packs its elements
+// without loss, and represents a non-finite value with the NaN scale
+template<typename Format>
+int VerifyBlockQuantization(bool reportTestCases) {
+	using namespace sw::universal;
+	using codec = mx_element<typename Format::element>;
+	constexpr unsigned blockSize = Format::blockSize;
+	int nrOfFailedTestCases = 0;
+	auto fail = [&](const std::string& what) {
+		++nrOfFailedTestCases;
+		if (reportTestCases) std::cerr << "FAIL: " << type_tag(Format()) << ' ' << what << '\n';
+	};
+	std::mt19937_64 generator(0x5eed);
+	std::normal_distribution<double> gaussian(0.0, 1.0);
+	std::uniform_int_distribution<int> scale(-60, 60);
+	double x[blockSize], y[blockSize], z[blockSize];
+	for (int trial = 0; trial < 1000; ++trial) {
+		int s = scale(generator);
+		double amax{ 0 };
+		for (unsigned i = 0; i < blockSize; ++i) {
+			x[i] = std::ldexp(gaussian(generator), s);
+			amax = std::max(amax, std::abs(x[i]));
+		}
+		mx_block<Format> block, requantized;
+		quantize(x, blockSize, block);
+		if (block.scale.exponent() != std::ilogb(amax) - codec::emax) fail("shared exponent of a block");
+		dequantize(block, y, blockSize);
+		double ulp = std::ldexp(1.0, block.scale.exponent() + codec::emax - int(Format::element::fbits));
+		for (unsigned i = 0; i < blockSize; ++i) {
+			// the largest value of the block may saturate, the other values are within half an ulp of the largest binade
+			if (std::abs(x[i] - y[i]) > std::max(ulp / 2.0, amax - codec::maxvalue() * double(block.scale))) { fail("rounding error of an element"); break; }
+		}
+		quantize(y, blockSize, requantized);
+		if (requantized.scale.bits() != block.scale.bits() || requantized.codes != block.codes) {
+			// a block whose largest value rounds up to the next binade gets a larger shared exponent
+			dequantize(requantized, z, blockSize);
+			for (unsigned i = 0; i < blockSize; ++i) if (z[i] != y[i]) { fail("requantization of the values of a block"); break; }
+		}
+		uint32_t codes[blockSize];
+		for (unsigned i = 0; i < blockSize; ++i) codes[i] = uint32_t(generator()) & mx_block<Format>::mask;
+		block.pack(codes);
+		bool packed{ true };
+		block.for_each_code([&](unsigned i, uint32_t code) { packed &= (code == codes[i] && block.code(i) == codes[i]); });
+		if (!packed) fail("packing of the element encodings");
+	}
+
+	mx_block<Format> block;
+	for (unsigned i = 0; i < blockSize; ++i) x[i] = 0.0;
+	quantize(x, blockSize, block);
+	dequantize(block, y, blockSize);
+	for (unsigned i = 0; i < blockSize; ++i) if (y[i] != 0.0) { fail("block of zeros"); break; }
+	x[3] = std::numeric_limits<double>::quiet_NaN();
+	quantize(x, blockSize, block);
+	dequantize(block, y, blockSize);
+	if (!block.scale.isnan() || !std::isnan(y[0])) fail("block with a NaN");
+	x[3] = std::numeric_limits<double>::infinity();
+	quantize(x, blockSize, block);
+	if (!block.scale.isnan()) fail("block with an infinity");
+	// a partial block: the elements past the end are zero
+	for (unsigned i = 0; i < blockSize; ++i) x[i] = 1.0;
+	quantize(x, 5, block);
+	dequantize(block, y, blockSize);
+	if (y[4] != 1.0 || y[5] != 0.0) fail("partial block");
+	return nrOfFailedTestCases;
+}
+
+// the block scaled dot product equals the dot product of the values, summed in double per block in block order,
+// which is exact within a block for the formats with an integer accumulator
+template<typename FA, typename FB>
+int VerifyDot(size_t N, bool reportTestCases) {
+	using namespace sw::universal;
+	int nrOfFailedTestCases = 0;
+	blas::vector<double> x(N), y(N);
+	blas::gaussian_random(x, 0.0, 1.0);
+	blas::gaussian_random(y, 0.0, 4.0);
+	mx_vector<FA> a(x);
+	mx_vector<FB> b(y);
+	double expected{ 0 };
+	for (size_t offset = 0; offset < N; offset += FA::blockSize) {
+		double block{ 0 };
+		for (size_t i = offset; i < std::min(N, offset + FA::blockSize); ++i) block += a[i] * b[i];
+		expected += block;
+	}
+	double result = dot(a, b);
+	if (result != expected) {
+		++nrOfFailedTestCases;
+		if (reportTestCases) std::cerr << "FAIL: " << type_tag(FA()) << " . " << type_tag(FB()) << " = " << std::setprecision(17) << result << " instead of " << expected << '\n';
+	}
+	return nrOfFailedTestCases;
+}
+
+// the block scaled GEMM equals the products of the dequantized matrices, summed per block, for any number of
+// threads and for shapes that are not multiples of the block size or of the row panel
+template<typename FA, typename FB>
+int VerifyGemm(size_t M, size_t K, size_t N, bool reportTestCases) {
+	using namespace sw::universal;
+	int nrOfFailedTestCases = 0;
+	blas::matrix<double> A(M, K), B(K, N), Ad, Bd;
+	blas::gaussian_random(A, 0.0, 1.0);
+	blas::gaussian_random(B, 0.0, 1.0);
+	A(0, 0) = 1000.0;  // a block with a large shared exponent
+	mx_matrix<FA> a(A, mx_axis::rows);
+	mx_matrix<FB> b(B, mx_axis::columns);
+	a.dequantize(Ad);
+	b.dequantize(Bd);
+	blas::matrix<double> C1 = gemm<double>(a, b, 1), C3 = gemm<double>(a, b, 3);
+	for (size_t i = 0; i < M; ++i) {
+		for (size_t j = 0; j < N; ++j) {
+			double expected{ 0 };
+			for (size_t offset = 0; offset < K; offset += FA::blockSize) {
+				double block{ 0 };
+				for (size_t k = offset; k < std::min(K, offset + FA::blockSize); ++k) block += Ad(i, k) * Bd(k, j);
+				expected += block;
+			}
+			if (C1(i, j) != expected || C3(i, j) != expected) {
+				++nrOfFailedTestCases;
+				if (reportTestCases && nrOfFailedTestCases < 10) std::cerr << "FAIL: " << type_tag(FA()) << " x " << type_tag(FB()) << " C(" << i << ',' << j << ") = " << C1(i, j) << " and " << C3(i, j) << " instead of " << expected << '\n';
+			}
+		}
+	}
+	// an operand blocked along the wrong axis is rejected
+	try {
+		mx_matrix<FB> wrong(B, mx_axis::rows);
+		gemm(a, wrong);
+		++nrOfFailedTestCases;
+		if (reportTestCases) std::cerr << "FAIL: gemm accepted a right operand blocked along its rows\n";
+	}
+	catch (const blas::matmul_incompatible_matrices&) {}
+	return nrOfFailedTestCases;
+}
+
+// the quantization sweep reports the error of a block-scaled format, quantized in blocks along the data
+int VerifyQsnr(bool reportTestCases) {
+	using namespace sw::universal;
+	int nrOfFailedTestCases = 0;
+	blas::vector<double> data(QSNR_SWEEP_TILE * 3 + 100);
+	blas::gaussian_random(data, 0.0, 1.0);
+	auto reports = qsnr_sweep<mxfp8_e4m3, mxfp6_e2m3, mxfp4, mxint8>(data, 2);
+	// the noise of the sweep is the noise of the MX vector of the data
+	auto noise = [&](const auto& v) {
+		double sum{ 0 };
+		for (size_t i = 0; i < size(data); ++i) sum += (data[i] - v[i]) * (data[i] - v[i]);
+		return sum / double(size(data));
+	};
+	double expected[] = { noise(mx_vector<mxfp8_e4m3>(data)), noise(mx_vector<mxfp6_e2m3>(data)), noise(mx_vector<mxfp4>(data)), noise(mx_vector<mxint8>(data)) };
+	for (size_t k = 0; k < reports.size(); ++k) {
+		if (std::abs(reports[k].noise_power - expected[k]) > 1.0e-12 * expected[k] || reports[k].count != size(data)) {
+			++nrOfFailedTestCases;
+			if (reportTestCases) std::cerr << "FAIL: " << reports[k] << " noise power " << reports[k].noise_power << " instead of " << expected[k] << '\n';
+		}
+	}
+	// the more fraction bits, the higher the QSNR: e4m3 and e2m3 have the same fraction bits, and on Gaussian
+	// blocks the extra exponent range of e4m3 does not outweigh its saturation of the largest binade
+	if (!(reports[3].qsnr > reports[0].qsnr && reports[3].qsnr > reports[1].qsnr && std::abs(reports[0].qsnr - reports[1].qsnr) < 1.0
+		&& reports[1].qsnr > reports[2].qsnr + 6.0)) {
+		++nrOfFailedTestCases;
+		if (reportTestCases) for (const auto& r : reports) std::cerr << "FAIL: QSNR order " << r << '\n';
+	}
+	return nrOfFailedTestCases;
+}
+
+int main()
+try {
+	using namespace sw::universal;
+
+	std::string test_suite  = "microscaling block-scaled formats";
+	std::string test_tag    = "mx";
+	bool reportTestCases    = true;
+	int nrOfFailedTestCases = 0;
+
+	ReportTestSuiteHeader(test_suite, reportTestCases);
+
+#if MANUAL_TESTING
+
+	blas::vector<double> data(1024 * 1024);
+	blas::gaussian_random(data, 0.0, 1.0);
+	for (const auto& report : qsnr_sweep<mxfp8_e4m3, mxfp8_e5m2, mxfp6_e3m2, mxfp6_e2m3, mxfp4, mxint8>(data)) std::cout << report << '\n';
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return EXIT_SUCCESS;
+#else
+
+#if REGRESSION_LEVEL_1
+	nrOfFailedTestCases += ReportTestResult(VerifyElementFormat<mx_e4m3>(0x1p-9, 0x1p-6, 448.0, reportTestCases), "mxfp8_e4m3", "element encodings");
+	nrOfFailedTestCases += ReportTestResult(VerifyElementFormat<mx_e5m2>(0x1p-16, 0x1p-14, 57344.0, reportTestCases), "mxfp8_e5m2", "element encodings");
+	nrOfFailedTestCases += ReportTestResult(VerifyElementFormat<mx_e3m2>(0.0625, 0.25, 28.0, reportTestCases), "mxfp6_e3m2", "element encodings");
+	nrOfFailedTestCases += ReportTestResult(VerifyElementFormat<mx_e2m3>(0.125, 1.0, 7.5, reportTestCases), "mxfp6_e2m3", "element encodings");
+	nrOfFailedTestCases += ReportTestResult(VerifyElementFormat<mx_e2m1>(0.5, 1.0, 6.0, reportTestCases), "mxfp4_e2m1", "element encodings");
+	nrOfFailedTestCases += ReportTestResult(VerifyElementFormat<mx_int8>(0.015625, 0.0, 127.0 / 64.0, reportTestCases), "mxint8", "element encodings");
+
+	nrOfFailedTestCases += ReportTestResult(VerifyElementRounding<mx_e4m3>(reportTestCases), "mxfp8_e4m3", "element rounding");
+	nrOfFailedTestCases += ReportTestResult(VerifyElementRounding<mx_e5m2>(reportTestCases), "mxfp8_e5m2", "element rounding");
+	nrOfFailedTestCases += ReportTestResult(VerifyElementRounding<mx_e3m2>(reportTestCases), "mxfp6_e3m2", "element rounding");
+	nrOfFailedTestCases += ReportTestResult(VerifyElementRounding<mx_e2m3>(reportTestCases), "mxfp6_e2m3", "element rounding");
+	nrOfFailedTestCases += ReportTestResult(VerifyElementRounding<mx_e2m1>(reportTestCases), "mxfp4_e2m1", "element rounding");
+	nrOfFailedTestCases += ReportTestResult(VerifyElementRounding<mx_int8>(reportTestCases), "mxint8", "element rounding");
+
+	nrOfFailedTestCases += ReportTestResult(VerifyBlockQuantization<mxfp8_e4m3>(reportTestCases), "mxfp8_e4m3", "block quantization");
+	nrOfFailedTestCases += ReportTestResult(VerifyBlockQuantization<mxfp8_e5m2>(reportTestCases), "mxfp8_e5m2", "block quantization");
+	nrOfFailedTestCases += ReportTestResult(VerifyBlockQuantization<mxfp6_e3m2>(reportTestCases), "mxfp6_e3m2", "block quantization");
+	nrOfFailedTestCases += ReportTestResult(VerifyBlockQuantization<mxfp6_e2m3>(reportTestCases), "mxfp6_e2m3", "block quantization");
+	nrOfFailedTestCases += ReportTestResult(VerifyBlockQuantization<mxfp4>(reportTestCases), "mxfp4_e2m1", "block quantization");
+	nrOfFailedTestCases += ReportTestResult(VerifyBlockQuantization<mxint8>(reportTestCases), "mxint8", "block quantization");
+
+	nrOfFailedTestCases += ReportTestResult(VerifyDot<mxfp8_e4m3, mxfp8_e4m3>(1000, reportTestCases), "mxfp8_e4m3", "dot");
+	nrOfFailedTestCases += ReportTestResult(VerifyDot<mxfp6_e2m3, mxfp6_e3m2>(1000, reportTestCases), "mxfp6", "dot");
+	nrOfFailedTestCases += ReportTestResult(VerifyDot<mxfp4, mxfp4>(1000, reportTestCases), "mxfp4_e2m1", "dot");
+	nrOfFailedTestCases += ReportTestResult(VerifyDot<mxint8, mxfp4>(1000, reportTestCases), "mxint8 . mxfp4", "dot");
+
+	nrOfFailedTestCases += ReportTestResult(VerifyGemm<mxfp8_e4m3, mxfp8_e4m3>(9, 70, 5, reportTestCases), "mxfp8_e4m3", "gemm");
+	nrOfFailedTestCases += ReportTestResult(VerifyGemm<mxfp8_e4m3, mxfp4>(9, 70, 5, reportTestCases), "mxfp8_e4m3 x mxfp4", "gemm");
+	nrOfFailedTestCases += ReportTestResult(VerifyGemm<mxfp6_e2m3, mxfp6_e2m3>(6, 64, 7, reportTestCases), "mxfp6_e2m3", "gemm");
+	nrOfFailedTestCases += ReportTestResult(VerifyGemm<mxint8, mxint8>(5, 33, 3, reportTestCases), "mxint8", "gemm");
+
+	nrOfFailedTestCases += ReportTestResult(VerifyQsnr(reportTestCases), "mx formats", "qsnr sweep");
+#endif
+
+#if REGRESSION_LEVEL_2
+	nrOfFailedTestCases += ReportTestResult(VerifyGemm<mxfp4, mxfp4>(33, 256, 17, reportTestCases), "mxfp4_e2m1", "gemm");
+#endif
+
+#if REGRESSION_LEVEL_3
+
+#endif
+
+#if REGRESSION_LEVEL_4
+
+#endif
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+#endif
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_arithmetic_exception& err) {
+	std::cerr << "Uncaught universal arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_internal_exception& err) {
+	std::cerr << "Uncaught universal internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
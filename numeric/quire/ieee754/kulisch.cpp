@@ -0,0 +1,215 @@
+// kulisch.cpp: verify the exact accumulation and the correct rounding of the word-based Kulisch accumulator
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <algorithm>
+#include <random>
+#include <universal/number/float/kulisch.hpp>
+#include <universal/verification/test_suite.hpp>
+
+template<typename Real>
+bool SameBits(Real a, Real b) {
+	return (std::isnan(a) && std::isnan(b)) || (a == b && std::signbit(a) == std::signbit(b));
+}
+
+template<typename Real>
+int ReportDot(bool reportTestCases, const std::string& label, Real result, Real expected) {
+	if (SameBits(result, expected)) return 0;
+	if (reportTestCases) std::cerr << "FAIL: " << label << " is " << std::setprecision(std::numeric_limits<Real>::max_digits10) << result << " instead of " << expected << '\n';
+	return 1;
+}
+
+// a sum of products that cancel exactly, shuffled with a payload whose exact sum is known
+template<typename Real>
+void CancellingDot(std::vector<Real>& x, std::vector<Real>& y, const std::vector<Real>& payloadX, const std::vector<Real>& payloadY, size_t nrPairs, uint64_t seed) {
+	std::mt19937_64 rng(seed);
+	std::uniform_real_distribution<double> mantissa(-1.0, 1.0);
+	std::uniform_int_distribution<int> exponent(std::numeric_limits<Real>::min_exponent / 2, std::numeric_limits<Real>::max_exponent / 2 - 1);
+	x = payloadX;
+	y = payloadY;
+	for (size_t i = 0; i < nrPairs; ++i) {
+		Real a = Real(std::ldexp(mantissa(rng), exponent(rng)));
+		Real b = Real(std::ldexp(mantissa(rng), exponent(rng)));
+		x.push_back(a);  y.push_back(b);
+		x.push_back(-a); y.push_back(b);
+	}
+	std::vector<size_t> order(x.size());
+	for (size_t i = 0; i < order.size(); ++i) order[i] = i;
+	std::shuffle(order.begin(), order.end(), rng);
+	std::vector<Real> sx(x.size()), sy(y.size());
+	for (size_t i = 0; i < order.size(); ++i) { sx[i] = x[order[i]]; sy[i] = y[order[i]]; }
+	x.swap(sx);
+	y.swap(sy);
+}
+
+// the fused dot product rounds the exact sum once: catastrophic cancellation, ties, and sticky bits far below the result
+template<typename Real>
+int VerifyExactRounding(bool reportTestCases) {
+	using namespace sw::universal;
+	constexpr int fbits = std::numeric_limits<Real>::digits;
+	int nrOfFailedTests = 0;
+	struct Case { std::vector<Real> x, y; Real expected; const char* label; };
+	Real one(1), ulp = std::ldexp(one, 1 - fbits), halfUlp = std::ldexp(one, -fbits), tiny = std::ldexp(one, -fbits - 100);
+	Real big = std::numeric_limits<Real>::max();
+	Real minSubnormal = std::numeric_limits<Real>::denorm_min();
+	constexpr int emin = std::numeric_limits<Real>::min_exponent - fbits;
+	Real lowerRoot = std::ldexp(one, emin / 2), upperRoot = std::ldexp(one, emin - emin / 2);  // lowerRoot * upperRoot is the smallest subnormal
+	const Case cases[] = {
+		{ { Real(1.0e30), one, Real(-1.0e30) }, { one, one, one }, one, "cancellation" },
+		{ { one, halfUlp }, { one, one }, one, "tie to even down" },
+		{ { one + ulp, halfUlp }, { one, one }, one + 2 * ulp, "tie to even up" },
+		{ { one, halfUlp, tiny }, { one, one, one }, one + ulp, "sticky below the tie" },
+		{ { one, -halfUlp, -tiny }, { one, one, one }, one - halfUlp, "borrow through the sticky bits" },
+		{ { big, big, -big }, { Real(4), Real(4), Real(4) }, std::numeric_limits<Real>::infinity(), "overflow" },
+		{ { big, one, -big }, { Real(4), one, Real(4) }, one, "intermediate beyond the dynamic range" },
+		{ { lowerRoot }, { upperRoot }, minSubnormal, "smallest subnormal" },
+		{ { lowerRoot }, { upperRoot / 2 }, Real(0), "half of the smallest subnormal ties to zero" },
+		{ { lowerRoot, lowerRoot, lowerRoot }, { upperRoot / 2, upperRoot / 2, upperRoot / 2 }, 2 * minSubnormal, "three halves of the smallest subnormal" },
+		{ { minSubnormal, one }, { minSubnormal, -one }, -one, "product below the smallest subnormal" },
+		{ { std::numeric_limits<Real>::infinity(), one }, { one, one }, std::numeric_limits<Real>::infinity(), "infinity" },
+		{ { std::numeric_limits<Real>::infinity(), -std::numeric_limits<Real>::infinity() }, { one, one }, std::numeric_limits<Real>::quiet_NaN(), "inf - inf" },
+		{ { std::numeric_limits<Real>::infinity() }, { Real(0) }, std::numeric_limits<Real>::quiet_NaN(), "inf * 0" },
+		{ { std::numeric_limits<Real>::quiet_NaN(), one }, { one, one }, std::numeric_limits<Real>::quiet_NaN(), "nan" },
+		{ {}, {}, Real(0), "empty" },
+	};
+	for (const Case& c : cases) {
+		nrOfFailedTests += ReportDot(reportTestCases, c.label, fdp(c.x.data(), c.y.data(), c.x.size()), c.expected);
+	}
+
+	// long cancelling sums around a payload with a known rounding
+	std::vector<Real> x, y;
+	CancellingDot(x, y, { one, halfUlp, tiny }, { one, one, one }, 20000, 1);
+	nrOfFailedTests += ReportDot(reportTestCases, "cancelling pairs around a sticky tie", fdp(x.data(), y.data(), x.size()), one + ulp);
+	CancellingDot(x, y, { Real(3), Real(-1) }, { Real(0.25), Real(0.75) }, 20000, 2);
+	nrOfFailedTests += ReportDot(reportTestCases, "cancelling pairs around zero", fdp(x.data(), y.data(), x.size()), Real(0));
+	return nrOfFailedTests;
+}
+
+// accumulators merged in any grouping and the parallel fused dot product on any number of threads
+// must produce the bits of the serial fused dot product
+template<typename Real>
+int VerifyReproducibility(bool reportTestCases, size_t N) {
+	using namespace sw::universal;
+	std::mt19937_64 rng(7);
+	std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+	std::vector<Real> x(N), y(N);
+	for (size_t i = 0; i < N; ++i) {
+		x[i] = Real(std::ldexp(distribution(rng), int(i % 61) - 30));
+		y[i] = Real(distribution(rng));
+	}
+	Real reference = fdp(x.data(), y.data(), N);
+	int nrOfFailedTests = 0;
+
+	// element by element in reverse order
+	kulisch_accumulator<Real> q;
+	for (size_t i = N; i > 0; --i) q.add_product(x[i - 1], y[i - 1]);
+	nrOfFailedTests += ReportDot(reportTestCases, "reverse order", q.value(), reference);
+
+	// merged partial accumulators of uneven chunks
+	kulisch_accumulator<Real> merged;
+	for (size_t first = 0, chunk = 1; first < N; first += chunk, chunk = chunk * 3 + 1) {
+		kulisch_accumulator<Real> partial;
+		partial.add_products(x.data() + first, y.data() + first, std::min(chunk, N - first));
+		merged += partial;
+	}
+	nrOfFailedTests += ReportDot(reportTestCases, "merged partial accumulators", merged.value(), reference);
+
+	for (unsigned nrThreads : { 1u, 2u, 3u, 8u, 0u }) {
+		nrOfFailedTests += ReportDot(reportTestCases, "parallel fdp on " + std::to_string(nrThreads) + " threads", fdp_parallel(x.data(), y.data(), N, nrThreads), reference);
+	}
+
+	// the exact sum of the negated products is the negated sum
+	for (size_t i = 0; i < N; ++i) q.add_product(-x[i], y[i]);
+	nrOfFailedTests += ReportDot(reportTestCases, "sum of the products and their negation", q.value(), Real(0));
+	return nrOfFailedTests;
+}
+
+// the double accumulator is exact on float products: the float fused dot product of data whose exact
+// sum is a double must be that double rounded once to float
+int VerifyFloatAgainstDouble(bool reportTestCases, size_t N) {
+	using namespace sw::universal;
+	std::mt19937_64 rng(11);
+	std::uniform_int_distribution<int> significand(-(1 << 11), 1 << 11);
+	std::uniform_int_distribution<int> exponent(-4, 4);
+	int nrOfFailedTests = 0;
+	for (int trial = 0; trial < 100; ++trial) {
+		// 24-bit products over 16 binades: the exact sum of 64 of them fits the 53 bits of a double
+		std::vector<float> x(N), y(N);
+		std::vector<double> dx(N), dy(N);
+		for (size_t i = 0; i < N; ++i) {
+			x[i] = std::ldexp(float(significand(rng)), exponent(rng));
+			y[i] = std::ldexp(float(significand(rng)), exponent(rng) - 11);
+			dx[i] = x[i];
+			dy[i] = y[i];
+		}
+		float expected = float(fdp(dx.data(), dy.data(), N));
+		nrOfFailedTests += ReportDot(reportTestCases, "float fdp against the exact double fdp", fdp(x.data(), y.data(), N), expected);
+		if (nrOfFailedTests > 0) break;
+	}
+	return nrOfFailedTests;
+}
+
+// Regression testing guards: typically set by the cmake configuration, but MANUAL_TESTING is an override
+#define MANUAL_TESTING 0
+// REGRESSION_LEVEL_OVERRIDE is set by the cmake file to drive a specific regression intensity
+// It is the responsibility of the regression test to organize the tests in a quartile progression.
+//#undef REGRESSION_LEVEL_OVERRIDE
+#ifndef REGRESSION_LEVEL_OVERRIDE
+#undef REGRESSION_LEVEL_1
+#undef REGRESSION_LEVEL_2
+#undef REGRESSION_LEVEL_3
+#undef REGRESSION_LEVEL_4
+#define REGRESSION_LEVEL_1 1
+#define REGRESSION_LEVEL_2 1
+#define REGRESSION_LEVEL_3 1
+#define REGRESSION_LEVEL_4 1
+#endif
+
+int main()
+try {
+	using namespace sw::universal;
+
+	std::string test_suite  = "word-based Kulisch accumulator for float and double";
+	std::string test_tag    = "kulisch";
+	bool reportTestCases    = true;
+	int nrOfFailedTestCases = 0;
+
+	ReportTestSuiteHeader(test_suite, reportTestCases);
+
+#if REGRESSION_LEVEL_1
+	nrOfFailedTestCases += ReportTestResult(VerifyExactRounding<double>(reportTestCases), "double", "exact rounding");
+	nrOfFailedTestCases += ReportTestResult(VerifyExactRounding<float>(reportTestCases), "float", "exact rounding");
+	nrOfFailedTestCases += ReportTestResult(VerifyReproducibility<double>(reportTestCases, 100000), "double", "reproducibility");
+#endif
+
+#if REGRESSION_LEVEL_2
+	nrOfFailedTestCases += ReportTestResult(VerifyReproducibility<float>(reportTestCases, 100000), "float", "reproducibility");
+	nrOfFailedTestCases += ReportTestResult(VerifyFloatAgainstDouble(reportTestCases, 64), "float", "fdp against double");
+#endif
+
+#if REGRESSION_LEVEL_3
+	nrOfFailedTestCases += ReportTestResult(VerifyReproducibility<double>(reportTestCases, 1000000), "double", "reproducibility");
+#endif
+
+#if REGRESSION_LEVEL_4
+	nrOfFailedTestCases += ReportTestResult(VerifyReproducibility<float>(reportTestCases, 1000000), "float", "reproducibility");
+#endif
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
@@ -0,0 +1,235 @@
+// native_arithmetic.cpp: test suite runner for the native integer arithmetic path of small cfloats
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <universal/number/cfloat/cfloat.hpp>
+#include <universal/verification/test_status.hpp>
+#include <universal/verification/test_reporters.hpp>
+
+// cfloats of 16 bits or less use native integer arithmetic in operator+=, operator*=, and operator/=.
+// These tests verify that the native path produces the same bits as the blocktriple path
+// it replaces, for all encodings of the 8-bit configurations, and for random samples of the 16-bit ones.
+
+namespace sw { namespace universal {
+
+	// the arithmetic path used by cfloats that are too big for native integer arithmetic
+	template<typename Cfloat>
+	Cfloat BlockTripleAdd(const Cfloat& lhs, const Cfloat& rhs) {
+		constexpr unsigned fbits = Cfloat::fbits;
+		using bt = typename Cfloat::BlockType;
+		blocktriple<fbits, BlockTripleOperator::ADD, bt> a, b, sum;
+		lhs.normalizeAddition(a);
+		rhs.normalizeAddition(b);
+		sum.add(a, b);
+		Cfloat c;
+		convert(sum, c);
+		return c;
+	}
+	template<typename Cfloat>
+	Cfloat BlockTripleMul(const Cfloat& lhs, const Cfloat& rhs) {
+		constexpr unsigned fbits = Cfloat::fbits;
+		using bt = typename Cfloat::BlockType;
+		blocktriple<fbits, BlockTripleOperator::MUL, bt> a, b, product;
+		lhs.normalizeMultiplication(a);
+		rhs.normalizeMultiplication(b);
+		product.mul(a, b);
+		Cfloat c;
+		convert(product, c);
+		return c;
+	}
+	template<typename Cfloat>
+	Cfloat BlockTripleDiv(const Cfloat& lhs, const Cfloat& rhs) {
+		constexpr unsigned fbits = Cfloat::fbits;
+		using bt = typename Cfloat::BlockType;
+		using BlockTriple = blocktriple<fbits, BlockTripleOperator::DIV, bt>;
+		BlockTriple a, b, quotient;
+		lhs.normalizeDivision(a);
+		rhs.normalizeDivision(b);
+		quotient.div(a, b);
+		quotient.setradix(BlockTriple::radix);
+		Cfloat c;
+		convert(quotient, c);
+		return c;
+	}
+
+	// compare the native and the blocktriple path for a pair of finite, nonzero operands
+	template<typename Cfloat>
+	int VerifyNativePair(bool reportTestCases, const Cfloat& a, const Cfloat& b, int& nrOfSamples) {
+		if (a.isnan() || a.isinf() || a.iszero() || b.isnan() || b.isinf() || b.iszero()) return 0;
+		++nrOfSamples;
+		int nrOfFailedTests = 0;
+		Cfloat c, cref;
+		c = a + b; cref = BlockTripleAdd(a, b);
+		if (c != cref || c.sign() != cref.sign()) {
+			++nrOfFailedTests;
+			if (reportTestCases) ReportBinaryArithmeticError("FAIL", "+", a, b, c, cref);
+		}
+		c = a - b; cref = BlockTripleAdd(a, -b);
+		if (c != cref || c.sign() != cref.sign()) {
+			++nrOfFailedTests;
+			if (reportTestCases) ReportBinaryArithmeticError("FAIL", "-", a, b, c, cref);
+		}
+		c = a * b; cref = BlockTripleMul(a, b);
+		if (c != cref || c.sign() != cref.sign()) {
+			++nrOfFailedTests;
+			if (reportTestCases) ReportBinaryArithmeticError("FAIL", "*", a, b, c, cref);
+		}
+		c = a / b; cref = BlockTripleDiv(a, b);
+		if (c != cref || c.sign() != cref.sign()) {
+			++nrOfFailedTests;
+			if (reportTestCases) ReportBinaryArithmeticError("FAIL", "/", a, b, c, cref);
+		}
+		return nrOfFailedTests;
+	}
+
+	template<typename Cfloat>
+	int VerifyNativeArithmetic(bool reportTestCases) {
+		static_assert(Cfloat::NATIVE_ARITHMETIC, "configuration does not use native arithmetic");
+		constexpr unsigned NR_VALUES = (1u << Cfloat::nbits);
+		int nrOfSamples = 0;
+		int nrOfFailedTests = 0;
+		Cfloat a, b;
+		for (unsigned i = 0; i < NR_VALUES; ++i) {
+			a.setbits(i);
+			for (unsigned j = 0; j < NR_VALUES; ++j) {
+				b.setbits(j);
+				nrOfFailedTests += VerifyNativePair(reportTestCases, a, b, nrOfSamples);
+				if (nrOfFailedTests > 24) return nrOfFailedTests;
+			}
+		}
+		return nrOfFailedTests;
+	}
+
+	template<typename Cfloat>
+	int VerifyNativeArithmeticThroughRandoms(bool reportTestCases, unsigned nrTests) {
+		static_assert(Cfloat::NATIVE_ARITHMETIC, "configuration does not use native arithmetic");
+		std::mt19937_64 generator(0x5eed);
+		std::uniform_int_distribution<uint64_t> distribution(0, (1ull << Cfloat::nbits) - 1ull);
+		int nrOfSamples = 0;
+		int nrOfFailedTests = 0;
+		Cfloat a, b;
+		for (unsigned i = 0; i < nrTests; ++i) {
+			a.setbits(distribution(generator));
+			b.setbits(distribution(generator));
+			nrOfFailedTests += VerifyNativePair(reportTestCases, a, b, nrOfSamples);
+			if (nrOfFailedTests > 24) return nrOfFailedTests;
+		}
+		return nrOfFailedTests;
+	}
+
+}} // namespace sw::universal
+
+template<unsigned nbits, unsigned es, typename bt = uint8_t>
+int VerifyAllFlavors(bool reportTestCases, const std::string& test_tag) {
+	using namespace sw::universal;
+	int nrOfFailedTestCases = 0;
+	nrOfFailedTestCases += ReportTestResult(VerifyNativeArithmetic< cfloat<nbits, es, bt, false, false, false> >(reportTestCases), type_tag(cfloat<nbits, es, bt, false, false, false>()), test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyNativeArithmetic< cfloat<nbits, es, bt, true, false, false> >(reportTestCases), type_tag(cfloat<nbits, es, bt, true, false, false>()), test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyNativeArithmetic< cfloat<nbits, es, bt, false, true, false> >(reportTestCases), type_tag(cfloat<nbits, es, bt, false, true, false>()), test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyNativeArithmetic< cfloat<nbits, es, bt, true, true, false> >(reportTestCases), type_tag(cfloat<nbits, es, bt, true, true, false>()), test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyNativeArithmetic< cfloat<nbits, es, bt, false, false, true> >(reportTestCases), type_tag(cfloat<nbits, es, bt, false, false, true>()), test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyNativeArithmetic< cfloat<nbits, es, bt, true, true, true> >(reportTestCases), type_tag(cfloat<nbits, es, bt, true, true, true>()), test_tag);
+	return nrOfFailedTestCases;
+}
+
+// Regression testing guards: typically set by the cmake configuration, but MANUAL_TESTING is an override
+#define MANUAL_TESTING 0
+// REGRESSION_LEVEL_OVERRIDE is set by the cmake file to drive a specific regression intensity
+// It is the responsibility of the regression test to organize the tests in a quartile progression.
+//#undef REGRESSION_LEVEL_OVERRIDE
+#ifndef REGRESSION_LEVEL_OVERRIDE
+#undef REGRESSION_LEVEL_1
+#undef REGRESSION_LEVEL_2
+#undef REGRESSION_LEVEL_3
+#undef REGRESSION_LEVEL_4
+#define REGRESSION_LEVEL_1 1
+#define REGRESSION_LEVEL_2 1
+#define REGRESSION_LEVEL_3 1
+#define REGRESSION_LEVEL_4 1
+#endif
+
+int main()
+try {
+	using namespace sw::universal;
+
+	std::string test_suite  = "cfloat native arithmetic validation against the blocktriple path";
+	std::string test_tag    = "native arithmetic";
+	bool reportTestCases    = true;
+	int nrOfFailedTestCases = 0;
+
+	ReportTestSuiteHeader(test_suite, reportTestCases);
+
+#if MANUAL_TESTING
+
+	{
+		using Cfloat = cfloat<8, 2, uint8_t, true, true, false>;
+		Cfloat a, b;
+		a.setbits(0x01); b.setbits(0x41);
+		std::cout << to_binary(a * b) << " : " << (a * b) << '\n';
+		std::cout << to_binary(BlockTripleMul(a, b)) << " : " << BlockTripleMul(a, b) << '\n';
+	}
+	nrOfFailedTestCases += VerifyAllFlavors<8, 2>(reportTestCases, test_tag);
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return EXIT_SUCCESS;   // ignore failures
+#else
+
+#if REGRESSION_LEVEL_1
+	nrOfFailedTestCases += VerifyAllFlavors<8, 2>(reportTestCases, test_tag);
+	nrOfFailedTestCases += VerifyAllFlavors<8, 3>(reportTestCases, test_tag);
+	nrOfFailedTestCases += VerifyAllFlavors<8, 4>(reportTestCases, test_tag);
+	nrOfFailedTestCases += VerifyAllFlavors<8, 5>(reportTestCases, test_tag);
+#endif
+
+#if REGRESSION_LEVEL_2
+	nrOfFailedTestCases += VerifyAllFlavors<8, 6>(reportTestCases, test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyNativeArithmetic< cfloat<8, 1, uint8_t, true, true, false> >(reportTestCases), type_tag(cfloat<8, 1, uint8_t, true, true, false>()), test_tag);
+	nrOfFailedTestCases += VerifyAllFlavors<7, 3>(reportTestCases, test_tag);
+	nrOfFailedTestCases += VerifyAllFlavors<9, 4, uint16_t>(reportTestCases, test_tag);
+#endif
+
+#if REGRESSION_LEVEL_3
+	// fp16, bfloat16, and their 16-bit cousins
+	nrOfFailedTestCases += ReportTestResult(VerifyNativeArithmeticThroughRandoms< cfloat<16, 5, uint16_t, true, false, false> >(reportTestCases, 200000), "cfloat<16,5,uint16_t,t,f,f>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyNativeArithmeticThroughRandoms< cfloat<16, 5, uint8_t, true, true, true> >(reportTestCases, 200000), "cfloat<16,5,uint8_t,t,t,t>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyNativeArithmeticThroughRandoms< cfloat<16, 8, uint16_t, true, false, false> >(reportTestCases, 200000), "cfloat<16,8,uint16_t,t,f,f>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyNativeArithmeticThroughRandoms< cfloat<16, 8, uint8_t, false, false, false> >(reportTestCases, 200000), "cfloat<16,8,uint8_t,f,f,f>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyNativeArithmeticThroughRandoms< cfloat<16, 2, uint16_t, true, true, false> >(reportTestCases, 200000), "cfloat<16,2,uint16_t,t,t,f>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyNativeArithmeticThroughRandoms< cfloat<12, 4, uint16_t, true, false, false> >(reportTestCases, 200000), "cfloat<12,4,uint16_t,t,f,f>", test_tag);
+#endif
+
+#if REGRESSION_LEVEL_4
+	nrOfFailedTestCases += VerifyAllFlavors<10, 3, uint16_t>(reportTestCases, test_tag);
+#endif
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+
+#endif  // MANUAL_TESTING
+}
+catch (char const* msg) {
+	std::cerr << "Caught ad-hoc exception: " << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_arithmetic_exception& err) {
+	std::cerr << "Caught unexpected universal arithmetic exception : " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_internal_exception& err) {
+	std::cerr << "Caught unexpected universal internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Caught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
@@ -0,0 +1,206 @@
+// sqrt.cpp: test suite runner for the correctly rounded cfloat square root
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <random>
+#include <universal/number/cfloat/cfloat.hpp>
+#include <universal/verification/test_suite.hpp>
+#include <universal/verification/cfloat_test_suite.hpp>
+
+// Small configurations take the native integer square root in sqrt(), so drive the blocktriple
+// path directly, and compare it exhaustively to the double precision reference, which rounds
+// correctly as long as 2 * (fbits + 1) + 2 <= 53
+template<typename Cfloat>
+int VerifyBlocktripleSqrt(bool reportTestCases) {
+	using namespace sw::universal;
+	constexpr unsigned nbits = Cfloat::nbits;
+	constexpr unsigned fbits = Cfloat::fbits;
+	using BlockType = typename Cfloat::BlockType;
+	static_assert(2 * (fbits + 1) + 2 <= 53, "reference is not correctly rounded");
+
+	int nrOfFailedTests = 0;
+	for (unsigned i = 1; i < (1u << (nbits - 1)); ++i) {
+		Cfloat a, result, ref;
+		a.setbits(i);
+		if (a.isnan() || a.isinf()) continue;
+		blocktriple<fbits, BlockTripleOperator::SQRT, BlockType> radicand, root;
+		a.normalizeSqrt(radicand);
+		root.sqrt(radicand);
+		convert(root, result);
+		ref = std::sqrt(double(a));
+		if (result != ref) {
+			++nrOfFailedTests;
+			if (reportTestCases) ReportUnaryArithmeticError("FAIL", "sqrt", a, result, ref);
+			if (nrOfFailedTests > 24) return nrOfFailedTests;
+		}
+	}
+	return nrOfFailedTests;
+}
+
+// random positive arguments against the double precision reference
+template<typename Cfloat>
+int VerifyRandomSqrt(bool reportTestCases, unsigned nrOfRandoms) {
+	using namespace sw::universal;
+	std::mt19937_64 generator(0x5eed);
+	int nrOfFailedTests = 0;
+	for (unsigned i = 0; i < nrOfRandoms; ++i) {
+		Cfloat a, result, ref;
+		a.setbits(generator());
+		a.setsign(false);
+		if (a.isnan() || a.isinf()) continue;
+		result = sw::universal::sqrt(a);
+		ref = std::sqrt(double(a));
+		if (result != ref) {
+			++nrOfFailedTests;
+			if (reportTestCases) ReportUnaryArithmeticError("FAIL", "sqrt", a, result, ref);
+			if (nrOfFailedTests > 24) return nrOfFailedTests;
+		}
+	}
+	return nrOfFailedTests;
+}
+
+// configurations wider than double have no native reference: the root of an exact square
+// must reproduce its argument, and the root of 2 must match the leading digits of sqrt(2)
+template<typename Cfloat>
+int VerifyExactSquares(bool reportTestCases, unsigned nrOfRandoms) {
+	using namespace sw::universal;
+	constexpr unsigned halfBits = (Cfloat::fbits + 1) / 2;
+	std::mt19937_64 generator(0x5eed);
+	int nrOfFailedTests = 0;
+	for (unsigned i = 0; i < nrOfRandoms; ++i) {
+		uint64_t significand = (generator() >> (64 - (halfBits < 32 ? halfBits : 32))) | 1ull;
+		int scale = static_cast<int>(generator() % 64) - 32;
+		Cfloat x = std::ldexp(double(significand), scale);
+		Cfloat square = x * x;
+		Cfloat result = sw::universal::sqrt(square);
+		if (result != x) {
+			++nrOfFailedTests;
+			if (reportTestCases) ReportUnaryArithmeticError("FAIL", "sqrt", square, result, x);
+			if (nrOfFailedTests > 24) return nrOfFailedTests;
+		}
+	}
+	Cfloat root2 = sw::universal::sqrt(Cfloat(2));
+	if (std::abs(double(root2) - 1.4142135623730951) > 1.0e-15) ++nrOfFailedTests;
+	return nrOfFailedTests;
+}
+
+// special values follow IEEE-754: sqrt(+-0) = +-0, sqrt(+inf) = +inf, sqrt(nan) = nan
+template<typename Cfloat>
+int VerifySqrtSpecialCases(bool reportTestCases) {
+	using namespace sw::universal;
+	int nrOfFailedTests = 0;
+	Cfloat a;
+	a.setzero();
+	if (!sw::universal::sqrt(a).iszero()) ++nrOfFailedTests;
+	a = -a;
+	if (!sw::universal::sqrt(a).iszero() || !sw::universal::sqrt(a).sign()) ++nrOfFailedTests;
+	a.setinf(false);
+	if (!sw::universal::sqrt(a).isinf()) ++nrOfFailedTests;
+	a.setnan(NAN_TYPE_QUIET);
+	if (!sw::universal::sqrt(a).isnan()) ++nrOfFailedTests;
+	if (reportTestCases && nrOfFailedTests > 0) std::cerr << "FAIL: sqrt special cases of " << type_tag(a) << '\n';
+	return nrOfFailedTests;
+}
+
+// Regression testing guards: typically set by the cmake configuration, but MANUAL_TESTING is an override
+#define MANUAL_TESTING 0
+// REGRESSION_LEVEL_OVERRIDE is set by the cmake file to drive a specific regression intensity
+// It is the responsibility of the regression test to organize the tests in a quartile progression.
+//#undef REGRESSION_LEVEL_OVERRIDE
+#ifndef REGRESSION_LEVEL_OVERRIDE
+#undef REGRESSION_LEVEL_1
+#undef REGRESSION_LEVEL_2
+#undef REGRESSION_LEVEL_3
+#undef REGRESSION_LEVEL_4
+#define REGRESSION_LEVEL_1 1
+#define REGRESSION_LEVEL_2 1
+#define REGRESSION_LEVEL_3 1
+#define REGRESSION_LEVEL_4 1
+#endif
+
+int main()
+try {
+	using namespace sw::universal;
+
+	std::string test_suite  = "cfloat correctly rounded square root validation";
+	std::string test_tag    = "sqrt";
+	bool reportTestCases    = true;
+	int nrOfFailedTestCases = 0;
+
+	ReportTestSuiteHeader(test_suite, reportTestCases);
+
+#if MANUAL_TESTING
+	using Cfloat = cfloat<16, 5, uint16_t, true, false, false>;
+	Cfloat a(2.0f);
+	std::cout << "sqrt(" << a << ") = " << sqrt(a) << " : " << to_binary(sqrt(a)) << '\n';
+	nrOfFailedTestCases += ReportTestResult(VerifyBlocktripleSqrt< Cfloat >(reportTestCases), type_tag(Cfloat()), "sqrt blocktriple");
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return EXIT_SUCCESS;   // ignore errors
+#else
+
+#if REGRESSION_LEVEL_1
+	// native integer path
+	nrOfFailedTestCases += ReportTestResult(VerifyCfloatSqrt< cfloat< 8, 2, uint8_t, true, false, false> >(reportTestCases), "cfloat< 8,2,tff>", "sqrt");
+	nrOfFailedTestCases += ReportTestResult(VerifyCfloatSqrt< cfloat< 8, 4, uint8_t, false, false, false> >(reportTestCases), "cfloat< 8,4,fff>", "sqrt");
+	nrOfFailedTestCases += ReportTestResult(VerifyCfloatSqrt< cfloat< 8, 3, uint8_t, true, true, false> >(reportTestCases), "cfloat< 8,3,ttf>", "sqrt");
+	nrOfFailedTestCases += ReportTestResult(VerifyCfloatSqrt< cfloat< 8, 3, uint8_t, true, true, true> >(reportTestCases), "cfloat< 8,3,ttt>", "sqrt");
+	nrOfFailedTestCases += ReportTestResult(VerifyCfloatSqrt< cfloat<12, 4, uint8_t, true, false, false> >(reportTestCases), "cfloat<12,4,tff>", "sqrt");
+
+	// blocktriple path
+	nrOfFailedTestCases += ReportTestResult(VerifyBlocktripleSqrt< cfloat< 8, 2, uint8_t, true, false, false> >(reportTestCases), "cfloat< 8,2,tff>", "sqrt blocktriple");
+	nrOfFailedTestCases += ReportTestResult(VerifyBlocktripleSqrt< cfloat< 8, 4, uint8_t, false, false, false> >(reportTestCases), "cfloat< 8,4,fff>", "sqrt blocktriple");
+	nrOfFailedTestCases += ReportTestResult(VerifyBlocktripleSqrt< cfloat< 8, 3, uint8_t, true, true, false> >(reportTestCases), "cfloat< 8,3,ttf>", "sqrt blocktriple");
+	nrOfFailedTestCases += ReportTestResult(VerifyBlocktripleSqrt< cfloat<12, 4, uint8_t, true, false, false> >(reportTestCases), "cfloat<12,4,tff>", "sqrt blocktriple");
+
+	nrOfFailedTestCases += ReportTestResult(VerifySqrtSpecialCases< cfloat< 8, 2, uint8_t, true, false, false> >(reportTestCases), "cfloat< 8,2,tff>", "sqrt special cases");
+	nrOfFailedTestCases += ReportTestResult(VerifySqrtSpecialCases< cfloat<32, 8, uint32_t, true, false, false> >(reportTestCases), "cfloat<32,8,tff>", "sqrt special cases");
+#endif
+
+#if REGRESSION_LEVEL_2
+	nrOfFailedTestCases += ReportTestResult(VerifyCfloatSqrt< cfloat<16, 5, uint16_t, true, false, false> >(reportTestCases), "cfloat<16,5,tff>", "sqrt");
+	nrOfFailedTestCases += ReportTestResult(VerifyCfloatSqrt< cfloat<16, 8, uint16_t, true, false, false> >(reportTestCases), "cfloat<16,8,tff>", "sqrt");
+	nrOfFailedTestCases += ReportTestResult(VerifyBlocktripleSqrt< cfloat<16, 5, uint16_t, true, false, false> >(reportTestCases), "cfloat<16,5,tff>", "sqrt blocktriple");
+	nrOfFailedTestCases += ReportTestResult(VerifyBlocktripleSqrt< cfloat<16, 8, uint8_t, true, false, false> >(reportTestCases), "cfloat<16,8,tff>", "sqrt blocktriple");
+#endif
+
+#if REGRESSION_LEVEL_3
+	nrOfFailedTestCases += ReportTestResult(VerifyRandomSqrt< cfloat<32, 8, uint32_t, true, false, false> >(reportTestCases, 100000), "cfloat<32,8,tff>", "sqrt");
+	nrOfFailedTestCases += ReportTestResult(VerifyRandomSqrt< cfloat<24, 5, uint8_t, true, false, false> >(reportTestCases, 100000), "cfloat<24,5,tff>", "sqrt");
+#endif
+
+#if REGRESSION_LEVEL_4
+	// IEEE-754 double precision is its own reference
+	nrOfFailedTestCases += ReportTestResult(VerifyRandomSqrt< cfloat<64, 11, uint64_t, true, false, false> >(reportTestCases, 100000), "cfloat<64,11,tff>", "sqrt");
+	nrOfFailedTestCases += ReportTestResult(VerifyRandomSqrt< cfloat<64, 11, uint32_t, true, false, false> >(reportTestCases, 10000), "cfloat<64,11,tff>", "sqrt");
+	nrOfFailedTestCases += ReportTestResult(VerifyExactSquares< cfloat<80, 15, uint32_t, true, false, false> >(reportTestCases, 10000), "cfloat<80,15,tff>", "sqrt");
+	nrOfFailedTestCases += ReportTestResult(VerifyExactSquares< cfloat<128, 15, uint64_t, true, false, false> >(reportTestCases, 10000), "cfloat<128,15,tff>", "sqrt");
+#endif
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+#endif  // MANUAL_TESTING
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_arithmetic_exception& err) {
+	std::cerr << "Uncaught universal arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_internal_exception& err) {
+	std::cerr << "Uncaught universal internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
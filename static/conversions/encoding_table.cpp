@@ -0,0 +1,241 @@
+// encoding_table.cpp: verify that the table conversions of small formats are identical to their arithmetic conversions
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <random>
+#include <universal/number/cfloat/cfloat.hpp>
+#include <universal/number/posit/posit.hpp>
+#include <universal/number/lns/lns.hpp>
+#include <universal/number/fixpnt/fixpnt.hpp>
+#include <universal/verification/test_suite.hpp>
+
+/*
+ * Formats of 12 bits or less decode to double through their encoding table, and posits also
+ * encode through it. Formats of 16 bits tabulate only on request and keep their arithmetic
+ * conversions, so the reference table verifies their tables. The reference is the arithmetic
+ * conversion from and to double of the format, which is public in cfloat and posit, and protected
+ * in lns. The encode table is verified for every format, also for the formats that keep their
+ * arithmetic conversion from double.
+ */
+template<typename Number>
+struct ArithmeticConversion : public Number {
+	double decode() const {
+		if constexpr (requires { this->template arithmetic_to_native<double>(); }) return this->template arithmetic_to_native<double>();
+		else if constexpr (requires { this->template arithmetic_to_ieee754<double>(); }) return this->template arithmetic_to_ieee754<double>();
+		else return this->arithmetic_to_double();
+	}
+	void encode(double v) {
+		if constexpr (requires { this->arithmetic_convert_ieee754(v); }) this->arithmetic_convert_ieee754(v);
+		else static_cast<Number&>(*this) = v;
+	}
+};
+
+template<typename Number>
+double ReferenceDecode(const Number& a) {
+	ArithmeticConversion<Number> r;
+	static_cast<Number&>(r) = a;
+	return r.decode();
+}
+template<typename Number>
+Number ReferenceEncode(double v) {
+	ArithmeticConversion<Number> r;
+	r.encode(v);
+	return static_cast<const Number&>(r);
+}
+
+// encoding table with the rounding boundaries of the arithmetic conversion from double
+template<typename Number>
+const sw::universal::encoding_table<Number::nbits>& ReferenceTable() {
+	static const sw::universal::encoding_table<Number::nbits> table(
+		[](uint64_t raw) { Number a; a.setbits(raw); return ReferenceDecode(a); },
+		[](double v) {
+			Number a = ReferenceEncode<Number>(v);
+			uint64_t raw{ 0 };
+			for (unsigned i = 0; i < Number::nbits; ++i) if (a.at(i)) raw |= (uint64_t(1) << i);
+			return raw;
+		});
+	return table;
+}
+
+// the double value of every encoding must be the value of the arithmetic decode
+template<typename Number>
+int VerifyTableDecode(bool reportTestCases) {
+	using namespace sw::universal;
+	constexpr size_t NR_ENCODINGS = size_t(1) << Number::nbits;
+	int nrOfFailedTests = 0;
+	Number a;
+	for (size_t i = 0; i < NR_ENCODINGS; ++i) {
+		a.setbits(i);
+		double table = double(a);
+		double reference = ReferenceDecode(a);
+		if (std::isnan(table) != std::isnan(reference) || (!std::isnan(table) && (table != reference || std::signbit(table) != std::signbit(reference)))) {
+			++nrOfFailedTests;
+			if (reportTestCases) std::cerr << "FAIL: " << type_tag(a) << ' ' << to_binary(a) << " decodes to " << table << " instead of " << reference << '\n';
+		}
+	}
+	return nrOfFailedTests;
+}
+
+// the table encoding of v, and the conversions of v from double and from float, must be the encoding of the arithmetic conversion
+template<typename Number>
+int VerifyEncode(bool reportTestCases, double v) {
+	using namespace sw::universal;
+	Number table, reference = ReferenceEncode<Number>(v);
+	int nrOfFailedTests = 0;
+	uint64_t raw{ 0 };
+	if (ReferenceTable<Number>().encode(v, raw)) {
+		table.setbits(raw);
+		if (to_binary(table) != to_binary(reference)) {
+			++nrOfFailedTests;
+			if (reportTestCases) std::cerr << "FAIL: " << type_tag(table) << " table encodes " << std::setprecision(17) << v << " as " << to_binary(table) << " instead of " << to_binary(reference) << '\n';
+		}
+	}
+	table = v;
+	if (to_binary(table) != to_binary(reference)) {
+		++nrOfFailedTests;
+		if (reportTestCases) std::cerr << "FAIL: " << type_tag(table) << " encodes " << std::setprecision(17) << v << " as " << to_binary(table) << " instead of " << to_binary(reference) << '\n';
+	}
+	// a float rounds as the double of the same value: the arithmetic conversion of a cfloat from float flushes float subnormals
+	float f = float(v);
+	if (double(f) == v && std::isnormal(f)) {
+		table = f;
+		if (to_binary(table) != to_binary(reference)) {
+			++nrOfFailedTests;
+			if (reportTestCases) std::cerr << "FAIL: " << type_tag(table) << " encodes float " << f << " as " << to_binary(table) << " instead of " << to_binary(reference) << '\n';
+		}
+	}
+	return nrOfFailedTests;
+}
+
+// rounding around every value: the values themselves, the arithmetic and geometric midpoints of neighbors and
+// the doubles next to them, values beyond the range, special values, and random values across the range
+template<typename Number>
+int VerifyTableEncode(bool reportTestCases) {
+	using namespace sw::universal;
+	constexpr size_t NR_ENCODINGS = size_t(1) << Number::nbits;
+	std::vector<double> values;
+	Number a;
+	for (size_t i = 0; i < NR_ENCODINGS; ++i) {
+		a.setbits(i);
+		double v = ReferenceDecode(a);
+		if (std::isfinite(v)) values.push_back(v);
+	}
+	std::sort(values.begin(), values.end());
+	values.erase(std::unique(values.begin(), values.end()), values.end());
+
+	int nrOfFailedTests = 0;
+	auto probe = [&](double v) {
+		nrOfFailedTests += VerifyEncode<Number>(reportTestCases, v);
+		nrOfFailedTests += VerifyEncode<Number>(reportTestCases, std::nextafter(v, -INFINITY));
+		nrOfFailedTests += VerifyEncode<Number>(reportTestCases, std::nextafter(v, INFINITY));
+	};
+	for (size_t k = 0; k < values.size(); ++k) {
+		probe(values[k]);
+		if (k + 1 < values.size()) {
+			double lo = values[k], hi = values[k + 1];
+			probe(std::midpoint(lo, hi));
+			if (lo > 0.0 || hi < 0.0) probe((lo > 0.0 ? 1.0 : -1.0) * std::sqrt(lo * hi));
+		}
+		if (nrOfFailedTests > 10) return nrOfFailedTests;
+	}
+	const double specials[] = { 0.0, -0.0, INFINITY, -INFINITY, double(NAN), 2.0 * values.back(), 2.0 * values.front(), 1.0e300, -1.0e300, 1.0e-300, -1.0e-300 };
+	for (double v : specials) {
+		nrOfFailedTests += VerifyEncode<Number>(reportTestCases, v);
+	}
+	std::mt19937_64 rng(1);
+	std::uniform_real_distribution<double> scale(std::log2(std::max(values.back(), -values.front())) - 40.0, std::log2(std::max(values.back(), -values.front())) + 1.0);
+	for (int i = 0; i < 20000; ++i) {
+		double v = std::exp2(scale(rng));
+		nrOfFailedTests += VerifyEncode<Number>(reportTestCases, (i & 1) ? -v : v);
+	}
+	return nrOfFailedTests;
+}
+
+template<typename Number>
+int VerifyEncodingTable(bool reportTestCases) {
+	return VerifyTableDecode<Number>(reportTestCases) + VerifyTableEncode<Number>(reportTestCases);
+}
+
+// Regression testing guards: typically set by the cmake configuration, but MANUAL_TESTING is an override
+#define MANUAL_TESTING 0
+// REGRESSION_LEVEL_OVERRIDE is set by the cmake file to drive a specific regression intensity
+// It is the responsibility of the regression test to organize the tests in a quartile progression.
+//#undef REGRESSION_LEVEL_OVERRIDE
+#ifndef REGRESSION_LEVEL_OVERRIDE
+#undef REGRESSION_LEVEL_1
+#undef REGRESSION_LEVEL_2
+#undef REGRESSION_LEVEL_3
+#undef REGRESSION_LEVEL_4
+#define REGRESSION_LEVEL_1 1
+#define REGRESSION_LEVEL_2 1
+#define REGRESSION_LEVEL_3 1
+#define REGRESSION_LEVEL_4 1
+#endif
+
+int main()
+try {
+	using namespace sw::universal;
+
+	std::string test_suite  = "encoding table conversions of small formats";
+	std::string test_tag    = "encoding table";
+	bool reportTestCases    = true;
+	int nrOfFailedTestCases = 0;
+
+	ReportTestSuiteHeader(test_suite, reportTestCases);
+
+#if REGRESSION_LEVEL_1
+	nrOfFailedTestCases += ReportTestResult(VerifyEncodingTable< cfloat<8, 2, uint8_t, true, true, false> >(reportTestCases), "cfloat< 8,2>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyEncodingTable< cfloat<8, 4, uint8_t, false, false, false> >(reportTestCases), "cfloat< 8,4>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyEncodingTable< cfloat<8, 3, uint8_t, true, false, true> >(reportTestCases), "cfloat< 8,3> saturating", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyEncodingTable< posit<8, 0> >(reportTestCases), "posit< 8,0>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyEncodingTable< posit<8, 2> >(reportTestCases), "posit< 8,2>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyEncodingTable< lns<8, 3, uint8_t> >(reportTestCases), "lns< 8,3>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyEncodingTable< fixpnt<8, 4, Modulo, uint8_t> >(reportTestCases), "fixpnt< 8,4> modulo", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyEncodingTable< fixpnt<8, 4, Saturate, uint8_t> >(reportTestCases), "fixpnt< 8,4> saturate", test_tag);
+#endif
+
+#if REGRESSION_LEVEL_2
+	nrOfFailedTestCases += ReportTestResult(VerifyEncodingTable< cfloat<12, 5, uint16_t, true, false, false> >(reportTestCases), "cfloat<12,5>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyEncodingTable< posit<12, 1> >(reportTestCases), "posit<12,1>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyEncodingTable< lns<12, 6, uint16_t> >(reportTestCases), "lns<12,6>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyEncodingTable< fixpnt<12, 10, Modulo, uint16_t> >(reportTestCases), "fixpnt<12,10> modulo", test_tag);
+#endif
+
+#if REGRESSION_LEVEL_3
+	nrOfFailedTestCases += ReportTestResult(VerifyEncodingTable< cfloat<16, 5, uint16_t, true, false, false> >(reportTestCases), "cfloat<16,5>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyEncodingTable< cfloat<16, 8, uint16_t, true, false, false> >(reportTestCases), "cfloat<16,8>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyEncodingTable< posit<16, 1> >(reportTestCases), "posit<16,1>", test_tag);
+#endif
+
+#if REGRESSION_LEVEL_4
+	nrOfFailedTestCases += ReportTestResult(VerifyEncodingTable< posit<16, 2> >(reportTestCases), "posit<16,2>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyEncodingTable< lns<16, 8, uint16_t> >(reportTestCases), "lns<16,8>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyEncodingTable< fixpnt<16, 8, Saturate, uint16_t> >(reportTestCases), "fixpnt<16,8> saturate", test_tag);
+#endif
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_arithmetic_exception& err) {
+	std::cerr << "Uncaught universal arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_internal_exception& err) {
+	std::cerr << "Uncaught universal internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
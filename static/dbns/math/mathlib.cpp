@@ -0,0 +1,123 @@
+// mathlib.cpp: test suite runner for the exponent arithmetic math functions of the double-base logarithmic number system
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <universal/number/dbns/dbns.hpp>
+#include <universal/verification/test_reporters.hpp>
+
+namespace sw {
+	namespace universal {
+		namespace local {
+
+			// enumerate the positive encodings and compare the function to the dbns rounding of the double function
+			template<typename DbnsType, typename Function, typename Reference>
+			int VerifyFunction(bool reportTestCases, const std::string& op, Function&& function, Reference&& reference) {
+				constexpr size_t NR_ENCODINGS = (1ull << DbnsType::nbits);
+				int nrOfFailedTestCases = 0;
+				DbnsType a{}, result{}, ref{};
+				for (size_t i = 0; i < NR_ENCODINGS; ++i) {
+					a.setbits(i);
+					if (a.isnan() || a.isneg() || a.iszero()) continue;
+					result = function(a);
+					ref = reference(double(a));
+					if (result != ref) {
+						++nrOfFailedTestCases;
+						if (reportTestCases) ReportOneInputFunctionError("FAIL", op, a, result, ref);
+					}
+				}
+				return nrOfFailedTestCases;
+			}
+
+			template<typename DbnsType>
+			int VerifyHypot(bool reportTestCases) {
+				constexpr size_t NR_ENCODINGS = (1ull << DbnsType::nbits);
+				int nrOfFailedTestCases = 0;
+				DbnsType a{}, b{}, result{}, ref{};
+				for (size_t i = 0; i < NR_ENCODINGS; ++i) {
+					a.setbits(i);
+					if (a.isnan()) continue;
+					for (size_t j = 0; j < NR_ENCODINGS; ++j) {
+						b.setbits(j);
+						if (b.isnan()) continue;
+						result = hypot(a, b);
+						double exact = std::hypot(double(a), double(b));
+						ref = exact;
+						if (result != ref) {
+							// hypot(x, x) = sqrt(2) x is a tie in the log domain between the neighbors 9/8 apart
+							double target = std::log2(exact);
+							if (std::abs(std::abs(std::log2(double(result)) - target) - std::abs(std::log2(double(ref)) - target)) < 1.0e-9) continue;
+							++nrOfFailedTestCases;
+							if (reportTestCases) ReportTwoInputFunctionError("FAIL", "hypot", a, b, result, ref);
+						}
+					}
+				}
+				return nrOfFailedTestCases;
+			}
+
+		}
+	}
+}
+
+#define MANUAL_TESTING 0
+
+int main()
+try {
+	using namespace sw::universal;
+
+	std::string test_suite  = "dbns mathlib validation";
+	std::string test_tag    = "mathlib";
+	bool reportTestCases    = false;
+	int nrOfFailedTestCases = 0;
+
+	ReportTestSuiteHeader(test_suite, reportTestCases);
+
+#if MANUAL_TESTING
+	using Dbns = dbns<8, 3>;
+	Dbns a(9.0);
+	std::cout << "sqrt(" << a << ") = " << sqrt(a) << " : " << to_binary(sqrt(a)) << '\n';
+	std::cout << "cbrt(" << a << ") = " << cbrt(a) << " : " << to_binary(cbrt(a)) << '\n';
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return EXIT_SUCCESS;   // ignore errors
+#else
+	using Dbns8 = dbns<8, 3>;
+	using Dbns10 = dbns<10, 4>;
+
+	nrOfFailedTestCases += ReportTestResult(local::VerifyFunction<Dbns8>(reportTestCases, "sqrt", [](const Dbns8& a) { return sqrt(a); }, [](double da) { return std::sqrt(da); }), "dbns<8,3>", "sqrt");
+	nrOfFailedTestCases += ReportTestResult(local::VerifyFunction<Dbns10>(reportTestCases, "sqrt", [](const Dbns10& a) { return sqrt(a); }, [](double da) { return std::sqrt(da); }), "dbns<10,4>", "sqrt");
+	nrOfFailedTestCases += ReportTestResult(local::VerifyFunction<Dbns8>(reportTestCases, "cbrt", [](const Dbns8& a) { return cbrt(a); }, [](double da) { return std::cbrt(da); }), "dbns<8,3>", "cbrt");
+	nrOfFailedTestCases += ReportTestResult(local::VerifyFunction<Dbns8>(reportTestCases, "rsqrt", [](const Dbns8& a) { return rsqrt(a); }, [](double da) { return 1.0 / std::sqrt(da); }), "dbns<8,3>", "rsqrt");
+	nrOfFailedTestCases += ReportTestResult(local::VerifyFunction<Dbns8>(reportTestCases, "pow", [](const Dbns8& a) { return pow(a, 3); }, [](double da) { return std::pow(da, 3.0); }), "dbns<8,3>", "pow");
+	nrOfFailedTestCases += ReportTestResult(local::VerifyFunction<Dbns8>(reportTestCases, "exp2", [](const Dbns8& a) { return exp2(a); }, [](double da) { return std::exp2(da); }), "dbns<8,3>", "exp2");
+	nrOfFailedTestCases += ReportTestResult(local::VerifyFunction<Dbns8>(reportTestCases, "exp", [](const Dbns8& a) { return exp(a); }, [](double da) { return std::exp(da); }), "dbns<8,3>", "exp");
+	nrOfFailedTestCases += ReportTestResult(local::VerifyFunction<Dbns8>(reportTestCases, "log2", [](const Dbns8& a) { return log2(a); }, [](double da) { return std::log2(da); }), "dbns<8,3>", "log2");
+	nrOfFailedTestCases += ReportTestResult(local::VerifyFunction<Dbns8>(reportTestCases, "log", [](const Dbns8& a) { return log(a); }, [](double da) { return std::log(da); }), "dbns<8,3>", "log");
+	nrOfFailedTestCases += ReportTestResult(local::VerifyHypot<Dbns8>(reportTestCases), "dbns<8,3>", "hypot");
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+#endif  // MANUAL_TESTING
+}
+catch (char const* msg) {
+	std::cerr << "Caught ad-hoc exception: " << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_arithmetic_exception& err) {
+	std::cerr << "Caught unexpected universal arithmetic exception : " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_internal_exception& err) {
+	std::cerr << "Caught unexpected universal internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Caught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
@@ -0,0 +1,204 @@
+// cordic.cpp: test suite runner for the CORDIC math library of wide fixed-point configurations
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <random>
+#include <vector>
+// use default number system library configuration
+#include <universal/number/fixpnt/fixpnt.hpp>
+#include <universal/blas/blas.hpp>
+#include <universal/verification/test_suite.hpp>
+
+namespace sw { namespace universal {
+
+// distance in ulps between two fixpnts
+template<typename Fixed>
+long long UlpDistance(const Fixed& a, const Fixed& b) {
+	constexpr unsigned unused = 64 - Fixed::nbits;
+	long long ra = static_cast<long long>(a.encoding() << unused) >> unused;
+	long long rb = static_cast<long long>(b.encoding() << unused) >> unused;
+	return (ra > rb ? ra - rb : rb - ra);
+}
+
+// sample a function of one argument in [lo, hi] against the double reference: the configurations are too
+// wide to enumerate, and the double reference is accurate to a fraction of their ulp
+template<typename Fixed, typename Function, typename Reference>
+int VerifyCordic(bool reportTestCases, const std::string& op, Function&& f, Reference&& ref, double lo, double hi, unsigned nrSamples = 10000) {
+	std::mt19937_64 generator(42);
+	std::uniform_real_distribution<double> distribution(lo, hi);
+	int nrOfFailedTests = 0;
+	for (unsigned i = 0; i < nrSamples; ++i) {
+		Fixed a(distribution(generator));
+		Fixed result = f(a);
+		Fixed reference(ref(double(a)));
+		if (UlpDistance(result, reference) > 1) {
+			++nrOfFailedTests;
+			if (reportTestCases) ReportOneInputFunctionError("FAIL", op, a, reference, result);
+		}
+	}
+	return nrOfFailedTests;
+}
+
+// sample a function of two arguments in [lo, hi] x [lo, hi] against the double reference
+template<typename Fixed, typename Function, typename Reference>
+int VerifyCordic2(bool reportTestCases, const std::string& op, Function&& f, Reference&& ref, double lo, double hi, unsigned nrSamples = 10000) {
+	std::mt19937_64 generator(42);
+	std::uniform_real_distribution<double> distribution(lo, hi);
+	int nrOfFailedTests = 0;
+	for (unsigned i = 0; i < nrSamples; ++i) {
+		Fixed a(distribution(generator)), b(distribution(generator));
+		Fixed result = f(a, b);
+		Fixed reference(ref(double(a), double(b)));
+		if (UlpDistance(result, reference) > 1) {
+			++nrOfFailedTests;
+			if (reportTestCases) ReportBinaryArithmeticError("FAIL", op, a, b, result, reference);
+		}
+	}
+	return nrOfFailedTests;
+}
+
+// the batch sine and cosine, and the vmath functions that use them, must match the scalar functions bitwise
+template<typename Fixed>
+int VerifyBatchSincos(bool reportTestCases, double lo, double hi, size_t N = 1000) {
+	std::mt19937_64 generator(7);
+	std::uniform_real_distribution<double> distribution(lo, hi);
+	std::vector<Fixed> x(N), s(N), c(N);
+	blas::vector<Fixed> v(N);
+	for (size_t i = 0; i < N; ++i) v[i] = x[i] = Fixed(distribution(generator));
+	sincos(x.data(), s.data(), c.data(), N);
+	blas::vector<Fixed> vs = blas::sin(v), vc = blas::cos(v);
+	int nrOfFailedTests = 0;
+	for (size_t i = 0; i < N; ++i) {
+		Fixed sref = sin(x[i]), cref = cos(x[i]);
+		if (s[i] != sref || vs[i] != sref) {
+			++nrOfFailedTests;
+			if (reportTestCases) ReportOneInputFunctionError("FAIL", "batch sin", x[i], sref, s[i]);
+		}
+		if (c[i] != cref || vc[i] != cref) {
+			++nrOfFailedTests;
+			if (reportTestCases) ReportOneInputFunctionError("FAIL", "batch cos", x[i], cref, c[i]);
+		}
+	}
+	return nrOfFailedTests;
+}
+
+// the functions whose results are of the order of one, which the double reference resolves for 64-bit configurations
+template<typename Fixed>
+int VerifyBoundedFunctions(bool reportTestCases, double range) {
+	int nrOfFailedTests = 0;
+	auto maxpos = double(Fixed(SpecificValue::maxpos));
+	nrOfFailedTests += VerifyCordic<Fixed>(reportTestCases, "sin",  [](Fixed x) { return sin(x); },  [](double x) { return std::sin(x); },  -range, range);
+	nrOfFailedTests += VerifyCordic<Fixed>(reportTestCases, "cos",  [](Fixed x) { return cos(x); },  [](double x) { return std::cos(x); },  -range, range);
+	nrOfFailedTests += VerifyCordic<Fixed>(reportTestCases, "tan",  [](Fixed x) { return tan(x); },  [](double x) { return std::tan(x); },  -1.5, 1.5);
+	nrOfFailedTests += VerifyCordic<Fixed>(reportTestCases, "atan", [](Fixed x) { return atan(x); }, [](double x) { return std::atan(x); }, -range, range);
+	nrOfFailedTests += VerifyCordic<Fixed>(reportTestCases, "asin", [](Fixed x) { return asin(x); }, [](double x) { return std::asin(x); }, -1.0, 1.0);
+	nrOfFailedTests += VerifyCordic<Fixed>(reportTestCases, "acos", [](Fixed x) { return acos(x); }, [](double x) { return std::acos(x); }, -1.0, 1.0);
+	nrOfFailedTests += VerifyCordic<Fixed>(reportTestCases, "tanh", [](Fixed x) { return tanh(x); }, [](double x) { return std::tanh(x); }, -range, range);
+	nrOfFailedTests += VerifyCordic<Fixed>(reportTestCases, "log",  [](Fixed x) { return log(x); },  [](double x) { return std::log(x); },  0.0, maxpos);
+	nrOfFailedTests += VerifyCordic<Fixed>(reportTestCases, "log2", [](Fixed x) { return log2(x); }, [](double x) { return std::log2(x); }, 0.0, maxpos);
+	nrOfFailedTests += VerifyCordic<Fixed>(reportTestCases, "log10",[](Fixed x) { return log10(x); },[](double x) { return std::log10(x); },0.0, maxpos);
+	nrOfFailedTests += VerifyCordic2<Fixed>(reportTestCases, "atan2", [](Fixed y, Fixed x) { return atan2(y, x); }, [](double y, double x) { return std::atan2(y, x); }, -range, range);
+	return nrOfFailedTests;
+}
+
+// the functions whose results span the range of the configuration
+template<typename Fixed>
+int VerifyUnboundedFunctions(bool reportTestCases, double range) {
+	int nrOfFailedTests = 0;
+	nrOfFailedTests += VerifyCordic<Fixed>(reportTestCases, "exp",   [](Fixed x) { return exp(x); },   [](double x) { return std::exp(x); },   -range, range);
+	nrOfFailedTests += VerifyCordic<Fixed>(reportTestCases, "exp2",  [](Fixed x) { return exp2(x); },  [](double x) { return std::exp2(x); },  -range, range);
+	nrOfFailedTests += VerifyCordic<Fixed>(reportTestCases, "exp10", [](Fixed x) { return exp10(x); }, [](double x) { return std::pow(10.0, x); }, -range, range);
+	nrOfFailedTests += VerifyCordic<Fixed>(reportTestCases, "sinh",  [](Fixed x) { return sinh(x); },  [](double x) { return std::sinh(x); },  -range, range);
+	nrOfFailedTests += VerifyCordic<Fixed>(reportTestCases, "cosh",  [](Fixed x) { return cosh(x); },  [](double x) { return std::cosh(x); },  -range, range);
+	nrOfFailedTests += VerifyCordic2<Fixed>(reportTestCases, "hypot", [](Fixed x, Fixed y) { return hypot(x, y); }, [](double x, double y) { return std::hypot(x, y); }, -range, range);
+	return nrOfFailedTests;
+}
+
+}} // namespace sw::universal
+
+// Regression testing guards: typically set by the cmake configuration, but MANUAL_TESTING is an override
+#define MANUAL_TESTING 0
+// REGRESSION_LEVEL_OVERRIDE is set by the cmake file to drive a specific regression intensity
+// It is the responsibility of the regression test to organize the tests in a quartile progression.
+//#undef REGRESSION_LEVEL_OVERRIDE
+#ifndef REGRESSION_LEVEL_OVERRIDE
+#undef REGRESSION_LEVEL_1
+#undef REGRESSION_LEVEL_2
+#undef REGRESSION_LEVEL_3
+#undef REGRESSION_LEVEL_4
+#define REGRESSION_LEVEL_1 1
+#define REGRESSION_LEVEL_2 1
+#define REGRESSION_LEVEL_3 1
+#define REGRESSION_LEVEL_4 1
+#endif
+
+int main()
+try {
+	using namespace sw::universal;
+
+	std::string test_suite  = "fixed-point mathlib CORDIC";
+	std::string test_tag    = "mathlib cordic";
+	bool reportTestCases    = true;
+	int nrOfFailedTestCases = 0;
+
+	ReportTestSuiteHeader(test_suite, reportTestCases);
+
+#if MANUAL_TESTING
+	using FixedPoint = fixpnt<32, 16, Saturate, uint32_t>;
+	FixedPoint a(1.5);
+	std::cout << "sin(" << a << ") = " << sin(a) << " reference " << std::sin(double(a)) << '\n';
+	std::cout << "exp(" << a << ") = " << exp(a) << " reference " << std::exp(double(a)) << '\n';
+	std::cout << "log(" << a << ") = " << log(a) << " reference " << std::log(double(a)) << '\n';
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return EXIT_SUCCESS; // ignore failures
+#else
+
+#if REGRESSION_LEVEL_1
+	nrOfFailedTestCases += ReportTestResult(VerifyBoundedFunctions< fixpnt<24, 12, Saturate, uint32_t> >(reportTestCases, 2000.0), "fixpnt<24,12>", "bounded functions");
+	nrOfFailedTestCases += ReportTestResult(VerifyUnboundedFunctions< fixpnt<24, 12, Saturate, uint32_t> >(reportTestCases, 12.0), "fixpnt<24,12>", "unbounded functions");
+	nrOfFailedTestCases += ReportTestResult(VerifyBatchSincos< fixpnt<24, 12, Saturate, uint32_t> >(reportTestCases, -2000.0, 2000.0), "fixpnt<24,12>", "batch sincos");
+#endif
+
+#if REGRESSION_LEVEL_2
+	nrOfFailedTestCases += ReportTestResult(VerifyBoundedFunctions< fixpnt<32, 16, Saturate, uint32_t> >(reportTestCases, 30000.0), "fixpnt<32,16>", "bounded functions");
+	nrOfFailedTestCases += ReportTestResult(VerifyUnboundedFunctions< fixpnt<32, 16, Saturate, uint32_t> >(reportTestCases, 12.0), "fixpnt<32,16>", "unbounded functions");
+	nrOfFailedTestCases += ReportTestResult(VerifyBoundedFunctions< fixpnt<32, 28, Saturate, uint32_t> >(reportTestCases, 7.0), "fixpnt<32,28>", "bounded functions");
+	nrOfFailedTestCases += ReportTestResult(VerifyBatchSincos< fixpnt<32, 28, Saturate, uint32_t> >(reportTestCases, -7.0, 7.0), "fixpnt<32,28>", "batch sincos");
+#endif
+
+#if REGRESSION_LEVEL_3
+	nrOfFailedTestCases += ReportTestResult(VerifyBoundedFunctions< fixpnt<64, 32, Saturate, uint64_t> >(reportTestCases, 1.0e9), "fixpnt<64,32>", "bounded functions");
+	nrOfFailedTestCases += ReportTestResult(VerifyBatchSincos< fixpnt<64, 32, Saturate, uint64_t> >(reportTestCases, -1.0e9, 1.0e9), "fixpnt<64,32>", "batch sincos");
+#endif
+
+#if REGRESSION_LEVEL_4
+#endif
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+#endif  // MANUAL_TESTING
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::fixpnt_arithmetic_exception& err) {
+	std::cerr << "Uncaught fixpnt arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::fixpnt_internal_exception& err) {
+	std::cerr << "Uncaught fixpnt internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
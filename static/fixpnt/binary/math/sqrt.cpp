@@ -0,0 +1,121 @@
+// sqrt.cpp: test suite runner for the correctly rounded fixed-point square root
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+// use default library configuration
+#include <universal/number/fixpnt/fixpnt.hpp>
+#include <universal/verification/test_suite.hpp>
+
+// exhaustive test of the non-negative encodings against an integer reference:
+// the root encoding is the square root of raw * 2^rbits, rounded to nearest
+template<typename Fixed>
+int VerifySqrt(bool reportTestCases) {
+	using namespace sw::universal;
+	constexpr unsigned nbits = Fixed::nbits;
+	constexpr unsigned rbits = Fixed::rbits;
+	static_assert(nbits + rbits <= 52, "integer reference needs the radicand to be exact in a double");
+
+	int nrOfFailedTests = 0;
+	for (uint64_t raw = 0; raw < (1ull << (nbits - 1)); ++raw) {
+		Fixed a, result, ref;
+		a.setbits(raw);
+		uint64_t radicand = raw << rbits;
+		uint64_t root = static_cast<uint64_t>(std::sqrt(double(radicand)));
+		while (root * root > radicand) --root;
+		while ((root + 1) * (root + 1) <= radicand) ++root;
+		if (radicand - root * root > root) ++root;
+		ref.setbits(root);
+		result = sw::universal::sqrt(a);
+		if (result != ref) {
+			++nrOfFailedTests;
+			if (reportTestCases) ReportUnaryArithmeticError("FAIL", "sqrt", a, result, ref);
+			if (nrOfFailedTests > 24) return nrOfFailedTests;
+		}
+	}
+	return nrOfFailedTests;
+}
+
+// Regression testing guards: typically set by the cmake configuration, but MANUAL_TESTING is an override
+#define MANUAL_TESTING 0
+// REGRESSION_LEVEL_OVERRIDE is set by the cmake file to drive a specific regression intensity
+// It is the responsibility of the regression test to organize the tests in a quartile progression.
+//#undef REGRESSION_LEVEL_OVERRIDE
+#ifndef REGRESSION_LEVEL_OVERRIDE
+#undef REGRESSION_LEVEL_1
+#undef REGRESSION_LEVEL_2
+#undef REGRESSION_LEVEL_3
+#undef REGRESSION_LEVEL_4
+#define REGRESSION_LEVEL_1 1
+#define REGRESSION_LEVEL_2 1
+#define REGRESSION_LEVEL_3 1
+#define REGRESSION_LEVEL_4 1
+#endif
+
+int main()
+try {
+	using namespace sw::universal;
+
+	std::string test_suite  = "fixed-point mathlib square root function";
+	std::string test_tag    = "mathlib sqrt";
+	bool reportTestCases    = true;
+	int nrOfFailedTestCases = 0;
+
+	ReportTestSuiteHeader(test_suite, reportTestCases);
+
+#if MANUAL_TESTING
+	// generate individual testcases to hand trace/debug
+	fixpnt<16, 8, Modulo, uint8_t> a(2.0f);
+	std::cout << "sqrt(" << a << ") = " << sqrt(a) << " : " << to_binary(sqrt(a)) << '\n';
+	nrOfFailedTestCases += ReportTestResult(VerifySqrt< fixpnt<8, 4, Modulo, uint8_t> >(reportTestCases), "fixpnt<8,4>", "sqrt");
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return EXIT_SUCCESS;   // ignore errors
+#else
+
+#if REGRESSION_LEVEL_1
+	nrOfFailedTestCases += ReportTestResult(VerifySqrt< fixpnt<8, 0, Modulo, uint8_t> >(reportTestCases), "fixpnt<8,0>", "sqrt");
+	nrOfFailedTestCases += ReportTestResult(VerifySqrt< fixpnt<8, 4, Modulo, uint8_t> >(reportTestCases), "fixpnt<8,4>", "sqrt");
+	nrOfFailedTestCases += ReportTestResult(VerifySqrt< fixpnt<8, 7, Modulo, uint8_t> >(reportTestCases), "fixpnt<8,7>", "sqrt");
+	nrOfFailedTestCases += ReportTestResult(VerifySqrt< fixpnt<8, 4, Saturate, uint8_t> >(reportTestCases), "fixpnt<8,4,Saturate>", "sqrt");
+#endif
+
+#if REGRESSION_LEVEL_2
+	nrOfFailedTestCases += ReportTestResult(VerifySqrt< fixpnt<12, 6, Modulo, uint8_t> >(reportTestCases), "fixpnt<12,6>", "sqrt");
+	nrOfFailedTestCases += ReportTestResult(VerifySqrt< fixpnt<16, 8, Modulo, uint16_t> >(reportTestCases), "fixpnt<16,8>", "sqrt");
+#endif
+
+#if REGRESSION_LEVEL_3
+	nrOfFailedTestCases += ReportTestResult(VerifySqrt< fixpnt<20, 16, Modulo, uint32_t> >(reportTestCases), "fixpnt<20,16>", "sqrt");
+#endif
+
+#if REGRESSION_LEVEL_4
+	nrOfFailedTestCases += ReportTestResult(VerifySqrt< fixpnt<24, 12, Modulo, uint8_t> >(reportTestCases), "fixpnt<24,12>", "sqrt");
+#endif
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+#endif  // MANUAL_TESTING
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_arithmetic_exception& err) {
+	std::cerr << "Uncaught universal arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_internal_exception& err) {
+	std::cerr << "Uncaught universal internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
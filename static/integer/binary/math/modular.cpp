@@ -0,0 +1,198 @@
+// modular.cpp: Montgomery and Barrett modular arithmetic and modular exponentiation tests on fixed-size integers
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal number project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <iostream>
+#include <random>
+#include <string>
+#include <universal/number/integer/integer.hpp>
+#include <universal/verification/test_suite.hpp>
+
+namespace sw { namespace universal {
+
+	// reference modular product and exponentiation through operator% on integers of twice the width
+	template<unsigned nbits>
+	integer<nbits, uint32_t> referenceMulMod(const integer<nbits, uint32_t>& a, const integer<nbits, uint32_t>& b, const integer<nbits, uint32_t>& m) {
+		using Wide = integer<2 * nbits, uint32_t>;
+		Wide wm(m), wa = Wide(a) % wm, wb = Wide(b) % wm;
+		if (wa < 0) wa += wm;
+		if (wb < 0) wb += wm;
+		return integer<nbits, uint32_t>((wa * wb) % wm);
+	}
+	template<unsigned nbits>
+	integer<nbits, uint32_t> referencePowMod(const integer<nbits, uint32_t>& a, integer<nbits, uint32_t> e, const integer<nbits, uint32_t>& m) {
+		integer<nbits, uint32_t> r(1), x = referenceMulMod(a, integer<nbits, uint32_t>(1), m);
+		r = referenceMulMod(r, r, m);
+		while (!e.iszero()) {
+			if (e.isodd()) r = referenceMulMod(r, x, m);
+			x = referenceMulMod(x, x, m);
+			e >>= 1;
+		}
+		return r;
+	}
+
+	// random non-negative integers of at most the given number of bits
+	template<unsigned nbits>
+	integer<nbits, uint32_t> randomInteger(unsigned bits, std::mt19937_64& generator) {
+		integer<nbits, uint32_t> a(0);
+		for (unsigned i = 0; i < bits; ++i) a.setbit(i, (generator() & 1) != 0);
+		return a;
+	}
+
+	// the products and powers of the Montgomery and Barrett engines agree with the reference for random operands
+	template<unsigned nbits>
+	int VerifyModularArithmetic(unsigned modulusBits, unsigned nrSamples, bool reportTestCases) {
+		using Integer = integer<nbits, uint32_t>;
+		std::mt19937_64 generator(nbits * 31 + modulusBits);
+		int nrOfFailedTests = 0;
+		for (unsigned s = 0; s < nrSamples; ++s) {
+			Integer m = randomInteger<nbits>(modulusBits, generator);
+			m.setbit(modulusBits - 1);
+			if (m <= 2) m = 3;
+			Integer a = randomInteger<nbits>(nbits - 1, generator), b = randomInteger<nbits>(modulusBits, generator), e = randomInteger<nbits>(modulusBits, generator);
+			if (s % 4 == 1) a = -a;
+			Integer product = referenceMulMod(a, b, m), power = referencePowMod(a, e, m);
+			barrett<nbits, uint32_t> br(m);
+			if (br.mul(a, b) != product || br.pow(a, e) != power || mulmod(a, b, m) != product || powmod(a, e, m) != power) {
+				++nrOfFailedTests;
+				if (reportTestCases) std::cerr << "FAIL: barrett modulo " << m << " of " << a << " and " << b << '\n';
+			}
+			if (m.isodd()) {
+				montgomery<nbits, uint32_t> mg(m);
+				if (mg.mul(a, b) != product || mg.pow(a, e) != power || mg.pow_ct(a, e) != power) {
+					++nrOfFailedTests;
+					if (reportTestCases) std::cerr << "FAIL: montgomery modulo " << m << " of " << a << " and " << b << '\n';
+				}
+			}
+		}
+		return nrOfFailedTests;
+	}
+
+	// Fermat's little theorem: a^(p-1) = 1 mod p for primes p that do not divide a
+	template<unsigned nbits>
+	int VerifyFermat(const char* prime, bool reportTestCases) {
+		using Integer = integer<nbits, uint32_t>;
+		int nrOfFailedTests = 0;
+		Integer p;
+		p.assign(prime);
+		montgomery<nbits, uint32_t> mg(p);
+		for (int a : { 2, 3, 5, 7, 1000003 }) {
+			if (mg.pow(Integer(a), p - 1) != 1 || mg.pow_ct(Integer(a), p - 1) != 1 || powmod(Integer(a), p, p) != a) {
+				++nrOfFailedTests;
+				if (reportTestCases) std::cerr << "FAIL: " << a << "^(p-1) mod " << prime << '\n';
+			}
+		}
+		return nrOfFailedTests;
+	}
+
+	// an RSA round trip with the primes p = 2^127 - 1 and q = 2^89 - 1, public exponent 65537
+	int VerifyRSA(bool reportTestCases) {
+		using Integer = integer<512, uint32_t>;
+		int nrOfFailedTests = 0;
+		Integer p, q;
+		p.assign("170141183460469231731687303715884105727");
+		q.assign("618970019642690137449562111");
+		Integer n = p * q, phi = (p - 1) * (q - 1), e(65537);
+		// d = e^-1 mod phi by the extended Euclidean algorithm
+		Integer r0 = phi, r1 = e, t0 = 0, t1 = 1;
+		while (!r1.iszero()) {
+			Integer quotient = r0 / r1, t;
+			t = r0 - quotient * r1; r0 = r1; r1 = t;
+			t = t0 - quotient * t1; t0 = t1; t1 = t;
+		}
+		Integer d = (t0 < 0 ? t0 + phi : t0);
+		montgomery<512, uint32_t> mg(n);
+		std::mt19937_64 generator(65537);
+		for (int i = 0; i < 8; ++i) {
+			Integer message = randomInteger<512>(200, generator);
+			Integer cipher = mg.pow(message, e);
+			if (mg.pow_ct(cipher, d) != message || mg.pow(cipher, d) != message) {
+				++nrOfFailedTests;
+				if (reportTestCases) std::cerr << "FAIL: RSA round trip of " << message << '\n';
+			}
+		}
+		return nrOfFailedTests;
+	}
+
+} } // namespace sw::universal
+
+// Regression testing guards: typically set by the cmake configuration, but MANUAL_TESTING is an override
+#define MANUAL_TESTING 0
+// REGRESSION_LEVEL_OVERRIDE is set by the cmake file to drive a specific regression intensity
+// It is the responsibility of the regression test to organize the tests in a quartile progression.
+//#undef REGRESSION_LEVEL_OVERRIDE
+#ifndef REGRESSION_LEVEL_OVERRIDE
+#undef REGRESSION_LEVEL_1
+#undef REGRESSION_LEVEL_2
+#undef REGRESSION_LEVEL_3
+#undef REGRESSION_LEVEL_4
+#define REGRESSION_LEVEL_1 1
+#define REGRESSION_LEVEL_2 1
+#define REGRESSION_LEVEL_3 1
+#define REGRESSION_LEVEL_4 1
+#endif
+
+int main()
+try {
+	using namespace sw::universal;
+
+	std::string test_suite  = "Integer modular arithmetic verification";
+	std::string test_tag    = "modular";
+	bool reportTestCases    = false;
+	int nrOfFailedTestCases = 0;
+
+	ReportTestSuiteHeader(test_suite, reportTestCases);
+
+#if MANUAL_TESTING
+
+	using Integer = integer<128, uint32_t>;
+	Integer m(1000003), a(2), e(1000002);
+	montgomery<128, uint32_t> mg(m);
+	std::cout << a << '^' << e << " mod " << m << " = " << mg.pow(a, e) << " : " << mg.pow_ct(a, e) << '\n';
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return EXIT_SUCCESS; // ignore failures
+#else // MANUAL_TESTING
+
+#if REGRESSION_LEVEL_1
+	nrOfFailedTestCases += ReportTestResult(VerifyModularArithmetic<64>(20, 64, reportTestCases), "integer<64, uint32_t>", "20-bit moduli");
+	nrOfFailedTestCases += ReportTestResult(VerifyModularArithmetic<64>(63, 64, reportTestCases), "integer<64, uint32_t>", "63-bit moduli");
+	nrOfFailedTestCases += ReportTestResult(VerifyFermat<64>("2305843009213693951", reportTestCases), "integer<64, uint32_t>", "Fermat 2^61 - 1");
+#endif
+
+#if REGRESSION_LEVEL_2
+	nrOfFailedTestCases += ReportTestResult(VerifyModularArithmetic<128>(70, 32, reportTestCases), "integer<128, uint32_t>", "70-bit moduli");
+	nrOfFailedTestCases += ReportTestResult(VerifyModularArithmetic<128>(127, 32, reportTestCases), "integer<128, uint32_t>", "127-bit moduli");
+	nrOfFailedTestCases += ReportTestResult(VerifyModularArithmetic<160>(100, 32, reportTestCases), "integer<160, uint32_t>", "100-bit moduli");
+	nrOfFailedTestCases += ReportTestResult(VerifyFermat<128>("170141183460469231731687303715884105727", reportTestCases), "integer<128, uint32_t>", "Fermat 2^127 - 1");
+#endif
+
+#if REGRESSION_LEVEL_3
+	nrOfFailedTestCases += ReportTestResult(VerifyModularArithmetic<256>(40, 16, reportTestCases), "integer<256, uint32_t>", "40-bit moduli");
+	nrOfFailedTestCases += ReportTestResult(VerifyModularArithmetic<256>(255, 16, reportTestCases), "integer<256, uint32_t>", "255-bit moduli");
+	nrOfFailedTestCases += ReportTestResult(VerifyRSA(reportTestCases), "integer<512, uint32_t>", "RSA round trip");
+#endif
+
+#if REGRESSION_LEVEL_4
+	nrOfFailedTestCases += ReportTestResult(VerifyModularArithmetic<512>(511, 8, reportTestCases), "integer<512, uint32_t>", "511-bit moduli");
+#endif
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+#endif // MANUAL_TESTING
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (std::runtime_error& err) {
+	std::cerr << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
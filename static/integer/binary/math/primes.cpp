@@ -0,0 +1,213 @@
+// primes.cpp: primality testing, prime sieves, and factorization tests on fixed-size and adaptive precision integers
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal number project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <universal/number/integer/integer.hpp>
+#include <universal/number/einteger/einteger.hpp>
+#include <universal/verification/test_suite.hpp>
+
+namespace sw { namespace universal {
+
+	// primes, among them the Mersenne primes 2^61 - 1, 2^89 - 1, and 2^127 - 1 and the largest 64-bit prime
+	static const char* knownPrimes[] = {
+		"2", "3", "5", "97", "65537", "2147483647", "1000000007", "2305843009213693951", "18446744073709551557",
+		"618970019642690137449562111", "170141183460469231731687303715884105727"
+	};
+	// composites that fool weaker tests: Carmichael numbers, strong pseudoprimes to base 2 and to the first
+	// 9 and 12 prime bases, strong Lucas pseudoprimes, the square of a prime, and 2^64 + 1
+	static const char* knownComposites[] = {
+		"0", "1", "4", "561", "1105", "1729", "2047", "3277", "4033", "4681", "8321", "5459", "5777", "10877",
+		"3215031751", "3825123056546413051", "318665857834031151167461", "1000006000009", "18446744073709551617"
+	};
+
+	template<typename Integer>
+	int VerifyPrimality(bool reportTestCases) {
+		int nrOfFailedTests = 0;
+		for (const char* txt : knownPrimes) {
+			Integer a;
+			a.assign(txt);
+			if (!isPrime(a)) {
+				++nrOfFailedTests;
+				if (reportTestCases) std::cerr << "FAIL: " << txt << " is a prime\n";
+			}
+		}
+		for (const char* txt : knownComposites) {
+			Integer a;
+			a.assign(txt);
+			if (isPrime(a)) {
+				++nrOfFailedTests;
+				if (reportTestCases) std::cerr << "FAIL: " << txt << " is not a prime\n";
+			}
+		}
+		return nrOfFailedTests;
+	}
+
+	// the segmented sieve agrees with the primality test, for any number of threads and at unaligned range boundaries
+	int VerifySieve(std::uint64_t low, std::uint64_t high, bool reportTestCases) {
+		int nrOfFailedTests = 0;
+		std::vector<std::uint64_t> expected;
+		for (std::uint64_t n = low; n < high; ++n) {
+			if (isPrime(n)) expected.push_back(n);
+		}
+		for (unsigned nrThreads : { 1u, 3u, 8u }) {
+			if (segmentedSieve(low, high, nrThreads) != expected) {
+				++nrOfFailedTests;
+				if (reportTestCases) std::cerr << "FAIL: segmented sieve of [" << low << ", " << high << ") with " << nrThreads << " threads\n";
+			}
+		}
+		return nrOfFailedTests;
+	}
+
+	// the factors are prime, increasing, and multiply out to the argument
+	template<typename Integer>
+	int VerifyFactorization(const Integer& a, size_t nrDistinctFactors, bool reportTestCases) {
+		int nrOfFailedTests = 0;
+		primefactors<Integer> factors;
+		primeFactorization(a, factors);
+		Integer product(1);
+		for (size_t i = 0; i < factors.size(); ++i) {
+			if (!isPrime(factors[i].first)) ++nrOfFailedTests;
+			if (i > 0 && !(factors[i - 1].first < factors[i].first)) ++nrOfFailedTests;
+			for (Integer k(0); k < factors[i].second; ++k) product *= factors[i].first;
+		}
+		if (product != a) ++nrOfFailedTests;
+		if (factors.size() != nrDistinctFactors) ++nrOfFailedTests;
+		if (nrOfFailedTests > 0 && reportTestCases) {
+			std::cerr << "FAIL: factorization of " << a << " :";
+			for (auto f : factors) std::cerr << ' ' << f.first << '^' << f.second;
+			std::cerr << '\n';
+		}
+		return nrOfFailedTests;
+	}
+
+	// smallest prime not smaller than a
+	template<typename Integer>
+	Integer nextPrime(Integer a) {
+		while (!isPrime(a)) ++a;
+		return a;
+	}
+
+} } // namespace sw::universal
+
+// Regression testing guards: typically set by the cmake configuration, but MANUAL_TESTING is an override
+#define MANUAL_TESTING 0
+// REGRESSION_LEVEL_OVERRIDE is set by the cmake file to drive a specific regression intensity
+// It is the responsibility of the regression test to organize the tests in a quartile progression.
+//#undef REGRESSION_LEVEL_OVERRIDE
+#ifndef REGRESSION_LEVEL_OVERRIDE
+#undef REGRESSION_LEVEL_1
+#undef REGRESSION_LEVEL_2
+#undef REGRESSION_LEVEL_3
+#undef REGRESSION_LEVEL_4
+#define REGRESSION_LEVEL_1 1
+#define REGRESSION_LEVEL_2 1
+#define REGRESSION_LEVEL_3 1
+#define REGRESSION_LEVEL_4 1
+#endif
+
+int main()
+try {
+	using namespace sw::universal;
+
+	std::string test_suite  = "Integer primality, sieves, and factorization verification";
+	std::string test_tag    = "primes";
+	bool reportTestCases    = false;
+	int nrOfFailedTestCases = 0;
+
+	ReportTestSuiteHeader(test_suite, reportTestCases);
+
+#if MANUAL_TESTING
+
+	using Integer = integer<256, uint32_t>;
+	Integer a;
+	a.assign("29526726473244001");
+	primefactors<Integer> factors;
+	primeFactorization(a, factors);
+	for (auto f : factors) std::cout << f.first << '^' << f.second << '\n';
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return EXIT_SUCCESS; // ignore failures
+#else // MANUAL_TESTING
+
+#if REGRESSION_LEVEL_1
+	nrOfFailedTestCases += ReportTestResult(VerifyPrimality< integer<256, uint32_t> >(reportTestCases), "integer<256, uint32_t>", "isPrime");
+	nrOfFailedTestCases += ReportTestResult(VerifyPrimality< integer<192, uint8_t> >(reportTestCases), "integer<192, uint8_t>", "isPrime");
+	nrOfFailedTestCases += ReportTestResult(VerifyPrimality< integer<1024, uint16_t> >(reportTestCases), "integer<1024, uint16_t>", "isPrime");
+	nrOfFailedTestCases += ReportTestResult(VerifyPrimality< einteger<uint32_t> >(reportTestCases), "einteger<uint32_t>", "isPrime");
+#endif
+
+#if REGRESSION_LEVEL_2
+	nrOfFailedTestCases += ReportTestResult(VerifySieve(0, 200000, reportTestCases), "segmentedSieve", "[0, 200000)");
+	nrOfFailedTestCases += ReportTestResult(VerifySieve(1000000000001ull, 1000000300001ull, reportTestCases), "segmentedSieve", "[10^12 + 1, 10^12 + 300001)");
+	{
+		// pi(10^7) = 664579
+		std::vector< integer<64, uint32_t> > primes;
+		primeNumbersInRange(integer<64, uint32_t>(0), integer<64, uint32_t>(10000000), primes);
+		nrOfFailedTestCases += ReportTestResult((primes.size() == 664579 ? 0 : 1), "primeNumbersInRange", "pi(10^7)");
+	}
+#endif
+
+#if REGRESSION_LEVEL_3
+	{
+		using Integer = integer<256, uint32_t>;
+		Integer a;
+		int nrOfFailures = 0;
+		a.assign("29526726473244001");       // 199 * 281 * 63281 * 8344159
+		nrOfFailures += VerifyFactorization(a, 4, reportTestCases);
+		a.assign("18446744073709551615");    // 2^64 - 1 = 3 * 5 * 17 * 257 * 641 * 65537 * 6700417
+		nrOfFailures += VerifyFactorization(a, 7, reportTestCases);
+		a.assign("147573952589676412927");   // 2^67 - 1 = 193707721 * 761838257287
+		nrOfFailures += VerifyFactorization(a, 2, reportTestCases);
+		a.assign("1000006000009");           // 1000003^2
+		a *= 999983;
+		a *= 1024;
+		nrOfFailures += VerifyFactorization(a, 3, reportTestCases);
+		// three primes of 30, 40, and 50 bits
+		Integer p = nextPrime(Integer(1ull << 30)), q = nextPrime(Integer(1ull << 40)), r = nextPrime(Integer(1ull << 50));
+		nrOfFailures += VerifyFactorization(Integer(p * q * r), 3, reportTestCases);
+		nrOfFailedTestCases += ReportTestResult(nrOfFailures, "integer<256, uint32_t>", "primeFactorization");
+	}
+	{
+		using Integer = einteger<uint32_t>;
+		Integer a;
+		int nrOfFailures = 0;
+		a.assign("18446744073709551615");
+		nrOfFailures += VerifyFactorization(a, 7, reportTestCases);
+		a.assign("147573952589676412927");
+		nrOfFailures += VerifyFactorization(a, 2, reportTestCases);
+		nrOfFailedTestCases += ReportTestResult(nrOfFailures, "einteger<uint32_t>", "primeFactorization");
+	}
+#endif
+
+#if REGRESSION_LEVEL_4
+	{
+		// a semiprime with two 64-bit factors is beyond the reach of rho and is split by the elliptic curve method
+		using Integer = integer<256, uint32_t>;
+		Integer p = nextPrime(Integer(0xFFFF'FFFF'0000'0000ull)), q = nextPrime(Integer(0x8000'0000'0000'0000ull));
+		Integer n = p * q;
+		nrOfFailedTestCases += ReportTestResult(VerifyFactorization(n, 2, reportTestCases), "integer<256, uint32_t>", "primeFactorization 2x64-bit");
+	}
+#endif
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+#endif // MANUAL_TESTING
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (std::runtime_error& err) {
+	std::cerr << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
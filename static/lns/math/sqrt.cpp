@@ -0,0 +1,113 @@
+// sqrt.cpp: test suite runner for the square root, reciprocal square root, and cube root functions
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <universal/number/lns/lns.hpp>
+#include <universal/verification/lns_test_suite_mathlib.hpp>
+
+// generate specific test case that you can trace with the trace conditions in lns.hpp
+template<typename LnsType>
+void GenerateTestCase(double a) {
+	LnsType pa(a), pref(std::sqrt(a)), psqrt = sw::universal::sqrt(pa);
+	std::cout << std::setprecision(LnsType::nbits - 2);
+	std::cout << " -> sqrt(" << a << ") = " << std::sqrt(a) << std::endl;
+	std::cout << " -> sqrt( " << pa << ") = " << psqrt << " (reference: " << pref << ")   ";
+	std::cout << (pref == psqrt ? "PASS" : "FAIL") << std::endl << std::endl;
+	std::cout << std::setprecision(5);
+}
+
+// the roots of the special values
+template<typename LnsType>
+int VerifySpecialCases(bool reportTestCases) {
+	using namespace sw::universal;
+	int nrOfFailedTestCases = 0;
+	LnsType zero(0), nan(SpecificValue::qnan), maxpos(SpecificValue::maxpos), minpos(SpecificValue::minpos);
+
+	if (!sqrt(zero).iszero()) ++nrOfFailedTestCases;
+	if (!sqrt(nan).isnan()) ++nrOfFailedTestCases;
+	if (!cbrt(zero).iszero()) ++nrOfFailedTestCases;
+	if (!rsqrt(LnsType(-4)).isnan()) ++nrOfFailedTestCases;
+	if (cbrt(LnsType(-8)) != LnsType(-2)) ++nrOfFailedTestCases;
+	if (sqrt(LnsType(4)) != LnsType(2)) ++nrOfFailedTestCases;
+	if (rsqrt(LnsType(4)) != LnsType(0.5)) ++nrOfFailedTestCases;
+	// the roots of maxpos and minpos are in range, and their squares saturate
+	if (sqrt(maxpos) * sqrt(maxpos) != maxpos) ++nrOfFailedTestCases;
+	if (sqrt(minpos).iszero() || !(sqrt(minpos) > minpos)) ++nrOfFailedTestCases;
+	// integer powers and reciprocals are exact in the log domain
+	if (pow(LnsType(2), 3) != LnsType(8)) ++nrOfFailedTestCases;
+	if (pow(LnsType(-2), 3) != LnsType(-8)) ++nrOfFailedTestCases;
+	if (pow(LnsType(-2), -2) != LnsType(0.25)) ++nrOfFailedTestCases;
+	if (pow(maxpos, 1000) != maxpos) ++nrOfFailedTestCases;
+	if (!pow(minpos, 1000).iszero()) ++nrOfFailedTestCases;
+	if (!pow(LnsType(-2), 0.5).isnan()) ++nrOfFailedTestCases;
+	if (reciprocal(LnsType(-4)) != LnsType(-0.25)) ++nrOfFailedTestCases;
+	if (reciprocal(reciprocal(maxpos)) != maxpos) ++nrOfFailedTestCases;
+	if (reportTestCases && nrOfFailedTestCases > 0) std::cerr << "FAIL: special cases of " << type_tag(zero) << '\n';
+	return nrOfFailedTestCases;
+}
+
+#define MANUAL_TESTING 0
+
+int main()
+try {
+	using namespace sw::universal;
+
+	std::string test_suite  = "lns<> mathlib root function validation";
+	std::string test_tag    = "sqrt";
+	bool reportTestCases    = false;
+	int nrOfFailedTestCases = 0;
+
+	ReportTestSuiteHeader(test_suite, reportTestCases);
+
+#if MANUAL_TESTING
+	// generate individual testcases to hand trace/debug
+	GenerateTestCase< lns<8, 2> >(2.0);
+	GenerateTestCase< lns<16, 8> >(3.0);
+
+	nrOfFailedTestCases += ReportTestResult(VerifySqrt< lns<8, 4> >(true), "lns<8,4>", "sqrt");
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return EXIT_SUCCESS;   // ignore errors
+#else
+
+	nrOfFailedTestCases += ReportTestResult(VerifySqrt< lns<8, 2> >(reportTestCases), "lns<8,2>", "sqrt");
+	nrOfFailedTestCases += ReportTestResult(VerifySqrt< lns<12, 6> >(reportTestCases), "lns<12,6>", "sqrt");
+	nrOfFailedTestCases += ReportTestResult(VerifySqrt< lns<16, 8> >(reportTestCases), "lns<16,8>", "sqrt");
+	nrOfFailedTestCases += ReportTestResult(VerifyRsqrt< lns<8, 2> >(reportTestCases), "lns<8,2>", "rsqrt");
+	nrOfFailedTestCases += ReportTestResult(VerifyRsqrt< lns<12, 6> >(reportTestCases), "lns<12,6>", "rsqrt");
+	nrOfFailedTestCases += ReportTestResult(VerifyCbrt< lns<8, 2> >(reportTestCases), "lns<8,2>", "cbrt");
+	nrOfFailedTestCases += ReportTestResult(VerifyCbrt< lns<12, 6> >(reportTestCases), "lns<12,6>", "cbrt");
+	nrOfFailedTestCases += ReportTestResult(VerifyCbrt< lns<16, 8> >(reportTestCases), "lns<16,8>", "cbrt");
+
+	nrOfFailedTestCases += ReportTestResult(VerifySpecialCases< lns<8, 2> >(reportTestCases), "lns<8,2>", "special cases");
+	nrOfFailedTestCases += ReportTestResult(VerifySpecialCases< lns<16, 8> >(reportTestCases), "lns<16,8>", "special cases");
+	nrOfFailedTestCases += ReportTestResult(VerifySpecialCases< lns<32, 16> >(reportTestCases), "lns<32,16>", "special cases");
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+
+#endif  // MANUAL_TESTING
+}
+catch (char const* msg) {
+	std::cerr << "Caught ad-hoc exception: " << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_arithmetic_exception& err) {
+	std::cerr << "Caught unexpected universal arithmetic exception : " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_internal_exception& err) {
+	std::cerr << "Caught unexpected universal internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Caught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}